@@ -0,0 +1 @@
+static const char *petscconfigureoptions = "--with-cc=mpicc --with-cxx=0 --with-debugging=1 --with-fc=0 --with-x=0 COPTFLAGS=-O1 PETSC_ARCH=_gate_hdf5 --with-hdf5-include=/usr/include/hdf5/serial --with-hdf5-lib=\"-L/usr/lib/x86_64-linux-gnu -lhdf5_serial_hl -lhdf5_serial\"";
@@ -0,0 +1,17 @@
+static const char *petscmachineinfo = "\n"
+"-----------------------------------------\n"
+"Libraries compiled on 2026-10-17 12:37:49 on vm \n"
+"Machine characteristics: Linux-6.18.44-fc-v130-x86_64-with-glibc2.36\n"
+"Using PETSc directory: /root/repo\n"
+"Using PETSc arch: _gate_hdf5\n"
+"-----------------------------------------\n";
+static const char *petsccompilerinfo = "\n"
+"Using C compiler: mpicc  -fPIC -Wall -Wwrite-strings -Wno-strict-aliasing -Wno-unknown-pragmas -Wno-misleading-indentation -Wno-stringop-overflow -fstack-protector -fvisibility=hidden -O1   \n"
+"-----------------------------------------\n";
+static const char *petsccompilerflagsinfo = "\n"
+"Using include paths: -I/root/repo/include -I/root/repo/_gate_hdf5/include -I/usr/include/hdf5/serial\n"
+"-----------------------------------------\n";
+static const char *petsclinkerinfo = "\n"
+"Using C linker: mpicc\n"
+"Using libraries: -Wl,-rpath,/root/repo/_gate_hdf5/lib -L/root/repo/_gate_hdf5/lib -lpetsc -L/usr/lib/x86_64-linux-gnu -llapack -lblas -lhdf5_serial_hl -lhdf5_serial -lm -lquadmath -ldl\n"
+"-----------------------------------------\n";
@@ -0,0 +1,18 @@
+#!/root/.pyenv/versions/3.11.7/bin/python3
+if __name__ == '__main__':
+  import sys
+  import os
+  sys.path.insert(0, os.path.abspath('config'))
+  import configure
+  configure_options = [
+    '--with-cc=mpicc',
+    '--with-cxx=0',
+    '--with-debugging=1',
+    '--with-fc=0',
+    '--with-hdf5-include=/usr/include/hdf5/serial',
+    '--with-hdf5-lib=-L/usr/lib/x86_64-linux-gnu -lhdf5_serial_hl -lhdf5_serial',
+    '--with-x=0',
+    'COPTFLAGS=-O1',
+    'PETSC_ARCH=_gate_hdf5',
+  ]
+  configure.petsc_configure(configure_options)
@@ -0,0 +1,72 @@
+#!/usr/bin/env bash
+# This script was created by gmakegentest.py
+
+
+
+# PATH for DLLs on windows
+PATH="$PATH":"/root/repo/_gate_hdf5/lib"
+
+exec='../ex31'
+testname='runex31_0'
+label='dm_impls_plex_tests-ex31_0'
+runfiles=''
+wPETSC_DIR='/root/repo'
+petsc_dir='/root/repo'
+petsc_arch='_gate_hdf5'
+# Must be consistent with gmakefile.test
+testlogtapfile=/root/repo/_gate_hdf5/tests/test_${petsc_arch}_tap.log
+testlogerrfile=/root/repo/_gate_hdf5/tests/test_${petsc_arch}_err.log
+config_dir='/root/repo/config'
+filter=''
+filter_output=''
+petsc_bindir='/root/repo/lib/petsc/bin'
+DATAFILESPATH=${DATAFILESPATH:-""}
+args='-interpolate -use_initial_guess FALSE'
+diff_args=''
+timeoutfactor=1
+
+mpiexec=${PETSCMPIEXEC:-"mpiexec"}
+diffexec=${PETSCDIFF:-"${petsc_bindir}/petscdiff"}
+
+. "${config_dir}/petsc_harness.sh"
+
+# The diff flags come from script arguments
+diff_exe="${diffexec} ${diff_flags} ${diff_args}"
+mpiexec="${mpiexec} ${mpiexec_flags}"
+
+
+
+if ! $force; then
+    petsc_report_tapoutput "" "${label}" "SKIP PETSC_HAVE_PARMETIS requirement not met"
+    total=1; skip=1
+    petsc_testend "/root/repo/_gate_hdf5/tests" 
+    exit
+fi
+
+
+nsize_in=${nsize:-2 3 4}
+faces_in=${faces:-2,3,4  5,4,3  7,11,5}
+entity_depth_in=${entity_depth:-0 1}
+parallel_in=${parallel:-FALSE TRUE}
+
+
+for insize in ${nsize_in}; do
+   for ifaces in ${faces_in}; do
+      for ientity_depth in ${entity_depth_in}; do
+         for iparallel in ${parallel_in}; do
+
+            petsc_testrun "${mpiexec} -n ${insize} ${exec} ${args}  -faces ${ifaces} -entity_depth ${ientity_depth} -parallel ${iparallel}" ex31_0.tmp ${testname}.err "${label}+nsize-${insize}faces-${ifaces}_entity_depth-${ientity_depth}_parallel-${iparallel}" 
+            res=$?
+
+            if test $res = 0; then
+               petsc_testrun "${diff_exe} /root/repo/src/dm/impls/plex/tests/output/ex31_0.out ex31_0.tmp" diff-${testname}.out diff-${testname}.out diff-${label}+nsize-${insize}faces-${ifaces}_entity_depth-${ientity_depth}_parallel-${iparallel} ""
+            else
+               petsc_report_tapoutput "" ${label} "SKIP Command failed so no diff"
+            fi
+
+         done
+      done
+   done
+done
+
+petsc_testend "/root/repo/_gate_hdf5/tests" 
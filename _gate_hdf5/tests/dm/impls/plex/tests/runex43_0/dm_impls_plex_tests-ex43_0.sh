@@ -0,0 +1 @@
+mpiexec  -n 1 ../ex43 -petscpartitioner_type simple -petscspace_degree 2 -write_size 1 -check  > ex43_0.tmp 2> runex43_0.err
@@ -0,0 +1 @@
+mpiexec  -n 4 ../ex43 -petscpartitioner_type simple -petscspace_degree 2 -write_size 2 -read_size 4  > ex43_grow.tmp 2> runex43_grow.err
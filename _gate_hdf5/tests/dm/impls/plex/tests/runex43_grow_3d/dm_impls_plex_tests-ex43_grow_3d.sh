@@ -0,0 +1 @@
+mpiexec  -n 3 ../ex43 -petscpartitioner_type simple -petscspace_degree 2 -dim 3 -faces 3 -write_size 2 -read_size 3  > ex43_grow_3d.tmp 2> runex43_grow_3d.err
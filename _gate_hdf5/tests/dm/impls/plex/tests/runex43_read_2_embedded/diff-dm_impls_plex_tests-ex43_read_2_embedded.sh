@@ -0,0 +1 @@
+/root/repo/lib/petsc/bin/petscdiff   /root/repo/src/dm/impls/plex/tests/output/ex43_read_2_embedded.out ex43_read_2_embedded.tmp > diff-runex43_read_2_embedded.out 2> diff-runex43_read_2_embedded.out
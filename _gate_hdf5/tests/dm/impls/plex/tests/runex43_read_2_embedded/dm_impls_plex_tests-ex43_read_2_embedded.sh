@@ -0,0 +1 @@
+mpiexec  -n 2 ../ex43 -petscpartitioner_type simple -petscspace_degree 2 -write_size 1 -check -embedded  > ex43_read_2_embedded.tmp 2> runex43_read_2_embedded.err
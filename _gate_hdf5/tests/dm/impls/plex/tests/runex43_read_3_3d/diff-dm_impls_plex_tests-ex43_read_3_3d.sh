@@ -0,0 +1 @@
+/root/repo/lib/petsc/bin/petscdiff   /root/repo/src/dm/impls/plex/tests/output/ex43_read_3_3d.out ex43_read_3_3d.tmp > diff-runex43_read_3_3d.out 2> diff-runex43_read_3_3d.out
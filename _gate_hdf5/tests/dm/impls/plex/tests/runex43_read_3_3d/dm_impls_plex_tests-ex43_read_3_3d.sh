@@ -0,0 +1 @@
+mpiexec  -n 3 ../ex43 -petscpartitioner_type simple -petscspace_degree 2 -write_size 1 -check -dim 3 -faces 3  > ex43_read_3_3d.tmp 2> runex43_read_3_3d.err
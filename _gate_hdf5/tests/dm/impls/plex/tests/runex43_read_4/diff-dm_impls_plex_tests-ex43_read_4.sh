@@ -0,0 +1 @@
+/root/repo/lib/petsc/bin/petscdiff   /root/repo/src/dm/impls/plex/tests/output/ex43_read_4.out ex43_read_4.tmp > diff-runex43_read_4.out 2> diff-runex43_read_4.out
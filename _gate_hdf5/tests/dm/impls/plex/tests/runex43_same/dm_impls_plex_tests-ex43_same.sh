@@ -0,0 +1 @@
+mpiexec  -n 2 ../ex43 -petscpartitioner_type simple -petscspace_degree 2  > ex43_same.tmp 2> runex43_same.err
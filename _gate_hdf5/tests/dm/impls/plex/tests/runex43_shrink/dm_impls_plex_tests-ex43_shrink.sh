@@ -0,0 +1 @@
+mpiexec  -n 4 ../ex43 -petscpartitioner_type simple -petscspace_degree 2 -write_size 4 -read_size 2  > ex43_shrink.tmp 2> runex43_shrink.err
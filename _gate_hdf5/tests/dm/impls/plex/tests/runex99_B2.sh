@@ -0,0 +1,69 @@
+#!/usr/bin/env bash
+# This script was created by gmakegentest.py
+
+
+
+# PATH for DLLs on windows
+PATH="$PATH":"/root/repo/_gate_hdf5/lib"
+
+exec='../ex99'
+testname='runex99_B2'
+label='dm_impls_plex_tests-ex99_B2'
+runfiles=''
+wPETSC_DIR='/root/repo'
+petsc_dir='/root/repo'
+petsc_arch='_gate_hdf5'
+# Must be consistent with gmakefile.test
+testlogtapfile=/root/repo/_gate_hdf5/tests/test_${petsc_arch}_tap.log
+testlogerrfile=/root/repo/_gate_hdf5/tests/test_${petsc_arch}_err.log
+config_dir='/root/repo/config'
+filter=''
+filter_output=''
+petsc_bindir='/root/repo/lib/petsc/bin'
+DATAFILESPATH=${DATAFILESPATH:-""}
+args='-dir ${wPETSC_DIR}/share/petsc/datafiles/meshes -dim 2 -integral 3.141592653589793 -tol 0.05'
+diff_args=''
+timeoutfactor=1
+
+mpiexec=${PETSCMPIEXEC:-"mpiexec"}
+diffexec=${PETSCDIFF:-"${petsc_bindir}/petscdiff"}
+
+. "${config_dir}/petsc_harness.sh"
+
+# The diff flags come from script arguments
+diff_exe="${diffexec} ${diff_flags} ${diff_args}"
+mpiexec="${mpiexec} ${mpiexec_flags}"
+
+
+
+if ! $force; then
+    petsc_report_tapoutput "" "${label}" "SKIP Required: define(PETSC_GMSH_EXE)"
+    total=1; skip=1
+    petsc_testend "/root/repo/_gate_hdf5/tests" 
+    exit
+fi
+
+
+nsize_in=${nsize:-1}
+msh_in=${msh:-B2tri B2qua}
+order_in=${order:-2 3 4 5 6 7 8 9}
+
+
+for insize in ${nsize_in}; do
+   for imsh in ${msh_in}; do
+      for iorder in ${order_in}; do
+
+         petsc_testrun "${mpiexec} -n ${insize} ${exec} ${args}  -msh ${imsh} -order ${iorder}" ex99_B2.tmp ${testname}.err "${label}+msh-${imsh}_order-${iorder}" 
+         res=$?
+
+         if test $res = 0; then
+            petsc_testrun "${diff_exe} /root/repo/src/dm/impls/plex/tests/output/ex99_B2.out ex99_B2.tmp" diff-${testname}.out diff-${testname}.out diff-${label}+msh-${imsh}_order-${iorder} ""
+         else
+            petsc_report_tapoutput "" ${label} "SKIP Command failed so no diff"
+         fi
+
+      done
+   done
+done
+
+petsc_testend "/root/repo/_gate_hdf5/tests" 
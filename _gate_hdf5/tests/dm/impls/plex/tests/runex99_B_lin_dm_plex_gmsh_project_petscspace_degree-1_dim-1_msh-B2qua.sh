@@ -0,0 +1,63 @@
+#!/usr/bin/env bash
+# This script was created by gmakegentest.py
+
+
+
+# PATH for DLLs on windows
+PATH="$PATH":"/root/repo/_gate_hdf5/lib"
+
+exec='../ex99'
+testname='runex99_B_lin_dm_plex_gmsh_project_petscspace_degree-1_dim-1_msh-B2qua'
+label='dm_impls_plex_tests-ex99_B_lin_dm_plex_gmsh_project_petscspace_degree-1_dim-1_msh-B2qua'
+runfiles=''
+wPETSC_DIR='/root/repo'
+petsc_dir='/root/repo'
+petsc_arch='_gate_hdf5'
+# Must be consistent with gmakefile.test
+testlogtapfile=/root/repo/_gate_hdf5/tests/test_${petsc_arch}_tap.log
+testlogerrfile=/root/repo/_gate_hdf5/tests/test_${petsc_arch}_err.log
+config_dir='/root/repo/config'
+filter=''
+filter_output=''
+petsc_bindir='/root/repo/lib/petsc/bin'
+DATAFILESPATH=${DATAFILESPATH:-""}
+args='-dir ${wPETSC_DIR}/share/petsc/datafiles/meshes -dm_plex_gmsh_highorder true -dm_plex_gmsh_project true -dm_plex_gmsh_fe_view -dm_plex_gmsh_project_fe_view -order 1 -tol 1e-4 -dm_plex_gmsh_project_petscspace_degree 1 -dm_plex_gmsh_spacedim 2 -dim 1 -integral 5.656854249492381 -msh B2qua'
+diff_args=''
+timeoutfactor=1
+
+mpiexec=${PETSCMPIEXEC:-"mpiexec"}
+diffexec=${PETSCDIFF:-"${petsc_bindir}/petscdiff"}
+
+. "${config_dir}/petsc_harness.sh"
+
+# The diff flags come from script arguments
+diff_exe="${diffexec} ${diff_flags} ${diff_args}"
+mpiexec="${mpiexec} ${mpiexec_flags}"
+
+
+
+if ! $force; then
+    petsc_report_tapoutput "" "${label}" "SKIP Required: define(PETSC_GMSH_EXE)"
+    total=1; skip=1
+    petsc_testend "/root/repo/_gate_hdf5/tests" 
+    exit
+fi
+
+
+nsize_in=${nsize:-1}
+
+
+for insize in ${nsize_in}; do
+
+   petsc_testrun "${mpiexec} -n ${insize} ${exec} ${args} " ex99_B_lin_dm_plex_gmsh_project_petscspace_degree-1_dim-1_msh-B2qua.tmp ${testname}.err "${label}" 
+   res=$?
+
+   if test $res = 0; then
+      petsc_testrun "${diff_exe} /root/repo/src/dm/impls/plex/tests/output/ex99_B_lin_dm_plex_gmsh_project_petscspace_degree-1_dim-1_msh-B2qua.out ex99_B_lin_dm_plex_gmsh_project_petscspace_degree-1_dim-1_msh-B2qua.tmp" diff-${testname}.out diff-${testname}.out diff-${label} ""
+   else
+      petsc_report_tapoutput "" ${label} "SKIP Command failed so no diff"
+   fi
+
+done
+
+petsc_testend "/root/repo/_gate_hdf5/tests" 
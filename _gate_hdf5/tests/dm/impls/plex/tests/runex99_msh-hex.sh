@@ -0,0 +1,72 @@
+#!/usr/bin/env bash
+# This script was created by gmakegentest.py
+
+
+
+# PATH for DLLs on windows
+PATH="$PATH":"/root/repo/_gate_hdf5/lib"
+
+exec='../ex99'
+testname='runex99_msh-hex'
+label='dm_impls_plex_tests-ex99_msh-hex'
+runfiles=''
+wPETSC_DIR='/root/repo'
+petsc_dir='/root/repo'
+petsc_arch='_gate_hdf5'
+# Must be consistent with gmakefile.test
+testlogtapfile=/root/repo/_gate_hdf5/tests/test_${petsc_arch}_tap.log
+testlogerrfile=/root/repo/_gate_hdf5/tests/test_${petsc_arch}_err.log
+config_dir='/root/repo/config'
+filter=''
+filter_output=''
+petsc_bindir='/root/repo/lib/petsc/bin'
+DATAFILESPATH=${DATAFILESPATH:-""}
+args='-dir ${wPETSC_DIR}/share/petsc/datafiles/meshes -dm_view ::ascii_info_detail -dm_plex_check_all -dm_plex_gmsh_highorder false -dm_plex_gmsh_use_marker true -msh hex'
+diff_args=''
+timeoutfactor=1
+
+mpiexec=${PETSCMPIEXEC:-"mpiexec"}
+diffexec=${PETSCDIFF:-"${petsc_bindir}/petscdiff"}
+
+. "${config_dir}/petsc_harness.sh"
+
+# The diff flags come from script arguments
+diff_exe="${diffexec} ${diff_flags} ${diff_args}"
+mpiexec="${mpiexec} ${mpiexec_flags}"
+
+
+
+if ! $force; then
+    petsc_report_tapoutput "" "${label}" "SKIP Required: define(PETSC_GMSH_EXE)"
+    total=1; skip=1
+    petsc_testend "/root/repo/_gate_hdf5/tests" 
+    exit
+fi
+
+
+nsize_in=${nsize:-1}
+order_in=${order:-1 2 3 7}
+fmt_in=${fmt:-msh22 msh40 msh41}
+bin_in=${bin:-0 1}
+
+
+for insize in ${nsize_in}; do
+   for iorder in ${order_in}; do
+      for ifmt in ${fmt_in}; do
+         for ibin in ${bin_in}; do
+
+            petsc_testrun "${mpiexec} -n ${insize} ${exec} ${args}  -order ${iorder} -fmt ${ifmt} -bin ${ibin}" ex99_msh-hex.tmp ${testname}.err "${label}+order-${iorder}_fmt-${ifmt}_bin-${ibin}" 
+            res=$?
+
+            if test $res = 0; then
+               petsc_testrun "${diff_exe} /root/repo/src/dm/impls/plex/tests/output/ex99_msh-hex.out ex99_msh-hex.tmp" diff-${testname}.out diff-${testname}.out diff-${label}+order-${iorder}_fmt-${ifmt}_bin-${ibin} ""
+            else
+               petsc_report_tapoutput "" ${label} "SKIP Command failed so no diff"
+            fi
+
+         done
+      done
+   done
+done
+
+petsc_testend "/root/repo/_gate_hdf5/tests" 
@@ -0,0 +1 @@
+echo dm_impls_plex_tests-ex43_read_3 dm_impls_plex_tests-ex43_0 dm_impls_plex_tests-ex43_read_4 dm_impls_plex_tests-ex43_read_2 dm_impls_plex_tests-ex43_read_3_3d
\ No newline at end of file
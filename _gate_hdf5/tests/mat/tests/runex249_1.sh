@@ -0,0 +1,63 @@
+#!/usr/bin/env bash
+# This script was created by gmakegentest.py
+
+
+
+# PATH for DLLs on windows
+PATH="$PATH":"/root/repo/_gate_hdf5/lib"
+
+exec='../ex249'
+testname='runex249_1'
+label='mat_tests-ex249_1'
+runfiles=''
+wPETSC_DIR='/root/repo'
+petsc_dir='/root/repo'
+petsc_arch='_gate_hdf5'
+# Must be consistent with gmakefile.test
+testlogtapfile=/root/repo/_gate_hdf5/tests/test_${petsc_arch}_tap.log
+testlogerrfile=/root/repo/_gate_hdf5/tests/test_${petsc_arch}_err.log
+config_dir='/root/repo/config'
+filter=''
+filter_output=''
+petsc_bindir='/root/repo/lib/petsc/bin'
+DATAFILESPATH=${DATAFILESPATH:-""}
+args=''
+diff_args=''
+timeoutfactor=1
+
+mpiexec=${PETSCMPIEXEC:-"mpiexec"}
+diffexec=${PETSCDIFF:-"${petsc_bindir}/petscdiff"}
+
+. "${config_dir}/petsc_harness.sh"
+
+# The diff flags come from script arguments
+diff_exe="${diffexec} ${diff_flags} ${diff_args}"
+mpiexec="${mpiexec} ${mpiexec_flags}"
+
+
+
+
+
+nsize_in=${nsize:-1}
+mat_sell_slice_height_in=${mat_sell_slice_height:-4 8 16 32}
+mat_sell_sigma_in=${mat_sell_sigma:-1 16 128}
+
+
+for insize in ${nsize_in}; do
+   for imat_sell_slice_height in ${mat_sell_slice_height_in}; do
+      for imat_sell_sigma in ${mat_sell_sigma_in}; do
+
+         petsc_testrun "${mpiexec} -n ${insize} ${exec} ${args}  -mat_sell_slice_height ${imat_sell_slice_height} -mat_sell_sigma ${imat_sell_sigma}" ex249_1.tmp ${testname}.err "${label}+mat_sell_slice_height-${imat_sell_slice_height}_mat_sell_sigma-${imat_sell_sigma}" 
+         res=$?
+
+         if test $res = 0; then
+            petsc_testrun "${diff_exe} /root/repo/src/mat/tests/output/ex249_1.out ex249_1.tmp" diff-${testname}.out diff-${testname}.out diff-${label}+mat_sell_slice_height-${imat_sell_slice_height}_mat_sell_sigma-${imat_sell_sigma} ""
+         else
+            petsc_report_tapoutput "" ${label} "SKIP Command failed so no diff"
+         fi
+
+      done
+   done
+done
+
+petsc_testend "/root/repo/_gate_hdf5/tests" 
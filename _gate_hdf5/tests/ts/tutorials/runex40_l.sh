@@ -0,0 +1,60 @@
+#!/usr/bin/env bash
+# This script was created by gmakegentest.py
+
+
+
+# PATH for DLLs on windows
+PATH="$PATH":"/root/repo/_gate_hdf5/lib"
+
+exec='../ex40'
+testname='runex40_l'
+label='ts_tutorials-ex40_l'
+runfiles=''
+wPETSC_DIR='/root/repo'
+petsc_dir='/root/repo'
+petsc_arch='_gate_hdf5'
+# Must be consistent with gmakefile.test
+testlogtapfile=/root/repo/_gate_hdf5/tests/test_${petsc_arch}_tap.log
+testlogerrfile=/root/repo/_gate_hdf5/tests/test_${petsc_arch}_err.log
+config_dir='/root/repo/config'
+filter=''
+filter_output=''
+petsc_bindir='/root/repo/lib/petsc/bin'
+DATAFILESPATH=${DATAFILESPATH:-""}
+args='-rhs-form -ts_type rk -ts_rk_type 2a -ts_trajectory_dirname ex40_l_dir -ts_adapt_type dsp -ts_adapt_dt_min 0.01'
+diff_args=''
+timeoutfactor=1
+
+mpiexec=${PETSCMPIEXEC:-"mpiexec"}
+diffexec=${PETSCDIFF:-"${petsc_bindir}/petscdiff"}
+
+. "${config_dir}/petsc_harness.sh"
+
+# The diff flags come from script arguments
+diff_exe="${diffexec} ${diff_flags} ${diff_args}"
+mpiexec="${mpiexec} ${mpiexec_flags}"
+
+
+
+
+
+nsize_in=${nsize:-1}
+ts_adapt_always_accept_in=${ts_adapt_always_accept:-false true}
+
+
+for insize in ${nsize_in}; do
+   for its_adapt_always_accept in ${ts_adapt_always_accept_in}; do
+
+      petsc_testrun "${mpiexec} -n ${insize} ${exec} ${args}  -ts_adapt_always_accept ${its_adapt_always_accept}" ex40_l.tmp ${testname}.err "${label}+ts_adapt_always_accept-${its_adapt_always_accept}" 
+      res=$?
+
+      if test $res = 0; then
+         petsc_testrun "${diff_exe} /root/repo/src/ts/tutorials/output/ex40.out ex40_l.tmp" diff-${testname}.out diff-${testname}.out diff-${label}+ts_adapt_always_accept-${its_adapt_always_accept} ""
+      else
+         petsc_report_tapoutput "" ${label} "SKIP Command failed so no diff"
+      fi
+
+   done
+done
+
+petsc_testend "/root/repo/_gate_hdf5/tests" 
@@ -0,0 +1,72 @@
+#!/usr/bin/env bash
+# This script was created by gmakegentest.py
+
+
+
+# PATH for DLLs on windows
+PATH="$PATH":"/root/repo/_gate_hdf5/lib"
+
+exec='../ex5'
+testname='runex5_2_window'
+label='vec_is_sf_tests-ex5_2_window'
+runfiles=''
+wPETSC_DIR='/root/repo'
+petsc_dir='/root/repo'
+petsc_arch='_gate_hdf5'
+# Must be consistent with gmakefile.test
+testlogtapfile=/root/repo/_gate_hdf5/tests/test_${petsc_arch}_tap.log
+testlogerrfile=/root/repo/_gate_hdf5/tests/test_${petsc_arch}_err.log
+config_dir='/root/repo/config'
+filter='grep -v "type" | grep -v "sort"'
+filter_output=''
+petsc_bindir='/root/repo/lib/petsc/bin'
+DATAFILESPATH=${DATAFILESPATH:-""}
+args='-view -nl 5 -sf_type window'
+diff_args=''
+timeoutfactor=1
+
+mpiexec=${PETSCMPIEXEC:-"mpiexec"}
+diffexec=${PETSCDIFF:-"${petsc_bindir}/petscdiff"}
+
+. "${config_dir}/petsc_harness.sh"
+
+# The diff flags come from script arguments
+diff_exe="${diffexec} ${diff_flags} ${diff_args}"
+mpiexec="${mpiexec} ${mpiexec_flags}"
+
+
+
+if ! $force; then
+    petsc_report_tapoutput "" "${label}" "SKIP PETSC_HAVE_DEFINED(PETSC_HAVE_MPI_FEATURE_DYNAMIC_WINDOW) requirement not met"
+    total=1; skip=1
+    petsc_testend "/root/repo/_gate_hdf5/tests" 
+    exit
+fi
+
+
+nsize_in=${nsize:-7}
+explicit_inverse_in=${explicit_inverse:-0 1}
+sf_window_sync_in=${sf_window_sync:-fence lock active}
+sf_window_flavor_in=${sf_window_flavor:-create allocate}
+
+
+for insize in ${nsize_in}; do
+   for iexplicit_inverse in ${explicit_inverse_in}; do
+      for isf_window_sync in ${sf_window_sync_in}; do
+         for isf_window_flavor in ${sf_window_flavor_in}; do
+
+            petsc_testrun "${mpiexec} -n ${insize} ${exec} ${args}  -explicit_inverse ${iexplicit_inverse} -sf_window_sync ${isf_window_sync} -sf_window_flavor ${isf_window_flavor}" ex5_2_window.tmp ${testname}.err "${label}+explicit_inverse-${iexplicit_inverse}_sf_window_sync-${isf_window_sync}_sf_window_flavor-${isf_window_flavor}" 
+            res=$?
+
+            if test $res = 0; then
+               petsc_testrun "${diff_exe} /root/repo/src/vec/is/sf/tests/output/ex5_2.out ex5_2_window.tmp" diff-${testname}.out diff-${testname}.out diff-${label}+explicit_inverse-${iexplicit_inverse}_sf_window_sync-${isf_window_sync}_sf_window_flavor-${isf_window_flavor} ""
+            else
+               petsc_report_tapoutput "" ${label} "SKIP Command failed so no diff"
+            fi
+
+         done
+      done
+   done
+done
+
+petsc_testend "/root/repo/_gate_hdf5/tests" 
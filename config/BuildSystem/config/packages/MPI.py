@@ -416,6 +416,18 @@ Unable to run hostname to check the network')
                        if (MPI_Neighbor_alltoallv(0,0,0,MPI_INT,0,0,0,MPI_INT,distcomm));\n\
                        if (MPI_Ineighbor_alltoallv(0,0,0,MPI_INT,0,0,0,MPI_INT,distcomm,&req));\n'):
       self.addDefine('HAVE_MPI_NEIGHBORHOOD_COLLECTIVES',1)
+      # Persistent neighborhood collectives are in MPI-4; OpenMPI provides them earlier as an MPIX extension
+      if self.checkLink('#include <mpi.h>\n',
+                        'MPI_Comm distcomm; \n\
+                         MPI_Request req; \n\
+                         if (MPI_Neighbor_alltoallv_init(0,0,0,MPI_INT,0,0,0,MPI_INT,distcomm,MPI_INFO_NULL,&req));\n'):
+        self.addDefine('HAVE_MPI_PERSISTENT_NEIGHBORHOOD_COLLECTIVES',1)
+      elif hasattr(self, 'ompi_major_version') and self.checkLink('#include <mpi.h>\n#include <mpi-ext.h>\n',
+                        'MPI_Comm distcomm; \n\
+                         MPI_Request req; \n\
+                         if (MPIX_Neighbor_alltoallv_init(0,0,0,MPI_INT,0,0,0,MPI_INT,distcomm,MPI_INFO_NULL,&req));\n'):
+        self.addDefine('HAVE_MPI_PERSISTENT_NEIGHBORHOOD_COLLECTIVES',1)
+        self.addDefine('HAVE_MPIX_NEIGHBOR_ALLTOALLV_INIT',1)
     if hasattr(self, 'ompi_major_version'):
       openmpi_cuda_test = '#include<mpi.h>\n #include <mpi-ext.h>\n #if defined(MPIX_CUDA_AWARE_SUPPORT) && MPIX_CUDA_AWARE_SUPPORT\n #else\n #error This OpenMPI is not CUDA-aware\n #endif\n'
       if self.checkCompile(openmpi_cuda_test):
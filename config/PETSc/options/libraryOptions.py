@@ -44,8 +44,9 @@ class Configure(config.base.Configure):
     else:
       self.useThreadSafety = 0
 
-    if self.useThreadSafety and self.framework.argDB['with-log']:
-      raise RuntimeError('Must use --with-log=0 with --with-threadsafety')
+    # Events are logged per thread only in OpenMP parallel regions
+    if self.useThreadSafety and self.framework.argDB['with-log'] and not ('with-openmp' in self.framework.argDB and self.framework.argDB['with-openmp']):
+      raise RuntimeError('Must use --with-log=0 with --with-threadsafety, unless --with-openmp is used')
 
     if self.useThreadSafety and not ((self.sharedLibraries.useShared and self.setCompilers.dynamicLibraries) or self.framework.argDB['with-single-library']):
       raise RuntimeError('Must use --with-shared-libraries or --with-single-library with --with-threadsafety')
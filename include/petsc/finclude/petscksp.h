@@ -13,6 +13,7 @@
 #define KSPType character*(80)
 #define KSPGuessType character*(80)
 #define KSPCGType PetscEnum
+#define KSPSStepCGBasisType PetscEnum
 #define KSPFCDTruncationType PetscEnum
 #define KSPConvergedReason PetscEnum
 #define KSPNormType PetscEnum
@@ -32,6 +33,7 @@
 #define KSPPIPECGRR 'pipecgrr'
 #define KSPPIPELCG 'pipelcg'
 #define KSPPIPECG2 'pipecg2'
+#define KSPSSTEPCG 'sstepcg'
 #define KSPCGNE 'cgne'
 #define KSPNASH 'nash'
 #define KSPSTCG 'stcg'
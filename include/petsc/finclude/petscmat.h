@@ -184,6 +184,7 @@
 #define MATSOLVERMATLAB          'matlab'
 #define MATSOLVERPETSC           'petsc'
 #define MATSOLVERBAS             'bas'
+#define MATSOLVERCHOWILU         'chowilu'
 #define MATSOLVERCUSPARSE        'cusparse'
 #define MATSOLVERCUDA            'cuda'
 #define MATSOLVERKOKKOS          'kokkos'
@@ -98,4 +98,5 @@
 #define PCBDDCInterfaceExtType PetscEnum
 #define PCHPDDMCoarseCorrectionType PetscEnum
 #define PCFailedReason PetscEnum
+#define PCMatPrecision PetscEnum
 #endif
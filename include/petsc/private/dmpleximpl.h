@@ -46,6 +46,8 @@ PETSC_EXTERN PetscLogEvent DMPLEX_CreateFromFile;
 PETSC_EXTERN PetscLogEvent DMPLEX_BuildFromCellList;
 PETSC_EXTERN PetscLogEvent DMPLEX_BuildCoordinatesFromCellList;
 PETSC_EXTERN PetscLogEvent DMPLEX_LocatePoints;
+PETSC_EXTERN PetscLogEvent DMPLEX_CheckpointView;
+PETSC_EXTERN PetscLogEvent DMPLEX_CheckpointLoad;
 
 typedef struct _DMPlexCellRefinerOps *DMPlexCellRefinerOps;
 struct _DMPlexCellRefinerOps {
@@ -150,6 +152,7 @@ typedef struct {
   char                *triangleOpts;
   PetscPartitioner     partitioner;
   PetscBool            partitionBalance;  /* Evenly divide partition overlap when distributing */
+  DMPlexReorderLocalityType reorderLocality; /* Reorder the mesh points for locality after distributing */
   PetscBool            remeshBd;
 
   /* Submesh */
@@ -186,6 +189,9 @@ typedef struct {
   PetscErrorCode      (*useradjacency)(DM,PetscInt,PetscInt*,PetscInt[],void*); /* User callback for adjacency */
   void                *useradjacencyctx;  /* User context for callback */
 
+  /* Assembly */
+  PetscBool            closureDofIndex;     /* Cache the dof indices in the cell closures of the local section on first use */
+
   /* Projection */
   PetscInt             maxProjectionHeight; /* maximum height of cells used in DMPlexProject functions */
   PetscInt             activePoint;         /* current active point in iteration */
@@ -193,6 +199,7 @@ typedef struct {
   /* Output */
   PetscInt             vtkCellHeight;            /* The height of cells for output, default is 0 */
   PetscReal            scale[NUM_PETSC_UNITS];   /* The scale for each SI unit */
+  IS                   checkpointPoints;         /* The checkpoint number of each point, for a mesh loaded from a checkpoint */
 
   /* Geometry */
   PetscReal            minradius;         /* Minimum distance from cell centroid to face */
@@ -702,6 +709,7 @@ PETSC_INTERN PetscErrorCode DMPlexBasisTransformPoint_Internal(DM, DM, Vec, Pets
 PETSC_EXTERN PetscErrorCode DMPlexBasisTransformPointTensor_Internal(DM, DM, Vec, PetscInt, PetscBool, PetscInt, PetscScalar *);
 PETSC_INTERN PetscErrorCode DMPlexBasisTransformApplyReal_Internal(DM, const PetscReal[], PetscBool, PetscInt, const PetscReal *, PetscReal *, void *);
 PETSC_INTERN PetscErrorCode DMPlexBasisTransformApply_Internal(DM, const PetscReal[], PetscBool, PetscInt, const PetscScalar *, PetscScalar *, void *);
+PETSC_INTERN PetscErrorCode DMPlexSetUpMatrixFree_Internal(DM, Mat, PetscBool *);
 PETSC_INTERN PetscErrorCode DMCreateNeumannOverlap_Plex(DM, IS*, Mat*, PetscErrorCode (**)(Mat, PetscReal, Vec, Vec, PetscReal, IS, void*), void **);
 
 #endif /* _PLEXIMPL_H */
@@ -117,6 +117,18 @@ PETSC_EXTERN PetscErrorCode PetscKernel_A_gets_inverse_A_15(MatScalar*,PetscInt*
 */
 #define PetscKernel_A_gets_inverse_A(bs,A,pivots,W,allowzeropivot,zeropivotdetected) (PetscLINPACKgefa((A),(bs),(pivots),(allowzeropivot),(zeropivotdetected)) || PetscLINPACKgedi((A),(bs),(pivots),(W)))
 
+/*
+    A = inv(A) for PETSC_KERNEL_BATCH_SIZE blocks at once    A_gets_inverse_A_Batch
+
+   A      - the bs by bs blocks interleaved, entry (i,j) of block l is A[(i+j*bs)*PETSC_KERNEL_BATCH_SIZE+l]
+   pivots - integer work array of length bs
+   W      - work array of length (PETSC_KERNEL_BATCH_SIZE+1)*bs*bs+bs
+
+   Unused blocks of the batch should hold the identity
+*/
+#define PETSC_KERNEL_BATCH_SIZE 8
+PETSC_EXTERN PetscErrorCode PetscKernel_A_gets_inverse_A_Batch(PetscInt,MatScalar*,PetscInt*,MatScalar*,PetscBool,PetscBool*);
+
 /* -----------------------------------------------------------------------*/
 
 #if !defined(PETSC_USE_REAL_MAT_SINGLE)
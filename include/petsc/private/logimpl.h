@@ -66,6 +66,8 @@ PETSC_EXTERN PetscErrorCode PetscEventPerfLogCreate(PetscEventPerfLog *);
 PETSC_EXTERN PetscErrorCode PetscEventPerfLogDestroy(PetscEventPerfLog);
 /* General functions */
 PETSC_EXTERN PetscErrorCode PetscEventPerfLogEnsureSize(PetscEventPerfLog, int);
+PETSC_EXTERN PetscErrorCode PetscEventPerfLogMergeThreads(PetscEventPerfLog);
+PETSC_INTERN PetscErrorCode PetscLogMergeThreadFlops(void);
 PETSC_EXTERN PetscErrorCode PetscEventPerfInfoClear(PetscEventPerfInfo *);
 PETSC_EXTERN PetscErrorCode PetscEventPerfInfoCopy(PetscEventPerfInfo *, PetscEventPerfInfo *);
 /* Registration functions */
@@ -128,4 +130,13 @@ PETSC_EXTERN PetscErrorCode PetscEventRegLogGetEvent(PetscEventRegLog, const cha
 PETSC_INTERN PetscErrorCode PetscLogView_Nested(PetscViewer);
 PETSC_INTERN PetscErrorCode PetscLogNestedEnd(void);
 PETSC_INTERN PetscErrorCode PetscLogView_Flamegraph(PetscViewer);
+PETSC_INTERN PetscErrorCode PetscLogView_ChromeTrace(PetscViewer);
+/* Hardware performance counters */
+PETSC_EXTERN const char *const PetscLogPerfCounterNames[];
+PETSC_INTERN PetscErrorCode PetscLogPerfCountersBegin(void);
+PETSC_INTERN PetscErrorCode PetscLogPerfCountersEnd(void);
+PETSC_EXTERN PetscErrorCode PetscLogPerfCountersGetAvailable(PetscBool[]);
+PETSC_INTERN PetscErrorCode PetscLogPerfCountersRead(PetscLogDouble[]);
+PETSC_INTERN PetscErrorCode PetscLogChromeTraceEnd(void);
+PETSC_INTERN PetscErrorCode PetscLogChromeTraceStage_Private(PetscLogStage,PetscBool);
 #endif /* PETSC_USE_LOG */
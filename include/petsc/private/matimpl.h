@@ -309,6 +309,11 @@ typedef struct {
   char        pending;
 } MatStashFrame;
 
+typedef struct {
+  PetscSegBuffer row,col;       /* Global row/column numbers stashed by one thread */
+  PetscSegBuffer val;           /* Values stashed by one thread */
+} MatStashThread;
+
 typedef struct _MatStash MatStash;
 struct _MatStash {
   PetscInt      nmax;                   /* maximum stash size */
@@ -318,6 +323,8 @@ struct _MatStash {
   PetscInt      bs;                     /* block size of the stash */
   PetscInt      reallocs;               /* preserve the no of mallocs invoked */
   PetscMatStashSpace space_head,space;  /* linked list to hold stashed global row/column numbers and matrix values */
+  PetscInt      nthreads;               /* number of per-thread stashes, used with OpenMP and thread safety */
+  MatStashThread *threads;              /* per-thread stashes filled in parallel regions, merged in MatStashScatterBegin_Private() */
 
   PetscErrorCode (*ScatterBegin)(Mat,MatStash*,PetscInt*);
   PetscErrorCode (*ScatterGetMesg)(MatStash*,PetscMPIInt*,PetscInt**,PetscInt**,PetscScalar**,PetscInt*);
@@ -21,7 +21,12 @@ typedef struct gamg_TAG {
   PCGAMGType type;
   PetscInt  Nlevels;
   PetscBool repart;
+  PetscBool node_aware_reduction;
   PetscBool reuse_prol;
+  PetscBool reuse_aggs;
+  PetscReal recoarsen_factor;
+  PetscInt  base_its,last_its; /* iterations of the first and of the last solve since the aggregates were built */
+  PetscInt  ncoarsen,nrefresh;
   PetscBool use_aggs_in_asm;
   PetscBool use_parallel_coarse_grid_solver;
   PCGAMGLayoutType layout_type;
@@ -40,6 +45,7 @@ typedef struct gamg_TAG {
   PetscInt  orig_data_cell_cols;
   PetscReal *data;          /* [data_sz] blocked vector of vertex data on fine grid (coordinates/nullspace) */
   PetscReal *orig_data;          /* cache data */
+  Mat       Prol0[PETSC_MG_MAXLEVELS]; /* tentative prolongators, kept to smooth them again with new operators */
 
   struct _PCGAMGOps *ops;
   char      *gamg_type_name;
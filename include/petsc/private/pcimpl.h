@@ -45,6 +45,8 @@ struct _p_PC {
   PetscInt         setfromoptionscalled;
   PetscBool        erroriffailure;                      /* Generate an error if FPE detected (for example a zero pivot) instead of returning*/
   Mat              mat,pmat;
+  PCMatPrecision   matprecision;                      /* precision of the values of pmat */
+  Mat              pmatuser;                          /* Pmat of the user when pmat is a copy of it converted to matprecision */
   Vec              diagonalscaleright,diagonalscaleleft; /* used for time integration scaling */
   PetscBool        diagonalscale;
   PetscBool        useAmat; /* used by several PC that including applying the operator inside the preconditioner */
@@ -64,6 +64,7 @@ typedef struct {
   PetscBool           mespMonitor;            /* flag to monitor the multilevel eigensolver */
 
   PetscBool           compatibleRelaxation;   /* flag to monitor the coarse space quality using an auxiliary solve with compatible relaxation */
+  PetscBool           estEigReuse;            /* flag to reuse the eigenvalue estimates of the Chebyshev smoothers while they are valid */
 
   PetscInt     nlevels;
   PC_MG_Levels **levels;
@@ -197,6 +197,7 @@ struct _p_PetscFE {
   PetscTabulation Tc;                    /* Tabulation of basis at face centroids */
   PetscInt        blockSize, numBlocks;  /* Blocks are processed concurrently */
   PetscInt        batchSize, numBatches; /* A batch is made up of blocks, Batches are processed in serial */
+  PetscBool       batched;               /* Evaluate the residual on a batch of cells at once, with the cell index innermost */
   PetscBool       setupcalled;
 };
 
@@ -44,6 +44,11 @@ struct _p_PetscSection {
   PetscClPerm                   clHash;       /* Hash of (depth, size) to perm and invPerm */
   PetscSection                  clSection;    /* Section giving the number of points in each closure */
   IS                            clPoints;     /* Points in each closure */
+  PetscObject                   clDofObj;     /* Key for the closure dof index */
+  PetscSection                  clDofSection; /* Section giving the number of dofs in the closure of each indexed point */
+  PetscInt                     *clDofs;       /* Local offsets of the dofs in each closure, -(off+1) for constrained dofs */
+  PetscSection                  clIdxSection; /* Section, usually global, whose offsets are stored in clIdxDofs */
+  PetscInt                     *clIdxDofs;    /* Offsets in clIdxSection of the dofs in each closure */
   PetscSectionSym               sym;          /* Symmetries of the data */
 };
 
@@ -73,6 +78,8 @@ struct _p_PetscSectionSym {
 PETSC_EXTERN PetscErrorCode PetscSectionSetClosurePermutation_Internal(PetscSection, PetscObject, PetscInt, PetscInt, PetscCopyMode, PetscInt *);
 PETSC_EXTERN PetscErrorCode PetscSectionGetClosurePermutation_Internal(PetscSection, PetscObject, PetscInt, PetscInt, const PetscInt *[]);
 PETSC_EXTERN PetscErrorCode PetscSectionGetClosureInversePermutation_Internal(PetscSection, PetscObject, PetscInt, PetscInt, const PetscInt *[]);
+PETSC_EXTERN PetscErrorCode PetscSectionSetClosureDofIndex_Internal(PetscSection, PetscObject, PetscSection, PetscSection, PetscInt *);
+PETSC_EXTERN PetscErrorCode PetscSectionGetClosureDofIndex_Internal(PetscSection, PetscObject, PetscSection, PetscSection *, const PetscInt *[]);
 PETSC_EXTERN PetscErrorCode ISIntersect_Caching_Internal(IS, IS, IS *);
 
 #endif
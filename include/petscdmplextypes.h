@@ -31,4 +31,20 @@ E*/
 typedef enum {DM_REFINER_REGULAR, DM_REFINER_TO_BOX, DM_REFINER_TO_SIMPLEX, DM_REFINER_ALFELD2D, DM_REFINER_ALFELD3D, DM_REFINER_POWELL_SABIN, DM_REFINER_BOUNDARYLAYER, DM_REFINER_SBR} DMPlexCellRefinerType;
 PETSC_EXTERN const char * const DMPlexCellRefinerTypes[];
 
+/*E
+  DMPlexReorderLocalityType - This describes the ordering of the mesh points made for memory locality after distribution.
+
+  Level: intermediate
+
+  The cells are ordered, then the faces, edges and vertices are numbered in the order the cells first touch them.
+$ DMPLEX_REORDER_LOCALITY_NONE    - Keep the ordering made by the distribution
+$ DMPLEX_REORDER_LOCALITY_RCM     - Order the cells by Reverse Cuthill-McKee on the cell adjacency graph
+$ DMPLEX_REORDER_LOCALITY_HILBERT - Order the cells along a Hilbert curve through the cell centroids
+$ DMPLEX_REORDER_LOCALITY_MORTON  - Order the cells along a Morton (Z-order) curve through the cell centroids
+
+.seealso: DMPlexSetReorderLocality(), DMPlexGetLocalityOrdering(), DMPlexDistribute()
+E*/
+typedef enum {DMPLEX_REORDER_LOCALITY_NONE, DMPLEX_REORDER_LOCALITY_RCM, DMPLEX_REORDER_LOCALITY_HILBERT, DMPLEX_REORDER_LOCALITY_MORTON} DMPlexReorderLocalityType;
+PETSC_EXTERN const char * const DMPlexReorderLocalityTypes[];
+
 #endif
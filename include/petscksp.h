@@ -38,6 +38,7 @@ typedef const char* KSPType;
 #define KSPPIPELCG     "pipelcg"
 #define KSPPIPEPRCG    "pipeprcg"
 #define KSPPIPECG2     "pipecg2"
+#define KSPSSTEPCG     "sstepcg"
 #define   KSPCGNE       "cgne"
 #define   KSPNASH       "nash"
 #define   KSPSTCG       "stcg"
@@ -184,6 +185,7 @@ PETSC_EXTERN PetscErrorCode KSPRichardsonSetSelfScale(KSP,PetscBool);
 PETSC_EXTERN PetscErrorCode KSPChebyshevSetEigenvalues(KSP,PetscReal,PetscReal);
 PETSC_EXTERN PetscErrorCode KSPChebyshevEstEigSet(KSP,PetscReal,PetscReal,PetscReal,PetscReal);
 PETSC_EXTERN PetscErrorCode KSPChebyshevEstEigSetUseNoisy(KSP,PetscBool);
+PETSC_EXTERN PetscErrorCode KSPChebyshevEstEigSetReuse(KSP,PetscBool,PetscReal);
 PETSC_EXTERN PetscErrorCode KSPChebyshevEstEigGetKSP(KSP,KSP*);
 PETSC_EXTERN PetscErrorCode KSPComputeExtremeSingularValues(KSP,PetscReal*,PetscReal*);
 PETSC_EXTERN PetscErrorCode KSPComputeEigenvalues(KSP,PetscInt,PetscReal[],PetscReal[],PetscInt*);
@@ -237,6 +239,7 @@ PETSC_EXTERN PetscErrorCode KSPGMRESSetOrthogonalization(KSP,PetscErrorCode (*)(
 PETSC_EXTERN PetscErrorCode KSPGMRESGetOrthogonalization(KSP,PetscErrorCode (**)(KSP,PetscInt));
 PETSC_EXTERN PetscErrorCode KSPGMRESModifiedGramSchmidtOrthogonalization(KSP,PetscInt);
 PETSC_EXTERN PetscErrorCode KSPGMRESClassicalGramSchmidtOrthogonalization(KSP,PetscInt);
+PETSC_EXTERN PetscErrorCode KSPGMRESLowSyncGramSchmidtOrthogonalization(KSP,PetscInt);
 
 PETSC_EXTERN PetscErrorCode KSPLGMRESSetAugDim(KSP,PetscInt);
 PETSC_EXTERN PetscErrorCode KSPLGMRESSetConstant(KSP);
@@ -728,6 +731,22 @@ PETSC_EXTERN PetscErrorCode KSPCGSetRadius(KSP,PetscReal);
 PETSC_EXTERN PetscErrorCode KSPCGGetNormD(KSP,PetscReal*);
 PETSC_EXTERN PetscErrorCode KSPCGGetObjFcn(KSP,PetscReal*);
 
+/*E
+    KSPSStepCGBasisType - The polynomial basis used by KSPSSTEPCG to generate the Krylov space
+
+   Level: intermediate
+
+.seealso: KSPSStepCGSetBasisType(), KSPSSTEPCG
+E*/
+typedef enum {KSP_SSTEPCG_BASIS_MONOMIAL,KSP_SSTEPCG_BASIS_NEWTON,KSP_SSTEPCG_BASIS_CHEBYSHEV} KSPSStepCGBasisType;
+PETSC_EXTERN const char *const KSPSStepCGBasisTypes[];
+
+PETSC_EXTERN PetscErrorCode KSPSStepCGSetSteps(KSP,PetscInt);
+PETSC_EXTERN PetscErrorCode KSPSStepCGGetSteps(KSP,PetscInt*);
+PETSC_EXTERN PetscErrorCode KSPSStepCGSetBasisType(KSP,KSPSStepCGBasisType);
+PETSC_EXTERN PetscErrorCode KSPSStepCGGetBasisType(KSP,KSPSStepCGBasisType*);
+PETSC_EXTERN PetscErrorCode KSPSStepCGSetEigenvalues(KSP,PetscReal,PetscReal);
+
 PETSC_EXTERN PetscErrorCode KSPGLTRGetMinEig(KSP,PetscReal*);
 PETSC_EXTERN PetscErrorCode KSPGLTRGetLambda(KSP,PetscReal*);
 PETSC_DEPRECATED_FUNCTION("Use KSPGLTRGetMinEig (since v3.12)") PETSC_STATIC_INLINE PetscErrorCode KSPCGGLTRGetMinEig(KSP ksp,PetscReal *x) {return KSPGLTRGetMinEig(ksp,x);}
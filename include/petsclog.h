@@ -6,6 +6,9 @@
 #define PETSCLOG_H
 #include <petscsys.h>
 #include <petsctime.h>
+#if defined(PETSC_HAVE_OPENMP) && defined(_OPENMP)
+#include <omp.h>
+#endif
 
 /* General logging of information; different from event logging */
 PETSC_EXTERN PetscErrorCode PetscInfo_Private(const char[],PetscObject,const char[],...);
@@ -94,6 +97,13 @@ PETSC_EXTERN PetscLogEvent PETSC_LARGEST_EVENT;
 /* Global flop counter */
 PETSC_EXTERN PetscLogDouble petsc_TotalFlops;
 PETSC_EXTERN PetscLogDouble petsc_tmp_flops;
+#if defined(PETSC_HAVE_OPENMP)
+/* Flop counters of the OpenMP threads in a parallel region, PETSC_LOG_THREAD_FLOPS_STRIDE apart so each thread has its own cache line;
+   the first entry of a thread counts all its flops and the second its GPU flops. They are added to petsc_TotalFlops outside of parallel regions */
+#define PETSC_LOG_THREAD_FLOPS_STRIDE 8
+PETSC_EXTERN int            petsc_numThreadFlops;
+PETSC_EXTERN PetscLogDouble *petsc_threadFlops;
+#endif
 
 /* We must make the following structures available to access the event
      activation flags in the PetscLogEventBegin/End() macros. These are not part of the PETSc public
@@ -143,6 +153,9 @@ struct _n_PetscClassPerfLog {
        static information about it, the second collects statistics on how many times the event is used, how
        much time it takes, etc.
 
+    PetscEventThreadInfo - The statistics of an event called by an OpenMP thread inside a parallel region. Each thread updates
+       its own copy without synchronization, and the copies are merged into the PetscEventPerfInfo by PetscLogView().
+
     PetscEventRegLog, PetscEventPerfLog - an array of all PetscEventRegInfo and PetscEventPerfInfo for all events. There is one
       of these for each stage.
 
@@ -157,6 +170,8 @@ typedef struct {
 #endif
 } PetscEventRegInfo;
 
+#define PETSC_LOG_NUM_PERF_COUNTERS 3
+
 typedef struct {
   int            id;            /* The integer identifying this event */
   PetscBool      active;        /* The flag to activate logging */
@@ -175,6 +190,7 @@ typedef struct {
   PetscLogDouble mallocIncrease;/* How much the maximum malloced space has increased in this event */
   PetscLogDouble mallocSpace;   /* How much the space was malloced and kept during this event */
   PetscLogDouble mallocIncreaseEvent;  /* Maximum of the high water mark with in event minus memory available at the end of the event */
+  PetscLogDouble perfCounters[PETSC_LOG_NUM_PERF_COUNTERS]; /* The cycles, instructions and last level cache misses counted by the hardware in this event */
   #if defined(PETSC_HAVE_DEVICE)
   PetscLogDouble CpuToGpuCount; /* The total number of CPU to GPU copies */
   PetscLogDouble GpuToCpuCount; /* The total number of GPU to CPU copies */
@@ -185,6 +201,16 @@ typedef struct {
   #endif
 } PetscEventPerfInfo;
 
+typedef struct {
+  int            depth;         /* The nesting depth of the event call by this thread */
+  int            count;         /* The number of times this event was executed by this thread */
+  PetscLogDouble time, timeTmp; /* The time taken for this event by this thread */
+  PetscLogDouble flops, flopsTmp; /* The flops used in this event by this thread */
+  int            countMerged;   /* The count already merged into the PetscEventPerfInfo */
+  PetscLogDouble timeMerged;    /* The time already merged into the PetscEventPerfInfo */
+  PetscLogDouble flopsMerged;   /* The flops already merged into the PetscEventPerfInfo */
+} PetscEventThreadInfo;
+
 typedef struct _n_PetscEventRegLog *PetscEventRegLog;
 struct _n_PetscEventRegLog {
   int               numEvents;  /* The number of registered events */
@@ -194,9 +220,11 @@ struct _n_PetscEventRegLog {
 
 typedef struct _n_PetscEventPerfLog *PetscEventPerfLog;
 struct _n_PetscEventPerfLog {
-  int                numEvents;  /* The number of logging events */
-  int                maxEvents;  /* The maximum number of events */
-  PetscEventPerfInfo *eventInfo; /* The performance information for each event */
+  int                  numEvents;   /* The number of logging events */
+  int                  maxEvents;   /* The maximum number of events */
+  PetscEventPerfInfo   *eventInfo;  /* The performance information for each event */
+  int                  numThreads;  /* The number of OpenMP threads with their own event information */
+  PetscEventThreadInfo *threadInfo; /* The information for each thread and event, with stride maxEvents */
 };
 /* ------------------------------------------------------------------------------------------------------------*/
 /*
@@ -262,6 +290,9 @@ PETSC_EXTERN PetscErrorCode PetscStageLogGetEventPerfLog(PetscStageLog,int,Petsc
      To limit the chance of integer overflow when multiplying by a constant, represent the constant as a double,
      not an integer. Use PetscLogFlops(4.0*n) not PetscLogFlops(4*n)
 
+     OpenMP threads in a parallel region add to their own counter, which is added to the total outside of parallel regions.
+     This requires the calling code to be compiled with OpenMP.
+
    Level: intermediate
 
 .seealso: PetscLogView(), PetscLogGpuFlops()
@@ -272,6 +303,19 @@ PETSC_STATIC_INLINE PetscErrorCode PetscLogFlops(PetscLogDouble n)
   PetscFunctionBegin;
 #if defined(PETSC_USE_DEBUG)
   if (n < 0) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"Cannot log negative flops");
+#endif
+#if defined(PETSC_HAVE_OPENMP) && defined(_OPENMP)
+  /* Threads in a parallel region count in their own counter, which is added to petsc_TotalFlops after the region */
+  if (omp_in_parallel()) {
+    int tid = omp_get_thread_num();
+
+    if (omp_get_level() == 1 && tid < petsc_numThreadFlops) petsc_threadFlops[tid*PETSC_LOG_THREAD_FLOPS_STRIDE] += PETSC_FLOPS_PER_OP*n;
+    else {
+#pragma omp atomic
+      petsc_TotalFlops += PETSC_FLOPS_PER_OP*n;
+    }
+    PetscFunctionReturn(0);
+  }
 #endif
   petsc_TotalFlops += PETSC_FLOPS_PER_OP*n;
   PetscFunctionReturn(0);
@@ -324,6 +368,22 @@ PETSC_STATIC_INLINE PetscErrorCode PetscLogGpuFlops(PetscLogDouble n)
   PetscFunctionBegin;
 #if defined(PETSC_USE_DEBUG)
   if (n < 0) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"Cannot log negative flops");
+#endif
+#if defined(PETSC_HAVE_OPENMP) && defined(_OPENMP)
+  if (omp_in_parallel()) {
+    int tid = omp_get_thread_num();
+
+    if (omp_get_level() == 1 && tid < petsc_numThreadFlops) {
+      petsc_threadFlops[tid*PETSC_LOG_THREAD_FLOPS_STRIDE]   += PETSC_FLOPS_PER_OP*n;
+      petsc_threadFlops[tid*PETSC_LOG_THREAD_FLOPS_STRIDE+1] += PETSC_FLOPS_PER_OP*n;
+    } else {
+#pragma omp atomic
+      petsc_TotalFlops += PETSC_FLOPS_PER_OP*n;
+#pragma omp atomic
+      petsc_gflops += PETSC_FLOPS_PER_OP*n;
+    }
+    PetscFunctionReturn(0);
+  }
 #endif
   petsc_TotalFlops += PETSC_FLOPS_PER_OP*n;
   petsc_gflops += PETSC_FLOPS_PER_OP*n;
@@ -403,6 +463,7 @@ PETSC_EXTERN PetscErrorCode PetscLogObjectState(PetscObject, const char[], ...);
 PETSC_EXTERN PetscErrorCode PetscLogDefaultBegin(void);
 PETSC_EXTERN PetscErrorCode PetscLogAllBegin(void);
 PETSC_EXTERN PetscErrorCode PetscLogNestedBegin(void);
+PETSC_EXTERN PetscErrorCode PetscLogChromeTraceBegin(void);
 PETSC_EXTERN PetscErrorCode PetscLogTraceBegin(FILE *);
 PETSC_EXTERN PetscErrorCode PetscLogActions(PetscBool);
 PETSC_EXTERN PetscErrorCode PetscLogObjects(PetscBool);
@@ -460,6 +521,7 @@ PETSC_EXTERN PetscLogDouble petsc_wait_all_ct;
 PETSC_EXTERN PetscLogDouble petsc_sum_of_waits_ct;
 
 PETSC_EXTERN PetscBool      PetscLogMemory;
+PETSC_EXTERN PetscBool      PetscLogPerfCounters;
 
 PETSC_EXTERN PetscBool PetscLogSyncOn;  /* true if logging synchronization is enabled */
 PETSC_EXTERN PetscErrorCode PetscLogEventSynchronize(PetscLogEvent, MPI_Comm);
@@ -637,6 +699,10 @@ PETSC_STATIC_INLINE int PetscMPIParallelComm(MPI_Comm comm)
 #define MPI_Start_neighbor_alltoallv(outdegree,indegree,sendbuf,sendcnts,sdispls,sendtype,recvbuf,recvcnts,rdispls,recvtype,comm) \
   ((petsc_isend_ct += (PetscLogDouble)(outdegree),0) || (petsc_irecv_ct += (PetscLogDouble)(indegree),0) || PetscMPITypeSizeCount((outdegree),(sendcnts),(sendtype),(&petsc_isend_len)) || PetscMPITypeSizeCount((indegree),(recvcnts),(recvtype),(&petsc_irecv_len)) || (((outdegree) || (indegree)) && MPI_Neighbor_alltoallv((sendbuf),(sendcnts),(sdispls),(sendtype),(recvbuf),(recvcnts),(rdispls),(recvtype),(comm))))
 
+/* Start a persistent request created by MPI_Neighbor_alltoallv_init(), logged the same way as MPI_Start_ineighbor_alltoallv() */
+#define MPI_Start_persistent_neighbor_alltoallv(outdegree,indegree,sendcnts,sendtype,recvcnts,recvtype,request) \
+  ((petsc_isend_ct += (PetscLogDouble)(outdegree),0) || (petsc_irecv_ct += (PetscLogDouble)(indegree),0) || PetscMPITypeSizeCount((outdegree),(sendcnts),(sendtype),(&petsc_isend_len)) || PetscMPITypeSizeCount((indegree),(recvcnts),(recvtype),(&petsc_irecv_len)) || (((outdegree) || (indegree)) && MPI_Start((request))))
+
 #else
 
 #define MPI_Startall_irecv(count,datatype,number,requests) \
@@ -654,11 +720,15 @@ PETSC_STATIC_INLINE int PetscMPIParallelComm(MPI_Comm comm)
 #define MPI_Start_neighbor_alltoallv(outdegree,indegree,sendbuf,sendcnts,sdispls,sendtype,recvbuf,recvcnts,rdispls,recvtype,comm) \
   (((outdegree) || (indegree)) && MPI_Neighbor_alltoallv((sendbuf),(sendcnts),(sdispls),(sendtype),(recvbuf),(recvcnts),(rdispls),(recvtype),(comm)))
 
+#define MPI_Start_persistent_neighbor_alltoallv(outdegree,indegree,sendcnts,sendtype,recvcnts,recvtype,request) \
+  (((outdegree) || (indegree)) && MPI_Start((request)))
+
 #endif /* !MPIUNI_H && ! PETSC_HAVE_BROKEN_RECURSIVE_MACRO */
 
 #else  /* ---Logging is turned off --------------------------------------------*/
 
 #define PetscLogMemory                     PETSC_FALSE
+#define PetscLogPerfCounters               PETSC_FALSE
 
 #define PetscLogFlops(n)                   0
 #define PetscGetFlops(a)                   (*(a) = 0.0,0)
@@ -701,6 +771,7 @@ PETSC_EXTERN PetscErrorCode PetscLogObjectState(PetscObject,const char[],...);
 #define PetscLogDefaultBegin()             0
 #define PetscLogAllBegin()                 0
 #define PetscLogNestedBegin()              0
+#define PetscLogChromeTraceBegin()         0
 #define PetscLogTraceBegin(file)           0
 #define PetscLogActions(a)                 0
 #define PetscLogObjects(a)                 0
@@ -732,6 +803,8 @@ PETSC_EXTERN PetscErrorCode PetscLogObjectState(PetscObject,const char[],...);
   (((outdegree) || (indegree)) && MPI_Ineighbor_alltoallv((sendbuf),(sendcnts),(sdispls),(sendtype),(recvbuf),(recvcnts),(rdispls),(recvtype),(comm),(request)))
 #define MPI_Start_neighbor_alltoallv(outdegree,indegree,sendbuf,sendcnts,sdispls,sendtype,recvbuf,recvcnts,rdispls,recvtype,comm) \
   (((outdegree) || (indegree)) && MPI_Neighbor_alltoallv((sendbuf),(sendcnts),(sdispls),(sendtype),(recvbuf),(recvcnts),(rdispls),(recvtype),(comm)))
+#define MPI_Start_persistent_neighbor_alltoallv(outdegree,indegree,sendcnts,sendtype,recvcnts,recvtype,request) \
+  (((outdegree) || (indegree)) && MPI_Start((request)))
 
 #endif   /* PETSC_USE_LOG */
 
@@ -37,6 +37,7 @@ typedef const char* MatType;
 #define MATAIJCRL          "aijcrl"
 #define MATSEQAIJCRL       "seqaijcrl"
 #define MATMPIAIJCRL       "mpiaijcrl"
+#define MATSEQAIJSINGLE    "seqaijsingle"
 #define MATAIJCUSPARSE     "aijcusparse"
 #define MATSEQAIJCUSPARSE  "seqaijcusparse"
 #define MATMPIAIJCUSPARSE  "mpiaijcusparse"
@@ -142,6 +143,7 @@ typedef const char* MatSolverType;
 #define MATSOLVERMATLAB           "matlab"
 #define MATSOLVERPETSC            "petsc"
 #define MATSOLVERBAS              "bas"
+#define MATSOLVERCHOWILU          "chowilu"
 #define MATSOLVERCUSPARSE         "cusparse"
 #define MATSOLVERCUSPARSEBAND     "cusparseband"
 #define MATSOLVERCUDA             "cuda"
@@ -295,6 +297,8 @@ PETSC_EXTERN PetscErrorCode MatCreateSeqSELL(MPI_Comm,PetscInt,PetscInt,PetscInt
 PETSC_EXTERN PetscErrorCode MatCreateSELL(MPI_Comm,PetscInt,PetscInt,PetscInt,PetscInt,PetscInt,const PetscInt[],PetscInt,const PetscInt[],Mat*);
 PETSC_EXTERN PetscErrorCode MatSeqSELLSetPreallocation(Mat,PetscInt,const PetscInt[]);
 PETSC_EXTERN PetscErrorCode MatMPISELLSetPreallocation(Mat,PetscInt,const PetscInt[],PetscInt,const PetscInt[]);
+PETSC_EXTERN PetscErrorCode MatSELLSetSliceHeight(Mat,PetscInt);
+PETSC_EXTERN PetscErrorCode MatSELLSetSigma(Mat,PetscInt);
 
 PETSC_EXTERN PetscErrorCode MatCreateSeqDense(MPI_Comm,PetscInt,PetscInt,PetscScalar[],Mat*);
 PETSC_EXTERN PetscErrorCode MatCreateDense(MPI_Comm,PetscInt,PetscInt,PetscInt,PetscInt,PetscScalar[],Mat*);
@@ -467,7 +471,9 @@ typedef enum {MAT_OPTION_MIN = -3,
               MAT_STRUCTURE_ONLY = 22,
               MAT_SORTED_FULL = 23,
               MAT_FORM_EXPLICIT_TRANSPOSE = 24,
-              MAT_OPTION_MAX = 25} MatOption;
+              MAT_AUTOTUNE_MULT = 25,
+              MAT_SOR_MULTICOLOR = 26,
+              MAT_OPTION_MAX = 27} MatOption;
 
 PETSC_EXTERN const char *const *MatOptions;
 PETSC_EXTERN PetscErrorCode MatSetOption(Mat,MatOption,PetscBool);
@@ -36,6 +36,7 @@ PETSC_EXTERN const char *const PCExoticTypes[];
 PETSC_EXTERN const char *const PCPatchConstructTypes[];
 PETSC_EXTERN const char *const PCDeflationTypes[];
 PETSC_EXTERN const char *const *const PCFailedReasons;
+PETSC_EXTERN const char *const PCMatPrecisions[];
 
 PETSC_EXTERN PetscErrorCode PCCreate(MPI_Comm,PC*);
 PETSC_EXTERN PetscErrorCode PCSetType(PC,PCType);
@@ -58,6 +59,8 @@ PETSC_EXTERN PetscErrorCode PCApplyTransposeExists(PC,PetscBool *);
 PETSC_EXTERN PetscErrorCode PCApplyBAorABTranspose(PC,PCSide,Vec,Vec,Vec);
 PETSC_EXTERN PetscErrorCode PCSetReusePreconditioner(PC,PetscBool);
 PETSC_EXTERN PetscErrorCode PCGetReusePreconditioner(PC,PetscBool*);
+PETSC_EXTERN PetscErrorCode PCSetMatPrecision(PC,PCMatPrecision);
+PETSC_EXTERN PetscErrorCode PCGetMatPrecision(PC,PCMatPrecision*);
 PETSC_EXTERN PetscErrorCode PCSetErrorIfFailure(PC,PetscBool);
 
 #define PC_FILE_CLASSID 1211222
@@ -124,6 +127,8 @@ PETSC_EXTERN PetscErrorCode PCSORSetOmega(PC,PetscReal);
 PETSC_EXTERN PetscErrorCode PCSORGetOmega(PC,PetscReal*);
 PETSC_EXTERN PetscErrorCode PCSORSetIterations(PC,PetscInt,PetscInt);
 PETSC_EXTERN PetscErrorCode PCSORGetIterations(PC,PetscInt*,PetscInt*);
+PETSC_EXTERN PetscErrorCode PCSORSetMulticolor(PC,PetscBool);
+PETSC_EXTERN PetscErrorCode PCSORGetMulticolor(PC,PetscBool*);
 
 PETSC_EXTERN PetscErrorCode PCEisenstatSetOmega(PC,PetscReal);
 PETSC_EXTERN PetscErrorCode PCEisenstatGetOmega(PC,PetscReal*);
@@ -293,6 +298,7 @@ PETSC_EXTERN PetscErrorCode PCGAMGGetType(PC,PCGAMGType*);
 PETSC_EXTERN PetscErrorCode PCGAMGSetProcEqLim(PC,PetscInt);
 
 PETSC_EXTERN PetscErrorCode PCGAMGSetRepartition(PC,PetscBool);
+PETSC_EXTERN PetscErrorCode PCGAMGSetNodeAwareReduction(PC,PetscBool);
 PETSC_EXTERN PetscErrorCode PCGAMGSetUseSAEstEig(PC,PetscBool);
 PETSC_EXTERN PetscErrorCode PCGAMGSetEstEigKSPMaxIt(PC,PetscInt);
 PETSC_EXTERN PetscErrorCode PCGAMGSetEstEigKSPType(PC,char[]);
@@ -310,6 +316,8 @@ PETSC_EXTERN PetscErrorCode PCGAMGSetNSmooths(PC,PetscInt);
 PETSC_EXTERN PetscErrorCode PCGAMGSetSymGraph(PC,PetscBool);
 PETSC_EXTERN PetscErrorCode PCGAMGSetSquareGraph(PC,PetscInt);
 PETSC_EXTERN PetscErrorCode PCGAMGSetReuseInterpolation(PC,PetscBool);
+PETSC_EXTERN PetscErrorCode PCGAMGSetReuseAggregates(PC,PetscBool);
+PETSC_EXTERN PetscErrorCode PCGAMGSetRecoarsenFactor(PC,PetscReal);
 PETSC_EXTERN PetscErrorCode PCGAMGFinalizePackage(void);
 PETSC_EXTERN PetscErrorCode PCGAMGInitializePackage(void);
 PETSC_EXTERN PetscErrorCode PCGAMGRegister(PCGAMGType,PetscErrorCode (*)(PC));
@@ -365,6 +373,8 @@ PETSC_EXTERN PetscErrorCode PCMGGetGalerkin(PC,PCMGGalerkinType*);
 PETSC_EXTERN PetscErrorCode PCMGSetAdaptInterpolation(PC,PetscBool);
 PETSC_EXTERN PetscErrorCode PCMGGetAdaptInterpolation(PC,PetscBool*);
 PETSC_EXTERN PetscErrorCode PCMGSetAdaptCR(PC,PetscBool);
+PETSC_EXTERN PetscErrorCode PCMGSetEstEigReuse(PC,PetscBool);
+PETSC_EXTERN PetscErrorCode PCMGGetEstEigReuse(PC,PetscBool*);
 PETSC_EXTERN PetscErrorCode PCMGGetAdaptCR(PC,PetscBool*);
 
 PETSC_EXTERN PetscErrorCode PCMGSetRhs(PC,PetscInt,Vec);
@@ -393,6 +393,20 @@ typedef enum { PC_HPDDM_COARSE_CORRECTION_DEFLATED, PC_HPDDM_COARSE_CORRECTION_A
 E*/
 typedef enum {PC_SETUP_ERROR = -1,PC_NOERROR,PC_FACTOR_STRUCT_ZEROPIVOT,PC_FACTOR_NUMERIC_ZEROPIVOT,PC_FACTOR_OUTMEMORY,PC_FACTOR_OTHER,PC_SUBPC_ERROR} PCFailedReason;
 
+/*E
+    PCMatPrecision - Precision of the values of the matrix a PC is built from
+
+    Level: intermediate
+
+    Values:
++   PC_MAT_PRECISION_DOUBLE - the values of the Pmat are used as they are (default)
+-   PC_MAT_PRECISION_SINGLE - PCSetUp() uses a copy of a MATSEQAIJ Pmat of type MATSEQAIJSINGLE
+
+.seealso: PCSetMatPrecision(), MATSEQAIJSINGLE
+    Any additions/changes here MUST also be made in include/petsc/finclude/petscpc.h
+E*/
+typedef enum {PC_MAT_PRECISION_DOUBLE,PC_MAT_PRECISION_SINGLE} PCMatPrecision;
+
 /*E
     PCGAMGLayoutType - Layout for reduced grids
 
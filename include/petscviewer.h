@@ -156,6 +156,7 @@ typedef enum {
   PETSC_VIEWER_HDF5_VIZ,
   PETSC_VIEWER_HDF5_XDMF,
   PETSC_VIEWER_HDF5_MAT,
+  PETSC_VIEWER_ASCII_CHROME_TRACE,
   PETSC_VIEWER_NOFORMAT,
   PETSC_VIEWER_LOAD_BALANCE,
   PETSC_VIEWER_FAILED
@@ -210,6 +210,23 @@
     </ol>
   </xsl:template>
 
+  <xsl:template match="threadtimertable">
+    <!-- Timer table of OpenMP threads -->
+    <h2><xsl:value-of select="@desc"/></h2>
+    <table width="800">
+      <tr><th align="left">Event</th><th>Thread</th><th>Count</th><th>Time (s)</th></tr>
+      <xsl:apply-templates select="threadevent"/>
+    </table>
+  </xsl:template>
+
+  <xsl:template match="threadtimertable/threadevent">
+    <tr><td class="timername"><xsl:value-of select="name"/></td>
+      <td class="numeric"><xsl:value-of select="thread"/></td>
+      <td class="numeric"><xsl:value-of select="count"/></td>
+      <td class="numeric"><xsl:value-of select="time"/></td>
+    </tr>
+  </xsl:template>
+
   <xsl:template match="event[events]">
     <!--tree-->
     <li>
@@ -366,6 +366,277 @@ static PetscErrorCode PetscFEIntegrateBd_Basic(PetscDS ds, PetscInt field,
   PetscFunctionReturn(0);
 }
 
+/* The batched residual handles H^1 fields with at most first derivatives in their own dimension, where pushing forward is only multiplying by invJ^T */
+static PetscErrorCode PetscFEBatchSupported_Private(PetscDS ds, PetscInt dim, PetscBool *supported)
+{
+  PetscTabulation *T;
+  PetscInt         Nf, f;
+  PetscErrorCode   ierr;
+
+  PetscFunctionBegin;
+  *supported = PETSC_FALSE;
+  ierr = PetscDSGetNumFields(ds, &Nf);CHKERRQ(ierr);
+  ierr = PetscDSGetTabulation(ds, &T);CHKERRQ(ierr);
+  for (f = 0; f < Nf; ++f) {
+    PetscObject    obj;
+    PetscClassId   id;
+    PetscDualSpace dsp;
+    PetscInt       k, jet;
+
+    ierr = PetscDSGetDiscretization(ds, f, &obj);CHKERRQ(ierr);
+    ierr = PetscObjectGetClassId(obj, &id);CHKERRQ(ierr);
+    if (id != PETSCFE_CLASSID) PetscFunctionReturn(0);
+    ierr = PetscFEGetDualSpace((PetscFE) obj, &dsp);CHKERRQ(ierr);
+    ierr = PetscDualSpaceGetDeRahm(dsp, &k);CHKERRQ(ierr);
+    ierr = PetscDSGetJetDegree(ds, f, &jet);CHKERRQ(ierr);
+    if (k || jet > 1 || T[f]->cdim != dim) PetscFunctionReturn(0);
+  }
+  *supported = PETSC_TRUE;
+  PetscFunctionReturn(0);
+}
+
+/* Evaluates the values U and gradients UX of the fields at quadrature point q on the ne cells of a batch. The
+   coefficients C, the inverse Jacobians invJ, U, UX and the reference gradients UXref have the cell index innermost,
+   with stride nb. UX is NULL if only the values are needed. */
+static void PetscFEEvaluateFieldJetsBatch_Private(PetscInt Nf, PetscTabulation T[], PetscInt q, PetscInt dim, PetscInt nb, PetscInt ne, const PetscReal invJ[], const PetscScalar C[], PetscScalar U[], PetscScalar UXref[], PetscScalar UX[])
+{
+  PetscInt dOffset = 0, fOffset = 0, f, b, c, d, k, e;
+
+  for (f = 0; f < Nf; ++f) {
+    const PetscInt   Nb = T[f]->Nb, Nc = T[f]->Nc;
+    const PetscReal *B  = &T[f]->T[0][q*Nb*Nc];
+    const PetscReal *D  = &T[f]->T[1][q*Nb*Nc*dim];
+
+    for (c = 0; c < Nc; ++c) {
+      PetscScalar *u = &U[(fOffset+c)*nb];
+
+      for (e = 0; e < ne; ++e) u[e] = 0.0;
+      if (UX) {
+        for (d = 0; d < dim; ++d) {
+          PetscScalar *ux = &UXref[((fOffset+c)*dim+d)*nb];
+
+          for (e = 0; e < ne; ++e) ux[e] = 0.0;
+        }
+      }
+    }
+    for (b = 0; b < Nb; ++b) {
+      const PetscScalar *coef = &C[(dOffset+b)*nb];
+
+      for (c = 0; c < Nc; ++c) {
+        const PetscInt  cidx = b*Nc+c;
+        const PetscReal Bv   = B[cidx];
+        PetscScalar    *u    = &U[(fOffset+c)*nb];
+
+        for (e = 0; e < ne; ++e) u[e] += Bv*coef[e];
+        if (!UX) continue;
+        for (d = 0; d < dim; ++d) {
+          const PetscReal Dv = D[cidx*dim+d];
+          PetscScalar    *ux = &UXref[((fOffset+c)*dim+d)*nb];
+
+          for (e = 0; e < ne; ++e) ux[e] += Dv*coef[e];
+        }
+      }
+    }
+    fOffset += Nc;
+    dOffset += Nb;
+  }
+  if (!UX) return;
+  /* Push forward the gradients, u_x = invJ^T u_x^ref */
+  for (c = 0; c < fOffset; ++c) {
+    for (d = 0; d < dim; ++d) {
+      PetscScalar *ux = &UX[(c*dim+d)*nb];
+
+      for (e = 0; e < ne; ++e) ux[e] = 0.0;
+      for (k = 0; k < dim; ++k) {
+        const PetscReal   *iJ  = &invJ[(k*dim+d)*nb];
+        const PetscScalar *uxr = &UXref[(c*dim+k)*nb];
+
+        for (e = 0; e < ne; ++e) ux[e] += iJ[e]*uxr[e];
+      }
+    }
+  }
+}
+
+/*
+  Integrates the residual on batches of cells at once. The coefficients, the field jets at a quadrature point, the
+  inverse Jacobians, the weak form terms and the element vectors of the cells of a batch have the cell index innermost,
+  so that the basis functions and the geometric maps are applied to all cells of the batch in unit stride loops. Only
+  the pointwise functions are called cell by cell.
+*/
+static PetscErrorCode PetscFEIntegrateResidual_Basic_Batched(PetscDS ds, PetscHashFormKey key, PetscInt Ne, PetscFEGeom *cgeom,
+                                                             const PetscScalar coefficients[], const PetscScalar coefficients_t[], PetscDS dsAux, const PetscScalar coefficientsAux[], PetscReal t, PetscScalar elemVec[])
+{
+  const PetscInt     field = key.field;
+  PetscFE            fe;
+  PetscWeakForm      wf;
+  PetscInt           n0, n1, i;
+  PetscPointFunc    *f0_func, *f1_func;
+  PetscQuadrature    quad;
+  PetscTabulation   *T, *TAux = NULL;
+  PetscScalar       *f0, *f1, *u, *u_t = NULL, *u_x, *a = NULL, *a_x = NULL;
+  PetscScalar       *work, *C, *Ct = NULL, *Ca = NULL, *U, *UT = NULL, *UXref, *UX, *A = NULL, *AXref = NULL, *AX = NULL, *F0, *F1, *F1ref, *R;
+  PetscReal         *invJ, *W, *x;
+  const PetscScalar *constants;
+  PetscInt          *uOff, *uOff_x, *aOff = NULL, *aOff_x = NULL;
+  PetscInt           dim, numConstants, Nf, NfAux = 0, totDim, totDimAux = 0, NcT, NcTAux = 0, fOffset, Nb, Nc, nb, ne, e0, e;
+  PetscBool          isAffine;
+  const PetscReal   *quadPoints, *quadWeights, *B, *D;
+  PetscInt           Nq, q, Np, b, c, d, k;
+  PetscErrorCode     ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscDSGetDiscretization(ds, field, (PetscObject *) &fe);CHKERRQ(ierr);
+  ierr = PetscFEGetSpatialDimension(fe, &dim);CHKERRQ(ierr);
+  ierr = PetscFEGetQuadrature(fe, &quad);CHKERRQ(ierr);
+  ierr = PetscDSGetNumFields(ds, &Nf);CHKERRQ(ierr);
+  ierr = PetscDSGetTotalDimension(ds, &totDim);CHKERRQ(ierr);
+  ierr = PetscDSGetTotalComponents(ds, &NcT);CHKERRQ(ierr);
+  ierr = PetscDSGetComponentOffsets(ds, &uOff);CHKERRQ(ierr);
+  ierr = PetscDSGetComponentDerivativeOffsets(ds, &uOff_x);CHKERRQ(ierr);
+  ierr = PetscDSGetFieldOffset(ds, field, &fOffset);CHKERRQ(ierr);
+  ierr = PetscDSGetWeakForm(ds, &wf);CHKERRQ(ierr);
+  ierr = PetscWeakFormGetResidual(wf, key.label, key.value, key.field, &n0, &f0_func, &n1, &f1_func);CHKERRQ(ierr);
+  if (!n0 && !n1) PetscFunctionReturn(0);
+  ierr = PetscDSGetEvaluationArrays(ds, &u, coefficients_t ? &u_t : NULL, &u_x);CHKERRQ(ierr);
+  ierr = PetscDSGetWorkspace(ds, &x, NULL, NULL, NULL, NULL);CHKERRQ(ierr);
+  ierr = PetscDSGetWeakFormArrays(ds, &f0, &f1, NULL, NULL, NULL, NULL);CHKERRQ(ierr);
+  ierr = PetscDSGetTabulation(ds, &T);CHKERRQ(ierr);
+  ierr = PetscDSGetConstants(ds, &numConstants, &constants);CHKERRQ(ierr);
+  if (dsAux) {
+    ierr = PetscDSGetNumFields(dsAux, &NfAux);CHKERRQ(ierr);
+    ierr = PetscDSGetTotalDimension(dsAux, &totDimAux);CHKERRQ(ierr);
+    ierr = PetscDSGetTotalComponents(dsAux, &NcTAux);CHKERRQ(ierr);
+    ierr = PetscDSGetComponentOffsets(dsAux, &aOff);CHKERRQ(ierr);
+    ierr = PetscDSGetComponentDerivativeOffsets(dsAux, &aOff_x);CHKERRQ(ierr);
+    ierr = PetscDSGetEvaluationArrays(dsAux, &a, NULL, &a_x);CHKERRQ(ierr);
+    ierr = PetscDSGetTabulation(dsAux, &TAux);CHKERRQ(ierr);
+    if (T[0]->Np != TAux[0]->Np) SETERRQ2(PETSC_COMM_SELF, PETSC_ERR_ARG_WRONG, "Number of tabulation points %D != %D number of auxiliary tabulation points", T[0]->Np, TAux[0]->Np);
+  }
+  ierr = PetscQuadratureGetData(quad, NULL, NULL, &Nq, &quadPoints, &quadWeights);CHKERRQ(ierr);
+  Np       = cgeom->numPoints;
+  isAffine = cgeom->isAffine;
+  Nb       = T[field]->Nb;
+  Nc       = T[field]->Nc;
+  B        = T[field]->T[0];
+  D        = T[field]->T[1];
+  nb       = PetscMax(PetscMin(fe->batchSize, Ne), 1);
+  ierr = PetscMalloc1(nb*(totDim + NcT*(1 + 2*dim) + Nc*(1 + 2*dim) + Nb + (coefficients_t ? totDim + NcT : 0) + totDimAux + NcTAux*(1 + 2*dim)), &work);CHKERRQ(ierr);
+  ierr = PetscMalloc2(nb*dim*dim, &invJ, nb, &W);CHKERRQ(ierr);
+  C     = work;
+  U     = C     + nb*totDim;
+  UXref = U     + nb*NcT;
+  UX    = UXref + nb*NcT*dim;
+  F0    = UX    + nb*NcT*dim;
+  F1    = F0    + nb*Nc;
+  F1ref = F1    + nb*Nc*dim;
+  R     = F1ref + nb*Nc*dim;
+  Ca    = R     + nb*Nb;
+  if (coefficients_t) {
+    Ct  = Ca + nb*totDimAux;
+    UT  = Ct + nb*totDim;
+  }
+  if (dsAux) {
+    A     = (coefficients_t ? UT + nb*NcT : Ca + nb*totDimAux);
+    AXref = A     + nb*NcTAux;
+    AX    = AXref + nb*NcTAux*dim;
+  }
+  for (e0 = 0; e0 < Ne; e0 += nb) {
+    ne = PetscMin(nb, Ne-e0);
+    /* Transpose the coefficients of the batch so that the cell index is innermost */
+    for (e = 0; e < ne; ++e) {
+      for (i = 0; i < totDim; ++i) C[i*nb+e] = coefficients[(e0+e)*totDim+i];
+      if (Ct) for (i = 0; i < totDim; ++i) Ct[i*nb+e] = coefficients_t[(e0+e)*totDim+i];
+      for (i = 0; i < totDimAux; ++i) Ca[i*nb+e] = coefficientsAux[(e0+e)*totDimAux+i];
+    }
+    for (i = 0; i < Nb*nb; ++i) R[i] = 0.0;
+    for (q = 0; q < Nq; ++q) {
+      const PetscReal *Bq = &B[q*Nb*Nc];
+      const PetscReal *Dq = &D[q*Nb*Nc*dim];
+
+      if (!q || !isAffine) {
+        const PetscInt p = isAffine ? 0 : q;
+
+        for (e = 0; e < ne; ++e) {
+          const PetscReal *iJ = &cgeom->invJ[((e0+e)*Np+p)*dim*dim];
+
+          for (i = 0; i < dim*dim; ++i) invJ[i*nb+e] = iJ[i];
+          W[e] = cgeom->detJ[(e0+e)*Np+p];
+        }
+      }
+      PetscFEEvaluateFieldJetsBatch_Private(Nf, T, q, dim, nb, ne, invJ, C, U, UXref, UX);
+      if (Ct)    PetscFEEvaluateFieldJetsBatch_Private(Nf, T, q, dim, nb, ne, invJ, Ct, UT, NULL, NULL);
+      if (dsAux) PetscFEEvaluateFieldJetsBatch_Private(NfAux, TAux, q, dim, nb, ne, invJ, Ca, A, AXref, AX);
+      /* Call the pointwise functions cell by cell */
+      for (e = 0; e < ne; ++e) {
+        const PetscReal w = W[e]*quadWeights[q];
+        PetscReal      *v;
+
+        for (i = 0; i < NcT; ++i) u[i] = U[i*nb+e];
+        for (i = 0; i < NcT*dim; ++i) u_x[i] = UX[i*nb+e];
+        if (UT) for (i = 0; i < NcT; ++i) u_t[i] = UT[i*nb+e];
+        for (i = 0; i < NcTAux; ++i) a[i] = A[i*nb+e];
+        for (i = 0; i < NcTAux*dim; ++i) a_x[i] = AX[i*nb+e];
+        if (isAffine) {
+          CoordinatesRefToReal(dim, dim, cgeom->xi, &cgeom->v[(e0+e)*Np*dim], &cgeom->J[(e0+e)*Np*dim*dim], &quadPoints[q*dim], x);
+          v = x;
+        } else v = &cgeom->v[((e0+e)*Np+q)*dim];
+        if (n0) {
+          for (c = 0; c < Nc; ++c) f0[c] = 0.0;
+          for (i = 0; i < n0; ++i) f0_func[i](dim, Nf, NfAux, uOff, uOff_x, u, u_t, u_x, aOff, aOff_x, a, NULL, a_x, t, v, numConstants, constants, f0);
+          for (c = 0; c < Nc; ++c) F0[c*nb+e] = f0[c]*w;
+        }
+        if (n1) {
+          for (c = 0; c < Nc*dim; ++c) f1[c] = 0.0;
+          for (i = 0; i < n1; ++i) f1_func[i](dim, Nf, NfAux, uOff, uOff_x, u, u_t, u_x, aOff, aOff_x, a, NULL, a_x, t, v, numConstants, constants, f1);
+          for (c = 0; c < Nc*dim; ++c) F1[c*nb+e] = f1[c]*w;
+        }
+      }
+      /* Pull f1 back to the reference cell, f1^ref = invJ f1, so that the reference basis derivatives can be used */
+      if (n1) {
+        for (c = 0; c < Nc; ++c) {
+          for (k = 0; k < dim; ++k) {
+            PetscScalar *fr = &F1ref[(c*dim+k)*nb];
+
+            for (e = 0; e < ne; ++e) fr[e] = 0.0;
+            for (d = 0; d < dim; ++d) {
+              const PetscReal   *iJ = &invJ[(k*dim+d)*nb];
+              const PetscScalar *fp = &F1[(c*dim+d)*nb];
+
+              for (e = 0; e < ne; ++e) fr[e] += iJ[e]*fp[e];
+            }
+          }
+        }
+      }
+      for (b = 0; b < Nb; ++b) {
+        PetscScalar *r = &R[b*nb];
+
+        for (c = 0; c < Nc; ++c) {
+          const PetscInt bcidx = b*Nc+c;
+
+          if (n0) {
+            const PetscReal    Bv = Bq[bcidx];
+            const PetscScalar *fp = &F0[c*nb];
+
+            for (e = 0; e < ne; ++e) r[e] += Bv*fp[e];
+          }
+          if (n1) {
+            for (k = 0; k < dim; ++k) {
+              const PetscReal    Dv = Dq[bcidx*dim+k];
+              const PetscScalar *fp = &F1ref[(c*dim+k)*nb];
+
+              for (e = 0; e < ne; ++e) r[e] += Dv*fp[e];
+            }
+          }
+        }
+      }
+    }
+    for (e = 0; e < ne; ++e) for (b = 0; b < Nb; ++b) elemVec[(e0+e)*totDim+fOffset+b] = R[b*nb+e];
+  }
+  ierr = PetscFree2(invJ, W);CHKERRQ(ierr);
+  ierr = PetscFree(work);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 PetscErrorCode PetscFEIntegrateResidual_Basic(PetscDS ds, PetscHashFormKey key, PetscInt Ne, PetscFEGeom *cgeom,
                                               const PetscScalar coefficients[], const PetscScalar coefficients_t[], PetscDS dsAux, const PetscScalar coefficientsAux[], PetscReal t, PetscScalar elemVec[])
 {
@@ -418,6 +689,16 @@ PetscErrorCode PetscFEIntegrateResidual_Basic(PetscDS ds, PetscHashFormKey key,
   Np = cgeom->numPoints;
   dE = cgeom->dimEmbed;
   isAffine = cgeom->isAffine;
+  if (fe->batched && dE == dim) {
+    PetscBool supported;
+
+    ierr = PetscFEBatchSupported_Private(ds, dim, &supported);CHKERRQ(ierr);
+    if (supported && dsAux) {ierr = PetscFEBatchSupported_Private(dsAux, dim, &supported);CHKERRQ(ierr);}
+    if (supported) {
+      ierr = PetscFEIntegrateResidual_Basic_Batched(ds, key, Ne, cgeom, coefficients, coefficients_t, dsAux, coefficientsAux, t, elemVec);CHKERRQ(ierr);
+      PetscFunctionReturn(0);
+    }
+  }
   for (e = 0; e < Ne; ++e) {
     PetscFEGeom fegeom;
 
@@ -257,6 +257,7 @@ PetscErrorCode PetscFESetFromOptions(PetscFE fem)
   }
   ierr = PetscOptionsBoundedInt("-petscfe_num_blocks", "The number of cell blocks to integrate concurrently", "PetscSpaceSetTileSizes", fem->numBlocks, &fem->numBlocks, NULL,1);CHKERRQ(ierr);
   ierr = PetscOptionsBoundedInt("-petscfe_num_batches", "The number of cell batches to integrate serially", "PetscSpaceSetTileSizes", fem->numBatches, &fem->numBatches, NULL,1);CHKERRQ(ierr);
+  ierr = PetscOptionsBool("-petscfe_batched", "Evaluate the residual on batches of cells with the cell index innermost", "PetscFESetBatched", fem->batched, &fem->batched, NULL);CHKERRQ(ierr);
   if (fem->ops->setfromoptions) {
     ierr = (*fem->ops->setfromoptions)(PetscOptionsObject,fem);CHKERRQ(ierr);
   }
@@ -379,6 +380,7 @@ PetscErrorCode PetscFECreate(MPI_Comm comm, PetscFE *fem)
   f->numBlocks     = 1;
   f->batchSize     = 0;
   f->numBatches    = 1;
+  f->batched       = PETSC_FALSE;
 
   *fem = f;
   PetscFunctionReturn(0);
@@ -517,6 +519,65 @@ PetscErrorCode PetscFEGetTileSizes(PetscFE fem, PetscInt *blockSize, PetscInt *n
   PetscFunctionReturn(0);
 }
 
+/*@
+  PetscFESetBatched - Sets whether the residual is evaluated on a batch of cells at once
+
+  Logically collective on fem
+
+  Input Parameters:
++ fem - The PetscFE object
+- flg - PETSC_TRUE to evaluate the residual in batches
+
+  Options Database:
+. -petscfe_batched - Evaluate the residual in batches
+
+  Notes:
+  The batches hold the number of elements in a batch given by PetscFESetTileSizes(), which DMPlex sets to the number of
+  blocks times the dimension of the space, so -petscfe_num_blocks controls the batch size. For a batch, the solution
+  and auxiliary fields and their gradients at all quadrature points, the quadrature weights and the weak form terms are
+  stored with the cell index innermost, so that the tabulated basis functions are applied to all cells of the batch in
+  loops the compiler can vectorize. The pointwise functions are still called at each quadrature point of each cell.
+
+  Only PETSCFEBASIC uses the batches, and only when all fields are H^1 conforming, no second derivatives are needed and
+  the embedding dimension is the topological dimension. Otherwise the residual is evaluated cell by cell.
+
+  Level: intermediate
+
+.seealso: PetscFEGetBatched(), PetscFESetTileSizes(), PetscFEIntegrateResidual()
+@*/
+PetscErrorCode PetscFESetBatched(PetscFE fem, PetscBool flg)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(fem, PETSCFE_CLASSID, 1);
+  PetscValidLogicalCollectiveBool(fem, flg, 2);
+  fem->batched = flg;
+  PetscFunctionReturn(0);
+}
+
+/*@
+  PetscFEGetBatched - Returns whether the residual is evaluated on a batch of cells at once
+
+  Not collective
+
+  Input Parameter:
+. fem - The PetscFE object
+
+  Output Parameter:
+. flg - PETSC_TRUE if the residual is evaluated in batches
+
+  Level: intermediate
+
+.seealso: PetscFESetBatched(), PetscFEGetTileSizes()
+@*/
+PetscErrorCode PetscFEGetBatched(PetscFE fem, PetscBool *flg)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(fem, PETSCFE_CLASSID, 1);
+  PetscValidBoolPointer(flg, 2);
+  *flg = fem->batched;
+  PetscFunctionReturn(0);
+}
+
 /*@
   PetscFEGetBasisSpace - Returns the PetscSpace used for approximation of the solution
 
@@ -10,6 +10,13 @@
       PetscEnum, parameter :: DM_REFINER_TO_BOX = 1
       PetscEnum, parameter :: DM_REFINER_TO_SIMPLEX = 2
 !
+! DMPlexReorderLocalityType
+!
+      PetscEnum, parameter :: DMPLEX_REORDER_LOCALITY_NONE = 0
+      PetscEnum, parameter :: DMPLEX_REORDER_LOCALITY_RCM = 1
+      PetscEnum, parameter :: DMPLEX_REORDER_LOCALITY_HILBERT = 2
+      PetscEnum, parameter :: DMPLEX_REORDER_LOCALITY_MORTON = 3
+!
 ! DMPlexInterpolatedFlag
 !
       PetscEnum, parameter :: DMPLEX_INTERPOLATED_INVALID = -1
@@ -8,7 +8,7 @@
 #include <petscdmfield.h>
 
 /* Logging support */
-PetscLogEvent DMPLEX_Interpolate, DMPLEX_Partition, DMPLEX_Distribute, DMPLEX_DistributeCones, DMPLEX_DistributeLabels, DMPLEX_DistributeSF, DMPLEX_DistributeOverlap, DMPLEX_DistributeField, DMPLEX_DistributeData, DMPLEX_Migrate, DMPLEX_InterpolateSF, DMPLEX_GlobalToNaturalBegin, DMPLEX_GlobalToNaturalEnd, DMPLEX_NaturalToGlobalBegin, DMPLEX_NaturalToGlobalEnd, DMPLEX_Stratify, DMPLEX_Symmetrize, DMPLEX_Preallocate, DMPLEX_ResidualFEM, DMPLEX_JacobianFEM, DMPLEX_InterpolatorFEM, DMPLEX_InjectorFEM, DMPLEX_IntegralFEM, DMPLEX_CreateGmsh, DMPLEX_RebalanceSharedPoints, DMPLEX_PartSelf, DMPLEX_PartLabelInvert, DMPLEX_PartLabelCreateSF, DMPLEX_PartStratSF, DMPLEX_CreatePointSF,DMPLEX_LocatePoints;
+PetscLogEvent DMPLEX_Interpolate, DMPLEX_Partition, DMPLEX_Distribute, DMPLEX_DistributeCones, DMPLEX_DistributeLabels, DMPLEX_DistributeSF, DMPLEX_DistributeOverlap, DMPLEX_DistributeField, DMPLEX_DistributeData, DMPLEX_Migrate, DMPLEX_InterpolateSF, DMPLEX_GlobalToNaturalBegin, DMPLEX_GlobalToNaturalEnd, DMPLEX_NaturalToGlobalBegin, DMPLEX_NaturalToGlobalEnd, DMPLEX_Stratify, DMPLEX_Symmetrize, DMPLEX_Preallocate, DMPLEX_ResidualFEM, DMPLEX_JacobianFEM, DMPLEX_InterpolatorFEM, DMPLEX_InjectorFEM, DMPLEX_IntegralFEM, DMPLEX_CreateGmsh, DMPLEX_RebalanceSharedPoints, DMPLEX_PartSelf, DMPLEX_PartLabelInvert, DMPLEX_PartLabelCreateSF, DMPLEX_PartStratSF, DMPLEX_CreatePointSF,DMPLEX_LocatePoints,DMPLEX_CheckpointView,DMPLEX_CheckpointLoad;
 
 PETSC_EXTERN PetscErrorCode VecView_MPI(Vec, PetscViewer);
 
@@ -1430,6 +1430,7 @@ PetscErrorCode DMDestroy_Plex(DM dm)
   ierr = ISDestroy(&mesh->subpointIS);CHKERRQ(ierr);
   ierr = ISDestroy(&mesh->globalVertexNumbers);CHKERRQ(ierr);
   ierr = ISDestroy(&mesh->globalCellNumbers);CHKERRQ(ierr);
+  ierr = ISDestroy(&mesh->checkpointPoints);CHKERRQ(ierr);
   ierr = PetscSectionDestroy(&mesh->anchorSection);CHKERRQ(ierr);
   ierr = ISDestroy(&mesh->anchorIS);CHKERRQ(ierr);
   ierr = PetscSectionDestroy(&mesh->parentSection);CHKERRQ(ierr);
@@ -1532,6 +1533,11 @@ PetscErrorCode DMCreateMatrix_Plex(DM dm, Mat *J)
     ierr = PetscCalloc4(localSize/bs, &dnz, localSize/bs, &onz, localSize/bs, &dnzu, localSize/bs, &onzu);CHKERRQ(ierr);
     ierr = DMPlexPreallocateOperator(dm, bs, dnz, onz, dnzu, onzu, *J, fillMatrix);CHKERRQ(ierr);
     ierr = PetscFree4(dnz, onz, dnzu, onzu);CHKERRQ(ierr);
+  } else {
+    PetscBool matfree;
+
+    ierr = DMPlexSetUpMatrixFree_Internal(dm, *J, &matfree);CHKERRQ(ierr);
+    if (matfree) {ierr = MatSetUp(*J);CHKERRQ(ierr);}
   }
   ierr = MatSetDM(*J, dm);CHKERRQ(ierr);
   PetscFunctionReturn(0);
@@ -4704,6 +4710,33 @@ PetscErrorCode DMPlexRestoreCompressedClosure(DM dm, PetscSection section, Petsc
   PetscFunctionReturn(0);
 }
 
+/* Gets the cached offsets of idxSection in the closure of point, or NULL if they are not cached, see DMPlexCreateClosureDofIndex() */
+PETSC_STATIC_INLINE PetscErrorCode DMPlexGetClosureDofIndex_Static(DM dm, PetscSection section, PetscSection idxSection, PetscInt point, PetscInt *numIndices, const PetscInt *indices[])
+{
+  DM_Plex        *mesh = (DM_Plex*) dm->data;
+  PetscSection    clDofSection;
+  const PetscInt *clDofs;
+  PetscInt        pStart, pEnd, off;
+  PetscErrorCode  ierr;
+
+  PetscFunctionBeginHot;
+  *indices = NULL;
+  ierr = PetscSectionGetClosureDofIndex_Internal(section, (PetscObject) dm, idxSection, &clDofSection, &clDofs);CHKERRQ(ierr);
+  if (!clDofs && mesh->closureDofIndex && section == dm->localSection && (idxSection == section || idxSection == dm->globalSection)) {
+    ierr = DMPlexCreateClosureDofIndex(dm, section, idxSection);CHKERRQ(ierr);
+    ierr = PetscSectionGetClosureDofIndex_Internal(section, (PetscObject) dm, idxSection, &clDofSection, &clDofs);CHKERRQ(ierr);
+    /* The DM does not support the index, do not try again */
+    if (!clDofs) mesh->closureDofIndex = PETSC_FALSE;
+  }
+  if (!clDofs) PetscFunctionReturn(0);
+  ierr = PetscSectionGetChart(clDofSection, &pStart, &pEnd);CHKERRQ(ierr);
+  if ((point < pStart) || (point >= pEnd)) PetscFunctionReturn(0);
+  ierr = PetscSectionGetDof(clDofSection, point, numIndices);CHKERRQ(ierr);
+  ierr = PetscSectionGetOffset(clDofSection, point, &off);CHKERRQ(ierr);
+  *indices = &clDofs[off];
+  PetscFunctionReturn(0);
+}
+
 PETSC_STATIC_INLINE PetscErrorCode DMPlexVecGetClosure_Static(DM dm, PetscSection section, PetscInt numPoints, const PetscInt points[], const PetscInt clperm[], const PetscScalar vArray[], PetscInt *size, PetscScalar array[])
 {
   PetscInt          offset = 0, p;
@@ -4847,7 +4880,7 @@ PetscErrorCode DMPlexVecGetClosure(DM dm, PetscSection section, Vec v, PetscInt
   PetscSection       clSection;
   IS                 clPoints;
   PetscInt          *points = NULL;
-  const PetscInt    *clp, *perm;
+  const PetscInt    *clp, *perm, *clDofs;
   PetscInt           depth, numFields, numPoints, asize;
   PetscErrorCode     ierr;
 
@@ -4862,6 +4895,23 @@ PetscErrorCode DMPlexVecGetClosure(DM dm, PetscSection section, Vec v, PetscInt
     ierr = DMPlexVecGetClosure_Depth1_Static(dm, section, v, point, csize, values);CHKERRQ(ierr);
     PetscFunctionReturn(0);
   }
+  /* Use the cached offsets of the closure */
+  ierr = DMPlexGetClosureDofIndex_Static(dm, section, section, point, &asize, &clDofs);CHKERRQ(ierr);
+  if (clDofs) {
+    if (values) {
+      const PetscScalar *vArray;
+      PetscInt           i;
+
+      if (*values) {
+        if (PetscUnlikely(*csize < asize)) SETERRQ2(PETSC_COMM_SELF, PETSC_ERR_ARG_OUTOFRANGE, "Provided array size %D not sufficient to hold closure size %D", *csize, asize);
+      } else {ierr = DMGetWorkArray(dm, asize, MPIU_SCALAR, values);CHKERRQ(ierr);}
+      ierr = VecGetArrayRead(v, &vArray);CHKERRQ(ierr);
+      for (i = 0; i < asize; ++i) (*values)[i] = vArray[clDofs[i] < 0 ? -(clDofs[i]+1) : clDofs[i]];
+      ierr = VecRestoreArrayRead(v, &vArray);CHKERRQ(ierr);
+    }
+    if (csize) *csize = asize;
+    PetscFunctionReturn(0);
+  }
   /* Get points */
   ierr = DMPlexGetCompressedClosure(dm,section,point,&numPoints,&points,&clSection,&clPoints,&clp);CHKERRQ(ierr);
   /* Get sizes */
@@ -5341,7 +5391,7 @@ PetscErrorCode DMPlexVecSetClosure(DM dm, PetscSection section, Vec v, PetscInt
   IS              clPoints;
   PetscScalar    *array;
   PetscInt       *points = NULL;
-  const PetscInt *clp, *clperm = NULL;
+  const PetscInt *clp, *clperm = NULL, *clDofs;
   PetscInt        depth, numFields, numPoints, p, clsize;
   PetscErrorCode  ierr;
 
@@ -5356,6 +5406,35 @@ PetscErrorCode DMPlexVecSetClosure(DM dm, PetscSection section, Vec v, PetscInt
     ierr = DMPlexVecSetClosure_Depth1_Static(dm, section, v, point, values, mode);CHKERRQ(ierr);
     PetscFunctionReturn(0);
   }
+  /* Use the cached offsets of the closure, constrained dofs have negative offsets */
+  ierr = DMPlexGetClosureDofIndex_Static(dm, section, section, point, &clsize, &clDofs);CHKERRQ(ierr);
+  if (clDofs) {
+    ierr = VecGetArray(v, &array);CHKERRQ(ierr);
+    switch (mode) {
+    case INSERT_VALUES:
+      for (p = 0; p < clsize; ++p) if (clDofs[p] >= 0) array[clDofs[p]] = values[p];
+      break;
+    case INSERT_ALL_VALUES:
+      for (p = 0; p < clsize; ++p) array[clDofs[p] < 0 ? -(clDofs[p]+1) : clDofs[p]] = values[p];
+      break;
+    case INSERT_BC_VALUES:
+      for (p = 0; p < clsize; ++p) if (clDofs[p] < 0) array[-(clDofs[p]+1)] = values[p];
+      break;
+    case ADD_VALUES:
+      for (p = 0; p < clsize; ++p) if (clDofs[p] >= 0) array[clDofs[p]] += values[p];
+      break;
+    case ADD_ALL_VALUES:
+      for (p = 0; p < clsize; ++p) array[clDofs[p] < 0 ? -(clDofs[p]+1) : clDofs[p]] += values[p];
+      break;
+    case ADD_BC_VALUES:
+      for (p = 0; p < clsize; ++p) if (clDofs[p] < 0) array[-(clDofs[p]+1)] += values[p];
+      break;
+    default:
+      SETERRQ1(PetscObjectComm((PetscObject)dm), PETSC_ERR_ARG_OUTOFRANGE, "Invalid insert mode %d", mode);
+    }
+    ierr = VecRestoreArray(v, &array);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
   /* Get points */
   ierr = DMPlexGetCompressedClosure(dm,section,point,&numPoints,&points,&clSection,&clPoints,&clp);CHKERRQ(ierr);
   for (clsize=0,p=0; p<numPoints; p++) {
@@ -6608,6 +6687,7 @@ PetscErrorCode DMPlexMatSetClosure(DM dm, PetscSection section, PetscSection glo
 {
   DM_Plex           *mesh = (DM_Plex*) dm->data;
   PetscInt          *indices;
+  const PetscInt    *clDofs;
   PetscInt           numIndices;
   const PetscScalar *valuesOrig = values;
   PetscErrorCode     ierr;
@@ -6620,7 +6700,10 @@ PetscErrorCode DMPlexMatSetClosure(DM dm, PetscSection section, PetscSection glo
   PetscValidHeaderSpecific(globalSection, PETSC_SECTION_CLASSID, 3);
   PetscValidHeaderSpecific(A, MAT_CLASSID, 4);
 
-  ierr = DMPlexGetClosureIndices(dm, section, globalSection, point, PETSC_TRUE, &numIndices, &indices, NULL, (PetscScalar **) &values);CHKERRQ(ierr);
+  /* The cached indices exist only if the point symmetries do not change the values */
+  ierr = DMPlexGetClosureDofIndex_Static(dm, section, globalSection, point, &numIndices, &clDofs);CHKERRQ(ierr);
+  if (clDofs) indices = (PetscInt *) clDofs;
+  else {ierr = DMPlexGetClosureIndices(dm, section, globalSection, point, PETSC_TRUE, &numIndices, &indices, NULL, (PetscScalar **) &values);CHKERRQ(ierr);}
 
   if (mesh->printSetValues) {ierr = DMPlexPrintMatSetValues(PETSC_VIEWER_STDOUT_SELF, A, point, numIndices, indices, 0, NULL, values);CHKERRQ(ierr);}
   ierr = MatSetValues(A, numIndices, indices, numIndices, indices, values, mode);
@@ -6631,7 +6714,7 @@ PetscErrorCode DMPlexMatSetClosure(DM dm, PetscSection section, PetscSection glo
     ierr2 = MPI_Comm_rank(PetscObjectComm((PetscObject)A), &rank);CHKERRMPI(ierr2);
     ierr2 = (*PetscErrorPrintf)("[%d]ERROR in DMPlexMatSetClosure\n", rank);CHKERRQ(ierr2);
     ierr2 = DMPlexPrintMatSetValues(PETSC_VIEWER_STDERR_SELF, A, point, numIndices, indices, 0, NULL, values);CHKERRQ(ierr2);
-    ierr2 = DMPlexRestoreClosureIndices(dm, section, globalSection, point, PETSC_TRUE, &numIndices, &indices, NULL, (PetscScalar **) &values);CHKERRQ(ierr2);
+    if (!clDofs) {ierr2 = DMPlexRestoreClosureIndices(dm, section, globalSection, point, PETSC_TRUE, &numIndices, &indices, NULL, (PetscScalar **) &values);CHKERRQ(ierr2);}
     if (values != valuesOrig) {ierr2 = DMRestoreWorkArray(dm, 0, MPIU_SCALAR, &values);CHKERRQ(ierr2);}
     CHKERRQ(ierr);
   }
@@ -6642,7 +6725,7 @@ PetscErrorCode DMPlexMatSetClosure(DM dm, PetscSection section, PetscSection glo
     ierr = PetscPrintf(PETSC_COMM_SELF, "\n");CHKERRQ(ierr);
   }
 
-  ierr = DMPlexRestoreClosureIndices(dm, section, globalSection, point, PETSC_TRUE, &numIndices, &indices, NULL, (PetscScalar **) &values);CHKERRQ(ierr);
+  if (!clDofs) {ierr = DMPlexRestoreClosureIndices(dm, section, globalSection, point, PETSC_TRUE, &numIndices, &indices, NULL, (PetscScalar **) &values);CHKERRQ(ierr);}
   if (values != valuesOrig) {ierr = DMRestoreWorkArray(dm, 0, MPIU_SCALAR, &values);CHKERRQ(ierr);}
   PetscFunctionReturn(0);
 }
@@ -8235,7 +8318,7 @@ PetscErrorCode DMCreateInterpolation_Plex(DM dmCoarse, DM dmFine, Mat *interpola
   PetscInt       m, n;
   void          *ctx;
   DM             cdm;
-  PetscBool      regular, ismatis, isRefined = dmCoarse->data == dmFine->data ? PETSC_FALSE : PETSC_TRUE;
+  PetscBool      regular, ismatis, isshell, isRefined = dmCoarse->data == dmFine->data ? PETSC_FALSE : PETSC_TRUE;
   PetscErrorCode ierr;
 
   PetscFunctionBegin;
@@ -8245,9 +8328,11 @@ PetscErrorCode DMCreateInterpolation_Plex(DM dmCoarse, DM dmFine, Mat *interpola
   ierr = PetscSectionGetConstrainedStorageSize(gsc, &n);CHKERRQ(ierr);
 
   ierr = PetscStrcmp(dmCoarse->mattype, MATIS, &ismatis);CHKERRQ(ierr);
+  /* A matrix-free operator still has an assembled interpolator */
+  ierr = PetscStrcmp(dmCoarse->mattype, MATSHELL, &isshell);CHKERRQ(ierr);
   ierr = MatCreate(PetscObjectComm((PetscObject) dmCoarse), interpolation);CHKERRQ(ierr);
   ierr = MatSetSizes(*interpolation, m, n, PETSC_DETERMINE, PETSC_DETERMINE);CHKERRQ(ierr);
-  ierr = MatSetType(*interpolation, ismatis ? MATAIJ : dmCoarse->mattype);CHKERRQ(ierr);
+  ierr = MatSetType(*interpolation, ismatis || isshell ? MATAIJ : dmCoarse->mattype);CHKERRQ(ierr);
   ierr = DMGetApplicationContext(dmFine, &ctx);CHKERRQ(ierr);
 
   ierr = DMGetCoarseDM(dmFine, &cdm);CHKERRQ(ierr);
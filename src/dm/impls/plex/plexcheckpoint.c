@@ -0,0 +1,855 @@
+#include <petsc/private/dmpleximpl.h>   /*I      "petscdmplex.h"   I*/
+#include <petsc/private/isimpl.h>
+#include <petsc/private/vecimpl.h>
+#include <petscsf.h>
+
+#if defined(PETSC_HAVE_HDF5)
+#include <petscviewerhdf5.h>
+#include <petsclayouthdf5.h>
+
+PETSC_EXTERN PetscErrorCode VecView_MPI(Vec, PetscViewer);
+
+/*
+  The checkpoint keeps each rank's local mesh as a contiguous chunk of every dataset, in rank order. In /checkpoint/topology
+
+    sizes        - The number of points, cone points, point SF leaves and coordinate dofs of each rank
+    points       - The global number of each local point, which identifies it across ranks
+    depths       - The depth of each local point
+    cone_sizes   - The cone size of each local point
+    cones        - The cones, in local point numbers
+    orientations - The cone orientations
+    leaves       - The point SF, as triples of the local leaf, the remote rank and the remote point
+    vertices     - The coordinates of the local vertices
+
+  and the labels in /checkpoint/labels/<name>, with the local points and their values and their number on each rank in
+  sizes. A vector is saved in /checkpoint/fields as the global vector, with the number of dofs and the global offset of
+  each local point in <name>_dofs and <name>_offsets, which are -1 for the points the rank does not own.
+*/
+
+static PetscErrorCode CheckpointWriteInts_Private(PetscViewer viewer, MPI_Comm comm, const char name[], PetscInt n, const PetscInt vals[])
+{
+  IS             is;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = ISCreateGeneral(comm, n, vals, PETSC_USE_POINTER, &is);CHKERRQ(ierr);
+  ierr = PetscObjectSetName((PetscObject) is, name);CHKERRQ(ierr);
+  ierr = ISView(is, viewer);CHKERRQ(ierr);
+  ierr = ISDestroy(&is);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* Reads n entries of the dataset on this rank, where n is PETSC_DECIDE to split it evenly */
+static PetscErrorCode CheckpointReadInts_Private(PetscViewer viewer, MPI_Comm comm, const char name[], PetscInt n, IS *is)
+{
+  PetscInt       N;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscViewerHDF5ReadSizes(viewer, name, NULL, &N);CHKERRQ(ierr);
+  ierr = ISCreate(comm, is);CHKERRQ(ierr);
+  ierr = PetscObjectSetName((PetscObject) *is, name);CHKERRQ(ierr);
+  ierr = PetscLayoutSetLocalSize((*is)->map, n);CHKERRQ(ierr);
+  ierr = PetscLayoutSetSize((*is)->map, N);CHKERRQ(ierr);
+  ierr = ISLoad(*is, viewer);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* Reads a small dataset, with k entries per rank of the checkpoint, on every rank */
+static PetscErrorCode CheckpointReadSizes_Private(PetscViewer viewer, MPI_Comm comm, const char name[], PetscInt N, PetscInt sizes[])
+{
+  IS              is;
+  const PetscInt *vals;
+  PetscMPIInt     rank;
+  PetscErrorCode  ierr;
+
+  PetscFunctionBegin;
+  ierr = MPI_Comm_rank(comm, &rank);CHKERRMPI(ierr);
+  ierr = CheckpointReadInts_Private(viewer, comm, name, !rank ? N : 0, &is);CHKERRQ(ierr);
+  if (!rank) {
+    ierr = ISGetIndices(is, &vals);CHKERRQ(ierr);
+    ierr = PetscArraycpy(sizes, vals, N);CHKERRQ(ierr);
+    ierr = ISRestoreIndices(is, &vals);CHKERRQ(ierr);
+  }
+  ierr = ISDestroy(&is);CHKERRQ(ierr);
+  ierr = MPI_Bcast(sizes, N, MPIU_INT, 0, comm);CHKERRMPI(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode DMPlexCheckpointView_HDF5_Static(DM dm, PetscViewer viewer)
+{
+  MPI_Comm           comm;
+  PetscMPIInt        size;
+  IS                 globalPointNumbers;
+  PetscSF            sf;
+  PetscSection       coordSection;
+  Vec                coordinates, vertices;
+  const PetscInt    *gpoint, *ilocal;
+  const PetscSFNode *iremote;
+  const PetscScalar *coords;
+  PetscScalar       *verts;
+  PetscInt          *sizes, *points, *depths, *coneSizes, *cones, *ornts, *leaves;
+  PetscInt           dim, depth, cdim, pStart, pEnd, vStart, vEnd, nroots, nleaves = 0, numCones = 0, numOwned = 0, numPoints, commSize, numLabels, p, d, c, l;
+  PetscErrorCode     ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectGetComm((PetscObject) dm, &comm);CHKERRQ(ierr);
+  ierr = MPI_Comm_size(comm, &size);CHKERRMPI(ierr);
+  ierr = DMGetDimension(dm, &dim);CHKERRQ(ierr);
+  ierr = DMPlexGetDepth(dm, &depth);CHKERRQ(ierr);
+  ierr = DMGetCoordinateDim(dm, &cdim);CHKERRQ(ierr);
+  ierr = DMPlexGetChart(dm, &pStart, &pEnd);CHKERRQ(ierr);
+  if (pStart) SETERRQ1(PETSC_COMM_SELF, PETSC_ERR_ARG_WRONG, "The chart must start at 0, not %D", pStart);
+  ierr = DMPlexGetDepthStratum(dm, 0, &vStart, &vEnd);CHKERRQ(ierr);
+  ierr = DMGetCoordinateSection(dm, &coordSection);CHKERRQ(ierr);
+  ierr = DMGetCoordinatesLocal(dm, &coordinates);CHKERRQ(ierr);
+  ierr = VecGetLocalSize(coordinates, &c);CHKERRQ(ierr);
+  if (c != (vEnd-vStart)*cdim) SETERRQ(PETSC_COMM_SELF, PETSC_ERR_SUP, "Checkpoints of meshes with localized coordinates are not supported");
+  /* Topology */
+  ierr = DMPlexCreatePointNumbering(dm, &globalPointNumbers);CHKERRQ(ierr);
+  ierr = ISGetIndices(globalPointNumbers, &gpoint);CHKERRQ(ierr);
+  ierr = PetscMalloc4(pEnd, &points, pEnd, &depths, pEnd, &coneSizes, 4, &sizes);CHKERRQ(ierr);
+  for (p = 0; p < pEnd; ++p) {
+    points[p] = gpoint[p] < 0 ? -(gpoint[p]+1) : gpoint[p];
+    if (gpoint[p] >= 0) ++numOwned;
+    ierr = DMPlexGetConeSize(dm, p, &coneSizes[p]);CHKERRQ(ierr);
+    numCones += coneSizes[p];
+  }
+  ierr = ISRestoreIndices(globalPointNumbers, &gpoint);CHKERRQ(ierr);
+  ierr = ISDestroy(&globalPointNumbers);CHKERRQ(ierr);
+  for (d = 0; d <= depth; ++d) {
+    PetscInt s, e;
+
+    ierr = DMPlexGetDepthStratum(dm, d, &s, &e);CHKERRQ(ierr);
+    for (p = s; p < e; ++p) depths[p] = d;
+  }
+  ierr = PetscMalloc2(numCones, &cones, numCones, &ornts);CHKERRQ(ierr);
+  for (p = 0, c = 0; p < pEnd; ++p) {
+    const PetscInt *cone, *ornt;
+    PetscInt        cp;
+
+    ierr = DMPlexGetCone(dm, p, &cone);CHKERRQ(ierr);
+    ierr = DMPlexGetConeOrientation(dm, p, &ornt);CHKERRQ(ierr);
+    for (cp = 0; cp < coneSizes[p]; ++cp, ++c) {cones[c] = cone[cp]; ornts[c] = ornt[cp];}
+  }
+  ierr = DMGetPointSF(dm, &sf);CHKERRQ(ierr);
+  ierr = PetscSFGetGraph(sf, &nroots, &nleaves, &ilocal, &iremote);CHKERRQ(ierr);
+  if (nroots < 0) nleaves = 0;
+  ierr = PetscMalloc1(3*nleaves, &leaves);CHKERRQ(ierr);
+  for (l = 0; l < nleaves; ++l) {
+    leaves[l*3+0] = ilocal ? ilocal[l] : l;
+    leaves[l*3+1] = iremote[l].rank;
+    leaves[l*3+2] = iremote[l].index;
+  }
+  sizes[0] = pEnd;
+  sizes[1] = numCones;
+  sizes[2] = nleaves;
+  sizes[3] = (vEnd-vStart)*cdim;
+  ierr = MPIU_Allreduce(&numOwned, &numPoints, 1, MPIU_INT, MPI_SUM, comm);CHKERRMPI(ierr);
+  commSize = size;
+  ierr = PetscViewerHDF5WriteAttribute(viewer, "/checkpoint/topology", "comm_size", PETSC_INT, &commSize);CHKERRQ(ierr);
+  ierr = PetscViewerHDF5WriteAttribute(viewer, "/checkpoint/topology", "dim", PETSC_INT, &dim);CHKERRQ(ierr);
+  ierr = PetscViewerHDF5WriteAttribute(viewer, "/checkpoint/topology", "depth", PETSC_INT, &depth);CHKERRQ(ierr);
+  ierr = PetscViewerHDF5WriteAttribute(viewer, "/checkpoint/topology", "coord_dim", PETSC_INT, &cdim);CHKERRQ(ierr);
+  ierr = PetscViewerHDF5WriteAttribute(viewer, "/checkpoint/topology", "num_points", PETSC_INT, &numPoints);CHKERRQ(ierr);
+  ierr = PetscViewerHDF5PushGroup(viewer, "/checkpoint/topology");CHKERRQ(ierr);
+  ierr = CheckpointWriteInts_Private(viewer, comm, "sizes", 4, sizes);CHKERRQ(ierr);
+  ierr = CheckpointWriteInts_Private(viewer, comm, "points", pEnd, points);CHKERRQ(ierr);
+  ierr = CheckpointWriteInts_Private(viewer, comm, "depths", pEnd, depths);CHKERRQ(ierr);
+  ierr = CheckpointWriteInts_Private(viewer, comm, "cone_sizes", pEnd, coneSizes);CHKERRQ(ierr);
+  ierr = CheckpointWriteInts_Private(viewer, comm, "cones", numCones, cones);CHKERRQ(ierr);
+  ierr = CheckpointWriteInts_Private(viewer, comm, "orientations", numCones, ornts);CHKERRQ(ierr);
+  ierr = CheckpointWriteInts_Private(viewer, comm, "leaves", 3*nleaves, leaves);CHKERRQ(ierr);
+  ierr = PetscFree4(points, depths, coneSizes, sizes);CHKERRQ(ierr);
+  ierr = PetscFree2(cones, ornts);CHKERRQ(ierr);
+  ierr = PetscFree(leaves);CHKERRQ(ierr);
+  /* Geometry */
+  ierr = VecCreate(comm, &vertices);CHKERRQ(ierr);
+  ierr = VecSetSizes(vertices, (vEnd-vStart)*cdim, PETSC_DETERMINE);CHKERRQ(ierr);
+  ierr = VecSetBlockSize(vertices, cdim);CHKERRQ(ierr);
+  ierr = VecSetType(vertices, VECSTANDARD);CHKERRQ(ierr);
+  ierr = PetscObjectSetName((PetscObject) vertices, "vertices");CHKERRQ(ierr);
+  ierr = VecGetArrayRead(coordinates, &coords);CHKERRQ(ierr);
+  ierr = VecGetArray(vertices, &verts);CHKERRQ(ierr);
+  for (p = vStart; p < vEnd; ++p) {
+    PetscInt off;
+
+    ierr = PetscSectionGetOffset(coordSection, p, &off);CHKERRQ(ierr);
+    for (d = 0; d < cdim; ++d) verts[(p-vStart)*cdim+d] = coords[off+d];
+  }
+  ierr = VecRestoreArray(vertices, &verts);CHKERRQ(ierr);
+  ierr = VecRestoreArrayRead(coordinates, &coords);CHKERRQ(ierr);
+  ierr = VecView(vertices, viewer);CHKERRQ(ierr);
+  ierr = VecDestroy(&vertices);CHKERRQ(ierr);
+  ierr = PetscViewerHDF5PopGroup(viewer);CHKERRQ(ierr);
+  /* Labels */
+  ierr = DMGetNumLabels(dm, &numLabels);CHKERRQ(ierr);
+  for (l = 0, c = 0; l < numLabels; ++l) {
+    DMLabel         label;
+    IS              valueIS;
+    const PetscInt *values;
+    const char     *name;
+    PetscInt       *lpoints, *lvalues, numValues, n = 0, v;
+    PetscBool       isDepth, isCellType, output;
+    char            group[PETSC_MAX_PATH_LEN], attr[PETSC_MAX_PATH_LEN];
+
+    ierr = DMGetLabelName(dm, l, &name);CHKERRQ(ierr);
+    ierr = DMGetLabelOutput(dm, name, &output);CHKERRQ(ierr);
+    ierr = PetscStrcmp(name, "depth", &isDepth);CHKERRQ(ierr);
+    ierr = PetscStrcmp(name, "celltype", &isCellType);CHKERRQ(ierr);
+    if (isDepth || isCellType || !output) continue;
+    ierr = DMGetLabel(dm, name, &label);CHKERRQ(ierr);
+    ierr = DMLabelGetValueIS(label, &valueIS);CHKERRQ(ierr);
+    ierr = ISGetLocalSize(valueIS, &numValues);CHKERRQ(ierr);
+    ierr = ISGetIndices(valueIS, &values);CHKERRQ(ierr);
+    for (v = 0; v < numValues; ++v) {
+      PetscInt sn;
+
+      ierr = DMLabelGetStratumSize(label, values[v], &sn);CHKERRQ(ierr);
+      n += sn;
+    }
+    ierr = PetscMalloc2(n, &lpoints, n, &lvalues);CHKERRQ(ierr);
+    for (v = 0, n = 0; v < numValues; ++v) {
+      IS              stratumIS;
+      const PetscInt *spoints;
+      PetscInt        sn, s;
+
+      ierr = DMLabelGetStratumIS(label, values[v], &stratumIS);CHKERRQ(ierr);
+      if (!stratumIS) continue;
+      ierr = ISGetLocalSize(stratumIS, &sn);CHKERRQ(ierr);
+      ierr = ISGetIndices(stratumIS, &spoints);CHKERRQ(ierr);
+      for (s = 0; s < sn; ++s, ++n) {lpoints[n] = spoints[s]; lvalues[n] = values[v];}
+      ierr = ISRestoreIndices(stratumIS, &spoints);CHKERRQ(ierr);
+      ierr = ISDestroy(&stratumIS);CHKERRQ(ierr);
+    }
+    ierr = ISRestoreIndices(valueIS, &values);CHKERRQ(ierr);
+    ierr = ISDestroy(&valueIS);CHKERRQ(ierr);
+    ierr = PetscSNPrintf(attr, PETSC_MAX_PATH_LEN, "label_%D", c++);CHKERRQ(ierr);
+    ierr = PetscViewerHDF5WriteAttribute(viewer, "/checkpoint/labels", attr, PETSC_STRING, name);CHKERRQ(ierr);
+    ierr = PetscSNPrintf(group, PETSC_MAX_PATH_LEN, "/checkpoint/labels/%s", name);CHKERRQ(ierr);
+    ierr = PetscViewerHDF5PushGroup(viewer, group);CHKERRQ(ierr);
+    ierr = CheckpointWriteInts_Private(viewer, comm, "sizes", 1, &n);CHKERRQ(ierr);
+    ierr = CheckpointWriteInts_Private(viewer, comm, "points", n, lpoints);CHKERRQ(ierr);
+    ierr = CheckpointWriteInts_Private(viewer, comm, "values", n, lvalues);CHKERRQ(ierr);
+    ierr = PetscViewerHDF5PopGroup(viewer);CHKERRQ(ierr);
+    ierr = PetscFree2(lpoints, lvalues);CHKERRQ(ierr);
+  }
+  ierr = PetscViewerHDF5WriteAttribute(viewer, "/checkpoint/labels", "num_labels", PETSC_INT, &c);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* The depth strata in the usual order of a DMPlex chart: cells, vertices, then the faces and edges */
+PETSC_STATIC_INLINE PetscInt CheckpointStratumOrder_Private(PetscInt depth, PetscInt d)
+{
+  return d == depth ? 0 : (d == 0 ? 1 : depth - d + 1);
+}
+
+static PetscErrorCode DMPlexCreateFromCheckpoint_HDF5_Static(MPI_Comm comm, PetscViewer viewer, DM *dm)
+{
+  DM_Plex         *mesh;
+  PetscSection     coordSection;
+  PetscSF          sf;
+  PetscSFNode     *iremote;
+  Vec              vertices, coordinates;
+  IS               pointsIS, depthsIS, coneSizesIS, conesIS, orntsIS, leavesIS;
+  const PetscInt  *points, *depths, *coneSizes, *cones, *ornts, *leaves;
+  const PetscScalar *verts;
+  PetscScalar     *coords;
+  PetscInt        *allSizes, *chunkStart, *newpoint, *ids, *ilocal, *cone, *ornt;
+  PetscInt         dim, depth, cdim, numPoints, oldSize, rStart, rEnd, nP = 0, nC = 0, nL = 0, nV = 0, numNew, nleaves = 0, maxConeSize = 0, vStart, vEnd, numLabels, r, k, e, c, l;
+  PetscMPIInt      rank, size;
+  PetscErrorCode   ierr;
+
+  PetscFunctionBegin;
+  ierr = MPI_Comm_rank(comm, &rank);CHKERRMPI(ierr);
+  ierr = MPI_Comm_size(comm, &size);CHKERRMPI(ierr);
+  ierr = PetscViewerHDF5ReadAttribute(viewer, "/checkpoint/topology", "comm_size", PETSC_INT, NULL, &oldSize);CHKERRQ(ierr);
+  ierr = PetscViewerHDF5ReadAttribute(viewer, "/checkpoint/topology", "dim", PETSC_INT, NULL, &dim);CHKERRQ(ierr);
+  ierr = PetscViewerHDF5ReadAttribute(viewer, "/checkpoint/topology", "depth", PETSC_INT, NULL, &depth);CHKERRQ(ierr);
+  ierr = PetscViewerHDF5ReadAttribute(viewer, "/checkpoint/topology", "coord_dim", PETSC_INT, NULL, &cdim);CHKERRQ(ierr);
+  ierr = PetscViewerHDF5ReadAttribute(viewer, "/checkpoint/topology", "num_points", PETSC_INT, NULL, &numPoints);CHKERRQ(ierr);
+  ierr = PetscViewerHDF5PushGroup(viewer, "/checkpoint/topology");CHKERRQ(ierr);
+  ierr = PetscMalloc2(4*oldSize, &allSizes, oldSize+1, &chunkStart);CHKERRQ(ierr);
+  ierr = CheckpointReadSizes_Private(viewer, comm, "sizes", 4*oldSize, allSizes);CHKERRQ(ierr);
+  /* Each rank reads the chunks of a contiguous range of the saved ranks, which is its own chunk on the same number of ranks */
+  rStart = (rank*oldSize)/size;
+  rEnd   = ((rank+1)*oldSize)/size;
+  for (r = rStart; r < rEnd; ++r) {
+    chunkStart[r-rStart] = nP;
+    nP += allSizes[r*4+0];
+    nC += allSizes[r*4+1];
+    nL += allSizes[r*4+2];
+    nV += allSizes[r*4+3];
+  }
+  chunkStart[rEnd-rStart] = nP;
+  ierr = CheckpointReadInts_Private(viewer, comm, "points", nP, &pointsIS);CHKERRQ(ierr);
+  ierr = CheckpointReadInts_Private(viewer, comm, "depths", nP, &depthsIS);CHKERRQ(ierr);
+  ierr = CheckpointReadInts_Private(viewer, comm, "cone_sizes", nP, &coneSizesIS);CHKERRQ(ierr);
+  ierr = CheckpointReadInts_Private(viewer, comm, "cones", nC, &conesIS);CHKERRQ(ierr);
+  ierr = CheckpointReadInts_Private(viewer, comm, "orientations", nC, &orntsIS);CHKERRQ(ierr);
+  ierr = CheckpointReadInts_Private(viewer, comm, "leaves", 3*nL, &leavesIS);CHKERRQ(ierr);
+  ierr = VecCreate(comm, &vertices);CHKERRQ(ierr);
+  ierr = PetscObjectSetName((PetscObject) vertices, "vertices");CHKERRQ(ierr);
+  ierr = VecSetSizes(vertices, nV, PETSC_DETERMINE);CHKERRQ(ierr);
+  ierr = VecSetBlockSize(vertices, cdim);CHKERRQ(ierr);
+  ierr = VecSetType(vertices, VECSTANDARD);CHKERRQ(ierr);
+  ierr = VecLoad(vertices, viewer);CHKERRQ(ierr);
+  ierr = PetscViewerHDF5PopGroup(viewer);CHKERRQ(ierr);
+  ierr = ISGetIndices(pointsIS, &points);CHKERRQ(ierr);
+  ierr = ISGetIndices(depthsIS, &depths);CHKERRQ(ierr);
+  ierr = ISGetIndices(coneSizesIS, &coneSizes);CHKERRQ(ierr);
+  ierr = ISGetIndices(conesIS, &cones);CHKERRQ(ierr);
+  ierr = ISGetIndices(orntsIS, &ornts);CHKERRQ(ierr);
+  ierr = ISGetIndices(leavesIS, &leaves);CHKERRQ(ierr);
+  ierr = PetscMalloc1(nP, &newpoint);CHKERRQ(ierr);
+  if (oldSize == size) {
+    /* The local mesh is the saved one, so its point SF is read as is */
+    numNew = nP;
+    for (e = 0; e < nP; ++e) newpoint[e] = e;
+    ierr = PetscMalloc1(nP, &ids);CHKERRQ(ierr);
+    ierr = PetscArraycpy(ids, points, nP);CHKERRQ(ierr);
+    nleaves = nL;
+    ierr = PetscMalloc1(nleaves, &ilocal);CHKERRQ(ierr);
+    ierr = PetscMalloc1(nleaves, &iremote);CHKERRQ(ierr);
+    for (l = 0; l < nL; ++l) {
+      ilocal[l]        = leaves[l*3+0];
+      iremote[l].rank  = leaves[l*3+1];
+      iremote[l].index = leaves[l*3+2];
+    }
+  } else {
+    PetscSF      sfIds;
+    PetscLayout  layout;
+    PetscInt    *gs, *keys, *perm, *owner, *rowner;
+    PetscBool   *leaf, *owned;
+    PetscInt     nU = 0, u;
+
+    /* Merge the chunks, identifying the points shared between them by their global number. The merged points keep the
+       order of the strata, and within a stratum the order of the chunks. */
+    ierr = PetscMalloc3(nP, &gs, nP, &keys, nP, &leaf);CHKERRQ(ierr);
+    for (e = 0; e < nP; ++e) {
+      gs[e]   = points[e];
+      keys[e] = CheckpointStratumOrder_Private(depth, depths[e])*nP + e;
+      leaf[e] = PETSC_FALSE;
+    }
+    for (k = 0, l = 0; k < rEnd-rStart; ++k) {
+      for (r = 0; r < allSizes[(rStart+k)*4+2]; ++r, ++l) leaf[chunkStart[k]+leaves[l*3+0]] = PETSC_TRUE;
+    }
+    ierr = PetscSortIntWithArray(nP, gs, keys);CHKERRQ(ierr);
+    /* newpoint holds the merged point of each chunk point until the merged points are numbered */
+    for (e = 0; e < nP; ++e) {
+      const PetscInt p = keys[e] % nP;
+
+      if (!nU || gs[e] != gs[nU-1]) {gs[nU] = gs[e]; keys[nU] = keys[e]; ++nU;}
+      else keys[nU-1] = PetscMin(keys[nU-1], keys[e]);
+      newpoint[p] = nU-1;
+    }
+    numNew = nU;
+    ierr = PetscMalloc3(nU, &perm, nU, &owned, 2*nU, &owner);CHKERRQ(ierr);
+    ierr = PetscMalloc1(nU, &ids);CHKERRQ(ierr);
+    for (u = 0; u < nU; ++u) {perm[u] = u; owned[u] = PETSC_FALSE;}
+    ierr = PetscSortIntWithPermutation(nU, keys, perm);CHKERRQ(ierr);
+    /* keys is reused for the new number of each merged point */
+    for (u = 0; u < nU; ++u) {keys[perm[u]] = u; ids[u] = gs[perm[u]];}
+    for (e = 0; e < nP; ++e) {
+      newpoint[e] = keys[newpoint[e]];
+      if (!leaf[e]) owned[newpoint[e]] = PETSC_TRUE;
+    }
+    /* The owner of each point is the rank that read the chunk of its saved owner */
+    ierr = PetscLayoutCreateFromSizes(comm, PETSC_DECIDE, numPoints, 1, &layout);CHKERRQ(ierr);
+    ierr = PetscSFCreate(comm, &sfIds);CHKERRQ(ierr);
+    ierr = PetscSFSetGraphLayout(sfIds, layout, nU, NULL, PETSC_COPY_VALUES, ids);CHKERRQ(ierr);
+    ierr = PetscMalloc1(2*layout->n, &rowner);CHKERRQ(ierr);
+    for (u = 0; u < layout->n; ++u) {rowner[u*2+0] = -1; rowner[u*2+1] = -1;}
+    for (u = 0; u < nU; ++u) {owner[u*2+0] = owned[u] ? rank : -1; owner[u*2+1] = owned[u] ? u : -1;}
+    ierr = PetscSFReduceBegin(sfIds, MPIU_2INT, owner, rowner, MPI_MAXLOC);CHKERRQ(ierr);
+    ierr = PetscSFReduceEnd(sfIds, MPIU_2INT, owner, rowner, MPI_MAXLOC);CHKERRQ(ierr);
+    ierr = PetscSFBcastBegin(sfIds, MPIU_2INT, rowner, owner, MPI_REPLACE);CHKERRQ(ierr);
+    ierr = PetscSFBcastEnd(sfIds, MPIU_2INT, rowner, owner, MPI_REPLACE);CHKERRQ(ierr);
+    ierr = PetscSFDestroy(&sfIds);CHKERRQ(ierr);
+    ierr = PetscLayoutDestroy(&layout);CHKERRQ(ierr);
+    for (u = 0; u < nU; ++u) {
+      if (owner[u*2+0] < 0) SETERRQ1(PETSC_COMM_SELF, PETSC_ERR_FILE_UNEXPECTED, "Point %D of the checkpoint has no owner", ids[u]);
+      if (owner[u*2+0] != rank) ++nleaves;
+    }
+    ierr = PetscMalloc1(nleaves, &ilocal);CHKERRQ(ierr);
+    ierr = PetscMalloc1(nleaves, &iremote);CHKERRQ(ierr);
+    for (u = 0, l = 0; u < nU; ++u) {
+      if (owner[u*2+0] == rank) continue;
+      ilocal[l]        = u;
+      iremote[l].rank  = owner[u*2+0];
+      iremote[l].index = owner[u*2+1];
+      ++l;
+    }
+    ierr = PetscFree(rowner);CHKERRQ(ierr);
+    ierr = PetscFree3(perm, owned, owner);CHKERRQ(ierr);
+    ierr = PetscFree3(gs, keys, leaf);CHKERRQ(ierr);
+  }
+  /* Topology */
+  ierr = DMCreate(comm, dm);CHKERRQ(ierr);
+  ierr = DMSetType(*dm, DMPLEX);CHKERRQ(ierr);
+  ierr = DMSetDimension(*dm, dim);CHKERRQ(ierr);
+  ierr = DMSetCoordinateDim(*dm, cdim);CHKERRQ(ierr);
+  ierr = DMPlexSetChart(*dm, 0, numNew);CHKERRQ(ierr);
+  for (e = 0; e < nP; ++e) {
+    ierr = DMPlexSetConeSize(*dm, newpoint[e], coneSizes[e]);CHKERRQ(ierr);
+    maxConeSize = PetscMax(maxConeSize, coneSizes[e]);
+  }
+  ierr = DMSetUp(*dm);CHKERRQ(ierr);
+  ierr = PetscMalloc2(maxConeSize, &cone, maxConeSize, &ornt);CHKERRQ(ierr);
+  for (k = 0, e = 0, l = 0; k < rEnd-rStart; ++k) {
+    for (; e < chunkStart[k+1]; ++e) {
+      for (c = 0; c < coneSizes[e]; ++c, ++l) {cone[c] = newpoint[chunkStart[k]+cones[l]]; ornt[c] = ornts[l];}
+      ierr = DMPlexSetCone(*dm, newpoint[e], cone);CHKERRQ(ierr);
+      ierr = DMPlexSetConeOrientation(*dm, newpoint[e], ornt);CHKERRQ(ierr);
+    }
+  }
+  ierr = PetscFree2(cone, ornt);CHKERRQ(ierr);
+  ierr = DMPlexSymmetrize(*dm);CHKERRQ(ierr);
+  ierr = DMPlexStratify(*dm);CHKERRQ(ierr);
+  ierr = PetscSFCreate(comm, &sf);CHKERRQ(ierr);
+  ierr = PetscSFSetGraph(sf, numNew, nleaves, ilocal, PETSC_OWN_POINTER, iremote, PETSC_OWN_POINTER);CHKERRQ(ierr);
+  ierr = DMSetPointSF(*dm, sf);CHKERRQ(ierr);
+  ierr = PetscSFDestroy(&sf);CHKERRQ(ierr);
+  /* Geometry, where the vertices of each chunk are in the order of its points */
+  ierr = DMPlexGetDepthStratum(*dm, 0, &vStart, &vEnd);CHKERRQ(ierr);
+  ierr = DMGetCoordinateSection(*dm, &coordSection);CHKERRQ(ierr);
+  ierr = PetscSectionSetNumFields(coordSection, 1);CHKERRQ(ierr);
+  ierr = PetscSectionSetFieldComponents(coordSection, 0, cdim);CHKERRQ(ierr);
+  ierr = PetscSectionSetChart(coordSection, vStart, vEnd);CHKERRQ(ierr);
+  for (e = vStart; e < vEnd; ++e) {
+    ierr = PetscSectionSetDof(coordSection, e, cdim);CHKERRQ(ierr);
+    ierr = PetscSectionSetFieldDof(coordSection, e, 0, cdim);CHKERRQ(ierr);
+  }
+  ierr = PetscSectionSetUp(coordSection);CHKERRQ(ierr);
+  ierr = VecCreate(PETSC_COMM_SELF, &coordinates);CHKERRQ(ierr);
+  ierr = PetscObjectSetName((PetscObject) coordinates, "coordinates");CHKERRQ(ierr);
+  ierr = VecSetSizes(coordinates, (vEnd-vStart)*cdim, PETSC_DETERMINE);CHKERRQ(ierr);
+  ierr = VecSetBlockSize(coordinates, cdim);CHKERRQ(ierr);
+  ierr = VecSetType(coordinates, VECSTANDARD);CHKERRQ(ierr);
+  ierr = VecGetArrayRead(vertices, &verts);CHKERRQ(ierr);
+  ierr = VecGetArray(coordinates, &coords);CHKERRQ(ierr);
+  for (e = 0, l = 0; e < nP; ++e) {
+    if (depths[e]) continue;
+    for (c = 0; c < cdim; ++c) coords[(newpoint[e]-vStart)*cdim+c] = verts[l*cdim+c];
+    ++l;
+  }
+  ierr = VecRestoreArray(coordinates, &coords);CHKERRQ(ierr);
+  ierr = VecRestoreArrayRead(vertices, &verts);CHKERRQ(ierr);
+  ierr = DMSetCoordinatesLocal(*dm, coordinates);CHKERRQ(ierr);
+  ierr = VecDestroy(&coordinates);CHKERRQ(ierr);
+  ierr = VecDestroy(&vertices);CHKERRQ(ierr);
+  ierr = ISRestoreIndices(pointsIS, &points);CHKERRQ(ierr);
+  ierr = ISRestoreIndices(depthsIS, &depths);CHKERRQ(ierr);
+  ierr = ISRestoreIndices(coneSizesIS, &coneSizes);CHKERRQ(ierr);
+  ierr = ISRestoreIndices(conesIS, &cones);CHKERRQ(ierr);
+  ierr = ISRestoreIndices(orntsIS, &ornts);CHKERRQ(ierr);
+  ierr = ISRestoreIndices(leavesIS, &leaves);CHKERRQ(ierr);
+  ierr = ISDestroy(&pointsIS);CHKERRQ(ierr);
+  ierr = ISDestroy(&depthsIS);CHKERRQ(ierr);
+  ierr = ISDestroy(&coneSizesIS);CHKERRQ(ierr);
+  ierr = ISDestroy(&conesIS);CHKERRQ(ierr);
+  ierr = ISDestroy(&orntsIS);CHKERRQ(ierr);
+  ierr = ISDestroy(&leavesIS);CHKERRQ(ierr);
+  /* Labels */
+  ierr = PetscViewerHDF5ReadAttribute(viewer, "/checkpoint/labels", "num_labels", PETSC_INT, NULL, &numLabels);CHKERRQ(ierr);
+  for (l = 0; l < numLabels; ++l) {
+    DMLabel         label;
+    IS              lpointsIS, lvaluesIS;
+    const PetscInt *lpoints, *lvalues;
+    PetscInt       *lsizes, n = 0, p;
+    char           *name, group[PETSC_MAX_PATH_LEN], attr[PETSC_MAX_PATH_LEN];
+
+    ierr = PetscSNPrintf(attr, PETSC_MAX_PATH_LEN, "label_%D", l);CHKERRQ(ierr);
+    ierr = PetscViewerHDF5ReadAttribute(viewer, "/checkpoint/labels", attr, PETSC_STRING, NULL, &name);CHKERRQ(ierr);
+    ierr = PetscSNPrintf(group, PETSC_MAX_PATH_LEN, "/checkpoint/labels/%s", name);CHKERRQ(ierr);
+    ierr = DMCreateLabel(*dm, name);CHKERRQ(ierr);
+    ierr = DMGetLabel(*dm, name, &label);CHKERRQ(ierr);
+    ierr = PetscFree(name);CHKERRQ(ierr);
+    ierr = PetscViewerHDF5PushGroup(viewer, group);CHKERRQ(ierr);
+    ierr = PetscMalloc1(oldSize, &lsizes);CHKERRQ(ierr);
+    ierr = CheckpointReadSizes_Private(viewer, comm, "sizes", oldSize, lsizes);CHKERRQ(ierr);
+    for (r = rStart; r < rEnd; ++r) n += lsizes[r];
+    ierr = CheckpointReadInts_Private(viewer, comm, "points", n, &lpointsIS);CHKERRQ(ierr);
+    ierr = CheckpointReadInts_Private(viewer, comm, "values", n, &lvaluesIS);CHKERRQ(ierr);
+    ierr = PetscViewerHDF5PopGroup(viewer);CHKERRQ(ierr);
+    ierr = ISGetIndices(lpointsIS, &lpoints);CHKERRQ(ierr);
+    ierr = ISGetIndices(lvaluesIS, &lvalues);CHKERRQ(ierr);
+    for (k = 0, p = 0; k < rEnd-rStart; ++k) {
+      for (e = 0; e < lsizes[rStart+k]; ++e, ++p) {ierr = DMLabelSetValue(label, newpoint[chunkStart[k]+lpoints[p]], lvalues[p]);CHKERRQ(ierr);}
+    }
+    ierr = ISRestoreIndices(lpointsIS, &lpoints);CHKERRQ(ierr);
+    ierr = ISRestoreIndices(lvaluesIS, &lvalues);CHKERRQ(ierr);
+    ierr = ISDestroy(&lpointsIS);CHKERRQ(ierr);
+    ierr = ISDestroy(&lvaluesIS);CHKERRQ(ierr);
+    ierr = PetscFree(lsizes);CHKERRQ(ierr);
+  }
+  ierr = PetscFree(newpoint);CHKERRQ(ierr);
+  ierr = PetscFree2(allSizes, chunkStart);CHKERRQ(ierr);
+  mesh = (DM_Plex *) (*dm)->data;
+  ierr = ISCreateGeneral(PETSC_COMM_SELF, numNew, ids, PETSC_OWN_POINTER, &mesh->checkpointPoints);CHKERRQ(ierr);
+  /* On more ranks than were saved some ranks have no chunk, and when the number of ranks does not divide the saved one the
+     ranks merge different numbers of chunks, so in both cases the merged mesh is partitioned again and migrated once */
+  if (size > oldSize || oldSize % size) {
+    PetscPartitioner part;
+    PetscSF          sfMigration;
+    DM               dmDist;
+
+    ierr = DMPlexGetPartitioner(*dm, &part);CHKERRQ(ierr);
+    ierr = PetscPartitionerSetFromOptions(part);CHKERRQ(ierr);
+    ierr = DMPlexDistribute(*dm, 0, &sfMigration, &dmDist);CHKERRQ(ierr);
+    if (dmDist) {
+      const PetscInt *oldIds;
+      PetscInt        pStart, pEnd;
+
+      ierr = DMPlexGetChart(dmDist, &pStart, &pEnd);CHKERRQ(ierr);
+      ierr = PetscMalloc1(pEnd-pStart, &ids);CHKERRQ(ierr);
+      ierr = ISGetIndices(mesh->checkpointPoints, &oldIds);CHKERRQ(ierr);
+      ierr = PetscSFBcastBegin(sfMigration, MPIU_INT, oldIds, ids, MPI_REPLACE);CHKERRQ(ierr);
+      ierr = PetscSFBcastEnd(sfMigration, MPIU_INT, oldIds, ids, MPI_REPLACE);CHKERRQ(ierr);
+      ierr = ISRestoreIndices(mesh->checkpointPoints, &oldIds);CHKERRQ(ierr);
+      mesh = (DM_Plex *) dmDist->data;
+      ierr = ISCreateGeneral(PETSC_COMM_SELF, pEnd-pStart, ids, PETSC_OWN_POINTER, &mesh->checkpointPoints);CHKERRQ(ierr);
+      ierr = PetscSFDestroy(&sfMigration);CHKERRQ(ierr);
+      ierr = DMDestroy(dm);CHKERRQ(ierr);
+      *dm = dmDist;
+    }
+  }
+  PetscFunctionReturn(0);
+}
+
+/* The checkpoint number of each local point, which is the global point number unless the mesh was loaded from a checkpoint */
+static PetscErrorCode CheckpointGetPoints_Private(DM dm, IS *ids)
+{
+  DM_Plex        *mesh = (DM_Plex *) dm->data;
+  IS              globalPointNumbers;
+  const PetscInt *gpoint;
+  PetscInt       *points, pStart, pEnd, p;
+  PetscErrorCode  ierr;
+
+  PetscFunctionBegin;
+  if (mesh->checkpointPoints) {
+    ierr = PetscObjectReference((PetscObject) mesh->checkpointPoints);CHKERRQ(ierr);
+    *ids = mesh->checkpointPoints;
+    PetscFunctionReturn(0);
+  }
+  ierr = DMPlexGetChart(dm, &pStart, &pEnd);CHKERRQ(ierr);
+  ierr = DMPlexCreatePointNumbering(dm, &globalPointNumbers);CHKERRQ(ierr);
+  ierr = ISGetIndices(globalPointNumbers, &gpoint);CHKERRQ(ierr);
+  ierr = PetscMalloc1(pEnd-pStart, &points);CHKERRQ(ierr);
+  for (p = 0; p < pEnd-pStart; ++p) points[p] = gpoint[p] < 0 ? -(gpoint[p]+1) : gpoint[p];
+  ierr = ISRestoreIndices(globalPointNumbers, &gpoint);CHKERRQ(ierr);
+  ierr = ISDestroy(&globalPointNumbers);CHKERRQ(ierr);
+  ierr = ISCreateGeneral(PETSC_COMM_SELF, pEnd-pStart, points, PETSC_OWN_POINTER, ids);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode DMPlexCheckpointVecView_HDF5_Static(DM dm, Vec v, PetscViewer viewer)
+{
+  MPI_Comm        comm;
+  PetscSection    sectionGlobal;
+  PetscInt       *dofs, *offsets, pStart, pEnd, p;
+  const char     *name;
+  char            dname[PETSC_MAX_PATH_LEN];
+  PetscBool       isseq;
+  PetscErrorCode  ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectGetComm((PetscObject) dm, &comm);CHKERRQ(ierr);
+  ierr = PetscObjectGetName((PetscObject) v, &name);CHKERRQ(ierr);
+  ierr = DMGetGlobalSection(dm, &sectionGlobal);CHKERRQ(ierr);
+  ierr = DMPlexGetChart(dm, &pStart, &pEnd);CHKERRQ(ierr);
+  ierr = PetscMalloc2(pEnd-pStart, &dofs, pEnd-pStart, &offsets);CHKERRQ(ierr);
+  for (p = pStart; p < pEnd; ++p) {
+    PetscInt dof, cdof, off;
+
+    ierr = PetscSectionGetDof(sectionGlobal, p, &dof);CHKERRQ(ierr);
+    ierr = PetscSectionGetConstraintDof(sectionGlobal, p, &cdof);CHKERRQ(ierr);
+    ierr = PetscSectionGetOffset(sectionGlobal, p, &off);CHKERRQ(ierr);
+    dofs[p-pStart]    = dof < 0 ? -1 : dof - cdof;
+    offsets[p-pStart] = dof < 0 ? -1 : off;
+  }
+  ierr = PetscViewerHDF5PushGroup(viewer, "/checkpoint/fields");CHKERRQ(ierr);
+  ierr = PetscSNPrintf(dname, PETSC_MAX_PATH_LEN, "%s_dofs", name);CHKERRQ(ierr);
+  ierr = CheckpointWriteInts_Private(viewer, comm, dname, pEnd-pStart, dofs);CHKERRQ(ierr);
+  ierr = PetscSNPrintf(dname, PETSC_MAX_PATH_LEN, "%s_offsets", name);CHKERRQ(ierr);
+  ierr = CheckpointWriteInts_Private(viewer, comm, dname, pEnd-pStart, offsets);CHKERRQ(ierr);
+  ierr = PetscObjectTypeCompare((PetscObject) v, VECSEQ, &isseq);CHKERRQ(ierr);
+  if (isseq) {ierr = VecView_Seq(v, viewer);CHKERRQ(ierr);}
+  else       {ierr = VecView_MPI(v, viewer);CHKERRQ(ierr);}
+  ierr = PetscViewerHDF5PopGroup(viewer);CHKERRQ(ierr);
+  ierr = PetscFree2(dofs, offsets);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode DMPlexCheckpointVecLoad_HDF5_Static(DM dm, Vec v, PetscViewer viewer)
+{
+  MPI_Comm         comm;
+  PetscSection     sectionGlobal;
+  PetscSF          sfOld, sfNew;
+  PetscLayout      layout;
+  IS               pointsIS, dofsIS, offsetsIS, idsIS, fromIS, toIS;
+  Vec              vOld;
+  VecScatter       scatter;
+  const PetscInt  *points, *dofs, *offsets, *ids;
+  PetscInt        *oldData, *rootData, *newData, *from, *to;
+  const char      *name;
+  char             dname[PETSC_MAX_PATH_LEN];
+  PetscInt         oldSize, numPoints, bs, n, pStart, pEnd, N = 0, p, i;
+  PetscMPIInt      size;
+  PetscErrorCode   ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectGetComm((PetscObject) dm, &comm);CHKERRQ(ierr);
+  ierr = MPI_Comm_size(comm, &size);CHKERRMPI(ierr);
+  ierr = PetscObjectGetName((PetscObject) v, &name);CHKERRQ(ierr);
+  ierr = PetscViewerHDF5ReadAttribute(viewer, "/checkpoint/topology", "comm_size", PETSC_INT, NULL, &oldSize);CHKERRQ(ierr);
+  ierr = PetscViewerHDF5ReadAttribute(viewer, "/checkpoint/topology", "num_points", PETSC_INT, NULL, &numPoints);CHKERRQ(ierr);
+  /* On the same number of ranks the mesh and its global numbering are the saved ones, so the vector is read directly */
+  if (oldSize == size) {
+    ierr = PetscViewerHDF5PushGroup(viewer, "/checkpoint/fields");CHKERRQ(ierr);
+    ierr = VecLoad_Default(v, viewer);CHKERRQ(ierr);
+    ierr = PetscViewerHDF5PopGroup(viewer);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  /* Otherwise the saved dofs of each point are sent to the rank now owning it, and the values are moved with one scatter */
+  ierr = PetscViewerHDF5PushGroup(viewer, "/checkpoint/topology");CHKERRQ(ierr);
+  ierr = CheckpointReadInts_Private(viewer, comm, "points", PETSC_DECIDE, &pointsIS);CHKERRQ(ierr);
+  ierr = PetscViewerHDF5PopGroup(viewer);CHKERRQ(ierr);
+  ierr = ISGetLocalSize(pointsIS, &n);CHKERRQ(ierr);
+  ierr = PetscViewerHDF5PushGroup(viewer, "/checkpoint/fields");CHKERRQ(ierr);
+  ierr = PetscSNPrintf(dname, PETSC_MAX_PATH_LEN, "%s_dofs", name);CHKERRQ(ierr);
+  ierr = CheckpointReadInts_Private(viewer, comm, dname, n, &dofsIS);CHKERRQ(ierr);
+  ierr = PetscSNPrintf(dname, PETSC_MAX_PATH_LEN, "%s_offsets", name);CHKERRQ(ierr);
+  ierr = CheckpointReadInts_Private(viewer, comm, dname, n, &offsetsIS);CHKERRQ(ierr);
+  ierr = PetscViewerHDF5PopGroup(viewer);CHKERRQ(ierr);
+  ierr = ISGetIndices(pointsIS, &points);CHKERRQ(ierr);
+  ierr = ISGetIndices(dofsIS, &dofs);CHKERRQ(ierr);
+  ierr = ISGetIndices(offsetsIS, &offsets);CHKERRQ(ierr);
+  ierr = PetscLayoutCreateFromSizes(comm, PETSC_DECIDE, numPoints, 1, &layout);CHKERRQ(ierr);
+  ierr = PetscMalloc2(2*n, &oldData, 2*layout->n, &rootData);CHKERRQ(ierr);
+  for (i = 0; i < n; ++i) {oldData[i*2+0] = dofs[i]; oldData[i*2+1] = offsets[i];}
+  for (i = 0; i < layout->n; ++i) {rootData[i*2+0] = -1; rootData[i*2+1] = -1;}
+  ierr = PetscSFCreate(comm, &sfOld);CHKERRQ(ierr);
+  ierr = PetscSFSetGraphLayout(sfOld, layout, n, NULL, PETSC_COPY_VALUES, points);CHKERRQ(ierr);
+  ierr = PetscSFReduceBegin(sfOld, MPIU_2INT, oldData, rootData, MPI_MAXLOC);CHKERRQ(ierr);
+  ierr = PetscSFReduceEnd(sfOld, MPIU_2INT, oldData, rootData, MPI_MAXLOC);CHKERRQ(ierr);
+  ierr = PetscSFDestroy(&sfOld);CHKERRQ(ierr);
+  ierr = ISRestoreIndices(pointsIS, &points);CHKERRQ(ierr);
+  ierr = ISRestoreIndices(dofsIS, &dofs);CHKERRQ(ierr);
+  ierr = ISRestoreIndices(offsetsIS, &offsets);CHKERRQ(ierr);
+  ierr = ISDestroy(&pointsIS);CHKERRQ(ierr);
+  ierr = ISDestroy(&dofsIS);CHKERRQ(ierr);
+  ierr = ISDestroy(&offsetsIS);CHKERRQ(ierr);
+  ierr = DMPlexGetChart(dm, &pStart, &pEnd);CHKERRQ(ierr);
+  ierr = CheckpointGetPoints_Private(dm, &idsIS);CHKERRQ(ierr);
+  ierr = ISGetIndices(idsIS, &ids);CHKERRQ(ierr);
+  ierr = PetscMalloc1(2*(pEnd-pStart), &newData);CHKERRQ(ierr);
+  ierr = PetscSFCreate(comm, &sfNew);CHKERRQ(ierr);
+  ierr = PetscSFSetGraphLayout(sfNew, layout, pEnd-pStart, NULL, PETSC_COPY_VALUES, ids);CHKERRQ(ierr);
+  ierr = PetscSFBcastBegin(sfNew, MPIU_2INT, rootData, newData, MPI_REPLACE);CHKERRQ(ierr);
+  ierr = PetscSFBcastEnd(sfNew, MPIU_2INT, rootData, newData, MPI_REPLACE);CHKERRQ(ierr);
+  ierr = PetscSFDestroy(&sfNew);CHKERRQ(ierr);
+  ierr = ISRestoreIndices(idsIS, &ids);CHKERRQ(ierr);
+  ierr = ISDestroy(&idsIS);CHKERRQ(ierr);
+  ierr = PetscLayoutDestroy(&layout);CHKERRQ(ierr);
+  /* Match the saved and the current global dofs of the points this rank owns */
+  ierr = DMGetGlobalSection(dm, &sectionGlobal);CHKERRQ(ierr);
+  for (p = pStart; p < pEnd; ++p) {
+    PetscInt dof, cdof;
+
+    ierr = PetscSectionGetDof(sectionGlobal, p, &dof);CHKERRQ(ierr);
+    ierr = PetscSectionGetConstraintDof(sectionGlobal, p, &cdof);CHKERRQ(ierr);
+    if (dof < 0) continue;
+    if (dof - cdof != newData[(p-pStart)*2+0]) SETERRQ3(PETSC_COMM_SELF, PETSC_ERR_FILE_UNEXPECTED, "Point %D has %D dofs, but %D in the checkpoint", p, dof - cdof, newData[(p-pStart)*2+0]);
+    N += dof - cdof;
+  }
+  ierr = PetscMalloc1(N, &from);CHKERRQ(ierr);
+  ierr = PetscMalloc1(N, &to);CHKERRQ(ierr);
+  for (p = pStart, N = 0; p < pEnd; ++p) {
+    PetscInt dof, cdof, off, d;
+
+    ierr = PetscSectionGetDof(sectionGlobal, p, &dof);CHKERRQ(ierr);
+    ierr = PetscSectionGetConstraintDof(sectionGlobal, p, &cdof);CHKERRQ(ierr);
+    ierr = PetscSectionGetOffset(sectionGlobal, p, &off);CHKERRQ(ierr);
+    if (dof < 0) continue;
+    for (d = 0; d < dof - cdof; ++d, ++N) {from[N] = newData[(p-pStart)*2+1] + d; to[N] = off + d;}
+  }
+  ierr = PetscFree2(oldData, rootData);CHKERRQ(ierr);
+  ierr = PetscFree(newData);CHKERRQ(ierr);
+  ierr = VecGetBlockSize(v, &bs);CHKERRQ(ierr);
+  ierr = VecCreate(comm, &vOld);CHKERRQ(ierr);
+  ierr = PetscObjectSetName((PetscObject) vOld, name);CHKERRQ(ierr);
+  ierr = VecSetBlockSize(vOld, bs);CHKERRQ(ierr);
+  ierr = VecSetType(vOld, VECSTANDARD);CHKERRQ(ierr);
+  ierr = PetscViewerHDF5PushGroup(viewer, "/checkpoint/fields");CHKERRQ(ierr);
+  ierr = VecLoad(vOld, viewer);CHKERRQ(ierr);
+  ierr = PetscViewerHDF5PopGroup(viewer);CHKERRQ(ierr);
+  ierr = ISCreateGeneral(comm, N, from, PETSC_OWN_POINTER, &fromIS);CHKERRQ(ierr);
+  ierr = ISCreateGeneral(comm, N, to, PETSC_OWN_POINTER, &toIS);CHKERRQ(ierr);
+  ierr = VecScatterCreate(vOld, fromIS, v, toIS, &scatter);CHKERRQ(ierr);
+  ierr = VecScatterBegin(scatter, vOld, v, INSERT_VALUES, SCATTER_FORWARD);CHKERRQ(ierr);
+  ierr = VecScatterEnd(scatter, vOld, v, INSERT_VALUES, SCATTER_FORWARD);CHKERRQ(ierr);
+  ierr = VecScatterDestroy(&scatter);CHKERRQ(ierr);
+  ierr = ISDestroy(&fromIS);CHKERRQ(ierr);
+  ierr = ISDestroy(&toIS);CHKERRQ(ierr);
+  ierr = VecDestroy(&vOld);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+#endif
+
+/*@
+  DMPlexCheckpointView - Saves the distributed mesh to an HDF5 checkpoint, so that it can be restarted in parallel
+
+  Collective on DM
+
+  Input Parameters:
++ dm     - The DM
+- viewer - The HDF5 PetscViewer
+
+  Notes:
+  Each rank saves its local mesh, including its point SF and labels, as a contiguous chunk of every dataset, so that a
+  restart on the same number of ranks is a parallel read without any communication of the mesh. The coordinates must not
+  be localized.
+
+  Level: intermediate
+
+.seealso: DMPlexCreateFromCheckpoint(), DMPlexCheckpointVecView(), DMView()
+@*/
+PetscErrorCode DMPlexCheckpointView(DM dm, PetscViewer viewer)
+{
+  PetscBool      ishdf5;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecificType(dm, DM_CLASSID, 1, DMPLEX);
+  PetscValidHeaderSpecific(viewer, PETSC_VIEWER_CLASSID, 2);
+  ierr = PetscObjectTypeCompare((PetscObject) viewer, PETSCVIEWERHDF5, &ishdf5);CHKERRQ(ierr);
+  if (!ishdf5) SETERRQ1(PetscObjectComm((PetscObject) dm), PETSC_ERR_SUP, "Viewer type %s not supported for DMPlex checkpoints", ((PetscObject) viewer)->type_name);
+#if defined(PETSC_HAVE_HDF5)
+  ierr = PetscLogEventBegin(DMPLEX_CheckpointView, dm, 0, 0, 0);CHKERRQ(ierr);
+  ierr = DMPlexCheckpointView_HDF5_Static(dm, viewer);CHKERRQ(ierr);
+  ierr = PetscLogEventEnd(DMPLEX_CheckpointView, dm, 0, 0, 0);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+#else
+  SETERRQ(PetscObjectComm((PetscObject) dm), PETSC_ERR_SUP, "HDF5 not supported in this build.\nPlease reconfigure using --download-hdf5");
+#endif
+}
+
+/*@
+  DMPlexCreateFromCheckpoint - Creates a distributed mesh from an HDF5 checkpoint saved by DMPlexCheckpointView()
+
+  Collective
+
+  Input Parameters:
++ comm   - The communicator
+- viewer - The HDF5 PetscViewer
+
+  Output Parameter:
+. dm     - The DM
+
+  Notes:
+  On the number of ranks the checkpoint was saved from, each rank reads its own chunk and the point SF is the saved one.
+  On fewer ranks, each rank reads the chunks of a contiguous range of the saved ranks and merges them. When the number of
+  ranks divides the saved one, every rank merges the same number of chunks and no mesh is migrated. Otherwise, as on more
+  ranks, the chunks are read in the same way and the mesh is then partitioned and migrated once, with the partitioner
+  configured from the options database, so that the restarted mesh is balanced.
+
+  Level: intermediate
+
+.seealso: DMPlexCheckpointView(), DMPlexCheckpointVecLoad(), DMLoad()
+@*/
+PetscErrorCode DMPlexCreateFromCheckpoint(MPI_Comm comm, PetscViewer viewer, DM *dm)
+{
+  PetscBool      ishdf5;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(viewer, PETSC_VIEWER_CLASSID, 2);
+  PetscValidPointer(dm, 3);
+  ierr = PetscObjectTypeCompare((PetscObject) viewer, PETSCVIEWERHDF5, &ishdf5);CHKERRQ(ierr);
+  if (!ishdf5) SETERRQ1(comm, PETSC_ERR_SUP, "Viewer type %s not supported for DMPlex checkpoints", ((PetscObject) viewer)->type_name);
+#if defined(PETSC_HAVE_HDF5)
+  ierr = DMInitializePackage();CHKERRQ(ierr);
+  ierr = PetscLogEventBegin(DMPLEX_CheckpointLoad, 0, 0, 0, 0);CHKERRQ(ierr);
+  ierr = DMPlexCreateFromCheckpoint_HDF5_Static(comm, viewer, dm);CHKERRQ(ierr);
+  ierr = PetscLogEventEnd(DMPLEX_CheckpointLoad, 0, 0, 0, 0);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+#else
+  SETERRQ(comm, PETSC_ERR_SUP, "HDF5 not supported in this build.\nPlease reconfigure using --download-hdf5");
+#endif
+}
+
+/*@
+  DMPlexCheckpointVecView - Saves a global vector to an HDF5 checkpoint
+
+  Collective on DM
+
+  Input Parameters:
++ dm     - The DM
+. v      - The global vector, with a name
+- viewer - The HDF5 PetscViewer, which holds the checkpoint of the mesh saved by DMPlexCheckpointView()
+
+  Level: intermediate
+
+.seealso: DMPlexCheckpointVecLoad(), DMPlexCheckpointView()
+@*/
+PetscErrorCode DMPlexCheckpointVecView(DM dm, Vec v, PetscViewer viewer)
+{
+  PetscBool      ishdf5;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecificType(dm, DM_CLASSID, 1, DMPLEX);
+  PetscValidHeaderSpecific(v, VEC_CLASSID, 2);
+  PetscValidHeaderSpecific(viewer, PETSC_VIEWER_CLASSID, 3);
+  ierr = PetscObjectTypeCompare((PetscObject) viewer, PETSCVIEWERHDF5, &ishdf5);CHKERRQ(ierr);
+  if (!ishdf5) SETERRQ1(PetscObjectComm((PetscObject) dm), PETSC_ERR_SUP, "Viewer type %s not supported for DMPlex checkpoints", ((PetscObject) viewer)->type_name);
+#if defined(PETSC_HAVE_HDF5)
+  ierr = PetscLogEventBegin(DMPLEX_CheckpointView, dm, v, 0, 0);CHKERRQ(ierr);
+  ierr = DMPlexCheckpointVecView_HDF5_Static(dm, v, viewer);CHKERRQ(ierr);
+  ierr = PetscLogEventEnd(DMPLEX_CheckpointView, dm, v, 0, 0);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+#else
+  SETERRQ(PetscObjectComm((PetscObject) dm), PETSC_ERR_SUP, "HDF5 not supported in this build.\nPlease reconfigure using --download-hdf5");
+#endif
+}
+
+/*@
+  DMPlexCheckpointVecLoad - Loads a global vector from an HDF5 checkpoint
+
+  Collective on DM
+
+  Input Parameters:
++ dm     - The DM, created by DMPlexCreateFromCheckpoint() from the same checkpoint
+. v      - The global vector, with the name it was saved with
+- viewer - The HDF5 PetscViewer
+
+  Notes:
+  The discretization of the DM must be the one of the saved vector. On the number of ranks the checkpoint was saved from,
+  the vector is read directly. Otherwise the saved global dofs of each point are sent to its new owner and the values are
+  moved with a single scatter.
+
+  Level: intermediate
+
+.seealso: DMPlexCheckpointVecView(), DMPlexCreateFromCheckpoint()
+@*/
+PetscErrorCode DMPlexCheckpointVecLoad(DM dm, Vec v, PetscViewer viewer)
+{
+  PetscBool      ishdf5;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecificType(dm, DM_CLASSID, 1, DMPLEX);
+  PetscValidHeaderSpecific(v, VEC_CLASSID, 2);
+  PetscValidHeaderSpecific(viewer, PETSC_VIEWER_CLASSID, 3);
+  ierr = PetscObjectTypeCompare((PetscObject) viewer, PETSCVIEWERHDF5, &ishdf5);CHKERRQ(ierr);
+  if (!ishdf5) SETERRQ1(PetscObjectComm((PetscObject) dm), PETSC_ERR_SUP, "Viewer type %s not supported for DMPlex checkpoints", ((PetscObject) viewer)->type_name);
+#if defined(PETSC_HAVE_HDF5)
+  ierr = PetscLogEventBegin(DMPLEX_CheckpointLoad, dm, v, 0, 0);CHKERRQ(ierr);
+  ierr = DMPlexCheckpointVecLoad_HDF5_Static(dm, v, viewer);CHKERRQ(ierr);
+  ierr = PetscLogEventEnd(DMPLEX_CheckpointLoad, dm, v, 0, 0);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+#else
+  SETERRQ(PetscObjectComm((PetscObject) dm), PETSC_ERR_SUP, "HDF5 not supported in this build.\nPlease reconfigure using --download-hdf5");
+#endif
+}
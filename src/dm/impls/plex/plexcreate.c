@@ -2394,6 +2394,8 @@ PetscErrorCode DMSetFromOptions_NonRefinement_Plex(PetscOptionItems *PetscOption
   ierr = PetscOptionsBool("-dm_plex_partition_balance", "Attempt to evenly divide points on partition boundary between processes", "DMPlexSetPartitionBalance", PETSC_FALSE, &mesh->partitionBalance, NULL);CHKERRQ(ierr);
   /* Generation and remeshing */
   ierr = PetscOptionsBool("-dm_plex_remesh_bd", "Allow changes to the boundary on remeshing", "DMAdapt", PETSC_FALSE, &mesh->remeshBd, NULL);CHKERRQ(ierr);
+  /* Assembly */
+  ierr = PetscOptionsBool("-dm_plex_closure_dof_index", "Cache the dof indices of the cell closures for assembly", "DMPlexCreateClosureDofIndex", mesh->closureDofIndex, &mesh->closureDofIndex, NULL);CHKERRQ(ierr);
   /* Projection behavior */
   ierr = PetscOptionsBoundedInt("-dm_plex_max_projection_height", "Maxmimum mesh point height used to project locally", "DMPlexSetMaxProjectionHeight", 0, &mesh->maxProjectionHeight, NULL,0);CHKERRQ(ierr);
   ierr = PetscOptionsBool("-dm_plex_regular_refinement", "Use special nested projection algorithm for regular refinement", "DMPlexSetRegularRefinement", mesh->regularRefinement, &mesh->regularRefinement, NULL);CHKERRQ(ierr);
@@ -2427,7 +2429,9 @@ static PetscErrorCode DMSetFromOptions_Plex(PetscOptionItems *PetscOptionsObject
 {
   PetscReal      volume = -1.0;
   PetscInt       prerefine = 0, refine = 0, r, coarsen = 0, overlap = 0;
-  PetscBool      uniformOrig, uniform = PETSC_TRUE, distribute = PETSC_FALSE, isHierarchy, flg;
+  PetscBool      uniformOrig, uniform = PETSC_TRUE, distribute = PETSC_FALSE, redistributed = PETSC_FALSE, reorderSet, isHierarchy, flg;
+  DM             pdm = NULL;
+  DMPlexReorderLocalityType reorder;
   PetscErrorCode ierr;
 
   PetscFunctionBegin;
@@ -2459,8 +2463,10 @@ static PetscErrorCode DMSetFromOptions_Plex(PetscOptionItems *PetscOptionsObject
   /* Handle DMPlex distribution */
   ierr = PetscOptionsBool("-dm_distribute", "Flag to redistribute a mesh among processes", "DMCreate", distribute, &distribute, NULL);CHKERRQ(ierr);
   ierr = PetscOptionsBoundedInt("-dm_distribute_overlap", "The size of the overlap halo", "DMCreate", overlap, &overlap, NULL, 0);CHKERRQ(ierr);
+  ierr = DMPlexGetReorderLocality(dm, &reorder);CHKERRQ(ierr);
+  ierr = PetscOptionsEnum("-dm_plex_reorder_locality", "Reorder the mesh points for memory locality after distribution", "DMPlexSetReorderLocality", DMPlexReorderLocalityTypes, (PetscEnum) reorder, (PetscEnum *) &reorder, &reorderSet);CHKERRQ(ierr);
+  if (reorderSet) {ierr = DMPlexSetReorderLocality(dm, reorder);CHKERRQ(ierr);}
   if (distribute) {
-    DM               pdm = NULL;
     PetscPartitioner part;
 
     ierr = DMPlexGetPartitioner(dm, &part);CHKERRQ(ierr);
@@ -2469,8 +2475,19 @@ static PetscErrorCode DMSetFromOptions_Plex(PetscOptionItems *PetscOptionsObject
     if (pdm) {
       ierr = DMPlexReplace_Static(dm, pdm);CHKERRQ(ierr);
       ierr = DMDestroy(&pdm);CHKERRQ(ierr);
+      redistributed = PETSC_TRUE;
     }
   }
+  /* The mesh was not distributed here, so reorder it in place */
+  if (reorderSet && reorder != DMPLEX_REORDER_LOCALITY_NONE && !redistributed) {
+    IS perm;
+
+    ierr = DMPlexGetLocalityOrdering(dm, reorder, &perm);CHKERRQ(ierr);
+    ierr = DMPlexPermute(dm, perm, &pdm);CHKERRQ(ierr);
+    ierr = ISDestroy(&perm);CHKERRQ(ierr);
+    ierr = DMPlexReplace_Static(dm, pdm);CHKERRQ(ierr);
+    ierr = DMDestroy(&pdm);CHKERRQ(ierr);
+  }
   /* Handle DMPlex refinement */
   ierr = PetscOptionsBoundedInt("-dm_refine", "The number of uniform refinements", "DMCreate", refine, &refine, NULL,0);CHKERRQ(ierr);
   ierr = PetscOptionsBoundedInt("-dm_refine_hierarchy", "The number of uniform refinements", "DMCreate", refine, &refine, &isHierarchy,0);CHKERRQ(ierr);
@@ -2768,6 +2785,7 @@ PETSC_EXTERN PetscErrorCode DMCreate_Plex(DM dm)
   mesh->celltypeState       = -1;
   mesh->globalVertexNumbers = NULL;
   mesh->globalCellNumbers   = NULL;
+  mesh->checkpointPoints    = NULL;
   mesh->anchorSection       = NULL;
   mesh->anchorIS            = NULL;
   mesh->createanchors       = NULL;
@@ -1332,6 +1332,63 @@ PetscErrorCode DMPlexGetPartitionBalance(DM dm, PetscBool *flg)
   PetscFunctionReturn(0);
 }
 
+/*@
+  DMPlexSetReorderLocality - Set the ordering of the mesh points made for locality after DMPlexDistribute()
+
+  Logically collective on dm
+
+  Input Parameters:
++ dm   - The DMPlex object
+- type - The ordering, DMPLEX_REORDER_LOCALITY_NONE to keep the ordering made by the distribution
+
+  Options Database:
+. -dm_plex_reorder_locality <none,rcm,hilbert,morton> - The ordering, with DMSetFromOptions() the mesh is also reordered if it is not distributed
+
+  Note: The cells are ordered by DMPlexGetLocalityOrdering(), and the faces, edges and vertices are numbered in the order
+  the cells first touch them, so that cell loops stream through the coordinate and solution arrays and the assembled
+  matrices have a small bandwidth. The mesh is not reordered if the DM uses the natural ordering, see DMSetUseNatural().
+
+  Level: intermediate
+
+.seealso: DMPlexDistribute(), DMPlexGetReorderLocality(), DMPlexGetLocalityOrdering(), DMPlexPermute()
+@*/
+PetscErrorCode DMPlexSetReorderLocality(DM dm, DMPlexReorderLocalityType type)
+{
+  DM_Plex *mesh = (DM_Plex *)dm->data;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(dm, DM_CLASSID, 1);
+  PetscValidLogicalCollectiveEnum(dm, type, 2);
+  mesh->reorderLocality = type;
+  PetscFunctionReturn(0);
+}
+
+/*@
+  DMPlexGetReorderLocality - Get the ordering of the mesh points made for locality after DMPlexDistribute()
+
+  Not collective
+
+  Input Parameter:
+. dm - The DMPlex object
+
+  Output Parameter:
+. type - The ordering
+
+  Level: intermediate
+
+.seealso: DMPlexDistribute(), DMPlexSetReorderLocality()
+@*/
+PetscErrorCode DMPlexGetReorderLocality(DM dm, DMPlexReorderLocalityType *type)
+{
+  DM_Plex *mesh = (DM_Plex *)dm->data;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(dm, DM_CLASSID, 1);
+  PetscValidPointer(type, 2);
+  *type = mesh->reorderLocality;
+  PetscFunctionReturn(0);
+}
+
 typedef struct {
   PetscInt vote, rank, index;
 } Petsc3Int;
@@ -1584,9 +1641,12 @@ PetscErrorCode DMPlexMigrate(DM dm, PetscSF sf, DM targetDM)
   The user can control the definition of adjacency for the mesh using DMSetAdjacency(). They should choose the combination appropriate for the function
   representation on the mesh.
 
+  The points of the distributed mesh are reordered for memory locality if requested with DMPlexSetReorderLocality(), sf
+  then maps to the reordered points.
+
   Level: intermediate
 
-.seealso: DMPlexCreate(), DMSetAdjacency(), DMPlexGetOverlap()
+.seealso: DMPlexCreate(), DMSetAdjacency(), DMPlexGetOverlap(), DMPlexSetReorderLocality()
 @*/
 PetscErrorCode DMPlexDistribute(DM dm, PetscInt overlap, PetscSF *sf, DM *dmParallel)
 {
@@ -1598,6 +1658,7 @@ PetscErrorCode DMPlexDistribute(DM dm, PetscInt overlap, PetscSF *sf, DM *dmPara
   DMLabel                lblPartition, lblMigration;
   PetscSF                sfMigration, sfStratified, sfPoint;
   PetscBool              flg, balance;
+  DMPlexReorderLocalityType reorder;
   PetscMPIInt            rank, size;
   PetscErrorCode         ierr;
 
@@ -1724,6 +1785,34 @@ PetscErrorCode DMPlexDistribute(DM dm, PetscInt overlap, PetscSF *sf, DM *dmPara
     ierr = PetscSFDestroy(&sfMigration);CHKERRQ(ierr);
     sfMigration = sfOverlapPoint;
   }
+  /* Reorder the points of the distributed mesh for locality */
+  ierr = DMPlexGetReorderLocality(dm, &reorder);CHKERRQ(ierr);
+  ierr = DMPlexSetReorderLocality(*dmParallel, reorder);CHKERRQ(ierr);
+  if (reorder != DMPLEX_REORDER_LOCALITY_NONE && !dm->useNatural) {
+    DM                 dmReorder;
+    IS                 perm;
+    const PetscInt    *pperm, *leaves;
+    const PetscSFNode *remotes;
+    PetscSFNode       *newRemote;
+    PetscInt           nroots, nleaves, l;
+    PetscSF            sfReorder;
+
+    ierr = DMPlexGetLocalityOrdering(*dmParallel, reorder, &perm);CHKERRQ(ierr);
+    ierr = DMPlexPermute(*dmParallel, perm, &dmReorder);CHKERRQ(ierr);
+    ierr = DMDestroy(dmParallel);CHKERRQ(ierr);
+    *dmParallel = dmReorder;
+    /* Every distributed point is a leaf of the migration SF, so the permuted leaves are numbered contiguously */
+    ierr = PetscSFGetGraph(sfMigration, &nroots, &nleaves, &leaves, &remotes);CHKERRQ(ierr);
+    ierr = PetscMalloc1(nleaves, &newRemote);CHKERRQ(ierr);
+    ierr = ISGetIndices(perm, &pperm);CHKERRQ(ierr);
+    for (l = 0; l < nleaves; ++l) newRemote[pperm[leaves ? leaves[l] : l]] = remotes[l];
+    ierr = ISRestoreIndices(perm, &pperm);CHKERRQ(ierr);
+    ierr = ISDestroy(&perm);CHKERRQ(ierr);
+    ierr = PetscSFCreate(comm, &sfReorder);CHKERRQ(ierr);
+    ierr = PetscSFSetGraph(sfReorder, nroots, nleaves, NULL, PETSC_OWN_POINTER, newRemote, PETSC_OWN_POINTER);CHKERRQ(ierr);
+    ierr = PetscSFDestroy(&sfMigration);CHKERRQ(ierr);
+    sfMigration = sfReorder;
+  }
   /* Cleanup Partition */
   ierr = DMLabelDestroy(&lblPartition);CHKERRQ(ierr);
   ierr = DMLabelDestroy(&lblMigration);CHKERRQ(ierr);
@@ -73,3 +73,125 @@ PetscErrorCode DMPlexCreateClosureIndex(DM dm, PetscSection section)
   ierr = ISDestroy(&closureIS);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
+
+/* Checks whether the point symmetries of the section flip the sign of dofs in the closure of point */
+static PetscErrorCode DMPlexClosureHasFlips_Private(DM dm, PetscSection section, PetscInt point, PetscBool *hasFlips)
+{
+  PetscSection        clSection;
+  IS                  clPoints;
+  const PetscInt     *clp;
+  PetscInt           *points = NULL;
+  PetscInt            Nf, Ncl, f, p;
+  PetscErrorCode      ierr;
+
+  PetscFunctionBegin;
+  *hasFlips = PETSC_FALSE;
+  ierr = PetscSectionGetNumFields(section, &Nf);CHKERRQ(ierr);
+  ierr = DMPlexGetCompressedClosure(dm, section, point, &Ncl, &points, &clSection, &clPoints, &clp);CHKERRQ(ierr);
+  for (f = 0; f < PetscMax(1, Nf); ++f) {
+    const PetscInt    **perms = NULL;
+    const PetscScalar **flips = NULL;
+
+    if (Nf) {ierr = PetscSectionGetFieldPointSyms(section, f, Ncl, points, &perms, &flips);CHKERRQ(ierr);}
+    else    {ierr = PetscSectionGetPointSyms(section, Ncl, points, &perms, &flips);CHKERRQ(ierr);}
+    for (p = 0; flips && p < Ncl; ++p) if (flips[p]) *hasFlips = PETSC_TRUE;
+    if (Nf) {ierr = PetscSectionRestoreFieldPointSyms(section, f, Ncl, points, &perms, &flips);CHKERRQ(ierr);}
+    else    {ierr = PetscSectionRestorePointSyms(section, Ncl, points, &perms, &flips);CHKERRQ(ierr);}
+  }
+  ierr = DMPlexRestoreCompressedClosure(dm, section, point, &Ncl, &points, &clSection, &clPoints, &clp);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*@
+  DMPlexCreateClosureDofIndex - Calculate an index of the dof offsets in the closure of each cell for the given PetscSection
+
+  Not collective
+
+  Input Parameters:
++ dm         - The DM
+. section    - The section describing the layout in the local vector, or NULL to use the default section
+- idxSection - The section from which to obtain the offsets, or NULL to use section. A global section gives the indices used by DMPlexMatSetClosure()
+
+  Options Database Key:
+. -dm_plex_closure_dof_index - Create the index for the default local and global sections when they are first used
+
+  Notes:
+  The offsets are stored in closure order, with the closure permutation and the orientation of each point already
+  applied, so that DMPlexVecGetClosure(), DMPlexVecSetClosure() and DMPlexMatSetClosure() on cells read them
+  directly instead of traversing the closure. This saves most of the closure work of the FEM residual and Jacobian
+  assembly, at the cost of one PetscInt per dof in the closure of each cell.
+
+  The index is kept by the section and dropped when its closure permutation or symmetries change. The offsets of a
+  section other than the local one, usually the global section, are only kept for one such section at a time.
+  No index is created if the DM has anchors (hanging nodes) or if the point symmetries flip the sign of any dof.
+
+  Level: intermediate
+
+.seealso DMPlexCreateClosureIndex(), DMPlexGetClosureIndices(), DMPlexVecGetClosure(), DMPlexVecSetClosure(), DMPlexMatSetClosure()
+@*/
+PetscErrorCode DMPlexCreateClosureDofIndex(DM dm, PetscSection section, PetscSection idxSection)
+{
+  PetscSection    clDofSection, anchorSection;
+  const PetscInt *clDofs;
+  PetscInt       *idxDofs;
+  PetscInt        cStart, cEnd, c, size;
+  PetscBool       pointMajor;
+  PetscErrorCode  ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(dm, DM_CLASSID, 1);
+  if (!section) {ierr = DMGetLocalSection(dm, &section);CHKERRQ(ierr);}
+  PetscValidHeaderSpecific(section, PETSC_SECTION_CLASSID, 2);
+  if (!idxSection) idxSection = section;
+  PetscValidHeaderSpecific(idxSection, PETSC_SECTION_CLASSID, 3);
+  ierr = DMPlexGetAnchors(dm, &anchorSection, NULL);CHKERRQ(ierr);
+  ierr = PetscSectionGetPointMajor(section, &pointMajor);CHKERRQ(ierr);
+  if (anchorSection || !pointMajor) {
+    ierr = PetscInfo(dm, "No closure dof index for a DM with anchors or a field major section\n");CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  ierr = DMPlexGetHeightStratum(dm, 0, &cStart, &cEnd);CHKERRQ(ierr);
+  if (idxSection != section) {
+    ierr = PetscSectionGetClosureDofIndex_Internal(section, (PetscObject) dm, section, &clDofSection, &clDofs);CHKERRQ(ierr);
+    if (!clDofs) {
+      ierr = DMPlexCreateClosureDofIndex(dm, section, NULL);CHKERRQ(ierr);
+      ierr = PetscSectionGetClosureDofIndex_Internal(section, (PetscObject) dm, section, &clDofSection, &clDofs);CHKERRQ(ierr);
+      if (!clDofs) PetscFunctionReturn(0);
+    }
+    ierr = PetscObjectReference((PetscObject) clDofSection);CHKERRQ(ierr);
+  } else {
+    ierr = PetscSectionCreate(PETSC_COMM_SELF, &clDofSection);CHKERRQ(ierr);
+    ierr = PetscSectionSetChart(clDofSection, cStart, cEnd);CHKERRQ(ierr);
+    for (c = cStart; c < cEnd; ++c) {
+      PetscInt  *indices = NULL, Ni;
+      PetscBool  hasFlips;
+
+      ierr = DMPlexClosureHasFlips_Private(dm, section, c, &hasFlips);CHKERRQ(ierr);
+      if (hasFlips) {
+        ierr = PetscInfo1(dm, "No closure dof index since the point symmetries flip dofs in the closure of cell %D\n", c);CHKERRQ(ierr);
+        ierr = PetscSectionDestroy(&clDofSection);CHKERRQ(ierr);
+        PetscFunctionReturn(0);
+      }
+      ierr = DMPlexGetClosureIndices(dm, section, section, c, PETSC_TRUE, &Ni, &indices, NULL, NULL);CHKERRQ(ierr);
+      ierr = PetscSectionSetDof(clDofSection, c, Ni);CHKERRQ(ierr);
+      ierr = DMPlexRestoreClosureIndices(dm, section, section, c, PETSC_TRUE, &Ni, &indices, NULL, NULL);CHKERRQ(ierr);
+    }
+    ierr = PetscSectionSetUp(clDofSection);CHKERRQ(ierr);
+  }
+  ierr = PetscSectionGetStorageSize(clDofSection, &size);CHKERRQ(ierr);
+  ierr = PetscMalloc1(size, &idxDofs);CHKERRQ(ierr);
+  ierr = PetscLogObjectMemory((PetscObject) dm, size*sizeof(PetscInt));CHKERRQ(ierr);
+  for (c = cStart; c < cEnd; ++c) {
+    PetscInt *indices = NULL, Ni, dof, off;
+
+    ierr = PetscSectionGetDof(clDofSection, c, &dof);CHKERRQ(ierr);
+    ierr = PetscSectionGetOffset(clDofSection, c, &off);CHKERRQ(ierr);
+    ierr = DMPlexGetClosureIndices(dm, section, idxSection, c, PETSC_TRUE, &Ni, &indices, NULL, NULL);CHKERRQ(ierr);
+    if (Ni != dof) SETERRQ3(PetscObjectComm((PetscObject) dm), PETSC_ERR_PLIB, "Invalid size for closure of cell %D, %D should be %D", c, Ni, dof);
+    ierr = PetscArraycpy(&idxDofs[off], indices, Ni);CHKERRQ(ierr);
+    ierr = DMPlexRestoreClosureIndices(dm, section, idxSection, c, PETSC_TRUE, &Ni, &indices, NULL, NULL);CHKERRQ(ierr);
+  }
+  ierr = PetscSectionSetClosureDofIndex_Internal(section, (PetscObject) dm, idxSection, clDofSection, idxDofs);CHKERRQ(ierr);
+  ierr = PetscSectionDestroy(&clDofSection);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
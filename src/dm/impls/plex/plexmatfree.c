@@ -0,0 +1,848 @@
+#include <petsc/private/dmpleximpl.h>   /*I      "petscdmplex.h"   I*/
+#include <petsc/private/petscfeimpl.h>
+#include <petscdmfield.h>
+
+/* The tensor product structure of a field, whose basis function b is the product of the 1D basis functions lex[b] in
+   each direction, with component comp[b]. B and D hold the 1D basis functions and their derivatives at the 1D
+   quadrature points, row q of each holds the k1 values at point q. */
+typedef struct {
+  PetscInt   k1;     /* The number of 1D basis functions */
+  PetscInt   Nb, Nc; /* The number of basis functions and components */
+  PetscInt  *bidx;   /* The basis function for each lexicographic 1D tuple and component, bidx[s*Nc+c] */
+  PetscReal *B, *D;  /* The 1D tabulation at the 1D quadrature points, n x k1 */
+  PetscReal *BB, *BD, *DD; /* The entrywise products B*B, B*D and D*D, for the diagonal */
+} PlexMFField;
+
+/* The pointwise data of the Jacobian block of a pair of fields, with the terms g0, g1, g2 and g3 which are present */
+typedef struct {
+  PetscBool has[4];
+  PetscInt  off[4];  /* The offset of each term in the data for a pair of components */
+  PetscInt  Nt;      /* The number of terms for a pair of components */
+  PetscInt  offset;  /* The offset of the data of the pair in the data of a cell */
+} PlexMFPair;
+
+typedef struct {
+  DM           dm;
+  PetscInt     dim, Nf, totDim;
+  PetscInt     n, Nq;          /* The number of 1D quadrature points and of quadrature points */
+  PetscInt     cStart, cEnd;
+  PetscInt    *qperm;          /* The lexicographic index of each quadrature point */
+  PlexMFField *fields;
+  PlexMFPair  *pairs;          /* The Jacobian blocks, pairs[fieldI*Nf+fieldJ] */
+  PetscInt     cellSize;       /* The size of the data of one cell */
+  PetscInt     tsize;          /* The size of a tensor of values at the nodes or at the quadrature points */
+  PetscScalar *qdata;          /* The weighted pointwise Jacobian in reference coordinates, with the quadrature point innermost */
+  PetscBool    setup;          /* The pointwise data has been computed */
+  Vec          diag;           /* The global diagonal, or NULL if it is out of date */
+  PetscScalar *work;
+} DMPlexMatFree;
+
+/* The Lagrange polynomials on the nodes x[], and their derivatives, at the points p[] */
+static void Lagrange1D_Private(PetscInt k1, const PetscReal x[], PetscInt n, const PetscReal p[], PetscReal B[], PetscReal D[])
+{
+  PetscInt q, i, j, m;
+
+  for (q = 0; q < n; ++q) {
+    for (i = 0; i < k1; ++i) {
+      PetscReal v = 1.0, dv = 0.0;
+
+      for (j = 0; j < k1; ++j) {
+        PetscReal t = 1.0;
+
+        if (j == i) continue;
+        v *= (p[q] - x[j])/(x[i] - x[j]);
+        for (m = 0; m < k1; ++m) {
+          if (m == i) continue;
+          t *= m == j ? 1.0/(x[i] - x[j]) : (p[q] - x[m])/(x[i] - x[m]);
+        }
+        dv += t;
+      }
+      B[q*k1+i] = v;
+      D[q*k1+i] = dv;
+    }
+  }
+}
+
+/* Collects the distinct coordinates in direction d of the points x[] into the sorted array u[], and the index of each point in it into idx[] */
+static PetscErrorCode UniqueCoordinates_Private(PetscInt Np, PetscInt dim, PetscInt d, const PetscReal x[], PetscInt *nu, PetscReal u[], PetscInt idx[])
+{
+  const PetscReal tol = 1.0e-10;
+  PetscInt        p, i, n = 0;
+  PetscErrorCode  ierr;
+
+  PetscFunctionBegin;
+  for (p = 0; p < Np; ++p) {
+    for (i = 0; i < n; ++i) if (PetscAbsReal(u[i] - x[p*dim+d]) < tol) break;
+    if (i == n) u[n++] = x[p*dim+d];
+  }
+  ierr = PetscSortReal(n, u);CHKERRQ(ierr);
+  for (p = 0; p < Np; ++p) {
+    for (i = 0; i < n; ++i) if (PetscAbsReal(u[i] - x[p*dim+d]) < tol) break;
+    idx[p] = i;
+  }
+  *nu = n;
+  PetscFunctionReturn(0);
+}
+
+/* Finds the tensor product structure of the field and checks it against the tabulation T at the quadrature points x[] with lexicographic 1D indices qidx[] */
+static PetscErrorCode PlexMFFieldSetUp_Private(PetscFE fe, PetscTabulation T, PetscInt dim, PetscInt n, const PetscReal xq[], const PetscInt qidx[], PlexMFField *mf, PetscBool *flg)
+{
+  PetscDualSpace   dsp;
+  PetscReal       *nodes, *u, x1[64];
+  PetscInt        *nidx, *lex, *comp, Nb, Nc, Nq = T->Np, Ns, k1 = 0, b, c, d, q, i, k;
+  PetscReal        maxErr = 0.0;
+  PetscErrorCode   ierr;
+
+  PetscFunctionBegin;
+  *flg = PETSC_FALSE;
+  Nb   = T->Nb;
+  Nc   = T->Nc;
+  ierr = PetscFEGetDualSpace(fe, &dsp);CHKERRQ(ierr);
+  ierr = PetscDualSpaceGetDeRahm(dsp, &k);CHKERRQ(ierr);
+  ierr = PetscDualSpaceGetDimension(dsp, &i);CHKERRQ(ierr);
+  if (k || i != Nb || Nb % Nc) PetscFunctionReturn(0);
+  ierr = PetscMalloc5(Nb*dim, &nodes, Nb, &u, Nb*dim, &nidx, Nb, &lex, Nb, &comp);CHKERRQ(ierr);
+  /* The node and the component of each point evaluation functional */
+  for (b = 0; b < Nb; ++b) {
+    PetscQuadrature  f;
+    const PetscReal *fx, *fw;
+    PetscInt         fNc, fNp;
+
+    ierr = PetscDualSpaceGetFunctional(dsp, b, &f);CHKERRQ(ierr);
+    ierr = PetscQuadratureGetData(f, NULL, &fNc, &fNp, &fx, &fw);CHKERRQ(ierr);
+    if (fNp != 1 || fNc != Nc) goto done;
+    for (d = 0; d < dim; ++d) nodes[b*dim+d] = fx[d];
+    comp[b] = -1;
+    for (c = 0; c < Nc; ++c) if (fw[c] != 0.0) comp[b] = comp[b] < 0 ? c : Nc;
+    if (comp[b] < 0 || comp[b] == Nc) goto done;
+  }
+  /* The 1D nodes, which must be the same in each direction */
+  for (d = 0; d < dim; ++d) {
+    PetscInt nu;
+
+    ierr = UniqueCoordinates_Private(Nb, dim, d, nodes, &nu, u, &nidx[d*Nb]);CHKERRQ(ierr);
+    if (!d) {k1 = nu; if (k1 > 64) goto done; for (i = 0; i < k1; ++i) x1[i] = u[i];}
+    else if (nu != k1) goto done;
+    else for (i = 0; i < k1; ++i) if (PetscAbsReal(u[i] - x1[i]) > 1.0e-10) goto done;
+  }
+  for (Ns = 1, d = 0; d < dim; ++d) Ns *= k1;
+  if (Ns*Nc != Nb) goto done;
+  for (b = 0; b < Nb; ++b) {
+    for (lex[b] = 0, d = dim-1; d >= 0; --d) lex[b] = lex[b]*k1 + nidx[d*Nb+b];
+  }
+  mf->k1 = k1;
+  mf->Nb = Nb;
+  mf->Nc = Nc;
+  ierr = PetscMalloc1(Nb, &mf->bidx);CHKERRQ(ierr);
+  for (i = 0; i < Nb; ++i) mf->bidx[i] = -1;
+  for (b = 0; b < Nb; ++b) {
+    if (mf->bidx[lex[b]*Nc+comp[b]] >= 0) goto done;
+    mf->bidx[lex[b]*Nc+comp[b]] = b;
+  }
+  {
+    PetscReal *xq1;
+    PetscInt   nq1;
+
+    ierr = PetscMalloc1(n, &xq1);CHKERRQ(ierr);
+    ierr = PetscMalloc5(n*k1, &mf->B, n*k1, &mf->D, n*k1, &mf->BB, n*k1, &mf->BD, n*k1, &mf->DD);CHKERRQ(ierr);
+    for (nq1 = 0, q = 0; q < Nq; ++q) {
+      if (qidx[q*dim] >= nq1) {xq1[qidx[q*dim]] = xq[q*dim]; nq1 = qidx[q*dim]+1;}
+    }
+    Lagrange1D_Private(k1, x1, n, xq1, mf->B, mf->D);
+    ierr = PetscFree(xq1);CHKERRQ(ierr);
+    for (i = 0; i < n*k1; ++i) {
+      mf->BB[i] = mf->B[i]*mf->B[i];
+      mf->BD[i] = mf->B[i]*mf->D[i];
+      mf->DD[i] = mf->D[i]*mf->D[i];
+    }
+  }
+  /* Check the tensor product basis against the tabulation */
+  for (q = 0; q < Nq; ++q) {
+    for (b = 0; b < Nb; ++b) {
+      PetscInt s = lex[b], id[3] = {0, 0, 0};
+
+      for (d = 0; d < dim; ++d) {id[d] = s % k1; s /= k1;}
+      for (c = 0; c < Nc; ++c) {
+        PetscReal v = c == comp[b] ? 1.0 : 0.0, dv[3];
+
+        for (d = 0; d < dim; ++d) dv[d] = v;
+        for (d = 0; d < dim; ++d) {
+          const PetscInt qd = qidx[q*dim+d];
+
+          for (k = 0; k < dim; ++k) dv[k] *= (k == d ? mf->D : mf->B)[qd*k1+id[d]];
+          v *= mf->B[qd*k1+id[d]];
+        }
+        maxErr = PetscMax(maxErr, PetscAbsReal(v - T->T[0][(q*Nb+b)*Nc+c]));
+        for (d = 0; d < dim; ++d) maxErr = PetscMax(maxErr, PetscAbsReal(dv[d] - T->T[1][((q*Nb+b)*Nc+c)*dim+d]));
+      }
+    }
+  }
+  if (maxErr < 1.0e-8) *flg = PETSC_TRUE;
+  done:
+  if (!*flg) {
+    ierr = PetscFree(mf->bidx);CHKERRQ(ierr);
+    if (mf->B) {ierr = PetscFree5(mf->B, mf->D, mf->BB, mf->BD, mf->DD);CHKERRQ(ierr);}
+  }
+  ierr = PetscFree5(nodes, u, nidx, lex, comp);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* Contracts direction d of the tensor in[], with a entries outside and s entries inside of it, with the n x k1 matrix M,
+   from k1 to n entries, or with its transpose from n to k1 entries, and adds to out[] if add is set */
+static void TensorContract_Private(PetscInt a, PetscInt s, PetscInt n, PetscInt k1, const PetscReal M[], PetscBool trans, PetscBool add, const PetscScalar in[], PetscScalar out[])
+{
+  const PetscInt mi = trans ? n : k1, mo = trans ? k1 : n;
+  PetscInt       x, o, i, y;
+
+  for (x = 0; x < a; ++x) {
+    for (o = 0; o < mo; ++o) {
+      PetscScalar *po = &out[(x*mo+o)*s];
+
+      if (!add) for (y = 0; y < s; ++y) po[y] = 0.0;
+      for (i = 0; i < mi; ++i) {
+        const PetscReal    m  = trans ? M[i*k1+o] : M[o*k1+i];
+        const PetscScalar *pi = &in[(x*mi+i)*s];
+
+        for (y = 0; y < s; ++y) po[y] += m*pi[y];
+      }
+    }
+  }
+}
+
+/* Applies the tensor product of the matrices M[d] in direction d, or of their transposes, to in[] and puts the result
+   in out[], or adds it for the transposes. work[] must hold 2 max(n, k1)^dim entries. */
+static void TensorApply_Private(PetscInt dim, PetscInt n, PetscInt k1, const PetscReal *M[], PetscBool trans, const PetscScalar in[], PetscScalar out[], PetscScalar work[])
+{
+  const PetscInt     mi = trans ? n : k1, mo = trans ? k1 : n;
+  PetscInt           size, d, e, a, s;
+  const PetscScalar *cur = in;
+  PetscScalar       *next;
+
+  for (size = 1, d = 0; d < dim; ++d) size *= PetscMax(n, k1);
+  for (d = 0; d < dim; ++d) {
+    for (a = 1, e = d+1; e < dim; ++e) a *= mi;
+    for (s = 1, e = 0; e < d; ++e) s *= mo;
+    next = d == dim-1 ? out : &work[(d%2)*size];
+    TensorContract_Private(a, s, n, k1, M[d], trans, (d == dim-1 && trans) ? PETSC_TRUE : PETSC_FALSE, cur, next);
+    cur = next;
+  }
+}
+
+static PetscErrorCode MatDestroy_Plex_MatFree(Mat A)
+{
+  DMPlexMatFree *mf;
+  PetscInt       f;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MatShellGetContext(A, (void **) &mf);CHKERRQ(ierr);
+  for (f = 0; f < mf->Nf; ++f) {
+    ierr = PetscFree(mf->fields[f].bidx);CHKERRQ(ierr);
+    ierr = PetscFree5(mf->fields[f].B, mf->fields[f].D, mf->fields[f].BB, mf->fields[f].BD, mf->fields[f].DD);CHKERRQ(ierr);
+  }
+  ierr = PetscFree3(mf->fields, mf->pairs, mf->qperm);CHKERRQ(ierr);
+  ierr = PetscFree(mf->qdata);CHKERRQ(ierr);
+  ierr = PetscFree(mf->work);CHKERRQ(ierr);
+  ierr = VecDestroy(&mf->diag);CHKERRQ(ierr);
+  ierr = DMDestroy(&mf->dm);CHKERRQ(ierr);
+  ierr = PetscFree(mf);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject) A, "DMPlexComputeJacobianMatrixFree_C", NULL);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* Applies the element matrix of a cell, given by the pointwise data qd[], to the closure values x[] and puts the result in y[] */
+static void DMPlexMatFreeApplyCell_Private(DMPlexMatFree *mf, const PetscScalar qd[], const PetscScalar x[], PetscScalar y[])
+{
+  const PetscInt dim = mf->dim, Nf = mf->Nf, n = mf->n, Nq = mf->Nq;
+  PetscScalar   *U, *V, *S, *work;
+  PetscInt       fieldI, fieldJ, offI, offJ, ci, cj, s, k, l, d, q, i, Uoff;
+
+  /* U holds the values and reference gradients of each component of each field at the quadrature points */
+  for (i = 0, Uoff = 0; i < Nf; ++i) Uoff += mf->fields[i].Nc;
+  U    = mf->work;
+  V    = U + Uoff*(dim+1)*Nq;
+  S    = V + (dim+1)*Nq;
+  work = S + mf->tsize;
+  for (fieldJ = 0, offJ = 0, Uoff = 0; fieldJ < Nf; ++fieldJ) {
+    const PlexMFField *fJ = &mf->fields[fieldJ];
+    PetscInt           Ns = fJ->Nb/fJ->Nc;
+
+    for (cj = 0; cj < fJ->Nc; ++cj, ++Uoff) {
+      for (s = 0; s < Ns; ++s) S[s] = x[offJ+fJ->bidx[s*fJ->Nc+cj]];
+      for (d = -1; d < dim; ++d) {
+        const PetscReal *M[3];
+
+        for (k = 0; k < dim; ++k) M[k] = k == d ? fJ->D : fJ->B;
+        TensorApply_Private(dim, n, fJ->k1, M, PETSC_FALSE, S, &U[(Uoff*(dim+1)+d+1)*Nq], work);
+      }
+    }
+    offJ += fJ->Nb;
+  }
+  for (fieldI = 0, offI = 0; fieldI < Nf; ++fieldI) {
+    const PlexMFField *fI = &mf->fields[fieldI];
+    PetscInt           Ns = fI->Nb/fI->Nc;
+
+    for (ci = 0; ci < fI->Nc; ++ci) {
+      PetscBool any = PETSC_FALSE;
+
+      for (i = 0; i < (dim+1)*Nq; ++i) V[i] = 0.0;
+      for (fieldJ = 0, Uoff = 0; fieldJ < Nf; ++fieldJ) {
+        const PlexMFPair *p  = &mf->pairs[fieldI*Nf+fieldJ];
+        const PetscInt    Nc = mf->fields[fieldJ].Nc;
+
+        if (p->Nt) {
+          any = PETSC_TRUE;
+          for (cj = 0; cj < Nc; ++cj) {
+            const PetscScalar *g = &qd[p->offset + (ci*Nc+cj)*p->Nt*Nq];
+            const PetscScalar *u = &U[(Uoff+cj)*(dim+1)*Nq];
+
+            if (p->has[0]) for (q = 0; q < Nq; ++q) V[q] += g[p->off[0]*Nq+q]*u[q];
+            if (p->has[1]) for (l = 0; l < dim; ++l) for (q = 0; q < Nq; ++q) V[q] += g[(p->off[1]+l)*Nq+q]*u[(l+1)*Nq+q];
+            if (p->has[2]) for (k = 0; k < dim; ++k) for (q = 0; q < Nq; ++q) V[(k+1)*Nq+q] += g[(p->off[2]+k)*Nq+q]*u[q];
+            if (p->has[3]) {
+              for (k = 0; k < dim; ++k) for (l = 0; l < dim; ++l) for (q = 0; q < Nq; ++q) V[(k+1)*Nq+q] += g[(p->off[3]+k*dim+l)*Nq+q]*u[(l+1)*Nq+q];
+            }
+          }
+        }
+        Uoff += Nc;
+      }
+      for (s = 0; s < Ns; ++s) S[s] = 0.0;
+      if (any) {
+        for (d = -1; d < dim; ++d) {
+          const PetscReal *M[3];
+
+          for (k = 0; k < dim; ++k) M[k] = k == d ? fI->D : fI->B;
+          TensorApply_Private(dim, n, fI->k1, M, PETSC_TRUE, &V[(d+1)*Nq], S, work);
+        }
+      }
+      for (s = 0; s < Ns; ++s) y[offI+fI->bidx[s*fI->Nc+ci]] = S[s];
+    }
+    offI += fI->Nb;
+  }
+}
+
+static PetscErrorCode MatMult_Plex_MatFree(Mat A, Vec X, Vec Y)
+{
+  DMPlexMatFree *mf;
+  DM             dm;
+  PetscSection   section;
+  Vec            locX, locY;
+  PetscScalar   *y;
+  PetscInt       c;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MatShellGetContext(A, (void **) &mf);CHKERRQ(ierr);
+  if (!mf->setup) SETERRQ(PetscObjectComm((PetscObject) A), PETSC_ERR_ARG_WRONGSTATE, "Must call DMPlexComputeJacobianMatrixFree() before applying the operator");
+  dm   = mf->dm;
+  ierr = DMGetLocalSection(dm, &section);CHKERRQ(ierr);
+  ierr = DMGetLocalVector(dm, &locX);CHKERRQ(ierr);
+  ierr = DMGetLocalVector(dm, &locY);CHKERRQ(ierr);
+  /* The constrained dofs are zero, as they are left out of the assembled Jacobian */
+  ierr = VecZeroEntries(locX);CHKERRQ(ierr);
+  ierr = DMGlobalToLocalBegin(dm, X, INSERT_VALUES, locX);CHKERRQ(ierr);
+  ierr = DMGlobalToLocalEnd(dm, X, INSERT_VALUES, locX);CHKERRQ(ierr);
+  ierr = VecZeroEntries(locY);CHKERRQ(ierr);
+  ierr = DMGetWorkArray(dm, mf->totDim, MPIU_SCALAR, &y);CHKERRQ(ierr);
+  for (c = mf->cStart; c < mf->cEnd; ++c) {
+    PetscScalar *x = NULL;
+
+    ierr = DMPlexVecGetClosure(dm, section, locX, c, NULL, &x);CHKERRQ(ierr);
+    DMPlexMatFreeApplyCell_Private(mf, &mf->qdata[(c-mf->cStart)*mf->cellSize], x, y);
+    ierr = DMPlexVecRestoreClosure(dm, section, locX, c, NULL, &x);CHKERRQ(ierr);
+    ierr = DMPlexVecSetClosure(dm, section, locY, c, y, ADD_VALUES);CHKERRQ(ierr);
+  }
+  ierr = DMRestoreWorkArray(dm, mf->totDim, MPIU_SCALAR, &y);CHKERRQ(ierr);
+  ierr = VecZeroEntries(Y);CHKERRQ(ierr);
+  ierr = DMLocalToGlobalBegin(dm, locY, ADD_VALUES, Y);CHKERRQ(ierr);
+  ierr = DMLocalToGlobalEnd(dm, locY, ADD_VALUES, Y);CHKERRQ(ierr);
+  ierr = DMRestoreLocalVector(dm, &locX);CHKERRQ(ierr);
+  ierr = DMRestoreLocalVector(dm, &locY);CHKERRQ(ierr);
+  ierr = PetscLogFlops(2.0*(mf->cEnd-mf->cStart)*mf->cellSize);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* Assembles the diagonal from the entrywise products of the 1D tabulations, without forming the element matrices */
+static PetscErrorCode MatGetDiagonal_Plex_MatFree(Mat A, Vec D)
+{
+  DMPlexMatFree *mf;
+  DM             dm;
+  PetscSection   section;
+  Vec            locD;
+  PetscScalar   *y, *S, *work;
+  PetscInt       dim, Nf, Nq, c, f, off, cc, s, k, l, d;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MatShellGetContext(A, (void **) &mf);CHKERRQ(ierr);
+  if (!mf->setup) SETERRQ(PetscObjectComm((PetscObject) A), PETSC_ERR_ARG_WRONGSTATE, "Must call DMPlexComputeJacobianMatrixFree() before getting the diagonal");
+  if (mf->diag) {ierr = VecCopy(mf->diag, D);CHKERRQ(ierr); PetscFunctionReturn(0);}
+  dm   = mf->dm;
+  dim  = mf->dim;
+  Nf   = mf->Nf;
+  Nq   = mf->Nq;
+  ierr = DMGetLocalSection(dm, &section);CHKERRQ(ierr);
+  ierr = DMGetLocalVector(dm, &locD);CHKERRQ(ierr);
+  ierr = VecZeroEntries(locD);CHKERRQ(ierr);
+  ierr = DMGetWorkArray(dm, mf->totDim, MPIU_SCALAR, &y);CHKERRQ(ierr);
+  S    = mf->work;
+  work = S + mf->tsize;
+  for (c = mf->cStart; c < mf->cEnd; ++c) {
+    const PetscScalar *qd = &mf->qdata[(c-mf->cStart)*mf->cellSize];
+
+    for (f = 0, off = 0; f < Nf; ++f) {
+      const PlexMFField *fe = &mf->fields[f];
+      const PlexMFPair  *p  = &mf->pairs[f*Nf+f];
+      const PetscInt     Ns = fe->Nb/fe->Nc;
+
+      for (cc = 0; cc < fe->Nc; ++cc) {
+        const PetscScalar *g = &qd[p->offset + (cc*fe->Nc+cc)*p->Nt*Nq];
+        const PetscReal   *M[3];
+
+        for (s = 0; s < Ns; ++s) S[s] = 0.0;
+        if (p->has[0]) {
+          for (d = 0; d < dim; ++d) M[d] = fe->BB;
+          TensorApply_Private(dim, mf->n, fe->k1, M, PETSC_TRUE, &g[p->off[0]*Nq], S, work);
+        }
+        if (p->has[1]) {
+          for (l = 0; l < dim; ++l) {
+            for (d = 0; d < dim; ++d) M[d] = d == l ? fe->BD : fe->BB;
+            TensorApply_Private(dim, mf->n, fe->k1, M, PETSC_TRUE, &g[(p->off[1]+l)*Nq], S, work);
+          }
+        }
+        if (p->has[2]) {
+          for (k = 0; k < dim; ++k) {
+            for (d = 0; d < dim; ++d) M[d] = d == k ? fe->BD : fe->BB;
+            TensorApply_Private(dim, mf->n, fe->k1, M, PETSC_TRUE, &g[(p->off[2]+k)*Nq], S, work);
+          }
+        }
+        if (p->has[3]) {
+          for (k = 0; k < dim; ++k) {
+            for (l = 0; l < dim; ++l) {
+              for (d = 0; d < dim; ++d) M[d] = d == k ? (d == l ? fe->DD : fe->BD) : (d == l ? fe->BD : fe->BB);
+              TensorApply_Private(dim, mf->n, fe->k1, M, PETSC_TRUE, &g[(p->off[3]+k*dim+l)*Nq], S, work);
+            }
+          }
+        }
+        for (s = 0; s < Ns; ++s) y[off+fe->bidx[s*fe->Nc+cc]] = S[s];
+      }
+      off += fe->Nb;
+    }
+    ierr = DMPlexVecSetClosure(dm, section, locD, c, y, ADD_VALUES);CHKERRQ(ierr);
+  }
+  ierr = DMRestoreWorkArray(dm, mf->totDim, MPIU_SCALAR, &y);CHKERRQ(ierr);
+  ierr = VecZeroEntries(D);CHKERRQ(ierr);
+  ierr = DMLocalToGlobalBegin(dm, locD, ADD_VALUES, D);CHKERRQ(ierr);
+  ierr = DMLocalToGlobalEnd(dm, locD, ADD_VALUES, D);CHKERRQ(ierr);
+  ierr = DMRestoreLocalVector(dm, &locD);CHKERRQ(ierr);
+  ierr = VecDuplicate(D, &mf->diag);CHKERRQ(ierr);
+  ierr = VecCopy(D, mf->diag);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode DMPlexComputeJacobianMatrixFree_Plex(DM dm, PetscReal t, Vec X, Mat J)
+{
+  DMPlexMatFree     *mf;
+  PetscDS            ds, dsAux = NULL;
+  PetscWeakForm      wf;
+  DM                 dmAux = NULL, plexAux = NULL;
+  DMEnclosureType    encAux;
+  Vec                A;
+  PetscSection       section, sectionAux = NULL;
+  PetscQuadrature    quad;
+  PetscFE            fe;
+  PetscFEGeom       *cgeom;
+  DMField            coordField;
+  IS                 cellIS;
+  PetscTabulation   *T, *TAux = NULL;
+  PetscScalar       *u, *u_x, *a = NULL, *a_x = NULL, *g[4], *coef, *coefAux = NULL;
+  PetscReal         *xr;
+  const PetscScalar *constants;
+  const PetscReal   *quadPoints, *quadWeights;
+  PetscInt          *uOff, *uOff_x, *aOff = NULL, *aOff_x = NULL;
+  PetscInt           dim, Nf, NfAux = 0, totDim, totDimAux = 0, numConstants, Nq, Np, c, q, fieldI, fieldJ, ci, cj, i, k, l, d, e;
+  PetscErrorCode     ierr;
+
+  PetscFunctionBegin;
+  ierr = MatShellGetContext(J, (void **) &mf);CHKERRQ(ierr);
+  dim  = mf->dim;
+  Nf   = mf->Nf;
+  Nq   = mf->Nq;
+  ierr = DMGetLocalSection(dm, &section);CHKERRQ(ierr);
+  ierr = DMGetDS(dm, &ds);CHKERRQ(ierr);
+  ierr = PetscDSGetWeakForm(ds, &wf);CHKERRQ(ierr);
+  ierr = PetscDSGetTotalDimension(ds, &totDim);CHKERRQ(ierr);
+  if (totDim != mf->totDim) SETERRQ2(PetscObjectComm((PetscObject) J), PETSC_ERR_ARG_INCOMP, "The discretization has changed, the closure size %D != %D", totDim, mf->totDim);
+  ierr = PetscDSGetComponentOffsets(ds, &uOff);CHKERRQ(ierr);
+  ierr = PetscDSGetComponentDerivativeOffsets(ds, &uOff_x);CHKERRQ(ierr);
+  ierr = PetscDSGetEvaluationArrays(ds, &u, NULL, &u_x);CHKERRQ(ierr);
+  ierr = PetscDSGetWorkspace(ds, &xr, NULL, NULL, NULL, NULL);CHKERRQ(ierr);
+  ierr = PetscDSGetWeakFormArrays(ds, NULL, NULL, &g[0], &g[1], &g[2], &g[3]);CHKERRQ(ierr);
+  ierr = PetscDSGetTabulation(ds, &T);CHKERRQ(ierr);
+  ierr = PetscDSGetConstants(ds, &numConstants, &constants);CHKERRQ(ierr);
+  ierr = DMGetAuxiliaryVec(dm, NULL, 0, &A);CHKERRQ(ierr);
+  if (A) {
+    ierr = VecGetDM(A, &dmAux);CHKERRQ(ierr);
+    ierr = DMGetEnclosureRelation(dmAux, dm, &encAux);CHKERRQ(ierr);
+    ierr = DMConvert(dmAux, DMPLEX, &plexAux);CHKERRQ(ierr);
+    ierr = DMGetLocalSection(plexAux, &sectionAux);CHKERRQ(ierr);
+    ierr = DMGetDS(dmAux, &dsAux);CHKERRQ(ierr);
+    ierr = PetscDSGetNumFields(dsAux, &NfAux);CHKERRQ(ierr);
+    ierr = PetscDSGetTotalDimension(dsAux, &totDimAux);CHKERRQ(ierr);
+    ierr = PetscDSGetComponentOffsets(dsAux, &aOff);CHKERRQ(ierr);
+    ierr = PetscDSGetComponentDerivativeOffsets(dsAux, &aOff_x);CHKERRQ(ierr);
+    ierr = PetscDSGetEvaluationArrays(dsAux, &a, NULL, &a_x);CHKERRQ(ierr);
+    ierr = PetscDSGetTabulation(dsAux, &TAux);CHKERRQ(ierr);
+    if (T[0]->Np != TAux[0]->Np) SETERRQ2(PETSC_COMM_SELF, PETSC_ERR_ARG_WRONG, "Number of tabulation points %D != %D number of auxiliary tabulation points", T[0]->Np, TAux[0]->Np);
+  }
+  ierr = PetscDSGetDiscretization(ds, 0, (PetscObject *) &fe);CHKERRQ(ierr);
+  ierr = PetscFEGetQuadrature(fe, &quad);CHKERRQ(ierr);
+  ierr = PetscQuadratureGetData(quad, NULL, NULL, NULL, &quadPoints, &quadWeights);CHKERRQ(ierr);
+  ierr = ISCreateStride(PETSC_COMM_SELF, mf->cEnd-mf->cStart, mf->cStart, 1, &cellIS);CHKERRQ(ierr);
+  ierr = DMGetCoordinateField(dm, &coordField);CHKERRQ(ierr);
+  ierr = DMFieldCreateFEGeom(coordField, cellIS, quad, PETSC_FALSE, &cgeom);CHKERRQ(ierr);
+  Np   = cgeom->numPoints;
+  ierr = PetscMalloc2(totDim, &coef, totDimAux, &coefAux);CHKERRQ(ierr);
+  for (c = mf->cStart; c < mf->cEnd; ++c) {
+    const PetscInt e0 = c - mf->cStart;
+    PetscScalar   *qd = &mf->qdata[e0*mf->cellSize];
+    PetscScalar   *x  = NULL;
+    PetscFEGeom    fegeom;
+
+    if (X) {
+      ierr = DMPlexVecGetClosure(dm, section, X, c, NULL, &x);CHKERRQ(ierr);
+      for (i = 0; i < totDim; ++i) coef[i] = x[i];
+      ierr = DMPlexVecRestoreClosure(dm, section, X, c, NULL, &x);CHKERRQ(ierr);
+    } else {
+      for (i = 0; i < totDim; ++i) coef[i] = 0.0;
+    }
+    if (dmAux) {
+      PetscInt subcell;
+
+      ierr = DMGetEnclosurePoint(dmAux, dm, encAux, c, &subcell);CHKERRQ(ierr);
+      ierr = DMPlexVecGetClosure(plexAux, sectionAux, A, subcell, NULL, &x);CHKERRQ(ierr);
+      for (i = 0; i < totDimAux; ++i) coefAux[i] = x[i];
+      ierr = DMPlexVecRestoreClosure(plexAux, sectionAux, A, subcell, NULL, &x);CHKERRQ(ierr);
+    }
+    fegeom.dim      = cgeom->dim;
+    fegeom.dimEmbed = cgeom->dimEmbed;
+    fegeom.xi       = cgeom->xi;
+    for (q = 0; q < Nq; ++q) {
+      const PetscInt lq = mf->qperm[q];
+      const PetscInt gq = cgeom->isAffine ? e0*Np : e0*Np+q;
+      PetscReal      w;
+
+      fegeom.J    = &cgeom->J[gq*dim*dim];
+      fegeom.invJ = &cgeom->invJ[gq*dim*dim];
+      fegeom.detJ = &cgeom->detJ[gq];
+      if (cgeom->isAffine) {
+        CoordinatesRefToReal(dim, dim, cgeom->xi, &cgeom->v[gq*dim], fegeom.J, &quadPoints[q*dim], xr);
+        fegeom.v = xr;
+      } else fegeom.v = &cgeom->v[gq*dim];
+      w    = fegeom.detJ[0]*quadWeights[q];
+      ierr = PetscFEEvaluateFieldJets_Internal(ds, Nf, 0, q, T, &fegeom, coef, NULL, u, u_x, NULL);CHKERRQ(ierr);
+      if (dsAux) {ierr = PetscFEEvaluateFieldJets_Internal(dsAux, NfAux, 0, q, TAux, &fegeom, coefAux, NULL, a, a_x, NULL);CHKERRQ(ierr);}
+      for (fieldI = 0; fieldI < Nf; ++fieldI) {
+        for (fieldJ = 0; fieldJ < Nf; ++fieldJ) {
+          const PlexMFPair *p   = &mf->pairs[fieldI*Nf+fieldJ];
+          const PetscInt    NcI = mf->fields[fieldI].Nc, NcJ = mf->fields[fieldJ].Nc;
+          const PetscReal  *iJ  = fegeom.invJ;
+          PetscPointJac    *gf[4];
+          PetscInt          ng[4], m;
+
+          if (!p->Nt) continue;
+          ierr = PetscWeakFormGetJacobian(wf, NULL, 0, fieldI, fieldJ, &ng[0], &gf[0], &ng[1], &gf[1], &ng[2], &gf[2], &ng[3], &gf[3]);CHKERRQ(ierr);
+          for (m = 0; m < 4; ++m) {
+            const PetscInt gsize = NcI*NcJ*(m == 0 ? 1 : (m == 3 ? dim*dim : dim));
+
+            if (!p->has[m]) continue;
+            ierr = PetscArrayzero(g[m], gsize);CHKERRQ(ierr);
+            for (i = 0; i < ng[m]; ++i) gf[m][i](dim, Nf, NfAux, uOff, uOff_x, u, NULL, u_x, aOff, aOff_x, a, NULL, a_x, t, 0.0, fegeom.v, numConstants, constants, g[m]);
+          }
+          /* Store w g with the real gradients pulled back to the reference cell, grad = invJ^T grad_ref */
+          for (ci = 0; ci < NcI; ++ci) {
+            for (cj = 0; cj < NcJ; ++cj) {
+              const PetscInt cc = ci*NcJ+cj;
+              PetscScalar   *gd = &qd[p->offset + cc*p->Nt*Nq];
+
+              if (p->has[0]) gd[p->off[0]*Nq+lq] = w*g[0][cc];
+              if (p->has[1]) {
+                for (l = 0; l < dim; ++l) {
+                  PetscScalar v = 0.0;
+
+                  for (e = 0; e < dim; ++e) v += g[1][cc*dim+e]*iJ[l*dim+e];
+                  gd[(p->off[1]+l)*Nq+lq] = w*v;
+                }
+              }
+              if (p->has[2]) {
+                for (k = 0; k < dim; ++k) {
+                  PetscScalar v = 0.0;
+
+                  for (d = 0; d < dim; ++d) v += iJ[k*dim+d]*g[2][cc*dim+d];
+                  gd[(p->off[2]+k)*Nq+lq] = w*v;
+                }
+              }
+              if (p->has[3]) {
+                for (k = 0; k < dim; ++k) {
+                  for (l = 0; l < dim; ++l) {
+                    PetscScalar v = 0.0;
+
+                    for (d = 0; d < dim; ++d) for (e = 0; e < dim; ++e) v += iJ[k*dim+d]*g[3][(cc*dim+d)*dim+e]*iJ[l*dim+e];
+                    gd[(p->off[3]+k*dim+l)*Nq+lq] = w*v;
+                  }
+                }
+              }
+            }
+          }
+        }
+      }
+    }
+  }
+  ierr = PetscFree2(coef, coefAux);CHKERRQ(ierr);
+  ierr = PetscFEGeomDestroy(&cgeom);CHKERRQ(ierr);
+  ierr = ISDestroy(&cellIS);CHKERRQ(ierr);
+  ierr = DMDestroy(&plexAux);CHKERRQ(ierr);
+  ierr = VecDestroy(&mf->diag);CHKERRQ(ierr);
+  mf->setup = PETSC_TRUE;
+  PetscFunctionReturn(0);
+}
+
+/*
+  Turns the MATSHELL J into the matrix-free Jacobian of dm if the discretization is supported: a single PetscDS of H^1
+  tensor product PetscFE fields sharing a tensor product quadrature, on a mesh of segments, quadrilaterals or hexahedra.
+  Otherwise J is left alone and flg is PETSC_FALSE.
+*/
+PetscErrorCode DMPlexSetUpMatrixFree_Internal(DM dm, Mat J, PetscBool *flg)
+{
+  DMPlexMatFree   *mf;
+  PetscDS          ds;
+  PetscWeakForm    wf;
+  PetscQuadrature  quad = NULL;
+  PetscTabulation *T;
+  PetscReal       *u1;
+  PetscInt        *qidx;
+  const PetscReal *quadPoints;
+  PetscInt         Nds, Nf, dim, cdim, Nq, n = 0, nd, size, maxSize = 0, NcT = 0, cStart, cEnd, c, f, g, d, q;
+  PetscBool        supported = PETSC_TRUE, transform;
+  PetscErrorCode   ierr;
+
+  PetscFunctionBegin;
+  *flg = PETSC_FALSE;
+  ierr = DMGetNumDS(dm, &Nds);CHKERRQ(ierr);
+  ierr = DMGetNumFields(dm, &Nf);CHKERRQ(ierr);
+  ierr = DMHasBasisTransform(dm, &transform);CHKERRQ(ierr);
+  if (Nds != 1 || !Nf || transform) PetscFunctionReturn(0);
+  ierr = DMGetDimension(dm, &dim);CHKERRQ(ierr);
+  ierr = DMGetCoordinateDim(dm, &cdim);CHKERRQ(ierr);
+  if (cdim != dim) supported = PETSC_FALSE;
+  ierr = DMGetDS(dm, &ds);CHKERRQ(ierr);
+  /* Boundary and dynamic Jacobian terms, and anchored (constrained) points, are not applied by the matrix-free kernel */
+  {
+    PetscSection aSec;
+    PetscBool    hasBd, hasDyn;
+
+    ierr = PetscDSHasBdJacobian(ds, &hasBd);CHKERRQ(ierr);
+    ierr = PetscDSHasDynamicJacobian(ds, &hasDyn);CHKERRQ(ierr);
+    ierr = DMPlexGetAnchors(dm, &aSec, NULL);CHKERRQ(ierr);
+    if (hasBd || hasDyn || aSec) supported = PETSC_FALSE;
+  }
+  ierr = DMPlexGetSimplexOrBoxCells(dm, 0, &cStart, &cEnd);CHKERRQ(ierr);
+  for (c = cStart; c < cEnd; ++c) {
+    DMPolytopeType ct;
+
+    ierr = DMPlexGetCellType(dm, c, &ct);CHKERRQ(ierr);
+    if (ct != DM_POLYTOPE_SEGMENT && ct != DM_POLYTOPE_QUADRILATERAL && ct != DM_POLYTOPE_HEXAHEDRON) {supported = PETSC_FALSE; break;}
+  }
+  for (f = 0; f < Nf && supported; ++f) {
+    PetscObject     obj;
+    PetscClassId    id;
+    PetscQuadrature fq;
+
+    ierr = PetscDSGetDiscretization(ds, f, &obj);CHKERRQ(ierr);
+    ierr = PetscObjectGetClassId(obj, &id);CHKERRQ(ierr);
+    if (id != PETSCFE_CLASSID) {supported = PETSC_FALSE; break;}
+    ierr = PetscFEGetQuadrature((PetscFE) obj, &fq);CHKERRQ(ierr);
+    if (!quad) quad = fq;
+    else if (fq != quad) {
+      const PetscReal *p0, *p1;
+      PetscInt         Nq0, Nq1;
+
+      ierr = PetscQuadratureGetData(quad, NULL, NULL, &Nq0, &p0, NULL);CHKERRQ(ierr);
+      ierr = PetscQuadratureGetData(fq, NULL, NULL, &Nq1, &p1, NULL);CHKERRQ(ierr);
+      if (Nq0 != Nq1) supported = PETSC_FALSE;
+      for (q = 0; q < Nq0*dim && supported; ++q) if (PetscAbsReal(p0[q] - p1[q]) > PETSC_SMALL) supported = PETSC_FALSE;
+    }
+  }
+  if (!supported || dim < 1 || dim > 3) {
+    ierr = PetscInfo(dm, "The discretization is not supported by the matrix-free Jacobian, which needs tensor product cells and elements\n");CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  /* The tensor product quadrature */
+  ierr = PetscQuadratureGetData(quad, NULL, NULL, &Nq, &quadPoints, NULL);CHKERRQ(ierr);
+  ierr = PetscMalloc2(Nq, &u1, Nq*dim, &qidx);CHKERRQ(ierr);
+  {
+    PetscInt *didx;
+
+    ierr = PetscMalloc1(Nq, &didx);CHKERRQ(ierr);
+    for (d = 0; d < dim; ++d) {
+      ierr = UniqueCoordinates_Private(Nq, dim, d, quadPoints, &nd, u1, didx);CHKERRQ(ierr);
+      if (!d) n = nd;
+      else if (nd != n) supported = PETSC_FALSE;
+      for (q = 0; q < Nq; ++q) qidx[q*dim+d] = didx[q];
+    }
+    ierr = PetscFree(didx);CHKERRQ(ierr);
+  }
+  for (size = 1, d = 0; d < dim; ++d) size *= n;
+  if (size != Nq) supported = PETSC_FALSE;
+  ierr = PetscNew(&mf);CHKERRQ(ierr);
+  ierr = PetscCalloc3(Nf, &mf->fields, Nf*Nf, &mf->pairs, Nq, &mf->qperm);CHKERRQ(ierr);
+  mf->dim = dim;
+  mf->Nf  = Nf;
+  mf->n   = n;
+  mf->Nq  = Nq;
+  for (q = 0; q < Nq; ++q) {
+    for (mf->qperm[q] = 0, d = dim-1; d >= 0; --d) mf->qperm[q] = mf->qperm[q]*n + qidx[q*dim+d];
+  }
+  ierr = PetscDSGetTabulation(ds, &T);CHKERRQ(ierr);
+  for (f = 0; f < Nf && supported; ++f) {
+    PetscFE fe;
+
+    ierr = PetscDSGetDiscretization(ds, f, (PetscObject *) &fe);CHKERRQ(ierr);
+    ierr = PlexMFFieldSetUp_Private(fe, T[f], dim, n, quadPoints, qidx, &mf->fields[f], &supported);CHKERRQ(ierr);
+  }
+  ierr = PetscFree2(u1, qidx);CHKERRQ(ierr);
+  if (!supported) {
+    for (g = 0; g < f; ++g) {
+      ierr = PetscFree(mf->fields[g].bidx);CHKERRQ(ierr);
+      ierr = PetscFree5(mf->fields[g].B, mf->fields[g].D, mf->fields[g].BB, mf->fields[g].BD, mf->fields[g].DD);CHKERRQ(ierr);
+    }
+    ierr = PetscFree3(mf->fields, mf->pairs, mf->qperm);CHKERRQ(ierr);
+    ierr = PetscFree(mf);CHKERRQ(ierr);
+    ierr = PetscInfo(dm, "The elements are not tensor products of 1D Lagrange elements on the quadrature, so the matrix-free Jacobian is not used\n");CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  /* The layout of the pointwise data */
+  ierr = PetscDSGetWeakForm(ds, &wf);CHKERRQ(ierr);
+  for (f = 0; f < Nf; ++f) {
+    for (g = 0; g < Nf; ++g) {
+      PlexMFPair    *p = &mf->pairs[f*Nf+g];
+      PetscPointJac *gf[4];
+      PetscInt       ng[4], m, sizes[4] = {1, dim, dim, dim*dim};
+
+      ierr = PetscWeakFormGetJacobian(wf, NULL, 0, f, g, &ng[0], &gf[0], &ng[1], &gf[1], &ng[2], &gf[2], &ng[3], &gf[3]);CHKERRQ(ierr);
+      for (m = 0, p->Nt = 0; m < 4; ++m) {
+        p->has[m] = ng[m] ? PETSC_TRUE : PETSC_FALSE;
+        p->off[m] = p->Nt;
+        if (p->has[m]) p->Nt += sizes[m];
+      }
+      p->offset     = mf->cellSize;
+      mf->cellSize += mf->fields[f].Nc*mf->fields[g].Nc*p->Nt*Nq;
+    }
+  }
+  for (f = 0; f < Nf; ++f) {
+    NcT     += mf->fields[f].Nc;
+    maxSize  = PetscMax(maxSize, mf->fields[f].k1);
+    mf->totDim += mf->fields[f].Nb;
+  }
+  for (size = 1, d = 0; d < dim; ++d) size *= PetscMax(n, maxSize);
+  mf->tsize  = size;
+  mf->cStart = cStart;
+  mf->cEnd   = cEnd;
+  ierr = PetscMalloc1((cEnd-cStart)*mf->cellSize, &mf->qdata);CHKERRQ(ierr);
+  ierr = PetscMalloc1((NcT+1)*(dim+1)*Nq + 3*size, &mf->work);CHKERRQ(ierr);
+  ierr = PetscObjectReference((PetscObject) dm);CHKERRQ(ierr);
+  mf->dm = dm;
+  /* The closures are read and written at every application */
+  ierr = DMPlexCreateClosureDofIndex(dm, NULL, NULL);CHKERRQ(ierr);
+  ierr = MatShellSetContext(J, mf);CHKERRQ(ierr);
+  ierr = MatShellSetOperation(J, MATOP_MULT, (void (*)(void)) MatMult_Plex_MatFree);CHKERRQ(ierr);
+  ierr = MatShellSetOperation(J, MATOP_GET_DIAGONAL, (void (*)(void)) MatGetDiagonal_Plex_MatFree);CHKERRQ(ierr);
+  ierr = MatShellSetOperation(J, MATOP_DESTROY, (void (*)(void)) MatDestroy_Plex_MatFree);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject) J, "DMPlexComputeJacobianMatrixFree_C", DMPlexComputeJacobianMatrixFree_Plex);CHKERRQ(ierr);
+  *flg = PETSC_TRUE;
+  PetscFunctionReturn(0);
+}
+
+/*@
+  DMPlexCreateMatrixFree - Creates a matrix-free Jacobian for the finite element discretization of the DM
+
+  Collective on dm
+
+  Input Parameter:
+. dm - The DMPlex
+
+  Output Parameter:
+. J - The MATSHELL
+
+  Notes:
+  This is what DMCreateMatrix() returns for the matrix type MATSHELL, which is set with DMSetMatType() or
+  -dm_mat_type shell. DMPlexSNESComputeJacobianFEM() then calls DMPlexComputeJacobianMatrixFree() instead of assembling
+  the Jacobian, so that with -dm_refine_hierarchy, -pc_type mg, -mg_levels_ksp_type chebyshev, -mg_levels_pc_type
+  jacobi and a Jacobi preconditioned Krylov coarse solver no matrix is stored on any level.
+
+  The mesh must have segments, quadrilaterals or hexahedra, and each field must be a PetscFE whose basis is the tensor
+  product of Lagrange polynomials, with the same tensor product quadrature for all fields, as given by
+  PetscFECreateDefault() with tensor cells. The operator is then applied by sum factorization: the values and
+  reference gradients at the quadrature points are computed one direction at a time from the 1D tabulation, which for
+  degree k in dimension d costs O(k^(d+1)) per cell instead of the O(k^(2d)) of an element matrix. The pointwise
+  Jacobian functions are evaluated once by DMPlexComputeJacobianMatrixFree(), which stores the weighted terms g0, g1,
+  g2 and g3 that are present at each quadrature point, pulled back to the reference cell. MatGetDiagonal() forms the
+  diagonal from the squares of the 1D tabulation without forming the element matrices.
+
+  Only the Jacobian of a single PetscDS without a dynamic or preconditioner part is supported.
+
+  Level: intermediate
+
+.seealso: DMPlexComputeJacobianMatrixFree(), DMCreateMatrix(), DMPlexSNESComputeJacobianFEM(), DMPlexComputeJacobianAction()
+@*/
+PetscErrorCode DMPlexCreateMatrixFree(DM dm, Mat *J)
+{
+  PetscSection   gsection;
+  PetscInt       localSize;
+  PetscBool      flg;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(dm, DM_CLASSID, 1);
+  PetscValidPointer(J, 2);
+  ierr = DMGetGlobalSection(dm, &gsection);CHKERRQ(ierr);
+  ierr = PetscSectionGetConstrainedStorageSize(gsection, &localSize);CHKERRQ(ierr);
+  ierr = MatCreateShell(PetscObjectComm((PetscObject) dm), localSize, localSize, PETSC_DETERMINE, PETSC_DETERMINE, NULL, J);CHKERRQ(ierr);
+  ierr = DMPlexSetUpMatrixFree_Internal(dm, *J, &flg);CHKERRQ(ierr);
+  if (!flg) SETERRQ(PetscObjectComm((PetscObject) dm), PETSC_ERR_SUP, "The matrix-free Jacobian needs tensor product cells and tensor product Lagrange elements");
+  ierr = MatSetDM(*J, dm);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*@
+  DMPlexComputeJacobianMatrixFree - Computes the pointwise data of the matrix-free Jacobian at the local solution X
+
+  Collective on dm
+
+  Input Parameters:
++ dm - The DMPlex
+. t  - The time
+. X  - The local solution, or NULL for the Jacobian at zero
+- J  - The matrix from DMPlexCreateMatrixFree()
+
+  Note:
+  DMPlexSNESComputeJacobianFEM() calls this when the Jacobian is matrix-free. The pointwise Jacobian functions of the
+  PetscDS are evaluated at each quadrature point of each cell and stored with the geometry folded in, and the diagonal
+  is recomputed at the next MatGetDiagonal().
+
+  Level: intermediate
+
+.seealso: DMPlexCreateMatrixFree(), DMPlexSNESComputeJacobianFEM()
+@*/
+PetscErrorCode DMPlexComputeJacobianMatrixFree(DM dm, PetscReal t, Vec X, Mat J)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(dm, DM_CLASSID, 1);
+  if (X) PetscValidHeaderSpecific(X, VEC_CLASSID, 3);
+  PetscValidHeaderSpecific(J, MAT_CLASSID, 4);
+  ierr = PetscUseMethod(J, "DMPlexComputeJacobianMatrixFree_C", (DM, PetscReal, Vec, Mat), (dm, t, X, J));CHKERRQ(ierr);
+  ierr = PetscObjectStateIncrease((PetscObject) J);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
@@ -1,6 +1,8 @@
 #include <petsc/private/dmpleximpl.h>   /*I      "petscdmplex.h"   I*/
 #include <petsc/private/matorderimpl.h> /*I      "petscmat.h"      I*/
 
+const char * const DMPlexReorderLocalityTypes[] = {"none", "rcm", "hilbert", "morton", "DMPlexReorderLocalityType", "DMPLEX_REORDER_LOCALITY_", NULL};
+
 static PetscErrorCode DMPlexCreateOrderingClosure_Static(DM dm, PetscInt numPoints, const PetscInt pperm[], PetscInt **clperm, PetscInt **invclperm)
 {
   PetscInt      *perm, *iperm;
@@ -45,6 +47,137 @@ static PetscErrorCode DMPlexCreateOrderingClosure_Static(DM dm, PetscInt numPoin
   PetscFunctionReturn(0);
 }
 
+/* Orders the cells by Reverse Cuthill-McKee on the cell adjacency graph, cperm[new cell number] = old cell number */
+static PetscErrorCode DMPlexGetCellOrderingRCM_Static(DM dm, PetscInt *numCells, PetscInt **cperm)
+{
+  PetscInt      *start = NULL, *adjacency = NULL, *mask, *xls, n = 0, c, i;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = DMPlexCreateNeighborCSR(dm, 0, &n, &start, &adjacency);CHKERRQ(ierr);
+  ierr = PetscMalloc1(n, cperm);CHKERRQ(ierr);
+  ierr = PetscMalloc2(n,&mask,n*2,&xls);CHKERRQ(ierr);
+  if (n) {
+    /* Shift for Fortran numbering */
+    for (i = 0; i < start[n]; ++i) ++adjacency[i];
+    for (i = 0; i <= n; ++i)       ++start[i];
+    ierr = SPARSEPACKgenrcm(&n, start, adjacency, *cperm, mask, xls);CHKERRQ(ierr);
+  }
+  ierr = PetscFree(start);CHKERRQ(ierr);
+  ierr = PetscFree(adjacency);CHKERRQ(ierr);
+  ierr = PetscFree2(mask,xls);CHKERRQ(ierr);
+  /* Shift for Fortran numbering */
+  for (c = 0; c < n; ++c) --(*cperm)[c];
+  *numCells = n;
+  PetscFunctionReturn(0);
+}
+
+/* Skilling's transform of the dim coordinates x[] of b bits into the transposed Hilbert index, AIP Conf. Proc. 707, 381 (2004) */
+static void DMPlexHilbertTranspose_Private(PetscInt dim, PetscInt b, PetscInt x[])
+{
+  const PetscInt M = (PetscInt) 1 << (b-1);
+  PetscInt       P, Q, t, i;
+
+  for (Q = M; Q > 1; Q >>= 1) {
+    P = Q - 1;
+    for (i = 0; i < dim; ++i) {
+      if (x[i] & Q) x[0] ^= P;
+      else {
+        t     = (x[0] ^ x[i]) & P;
+        x[0] ^= t;
+        x[i] ^= t;
+      }
+    }
+  }
+  /* Gray encode */
+  for (i = 1; i < dim; ++i) x[i] ^= x[i-1];
+  t = 0;
+  for (Q = M; Q > 1; Q >>= 1) if (x[dim-1] & Q) t ^= Q - 1;
+  for (i = 0; i < dim; ++i) x[i] ^= t;
+}
+
+/* Orders the cells along a Hilbert or Morton curve through their centroids, cperm[new cell number] = old cell number */
+static PetscErrorCode DMPlexGetCellOrderingCurve_Static(DM dm, PetscBool hilbert, PetscInt **cperm)
+{
+  DM             cdm;
+  PetscSection   csection;
+  Vec            coordinates;
+  PetscReal     *centroids, lo[3], hi[3];
+  PetscInt      *keys, cdim, dim, b, cStart, cEnd, csStart, csEnd, c, d;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = DMGetCoordinateDim(dm, &cdim);CHKERRQ(ierr);
+  ierr = DMGetCoordinateDM(dm, &cdm);CHKERRQ(ierr);
+  ierr = DMGetLocalSection(cdm, &csection);CHKERRQ(ierr);
+  ierr = PetscSectionGetChart(csection, &csStart, &csEnd);CHKERRQ(ierr);
+  ierr = DMGetCoordinatesLocal(dm, &coordinates);CHKERRQ(ierr);
+  ierr = DMPlexGetHeightStratum(dm, 0, &cStart, &cEnd);CHKERRQ(ierr);
+  dim  = PetscMin(cdim, 3);
+  b    = 30/dim;
+  ierr = PetscMalloc1(cEnd-cStart, cperm);CHKERRQ(ierr);
+  ierr = PetscMalloc2((cEnd-cStart)*dim,&centroids,cEnd-cStart,&keys);CHKERRQ(ierr);
+  for (d = 0; d < dim; ++d) {lo[d] = PETSC_MAX_REAL; hi[d] = PETSC_MIN_REAL;}
+  for (c = cStart; c < cEnd; ++c) {
+    PetscScalar *x = NULL;
+    PetscReal   *centroid = &centroids[(c-cStart)*dim];
+    PetscInt     csize, cldof = 0, Nv, v;
+
+    /* Periodic meshes store the localized coordinates of the cell on the cell, which are first in the closure */
+    if (c >= csStart && c < csEnd) {ierr = PetscSectionGetDof(csection, c, &cldof);CHKERRQ(ierr);}
+    ierr = DMPlexVecGetClosure(cdm, csection, coordinates, c, &csize, &x);CHKERRQ(ierr);
+    Nv   = (cldof ? cldof : csize)/cdim;
+    for (d = 0; d < dim; ++d) {
+      centroid[d] = 0.0;
+      for (v = 0; v < Nv; ++v) centroid[d] += PetscRealPart(x[v*cdim+d]);
+      centroid[d] /= PetscMax(Nv, 1);
+      lo[d] = PetscMin(lo[d], centroid[d]);
+      hi[d] = PetscMax(hi[d], centroid[d]);
+    }
+    ierr = DMPlexVecRestoreClosure(cdm, csection, coordinates, c, &csize, &x);CHKERRQ(ierr);
+  }
+  for (c = 0; c < cEnd-cStart; ++c) {
+    PetscInt q[3], key = 0, i;
+
+    for (d = 0; d < dim; ++d) {
+      q[d] = hi[d] > lo[d] ? (PetscInt) ((centroids[c*dim+d] - lo[d])/(hi[d] - lo[d])*(((PetscInt) 1 << b) - 1)) : 0;
+      q[d] = PetscMin(PetscMax(q[d], 0), ((PetscInt) 1 << b) - 1);
+    }
+    if (hilbert) DMPlexHilbertTranspose_Private(dim, b, q);
+    /* Interleave the bits, most significant first */
+    for (i = b-1; i >= 0; --i) for (d = 0; d < dim; ++d) key = (key << 1) | ((q[d] >> i) & 1);
+    keys[c]      = key;
+    (*cperm)[c] = c;
+  }
+  ierr = PetscSortIntWithArray(cEnd-cStart, keys, *cperm);CHKERRQ(ierr);
+  ierr = PetscFree2(centroids,keys);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* Keeps the cells of each contiguous run of the same cell type in that run, in the order given by cperm */
+static PetscErrorCode DMPlexSegregateCellTypes_Static(DM dm, PetscInt numCells, PetscInt cperm[])
+{
+  DMPolytopeType ct, ctPrev = DM_POLYTOPE_UNKNOWN;
+  PetscInt      *run, *off, *sperm, numRuns = 0, cStart, c;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = DMPlexGetHeightStratum(dm, 0, &cStart, NULL);CHKERRQ(ierr);
+  ierr = PetscMalloc3(numCells,&run,numCells,&off,numCells,&sperm);CHKERRQ(ierr);
+  for (c = 0; c < numCells; ++c) {
+    ierr = DMPlexGetCellType(dm, cStart+c, &ct);CHKERRQ(ierr);
+    if (!c || ct != ctPrev) off[numRuns++] = c;
+    run[c] = numRuns-1;
+    ctPrev = ct;
+  }
+  if (numRuns > 1) {
+    for (c = 0; c < numCells; ++c) sperm[off[run[cperm[c]]]++] = cperm[c];
+    ierr = PetscArraycpy(cperm, sperm, numCells);CHKERRQ(ierr);
+  }
+  ierr = PetscFree3(run,off,sperm);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 /*@
   DMPlexGetOrdering - Calculate a reordering of the mesh
 
@@ -74,24 +207,13 @@ $     MATORDERINGQMD - Quotient Minimum Degree
 PetscErrorCode DMPlexGetOrdering(DM dm, MatOrderingType otype, DMLabel label, IS *perm)
 {
   PetscInt       numCells = 0;
-  PetscInt      *start = NULL, *adjacency = NULL, *cperm, *clperm = NULL, *invclperm = NULL, *mask, *xls, pStart, pEnd, c, i;
+  PetscInt      *cperm, *clperm = NULL, *invclperm = NULL, pStart, pEnd, c;
   PetscErrorCode ierr;
 
   PetscFunctionBegin;
   PetscValidHeaderSpecific(dm, DM_CLASSID, 1);
   PetscValidPointer(perm, 3);
-  ierr = DMPlexCreateNeighborCSR(dm, 0, &numCells, &start, &adjacency);CHKERRQ(ierr);
-  ierr = PetscMalloc3(numCells,&cperm,numCells,&mask,numCells*2,&xls);CHKERRQ(ierr);
-  if (numCells) {
-    /* Shift for Fortran numbering */
-    for (i = 0; i < start[numCells]; ++i) ++adjacency[i];
-    for (i = 0; i <= numCells; ++i)       ++start[i];
-    ierr = SPARSEPACKgenrcm(&numCells, start, adjacency, cperm, mask, xls);CHKERRQ(ierr);
-  }
-  ierr = PetscFree(start);CHKERRQ(ierr);
-  ierr = PetscFree(adjacency);CHKERRQ(ierr);
-  /* Shift for Fortran numbering */
-  for (c = 0; c < numCells; ++c) --cperm[c];
+  ierr = DMPlexGetCellOrderingRCM_Static(dm, &numCells, &cperm);CHKERRQ(ierr);
   /* Segregate */
   if (label) {
     IS              valueIS;
@@ -130,7 +252,7 @@ PetscErrorCode DMPlexGetOrdering(DM dm, MatOrderingType otype, DMLabel label, IS
   }
   /* Construct closure */
   ierr = DMPlexCreateOrderingClosure_Static(dm, numCells, cperm, &clperm, &invclperm);CHKERRQ(ierr);
-  ierr = PetscFree3(cperm,mask,xls);CHKERRQ(ierr);
+  ierr = PetscFree(cperm);CHKERRQ(ierr);
   ierr = PetscFree(clperm);CHKERRQ(ierr);
   /* Invert permutation */
   ierr = DMPlexGetChart(dm, &pStart, &pEnd);CHKERRQ(ierr);
@@ -138,6 +260,66 @@ PetscErrorCode DMPlexGetOrdering(DM dm, MatOrderingType otype, DMLabel label, IS
   PetscFunctionReturn(0);
 }
 
+/*@
+  DMPlexGetLocalityOrdering - Calculate a reordering of the mesh that improves the memory locality of cell loops
+
+  Collective on dm
+
+  Input Parameters:
++ dm   - The DMPlex object
+- type - The ordering of the cells, one of
+$     DMPLEX_REORDER_LOCALITY_NONE    - Keep the cell order
+$     DMPLEX_REORDER_LOCALITY_RCM     - Reverse Cuthill-McKee on the cell adjacency graph
+$     DMPLEX_REORDER_LOCALITY_HILBERT - Hilbert curve through the cell centroids
+$     DMPLEX_REORDER_LOCALITY_MORTON  - Morton (Z-order) curve through the cell centroids
+
+  Output Parameter:
+. perm - The point permutation as an IS, perm[old point number] = new point number
+
+  Notes:
+  The faces, edges and vertices are numbered in the order the cells first touch them. The cells of each contiguous run
+  of the same cell type stay in that run, so for example hybrid cells remain at the end of the cells. The curves are
+  computed from the local coordinates with 30/d bits in each of the d coordinate directions, the orderings only use
+  local information.
+
+  Level: intermediate
+
+.seealso: DMPlexGetOrdering(), DMPlexPermute(), DMPlexSetReorderLocality(), DMPlexDistribute()
+@*/
+PetscErrorCode DMPlexGetLocalityOrdering(DM dm, DMPlexReorderLocalityType type, IS *perm)
+{
+  PetscInt       numCells, cStart, cEnd, c;
+  PetscInt      *cperm, *clperm = NULL, *invclperm = NULL, pStart, pEnd;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(dm, DM_CLASSID, 1);
+  PetscValidPointer(perm, 3);
+  ierr = DMPlexGetHeightStratum(dm, 0, &cStart, &cEnd);CHKERRQ(ierr);
+  numCells = cEnd - cStart;
+  switch (type) {
+  case DMPLEX_REORDER_LOCALITY_NONE:
+    ierr = PetscMalloc1(numCells, &cperm);CHKERRQ(ierr);
+    for (c = 0; c < numCells; ++c) cperm[c] = c;
+    break;
+  case DMPLEX_REORDER_LOCALITY_RCM:
+    ierr = DMPlexGetCellOrderingRCM_Static(dm, &numCells, &cperm);CHKERRQ(ierr);
+    break;
+  case DMPLEX_REORDER_LOCALITY_HILBERT:
+  case DMPLEX_REORDER_LOCALITY_MORTON:
+    ierr = DMPlexGetCellOrderingCurve_Static(dm, type == DMPLEX_REORDER_LOCALITY_HILBERT ? PETSC_TRUE : PETSC_FALSE, &cperm);CHKERRQ(ierr);
+    break;
+  default: SETERRQ1(PetscObjectComm((PetscObject) dm), PETSC_ERR_ARG_OUTOFRANGE, "Invalid locality ordering %d", (int) type);
+  }
+  ierr = DMPlexSegregateCellTypes_Static(dm, numCells, cperm);CHKERRQ(ierr);
+  ierr = DMPlexCreateOrderingClosure_Static(dm, numCells, cperm, &clperm, &invclperm);CHKERRQ(ierr);
+  ierr = PetscFree(cperm);CHKERRQ(ierr);
+  ierr = PetscFree(clperm);CHKERRQ(ierr);
+  ierr = DMPlexGetChart(dm, &pStart, &pEnd);CHKERRQ(ierr);
+  ierr = ISCreateGeneral(PetscObjectComm((PetscObject) dm), pEnd-pStart, invclperm, PETSC_OWN_POINTER, perm);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 /*@
   DMPlexPermute - Reorder the mesh according to the input permutation
 
@@ -150,16 +332,23 @@ PetscErrorCode DMPlexGetOrdering(DM dm, MatOrderingType otype, DMLabel label, IS
   Output Parameter:
 . pdm - The permuted DM
 
+  Note: The point SF, coordinates, labels, periodicity and the tree of a non-conforming mesh are permuted as well. Each
+  process permutes its own points, the permutation must be computed on all processes of a distributed mesh.
+
   Level: intermediate
 
-.seealso: MatPermute()
+.seealso: MatPermute(), DMPlexGetOrdering(), DMPlexGetLocalityOrdering()
 @*/
 PetscErrorCode DMPlexPermute(DM dm, IS perm, DM *pdm)
 {
-  DM_Plex       *plex = (DM_Plex *) dm->data, *plexNew;
-  PetscSection   section, sectionNew;
-  PetscInt       dim;
-  PetscErrorCode ierr;
+  DM_Plex              *plex = (DM_Plex *) dm->data, *plexNew;
+  PetscSection          section, sectionNew;
+  PetscInt              dim, cdim;
+  PetscBool             isper;
+  const PetscReal      *maxCell, *L;
+  const DMBoundaryType *bd;
+  const char           *name;
+  PetscErrorCode        ierr;
 
   PetscFunctionBegin;
   PetscValidHeaderSpecific(dm, DM_CLASSID, 1);
@@ -169,16 +358,26 @@ PetscErrorCode DMPlexPermute(DM dm, IS perm, DM *pdm)
   ierr = DMSetType(*pdm, DMPLEX);CHKERRQ(ierr);
   ierr = DMGetDimension(dm, &dim);CHKERRQ(ierr);
   ierr = DMSetDimension(*pdm, dim);CHKERRQ(ierr);
+  ierr = DMGetCoordinateDim(dm, &cdim);CHKERRQ(ierr);
+  ierr = DMSetCoordinateDim(*pdm, cdim);CHKERRQ(ierr);
+  ierr = PetscObjectGetName((PetscObject) dm, &name);CHKERRQ(ierr);
+  ierr = PetscObjectSetName((PetscObject) *pdm, name);CHKERRQ(ierr);
   ierr = DMCopyDisc(dm, *pdm);CHKERRQ(ierr);
-  ierr = DMGetLocalSection(dm, &section);CHKERRQ(ierr);
+  /* Do not create the local section here, the permuted DM creates its own from the discretization */
+  section = dm->localSection;
   if (section) {
     ierr = PetscSectionPermute(section, perm, &sectionNew);CHKERRQ(ierr);
     ierr = DMSetLocalSection(*pdm, sectionNew);CHKERRQ(ierr);
     ierr = PetscSectionDestroy(&sectionNew);CHKERRQ(ierr);
   }
   plexNew = (DM_Plex *) (*pdm)->data;
+  plexNew->overlap          = plex->overlap;
+  plexNew->partitionBalance = plex->partitionBalance;
+  plexNew->reorderLocality  = plex->reorderLocality;
+  ierr = DMGetPeriodicity(dm, &isper, &maxCell, &L, &bd);CHKERRQ(ierr);
+  ierr = DMSetPeriodicity(*pdm, isper, maxCell, L, bd);CHKERRQ(ierr);
   /* Ignore ltogmap, ltogmapb */
-  /* Ignore sf, sectionSF */
+  /* Ignore sectionSF */
   /* Ignore globalVertexNumbers, globalCellNumbers */
   /* Reorder labels */
   {
@@ -246,7 +445,6 @@ PetscErrorCode DMPlexPermute(DM dm, IS perm, DM *pdm)
     PetscScalar    *coords, *coordsNew;
     const PetscInt *pperm;
     PetscInt        pStart, pEnd, p;
-    const char     *name;
 
     ierr = DMGetCoordinateDM(dm, &cdm);CHKERRQ(ierr);
     ierr = DMGetLocalSection(cdm, &csection);CHKERRQ(ierr);
@@ -262,7 +460,7 @@ PetscErrorCode DMPlexPermute(DM dm, IS perm, DM *pdm)
     for (p = pStart; p < pEnd; ++p) {
       PetscInt dof, off, offNew, d;
 
-      ierr = PetscSectionGetDof(csectionNew, p, &dof);CHKERRQ(ierr);
+      ierr = PetscSectionGetDof(csection, p, &dof);CHKERRQ(ierr);
       ierr = PetscSectionGetOffset(csection, p, &off);CHKERRQ(ierr);
       ierr = PetscSectionGetOffset(csectionNew, pperm[p], &offNew);CHKERRQ(ierr);
       for (d = 0; d < dof; ++d) coordsNew[offNew+d] = coords[off+d];
@@ -276,6 +474,88 @@ PetscErrorCode DMPlexPermute(DM dm, IS perm, DM *pdm)
     ierr = PetscSectionDestroy(&csectionNew);CHKERRQ(ierr);
     ierr = VecDestroy(&coordinatesNew);CHKERRQ(ierr);
   }
+  /* Reorder the point SF, the remote points are renumbered by the permutation of their owner */
+  {
+    DM                 cdmNew;
+    PetscSF            sf, sfNew;
+    const PetscInt    *pperm, *leaves;
+    const PetscSFNode *remotes;
+    PetscInt          *rperm, *newLeaves, nroots, nleaves, pStart, pEnd, l;
+    PetscSFNode       *newRemotes, *work;
+
+    ierr = DMGetPointSF(dm, &sf);CHKERRQ(ierr);
+    ierr = PetscSFGetGraph(sf, &nroots, &nleaves, &leaves, &remotes);CHKERRQ(ierr);
+    if (nroots >= 0) {
+      ierr = DMPlexGetChart(dm, &pStart, &pEnd);CHKERRQ(ierr);
+      ierr = PetscMalloc1(pEnd-pStart, &rperm);CHKERRQ(ierr);
+      ierr = PetscMalloc3(nleaves,&newLeaves,nleaves,&newRemotes,nleaves,&work);CHKERRQ(ierr);
+      ierr = ISGetIndices(perm, &pperm);CHKERRQ(ierr);
+      ierr = PetscSFBcastBegin(sf, MPIU_INT, pperm, rperm, MPI_REPLACE);CHKERRQ(ierr);
+      ierr = PetscSFBcastEnd(sf, MPIU_INT, pperm, rperm, MPI_REPLACE);CHKERRQ(ierr);
+      for (l = 0; l < nleaves; ++l) {
+        const PetscInt leaf = leaves ? leaves[l] : l;
+
+        newLeaves[l]        = pperm[leaf];
+        newRemotes[l].rank  = remotes[l].rank;
+        newRemotes[l].index = rperm[leaf];
+      }
+      ierr = ISRestoreIndices(perm, &pperm);CHKERRQ(ierr);
+      ierr = PetscFree(rperm);CHKERRQ(ierr);
+      /* Plex looks up leaves with PetscFindInt(), so keep them sorted */
+      ierr = PetscSortIntWithDataArray(nleaves, newLeaves, newRemotes, sizeof(PetscSFNode), work);CHKERRQ(ierr);
+      ierr = PetscSFCreate(PetscObjectComm((PetscObject) dm), &sfNew);CHKERRQ(ierr);
+      ierr = PetscSFSetGraph(sfNew, nroots, nleaves, newLeaves, PETSC_COPY_VALUES, newRemotes, PETSC_COPY_VALUES);CHKERRQ(ierr);
+      ierr = PetscFree3(newLeaves,newRemotes,work);CHKERRQ(ierr);
+      ierr = DMSetPointSF(*pdm, sfNew);CHKERRQ(ierr);
+      ierr = DMGetCoordinateDM(*pdm, &cdmNew);CHKERRQ(ierr);
+      ierr = DMSetPointSF(cdmNew, sfNew);CHKERRQ(ierr);
+      ierr = PetscSFDestroy(&sfNew);CHKERRQ(ierr);
+    }
+  }
+  /* Reorder the tree of a non-conforming mesh, after the point SF which DMPlexSetTree() uses to exchange supports */
+  {
+    DM              refTree;
+    PetscSection    parentSection, parentSectionNew;
+    PetscInt       *parents, *childIDs, *parentsNew, *childIDsNew, pStart, pEnd, p, n;
+    const PetscInt *pperm;
+
+    ierr = DMPlexGetReferenceTree(dm, &refTree);CHKERRQ(ierr);
+    ierr = DMPlexSetReferenceTree(*pdm, refTree);CHKERRQ(ierr);
+    ierr = DMPlexGetTree(dm, &parentSection, &parents, &childIDs, NULL, NULL);CHKERRQ(ierr);
+    if (parentSection) {
+      /* The chart of the parent section may not cover the permuted points, so build it on the chart of the mesh */
+      ierr = ISGetIndices(perm, &pperm);CHKERRQ(ierr);
+      ierr = PetscSectionCreate(PetscObjectComm((PetscObject) parentSection), &parentSectionNew);CHKERRQ(ierr);
+      ierr = DMPlexGetChart(dm, &pStart, &pEnd);CHKERRQ(ierr);
+      ierr = PetscSectionSetChart(parentSectionNew, pStart, pEnd);CHKERRQ(ierr);
+      ierr = PetscSectionGetChart(parentSection, &pStart, &pEnd);CHKERRQ(ierr);
+      for (p = pStart; p < pEnd; ++p) {
+        PetscInt dof;
+
+        ierr = PetscSectionGetDof(parentSection, p, &dof);CHKERRQ(ierr);
+        ierr = PetscSectionSetDof(parentSectionNew, pperm[p], dof);CHKERRQ(ierr);
+      }
+      ierr = PetscSectionSetUp(parentSectionNew);CHKERRQ(ierr);
+      ierr = PetscSectionGetStorageSize(parentSectionNew, &n);CHKERRQ(ierr);
+      ierr = PetscMalloc2(n, &parentsNew, n, &childIDsNew);CHKERRQ(ierr);
+      for (p = pStart; p < pEnd; ++p) {
+        PetscInt dof, off, offNew;
+
+        ierr = PetscSectionGetDof(parentSection, p, &dof);CHKERRQ(ierr);
+        if (!dof) continue;
+        ierr = PetscSectionGetOffset(parentSection, p, &off);CHKERRQ(ierr);
+        ierr = PetscSectionGetOffset(parentSectionNew, pperm[p], &offNew);CHKERRQ(ierr);
+        /* The child IDs are points of the reference tree, which is not permuted */
+        parentsNew[offNew]  = pperm[parents[off]];
+        childIDsNew[offNew] = childIDs[off];
+      }
+      ierr = ISRestoreIndices(perm, &pperm);CHKERRQ(ierr);
+      ierr = DMPlexSetTree(*pdm, parentSectionNew, parentsNew, childIDsNew);CHKERRQ(ierr);
+      ierr = PetscSectionDestroy(&parentSectionNew);CHKERRQ(ierr);
+      ierr = PetscFree2(parentsNew, childIDsNew);CHKERRQ(ierr);
+    }
+    plexNew->useAnchors = plex->useAnchors;
+  }
   (*pdm)->setupcalled = PETSC_TRUE;
   PetscFunctionReturn(0);
 }
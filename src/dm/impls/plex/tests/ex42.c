@@ -0,0 +1,152 @@
+static const char help[] = "Tests the closure operations with the cached closure dof indices.\n\n";
+
+/*
+  Gets the closures of a random local vector, sets values on the closures of a vector in all insert modes and assembles
+  element matrices, first with the closures traversed and then with DMPlexCreateClosureDofIndex(), and checks that the
+  results agree. The first field has an essential boundary condition on the boundary, so the section has constraints.
+*/
+#include <petscdmplex.h>
+#include <petscds.h>
+
+static PetscErrorCode zero(PetscInt dim, PetscReal time, const PetscReal x[], PetscInt Nc, PetscScalar *u, void *ctx)
+{
+  PetscInt c;
+  for (c = 0; c < Nc; ++c) u[c] = 0.0;
+  return 0;
+}
+
+/* Puts the closure values of all cells in vals, the sums of the set closures in F and the element matrices in A */
+static PetscErrorCode ApplyClosures(DM dm, Vec X, PetscScalar vals[], Vec F, Mat A)
+{
+  const InsertMode modes[] = {INSERT_ALL_VALUES, ADD_VALUES, ADD_ALL_VALUES, INSERT_BC_VALUES, ADD_BC_VALUES, INSERT_VALUES};
+  PetscScalar     *elemMat;
+  PetscInt         cStart, cEnd, c, m, i, j, off = 0, maxSize = 0;
+  PetscErrorCode   ierr;
+
+  PetscFunctionBeginUser;
+  ierr = DMPlexGetHeightStratum(dm, 0, &cStart, &cEnd);CHKERRQ(ierr);
+  for (c = cStart; c < cEnd; ++c) {
+    PetscInt csize;
+
+    ierr = DMPlexVecGetClosure(dm, NULL, X, c, &csize, NULL);CHKERRQ(ierr);
+    maxSize = PetscMax(maxSize, csize);
+  }
+  ierr = PetscMalloc1(maxSize*maxSize, &elemMat);CHKERRQ(ierr);
+  ierr = VecZeroEntries(F);CHKERRQ(ierr);
+  for (c = cStart; c < cEnd; ++c) {
+    PetscScalar *x = NULL;
+    PetscInt     csize;
+
+    ierr = DMPlexVecGetClosure(dm, NULL, X, c, &csize, &x);CHKERRQ(ierr);
+    for (i = 0; i < csize; ++i) vals[off+i] = x[i];
+    for (m = 0; m < (PetscInt) (sizeof(modes)/sizeof(modes[0])); ++m) {
+      ierr = DMPlexVecSetClosure(dm, NULL, F, c, x, modes[m]);CHKERRQ(ierr);
+    }
+    for (i = 0; i < csize; ++i) for (j = 0; j < csize; ++j) elemMat[i*csize+j] = x[i]*(j+1);
+    ierr = DMPlexMatSetClosure(dm, NULL, NULL, A, c, elemMat, ADD_VALUES);CHKERRQ(ierr);
+    ierr = DMPlexVecRestoreClosure(dm, NULL, X, c, &csize, &x);CHKERRQ(ierr);
+    off += csize;
+  }
+  ierr = MatAssemblyBegin(A, MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(A, MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = PetscFree(elemMat);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+int main(int argc, char **argv)
+{
+  DM             dm;
+  PetscSection   gsection;
+  PetscFE        fe;
+  DMLabel        label;
+  Vec            X, F[2];
+  Mat            A[2];
+  PetscScalar   *vals[2];
+  PetscInt       dim, Nc = 1, Nf = 1, f, id = 1, cStart, cEnd, c, size = 0, i;
+  PetscReal      diffV = 0.0, diffF, diffA, norm;
+  PetscBool      simplex = PETSC_TRUE;
+  PetscRandom    rand;
+  PetscErrorCode ierr;
+
+  ierr = PetscInitialize(&argc, &argv, NULL, help);if (ierr) return ierr;
+  ierr = PetscOptionsBegin(PETSC_COMM_WORLD, "", "Closure Dof Index Options", "DMPLEX");CHKERRQ(ierr);
+  ierr = PetscOptionsBool("-simplex", "Use simplices", "ex42.c", simplex, &simplex, NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsInt("-num_comp", "The number of components of the fields", "ex42.c", Nc, &Nc, NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsInt("-num_fields", "The number of fields", "ex42.c", Nf, &Nf, NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsEnd();CHKERRQ(ierr);
+  ierr = DMPlexCreateBoxMesh(PETSC_COMM_WORLD, 2, simplex, NULL, NULL, NULL, NULL, PETSC_TRUE, &dm);CHKERRQ(ierr);
+  ierr = DMSetFromOptions(dm);CHKERRQ(ierr);
+  ierr = DMViewFromOptions(dm, NULL, "-dm_view");CHKERRQ(ierr);
+  ierr = DMGetDimension(dm, &dim);CHKERRQ(ierr);
+  for (f = 0; f < Nf; ++f) {
+    ierr = PetscFECreateDefault(PETSC_COMM_WORLD, dim, Nc, simplex, NULL, PETSC_DETERMINE, &fe);CHKERRQ(ierr);
+    ierr = DMSetField(dm, f, NULL, (PetscObject) fe);CHKERRQ(ierr);
+    ierr = PetscFEDestroy(&fe);CHKERRQ(ierr);
+  }
+  ierr = DMCreateDS(dm);CHKERRQ(ierr);
+  ierr = DMGetLabel(dm, "marker", &label);CHKERRQ(ierr);
+  ierr = DMAddBoundary(dm, DM_BC_ESSENTIAL, "wall", label, 1, &id, 0, 0, NULL, (void (*)(void)) zero, NULL, NULL, NULL);CHKERRQ(ierr);
+
+  ierr = DMCreateLocalVector(dm, &X);CHKERRQ(ierr);
+  ierr = DMPlexGetHeightStratum(dm, 0, &cStart, &cEnd);CHKERRQ(ierr);
+  for (c = cStart; c < cEnd; ++c) {
+    PetscInt csize;
+
+    ierr = DMPlexVecGetClosure(dm, NULL, X, c, &csize, NULL);CHKERRQ(ierr);
+    size += csize;
+  }
+  ierr = PetscRandomCreate(PETSC_COMM_SELF, &rand);CHKERRQ(ierr);
+  ierr = VecSetRandom(X, rand);CHKERRQ(ierr);
+  ierr = PetscRandomDestroy(&rand);CHKERRQ(ierr);
+  for (i = 0; i < 2; ++i) {
+    ierr = PetscMalloc1(size, &vals[i]);CHKERRQ(ierr);
+    ierr = VecDuplicate(X, &F[i]);CHKERRQ(ierr);
+    ierr = DMCreateMatrix(dm, &A[i]);CHKERRQ(ierr);
+    if (i) {
+      ierr = DMPlexCreateClosureDofIndex(dm, NULL, NULL);CHKERRQ(ierr);
+      ierr = DMGetGlobalSection(dm, &gsection);CHKERRQ(ierr);
+      ierr = DMPlexCreateClosureDofIndex(dm, NULL, gsection);CHKERRQ(ierr);
+    }
+    ierr = ApplyClosures(dm, X, vals[i], F[i], A[i]);CHKERRQ(ierr);
+  }
+
+  for (i = 0; i < size; ++i) diffV = PetscMax(diffV, PetscAbsScalar(vals[1][i] - vals[0][i]));
+  ierr = VecAXPY(F[1], -1.0, F[0]);CHKERRQ(ierr);
+  ierr = VecNorm(F[1], NORM_INFINITY, &diffF);CHKERRQ(ierr);
+  ierr = MatNorm(A[0], NORM_FROBENIUS, &norm);CHKERRQ(ierr);
+  ierr = MatAXPY(A[1], -1.0, A[0], SAME_NONZERO_PATTERN);CHKERRQ(ierr);
+  ierr = MatNorm(A[1], NORM_FROBENIUS, &diffA);CHKERRQ(ierr);
+  ierr = PetscPrintf(PETSC_COMM_SELF, "Closure values %s\n", diffV == 0.0 ? "agree" : "differ");CHKERRQ(ierr);
+  ierr = PetscPrintf(PETSC_COMM_SELF, "Set closures %s\n", diffF == 0.0 ? "agree" : "differ");CHKERRQ(ierr);
+  ierr = PetscPrintf(PETSC_COMM_WORLD, "Assembled matrices %s\n", diffA <= 1.e-12*norm ? "agree" : "differ");CHKERRQ(ierr);
+
+  for (i = 0; i < 2; ++i) {
+    ierr = PetscFree(vals[i]);CHKERRQ(ierr);
+    ierr = VecDestroy(&F[i]);CHKERRQ(ierr);
+    ierr = MatDestroy(&A[i]);CHKERRQ(ierr);
+  }
+  ierr = VecDestroy(&X);CHKERRQ(ierr);
+  ierr = DMDestroy(&dm);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+  # The simplices are made from the hexahedra so that no mesh generator is needed
+  test:
+    suffix: p2_tri
+    args: -dm_plex_box_simplex 0 -dm_plex_cell_refiner tosimplex -dm_refine 1 -petscspace_degree 2
+
+  test:
+    suffix: p3_tet
+    nsize: 2
+    args: -dm_plex_box_dim 3 -dm_plex_box_faces 2,2,2 -dm_plex_box_simplex 0 -dm_plex_cell_refiner tosimplex -dm_refine 1 -dm_distribute -petscpartitioner_type simple -petscspace_degree 3 -num_comp 2 -num_fields 2
+    filter: sort -b
+    filter_output: sort -b
+
+  test:
+    suffix: q3_quad
+    args: -simplex 0 -dm_plex_box_faces 3,3 -petscspace_degree 3 -num_fields 2
+
+TEST*/
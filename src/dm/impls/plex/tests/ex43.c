@@ -0,0 +1,238 @@
+static char help[] = "Save a distributed mesh and field to an HDF5 checkpoint and restart on a different number of ranks\n\n";
+
+#include <petscdmplex.h>
+#include <petscviewerhdf5.h>
+#include <petscds.h>
+#include <petscfe.h>
+
+typedef struct {
+  PetscInt  dim;                          /* The topological mesh dimension */
+  PetscInt  faces;                        /* The number of faces in each direction */
+  PetscBool embedded;                     /* Mesh the unit sphere, a surface embedded in 3D, instead of a box */
+  PetscInt  writeSize;                    /* The number of ranks saving the checkpoint */
+  PetscInt  readSize;                     /* The number of ranks restarting from the checkpoint */
+  PetscBool check;                        /* Print the norms of the restarted solution and of its error */
+  char      filename[PETSC_MAX_PATH_LEN]; /* The checkpoint filename */
+} AppCtx;
+
+static PetscErrorCode ProcessOptions(MPI_Comm comm, AppCtx *options)
+{
+  PetscMPIInt    size;
+  PetscErrorCode ierr;
+
+  PetscFunctionBeginUser;
+  ierr = MPI_Comm_size(comm, &size);CHKERRMPI(ierr);
+  options->dim       = 2;
+  options->faces     = 4;
+  options->embedded  = PETSC_FALSE;
+  options->writeSize = size;
+  options->readSize  = size;
+  options->check     = PETSC_FALSE;
+  ierr = PetscStrcpy(options->filename, "ex43.h5");CHKERRQ(ierr);
+
+  ierr = PetscOptionsBegin(comm, "", "Checkpoint Restart Options", "DMPLEX");CHKERRQ(ierr);
+  ierr = PetscOptionsRangeInt("-dim", "The topological mesh dimension", "ex43.c", options->dim, &options->dim, NULL, 1, 3);CHKERRQ(ierr);
+  ierr = PetscOptionsBoundedInt("-faces", "The number of faces in each direction", "ex43.c", options->faces, &options->faces, NULL, 1);CHKERRQ(ierr);
+  ierr = PetscOptionsBool("-embedded", "Mesh the unit sphere, a surface embedded in 3D, instead of a box", "ex43.c", options->embedded, &options->embedded, NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsRangeInt("-write_size", "The number of ranks saving the checkpoint", "ex43.c", options->writeSize, &options->writeSize, NULL, 1, size);CHKERRQ(ierr);
+  ierr = PetscOptionsRangeInt("-read_size", "The number of ranks restarting from the checkpoint", "ex43.c", options->readSize, &options->readSize, NULL, 1, size);CHKERRQ(ierr);
+  ierr = PetscOptionsBool("-check", "Print the norms of the restarted solution and of its error", "ex43.c", options->check, &options->check, NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsString("-filename", "The checkpoint filename", "ex43.c", options->filename, options->filename, sizeof(options->filename), NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsEnd();
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode linear(PetscInt dim, PetscReal time, const PetscReal x[], PetscInt Nc, PetscScalar *u, void *ctx)
+{
+  PetscInt d;
+
+  u[0] = 1.0;
+  for (d = 0; d < dim; ++d) u[0] += (d+1)*x[d];
+  return 0;
+}
+
+static PetscErrorCode SetupDiscretization(DM dm)
+{
+  PetscFE        fe;
+  PetscInt       dim;
+  PetscErrorCode ierr;
+
+  PetscFunctionBeginUser;
+  ierr = DMGetDimension(dm, &dim);CHKERRQ(ierr);
+  ierr = PetscFECreateDefault(PetscObjectComm((PetscObject) dm), dim, 1, PETSC_FALSE, NULL, PETSC_DETERMINE, &fe);CHKERRQ(ierr);
+  ierr = PetscObjectSetName((PetscObject) fe, "u");CHKERRQ(ierr);
+  ierr = DMSetField(dm, 0, NULL, (PetscObject) fe);CHKERRQ(ierr);
+  ierr = DMCreateDS(dm);CHKERRQ(ierr);
+  ierr = PetscFEDestroy(&fe);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode WriteCheckpoint(MPI_Comm comm, AppCtx *user)
+{
+  PetscErrorCode (*funcs[1])(PetscInt, PetscReal, const PetscReal[], PetscInt, PetscScalar *, void *) = {linear};
+  DM               dm, dmDist;
+  PetscPartitioner part;
+  PetscViewer      viewer;
+  Vec              u;
+  PetscInt         faces[3];
+  PetscErrorCode   ierr;
+
+  PetscFunctionBeginUser;
+  faces[0] = faces[1] = faces[2] = user->faces;
+  if (user->embedded) {
+    DM rdm;
+
+    ierr = DMPlexCreateSphereMesh(comm, 2, PETSC_FALSE, 1.0, &dm);CHKERRQ(ierr);
+    ierr = DMRefine(dm, comm, &rdm);CHKERRQ(ierr);
+    ierr = DMDestroy(&dm);CHKERRQ(ierr);
+    dm   = rdm;
+  } else {
+    ierr = DMPlexCreateBoxMesh(comm, user->dim, PETSC_FALSE, faces, NULL, NULL, NULL, PETSC_TRUE, &dm);CHKERRQ(ierr);
+  }
+  ierr = DMPlexGetPartitioner(dm, &part);CHKERRQ(ierr);
+  ierr = PetscPartitionerSetFromOptions(part);CHKERRQ(ierr);
+  ierr = DMPlexDistribute(dm, 0, NULL, &dmDist);CHKERRQ(ierr);
+  if (dmDist) {
+    ierr = DMDestroy(&dm);CHKERRQ(ierr);
+    dm   = dmDist;
+  }
+  ierr = SetupDiscretization(dm);CHKERRQ(ierr);
+  ierr = DMCreateGlobalVector(dm, &u);CHKERRQ(ierr);
+  ierr = PetscObjectSetName((PetscObject) u, "u");CHKERRQ(ierr);
+  ierr = DMProjectFunction(dm, 0.0, funcs, NULL, INSERT_ALL_VALUES, u);CHKERRQ(ierr);
+  ierr = PetscViewerHDF5Open(comm, user->filename, FILE_MODE_WRITE, &viewer);CHKERRQ(ierr);
+  ierr = DMPlexCheckpointView(dm, viewer);CHKERRQ(ierr);
+  ierr = DMPlexCheckpointVecView(dm, u, viewer);CHKERRQ(ierr);
+  ierr = PetscViewerDestroy(&viewer);CHKERRQ(ierr);
+  ierr = VecDestroy(&u);CHKERRQ(ierr);
+  ierr = DMDestroy(&dm);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode Restart(MPI_Comm comm, AppCtx *user)
+{
+  PetscErrorCode (*funcs[1])(PetscInt, PetscReal, const PetscReal[], PetscInt, PetscScalar *, void *) = {linear};
+  DM              dm;
+  PetscViewer     viewer;
+  Vec             u, uExact;
+  IS              globalNumbers;
+  const PetscInt *numbers;
+  PetscInt        counts[2] = {0, 0}, gcounts[2], cdim, n, i;
+  PetscReal       norm, error;
+  PetscErrorCode  ierr;
+
+  PetscFunctionBeginUser;
+  ierr = PetscViewerHDF5Open(comm, user->filename, FILE_MODE_READ, &viewer);CHKERRQ(ierr);
+  ierr = DMPlexCreateFromCheckpoint(comm, viewer, &dm);CHKERRQ(ierr);
+  ierr = SetupDiscretization(dm);CHKERRQ(ierr);
+  ierr = DMCreateGlobalVector(dm, &u);CHKERRQ(ierr);
+  ierr = PetscObjectSetName((PetscObject) u, "u");CHKERRQ(ierr);
+  ierr = DMPlexCheckpointVecLoad(dm, u, viewer);CHKERRQ(ierr);
+  ierr = PetscViewerDestroy(&viewer);CHKERRQ(ierr);
+  ierr = DMViewFromOptions(dm, NULL, "-dm_view");CHKERRQ(ierr);
+  ierr = DMGetCoordinateDim(dm, &cdim);CHKERRQ(ierr);
+  if (cdim != (user->embedded ? 3 : user->dim)) {ierr = PetscPrintf(comm, "Error: restarted mesh has coordinate dimension %D\n", cdim);CHKERRQ(ierr);}
+  ierr = DMPlexGetCellNumbering(dm, &globalNumbers);CHKERRQ(ierr);
+  ierr = ISGetLocalSize(globalNumbers, &n);CHKERRQ(ierr);
+  ierr = ISGetIndices(globalNumbers, &numbers);CHKERRQ(ierr);
+  for (i = 0; i < n; ++i) if (numbers[i] >= 0) ++counts[0];
+  ierr = ISRestoreIndices(globalNumbers, &numbers);CHKERRQ(ierr);
+  ierr = DMPlexGetVertexNumbering(dm, &globalNumbers);CHKERRQ(ierr);
+  ierr = ISGetLocalSize(globalNumbers, &n);CHKERRQ(ierr);
+  ierr = ISGetIndices(globalNumbers, &numbers);CHKERRQ(ierr);
+  for (i = 0; i < n; ++i) if (numbers[i] >= 0) ++counts[1];
+  ierr = ISRestoreIndices(globalNumbers, &numbers);CHKERRQ(ierr);
+  ierr = MPIU_Allreduce(counts, gcounts, 2, MPIU_INT, MPI_SUM, comm);CHKERRMPI(ierr);
+  ierr = PetscPrintf(comm, "Restarted mesh has %D cells and %D vertices\n", gcounts[0], gcounts[1]);CHKERRQ(ierr);
+  ierr = VecDuplicate(u, &uExact);CHKERRQ(ierr);
+  ierr = DMProjectFunction(dm, 0.0, funcs, NULL, INSERT_ALL_VALUES, uExact);CHKERRQ(ierr);
+  ierr = VecNorm(u, NORM_INFINITY, &norm);CHKERRQ(ierr);
+  ierr = VecAXPY(uExact, -1.0, u);CHKERRQ(ierr);
+  ierr = VecNorm(uExact, NORM_INFINITY, &error);CHKERRQ(ierr);
+  if (user->check) {ierr = PetscPrintf(comm, "Restarted solution norm %g, error %g\n", (double) norm, (double) error);CHKERRQ(ierr);}
+  if (error > PETSC_SMALL) {ierr = PetscPrintf(comm, "Error: restarted solution differs by %g\n", (double) error);CHKERRQ(ierr);}
+  ierr = VecDestroy(&uExact);CHKERRQ(ierr);
+  ierr = VecDestroy(&u);CHKERRQ(ierr);
+  ierr = DMDestroy(&dm);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+int main(int argc, char **argv)
+{
+  AppCtx         user;
+  MPI_Comm       comm;
+  PetscMPIInt    rank;
+  PetscErrorCode ierr;
+
+  ierr = PetscInitialize(&argc, &argv, NULL, help);if (ierr) return ierr;
+  ierr = ProcessOptions(PETSC_COMM_WORLD, &user);CHKERRQ(ierr);
+  ierr = MPI_Comm_rank(PETSC_COMM_WORLD, &rank);CHKERRMPI(ierr);
+  ierr = MPI_Comm_split(PETSC_COMM_WORLD, rank < user.writeSize ? 0 : MPI_UNDEFINED, rank, &comm);CHKERRMPI(ierr);
+  if (comm != MPI_COMM_NULL) {
+    ierr = WriteCheckpoint(comm, &user);CHKERRQ(ierr);
+    ierr = MPI_Comm_free(&comm);CHKERRMPI(ierr);
+  }
+  ierr = MPI_Barrier(PETSC_COMM_WORLD);CHKERRMPI(ierr);
+  ierr = MPI_Comm_split(PETSC_COMM_WORLD, rank < user.readSize ? 0 : MPI_UNDEFINED, rank, &comm);CHKERRMPI(ierr);
+  if (comm != MPI_COMM_NULL) {
+    ierr = Restart(comm, &user);CHKERRQ(ierr);
+    ierr = MPI_Comm_free(&comm);CHKERRMPI(ierr);
+  }
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+  build:
+    requires: hdf5
+
+  # A checkpoint saved by one rank, which every HDF5 build can restart in parallel
+  testset:
+    args: -petscpartitioner_type simple -petscspace_degree 2 -write_size 1 -check
+    test:
+      suffix: 0
+    test:
+      suffix: read_2
+      nsize: 2
+    test:
+      suffix: read_3
+      nsize: 3
+    test:
+      suffix: read_4
+      nsize: 4
+    test:
+      suffix: read_3_3d
+      nsize: 3
+      args: -dim 3 -faces 3
+    test:
+      suffix: read_2_embedded
+      nsize: 2
+      args: -embedded
+
+  # Saving a distributed checkpoint needs HDF5 with MPI-IO
+  testset:
+    requires: define(PETSC_HDF5_HAVE_PARALLEL)
+    args: -petscpartitioner_type simple -petscspace_degree 2 -check
+    test:
+      suffix: same
+      nsize: 2
+    test:
+      suffix: shrink
+      nsize: 4
+      args: -write_size 4 -read_size 2
+    test:
+      suffix: shrink_uneven
+      nsize: 4
+      args: -write_size 4 -read_size 3
+      output_file: output/ex43_shrink.out
+    test:
+      suffix: grow
+      nsize: 4
+      args: -write_size 2 -read_size 4
+    test:
+      suffix: grow_3d
+      nsize: 3
+      args: -dim 3 -faces 3 -write_size 2 -read_size 3
+
+TEST*/
@@ -69,6 +69,7 @@
       external KSPGMRESMONITORKRYLOV
       external KSPGMRESCLASSICALGRAMSCHMIDTORTHOGONALIZATION
       external KSPGMRESMODIFIEDGRAMSCHMIDTORTHOGONALIZATION
+      external KSPGMRESLOWSYNCGRAMSCHMIDTORTHOGONALIZATION
 !
 !   Possible arguments to KSPGMRESSetRefinementType()
 !
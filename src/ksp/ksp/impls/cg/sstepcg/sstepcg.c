@@ -0,0 +1,689 @@
+#include <petsc/private/kspimpl.h>
+
+/*
+   The s-step (communication-avoiding) conjugate gradient method.
+
+   Each outer iteration builds the bases P = [rho_0(K)p,...,rho_s(K)p] and R = [rho_0(K)z,...,rho_{s-1}(K)z] of the
+   preconditioned operator K = B A, where the polynomials rho_j satisfy the three-term recurrence
+
+      K rho_j = gam_j rho_{j+1} + th_j rho_j + sig_j rho_{j-1}
+
+   All the inner products of the next s CG iterations are then obtained from the Gram matrix of Y = [P,R], which is
+   computed with a single global reduction. The s CG iterations are carried out on the coefficients of the vectors in
+   the basis Y and the vectors are only reconstructed at the end of the outer iteration.
+*/
+
+typedef struct {
+  PetscInt            s;            /* number of CG iterations per outer iteration */
+  KSPSStepCGBasisType basis;
+  PetscReal           emin,emax;    /* bounds of the spectrum of K used by the Newton and Chebyshev bases */
+  PetscBool           eigset;       /* emin and emax were provided by the user */
+  Vec                 *Y;           /* the 2s+1 preconditioned basis vectors */
+  Vec                 *W;           /* W = inv(B) Y, the unpreconditioned basis vectors */
+  PetscScalar         *G;           /* Gram matrix Y^H inv(B) Y */
+  PetscScalar         *Gn;          /* Gram matrix of the vectors used for the residual norm */
+  PetscScalar         *xc,*zc,*pc,*kpc; /* coefficients of the vectors in the basis Y */
+  PetscReal           *gam,*th,*sig; /* coefficients of the recurrence of the polynomials */
+  PetscReal           *alpha,*beta; /* CG coefficients of the first outer iteration, used to estimate the spectrum */
+} KSP_SSTEPCG;
+
+static PetscErrorCode KSPSetUp_SSTEPCG(KSP ksp)
+{
+  KSP_SSTEPCG    *sstep = (KSP_SSTEPCG*)ksp->data;
+  PetscInt       s = sstep->s,n = 2*s+1;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  /* get work vectors needed by SSTEPCG: r, z, p and u = inv(B) p */
+  ierr = KSPSetWorkVecs(ksp,4);CHKERRQ(ierr);
+  ierr = VecDuplicateVecs(ksp->work[0],n,&sstep->Y);CHKERRQ(ierr);
+  ierr = VecDuplicateVecs(ksp->work[0],n,&sstep->W);CHKERRQ(ierr);
+  ierr = PetscLogObjectParents(ksp,n,sstep->Y);CHKERRQ(ierr);
+  ierr = PetscLogObjectParents(ksp,n,sstep->W);CHKERRQ(ierr);
+  ierr = PetscMalloc6(n*n,&sstep->G,n*n,&sstep->Gn,n,&sstep->xc,n,&sstep->zc,n,&sstep->pc,n,&sstep->kpc);CHKERRQ(ierr);
+  ierr = PetscMalloc5(s,&sstep->gam,s,&sstep->th,s,&sstep->sig,s,&sstep->alpha,s,&sstep->beta);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode KSPReset_SSTEPCG(KSP ksp)
+{
+  KSP_SSTEPCG    *sstep = (KSP_SSTEPCG*)ksp->data;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (sstep->Y) {
+    ierr = VecDestroyVecs(2*sstep->s+1,&sstep->Y);CHKERRQ(ierr);
+    ierr = VecDestroyVecs(2*sstep->s+1,&sstep->W);CHKERRQ(ierr);
+  }
+  ierr = PetscFree6(sstep->G,sstep->Gn,sstep->xc,sstep->zc,sstep->pc,sstep->kpc);CHKERRQ(ierr);
+  ierr = PetscFree5(sstep->gam,sstep->th,sstep->sig,sstep->alpha,sstep->beta);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* Number of eigenvalues smaller than x of the symmetric tridiagonal matrix with diagonal d and off-diagonal e */
+static PetscInt SturmCount_Private(PetscInt m,const PetscReal *d,const PetscReal *e,PetscReal x)
+{
+  PetscInt  i,count = 0;
+  PetscReal q = 1.0;
+
+  for (i=0; i<m; i++) {
+    q = d[i] - x - (i ? e[i-1]*e[i-1]/q : 0.0);
+    if (q == 0.0) q = -PETSC_MACHINE_EPSILON*(PetscAbsReal(d[i])+PETSC_MACHINE_EPSILON);
+    if (q < 0.0) count++;
+  }
+  return count;
+}
+
+/*
+   Estimates the extreme eigenvalues of K from the Lanczos tridiagonal matrix of the first m CG iterations, computed
+   by bisection of the Sturm sequence
+*/
+static PetscErrorCode KSPSSTEPCGEstimateEigenvalues_Private(KSP ksp,PetscInt m)
+{
+  KSP_SSTEPCG    *sstep = (KSP_SSTEPCG*)ksp->data;
+  PetscReal      *d,*e,lo = PETSC_MAX_REAL,hi = PETSC_MIN_REAL,a,b,c;
+  PetscInt       i,k,l;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscMalloc2(m,&d,m,&e);CHKERRQ(ierr);
+  for (i=0; i<m; i++) {
+    d[i] = 1.0/sstep->alpha[i] + (i ? sstep->beta[i-1]/sstep->alpha[i-1] : 0.0);
+    e[i] = PetscSqrtReal(sstep->beta[i])/sstep->alpha[i];
+  }
+  for (i=0; i<m; i++) { /* Gershgorin bounds */
+    a  = PetscAbsReal(i ? e[i-1] : 0.0) + PetscAbsReal(i < m-1 ? e[i] : 0.0);
+    lo = PetscMin(lo,d[i]-a);
+    hi = PetscMax(hi,d[i]+a);
+  }
+  for (l=0; l<2; l++) {
+    a = lo; b = hi;
+    for (k=0; k<64 && b-a > PETSC_MACHINE_EPSILON*PetscMax(PetscAbsReal(a),PetscAbsReal(b)); k++) {
+      c = 0.5*(a+b);
+      if (SturmCount_Private(m,d,e,c) > (l ? m-1 : 0)) b = c;
+      else a = c;
+    }
+    if (l) sstep->emax = 0.5*(a+b);
+    else   sstep->emin = 0.5*(a+b);
+  }
+  ierr = PetscFree2(d,e);CHKERRQ(ierr);
+  ierr = PetscInfo2(ksp,"Estimated the extreme eigenvalues %g %g\n",(double)sstep->emin,(double)sstep->emax);CHKERRQ(ierr);
+  /* the Ritz values lie inside the spectrum, widen the interval since the basis degrades quickly beyond emax */
+  a           = 0.1*(sstep->emax-sstep->emin);
+  sstep->emin = PetscMax(sstep->emin-a,0.0);
+  sstep->emax = sstep->emax+a;
+  PetscFunctionReturn(0);
+}
+
+/* Sets the coefficients of the three-term recurrence of the basis polynomials */
+static PetscErrorCode KSPSSTEPCGSetRecurrence_Private(KSP ksp,KSPSStepCGBasisType basis)
+{
+  KSP_SSTEPCG *sstep = (KSP_SSTEPCG*)ksp->data;
+  PetscInt    s = sstep->s,i,j,k,next;
+  PetscReal   c = 0.5*(sstep->emax+sstep->emin),h = 0.5*(sstep->emax-sstep->emin),pts[32],t,best;
+
+  PetscFunctionBegin;
+  if (basis != KSP_SSTEPCG_BASIS_MONOMIAL && !(h > PETSC_SMALL*PetscAbsReal(c))) basis = KSP_SSTEPCG_BASIS_MONOMIAL;
+  for (j=0; j<s; j++) {sstep->gam[j] = 1.0; sstep->th[j] = 0.0; sstep->sig[j] = 0.0;}
+  switch (basis) {
+  case KSP_SSTEPCG_BASIS_MONOMIAL:
+    break;
+  case KSP_SSTEPCG_BASIS_NEWTON:
+    /* the shifts are the Chebyshev points of [emin,emax] in Leja order */
+    for (j=0; j<s; j++) pts[j] = c + h*PetscCosReal((2*j+1)*PETSC_PI/(2*s));
+    for (j=0; j<s; j++) {
+      for (best=-1.0,next=j,i=j; i<s; i++) {
+        for (t=j ? 1.0 : PetscAbsReal(pts[i]),k=0; k<j; k++) t *= PetscAbsReal(pts[i]-pts[k]);
+        if (t > best) {best = t; next = i;}
+      }
+      t = pts[j]; pts[j] = pts[next]; pts[next] = t;
+      sstep->th[j] = pts[j];
+    }
+    break;
+  case KSP_SSTEPCG_BASIS_CHEBYSHEV:
+    /* Chebyshev polynomials of the first kind of (K - c)/h */
+    for (j=0; j<s; j++) {
+      sstep->th[j]  = c;
+      sstep->gam[j] = j ? 0.5*h : h;
+      sstep->sig[j] = j ? 0.5*h : 0.0;
+    }
+    break;
+  }
+  PetscFunctionReturn(0);
+}
+
+/* Builds the basis rho_j(K)Y[o], j=0,...,m-1, and its unpreconditioned counterpart from Y[o] and W[o] */
+static PetscErrorCode KSPSSTEPCGBuildBasis_Private(KSP ksp,Mat Amat,PetscInt o,PetscInt m)
+{
+  KSP_SSTEPCG    *sstep = (KSP_SSTEPCG*)ksp->data;
+  Vec            *Y = sstep->Y + o,*W = sstep->W + o;
+  PetscInt       j;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  for (j=0; j<m-1; j++) {
+    ierr = KSP_MatMult(ksp,Amat,Y[j],W[j+1]);CHKERRQ(ierr);
+    if (sstep->th[j] != 0.0) {ierr = VecAXPY(W[j+1],-sstep->th[j],W[j]);CHKERRQ(ierr);}
+    if (sstep->sig[j] != 0.0) {ierr = VecAXPY(W[j+1],-sstep->sig[j],W[j-1]);CHKERRQ(ierr);}
+    if (sstep->gam[j] != 1.0) {ierr = VecScale(W[j+1],1.0/sstep->gam[j]);CHKERRQ(ierr);}
+    ierr = KSP_PCApply(ksp,W[j+1],Y[j+1]);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+/* Computes the coefficients in the basis Y of K times the vector with coefficients a */
+static void KSPSSTEPCGApplyK_Private(KSP_SSTEPCG *sstep,const PetscScalar *a,PetscScalar *b)
+{
+  PetscInt s = sstep->s,n = 2*s+1,o,j,m;
+
+  for (j=0; j<n; j++) b[j] = 0.0;
+  for (o=0,m=s+1; o<n; o+=m,m=s) {
+    for (j=0; j<m-1; j++) {
+      b[o+j+1] += sstep->gam[j]*a[o+j];
+      b[o+j]   += sstep->th[j]*a[o+j];
+      if (j) b[o+j-1] += sstep->sig[j]*a[o+j];
+    }
+  }
+}
+
+/* Computes the inner product (Y b)^H M (Y a) from the Gram matrix G with G[i*n+j] = Y_j^H M Y_i */
+static PetscScalar KSPSSTEPCGDot_Private(PetscInt n,const PetscScalar *G,const PetscScalar *a,const PetscScalar *b)
+{
+  PetscScalar sum = 0.0,t;
+  PetscInt    i,j;
+
+  for (i=0; i<n; i++) {
+    if (a[i] == 0.0) continue;
+    for (t=0.0,j=0; j<n; j++) t += G[i*n+j]*PetscConj(b[j]);
+    sum += a[i]*t;
+  }
+  return sum;
+}
+
+static PetscErrorCode KSPSSTEPCGResidualNorm_Private(KSP ksp,PetscScalar gamma,PetscReal *dp)
+{
+  KSP_SSTEPCG *sstep = (KSP_SSTEPCG*)ksp->data;
+
+  PetscFunctionBegin;
+  switch (ksp->normtype) {
+  case KSP_NORM_PRECONDITIONED:
+  case KSP_NORM_UNPRECONDITIONED:
+    *dp = PetscSqrtReal(PetscMax(PetscRealPart(KSPSSTEPCGDot_Private(2*sstep->s+1,sstep->Gn,sstep->zc,sstep->zc)),0.0));
+    break;
+  case KSP_NORM_NATURAL:
+    *dp = PetscSqrtReal(PetscAbsScalar(gamma));
+    break;
+  case KSP_NORM_NONE:
+    *dp = 0.0;
+    break;
+  default: SETERRQ1(PetscObjectComm((PetscObject)ksp),PETSC_ERR_SUP,"%s",KSPNormTypes[ksp->normtype]);
+  }
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode KSPSolve_SSTEPCG(KSP ksp)
+{
+  KSP_SSTEPCG    *sstep = (KSP_SSTEPCG*)ksp->data;
+  PetscInt       s = sstep->s,n = 2*s+1,i,j,k,nsteps,first = 0;
+  PetscScalar    *G = sstep->G,*Gn = sstep->Gn,*xc = sstep->xc,*zc = sstep->zc,*pc = sstep->pc,*kpc = sstep->kpc;
+  PetscScalar    alpha,beta,gamma = 0.0,gammaNew,dpi;
+  PetscReal      dp = 0.0;
+  Vec            x,b,r,z,p,u,*Y = sstep->Y,*W = sstep->W,*Yn = NULL;
+  Mat            Amat,Pmat;
+  MPI_Comm       comm;
+  PetscBool      diagonalscale,estimate;
+  KSPSStepCGBasisType basis;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PCGetDiagonalScale(ksp->pc,&diagonalscale);CHKERRQ(ierr);
+  if (diagonalscale) SETERRQ1(PetscObjectComm((PetscObject)ksp),PETSC_ERR_SUP,"Krylov method %s does not support diagonal scaling",((PetscObject)ksp)->type_name);
+
+  comm = PetscObjectComm((PetscObject)ksp);
+  x    = ksp->vec_sol;
+  b    = ksp->vec_rhs;
+  r    = ksp->work[0];
+  z    = ksp->work[1];
+  p    = ksp->work[2];
+  u    = ksp->work[3];
+  if (ksp->normtype == KSP_NORM_PRECONDITIONED) Yn = Y;
+  else if (ksp->normtype == KSP_NORM_UNPRECONDITIONED) Yn = W;
+
+  ierr = PCGetOperators(ksp->pc,&Amat,&Pmat);CHKERRQ(ierr);
+
+  /* without eigenvalue estimates the first outer iteration uses the monomial basis and provides them */
+  estimate = (PetscBool)(sstep->basis != KSP_SSTEPCG_BASIS_MONOMIAL && !sstep->eigset);
+  basis    = estimate ? KSP_SSTEPCG_BASIS_MONOMIAL : sstep->basis;
+  ierr     = KSPSSTEPCGSetRecurrence_Private(ksp,basis);CHKERRQ(ierr);
+
+  ksp->its = 0;
+  if (!ksp->guess_zero) {
+    ierr = KSP_MatMult(ksp,Amat,x,r);CHKERRQ(ierr);            /*     r <- b - Ax     */
+    ierr = VecAYPX(r,-1.0,b);CHKERRQ(ierr);
+  } else {
+    ierr = VecCopy(b,r);CHKERRQ(ierr);                         /*     r <- b (x is 0) */
+  }
+  ierr = KSP_PCApply(ksp,r,z);CHKERRQ(ierr);                   /*     z <- Br         */
+  ierr = VecCopy(z,p);CHKERRQ(ierr);                           /*     p <- z          */
+  ierr = VecCopy(r,u);CHKERRQ(ierr);                           /*     u <- inv(B) p   */
+
+  do {
+    /* the bases [P,R] = Y and [inv(B)P,inv(B)R] = W */
+    ierr = VecCopy(p,Y[0]);CHKERRQ(ierr);
+    ierr = VecCopy(u,W[0]);CHKERRQ(ierr);
+    ierr = VecCopy(z,Y[s+1]);CHKERRQ(ierr);
+    ierr = VecCopy(r,W[s+1]);CHKERRQ(ierr);
+    ierr = KSPSSTEPCGBuildBasis_Private(ksp,Amat,0,s+1);CHKERRQ(ierr);
+    ierr = KSPSSTEPCGBuildBasis_Private(ksp,Amat,s+1,s);CHKERRQ(ierr);
+
+    /* all the inner products of the next s iterations with a single reduction */
+    for (i=0; i<n; i++) {ierr = VecMDotBegin(W[i],n-i,Y+i,G+i*n+i);CHKERRQ(ierr);}
+    if (Yn) for (i=0; i<n; i++) {ierr = VecMDotBegin(Yn[i],n-i,Yn+i,Gn+i*n+i);CHKERRQ(ierr);}
+    ierr = PetscCommSplitReductionBegin(comm);CHKERRQ(ierr);
+    for (i=0; i<n; i++) {ierr = VecMDotEnd(W[i],n-i,Y+i,G+i*n+i);CHKERRQ(ierr);}
+    if (Yn) for (i=0; i<n; i++) {ierr = VecMDotEnd(Yn[i],n-i,Yn+i,Gn+i*n+i);CHKERRQ(ierr);}
+    for (i=0; i<n; i++) {
+      for (j=i+1; j<n; j++) {
+        G[j*n+i] = PetscConj(G[i*n+j]);
+        if (Yn) Gn[j*n+i] = PetscConj(Gn[i*n+j]);
+      }
+    }
+
+    /* the coefficients of x (update), z and p in the basis Y */
+    ierr = PetscArrayzero(xc,n);CHKERRQ(ierr);
+    ierr = PetscArrayzero(zc,n);CHKERRQ(ierr);
+    ierr = PetscArrayzero(pc,n);CHKERRQ(ierr);
+    zc[s+1] = 1.0;
+    pc[0]   = 1.0;
+    gamma   = KSPSSTEPCGDot_Private(n,G,zc,zc);                /*     gamma <- r'*z   */
+    if (!ksp->its) {
+      ierr       = KSPSSTEPCGResidualNorm_Private(ksp,gamma,&dp);CHKERRQ(ierr);
+      ierr       = KSPLogResidualHistory(ksp,dp);CHKERRQ(ierr);
+      ierr       = KSPMonitor(ksp,0,dp);CHKERRQ(ierr);
+      ksp->rnorm = dp;
+      ierr       = (*ksp->converged)(ksp,0,dp,&ksp->reason,ksp->cnvP);CHKERRQ(ierr); /* test for convergence */
+      if (ksp->reason) PetscFunctionReturn(0);
+    }
+
+    /* the monomial basis of the estimation is only accurate for a few steps */
+    nsteps = estimate ? PetscMin(s,8) : s;
+    for (k=0; k<nsteps && ksp->its<ksp->max_it; k++) {
+      if (gamma == 0.0) {
+        ksp->reason = KSP_CONVERGED_ATOL;
+        ierr        = PetscInfo(ksp,"converged due to gamma = 0\n");CHKERRQ(ierr);
+        break;
+      }
+      KSPSSTEPCGApplyK_Private(sstep,pc,kpc);
+      dpi = KSPSSTEPCGDot_Private(n,G,pc,kpc);                 /*     dpi <- p'*A*p   */
+      if (PetscRealPart(dpi) <= 0.0) {
+        if (ksp->errorifnotconverged) SETERRQ1(comm,PETSC_ERR_NOT_CONVERGED,"Diverged due to indefinite matrix, dpi %g",(double)PetscRealPart(dpi));
+        ksp->reason = KSP_DIVERGED_INDEFINITE_MAT;
+        ierr        = PetscInfo(ksp,"diverging due to indefinite or negative definite matrix\n");CHKERRQ(ierr);
+        break;
+      }
+      alpha = gamma/dpi;
+      for (j=0; j<n; j++) {
+        xc[j] += alpha*pc[j];                                  /*     x <- x + alpha*p   */
+        zc[j] -= alpha*kpc[j];                                 /*     z <- z - alpha*K*p */
+      }
+      gammaNew = KSPSSTEPCGDot_Private(n,G,zc,zc);
+      beta     = gammaNew/gamma;
+      for (j=0; j<n; j++) pc[j] = zc[j] + beta*pc[j];         /*     p <- z + beta*p    */
+      if (estimate && first < s) {
+        sstep->alpha[first] = PetscRealPart(alpha);
+        sstep->beta[first]  = PetscRealPart(beta);
+        first++;
+      }
+      gamma = gammaNew;
+
+      ksp->its++;
+      ierr       = KSPSSTEPCGResidualNorm_Private(ksp,gamma,&dp);CHKERRQ(ierr);
+      ksp->rnorm = dp;
+      ierr       = KSPLogResidualHistory(ksp,dp);CHKERRQ(ierr);
+      ierr       = KSPMonitor(ksp,ksp->its,dp);CHKERRQ(ierr);
+      ierr       = (*ksp->converged)(ksp,ksp->its,dp,&ksp->reason,ksp->cnvP);CHKERRQ(ierr);
+      if (ksp->reason) break;
+    }
+
+    /* back from the coefficients to the vectors */
+    ierr = VecMAXPY(x,n,xc,Y);CHKERRQ(ierr);
+    if (ksp->reason) break;
+    ierr = VecSet(z,0.0);CHKERRQ(ierr);
+    ierr = VecMAXPY(z,n,zc,Y);CHKERRQ(ierr);
+    ierr = VecSet(r,0.0);CHKERRQ(ierr);
+    ierr = VecMAXPY(r,n,zc,W);CHKERRQ(ierr);
+    ierr = VecSet(p,0.0);CHKERRQ(ierr);
+    ierr = VecMAXPY(p,n,pc,Y);CHKERRQ(ierr);
+    ierr = VecSet(u,0.0);CHKERRQ(ierr);
+    ierr = VecMAXPY(u,n,pc,W);CHKERRQ(ierr);
+
+    if (estimate && first) {
+      ierr     = KSPSSTEPCGEstimateEigenvalues_Private(ksp,first);CHKERRQ(ierr);
+      ierr     = KSPSSTEPCGSetRecurrence_Private(ksp,sstep->basis);CHKERRQ(ierr);
+      estimate = PETSC_FALSE;
+    }
+  } while (ksp->its < ksp->max_it);
+
+  if (ksp->reason) {
+    /* the residual is needed by KSPBuildResidual() */
+    ierr = VecSet(r,0.0);CHKERRQ(ierr);
+    ierr = VecMAXPY(r,n,zc,W);CHKERRQ(ierr);
+  } else ksp->reason = KSP_DIVERGED_ITS;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode KSPDestroy_SSTEPCG(KSP ksp)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = KSPReset_SSTEPCG(ksp);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPSStepCGSetSteps_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPSStepCGGetSteps_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPSStepCGSetBasisType_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPSStepCGGetBasisType_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPSStepCGSetEigenvalues_C",NULL);CHKERRQ(ierr);
+  ierr = KSPDestroyDefault(ksp);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode KSPView_SSTEPCG(KSP ksp,PetscViewer viewer)
+{
+  KSP_SSTEPCG    *sstep = (KSP_SSTEPCG*)ksp->data;
+  PetscBool      iascii;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectTypeCompare((PetscObject)viewer,PETSCVIEWERASCII,&iascii);CHKERRQ(ierr);
+  if (iascii) {
+    ierr = PetscViewerASCIIPrintf(viewer,"  steps per reduction %D, %s basis\n",sstep->s,KSPSStepCGBasisTypes[sstep->basis]);CHKERRQ(ierr);
+    if (sstep->basis != KSP_SSTEPCG_BASIS_MONOMIAL) {
+      ierr = PetscViewerASCIIPrintf(viewer,"  %s eigenvalue bounds %g %g\n",sstep->eigset ? "given" : "estimated",(double)sstep->emin,(double)sstep->emax);CHKERRQ(ierr);
+    }
+  }
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode KSPSetFromOptions_SSTEPCG(PetscOptionItems *PetscOptionsObject,KSP ksp)
+{
+  KSP_SSTEPCG         *sstep = (KSP_SSTEPCG*)ksp->data;
+  PetscInt            s = sstep->s,neig = 2;
+  PetscReal           eminmax[2] = {0.0,0.0};
+  KSPSStepCGBasisType basis = sstep->basis;
+  PetscBool           flg;
+  PetscErrorCode      ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscOptionsHead(PetscOptionsObject,"KSP s-step CG options");CHKERRQ(ierr);
+  ierr = PetscOptionsInt("-ksp_sstep_s","Number of iterations per global reduction","KSPSStepCGSetSteps",s,&s,&flg);CHKERRQ(ierr);
+  if (flg) {ierr = KSPSStepCGSetSteps(ksp,s);CHKERRQ(ierr);}
+  ierr = PetscOptionsEnum("-ksp_sstep_basis","Polynomial basis of the Krylov space","KSPSStepCGSetBasisType",KSPSStepCGBasisTypes,(PetscEnum)basis,(PetscEnum*)&basis,&flg);CHKERRQ(ierr);
+  if (flg) {ierr = KSPSStepCGSetBasisType(ksp,basis);CHKERRQ(ierr);}
+  ierr = PetscOptionsRealArray("-ksp_sstep_eigenvalues","extreme eigenvalues","KSPSStepCGSetEigenvalues",eminmax,&neig,&flg);CHKERRQ(ierr);
+  if (flg) {
+    if (neig != 2) SETERRQ(PetscObjectComm((PetscObject)ksp),PETSC_ERR_ARG_INCOMP,"-ksp_sstep_eigenvalues: must specify 2 parameters, min and max eigenvalues");
+    ierr = KSPSStepCGSetEigenvalues(ksp,eminmax[1],eminmax[0]);CHKERRQ(ierr);
+  }
+  ierr = PetscOptionsTail();CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode KSPSStepCGSetSteps_SSTEPCG(KSP ksp,PetscInt s)
+{
+  KSP_SSTEPCG    *sstep = (KSP_SSTEPCG*)ksp->data;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (s < 1 || s > 32) SETERRQ1(PetscObjectComm((PetscObject)ksp),PETSC_ERR_ARG_OUTOFRANGE,"Number of steps %D must be between 1 and 32",s);
+  if (!ksp->setupstage) {
+    sstep->s = s;
+  } else if (sstep->s != s) {
+    /* free the data structures, then create them again */
+    ierr            = KSPReset_SSTEPCG(ksp);CHKERRQ(ierr);
+    sstep->s        = s;
+    ksp->setupstage = KSP_SETUP_NEW;
+  }
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode KSPSStepCGGetSteps_SSTEPCG(KSP ksp,PetscInt *s)
+{
+  PetscFunctionBegin;
+  *s = ((KSP_SSTEPCG*)ksp->data)->s;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode KSPSStepCGSetBasisType_SSTEPCG(KSP ksp,KSPSStepCGBasisType basis)
+{
+  PetscFunctionBegin;
+  ((KSP_SSTEPCG*)ksp->data)->basis = basis;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode KSPSStepCGGetBasisType_SSTEPCG(KSP ksp,KSPSStepCGBasisType *basis)
+{
+  PetscFunctionBegin;
+  *basis = ((KSP_SSTEPCG*)ksp->data)->basis;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode KSPSStepCGSetEigenvalues_SSTEPCG(KSP ksp,PetscReal emax,PetscReal emin)
+{
+  KSP_SSTEPCG *sstep = (KSP_SSTEPCG*)ksp->data;
+
+  PetscFunctionBegin;
+  if (emax <= emin) SETERRQ2(PetscObjectComm((PetscObject)ksp),PETSC_ERR_ARG_INCOMP,"Maximum eigenvalue must be larger than minimum: max %g min %g",(double)emax,(double)emin);
+  sstep->emax   = emax;
+  sstep->emin   = emin;
+  sstep->eigset = PETSC_TRUE;
+  PetscFunctionReturn(0);
+}
+
+/*@
+   KSPSStepCGSetSteps - Sets the number of CG iterations carried out for each global reduction by KSPSSTEPCG
+
+   Logically Collective on ksp
+
+   Input Parameters:
++  ksp - the Krylov space context
+-  s - the number of iterations per outer iteration, between 1 and 32
+
+   Options Database:
+.  -ksp_sstep_s <s> - number of iterations per global reduction
+
+   Level: intermediate
+
+   Notes:
+   Each outer iteration applies the operator and the preconditioner 2s-1 times. Large values of s make the basis
+   ill-conditioned, in particular with the monomial basis, which slows down the convergence.
+
+.seealso: KSPSSTEPCG, KSPSStepCGGetSteps(), KSPSStepCGSetBasisType()
+@*/
+PetscErrorCode KSPSStepCGSetSteps(KSP ksp,PetscInt s)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(ksp,KSP_CLASSID,1);
+  PetscValidLogicalCollectiveInt(ksp,s,2);
+  ierr = PetscTryMethod(ksp,"KSPSStepCGSetSteps_C",(KSP,PetscInt),(ksp,s));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*@
+   KSPSStepCGGetSteps - Gets the number of CG iterations carried out for each global reduction by KSPSSTEPCG
+
+   Not Collective
+
+   Input Parameter:
+.  ksp - the Krylov space context
+
+   Output Parameter:
+.  s - the number of iterations per outer iteration
+
+   Level: intermediate
+
+.seealso: KSPSSTEPCG, KSPSStepCGSetSteps()
+@*/
+PetscErrorCode KSPSStepCGGetSteps(KSP ksp,PetscInt *s)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(ksp,KSP_CLASSID,1);
+  PetscValidIntPointer(s,2);
+  ierr = PetscUseMethod(ksp,"KSPSStepCGGetSteps_C",(KSP,PetscInt*),(ksp,s));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*@
+   KSPSStepCGSetBasisType - Sets the polynomial basis used by KSPSSTEPCG to generate the Krylov space
+
+   Logically Collective on ksp
+
+   Input Parameters:
++  ksp - the Krylov space context
+-  basis - KSP_SSTEPCG_BASIS_MONOMIAL, KSP_SSTEPCG_BASIS_NEWTON or KSP_SSTEPCG_BASIS_CHEBYSHEV
+
+   Options Database:
+.  -ksp_sstep_basis <monomial,newton,chebyshev> - the polynomial basis
+
+   Level: intermediate
+
+   Notes:
+   The Newton and Chebyshev bases are better conditioned than the monomial basis. They need bounds of the spectrum of
+   the preconditioned operator, which are given by KSPSStepCGSetEigenvalues() or otherwise estimated from the CG
+   coefficients of the first iterations of each solve, which use the monomial basis.
+
+.seealso: KSPSSTEPCG, KSPSStepCGGetBasisType(), KSPSStepCGSetEigenvalues(), KSPSStepCGBasisType
+@*/
+PetscErrorCode KSPSStepCGSetBasisType(KSP ksp,KSPSStepCGBasisType basis)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(ksp,KSP_CLASSID,1);
+  PetscValidLogicalCollectiveEnum(ksp,basis,2);
+  ierr = PetscTryMethod(ksp,"KSPSStepCGSetBasisType_C",(KSP,KSPSStepCGBasisType),(ksp,basis));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*@
+   KSPSStepCGGetBasisType - Gets the polynomial basis used by KSPSSTEPCG to generate the Krylov space
+
+   Not Collective
+
+   Input Parameter:
+.  ksp - the Krylov space context
+
+   Output Parameter:
+.  basis - the polynomial basis
+
+   Level: intermediate
+
+.seealso: KSPSSTEPCG, KSPSStepCGSetBasisType()
+@*/
+PetscErrorCode KSPSStepCGGetBasisType(KSP ksp,KSPSStepCGBasisType *basis)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(ksp,KSP_CLASSID,1);
+  PetscValidPointer(basis,2);
+  ierr = PetscUseMethod(ksp,"KSPSStepCGGetBasisType_C",(KSP,KSPSStepCGBasisType*),(ksp,basis));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*@
+   KSPSStepCGSetEigenvalues - Sets the bounds of the spectrum of the preconditioned operator used by the Newton and
+   Chebyshev bases of KSPSSTEPCG
+
+   Logically Collective on ksp
+
+   Input Parameters:
++  ksp - the Krylov space context
+-  emax, emin - the eigenvalue estimates
+
+   Options Database:
+.  -ksp_sstep_eigenvalues emin,emax
+
+   Level: intermediate
+
+.seealso: KSPSSTEPCG, KSPSStepCGSetBasisType(), KSPChebyshevSetEigenvalues()
+@*/
+PetscErrorCode KSPSStepCGSetEigenvalues(KSP ksp,PetscReal emax,PetscReal emin)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(ksp,KSP_CLASSID,1);
+  PetscValidLogicalCollectiveReal(ksp,emax,2);
+  PetscValidLogicalCollectiveReal(ksp,emin,3);
+  ierr = PetscTryMethod(ksp,"KSPSStepCGSetEigenvalues_C",(KSP,PetscReal,PetscReal),(ksp,emax,emin));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PETSC_INTERN PetscErrorCode KSPBuildResidual_CG(KSP,Vec,Vec,Vec*);
+
+/*MC
+    KSPSSTEPCG - The s-step (communication-avoiding) conjugate gradient method. It carries out s iterations of
+    preconditioned CG with a single global reduction, instead of the 2s reductions of standard CG.
+
+    Options Database Keys:
++   -ksp_sstep_s <s> - number of iterations per global reduction (default: 4)
+.   -ksp_sstep_basis <monomial,newton,chebyshev> - polynomial basis of the Krylov space (default: chebyshev)
+.   -ksp_sstep_eigenvalues emin,emax - bounds of the spectrum of the preconditioned operator for the Newton and
+    Chebyshev bases (default: estimated during the first iterations)
+-   see KSPSolve() for additional options
+
+    Level: advanced
+
+    Notes:
+    Each group of s iterations generates a basis of dimension 2s+1 of the Krylov space with 2s-1 applications of the
+    operator and of the preconditioner, computes its Gram matrix with one reduction, and performs the s CG iterations
+    on the coefficients in that basis. The method thus trades about twice the number of matrix-vector products and
+    extra local vector operations for a factor s fewer global reductions, which pays off when the reductions dominate,
+    typically at large process counts.
+
+    The residual norms used by the convergence test and the monitors are computed from the Gram matrices, so they are
+    available at every iteration. The preconditioner must be symmetric positive definite.
+
+    References:
+.   1. - E. Carson, "Communication-avoiding Krylov subspace methods in theory and practice", PhD thesis,
+    University of California, Berkeley, 2015.
+
+.seealso: KSPCreate(), KSPSetType(), KSPType (for list of available types), KSPCG, KSPPIPECG, KSPPIPELCG, KSPGROPPCG,
+          KSPSStepCGSetSteps(), KSPSStepCGSetBasisType(), KSPSStepCGSetEigenvalues()
+M*/
+PETSC_EXTERN PetscErrorCode KSPCreate_SSTEPCG(KSP ksp)
+{
+  KSP_SSTEPCG    *sstep;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscNewLog(ksp,&sstep);CHKERRQ(ierr);
+  ksp->data    = (void*)sstep;
+  sstep->s     = 4;
+  sstep->basis = KSP_SSTEPCG_BASIS_CHEBYSHEV;
+
+  ierr = KSPSetSupportedNorm(ksp,KSP_NORM_PRECONDITIONED,PC_LEFT,3);CHKERRQ(ierr);
+  ierr = KSPSetSupportedNorm(ksp,KSP_NORM_UNPRECONDITIONED,PC_LEFT,2);CHKERRQ(ierr);
+  ierr = KSPSetSupportedNorm(ksp,KSP_NORM_NATURAL,PC_LEFT,2);CHKERRQ(ierr);
+  ierr = KSPSetSupportedNorm(ksp,KSP_NORM_NONE,PC_LEFT,1);CHKERRQ(ierr);
+
+  ksp->ops->setup          = KSPSetUp_SSTEPCG;
+  ksp->ops->solve          = KSPSolve_SSTEPCG;
+  ksp->ops->reset          = KSPReset_SSTEPCG;
+  ksp->ops->destroy        = KSPDestroy_SSTEPCG;
+  ksp->ops->view           = KSPView_SSTEPCG;
+  ksp->ops->setfromoptions = KSPSetFromOptions_SSTEPCG;
+  ksp->ops->buildsolution  = KSPBuildSolutionDefault;
+  ksp->ops->buildresidual  = KSPBuildResidual_CG;
+
+  ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPSStepCGSetSteps_C",KSPSStepCGSetSteps_SSTEPCG);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPSStepCGGetSteps_C",KSPSStepCGGetSteps_SSTEPCG);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPSStepCGSetBasisType_C",KSPSStepCGSetBasisType_SSTEPCG);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPSStepCGGetBasisType_C",KSPSStepCGGetBasisType_SSTEPCG);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPSStepCGSetEigenvalues_C",KSPSStepCGSetEigenvalues_SSTEPCG);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
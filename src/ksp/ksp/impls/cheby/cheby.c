@@ -10,6 +10,7 @@ static PetscErrorCode KSPReset_Chebyshev(KSP ksp)
   if (cheb->kspest) {
     ierr = KSPReset(cheb->kspest);CHKERRQ(ierr);
   }
+  ierr = VecDestroy(&cheb->vest);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
@@ -38,6 +39,52 @@ static PetscErrorCode KSPChebyshevComputeExtremeEigenvalues_Private(KSP kspest,P
   PetscFunctionReturn(0);
 }
 
+/*
+ * Computes the Rayleigh quotient (v,B^{-1}A v) of the preconditioned operator for a vector v of unit norm, B^{-1}A v is returned in y
+ */
+static PetscErrorCode KSPChebyshevRayleighQuotient_Private(KSP ksp,Mat Amat,Vec v,Vec y,PetscReal *rq)
+{
+  PetscErrorCode ierr;
+  PetscScalar    dot;
+
+  PetscFunctionBegin;
+  ierr = KSP_MatMult(ksp,Amat,v,ksp->work[1]);CHKERRQ(ierr);
+  ierr = KSP_PCApply(ksp,ksp->work[1],y);CHKERRQ(ierr);
+  ierr = VecDot(y,v,&dot);CHKERRQ(ierr);
+  *rq  = PetscRealPart(dot);
+  PetscFunctionReturn(0);
+}
+
+/*
+ * The bounds of the last estimate are kept if the Rayleigh quotient of its approximate dominant eigenvector moved by
+ * less than esteig_reuse_rtol with the new operators, this costs one application of the preconditioned operator
+ */
+static PetscErrorCode KSPChebyshevEstEigReuseCheck_Private(KSP ksp,Mat Amat,PetscBool *valid)
+{
+  KSP_Chebyshev  *cheb = (KSP_Chebyshev*)ksp->data;
+  PetscErrorCode ierr;
+  PetscInt       m,n,M,N;
+  PetscBool      same;
+  PetscReal      rq;
+
+  PetscFunctionBegin;
+  *valid = PETSC_FALSE;
+  ierr = VecGetLocalSize(cheb->vest,&m);CHKERRQ(ierr);
+  ierr = VecGetSize(cheb->vest,&M);CHKERRQ(ierr);
+  ierr = MatGetLocalSize(Amat,NULL,&n);CHKERRQ(ierr);
+  ierr = MatGetSize(Amat,NULL,&N);CHKERRQ(ierr);
+  same = (PetscBool)(m == n && M == N);
+  ierr = MPIU_Allreduce(MPI_IN_PLACE,&same,1,MPIU_BOOL,MPI_LAND,PetscObjectComm((PetscObject)ksp));CHKERRMPI(ierr);
+  if (!same) {
+    ierr = VecDestroy(&cheb->vest);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  ierr = KSPChebyshevRayleighQuotient_Private(ksp,Amat,cheb->vest,ksp->work[2],&rq);CHKERRQ(ierr);
+  *valid = (PetscBool)(PetscAbsReal(rq - cheb->rqest) <= cheb->esteig_reuse_rtol*PetscAbsReal(cheb->rqest));
+  ierr = PetscInfo3(ksp,"Rayleigh quotient %g, was %g at the last eigenvalue estimate: %s\n",(double)rq,(double)cheb->rqest,*valid ? "reusing the estimate" : "estimating again");CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 static PetscErrorCode KSPSetUp_Chebyshev(KSP ksp)
 {
   KSP_Chebyshev    *cheb = (KSP_Chebyshev*)ksp->data;
@@ -70,8 +117,23 @@ static PetscErrorCode KSPSetUp_Chebyshev(KSP ksp)
       PetscReal          max=0.0,min=0.0;
       Vec                B;
       KSPConvergedReason reason;
+      PetscBool          valid = PETSC_FALSE;
+
+      if (cheb->esteig_reuse && cheb->vest) {
+        ierr = KSPChebyshevEstEigReuseCheck_Private(ksp,Amat,&valid);CHKERRQ(ierr);
+      }
+      if (valid) {
+        cheb->nreuses++;
+        cheb->amatid    = amatid;
+        cheb->pmatid    = pmatid;
+        cheb->amatstate = amatstate;
+        cheb->pmatstate = pmatstate;
+        PetscFunctionReturn(0);
+      }
       ierr = KSPSetPC(cheb->kspest,ksp->pc);CHKERRQ(ierr);
-      if (cheb->usenoisy) {
+      if (cheb->esteig_reuse && cheb->vest) {
+        B = cheb->vest; /* warm start the Krylov space from the dominant direction of the last estimate */
+      } else if (cheb->usenoisy) {
         B = ksp->work[1];
         ierr = KSPSetNoisy_Private(B);CHKERRQ(ierr);
       } else {
@@ -117,6 +179,21 @@ static PetscErrorCode KSPSetUp_Chebyshev(KSP ksp)
       cheb->emax_computed = max;
       cheb->emin = cheb->tform[0]*min + cheb->tform[1]*max;
       cheb->emax = cheb->tform[2]*min + cheb->tform[3]*max;
+      cheb->nestimates++;
+
+      if (cheb->esteig_reuse) {
+        /* one power iteration from the right hand side of the estimate approximates the dominant eigenvector */
+        if (!cheb->vest) {
+          ierr = VecDuplicate(ksp->work[0],&cheb->vest);CHKERRQ(ierr);
+          ierr = PetscLogObjectParent((PetscObject)ksp,(PetscObject)cheb->vest);CHKERRQ(ierr);
+        }
+        if (B != cheb->vest) {ierr = VecCopy(B,cheb->vest);CHKERRQ(ierr);}
+        ierr = KSP_MatMult(ksp,Amat,cheb->vest,ksp->work[1]);CHKERRQ(ierr);
+        ierr = KSP_PCApply(ksp,ksp->work[1],ksp->work[2]);CHKERRQ(ierr);
+        ierr = VecCopy(ksp->work[2],cheb->vest);CHKERRQ(ierr);
+        ierr = VecNormalize(cheb->vest,NULL);CHKERRQ(ierr);
+        ierr = KSPChebyshevRayleighQuotient_Private(ksp,Amat,cheb->vest,ksp->work[2],&cheb->rqest);CHKERRQ(ierr);
+      }
 
       cheb->amatid    = amatid;
       cheb->pmatid    = pmatid;
@@ -174,6 +251,7 @@ static PetscErrorCode KSPChebyshevEstEigSet_Chebyshev(KSP ksp,PetscReal a,PetscR
   } else {
     ierr = KSPDestroy(&cheb->kspest);CHKERRQ(ierr);
   }
+  ierr = VecDestroy(&cheb->vest);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
@@ -186,6 +264,21 @@ static PetscErrorCode KSPChebyshevEstEigSetUseNoisy_Chebyshev(KSP ksp,PetscBool
   PetscFunctionReturn(0);
 }
 
+static PetscErrorCode KSPChebyshevEstEigSetReuse_Chebyshev(KSP ksp,PetscBool reuse,PetscReal rtol)
+{
+  KSP_Chebyshev  *cheb = (KSP_Chebyshev*)ksp->data;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  cheb->esteig_reuse = reuse;
+  if (rtol != PETSC_DEFAULT) {
+    if (rtol < 0.0) SETERRQ1(PetscObjectComm((PetscObject)ksp),PETSC_ERR_ARG_OUTOFRANGE,"Relative tolerance %g must be nonnegative",(double)rtol);
+    cheb->esteig_reuse_rtol = rtol;
+  }
+  if (!reuse) {ierr = VecDestroy(&cheb->vest);CHKERRQ(ierr);}
+  PetscFunctionReturn(0);
+}
+
 /*@
    KSPChebyshevSetEigenvalues - Sets estimates for the extreme eigenvalues
    of the preconditioned problem.
@@ -293,6 +386,47 @@ PetscErrorCode KSPChebyshevEstEigSetUseNoisy(KSP ksp,PetscBool use)
   PetscFunctionReturn(0);
 }
 
+/*@
+   KSPChebyshevEstEigSetReuse - Reuse the estimated eigenvalues when the operators change, as long as a Rayleigh quotient
+   check shows that they are still valid
+
+   Logically Collective on ksp
+
+   Input Arguments:
++  ksp - linear solver context
+.  reuse - PETSC_TRUE to check the previous estimate before estimating the eigenvalues again
+-  rtol - relative change of the Rayleigh quotient above which the eigenvalues are estimated again, or PETSC_DEFAULT to keep the current value (default 0.05)
+
+   Options Database:
++  -ksp_chebyshev_esteig_reuse <true,false> - reuse the estimates while they are valid
+-  -ksp_chebyshev_esteig_reuse_rtol <rtol> - relative change of the Rayleigh quotient that triggers a new estimate
+
+   Notes:
+   After each estimate, one power iteration from the right hand side of the estimate gives an approximation v of the dominant
+   eigenvector of the preconditioned operator, together with its Rayleigh quotient. When the operators change, the Rayleigh
+   quotient of v is computed with the new operators, which costs one matrix-vector product and one preconditioner application.
+   If it moved by less than rtol relative to the one of the last estimate, the Chebyshev bounds are kept, otherwise the
+   eigenvalues are estimated again, starting the Krylov method from v instead of a new right hand side.
+
+   This is intended for sequences of slowly varying operators, such as the smoothers of PCMG in time-dependent problems,
+   see PCMGSetEstEigReuse().
+
+   Level: intermediate
+
+.seealso: KSPChebyshevEstEigSet(), PCMGSetEstEigReuse()
+@*/
+PetscErrorCode KSPChebyshevEstEigSetReuse(KSP ksp,PetscBool reuse,PetscReal rtol)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(ksp,KSP_CLASSID,1);
+  PetscValidLogicalCollectiveBool(ksp,reuse,2);
+  PetscValidLogicalCollectiveReal(ksp,rtol,3);
+  ierr = PetscTryMethod(ksp,"KSPChebyshevEstEigSetReuse_C",(KSP,PetscBool,PetscReal),(ksp,reuse,rtol));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 /*@
   KSPChebyshevEstEigGetKSP - Get the Krylov method context used to estimate eigenvalues for the Chebyshev method.  If
   a Krylov method is not being used for this purpose, NULL is returned.  The reference count of the returned KSP is
@@ -369,6 +503,8 @@ static PetscErrorCode KSPSetFromOptions_Chebyshev(PetscOptionItems *PetscOptions
 
   if (cheb->kspest) {
     ierr = PetscOptionsBool("-ksp_chebyshev_esteig_noisy","Use noisy right hand side for estimate","KSPChebyshevEstEigSetUseNoisy",cheb->usenoisy,&cheb->usenoisy,NULL);CHKERRQ(ierr);
+    ierr = PetscOptionsBool("-ksp_chebyshev_esteig_reuse","Reuse the estimate while a Rayleigh quotient check shows it is valid","KSPChebyshevEstEigSetReuse",cheb->esteig_reuse,&cheb->esteig_reuse,NULL);CHKERRQ(ierr);
+    ierr = PetscOptionsReal("-ksp_chebyshev_esteig_reuse_rtol","Relative change of the Rayleigh quotient that triggers a new estimate","KSPChebyshevEstEigSetReuse",cheb->esteig_reuse_rtol,&cheb->esteig_reuse_rtol,NULL);CHKERRQ(ierr);
     ierr = KSPSetFromOptions(cheb->kspest);CHKERRQ(ierr);
   }
   ierr = PetscOptionsTail();CHKERRQ(ierr);
@@ -568,6 +704,9 @@ static  PetscErrorCode KSPView_Chebyshev(KSP ksp,PetscViewer viewer)
       if (cheb->usenoisy) {
         ierr = PetscViewerASCIIPrintf(viewer,"  estimating eigenvalues using noisy right hand side\n");CHKERRQ(ierr);
       }
+      if (cheb->esteig_reuse) {
+        ierr = PetscViewerASCIIPrintf(viewer,"  reusing the estimate while the Rayleigh quotient changes by less than %g: estimated %D times, reused %D times\n",(double)cheb->esteig_reuse_rtol,cheb->nestimates,cheb->nreuses);CHKERRQ(ierr);
+      }
     }
   }
   PetscFunctionReturn(0);
@@ -583,6 +722,7 @@ static PetscErrorCode KSPDestroy_Chebyshev(KSP ksp)
   ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPChebyshevSetEigenvalues_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPChebyshevEstEigSet_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPChebyshevEstEigSetUseNoisy_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPChebyshevEstEigSetReuse_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPChebyshevEstEigGetKSP_C",NULL);CHKERRQ(ierr);
   ierr = KSPDestroyDefault(ksp);CHKERRQ(ierr);
   PetscFunctionReturn(0);
@@ -597,7 +737,9 @@ static PetscErrorCode KSPDestroy_Chebyshev(KSP ksp)
 .   -ksp_chebyshev_esteig <a,b,c,d> - estimate eigenvalues using a Krylov method, then use this
                          transform for Chebyshev eigenvalue bounds (KSPChebyshevEstEigSet())
 .   -ksp_chebyshev_esteig_steps - number of estimation steps
--   -ksp_chebyshev_esteig_noisy - use noisy number generator to create right hand side for eigenvalue estimator
+.   -ksp_chebyshev_esteig_noisy - use noisy number generator to create right hand side for eigenvalue estimator
+.   -ksp_chebyshev_esteig_reuse - reuse the estimate when the operators change while a Rayleigh quotient check shows it is valid
+-   -ksp_chebyshev_esteig_reuse_rtol - relative change of the Rayleigh quotient that triggers a new estimate
 
    Level: beginner
 
@@ -610,7 +752,7 @@ static PetscErrorCode KSPDestroy_Chebyshev(KSP ksp)
           The user should call KSPChebyshevSetEigenvalues() if they have eigenvalue estimates.
 
 .seealso:  KSPCreate(), KSPSetType(), KSPType (for list of available types), KSP,
-           KSPChebyshevSetEigenvalues(), KSPChebyshevEstEigSet(), KSPChebyshevEstEigSetUseNoisy()
+           KSPChebyshevSetEigenvalues(), KSPChebyshevEstEigSet(), KSPChebyshevEstEigSetUseNoisy(), KSPChebyshevEstEigSetReuse()
            KSPRICHARDSON, KSPCG, PCMG
 
 M*/
@@ -638,6 +780,7 @@ PETSC_EXTERN PetscErrorCode KSPCreate_Chebyshev(KSP ksp)
   chebyshevP->tform[3] = 1.1;
   chebyshevP->eststeps = 10;
   chebyshevP->usenoisy = PETSC_TRUE;
+  chebyshevP->esteig_reuse_rtol = 0.05;
   ksp->setupnewmatrix = PETSC_TRUE;
 
   ksp->ops->setup          = KSPSetUp_Chebyshev;
@@ -652,6 +795,7 @@ PETSC_EXTERN PetscErrorCode KSPCreate_Chebyshev(KSP ksp)
   ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPChebyshevSetEigenvalues_C",KSPChebyshevSetEigenvalues_Chebyshev);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPChebyshevEstEigSet_C",KSPChebyshevEstEigSet_Chebyshev);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPChebyshevEstEigSetUseNoisy_C",KSPChebyshevEstEigSetUseNoisy_Chebyshev);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPChebyshevEstEigSetReuse_C",KSPChebyshevEstEigSetReuse_Chebyshev);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPChebyshevEstEigGetKSP_C",KSPChebyshevEstEigGetKSP_Chebyshev);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
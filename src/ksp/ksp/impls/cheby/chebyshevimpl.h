@@ -17,6 +17,12 @@ typedef struct {
   /* For tracking when to update the eigenvalue estimates */
   PetscObjectId    amatid,    pmatid;
   PetscObjectState amatstate, pmatstate;
+  /* For reusing the eigenvalue estimates when the operators change */
+  PetscBool        esteig_reuse;      /* check the previous estimates with a Rayleigh quotient before estimating again */
+  PetscReal        esteig_reuse_rtol; /* relative change of the Rayleigh quotient above which the eigenvalues are estimated again */
+  Vec              vest;              /* approximation of the dominant eigenvector of the preconditioned operator */
+  PetscReal        rqest;             /* Rayleigh quotient of vest with the operators of the last estimate */
+  PetscInt         nestimates,nreuses;
 } KSP_Chebyshev;
 
 #endif
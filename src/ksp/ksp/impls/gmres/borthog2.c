@@ -118,3 +118,138 @@ done:
   ierr = PetscLogEventEnd(KSP_GMRESOrthogonalization,ksp,0,0,0);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
+
+/*@C
+     KSPGMRESLowSyncGramSchmidtOrthogonalization -  Classical Gram-Schmidt orthogonalization with delayed
+                reorthogonalization that requires a single global reduction per GMRES iteration
+
+     Collective on ksp
+
+  Input Parameters:
++   ksp - KSP object, must be associated with the GMRES Krylov method
+-   its - one less then the current GMRES restart iteration, i.e. the size of the Krylov space
+
+   Options Database Keys:
+.  -ksp_gmres_lowsyncgramschmidt - Activates KSPGMRESLowSyncGramSchmidtOrthogonalization()
+
+    Notes:
+    The inner products of the new Krylov vector with the basis, its norm, and the inner products needed to
+    reorthogonalize the previous Krylov vector are all computed with one MPI_Allreduce(). The second classical
+    Gram-Schmidt pass on each Krylov vector is therefore delayed by one iteration and the previous column of the
+    Hessenberg matrix is corrected afterwards (Swirydowicz, Langou, Ananthan, Yang and Thomas, Low synchronization
+    Gram-Schmidt and generalized minimal residual algorithms, 2020). The norms are obtained from the Pythagorean
+    theorem, an explicit VecNorm() is only computed when cancellation makes this unreliable.
+
+    The stability is similar to KSPGMRESClassicalGramSchmidtOrthogonalization() with KSP_GMRES_CGS_REFINE_ALWAYS but with
+    one global reduction per iteration instead of three, which matters when GMRES is latency bound on many processes.
+    Since the newest Krylov vector is only reorthogonalized at the next iteration, the monitored residual norms
+    can differ slightly from those obtained with the other orthogonalizations.
+
+    Only KSPGMRES supports this orthogonalization.
+
+   Level: intermediate
+
+.seealso:  KSPGMRESSetOrthogonalization(), KSPGMRESClassicalGramSchmidtOrthogonalization(), KSPGMRESGetOrthogonalization(),
+           KSPGMRESModifiedGramSchmidtOrthogonalization()
+
+@*/
+PetscErrorCode  KSPGMRESLowSyncGramSchmidtOrthogonalization(KSP ksp,PetscInt it)
+{
+  KSP_GMRES      *gmres = (KSP_GMRES*)(ksp->data);
+  PetscErrorCode ierr;
+  PetscInt       i,j;
+  PetscScalar    *hh,*hes,*lhh,*dhh,hprev,g;
+  PetscReal      nu = 1.0,nrm2,omega,tt;
+  PetscBool      isgmres;
+
+  PetscFunctionBegin;
+  ierr = PetscLogEventBegin(KSP_GMRESOrthogonalization,ksp,0,0,0);CHKERRQ(ierr);
+  if (!it) {
+    ierr = PetscObjectTypeCompare((PetscObject)ksp,KSPGMRES,&isgmres);CHKERRQ(ierr);
+    if (!isgmres) SETERRQ1(PetscObjectComm((PetscObject)ksp),PETSC_ERR_SUP,"Low synchronization Gram-Schmidt is not supported by KSP type %s",((PetscObject)ksp)->type_name);
+  }
+  if (!gmres->orthogwork) {
+    ierr = PetscMalloc1(2*gmres->max_k + 4,&gmres->orthogwork);CHKERRQ(ierr);
+  }
+  lhh = gmres->orthogwork;          /* <v_it,v_j>,   j = 0,...,it   */
+  dhh = gmres->orthogwork + it + 1; /* <v_it+1,v_j>, j = 0,...,it+1 */
+
+  /* the only global reduction of the iteration */
+  ierr = VecMDotBegin(VEC_VV(it+1),it+2,&(VEC_VV(0)),dhh);CHKERRQ(ierr);
+  if (it) {ierr = VecMDotBegin(VEC_VV(it),it+1,&(VEC_VV(0)),lhh);CHKERRQ(ierr);}
+  ierr = PetscCommSplitReductionBegin(PetscObjectComm((PetscObject)VEC_VV(0)));CHKERRQ(ierr);
+  ierr = VecMDotEnd(VEC_VV(it+1),it+2,&(VEC_VV(0)),dhh);CHKERRQ(ierr);
+  if (it) {ierr = VecMDotEnd(VEC_VV(it),it+1,&(VEC_VV(0)),lhh);CHKERRQ(ierr);}
+  for (j=0; j<=it+1; j++) {
+    KSPCheckDot(ksp,dhh[j]);
+    if (ksp->reason) goto done;
+  }
+  omega = PetscRealPart(dhh[it+1]);
+
+  if (it) {
+    /* delayed second Gram-Schmidt pass on v_it, which is then normalized */
+    for (j=0; j<=it; j++) {
+      KSPCheckDot(ksp,lhh[j]);
+      if (ksp->reason) goto done;
+    }
+    nrm2 = PetscRealPart(lhh[it]);
+    g    = dhh[it];
+    for (j=0; j<it; j++) {
+      nrm2 -= PetscRealPart(PetscConj(lhh[j])*lhh[j]);
+      g    -= PetscConj(lhh[j])*dhh[j];
+      lhh[j] = -lhh[j];
+    }
+    ierr = VecMAXPY(VEC_VV(it),it,lhh,&VEC_VV(0));CHKERRQ(ierr);
+    if (nrm2 > PETSC_SMALL*PetscRealPart(lhh[it])) nu = PetscSqrtReal(nrm2);
+    else {
+      ierr = VecNorm(VEC_VV(it),NORM_2,&nu);CHKERRQ(ierr);
+      KSPCheckNorm(ksp,nu);
+      if (ksp->reason) goto done;
+    }
+    if (nu == 0.0) {
+      if (ksp->errorifnotconverged) SETERRQ1(PetscObjectComm((PetscObject)ksp),PETSC_ERR_NOT_CONVERGED,"Krylov vector %D is linearly dependent on the previous ones",it);
+      ierr = PetscInfo1(ksp,"Krylov vector %D is linearly dependent on the previous ones\n",it);CHKERRQ(ierr);
+      ksp->reason = KSP_DIVERGED_BREAKDOWN;
+      goto done;
+    }
+    ierr    = VecScale(VEC_VV(it),1.0/nu);CHKERRQ(ierr);
+    dhh[it] = g/nu;
+
+    /* A v_it-1 was expanded on the unfinished v_it, expand it on the reorthogonalized one instead */
+    hprev = *HES(it,it-1);
+    for (j=0; j<it; j++) *HES(j,it-1) -= hprev*lhh[j];
+    *HES(it,it-1) = hprev*nu;
+  }
+
+  /*
+     v_it+1 = A v_it^old = nu A v_it + sum_j a_j A v_j, so the new column of the Hessenberg matrix is
+     (<v_it+1,v_i> - sum_j H(i,j) a_j)/nu where a_j = -lhh[j] are the coefficients of the delayed pass
+  */
+  hh  = HH(0,it);
+  hes = HES(0,it);
+  for (i=0; i<=it; i++) {
+    g = dhh[i];
+    for (j=PetscMax(i-1,0); j<it; j++) g += *HES(i,j)*lhh[j];
+    hes[i] = hh[i] = g/nu;
+  }
+
+  /* first Gram-Schmidt pass on v_it+1, whose norm follows from the inner products */
+  nrm2 = omega;
+  for (j=0; j<=it; j++) {
+    nrm2  -= PetscRealPart(PetscConj(dhh[j])*dhh[j]);
+    dhh[j] = -dhh[j];
+  }
+  ierr = VecMAXPY(VEC_VV(it+1),it+1,dhh,&VEC_VV(0));CHKERRQ(ierr);
+  if (nrm2 > PETSC_SMALL*omega) tt = PetscSqrtReal(nrm2);
+  else {
+    ierr = VecNorm(VEC_VV(it+1),NORM_2,&tt);CHKERRQ(ierr);
+    KSPCheckNorm(ksp,tt);
+    if (ksp->reason) goto done;
+  }
+  if (tt != 0.0) {ierr = VecScale(VEC_VV(it+1),1.0/tt);CHKERRQ(ierr);}
+  *HH(it+1,it)  = tt/nu;
+  *HES(it+1,it) = tt/nu;
+done:
+  ierr = PetscLogEventEnd(KSP_GMRESOrthogonalization,ksp,0,0,0);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
@@ -5,10 +5,12 @@
 #define kspgmressetorthogonalization_                  KSPGMRESSETORTHOGONALIZATION
 #define kspgmresmodifiedgramschmidtorthogonalization_  KSPGMRESMODIFIEDGRAMSCHMIDTORTHOGONALIZATION
 #define kspgmresclassicalgramschmidtorthogonalization_ KSPGMRESCLASSICALGRAMSCHMIDTORTHOGONALIZATION
+#define kspgmreslowsyncgramschmidtorthogonalization_   KSPGMRESLOWSYNCGRAMSCHMIDTORTHOGONALIZATION
 #elif !defined(PETSC_HAVE_FORTRAN_UNDERSCORE)
 #define kspgmressetorthogonalization_                  kspgmressetorthogonalization
 #define kspgmresmodifiedgramschmidtorthogonalization_  kspgmresmodifiedgramschmidtorthogonalization
 #define kspgmresclassicalgramschmidtorthogonalization_ kspgmresclassicalgramschmidtorthogonalization
+#define kspgmreslowsyncgramschmidtorthogonalization_   kspgmreslowsyncgramschmidtorthogonalization
 #endif
 
 static struct {
@@ -25,6 +27,11 @@ PETSC_EXTERN void kspgmresclassicalgramschmidtorthogonalization_(KSP *ksp,PetscI
   *ierr = KSPGMRESClassicalGramSchmidtOrthogonalization(*ksp,*n);
 }
 
+PETSC_EXTERN void kspgmreslowsyncgramschmidtorthogonalization_(KSP *ksp,PetscInt *n,PetscErrorCode *ierr)
+{
+  *ierr = KSPGMRESLowSyncGramSchmidtOrthogonalization(*ksp,*n);
+}
+
 static PetscErrorCode ourorthog(KSP ksp,PetscInt n)
 {
   PetscObjectUseFortranCallback(ksp,_cb.orthog,(KSP*,PetscInt*,PetscErrorCode*),(&ksp,&n,&ierr));
@@ -37,6 +44,8 @@ PETSC_EXTERN void kspgmressetorthogonalization_(KSP *ksp,void (*orthog)(KSP*,Pet
     *ierr = KSPGMRESSetOrthogonalization(*ksp,KSPGMRESModifiedGramSchmidtOrthogonalization);
   } else if ((PetscVoidFunction)orthog == (PetscVoidFunction)kspgmresclassicalgramschmidtorthogonalization_) {
     *ierr = KSPGMRESSetOrthogonalization(*ksp,KSPGMRESClassicalGramSchmidtOrthogonalization);
+  } else if ((PetscVoidFunction)orthog == (PetscVoidFunction)kspgmreslowsyncgramschmidtorthogonalization_) {
+    *ierr = KSPGMRESSetOrthogonalization(*ksp,KSPGMRESLowSyncGramSchmidtOrthogonalization);
   } else {
     *ierr = PetscObjectSetFortranCallback((PetscObject)*ksp,PETSC_FORTRAN_CALLBACK_CLASS,&_cb.orthog,(PetscVoidFunction)orthog,NULL); if (*ierr) return;
     *ierr = KSPGMRESSetOrthogonalization(*ksp,ourorthog);
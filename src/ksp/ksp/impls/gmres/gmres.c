@@ -32,6 +32,7 @@
 #define GMRES_DELTA_DIRECTIONS 10
 #define GMRES_DEFAULT_MAXK     30
 static PetscErrorCode KSPGMRESUpdateHessenberg(KSP,PetscInt,PetscBool,PetscReal*);
+static PetscErrorCode KSPGMRESCorrectHessenberg(KSP,PetscInt);
 static PetscErrorCode KSPGMRESBuildSoln(PetscScalar*,Vec,Vec,KSP,PetscInt);
 
 PetscErrorCode    KSPSetUp_GMRES(KSP ksp)
@@ -166,13 +167,20 @@ PetscErrorCode KSPGMRESCycle(PetscInt *itcount,KSP ksp)
     ierr = (*gmres->orthog)(ksp,it);CHKERRQ(ierr);
     if (ksp->reason) break;
 
-    /* vv(i+1) . vv(i+1) */
-    ierr = VecNormalize(VEC_VV(it+1),&tt);CHKERRQ(ierr);
-    KSPCheckNorm(ksp,tt);
-
-    /* save the magnitude */
-    *HH(it+1,it)  = tt;
-    *HES(it+1,it) = tt;
+    if (gmres->orthog == KSPGMRESLowSyncGramSchmidtOrthogonalization) {
+      /* vv(i+1) is already normalized, but the previous column of the Hessenberg matrix has changed */
+      tt = PetscRealPart(*HES(it+1,it));
+      if (it) {ierr = KSPGMRESCorrectHessenberg(ksp,it-1);CHKERRQ(ierr);}
+      if (ksp->reason) break;
+    } else {
+      /* vv(i+1) . vv(i+1) */
+      ierr = VecNormalize(VEC_VV(it+1),&tt);CHKERRQ(ierr);
+      KSPCheckNorm(ksp,tt);
+
+      /* save the magnitude */
+      *HH(it+1,it)  = tt;
+      *HES(it+1,it) = tt;
+    }
 
     /* check for the happy breakdown */
     hapbnd = PetscAbsScalar(tt / *GRS(it));
@@ -447,6 +455,25 @@ static PetscErrorCode KSPGMRESUpdateHessenberg(KSP ksp,PetscInt it,PetscBool hap
   }
   PetscFunctionReturn(0);
 }
+/*
+   Redo the plane rotations of column it of the Hessenberg matrix after the
+   orthogonalization has changed that column in HES.
+ */
+static PetscErrorCode KSPGMRESCorrectHessenberg(KSP ksp,PetscInt it)
+{
+  KSP_GMRES      *gmres = (KSP_GMRES*)(ksp->data);
+  PetscErrorCode ierr;
+  PetscInt       j;
+  PetscReal      res;
+
+  PetscFunctionBegin;
+  /* undo the last rotation of the right-hand-side of the Hessenberg system */
+  *GRS(it) = *CC(it) * *GRS(it) - PetscConj(*SS(it)) * *GRS(it+1);
+  for (j=0; j<=it+1; j++) *HH(j,it) = *HES(j,it);
+  ierr = KSPGMRESUpdateHessenberg(ksp,it,PETSC_FALSE,&res);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 /*
    This routine allocates more work vectors, starting from VEC_VV(it).
  */
@@ -528,6 +555,8 @@ PetscErrorCode KSPView_GMRES(KSP ksp,PetscViewer viewer)
     }
   } else if (gmres->orthog == KSPGMRESModifiedGramSchmidtOrthogonalization) {
     cstr = "Modified Gram-Schmidt Orthogonalization";
+  } else if (gmres->orthog == KSPGMRESLowSyncGramSchmidtOrthogonalization) {
+    cstr = "Low synchronization Classical (unmodified) Gram-Schmidt Orthogonalization with delayed refinement";
   } else {
     cstr = "unknown orthogonalization";
   }
@@ -602,6 +631,8 @@ PetscErrorCode KSPSetFromOptions_GMRES(PetscOptionItems *PetscOptionsObject,KSP
   if (flg) {ierr = KSPGMRESSetPreAllocateVectors(ksp);CHKERRQ(ierr);}
   ierr = PetscOptionsBoolGroupBegin("-ksp_gmres_classicalgramschmidt","Classical (unmodified) Gram-Schmidt (fast)","KSPGMRESSetOrthogonalization",&flg);CHKERRQ(ierr);
   if (flg) {ierr = KSPGMRESSetOrthogonalization(ksp,KSPGMRESClassicalGramSchmidtOrthogonalization);CHKERRQ(ierr);}
+  ierr = PetscOptionsBoolGroup("-ksp_gmres_lowsyncgramschmidt","Classical Gram-Schmidt with delayed refinement and one reduction per iteration","KSPGMRESSetOrthogonalization",&flg);CHKERRQ(ierr);
+  if (flg) {ierr = KSPGMRESSetOrthogonalization(ksp,KSPGMRESLowSyncGramSchmidtOrthogonalization);CHKERRQ(ierr);}
   ierr = PetscOptionsBoolGroupEnd("-ksp_gmres_modifiedgramschmidt","Modified Gram-Schmidt (slow,more stable)","KSPGMRESSetOrthogonalization",&flg);CHKERRQ(ierr);
   if (flg) {ierr = KSPGMRESSetOrthogonalization(ksp,KSPGMRESModifiedGramSchmidtOrthogonalization);CHKERRQ(ierr);}
   ierr = PetscOptionsEnum("-ksp_gmres_cgs_refinement_type","Type of iterative refinement for classical (unmodified) Gram-Schmidt","KSPGMRESSetCGSRefinementType",
@@ -670,8 +701,13 @@ PetscErrorCode  KSPGMRESSetRestart_GMRES(KSP ksp,PetscInt max_k)
 
 PetscErrorCode  KSPGMRESSetOrthogonalization_GMRES(KSP ksp,FCN fcn)
 {
+  KSP_GMRES      *gmres = (KSP_GMRES*)ksp->data;
+  PetscErrorCode ierr;
+
   PetscFunctionBegin;
-  ((KSP_GMRES*)ksp->data)->orthog = fcn;
+  /* the work space of the orthogonalizations differs in size */
+  if (gmres->orthog != fcn) {ierr = PetscFree(gmres->orthogwork);CHKERRQ(ierr);}
+  gmres->orthog = fcn;
   PetscFunctionReturn(0);
 }
 
@@ -896,6 +932,7 @@ PetscErrorCode  KSPGMRESSetBreakdownTolerance(KSP ksp,PetscReal tol)
                              vectors are allocated as needed)
 .   -ksp_gmres_classicalgramschmidt - use classical (unmodified) Gram-Schmidt to orthogonalize against the Krylov space (fast) (the default)
 .   -ksp_gmres_modifiedgramschmidt - use modified Gram-Schmidt in the orthogonalization (more stable, but slower)
+.   -ksp_gmres_lowsyncgramschmidt - use classical Gram-Schmidt with delayed refinement, one global reduction per iteration
 .   -ksp_gmres_cgs_refinement_type <refine_never,refine_ifneeded,refine_always> - determine if iterative refinement is used to increase the
                                    stability of the classical Gram-Schmidt  orthogonalization.
 -   -ksp_gmres_krylov_monitor - plot the Krylov space generated
@@ -911,7 +948,7 @@ PetscErrorCode  KSPGMRESSetBreakdownTolerance(KSP ksp,PetscReal tol)
 
 .seealso:  KSPCreate(), KSPSetType(), KSPType (for list of available types), KSP, KSPFGMRES, KSPLGMRES,
            KSPGMRESSetRestart(), KSPGMRESSetHapTol(), KSPGMRESSetPreAllocateVectors(), KSPGMRESSetOrthogonalization(), KSPGMRESGetOrthogonalization(),
-           KSPGMRESClassicalGramSchmidtOrthogonalization(), KSPGMRESModifiedGramSchmidtOrthogonalization(),
+           KSPGMRESClassicalGramSchmidtOrthogonalization(), KSPGMRESModifiedGramSchmidtOrthogonalization(), KSPGMRESLowSyncGramSchmidtOrthogonalization(),
            KSPGMRESCGSRefinementType, KSPGMRESSetCGSRefinementType(), KSPGMRESGetCGSRefinementType(), KSPGMRESMonitorKrylov(), KSPSetPCSide()
 
 M*/
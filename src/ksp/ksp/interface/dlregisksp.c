@@ -14,6 +14,7 @@ const char *const        PCPatchConstructTypes[] = {"star", "vanka", "pardecomp"
 
 const char *const        PCFailedReasons_Shifted[] = {"SETUP_ERROR","FACTOR_NOERROR","FACTOR_STRUCT_ZEROPIVOT","FACTOR_NUMERIC_ZEROPIVOT","FACTOR_OUTMEMORY","FACTOR_OTHER","SUBPC_ERROR",NULL};
 const char *const *const PCFailedReasons       = PCFailedReasons_Shifted + 1;
+const char *const        PCMatPrecisions[]     = {"DOUBLE","SINGLE","PCMatPrecision","PC_MAT_PRECISION_",NULL};
 
 static PetscBool PCPackageInitialized = PETSC_FALSE;
 /*@C
@@ -111,6 +112,7 @@ PetscErrorCode  PCInitializePackage(void)
 }
 
 const char *const KSPCGTypes[]                  = {"SYMMETRIC","HERMITIAN","KSPCGType","KSP_CG_",NULL};
+const char *const KSPSStepCGBasisTypes[]        = {"MONOMIAL","NEWTON","CHEBYSHEV","KSPSStepCGBasisType","KSP_SSTEPCG_BASIS_",NULL};
 const char *const KSPGMRESCGSRefinementTypes[]  = {"REFINE_NEVER", "REFINE_IFNEEDED", "REFINE_ALWAYS","KSPGMRESRefinementType","KSP_GMRES_CGS_",NULL};
 const char *const KSPNormTypes_Shifted[]        = {"DEFAULT","NONE","PRECONDITIONED","UNPRECONDITIONED","NATURAL","KSPNormType","KSP_NORM_",NULL};
 const char *const*const KSPNormTypes = KSPNormTypes_Shifted + 1;
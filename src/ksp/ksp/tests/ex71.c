@@ -0,0 +1,75 @@
+static char help[] = "Reuses the Chebyshev eigenvalue estimates of the multigrid smoothers for slowly varying operators.\n\n";
+
+/*
+  Solves (L + t C) x = b for a sequence of times t, where L is the 5-point Laplacian on a -m x -m grid and C a positive
+  diagonal varying in space. The operator varies slowly for -steps steps, then jumps at the last one, so that with
+  -pc_mg_esteig_reuse the smoothers only estimate their eigenvalues again at the first and last steps.
+
+  Usage: ./ex71 -m 200 -steps 20 -pc_type gamg -pc_gamg_reuse_interpolation -pc_mg_esteig_reuse -log_view
+*/
+#include <petscksp.h>
+
+int main(int argc,char **args)
+{
+  Mat            A;
+  Vec            x,b;
+  KSP            ksp;
+  PetscInt       m = 32,steps = 4,Istart,Iend,row,i,j,k,its;
+  PetscReal      t,dt = 0.01,tjump = 100.0;
+  PetscErrorCode ierr;
+
+  ierr = PetscInitialize(&argc,&args,(char*)0,help);if (ierr) return ierr;
+  ierr = PetscOptionsGetInt(NULL,NULL,"-m",&m,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,NULL,"-steps",&steps,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetReal(NULL,NULL,"-dt",&dt,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetReal(NULL,NULL,"-tjump",&tjump,NULL);CHKERRQ(ierr);
+
+  ierr = MatCreateAIJ(PETSC_COMM_WORLD,PETSC_DECIDE,PETSC_DECIDE,m*m,m*m,5,NULL,2,NULL,&A);CHKERRQ(ierr);
+  ierr = MatSetOption(A,MAT_SPD,PETSC_TRUE);CHKERRQ(ierr);
+  ierr = MatGetOwnershipRange(A,&Istart,&Iend);CHKERRQ(ierr);
+  ierr = MatCreateVecs(A,&x,&b);CHKERRQ(ierr);
+  ierr = VecSet(b,1.0);CHKERRQ(ierr);
+
+  ierr = KSPCreate(PETSC_COMM_WORLD,&ksp);CHKERRQ(ierr);
+  ierr = KSPSetOperators(ksp,A,A);CHKERRQ(ierr);
+  ierr = KSPSetFromOptions(ksp);CHKERRQ(ierr);
+
+  for (k=0; k<=steps; k++) {
+    t = k < steps ? k*dt : tjump;
+    for (row=Istart; row<Iend; row++) {
+      i = row/m; j = row - i*m;
+      if (i > 0)   {ierr = MatSetValue(A,row,row-m,-1.0,INSERT_VALUES);CHKERRQ(ierr);}
+      if (j > 0)   {ierr = MatSetValue(A,row,row-1,-1.0,INSERT_VALUES);CHKERRQ(ierr);}
+      ierr = MatSetValue(A,row,row,4.0 + t*(1.0 + (PetscReal)i/m),INSERT_VALUES);CHKERRQ(ierr);
+      if (j < m-1) {ierr = MatSetValue(A,row,row+1,-1.0,INSERT_VALUES);CHKERRQ(ierr);}
+      if (i < m-1) {ierr = MatSetValue(A,row,row+m,-1.0,INSERT_VALUES);CHKERRQ(ierr);}
+    }
+    ierr = MatAssemblyBegin(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+    ierr = MatAssemblyEnd(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+    ierr = KSPSolve(ksp,b,x);CHKERRQ(ierr);
+    ierr = KSPGetIterationNumber(ksp,&its);CHKERRQ(ierr);
+    ierr = PetscPrintf(PETSC_COMM_WORLD,"Step %D t %g: %D iterations\n",k,(double)t,its);CHKERRQ(ierr);
+  }
+
+  ierr = KSPDestroy(&ksp);CHKERRQ(ierr);
+  ierr = VecDestroy(&x);CHKERRQ(ierr);
+  ierr = VecDestroy(&b);CHKERRQ(ierr);
+  ierr = MatDestroy(&A);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+   testset:
+      args: -ksp_type cg -ksp_rtol 1.e-8 -pc_type gamg -pc_gamg_reuse_interpolation -pc_gamg_coarse_eq_limit 100 -mg_levels_ksp_type chebyshev -mg_levels_pc_type jacobi -ksp_view
+      filter: grep -e Step -e reused
+      test:
+         suffix: 1
+         args: -pc_mg_esteig_reuse
+      test:
+         suffix: 2
+         nsize: 2
+         args: -pc_mg_esteig_reuse -mg_levels_ksp_chebyshev_esteig_reuse_rtol 0.001
+
+TEST*/
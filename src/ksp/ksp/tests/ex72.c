@@ -0,0 +1,79 @@
+static char help[] = "Reuses the aggregates of GAMG for a sequence of operators with changing entries.\n\n";
+
+/*
+  Solves -u_xx - e^(-t) u_yy = 1 on a -m x -m grid for the times t = 0, dt, ..., steps*dt. The operator keeps its nonzero
+  pattern, so with -pc_gamg_reuse_aggregates GAMG only smooths the tentative prolongators again with the new operator
+  until the anisotropy has grown enough for the iterations to exceed -pc_gamg_recoarsen_factor times the iterations of
+  the first solve with the aggregates.
+
+  Usage: ./ex72 -m 200 -steps 10 -pc_type gamg -pc_gamg_reuse_aggregates -pc_gamg_threshold 0.05 -log_view
+*/
+#include <petscksp.h>
+
+int main(int argc,char **args)
+{
+  Mat            A;
+  Vec            x,b;
+  KSP            ksp;
+  PetscInt       m = 32,steps = 4,Istart,Iend,row,i,j,k,its;
+  PetscReal      t,dt = 0.5,ey;
+  PetscErrorCode ierr;
+
+  ierr = PetscInitialize(&argc,&args,(char*)0,help);if (ierr) return ierr;
+  ierr = PetscOptionsGetInt(NULL,NULL,"-m",&m,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,NULL,"-steps",&steps,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetReal(NULL,NULL,"-dt",&dt,NULL);CHKERRQ(ierr);
+
+  ierr = MatCreateAIJ(PETSC_COMM_WORLD,PETSC_DECIDE,PETSC_DECIDE,m*m,m*m,5,NULL,2,NULL,&A);CHKERRQ(ierr);
+  ierr = MatSetOption(A,MAT_SPD,PETSC_TRUE);CHKERRQ(ierr);
+  ierr = MatGetOwnershipRange(A,&Istart,&Iend);CHKERRQ(ierr);
+  ierr = MatCreateVecs(A,&x,&b);CHKERRQ(ierr);
+  ierr = VecSet(b,1.0);CHKERRQ(ierr);
+
+  ierr = KSPCreate(PETSC_COMM_WORLD,&ksp);CHKERRQ(ierr);
+  ierr = KSPSetOperators(ksp,A,A);CHKERRQ(ierr);
+  ierr = KSPSetFromOptions(ksp);CHKERRQ(ierr);
+
+  for (k=0; k<=steps; k++) {
+    t  = k*dt;
+    ey = PetscExpReal(-t);
+    for (row=Istart; row<Iend; row++) {
+      i = row/m; j = row - i*m;
+      if (i > 0)   {ierr = MatSetValue(A,row,row-m,-ey,INSERT_VALUES);CHKERRQ(ierr);}
+      if (j > 0)   {ierr = MatSetValue(A,row,row-1,-1.0,INSERT_VALUES);CHKERRQ(ierr);}
+      ierr = MatSetValue(A,row,row,2.0+2.0*ey,INSERT_VALUES);CHKERRQ(ierr);
+      if (j < m-1) {ierr = MatSetValue(A,row,row+1,-1.0,INSERT_VALUES);CHKERRQ(ierr);}
+      if (i < m-1) {ierr = MatSetValue(A,row,row+m,-ey,INSERT_VALUES);CHKERRQ(ierr);}
+    }
+    ierr = MatAssemblyBegin(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+    ierr = MatAssemblyEnd(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+    ierr = KSPSolve(ksp,b,x);CHKERRQ(ierr);
+    ierr = KSPGetIterationNumber(ksp,&its);CHKERRQ(ierr);
+    ierr = PetscPrintf(PETSC_COMM_WORLD,"Step %D t %g: %D iterations\n",k,(double)t,its);CHKERRQ(ierr);
+  }
+
+  ierr = KSPDestroy(&ksp);CHKERRQ(ierr);
+  ierr = VecDestroy(&x);CHKERRQ(ierr);
+  ierr = VecDestroy(&b);CHKERRQ(ierr);
+  ierr = MatDestroy(&A);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+   testset:
+      args: -ksp_type cg -ksp_rtol 1.e-8 -pc_type gamg -pc_gamg_reuse_aggregates -pc_gamg_coarse_eq_limit 100 -ksp_view
+      filter: grep -e Step -e "Reusing the aggregates"
+      test:
+         suffix: 1
+      test:
+         suffix: 2
+         nsize: 2
+         args: -pc_gamg_threshold 0.05 -pc_gamg_recoarsen_factor 1.2 -steps 8
+      test:
+         suffix: reduction
+         nsize: 4
+         args: -pc_gamg_process_eq_limit 200
+
+TEST*/
@@ -0,0 +1,63 @@
+static char help[] = "Reduces the active processes of the GAMG coarse grids within the shared memory nodes first.\n\n";
+
+/*
+  Solves the 7-point Laplacian on a -m x -m x -m grid with GAMG. With -pc_gamg_node_aware_reduction the coarse grids
+  move their equations between the processes of the same node until one process per node is active, -info shows the
+  reductions.
+
+  Usage: mpiexec -n 64 ./ex73 -m 64 -pc_type gamg -pc_gamg_node_aware_reduction -pc_gamg_process_eq_limit 200 -log_view
+*/
+#include <petscksp.h>
+
+int main(int argc,char **args)
+{
+  Mat            A;
+  Vec            x,b;
+  KSP            ksp;
+  PetscInt       m = 16,Istart,Iend,row,i,j,k,its;
+  PetscErrorCode ierr;
+
+  ierr = PetscInitialize(&argc,&args,(char*)0,help);if (ierr) return ierr;
+  ierr = PetscOptionsGetInt(NULL,NULL,"-m",&m,NULL);CHKERRQ(ierr);
+
+  ierr = MatCreateAIJ(PETSC_COMM_WORLD,PETSC_DECIDE,PETSC_DECIDE,m*m*m,m*m*m,7,NULL,6,NULL,&A);CHKERRQ(ierr);
+  ierr = MatSetOption(A,MAT_SPD,PETSC_TRUE);CHKERRQ(ierr);
+  ierr = MatGetOwnershipRange(A,&Istart,&Iend);CHKERRQ(ierr);
+  for (row=Istart; row<Iend; row++) {
+    i = row/(m*m); j = (row/m)%m; k = row%m;
+    if (i > 0)   {ierr = MatSetValue(A,row,row-m*m,-1.0,INSERT_VALUES);CHKERRQ(ierr);}
+    if (j > 0)   {ierr = MatSetValue(A,row,row-m,-1.0,INSERT_VALUES);CHKERRQ(ierr);}
+    if (k > 0)   {ierr = MatSetValue(A,row,row-1,-1.0,INSERT_VALUES);CHKERRQ(ierr);}
+    ierr = MatSetValue(A,row,row,6.0,INSERT_VALUES);CHKERRQ(ierr);
+    if (k < m-1) {ierr = MatSetValue(A,row,row+1,-1.0,INSERT_VALUES);CHKERRQ(ierr);}
+    if (j < m-1) {ierr = MatSetValue(A,row,row+m,-1.0,INSERT_VALUES);CHKERRQ(ierr);}
+    if (i < m-1) {ierr = MatSetValue(A,row,row+m*m,-1.0,INSERT_VALUES);CHKERRQ(ierr);}
+  }
+  ierr = MatAssemblyBegin(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatCreateVecs(A,&x,&b);CHKERRQ(ierr);
+  ierr = VecSet(b,1.0);CHKERRQ(ierr);
+
+  ierr = KSPCreate(PETSC_COMM_WORLD,&ksp);CHKERRQ(ierr);
+  ierr = KSPSetOperators(ksp,A,A);CHKERRQ(ierr);
+  ierr = KSPSetFromOptions(ksp);CHKERRQ(ierr);
+  ierr = KSPSolve(ksp,b,x);CHKERRQ(ierr);
+  ierr = KSPGetIterationNumber(ksp,&its);CHKERRQ(ierr);
+  ierr = PetscPrintf(PETSC_COMM_WORLD,"%D iterations\n",its);CHKERRQ(ierr);
+
+  ierr = KSPDestroy(&ksp);CHKERRQ(ierr);
+  ierr = VecDestroy(&x);CHKERRQ(ierr);
+  ierr = VecDestroy(&b);CHKERRQ(ierr);
+  ierr = MatDestroy(&A);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+   test:
+      nsize: 8
+      args: -ksp_type cg -ksp_rtol 1.e-8 -pc_type gamg -pc_gamg_node_aware_reduction -pc_gamg_process_eq_limit 100 -pc_gamg_coarse_eq_limit 10 -info :pc
+      filter: grep -e iterations -e "active processes" -e "same node"
+
+TEST*/
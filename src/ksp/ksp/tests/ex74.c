@@ -0,0 +1,118 @@
+static char help[] = "Builds the preconditioners from the matrix values rounded to single precision.\n\n";
+
+/*
+  Solves the 5-point Laplacian with a variable coefficient on a -m x -m grid, then again after the coefficient
+  changed. With -pc_mat_precision single the preconditioner is built from a MATSEQAIJSINGLE copy of the matrix
+  (for PCBJACOBI and PCASM use -sub_pc_mat_precision single), which is updated for the second solve. Also checks that
+  MatMult() with MATSEQAIJSINGLE agrees with MATSEQAIJ to single precision.
+
+  Usage: ./ex74 -m 1000 -pc_type ilu -pc_mat_precision single -log_view
+*/
+#include <petscksp.h>
+
+static PetscErrorCode FillMatrix(Mat A,PetscInt m,PetscReal c)
+{
+  PetscErrorCode ierr;
+  PetscInt       Istart,Iend,row,i,j;
+  PetscReal      k;
+
+  PetscFunctionBegin;
+  ierr = MatGetOwnershipRange(A,&Istart,&Iend);CHKERRQ(ierr);
+  for (row=Istart; row<Iend; row++) {
+    i = row/m; j = row - i*m;
+    k = 1.0 + c*(PetscReal)(i+j)/m;
+    if (i > 0)   {ierr = MatSetValue(A,row,row-m,-k,INSERT_VALUES);CHKERRQ(ierr);}
+    if (j > 0)   {ierr = MatSetValue(A,row,row-1,-1.0,INSERT_VALUES);CHKERRQ(ierr);}
+    ierr = MatSetValue(A,row,row,2.0+2.0*k,INSERT_VALUES);CHKERRQ(ierr);
+    if (j < m-1) {ierr = MatSetValue(A,row,row+1,-1.0,INSERT_VALUES);CHKERRQ(ierr);}
+    if (i < m-1) {ierr = MatSetValue(A,row,row+m,-k,INSERT_VALUES);CHKERRQ(ierr);}
+  }
+  ierr = MatAssemblyBegin(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+int main(int argc,char **args)
+{
+  Mat            A,As;
+  Vec            x,b,y,ys;
+  KSP            ksp;
+  PetscInt       m = 32,k,its;
+  PetscReal      norm,diff;
+  PetscMPIInt    size;
+  PetscErrorCode ierr;
+
+  ierr = PetscInitialize(&argc,&args,(char*)0,help);if (ierr) return ierr;
+  ierr = MPI_Comm_size(PETSC_COMM_WORLD,&size);CHKERRMPI(ierr);
+  ierr = PetscOptionsGetInt(NULL,NULL,"-m",&m,NULL);CHKERRQ(ierr);
+
+  ierr = MatCreateAIJ(PETSC_COMM_WORLD,PETSC_DECIDE,PETSC_DECIDE,m*m,m*m,5,NULL,2,NULL,&A);CHKERRQ(ierr);
+  ierr = FillMatrix(A,m,1.0);CHKERRQ(ierr);
+  ierr = MatCreateVecs(A,&x,&b);CHKERRQ(ierr);
+  ierr = VecSet(b,1.0);CHKERRQ(ierr);
+
+  if (size == 1) {
+    ierr = MatConvert(A,MATSEQAIJSINGLE,MAT_INITIAL_MATRIX,&As);CHKERRQ(ierr);
+    ierr = VecDuplicate(b,&y);CHKERRQ(ierr);
+    ierr = VecDuplicate(b,&ys);CHKERRQ(ierr);
+    ierr = VecSetRandom(x,NULL);CHKERRQ(ierr);
+    ierr = MatMult(A,x,y);CHKERRQ(ierr);
+    ierr = MatMult(As,x,ys);CHKERRQ(ierr);
+    ierr = VecNorm(y,NORM_2,&norm);CHKERRQ(ierr);
+    ierr = VecAXPY(ys,-1.0,y);CHKERRQ(ierr);
+    ierr = VecNorm(ys,NORM_2,&diff);CHKERRQ(ierr);
+    ierr = PetscPrintf(PETSC_COMM_WORLD,"MatMult with %s %s\n",MATSEQAIJSINGLE,diff <= 1.e-6*norm ? "agrees to single precision" : "differs");CHKERRQ(ierr);
+    ierr = VecDestroy(&y);CHKERRQ(ierr);
+    ierr = VecDestroy(&ys);CHKERRQ(ierr);
+    ierr = MatDestroy(&As);CHKERRQ(ierr);
+  }
+
+  ierr = KSPCreate(PETSC_COMM_WORLD,&ksp);CHKERRQ(ierr);
+  ierr = KSPSetOperators(ksp,A,A);CHKERRQ(ierr);
+  ierr = KSPSetFromOptions(ksp);CHKERRQ(ierr);
+  for (k=0; k<2; k++) {
+    if (k) {ierr = FillMatrix(A,m,10.0);CHKERRQ(ierr);}
+    ierr = VecZeroEntries(x);CHKERRQ(ierr);
+    ierr = KSPSolve(ksp,b,x);CHKERRQ(ierr);
+    ierr = KSPGetIterationNumber(ksp,&its);CHKERRQ(ierr);
+    ierr = PetscPrintf(PETSC_COMM_WORLD,"Solve %D: %D iterations\n",k,its);CHKERRQ(ierr);
+  }
+
+  ierr = KSPDestroy(&ksp);CHKERRQ(ierr);
+  ierr = VecDestroy(&x);CHKERRQ(ierr);
+  ierr = VecDestroy(&b);CHKERRQ(ierr);
+  ierr = MatDestroy(&A);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+   testset:
+      args: -ksp_type gmres -ksp_rtol 1.e-10 -ksp_view
+      filter: grep -e iterations -e MatMult -e "single precision" -e "type: seq"
+      test:
+         suffix: sor
+         args: -pc_type sor -pc_mat_precision single
+      test:
+         suffix: ssor
+         args: -pc_type sor -pc_sor_symmetric -pc_sor_omega 1.5 -pc_sor_its 2 -pc_mat_precision single
+      test:
+         suffix: ilu
+         args: -pc_type ilu -pc_factor_levels 1 -pc_mat_precision single
+      test:
+         suffix: ilu_in_place
+         args: -pc_type ilu -pc_factor_in_place -pc_mat_precision single
+      test:
+         suffix: lu
+         args: -pc_type lu -pc_factor_mat_ordering_type rcm -pc_mat_precision single
+      test:
+         suffix: bjacobi
+         nsize: 2
+         args: -pc_type bjacobi -sub_pc_type ilu -sub_pc_mat_precision single
+      test:
+         suffix: asm
+         nsize: 2
+         args: -pc_type asm -sub_pc_type ilu -sub_pc_mat_precision single
+
+TEST*/
@@ -297,6 +297,28 @@ int main(int argc,char **args)
       args: -ksp_monitor_short -ksp_type pipelcg -m 9 -n 9 -pc_type none -ksp_pipelcg_pipel 2 -ksp_pipelcg_lmax 2
       filter: grep -v "sqrt breakdown in iteration"
 
+   test:
+      suffix: gmres_lowsync
+      args: -ksp_monitor_short -m 9 -n 9 -ksp_gmres_lowsyncgramschmidt -ksp_gmres_restart 5 -ksp_pc_side {{left right}separate output}
+
+   test:
+      suffix: sstepcg
+      args: -ksp_monitor_short -ksp_type sstepcg -m 9 -n 9 -pc_type none -ksp_sstep_s 5 -ksp_sstep_basis {{monomial newton chebyshev}}
+      output_file: output/ex2_sstepcg.out
+
+   test:
+      suffix: sstepcg_unprecond
+      args: -ksp_monitor_short -ksp_type sstepcg -m 9 -n 9 -ksp_sstep_s 6 -ksp_norm_type unpreconditioned -ksp_sstep_basis {{monomial newton chebyshev}}
+
+   test:
+      suffix: sstepcg_natural
+      args: -ksp_monitor_short -ksp_type sstepcg -m 9 -n 9 -ksp_sstep_s 6 -ksp_norm_type natural -ksp_sstep_basis {{monomial newton chebyshev}}
+
+   test:
+      suffix: sstepcg_2
+      nsize: 2
+      args: -ksp_monitor_short -ksp_type sstepcg -m 9 -n 9 -pc_type jacobi
+
    test:
       suffix: sell
       args: -ksp_monitor_short -ksp_gmres_cgs_refinement_type refine_always -m 9 -n 9 -mat_type sell
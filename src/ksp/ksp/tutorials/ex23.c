@@ -213,4 +213,9 @@ int main(int argc,char **args)
       nsize: 2
       args: -ksp_monitor_short -ksp_rtol 1e-6 -ksp_type pipefgmres
 
+   test:
+      suffix: 4
+      nsize: 3
+      args: -ksp_monitor_short -ksp_gmres_lowsyncgramschmidt
+
 TEST*/
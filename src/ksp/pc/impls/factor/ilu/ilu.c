@@ -120,8 +120,9 @@ static PetscErrorCode PCSetUp_ILU(PC pc)
     }
 
     ((PC_Factor*)ilu)->fact = pc->pmat;
-    /* must update the pc record of the matrix state or the PC will attempt to run PCSetUp() yet again */
-    ierr = PetscObjectStateGet((PetscObject)pc->pmat,&pc->matstate);CHKERRQ(ierr);
+    /* must update the pc record of the matrix state or the PC will attempt to run PCSetUp() yet again;
+       with a reduced precision Pmat the record is the state of the user's Pmat, which PCSetUp() compares against */
+    ierr = PetscObjectStateGet((PetscObject)(pc->pmatuser ? pc->pmatuser : pc->pmat),&pc->matstate);CHKERRQ(ierr);
   } else {
     if (!pc->setupcalled) {
       /* first time in so compute reordering and symbolic factorization */
@@ -48,9 +48,81 @@ PetscErrorCode PCReset_GAMG(PC pc)
   }
   pc_gamg->emin = 0;
   pc_gamg->emax = 0;
+  for (level = 0; level < PETSC_MG_MAXLEVELS; level++) {
+    ierr = MatDestroy(&pc_gamg->Prol0[level]);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+/*
+   PCPostSolve_GAMG - records the iterations of the solves to decide when to build the aggregates again
+*/
+static PetscErrorCode PCPostSolve_GAMG(PC pc,KSP ksp,Vec b,Vec x)
+{
+  PetscErrorCode ierr;
+  PC_MG          *mg      = (PC_MG*)pc->data;
+  PC_GAMG        *pc_gamg = (PC_GAMG*)mg->innerctx;
+  PetscInt       its;
+
+  PetscFunctionBegin;
+  ierr = KSPGetIterationNumber(ksp,&its);CHKERRQ(ierr);
+  if (!pc_gamg->base_its) pc_gamg->base_its = PetscMax(its,1);
+  pc_gamg->last_its = its;
   PetscFunctionReturn(0);
 }
 
+/* -------------------------------------------------------------------------- */
+/*
+   PCGAMGReduceInNode_Private: reduce the number of active processes within each shared memory node only, keeping
+     about the share of 'a_new_size' of each node and at least one process per node
+
+   Output Parameter:
+   . a_new_size - number of active processes after the reduction
+   . a_target - process receiving the equations of this process, on the same node
+   . a_flg - PETSC_FALSE if there already is at most one active process per node, the reduction must then cross the nodes
+*/
+static PetscErrorCode PCGAMGReduceInNode_Private(PC pc,MPI_Comm comm,PetscMPIInt nactive,PetscMPIInt *a_new_size,PetscMPIInt *a_target,PetscBool *a_flg)
+{
+#if defined(PETSC_HAVE_MPI_PROCESS_SHARED_MEMORY)
+  PetscErrorCode ierr;
+  PetscShmComm   pshmcomm;
+  MPI_Comm       loccomm;
+  PetscMPIInt    size,locrank,locsize,leader,nnodes,nkeep,stride,istarget,ntargets;
+
+  PetscFunctionBegin;
+  *a_flg = PETSC_FALSE;
+  ierr = MPI_Comm_size(comm,&size);CHKERRMPI(ierr);
+  ierr = PetscShmCommGet(comm,&pshmcomm);CHKERRQ(ierr);
+  ierr = PetscShmCommGetMpiShmComm(pshmcomm,&loccomm);CHKERRQ(ierr);
+  ierr = MPI_Comm_rank(loccomm,&locrank);CHKERRMPI(ierr);
+  ierr = MPI_Comm_size(loccomm,&locsize);CHKERRMPI(ierr);
+  leader = !locrank;
+  ierr = MPIU_Allreduce(&leader,&nnodes,1,MPI_INT,MPI_SUM,comm);CHKERRMPI(ierr);
+  if (nactive <= nnodes) {
+    ierr = PetscInfo2(pc,"%d active processes on %d nodes, reduce across the nodes\n",nactive,nnodes);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  nkeep = (PetscMPIInt)((PetscReal)(*a_new_size)*locsize/size + 0.5);
+  nkeep = PetscMax(PetscMin(nkeep,locsize),1);
+  stride = (locsize + nkeep - 1)/nkeep;
+  ierr = PetscShmCommLocalToGlobal(pshmcomm,(locrank/stride)*stride,a_target);CHKERRQ(ierr);
+  istarget = !(locrank%stride);
+  ierr = MPIU_Allreduce(&istarget,&ntargets,1,MPI_INT,MPI_SUM,comm);CHKERRMPI(ierr);
+  if (ntargets >= nactive) PetscFunctionReturn(0);
+  ierr = PetscInfo4(pc,"Reduce within the %d nodes from %d to %d active processes (%d asked)\n",nnodes,nactive,ntargets,*a_new_size);CHKERRQ(ierr);
+  *a_new_size = ntargets;
+  *a_flg      = PETSC_TRUE;
+  PetscFunctionReturn(0);
+#else
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  *a_flg = PETSC_FALSE;
+  ierr = PetscInfo(pc,"Shared memory communicators need MPI-3, reduce across all processes\n");CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+#endif
+}
+
 /* -------------------------------------------------------------------------- */
 /*
    PCGAMGCreateLevel_GAMG: create coarse op with RAP.  repartition and/or reduce number
@@ -111,7 +183,7 @@ static PetscErrorCode PCGAMGCreateLevel_GAMG(PC pc,Mat Amat_fine,PetscInt cr_bs,
     ierr = PetscShmCommGetMpiShmComm(pshmcomm,&loccomm);CHKERRQ(ierr);
     ierr = MPI_Comm_rank(loccomm, &locrank);CHKERRMPI(ierr);
     s_nnodes = !locrank;
-    ierr = MPI_Allreduce(&s_nnodes,&r_nnodes,1,MPIU_INT,MPI_SUM,comm);CHKERRMPI(ierr);
+    ierr = MPIU_Allreduce(&s_nnodes,&r_nnodes,1,MPIU_INT,MPI_SUM,comm);CHKERRMPI(ierr);
     if (size%r_nnodes) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_PLIB,"odd number of nodes np=%D nnodes%D",size,r_nnodes);
     devCount = 0;
     cerr = cudaGetDeviceCount(&devCount);
@@ -159,10 +231,16 @@ static PetscErrorCode PCGAMGCreateLevel_GAMG(PC pc,Mat Amat_fine,PetscInt cr_bs,
   } else { /* reduce active processors - we know that the grid structure can NOT be reused in MatPtAP */
     PetscInt       *counts,*newproc_idx,ii,jj,kk,strideNew,*tidx,ncrs_new,ncrs_eq_new,nloc_old,expand_factor=1,rfactor=1;
     IS             is_eq_newproc,is_eq_num,is_eq_num_prim,new_eq_indices;
+    PetscMPIInt    node_target = rank;
+    PetscBool      in_node = PETSC_FALSE;
     nloc_old = ncrs_eq/cr_bs;
     if (ncrs_eq % cr_bs) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_PLIB,"ncrs_eq %D not divisible by cr_bs %D",ncrs_eq,cr_bs);
+    /* first reduce within the shared memory nodes, unless going to a single process */
+    if (pc_gamg->node_aware_reduction && new_size > 1) {
+      ierr = PCGAMGReduceInNode_Private(pc,comm,nactive,&new_size,&node_target,&in_node);CHKERRQ(ierr);
+    }
     /* get new_size and rfactor */
-    if (pc_gamg->layout_type==PCGAMG_LAYOUT_SPREAD || !pc_gamg->repart) {
+    if (!in_node && (pc_gamg->layout_type==PCGAMG_LAYOUT_SPREAD || !pc_gamg->repart)) {
       /* find factor */
       if (new_size == 1) rfactor = size; /* don't modify */
       else {
@@ -192,7 +270,10 @@ static PetscErrorCode PCGAMGCreateLevel_GAMG(PC pc,Mat Amat_fine,PetscInt cr_bs,
     ierr = PetscLogEventBegin(petsc_gamg_setup_events[SET12],0,0,0,0);CHKERRQ(ierr);
     /* make 'is_eq_newproc' */
     ierr = PetscMalloc1(size, &counts);CHKERRQ(ierr);
-    if (pc_gamg->repart) {
+    if (in_node) { /* move the equations to a process on the same node */
+      ierr = PetscInfo2(pc,"Number of equations (loc) %D moved to process %d on the same node\n",ncrs_eq,node_target);CHKERRQ(ierr);
+      ierr = ISCreateStride(comm, ncrs_eq, node_target, 0, &is_eq_newproc);CHKERRQ(ierr);
+    } else if (pc_gamg->repart) {
       /* Repartition Cmat_{k} and move colums of P^{k}_{k-1} and coordinates of primal part accordingly */
       Mat      adj;
       ierr = PetscInfo4(pc,"Repartition: size (active): %d --> %d, %D local equations, using %s process layout\n",*a_nactive_proc, new_size, ncrs_eq, (pc_gamg->layout_type==PCGAMG_LAYOUT_COMPACT) ? "compact" : "spread");CHKERRQ(ierr);
@@ -454,6 +535,25 @@ static PetscErrorCode PCGAMGCreateLevel_GAMG(PC pc,Mat Amat_fine,PetscInt cr_bs,
   PetscFunctionReturn(0);
 }
 
+/* Sets the options prefix pc_gamg_prolongator_<level>_ of a prolongator and its default options */
+static PetscErrorCode PCGAMGSetProlongatorFromOptions_Private(PC pc, PetscInt level, Mat Prol)
+{
+  PetscErrorCode ierr;
+  const char     *prefix;
+  char           addp[32];
+
+  PetscFunctionBegin;
+  ierr = PCGetOptionsPrefix(pc,&prefix);CHKERRQ(ierr);
+  ierr = MatSetOptionsPrefix(Prol,prefix);CHKERRQ(ierr);
+  ierr = PetscSNPrintf(addp,sizeof(addp),"pc_gamg_prolongator_%d_",(int)level);CHKERRQ(ierr);
+  ierr = MatAppendOptionsPrefix(Prol,addp);CHKERRQ(ierr);
+  /* Always generate the transpose with CUDA
+     Such behaviour can be adapted with -pc_gamg_prolongator_ prefixed options */
+  ierr = MatSetOption(Prol,MAT_FORM_EXPLICIT_TRANSPOSE,PETSC_TRUE);CHKERRQ(ierr);
+  ierr = MatSetFromOptions(Prol);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 PetscErrorCode PCGAMGSquareGraph_GAMG(PC a_pc, Mat Gmat1, Mat* Gmat2)
 {
   PetscErrorCode ierr;
@@ -515,9 +615,19 @@ PetscErrorCode PCSetUp_GAMG(PC pc)
   ierr = MPI_Comm_size(comm,&size);CHKERRMPI(ierr);
 
   if (pc->setupcalled) {
-    if (!pc_gamg->reuse_prol || pc->flag == DIFFERENT_NONZERO_PATTERN) {
+    /* keep the aggregates and only smooth the tentative prolongators again with the new operators */
+    PetscBool refresh = (PetscBool)(pc_gamg->reuse_aggs && !pc_gamg->reuse_prol && pc_gamg->Prol0[1]);
+
+    if (refresh && pc_gamg->recoarsen_factor > 0 && pc_gamg->base_its && pc_gamg->last_its > pc_gamg->recoarsen_factor*pc_gamg->base_its) {
+      ierr = PetscInfo3(pc,"Iterations grew from %D to %D, more than a factor %g, build the aggregates again\n",pc_gamg->base_its,pc_gamg->last_its,(double)pc_gamg->recoarsen_factor);CHKERRQ(ierr);
+      refresh = PETSC_FALSE;
+    }
+    if ((!pc_gamg->reuse_prol && !refresh) || pc->flag == DIFFERENT_NONZERO_PATTERN) {
       /* reset everything */
       ierr = PCReset_MG(pc);CHKERRQ(ierr);
+      for (level=0; level<PETSC_MG_MAXLEVELS; level++) {
+        ierr = MatDestroy(&pc_gamg->Prol0[level]);CHKERRQ(ierr);
+      }
       pc->setupcalled = 0;
     } else {
       PC_MG_Levels **mglevels = mg->levels;
@@ -534,10 +644,24 @@ PetscErrorCode PCSetUp_GAMG(PC pc)
         for (level=pc_gamg->Nlevels-2,gl=0; level>=0; level--,gl++) {
           MatReuse reuse = MAT_INITIAL_MATRIX ;
 
+          if (refresh) {
+            Mat Prol;
+
+            pc_gamg->current_level = gl;
+            ierr = MatDuplicate(pc_gamg->Prol0[gl+1],MAT_COPY_VALUES,&Prol);CHKERRQ(ierr);
+            if (pc_gamg->ops->optprolongator) {
+              ierr = pc_gamg->ops->optprolongator(pc,dB,&Prol);CHKERRQ(ierr);
+            }
+            ierr = PCGAMGSetProlongatorFromOptions_Private(pc,gl,Prol);CHKERRQ(ierr);
+            ierr = PCMGSetInterpolation(pc,level+1,Prol);CHKERRQ(ierr);
+            ierr = PCMGSetRestriction(pc,level+1,Prol);CHKERRQ(ierr);
+            ierr = MatDestroy(&Prol);CHKERRQ(ierr);
+          }
           /* matrix structure can change from repartitioning or process reduction but don't know if we have process reduction here. Should fix */
           ierr = KSPGetOperators(mglevels[level]->smoothd,NULL,&B);CHKERRQ(ierr);
           if (B->product) {
-            if (B->product->A == dB && B->product->B == mglevels[level+1]->interpolate) {
+            /* the new prolongators have the nonzero pattern of the old ones so only the numeric product is redone */
+            if (B->product->A == dB && (refresh || B->product->B == mglevels[level+1]->interpolate)) {
               reuse = MAT_REUSE_MATRIX;
             }
           }
@@ -555,6 +679,7 @@ PetscErrorCode PCSetUp_GAMG(PC pc)
           dB   = B;
         }
       }
+      if (refresh) pc_gamg->nrefresh++;
 
       ierr = PCSetUp_MG(pc);CHKERRQ(ierr);
       PetscFunctionReturn(0);
@@ -615,12 +740,13 @@ PetscErrorCode PCSetUp_GAMG(PC pc)
 
       /* could have failed to create new level */
       if (Prol11) {
-        const char *prefix;
-        char       addp[32];
-
         /* get new block size of coarse matrices */
         ierr = MatGetBlockSizes(Prol11, NULL, &bs);CHKERRQ(ierr);
 
+        if (pc_gamg->reuse_aggs && !pc_gamg->reuse_prol) {
+          ierr = MatDuplicate(Prol11,MAT_COPY_VALUES,&pc_gamg->Prol0[level1]);CHKERRQ(ierr);
+        }
+
         if (pc_gamg->ops->optprolongator) {
           /* smooth */
           ierr = pc_gamg->ops->optprolongator(pc, Aarr[level], &Prol11);CHKERRQ(ierr);
@@ -632,14 +758,7 @@ PetscErrorCode PCSetUp_GAMG(PC pc)
           ierr = PetscCDGetASMBlocks(agg_lists, bs, Gmat, &nASMBlocksArr[level], &ASMLocalIDsArr[level]);CHKERRQ(ierr);
         }
 
-        ierr = PCGetOptionsPrefix(pc,&prefix);CHKERRQ(ierr);
-        ierr = MatSetOptionsPrefix(Prol11,prefix);CHKERRQ(ierr);
-        ierr = PetscSNPrintf(addp,sizeof(addp),"pc_gamg_prolongator_%d_",(int)level);CHKERRQ(ierr);
-        ierr = MatAppendOptionsPrefix(Prol11,addp);CHKERRQ(ierr);
-        /* Always generate the transpose with CUDA
-           Such behaviour can be adapted with -pc_gamg_prolongator_ prefixed options */
-        ierr = MatSetOption(Prol11,MAT_FORM_EXPLICIT_TRANSPOSE,PETSC_TRUE);CHKERRQ(ierr);
-        ierr = MatSetFromOptions(Prol11);CHKERRQ(ierr);
+        ierr = PCGAMGSetProlongatorFromOptions_Private(pc,level,Prol11);CHKERRQ(ierr);
         Parr[level1] = Prol11;
       } else Parr[level1] = NULL; /* failed to coarsen */
 
@@ -660,7 +779,28 @@ PetscErrorCode PCSetUp_GAMG(PC pc)
     if (is_last) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_PLIB,"Is last ?");
     if (N <= pc_gamg->coarse_eq_limit) is_last = PETSC_TRUE;
     if (level1 == pc_gamg->Nlevels-1) is_last = PETSC_TRUE;
-    ierr = pc_gamg->ops->createlevel(pc, Aarr[level], bs, &Parr[level1], &Aarr[level1], &nactivepe, NULL, is_last);CHKERRQ(ierr);
+    if (pc_gamg->Prol0[level1]) {
+      IS colperm;
+
+      ierr = pc_gamg->ops->createlevel(pc, Aarr[level], bs, &Parr[level1], &Aarr[level1], &nactivepe, &colperm, is_last);CHKERRQ(ierr);
+      if (colperm) { /* the coarse equations were moved, move the columns of the tentative prolongator too */
+        IS       findices;
+        PetscInt Istart,Iend,f_bs;
+        Mat      Pnew;
+
+        ierr = MatGetBlockSize(Aarr[level], &f_bs);CHKERRQ(ierr);
+        ierr = MatGetOwnershipRange(pc_gamg->Prol0[level1], &Istart, &Iend);CHKERRQ(ierr);
+        ierr = ISCreateStride(comm,Iend-Istart,Istart,1,&findices);CHKERRQ(ierr);
+        ierr = ISSetBlockSize(findices,f_bs);CHKERRQ(ierr);
+        ierr = MatCreateSubMatrix(pc_gamg->Prol0[level1], findices, colperm, MAT_INITIAL_MATRIX, &Pnew);CHKERRQ(ierr);
+        ierr = ISDestroy(&findices);CHKERRQ(ierr);
+        ierr = ISDestroy(&colperm);CHKERRQ(ierr);
+        ierr = MatDestroy(&pc_gamg->Prol0[level1]);CHKERRQ(ierr);
+        pc_gamg->Prol0[level1] = Pnew;
+      }
+    } else {
+      ierr = pc_gamg->ops->createlevel(pc, Aarr[level], bs, &Parr[level1], &Aarr[level1], &nactivepe, NULL, is_last);CHKERRQ(ierr);
+    }
 
     ierr = PetscLogEventEnd(petsc_gamg_setup_events[SET2],0,0,0,0);CHKERRQ(ierr);
     ierr = MatGetSize(Aarr[level1], &M, &N);CHKERRQ(ierr); /* M is loop test variables */
@@ -679,6 +819,9 @@ PetscErrorCode PCSetUp_GAMG(PC pc)
     }
   } /* levels */
   ierr = PetscFree(pc_gamg->data);CHKERRQ(ierr);
+  pc_gamg->ncoarsen++;
+  pc_gamg->base_its = 0;
+  pc_gamg->last_its = 0;
 
   ierr = PetscInfo2(pc,"%D levels, grid complexity = %g\n",level+1,nnztot/nnz0);CHKERRQ(ierr);
   pc_gamg->Nlevels = level + 1;
@@ -977,6 +1120,50 @@ static PetscErrorCode PCGAMGSetRepartition_GAMG(PC pc, PetscBool n)
   PetscFunctionReturn(0);
 }
 
+/*@
+   PCGAMGSetNodeAwareReduction - Reduce the number of active processes on the coarse grids within the shared memory nodes first
+
+   Collective on PC
+
+   Input Parameters:
++  pc - the preconditioner context
+-  n - PETSC_TRUE or PETSC_FALSE
+
+   Options Database Key:
+.  -pc_gamg_node_aware_reduction <true,false>
+
+   Notes:
+    When GAMG reduces the number of active processes of a coarse grid it moves the equations only between the processes
+    of the same node, found with PetscShmCommGet(), until one process per node is active. Only then the equations move
+    across the nodes, with the simple aggregation of processes or with the repartitioning of PCGAMGSetRepartition().
+    Each node keeps its share of the active processes asked for by PCGAMGSetProcEqLim(), but at least one.
+    This avoids the traffic between the nodes on the finer coarse grids. The reduction to a single process is not changed.
+
+   Level: intermediate
+
+.seealso: PCGAMGSetProcEqLim(), PCGAMGSetRepartition(), PCGAMGSetRankReductionFactors(), PetscShmCommGet()
+@*/
+PetscErrorCode PCGAMGSetNodeAwareReduction(PC pc, PetscBool n)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(pc,PC_CLASSID,1);
+  PetscValidLogicalCollectiveBool(pc,n,2);
+  ierr = PetscTryMethod(pc,"PCGAMGSetNodeAwareReduction_C",(PC,PetscBool),(pc,n));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode PCGAMGSetNodeAwareReduction_GAMG(PC pc, PetscBool n)
+{
+  PC_MG   *mg      = (PC_MG*)pc->data;
+  PC_GAMG *pc_gamg = (PC_GAMG*)mg->innerctx;
+
+  PetscFunctionBegin;
+  pc_gamg->node_aware_reduction = n;
+  PetscFunctionReturn(0);
+}
+
 /*@
    PCGAMGSetEstEigKSPMaxIt - Set number of KSP iterations in eigen estimator (for Cheby)
 
@@ -1172,6 +1359,87 @@ static PetscErrorCode PCGAMGSetReuseInterpolation_GAMG(PC pc, PetscBool n)
   PetscFunctionReturn(0);
 }
 
+/*@
+   PCGAMGSetReuseAggregates - Reuse the aggregates when rebuilding the algebraic multigrid preconditioner, only the prolongators are smoothed again and the coarse operators recomputed
+
+   Collective on PC
+
+   Input Parameters:
++  pc - the preconditioner context
+-  n - PETSC_TRUE or PETSC_FALSE
+
+   Options Database Key:
+.  -pc_gamg_reuse_aggregates <true,false>
+
+   Level: intermediate
+
+   Notes:
+    The graph, the aggregates and the tentative prolongators are only computed again when the nonzero pattern of the matrix changes
+    or when the number of iterations grows by more than the factor set with PCGAMGSetRecoarsenFactor().
+    The smoothed prolongators keep their nonzero pattern, so the Galerkin products only redo their numeric phase.
+    This is cheaper than a full setup but, unlike PCGAMGSetReuseInterpolation(), the prolongators follow the changes of the matrix entries.
+    PCGAMGSetReuseInterpolation() takes precedence.
+
+.seealso: PCGAMGSetRecoarsenFactor(), PCGAMGSetReuseInterpolation()
+@*/
+PetscErrorCode PCGAMGSetReuseAggregates(PC pc, PetscBool n)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(pc,PC_CLASSID,1);
+  PetscValidLogicalCollectiveBool(pc,n,2);
+  ierr = PetscTryMethod(pc,"PCGAMGSetReuseAggregates_C",(PC,PetscBool),(pc,n));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode PCGAMGSetReuseAggregates_GAMG(PC pc, PetscBool n)
+{
+  PC_MG   *mg      = (PC_MG*)pc->data;
+  PC_GAMG *pc_gamg = (PC_GAMG*)mg->innerctx;
+
+  PetscFunctionBegin;
+  pc_gamg->reuse_aggs = n;
+  PetscFunctionReturn(0);
+}
+
+/*@
+   PCGAMGSetRecoarsenFactor - Set the growth of the number of iterations that makes GAMG build the aggregates again when they are reused
+
+   Logically Collective on PC
+
+   Input Parameters:
++  pc - the preconditioner context
+-  factor - the aggregates are built again at the next setup once a solve takes more than factor times the iterations of the first solve with them, 0 to never build them again
+
+   Options Database Key:
+.  -pc_gamg_recoarsen_factor <factor, default=2>
+
+   Level: intermediate
+
+.seealso: PCGAMGSetReuseAggregates()
+@*/
+PetscErrorCode PCGAMGSetRecoarsenFactor(PC pc, PetscReal factor)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(pc,PC_CLASSID,1);
+  PetscValidLogicalCollectiveReal(pc,factor,2);
+  ierr = PetscTryMethod(pc,"PCGAMGSetRecoarsenFactor_C",(PC,PetscReal),(pc,factor));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode PCGAMGSetRecoarsenFactor_GAMG(PC pc, PetscReal factor)
+{
+  PC_MG   *mg      = (PC_MG*)pc->data;
+  PC_GAMG *pc_gamg = (PC_GAMG*)mg->innerctx;
+
+  PetscFunctionBegin;
+  pc_gamg->recoarsen_factor = factor;
+  PetscFunctionReturn(0);
+}
+
 /*@
    PCGAMGASMSetUseAggs - Have the PCGAMG smoother on each level use the aggregates defined by the coarsening process as the subdomains for the additive Schwarz preconditioner.
 
@@ -1622,6 +1890,12 @@ static PetscErrorCode PCView_GAMG(PC pc,PetscViewer viewer)
   if (pc_gamg->use_aggs_in_asm) {
     ierr = PetscViewerASCIIPrintf(viewer,"      Using aggregates from coarsening process to define subdomains for PCASM\n");CHKERRQ(ierr);
   }
+  if (pc_gamg->reuse_aggs && !pc_gamg->reuse_prol) {
+    ierr = PetscViewerASCIIPrintf(viewer,"      Reusing the aggregates until the iterations grow by a factor %g: aggregated %D times, reused %D times\n",(double)pc_gamg->recoarsen_factor,pc_gamg->ncoarsen,pc_gamg->nrefresh);CHKERRQ(ierr);
+  }
+  if (pc_gamg->node_aware_reduction) {
+    ierr = PetscViewerASCIIPrintf(viewer,"      Reducing the active processes within the shared memory nodes first\n");CHKERRQ(ierr);
+  }
   if (pc_gamg->use_parallel_coarse_grid_solver) {
     ierr = PetscViewerASCIIPrintf(viewer,"      Using parallel coarse grid solver (all coarse grid equations not put on one process)\n");CHKERRQ(ierr);
   }
@@ -1666,10 +1940,13 @@ PetscErrorCode PCSetFromOptions_GAMG(PetscOptionItems *PetscOptionsObject,PC pc)
     ierr = PCGAMGSetEstEigKSPType(pc,tname);CHKERRQ(ierr);
   }
   ierr = PetscOptionsBool("-pc_gamg_repartition","Repartion coarse grids","PCGAMGSetRepartition",pc_gamg->repart,&pc_gamg->repart,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsBool("-pc_gamg_node_aware_reduction","Reduce the active processes within the shared memory nodes first","PCGAMGSetNodeAwareReduction",pc_gamg->node_aware_reduction,&pc_gamg->node_aware_reduction,NULL);CHKERRQ(ierr);
   f2 = PETSC_TRUE;
   ierr = PetscOptionsBool("-pc_gamg_use_sa_esteig","Use eigen estimate from Smoothed aggregation for smoother","PCGAMGSetUseSAEstEig",f2,&f2,&flag);CHKERRQ(ierr);
   if (flag) pc_gamg->use_sa_esteig = f2 ? 1 : 0;
   ierr = PetscOptionsBool("-pc_gamg_reuse_interpolation","Reuse prolongation operator","PCGAMGReuseInterpolation",pc_gamg->reuse_prol,&pc_gamg->reuse_prol,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsBool("-pc_gamg_reuse_aggregates","Reuse the aggregates and smooth the prolongators again","PCGAMGSetReuseAggregates",pc_gamg->reuse_aggs,&pc_gamg->reuse_aggs,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsReal("-pc_gamg_recoarsen_factor","Build the aggregates again when the iterations grow by this factor","PCGAMGSetRecoarsenFactor",pc_gamg->recoarsen_factor,&pc_gamg->recoarsen_factor,NULL);CHKERRQ(ierr);
   ierr = PetscOptionsBool("-pc_gamg_asm_use_agg","Use aggregation aggregates for ASM smoother","PCGAMGASMSetUseAggs",pc_gamg->use_aggs_in_asm,&pc_gamg->use_aggs_in_asm,NULL);CHKERRQ(ierr);
   ierr = PetscOptionsBool("-pc_gamg_use_parallel_coarse_grid_solver","Use parallel coarse grid solver (otherwise put last grid on one process)","PCGAMGSetUseParallelCoarseGridSolve",pc_gamg->use_parallel_coarse_grid_solver,&pc_gamg->use_parallel_coarse_grid_solver,NULL);CHKERRQ(ierr);
   ierr = PetscOptionsBool("-pc_gamg_cpu_pin_coarse_grids","Pin coarse grids to the CPU","PCGAMGSetCpuPinCoarseGrids",pc_gamg->cpu_pin_coarse_grids,&pc_gamg->cpu_pin_coarse_grids,NULL);CHKERRQ(ierr);
@@ -1717,9 +1994,12 @@ PetscErrorCode PCSetFromOptions_GAMG(PetscOptionItems *PetscOptionsObject,PC pc)
 +   -pc_gamg_type <type> - one of agg, geo, or classical
 .   -pc_gamg_repartition  <true,default=false> - repartition the degrees of freedom accross the coarse grids as they are determined
 .   -pc_gamg_reuse_interpolation <true,default=false> - when rebuilding the algebraic multigrid preconditioner reuse the previously computed interpolations
+.   -pc_gamg_reuse_aggregates <true,default=false> - when rebuilding the algebraic multigrid preconditioner reuse the aggregates and only smooth the interpolations again
+.   -pc_gamg_recoarsen_factor <factor,default=2> - with -pc_gamg_reuse_aggregates build the aggregates again once the iterations grow by more than this factor
 .   -pc_gamg_asm_use_agg <true,default=false> - use the aggregates from the coasening process to defined the subdomains on each level for the PCASM smoother
 .   -pc_gamg_process_eq_limit <limit, default=50> - GAMG will reduce the number of MPI processes used directly on the coarse grids so that there are around <limit>
                                         equations on each process that has degrees of freedom
+.   -pc_gamg_node_aware_reduction <true,default=false> - reduce the number of MPI processes within the shared memory nodes before reducing across the nodes
 .   -pc_gamg_coarse_eq_limit <limit, default=50> - Set maximum number of equations on coarsest grid to aim for.
 .   -pc_gamg_threshold[] <thresh,default=0> - Before aggregating the graph GAMG will remove small values from the graph on each level
 -   -pc_gamg_threshold_scale <scale,default=1> - Scaling of threshold on each coarser grid if not specified
@@ -1745,7 +2025,8 @@ PetscErrorCode PCSetFromOptions_GAMG(PetscOptionItems *PetscOptionsObject,PC pc)
   Level: intermediate
 
 .seealso:  PCCreate(), PCSetType(), MatSetBlockSize(), PCMGType, PCSetCoordinates(), MatSetNearNullSpace(), PCGAMGSetType(), PCGAMGAGG, PCGAMGGEO, PCGAMGCLASSICAL, PCGAMGSetProcEqLim(),
-           PCGAMGSetCoarseEqLim(), PCGAMGSetRepartition(), PCGAMGRegister(), PCGAMGSetReuseInterpolation(), PCGAMGASMSetUseAggs(), PCGAMGSetUseParallelCoarseGridSolve(), PCGAMGSetNlevels(), PCGAMGSetThreshold(), PCGAMGGetType(), PCGAMGSetReuseInterpolation(), PCGAMGSetUseSAEstEig(), PCGAMGSetEstEigKSPMaxIt(), PCGAMGSetEstEigKSPType()
+           PCGAMGSetCoarseEqLim(), PCGAMGSetRepartition(), PCGAMGRegister(), PCGAMGSetReuseInterpolation(), PCGAMGASMSetUseAggs(), PCGAMGSetUseParallelCoarseGridSolve(), PCGAMGSetNlevels(), PCGAMGSetThreshold(), PCGAMGGetType(), PCGAMGSetReuseInterpolation(), PCGAMGSetUseSAEstEig(), PCGAMGSetEstEigKSPMaxIt(), PCGAMGSetEstEigKSPType(),
+           PCGAMGSetReuseAggregates(), PCGAMGSetRecoarsenFactor(), PCGAMGSetNodeAwareReduction()
 M*/
 
 PETSC_EXTERN PetscErrorCode PCCreate_GAMG(PC pc)
@@ -1779,6 +2060,7 @@ PETSC_EXTERN PetscErrorCode PCCreate_GAMG(PC pc)
   pc->ops->setup          = PCSetUp_GAMG;
   pc->ops->reset          = PCReset_GAMG;
   pc->ops->destroy        = PCDestroy_GAMG;
+  pc->ops->postsolve      = PCPostSolve_GAMG;
   mg->view                = PCView_GAMG;
 
   ierr = PetscObjectComposeFunction((PetscObject)pc,"PCMGGetLevels_C",PCMGGetLevels_MG);CHKERRQ(ierr);
@@ -1786,11 +2068,14 @@ PETSC_EXTERN PetscErrorCode PCCreate_GAMG(PC pc)
   ierr = PetscObjectComposeFunction((PetscObject)pc,"PCGAMGSetProcEqLim_C",PCGAMGSetProcEqLim_GAMG);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)pc,"PCGAMGSetCoarseEqLim_C",PCGAMGSetCoarseEqLim_GAMG);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)pc,"PCGAMGSetRepartition_C",PCGAMGSetRepartition_GAMG);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)pc,"PCGAMGSetNodeAwareReduction_C",PCGAMGSetNodeAwareReduction_GAMG);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)pc,"PCGAMGSetEstEigKSPType_C",PCGAMGSetEstEigKSPType_GAMG);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)pc,"PCGAMGSetEstEigKSPMaxIt_C",PCGAMGSetEstEigKSPMaxIt_GAMG);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)pc,"PCGAMGSetEigenvalues_C",PCGAMGSetEigenvalues_GAMG);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)pc,"PCGAMGSetUseSAEstEig_C",PCGAMGSetUseSAEstEig_GAMG);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)pc,"PCGAMGSetReuseInterpolation_C",PCGAMGSetReuseInterpolation_GAMG);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)pc,"PCGAMGSetReuseAggregates_C",PCGAMGSetReuseAggregates_GAMG);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)pc,"PCGAMGSetRecoarsenFactor_C",PCGAMGSetRecoarsenFactor_GAMG);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)pc,"PCGAMGASMSetUseAggs_C",PCGAMGASMSetUseAggs_GAMG);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)pc,"PCGAMGSetUseParallelCoarseGridSolve_C",PCGAMGSetUseParallelCoarseGridSolve_GAMG);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)pc,"PCGAMGSetCpuPinCoarseGrids_C",PCGAMGSetCpuPinCoarseGrids_GAMG);CHKERRQ(ierr);
@@ -1802,7 +2087,10 @@ PETSC_EXTERN PetscErrorCode PCCreate_GAMG(PC pc)
   ierr = PetscObjectComposeFunction((PetscObject)pc,"PCGAMGGetType_C",PCGAMGGetType_GAMG);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)pc,"PCGAMGSetNlevels_C",PCGAMGSetNlevels_GAMG);CHKERRQ(ierr);
   pc_gamg->repart           = PETSC_FALSE;
+  pc_gamg->node_aware_reduction = PETSC_FALSE;
   pc_gamg->reuse_prol       = PETSC_FALSE;
+  pc_gamg->reuse_aggs       = PETSC_FALSE;
+  pc_gamg->recoarsen_factor = 2.0;
   pc_gamg->use_aggs_in_asm  = PETSC_FALSE;
   pc_gamg->use_parallel_coarse_grid_solver = PETSC_FALSE;
   pc_gamg->cpu_pin_coarse_grids = PETSC_FALSE;
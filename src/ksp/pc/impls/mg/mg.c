@@ -711,6 +711,7 @@ PetscErrorCode PCSetFromOptions_MG(PetscOptionItems *PetscOptionsObject,PC pc)
   flg2 = PETSC_FALSE;
   ierr = PetscOptionsBool("-pc_mg_adapt_cr","Monitor coarse space quality using Compatible Relaxation (CR)","PCMGSetAdaptCR",PETSC_FALSE,&flg2,&flg);CHKERRQ(ierr);
   if (flg) {ierr = PCMGSetAdaptCR(pc, flg2);CHKERRQ(ierr);}
+  ierr = PetscOptionsBool("-pc_mg_esteig_reuse","Reuse the eigenvalue estimates of the Chebyshev smoothers while they are valid","PCMGSetEstEigReuse",mg->estEigReuse,&mg->estEigReuse,NULL);CHKERRQ(ierr);
   flg = PETSC_FALSE;
   ierr = PetscOptionsBool("-pc_mg_distinct_smoothup","Create separate smoothup KSP and append the prefix _up","PCMGSetDistinctSmoothUp",PETSC_FALSE,&flg,NULL);CHKERRQ(ierr);
   if (flg) {
@@ -809,6 +810,9 @@ PetscErrorCode PCView_MG(PC pc,PetscViewer viewer)
     } else {
       ierr = PetscViewerASCIIPrintf(viewer,"    Not using Galerkin computed coarse grid matrices\n");CHKERRQ(ierr);
     }
+    if (mg->estEigReuse) {
+      ierr = PetscViewerASCIIPrintf(viewer,"    Reusing the eigenvalue estimates of the Chebyshev smoothers while they are valid\n");CHKERRQ(ierr);
+    }
     if (mg->view){
       ierr = (*mg->view)(pc,viewer);CHKERRQ(ierr);
     }
@@ -1195,6 +1199,16 @@ PetscErrorCode PCSetUp_MG(PC pc)
     }
   }
 
+  if (mg->estEigReuse) {
+    /* nothing happens for smoothers that are not Chebyshev */
+    for (i=1; i<n; i++) {
+      ierr = KSPChebyshevEstEigSetReuse(mglevels[i]->smoothd,PETSC_TRUE,PETSC_DEFAULT);CHKERRQ(ierr);
+      if (mglevels[i]->smoothu && mglevels[i]->smoothu != mglevels[i]->smoothd) {
+        ierr = KSPChebyshevEstEigSetReuse(mglevels[i]->smoothu,PETSC_TRUE,PETSC_DEFAULT);CHKERRQ(ierr);
+      }
+    }
+  }
+
   for (i=1; i<n; i++) {
     if (mglevels[i]->smoothu == mglevels[i]->smoothd || mg->am == PC_MG_FULL || mg->am == PC_MG_KASKADE || mg->cyclesperpcapply > 1){
       /* if doing only down then initial guess is zero */
@@ -1665,6 +1679,65 @@ PetscErrorCode PCMGGetAdaptCR(PC pc, PetscBool *cr)
   PetscFunctionReturn(0);
 }
 
+/*@
+   PCMGSetEstEigReuse - Reuse the eigenvalue estimates of the Chebyshev smoothers when the operators change, as long as
+   a Rayleigh quotient check shows that they are still valid
+
+   Logically Collective on PC
+
+   Input Parameters:
++  pc - the multigrid context
+-  reuse - PETSC_TRUE to reuse the estimates
+
+   Options Database Key:
+.  -pc_mg_esteig_reuse <true,false> - reuse the estimates while they are valid
+
+   Level: intermediate
+
+   Notes:
+   Each PCSetUp() with changed operators otherwise estimates the eigenvalues again on every level. This calls
+   KSPChebyshevEstEigSetReuse() on the smoothers of all levels but the coarsest one, the tolerance of the check is set
+   with -mg_levels_ksp_chebyshev_esteig_reuse_rtol.
+
+.seealso: PCMGGetEstEigReuse(), KSPChebyshevEstEigSetReuse()
+@*/
+PetscErrorCode PCMGSetEstEigReuse(PC pc,PetscBool reuse)
+{
+  PC_MG *mg = (PC_MG*)pc->data;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(pc,PC_CLASSID,1);
+  PetscValidLogicalCollectiveBool(pc,reuse,2);
+  mg->estEigReuse = reuse;
+  PetscFunctionReturn(0);
+}
+
+/*@
+   PCMGGetEstEigReuse - Tells if the eigenvalue estimates of the Chebyshev smoothers are reused while they are valid
+
+   Not Collective
+
+   Input Parameter:
+.  pc - the multigrid context
+
+   Output Parameter:
+.  reuse - PETSC_TRUE if the estimates are reused
+
+   Level: intermediate
+
+.seealso: PCMGSetEstEigReuse()
+@*/
+PetscErrorCode PCMGGetEstEigReuse(PC pc,PetscBool *reuse)
+{
+  PC_MG *mg = (PC_MG*)pc->data;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(pc,PC_CLASSID,1);
+  PetscValidBoolPointer(reuse,2);
+  *reuse = mg->estEigReuse;
+  PetscFunctionReturn(0);
+}
+
 /*@
    PCMGSetNumberSmooth - Sets the number of pre and post-smoothing steps to use
    on all levels.  Use PCMGDistinctSmoothUp() to create separate up and down smoothers if you want different numbers of
@@ -1875,6 +1948,7 @@ PetscErrorCode PCMGGetCoarseSpaceConstructor(const char name[], PetscErrorCode (
 .  -pc_mg_cycle_type <v,w> - provide the cycle desired
 .  -pc_mg_type <additive,multiplicative,full,kaskade> - multiplicative is the default
 .  -pc_mg_log - log information about time spent on each level of the solver
+.  -pc_mg_esteig_reuse - reuse the eigenvalue estimates of the Chebyshev smoothers while a Rayleigh quotient check shows they are valid
 .  -pc_mg_distinct_smoothup - configure up (after interpolation) and down (before restriction) smoothers separately (with different options prefixes)
 .  -pc_mg_galerkin <both,pmat,mat,none> - use Galerkin process to compute coarser operators, i.e. Acoarse = R A R'
 .  -pc_mg_multiplicative_cycles - number of cycles to use as the preconditioner (defaults to 1)
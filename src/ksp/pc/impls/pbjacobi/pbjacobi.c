@@ -5,6 +5,7 @@
 */
 
 #include <petsc/private/pcimpl.h>   /*I "petscpc.h" I*/
+#include <petsc/private/kernels/blockinvert.h>
 
 /*
    Private context (data structure) for the PBJacobi preconditioner.
@@ -12,6 +13,8 @@
 typedef struct {
   const MatScalar *diag;
   PetscInt        bs,mbs;
+  PetscBool       batched;  /* invert and apply the blocks in batches of PETSC_KERNEL_BATCH_SIZE interleaved blocks */
+  MatScalar       *bdiag;   /* the interleaved inverses of the blocks, owned by the PC */
 } PC_PBJacobi;
 
 
@@ -249,6 +252,108 @@ static PetscErrorCode PCApplyTranspose_PBJacobi_N(PC pc,Vec x,Vec y)
   PetscFunctionReturn(0);
 }
 
+/*
+   Applies the interleaved inverses of a batch of blocks, the loops over the blocks of the batch are vectorized.
+   Entry (i,j) of the inverse of block l of batch g is bdiag[(g*bs*bs+i+j*bs)*PETSC_KERNEL_BATCH_SIZE+l]
+*/
+static PetscErrorCode PCApplyBatched_PBJacobi_Private(PC pc,Vec x,Vec y,PetscBool transpose)
+{
+  PC_PBJacobi       *jac = (PC_PBJacobi*)pc->data;
+  PetscErrorCode    ierr;
+  const PetscInt    nb = PETSC_KERNEL_BATCH_SIZE,m = jac->mbs,bs = jac->bs,bs2 = bs*bs;
+  PetscInt          g,i,j,l,nl;
+  const MatScalar   *d,*dij;
+  const PetscScalar *xx,*xg;
+  PetscScalar       *yy,*yg,sum[PETSC_KERNEL_BATCH_SIZE];
+
+  PetscFunctionBegin;
+  ierr = VecGetArrayRead(x,&xx);CHKERRQ(ierr);
+  ierr = VecGetArray(y,&yy);CHKERRQ(ierr);
+  for (g=0; g<m; g+=nb) {
+    nl = PetscMin(nb,m-g);
+    d  = jac->bdiag + g*bs2;
+    xg = xx + g*bs;
+    yg = yy + g*bs;
+    for (i=0; i<bs; i++) {
+      for (l=0; l<nb; l++) sum[l] = 0.0;
+      for (j=0; j<bs; j++) {
+        dij = transpose ? d + (j+i*bs)*nb : d + (i+j*bs)*nb;
+        PetscPragmaSIMD
+        for (l=0; l<nl; l++) sum[l] += dij[l]*xg[l*bs+j];
+      }
+      for (l=0; l<nl; l++) yg[l*bs+i] = sum[l];
+    }
+  }
+  ierr = VecRestoreArrayRead(x,&xx);CHKERRQ(ierr);
+  ierr = VecRestoreArray(y,&yy);CHKERRQ(ierr);
+  ierr = PetscLogFlops((2.0*bs2-bs)*m);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode PCApply_PBJacobi_Batched(PC pc,Vec x,Vec y)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PCApplyBatched_PBJacobi_Private(pc,x,y,PETSC_FALSE);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode PCApplyTranspose_PBJacobi_Batched(PC pc,Vec x,Vec y)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PCApplyBatched_PBJacobi_Private(pc,x,y,PETSC_TRUE);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+   Gathers the diagonal blocks of the matrix interleaved in batches of PETSC_KERNEL_BATCH_SIZE blocks, the unused
+   blocks of the last batch are set to the identity, and inverts them one batch at a time
+*/
+static PetscErrorCode PCSetUpBatched_PBJacobi_Private(PC pc)
+{
+  PC_PBJacobi    *jac = (PC_PBJacobi*)pc->data;
+  PetscErrorCode ierr;
+  Mat            A = pc->pmat;
+  const PetscInt nb = PETSC_KERNEL_BATCH_SIZE,m = jac->mbs,bs = jac->bs,bs2 = bs*bs;
+  PetscInt       g,i,j,k,l,rstart,*idx,*pivots;
+  MatScalar      *d,*work;
+  PetscScalar    *v;
+  PetscBool      allowzeropivot,zeropivotdetected;
+
+  PetscFunctionBegin;
+  allowzeropivot = PetscNot(pc->erroriffailure);
+  ierr = PetscFree(jac->bdiag);CHKERRQ(ierr);
+  ierr = PetscMalloc1(((m+nb-1)/nb)*nb*bs2,&jac->bdiag);CHKERRQ(ierr);
+  ierr = PetscMalloc4(bs,&idx,bs,&pivots,bs2,&v,(nb+1)*bs2+bs,&work);CHKERRQ(ierr);
+  ierr = MatGetOwnershipRange(A,&rstart,NULL);CHKERRQ(ierr);
+  for (g=0; g<m; g+=nb) {
+    d = jac->bdiag + g*bs2;
+    for (l=0; l<nb; l++) {
+      if (g+l < m) {
+        for (k=0; k<bs; k++) idx[k] = rstart + (g+l)*bs + k;
+        ierr = MatGetValues(A,bs,idx,bs,idx,v);CHKERRQ(ierr);
+        for (i=0; i<bs; i++) {
+          for (j=0; j<bs; j++) d[(i+j*bs)*nb+l] = v[i*bs+j];
+        }
+      } else {
+        for (i=0; i<bs; i++) {
+          for (j=0; j<bs; j++) d[(i+j*bs)*nb+l] = (i == j) ? 1.0 : 0.0;
+        }
+      }
+    }
+    ierr = PetscKernel_A_gets_inverse_A_Batch(bs,d,pivots,work,allowzeropivot,&zeropivotdetected);CHKERRQ(ierr);
+    if (zeropivotdetected) pc->failedreason = PC_FACTOR_NUMERIC_ZEROPIVOT;
+  }
+  ierr = PetscFree4(idx,pivots,v,work);CHKERRQ(ierr);
+  ierr = PetscLogFlops(2.0*bs*bs2*m);CHKERRQ(ierr);
+  pc->ops->apply          = PCApply_PBJacobi_Batched;
+  pc->ops->applytranspose = PCApplyTranspose_PBJacobi_Batched;
+  PetscFunctionReturn(0);
+}
+
 /* -------------------------------------------------------------------------- */
 static PetscErrorCode PCSetUp_PBJacobi(PC pc)
 {
@@ -257,15 +362,25 @@ static PetscErrorCode PCSetUp_PBJacobi(PC pc)
   Mat            A = pc->pmat;
   MatFactorError err;
   PetscInt       nlocal;
+  PetscBool      getvalues;
 
   PetscFunctionBegin;
-  ierr = MatInvertBlockDiagonal(A,&jac->diag);CHKERRQ(ierr);
-  ierr = MatFactorGetError(A,&err);CHKERRQ(ierr);
-  if (err) pc->failedreason = (PCFailedReason)err;
-
   ierr = MatGetBlockSize(A,&jac->bs);CHKERRQ(ierr);
   ierr = MatGetLocalSize(A,&nlocal,NULL);CHKERRQ(ierr);
   jac->mbs = nlocal/jac->bs;
+  ierr = MatHasOperation(A,MATOP_GET_VALUES,&getvalues);CHKERRQ(ierr);
+  if (jac->batched && !getvalues) {
+    ierr = PetscInfo1(pc,"Matrix type %s cannot provide its diagonal blocks, they are not batched\n",((PetscObject)A)->type_name);CHKERRQ(ierr);
+    jac->batched = PETSC_FALSE;
+  }
+  if (jac->batched && jac->bs > 1) {
+    ierr = PCSetUpBatched_PBJacobi_Private(pc);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+
+  ierr = MatInvertBlockDiagonal(A,&jac->diag);CHKERRQ(ierr);
+  ierr = MatFactorGetError(A,&err);CHKERRQ(ierr);
+  if (err) pc->failedreason = (PCFailedReason)err;
   switch (jac->bs) {
   case 1:
     pc->ops->apply = PCApply_PBJacobi_1;
@@ -298,16 +413,30 @@ static PetscErrorCode PCSetUp_PBJacobi(PC pc)
 /* -------------------------------------------------------------------------- */
 static PetscErrorCode PCDestroy_PBJacobi(PC pc)
 {
+  PC_PBJacobi    *jac = (PC_PBJacobi*)pc->data;
   PetscErrorCode ierr;
 
   PetscFunctionBegin;
   /*
       Free the private data structure that was hanging off the PC
   */
+  ierr = PetscFree(jac->bdiag);CHKERRQ(ierr);
   ierr = PetscFree(pc->data);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
+static PetscErrorCode PCSetFromOptions_PBJacobi(PetscOptionItems *PetscOptionsObject,PC pc)
+{
+  PC_PBJacobi    *jac = (PC_PBJacobi*)pc->data;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscOptionsHead(PetscOptionsObject,"Point-block Jacobi options");CHKERRQ(ierr);
+  ierr = PetscOptionsBool("-pc_pbjacobi_batched","Invert and apply the blocks in batches of interleaved blocks","None",jac->batched,&jac->batched,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsTail();CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 static PetscErrorCode PCView_PBJacobi(PC pc,PetscViewer viewer)
 {
   PetscErrorCode ierr;
@@ -318,6 +447,9 @@ static PetscErrorCode PCView_PBJacobi(PC pc,PetscViewer viewer)
   ierr = PetscObjectTypeCompare((PetscObject)viewer,PETSCVIEWERASCII,&iascii);CHKERRQ(ierr);
   if (iascii) {
     ierr = PetscViewerASCIIPrintf(viewer,"  point-block size %D\n",jac->bs);CHKERRQ(ierr);
+    if (jac->batched && jac->bs > 1) {
+      ierr = PetscViewerASCIIPrintf(viewer,"  blocks inverted and applied in batches of %d interleaved blocks\n",PETSC_KERNEL_BATCH_SIZE);CHKERRQ(ierr);
+    }
   }
   PetscFunctionReturn(0);
 }
@@ -335,6 +467,13 @@ static PetscErrorCode PCView_PBJacobi(PC pc,PetscViewer viewer)
    Uses dense LU factorization with partial pivoting to invert the blocks; if a zero pivot
    is detected a PETSc error is generated.
 
+   With -pc_pbjacobi_batched the blocks are stored interleaved in batches of PETSC_KERNEL_BATCH_SIZE
+   blocks and inverted with Gauss-Jordan elimination and applied vectorized over the blocks of a batch.
+   Only the blocks with a small pivot are inverted with partial pivoting.
+
+   Options Database Keys:
+.  -pc_pbjacobi_batched - invert and apply the blocks in batches of interleaved blocks
+
    Developer Notes:
     This should support the PCSetErrorIfFailure() flag set to PETSC_TRUE to allow
    the factorization to continue even after a zero pivot is found resulting in a Nan and hence
@@ -381,7 +520,7 @@ PETSC_EXTERN PetscErrorCode PCCreate_PBJacobi(PC pc)
   pc->ops->applytranspose      = NULL;
   pc->ops->setup               = PCSetUp_PBJacobi;
   pc->ops->destroy             = PCDestroy_PBJacobi;
-  pc->ops->setfromoptions      = NULL;
+  pc->ops->setfromoptions      = PCSetFromOptions_PBJacobi;
   pc->ops->view                = PCView_PBJacobi;
   pc->ops->applyrichardson     = NULL;
   pc->ops->applysymmetricleft  = NULL;
@@ -9,17 +9,48 @@ typedef struct {
   MatSORType sym;         /* forward, reverse, symmetric etc. */
   PetscReal  omega;
   PetscReal  fshift;
+  PetscBool  multicolor;  /* sweep the rows color by color, with MAT_SOR_MULTICOLOR */
+  Mat        mcmat;       /* the matrix on which this PC set MAT_SOR_MULTICOLOR, cleared again in PCReset_SOR() */
 } PC_SOR;
 
+static PetscErrorCode PCReset_SOR(PC pc)
+{
+  PC_SOR         *jac = (PC_SOR*)pc->data;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (jac->mcmat) {ierr = MatSetOption(jac->mcmat,MAT_SOR_MULTICOLOR,PETSC_FALSE);CHKERRQ(ierr);}
+  ierr = MatDestroy(&jac->mcmat);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 static PetscErrorCode PCDestroy_SOR(PC pc)
 {
   PetscErrorCode ierr;
 
   PetscFunctionBegin;
+  ierr = PCReset_SOR(pc);CHKERRQ(ierr);
   ierr = PetscFree(pc->data);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
+static PetscErrorCode PCSetUp_SOR(PC pc)
+{
+  PC_SOR         *jac = (PC_SOR*)pc->data;
+  PetscBool      isaij;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (jac->mcmat && (!jac->multicolor || jac->mcmat != pc->pmat)) {ierr = PCReset_SOR(pc);CHKERRQ(ierr);}
+  if (!jac->multicolor || jac->mcmat) PetscFunctionReturn(0);
+  ierr = PetscObjectBaseTypeCompareAny((PetscObject)pc->pmat,&isaij,MATSEQAIJ,MATMPIAIJ,"");CHKERRQ(ierr);
+  if (!isaij) SETERRQ1(PetscObjectComm((PetscObject)pc),PETSC_ERR_SUP,"Multicolor SOR requires an AIJ matrix, not %s",((PetscObject)pc->pmat)->type_name);
+  ierr = MatSetOption(pc->pmat,MAT_SOR_MULTICOLOR,PETSC_TRUE);CHKERRQ(ierr);
+  ierr = PetscObjectReference((PetscObject)pc->pmat);CHKERRQ(ierr);
+  jac->mcmat = pc->pmat;
+  PetscFunctionReturn(0);
+}
+
 static PetscErrorCode PCApply_SOR(PC pc,Vec x,Vec y)
 {
   PC_SOR         *jac = (PC_SOR*)pc->data;
@@ -75,6 +106,7 @@ PetscErrorCode PCSetFromOptions_SOR(PetscOptionItems *PetscOptionsObject,PC pc)
   ierr = PetscOptionsReal("-pc_sor_diagonal_shift","Add to the diagonal entries","",jac->fshift,&jac->fshift,NULL);CHKERRQ(ierr);
   ierr = PetscOptionsInt("-pc_sor_its","number of inner SOR iterations","PCSORSetIterations",jac->its,&jac->its,NULL);CHKERRQ(ierr);
   ierr = PetscOptionsInt("-pc_sor_lits","number of local inner SOR iterations","PCSORSetIterations",jac->lits,&jac->lits,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsBool("-pc_sor_multicolor","relax the rows color by color in parallel","PCSORSetMulticolor",jac->multicolor,&jac->multicolor,NULL);CHKERRQ(ierr);
   ierr = PetscOptionsBoolGroupBegin("-pc_sor_symmetric","SSOR, not SOR","PCSORSetSymmetric",&flg);CHKERRQ(ierr);
   if (flg) {ierr = PCSORSetSymmetric(pc,SOR_SYMMETRIC_SWEEP);CHKERRQ(ierr);}
   ierr = PetscOptionsBoolGroup("-pc_sor_backward","use backward sweep instead of forward","PCSORSetSymmetric",&flg);CHKERRQ(ierr);
@@ -114,6 +146,7 @@ PetscErrorCode PCView_SOR(PC pc,PetscViewer viewer)
     else if (sym & SOR_LOCAL_BACKWARD_SWEEP)                                 sortype = "local_backward";
     else                                                                     sortype = "unknown";
     ierr = PetscViewerASCIIPrintf(viewer,"  type = %s, iterations = %D, local iterations = %D, omega = %g\n",sortype,jac->its,jac->lits,(double)jac->omega);CHKERRQ(ierr);
+    if (jac->multicolor) {ierr = PetscViewerASCIIPrintf(viewer,"  multicolor ordering of the rows\n");CHKERRQ(ierr);}
   }
   PetscFunctionReturn(0);
 }
@@ -149,6 +182,26 @@ static PetscErrorCode  PCSORSetIterations_SOR(PC pc,PetscInt its,PetscInt lits)
   PetscFunctionReturn(0);
 }
 
+static PetscErrorCode  PCSORSetMulticolor_SOR(PC pc,PetscBool flg)
+{
+  PC_SOR         *jac = (PC_SOR*)pc->data;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  jac->multicolor = flg;
+  if (!flg) {ierr = PCReset_SOR(pc);CHKERRQ(ierr);}
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode  PCSORGetMulticolor_SOR(PC pc,PetscBool *flg)
+{
+  PC_SOR *jac = (PC_SOR*)pc->data;
+
+  PetscFunctionBegin;
+  *flg = jac->multicolor;
+  PetscFunctionReturn(0);
+}
+
 static PetscErrorCode  PCSORGetSymmetric_SOR(PC pc,MatSORType *flag)
 {
   PC_SOR *jac = (PC_SOR*)pc->data;
@@ -398,6 +451,69 @@ PetscErrorCode  PCSORSetIterations(PC pc,PetscInt its,PetscInt lits)
   PetscFunctionReturn(0);
 }
 
+/*@
+   PCSORSetMulticolor - Sets the SOR preconditioner to relax the rows color by color, with the rows of each color
+   relaxed in parallel by OpenMP threads.
+
+   Logically Collective on PC
+
+   Input Parameters:
++  pc - the preconditioner context
+-  flg - PETSC_TRUE to use the multicolor ordering
+
+   Options Database Key:
+.  -pc_sor_multicolor - Activates the multicolor ordering
+
+   Level: intermediate
+
+   Notes:
+   The rows (of the diagonal block in parallel) are colored once with MatColoring, so that the rows of one color are
+   not coupled. The type of coloring can be set with -mat_coloring_type, the default is greedy. A forward sweep
+   relaxes the colors in increasing order and a backward sweep in decreasing order. The multicolor ordering usually
+   smooths a little less per sweep than the natural ordering, but each sweep is parallel.
+
+   Only implemented for AIJ matrices, it sets the MAT_SOR_MULTICOLOR option of the matrix; the option is cleared again
+   when the PC is reset or destroyed, or when a different matrix is provided.
+
+.seealso: PCSORGetMulticolor(), PCSORSetSymmetric(), MatSetOption(), MatColoringSetType()
+@*/
+PetscErrorCode  PCSORSetMulticolor(PC pc,PetscBool flg)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(pc,PC_CLASSID,1);
+  PetscValidLogicalCollectiveBool(pc,flg,2);
+  ierr = PetscTryMethod(pc,"PCSORSetMulticolor_C",(PC,PetscBool),(pc,flg));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*@
+   PCSORGetMulticolor - Gets if the SOR preconditioner relaxes the rows color by color
+
+   Not Collective
+
+   Input Parameter:
+.  pc - the preconditioner context
+
+   Output Parameter:
+.  flg - PETSC_TRUE if the multicolor ordering is used
+
+   Level: intermediate
+
+.seealso: PCSORSetMulticolor()
+@*/
+PetscErrorCode  PCSORGetMulticolor(PC pc,PetscBool *flg)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(pc,PC_CLASSID,1);
+  PetscValidBoolPointer(flg,2);
+  ierr = PetscUseMethod(pc,"PCSORGetMulticolor_C",(PC,PetscBool*),(pc,flg));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 /*MC
      PCSOR - (S)SOR (successive over relaxation, Gauss-Seidel) preconditioning
 
@@ -411,7 +527,8 @@ PetscErrorCode  PCSORSetIterations(PC pc,PetscInt its,PetscInt lits)
 .  -pc_sor_omega <omega> - Sets omega
 .  -pc_sor_diagonal_shift <shift> - shift the diagonal entries; useful if the matrix has zeros on the diagonal
 .  -pc_sor_its <its> - Sets number of iterations   (default 1)
--  -pc_sor_lits <lits> - Sets number of local iterations  (default 1)
+.  -pc_sor_lits <lits> - Sets number of local iterations  (default 1)
+-  -pc_sor_multicolor - Relax the rows color by color, in parallel with OpenMP threads (AIJ matrices only)
 
    Level: beginner
 
@@ -436,7 +553,7 @@ PetscErrorCode  PCSORSetIterations(PC pc,PetscInt its,PetscInt lits)
           If omega != 1, you will need to set the MAT_USE_INODES option to PETSC_FALSE on the matrix.
 
 .seealso:  PCCreate(), PCSetType(), PCType (for list of available types), PC,
-           PCSORSetIterations(), PCSORSetSymmetric(), PCSORSetOmega(), PCEISENSTAT, MatSetOption()
+           PCSORSetIterations(), PCSORSetSymmetric(), PCSORSetOmega(), PCSORSetMulticolor(), PCEISENSTAT, MatSetOption()
 M*/
 
 PETSC_EXTERN PetscErrorCode PCCreate_SOR(PC pc)
@@ -451,9 +568,10 @@ PETSC_EXTERN PetscErrorCode PCCreate_SOR(PC pc)
   pc->ops->applytranspose  = PCApplyTranspose_SOR;
   pc->ops->applyrichardson = PCApplyRichardson_SOR;
   pc->ops->setfromoptions  = PCSetFromOptions_SOR;
-  pc->ops->setup           = NULL;
+  pc->ops->setup           = PCSetUp_SOR;
   pc->ops->view            = PCView_SOR;
   pc->ops->destroy         = PCDestroy_SOR;
+  pc->ops->reset           = PCReset_SOR;
   pc->data                 = (void*)jac;
   jac->sym                 = SOR_LOCAL_SYMMETRIC_SWEEP;
   jac->omega               = 1.0;
@@ -467,5 +585,7 @@ PETSC_EXTERN PetscErrorCode PCCreate_SOR(PC pc)
   ierr = PetscObjectComposeFunction((PetscObject)pc,"PCSORGetSymmetric_C",PCSORGetSymmetric_SOR);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)pc,"PCSORGetOmega_C",PCSORGetOmega_SOR);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)pc,"PCSORGetIterations_C",PCSORGetIterations_SOR);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)pc,"PCSORSetMulticolor_C",PCSORSetMulticolor_SOR);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)pc,"PCSORGetMulticolor_C",PCSORGetMulticolor_SOR);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
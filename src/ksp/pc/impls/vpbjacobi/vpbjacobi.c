@@ -5,12 +5,14 @@
 */
 
 #include <petsc/private/pcimpl.h>   /*I "petscpc.h" I*/
+#include <petsc/private/kernels/blockinvert.h>
 
 /*
    Private context (data structure) for the VPBJacobi preconditioner.
 */
 typedef struct {
   MatScalar *diag;
+  PetscBool batched;  /* invert the consecutive blocks of the same size in batches of interleaved blocks */
 } PC_VPBJacobi;
 
 
@@ -100,6 +102,72 @@ static PetscErrorCode PCApply_VPBJacobi(PC pc,Vec x,Vec y)
 
 
 
+/*
+   Inverts the runs of up to PETSC_KERNEL_BATCH_SIZE consecutive blocks of the same size together, the blocks of a run
+   are interleaved for the batched kernel and the inverses stored back one after the other in column major order
+*/
+static PetscErrorCode PCSetUpBatched_VPBJacobi_Private(PC pc,PetscInt nblocks,const PetscInt *bsizes)
+{
+  PC_VPBJacobi   *jac = (PC_VPBJacobi*)pc->data;
+  PetscErrorCode ierr;
+  Mat            A = pc->pmat;
+  const PetscInt nb = PETSC_KERNEL_BATCH_SIZE;
+  PetscInt       b,e,i,j,k,l,bs,bs2,bsmax = 0,ncnt,rstart,*idx,*pivots;
+  MatScalar      *diag = jac->diag,*batch,*work;
+  PetscScalar    *v;
+  PetscBool      allowzeropivot,zeropivotdetected;
+  PetscLogDouble flops = 0.0;
+
+  PetscFunctionBegin;
+  allowzeropivot = PetscNot(pc->erroriffailure);
+  for (b=0; b<nblocks; b++) bsmax = PetscMax(bsmax,bsizes[b]);
+  ierr = PetscMalloc5(bsmax,&idx,bsmax,&pivots,bsmax*bsmax,&v,nb*bsmax*bsmax,&batch,(nb+1)*bsmax*bsmax+bsmax,&work);CHKERRQ(ierr);
+  ierr = MatGetOwnershipRange(A,&rstart,NULL);CHKERRQ(ierr);
+  ncnt = rstart;
+  for (b=0; b<nblocks; b=e) {
+    bs  = bsizes[b];
+    bs2 = bs*bs;
+    for (e=b+1; e<nblocks && e-b<nb && bsizes[e]==bs; e++) ;
+    if (bs == 1) {
+      for (l=0; l<e-b; l++) {
+        ierr = MatGetValues(A,1,&ncnt,1,&ncnt,v);CHKERRQ(ierr);
+        if (v[0] == 0.0) {
+          if (!allowzeropivot) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_MAT_LU_ZRPVT,"Zero pivot, row %D",ncnt);
+          pc->failedreason = PC_FACTOR_NUMERIC_ZEROPIVOT;
+        }
+        *diag++ = 1.0/v[0];
+        ncnt++;
+      }
+      flops += e-b;
+      continue;
+    }
+    for (l=0; l<nb; l++) {
+      if (l < e-b) {
+        for (k=0; k<bs; k++) idx[k] = ncnt + k;
+        ierr = MatGetValues(A,bs,idx,bs,idx,v);CHKERRQ(ierr);
+        for (i=0; i<bs; i++) {
+          for (j=0; j<bs; j++) batch[(i+j*bs)*nb+l] = v[i*bs+j];
+        }
+        ncnt += bs;
+      } else {
+        for (i=0; i<bs; i++) {
+          for (j=0; j<bs; j++) batch[(i+j*bs)*nb+l] = (i == j) ? 1.0 : 0.0;
+        }
+      }
+    }
+    ierr = PetscKernel_A_gets_inverse_A_Batch(bs,batch,pivots,work,allowzeropivot,&zeropivotdetected);CHKERRQ(ierr);
+    if (zeropivotdetected) pc->failedreason = PC_FACTOR_NUMERIC_ZEROPIVOT;
+    for (l=0; l<e-b; l++) {
+      for (k=0; k<bs2; k++) diag[k] = batch[k*nb+l];
+      diag += bs2;
+    }
+    flops += 2.0*bs*bs2*(e-b);
+  }
+  ierr = PetscFree5(idx,pivots,v,batch,work);CHKERRQ(ierr);
+  ierr = PetscLogFlops(flops);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 /* -------------------------------------------------------------------------- */
 static PetscErrorCode PCSetUp_VPBJacobi(PC pc)
 {
@@ -110,6 +178,7 @@ static PetscErrorCode PCSetUp_VPBJacobi(PC pc)
   PetscInt       i,nsize = 0,nlocal;
   PetscInt       nblocks;
   const PetscInt *bsizes;
+  PetscBool      getvalues;
 
   PetscFunctionBegin;
   ierr = MatGetVariableBlockSizes(pc->pmat,&nblocks,&bsizes);CHKERRQ(ierr);
@@ -119,9 +188,18 @@ static PetscErrorCode PCSetUp_VPBJacobi(PC pc)
     for (i=0; i<nblocks; i++) nsize += bsizes[i]*bsizes[i];
     ierr = PetscMalloc1(nsize,&jac->diag);CHKERRQ(ierr);
   }
-  ierr = MatInvertVariableBlockDiagonal(A,nblocks,bsizes,jac->diag);CHKERRQ(ierr);
-  ierr = MatFactorGetError(A,&err);CHKERRQ(ierr);
-  if (err) pc->failedreason = (PCFailedReason)err;
+  ierr = MatHasOperation(A,MATOP_GET_VALUES,&getvalues);CHKERRQ(ierr);
+  if (jac->batched && !getvalues) {
+    ierr = PetscInfo1(pc,"Matrix type %s cannot provide its diagonal blocks, they are not batched\n",((PetscObject)A)->type_name);CHKERRQ(ierr);
+    jac->batched = PETSC_FALSE;
+  }
+  if (jac->batched) {
+    ierr = PCSetUpBatched_VPBJacobi_Private(pc,nblocks,bsizes);CHKERRQ(ierr);
+  } else {
+    ierr = MatInvertVariableBlockDiagonal(A,nblocks,bsizes,jac->diag);CHKERRQ(ierr);
+    ierr = MatFactorGetError(A,&err);CHKERRQ(ierr);
+    if (err) pc->failedreason = (PCFailedReason)err;
+  }
   pc->ops->apply = PCApply_VPBJacobi;
   PetscFunctionReturn(0);
 }
@@ -140,6 +218,32 @@ static PetscErrorCode PCDestroy_VPBJacobi(PC pc)
   PetscFunctionReturn(0);
 }
 
+static PetscErrorCode PCSetFromOptions_VPBJacobi(PetscOptionItems *PetscOptionsObject,PC pc)
+{
+  PC_VPBJacobi   *jac = (PC_VPBJacobi*)pc->data;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscOptionsHead(PetscOptionsObject,"Variable point-block Jacobi options");CHKERRQ(ierr);
+  ierr = PetscOptionsBool("-pc_vpbjacobi_batched","Invert the consecutive blocks of the same size in batches of interleaved blocks","None",jac->batched,&jac->batched,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsTail();CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode PCView_VPBJacobi(PC pc,PetscViewer viewer)
+{
+  PetscErrorCode ierr;
+  PC_VPBJacobi   *jac = (PC_VPBJacobi*)pc->data;
+  PetscBool      iascii;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectTypeCompare((PetscObject)viewer,PETSCVIEWERASCII,&iascii);CHKERRQ(ierr);
+  if (iascii && jac->batched) {
+    ierr = PetscViewerASCIIPrintf(viewer,"  blocks of the same size inverted in batches of %d interleaved blocks\n",PETSC_KERNEL_BATCH_SIZE);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
 /* -------------------------------------------------------------------------- */
 /*MC
      PCVPBJACOBI - Variable size point block Jacobi preconditioner
@@ -154,6 +258,14 @@ static PetscErrorCode PCDestroy_VPBJacobi(PC pc)
    is detected a PETSc error is generated.
 
    One must call MatSetVariableBlockSizes() to use this preconditioner
+
+   With -pc_vpbjacobi_batched the runs of consecutive blocks of the same size are inverted together,
+   PETSC_KERNEL_BATCH_SIZE blocks at a time, with Gauss-Jordan elimination vectorized over the blocks.
+   Only the blocks with a small pivot are inverted with partial pivoting.
+
+   Options Database Keys:
+.  -pc_vpbjacobi_batched - invert the blocks in batches of interleaved blocks
+
    Developer Notes:
     This should support the PCSetErrorIfFailure() flag set to PETSC_TRUE to allow
    the factorization to continue even after a zero pivot is found resulting in a Nan and hence
@@ -199,7 +311,8 @@ PETSC_EXTERN PetscErrorCode PCCreate_VPBJacobi(PC pc)
   pc->ops->applytranspose      = NULL;
   pc->ops->setup               = PCSetUp_VPBJacobi;
   pc->ops->destroy             = PCDestroy_VPBJacobi;
-  pc->ops->setfromoptions      = NULL;
+  pc->ops->setfromoptions      = PCSetFromOptions_VPBJacobi;
+  pc->ops->view                = PCView_VPBJacobi;
   pc->ops->applyrichardson     = NULL;
   pc->ops->applysymmetricleft  = NULL;
   pc->ops->applysymmetricright = NULL;
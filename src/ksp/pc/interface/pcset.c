@@ -124,11 +124,12 @@ extern PetscErrorCode PCGetDefaultType_Private(PC,const char*[]);
 .  pc - the preconditioner context
 
    Options Database:
-.   -pc_use_amat true,false see PCSetUseAmat()
++   -pc_use_amat true,false see PCSetUseAmat()
+-   -pc_mat_precision <double,single> see PCSetMatPrecision()
 
    Level: developer
 
-.seealso: PCSetUseAmat()
+.seealso: PCSetUseAmat(), PCSetMatPrecision()
 
 @*/
 PetscErrorCode  PCSetFromOptions(PC pc)
@@ -137,6 +138,7 @@ PetscErrorCode  PCSetFromOptions(PC pc)
   char           type[256];
   const char     *def;
   PetscBool      flg;
+  PCMatPrecision precision;
 
   PetscFunctionBegin;
   PetscValidHeaderSpecific(pc,PC_CLASSID,1);
@@ -160,6 +162,8 @@ PetscErrorCode  PCSetFromOptions(PC pc)
   if (flg) goto skipoptions;
 
   ierr = PetscOptionsBool("-pc_use_amat","use Amat (instead of Pmat) to define preconditioner in nested inner solves","PCSetUseAmat",pc->useAmat,&pc->useAmat,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsEnum("-pc_mat_precision","Precision of the values of the Pmat","PCSetMatPrecision",PCMatPrecisions,(PetscEnum)pc->matprecision,(PetscEnum*)&precision,&flg);CHKERRQ(ierr);
+  if (flg) {ierr = PCSetMatPrecision(pc,precision);CHKERRQ(ierr);}
 
   if (pc->ops->setfromoptions) {
     ierr = (*pc->ops->setfromoptions)(PetscOptionsObject,pc);CHKERRQ(ierr);
@@ -78,6 +78,7 @@ PetscErrorCode  PCReset(PC pc)
   ierr = VecDestroy(&pc->diagonalscaleright);CHKERRQ(ierr);
   ierr = VecDestroy(&pc->diagonalscaleleft);CHKERRQ(ierr);
   ierr = MatDestroy(&pc->pmat);CHKERRQ(ierr);
+  ierr = MatDestroy(&pc->pmatuser);CHKERRQ(ierr);
   ierr = MatDestroy(&pc->mat);CHKERRQ(ierr);
 
   pc->setupcalled = 0;
@@ -385,6 +386,8 @@ PetscErrorCode  PCCreate(MPI_Comm comm,PC *newpc)
 
   pc->mat                  = NULL;
   pc->pmat                 = NULL;
+  pc->pmatuser             = NULL;
+  pc->matprecision         = PC_MAT_PRECISION_DOUBLE;
   pc->setupcalled          = 0;
   pc->setfromoptionscalled = 0;
   pc->data                 = NULL;
@@ -948,6 +951,44 @@ PetscErrorCode PCGetFailedReasonRank(PC pc,PCFailedReason *reason)
 /*  Next line needed to deactivate KSP_Solve logging */
 #include <petsc/private/kspimpl.h>
 
+/*
+   Replaces a MATSEQAIJ Pmat by a copy of type MATSEQAIJSINGLE when the precision of the Pmat is single, the Pmat of
+   the user is kept in pc->pmatuser. The copy is updated when the Pmat changed and dropped if the precision is reset.
+   A copy that was factored in place (PCFactorSetUseInPlace()) cannot be updated and is converted again.
+*/
+static PetscErrorCode PCSetUpMatPrecision_Private(PC pc)
+{
+  PetscErrorCode ierr;
+  Mat            pmat = pc->pmatuser ? pc->pmatuser : pc->pmat,B;
+  MatFactorType  ftype = MAT_FACTOR_NONE;
+  PetscBool      isseqaij;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectTypeCompare((PetscObject)pmat,MATSEQAIJ,&isseqaij);CHKERRQ(ierr);
+  if (pc->matprecision == PC_MAT_PRECISION_DOUBLE || !isseqaij) {
+    if (pc->matprecision != PC_MAT_PRECISION_DOUBLE) {
+      ierr = PetscInfo1(pc,"Keeping the values of the Pmat of type %s in full precision, only MATSEQAIJ is converted\n",((PetscObject)pmat)->type_name);CHKERRQ(ierr);
+    }
+    if (pc->pmatuser) {
+      ierr         = MatDestroy(&pc->pmat);CHKERRQ(ierr);
+      pc->pmat     = pc->pmatuser;
+      pc->pmatuser = NULL;
+    }
+    PetscFunctionReturn(0);
+  }
+  if (pc->pmatuser) {ierr = MatGetFactorType(pc->pmat,&ftype);CHKERRQ(ierr);}
+  if (pc->pmatuser && pc->flag == SAME_NONZERO_PATTERN && ftype == MAT_FACTOR_NONE) {
+    ierr = MatConvert(pmat,MATSEQAIJSINGLE,MAT_REUSE_MATRIX,&pc->pmat);CHKERRQ(ierr);
+  } else {
+    ierr = PetscInfo(pc,"Converting the Pmat to MATSEQAIJSINGLE\n");CHKERRQ(ierr);
+    ierr = MatConvert(pmat,MATSEQAIJSINGLE,MAT_INITIAL_MATRIX,&B);CHKERRQ(ierr);
+    if (pc->pmatuser) {ierr = MatDestroy(&pc->pmat);CHKERRQ(ierr);}
+    else pc->pmatuser = pc->pmat;
+    pc->pmat = B;
+  }
+  PetscFunctionReturn(0);
+}
+
 /*
       a setupcall of 0 indicates never setup,
                      1 indicates has been previously setup
@@ -970,6 +1011,7 @@ PetscErrorCode  PCSetUp(PC pc)
   PetscErrorCode   ierr;
   const char       *def;
   PetscObjectState matstate, matnonzerostate;
+  Mat              pmat;
 
   PetscFunctionBegin;
   PetscValidHeaderSpecific(pc,PC_CLASSID,1);
@@ -980,8 +1022,9 @@ PetscErrorCode  PCSetUp(PC pc)
     PetscFunctionReturn(0);
   }
 
-  ierr = PetscObjectStateGet((PetscObject)pc->pmat,&matstate);CHKERRQ(ierr);
-  ierr = MatGetNonzeroState(pc->pmat,&matnonzerostate);CHKERRQ(ierr);
+  pmat = pc->pmatuser ? pc->pmatuser : pc->pmat; /* the state of the user's Pmat, not of its converted copy */
+  ierr = PetscObjectStateGet((PetscObject)pmat,&matstate);CHKERRQ(ierr);
+  ierr = MatGetNonzeroState(pmat,&matnonzerostate);CHKERRQ(ierr);
   if (!pc->setupcalled) {
     ierr     = PetscInfo(pc,"Setting up PC for first time\n");CHKERRQ(ierr);
     pc->flag = DIFFERENT_NONZERO_PATTERN;
@@ -1005,6 +1048,7 @@ PetscErrorCode  PCSetUp(PC pc)
     ierr = PCSetType(pc,def);CHKERRQ(ierr);
   }
 
+  ierr = PCSetUpMatPrecision_Private(pc);CHKERRQ(ierr);
   ierr = MatSetErrorIfFailure(pc->pmat,pc->erroriffailure);CHKERRQ(ierr);
   ierr = MatSetErrorIfFailure(pc->mat,pc->erroriffailure);CHKERRQ(ierr);
   ierr = PetscLogEventBegin(PC_SetUp,pc,0,0,0);CHKERRQ(ierr);
@@ -1190,6 +1234,18 @@ PetscErrorCode  PCSetOperators(PC pc,Mat Amat,Mat Pmat)
     if (m1 != m2 || n1 != n2) SETERRQ4(PETSC_COMM_SELF,PETSC_ERR_ARG_SIZ,"Cannot change local size of Pmat after use old sizes %D %D new sizes %D %D",m2,n2,m1,n1);
   }
 
+  if (pc->pmatuser) {
+    if (Pmat == pc->pmatuser) { /* keep the converted copy, PCSetUp() updates it if the Pmat changed */
+      if (Amat) {ierr = PetscObjectReference((PetscObject)Amat);CHKERRQ(ierr);}
+      ierr    = MatDestroy(&pc->mat);CHKERRQ(ierr);
+      pc->mat = Amat;
+      PetscFunctionReturn(0);
+    }
+    ierr         = MatDestroy(&pc->pmat);CHKERRQ(ierr);
+    pc->pmat     = pc->pmatuser;
+    pc->pmatuser = NULL;
+  }
+
   if (Pmat != pc->pmat) {
     /* changing the operator that defines the preconditioner thus reneed to clear current states so new preconditioner is built */
     pc->matnonzerostate = -1;
@@ -1252,6 +1308,68 @@ PetscErrorCode  PCGetReusePreconditioner(PC pc,PetscBool *flag)
   PetscFunctionReturn(0);
 }
 
+/*@
+   PCSetMatPrecision - Sets the precision of the values of the matrix the preconditioner is built from.
+
+   Logically Collective on PC
+
+   Input Parameters:
++  pc - the preconditioner context
+-  precision - PC_MAT_PRECISION_DOUBLE (default) or PC_MAT_PRECISION_SINGLE
+
+   Options Database Key:
+.  -pc_mat_precision <double,single> - precision of the values of the Pmat
+
+   Notes:
+   With PC_MAT_PRECISION_SINGLE, PCSetUp() builds the preconditioner from a copy of a MATSEQAIJ Pmat of type
+   MATSEQAIJSINGLE, whose MatMult(), MatSOR() and LU and ILU triangular solves read the values in single precision.
+   The Pmat of the user is not changed and is still returned by PCGetOperators(), the copy is updated in PCSetUp()
+   when the Pmat changed. Other matrix types are used as they are, for parallel preconditioners such as PCBJACOBI
+   and PCASM set the precision of the subdomain solvers instead, for example with -sub_pc_mat_precision single.
+
+   Since the preconditioner is that of the Pmat rounded to single precision, this is meant for preconditioners used
+   inside a Krylov method.
+
+   Level: intermediate
+
+.seealso: PCGetMatPrecision(), PCSetOperators(), MATSEQAIJSINGLE
+@*/
+PetscErrorCode  PCSetMatPrecision(PC pc,PCMatPrecision precision)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(pc,PC_CLASSID,1);
+  PetscValidLogicalCollectiveEnum(pc,precision,2);
+  if (precision != pc->matprecision) {
+    pc->matprecision = precision;
+    pc->matstate     = -1; /* build the preconditioner again at the next PCSetUp() */
+  }
+  PetscFunctionReturn(0);
+}
+
+/*@
+   PCGetMatPrecision - Gets the precision of the values of the matrix the preconditioner is built from.
+
+   Not Collective
+
+   Input Parameter:
+.  pc - the preconditioner context
+
+   Output Parameter:
+.  precision - PC_MAT_PRECISION_DOUBLE or PC_MAT_PRECISION_SINGLE
+
+   Level: intermediate
+
+.seealso: PCSetMatPrecision()
+@*/
+PetscErrorCode  PCGetMatPrecision(PC pc,PCMatPrecision *precision)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(pc,PC_CLASSID,1);
+  PetscValidPointer(precision,2);
+  *precision = pc->matprecision;
+  PetscFunctionReturn(0);
+}
+
 /*@
    PCGetOperators - Gets the matrix associated with the linear system and
    possibly a different one associated with the preconditioner.
@@ -1344,7 +1462,7 @@ PetscErrorCode  PCGetOperators(PC pc,Mat *Amat,Mat *Pmat)
         }
       }
     }
-    *Pmat = pc->pmat;
+    *Pmat = pc->pmatuser ? pc->pmatuser : pc->pmat;
   }
   PetscFunctionReturn(0);
 }
@@ -1737,6 +1855,9 @@ PetscErrorCode  PCView(PC pc,PetscViewer viewer)
       ierr = (*pc->ops->view)(pc,viewer);CHKERRQ(ierr);
       ierr = PetscViewerASCIIPopTab(viewer);CHKERRQ(ierr);
     }
+    if (pc->pmatuser) {
+      ierr = PetscViewerASCIIPrintf(viewer,"  preconditioner matrix values stored in single precision\n");CHKERRQ(ierr);
+    }
     if (pc->mat) {
       ierr = PetscViewerPushFormat(viewer,PETSC_VIEWER_ASCII_INFO);CHKERRQ(ierr);
       if (pc->pmat == pc->mat) {
@@ -0,0 +1,104 @@
+static char help[] = "Compares the smoothing rate of PCSOR with the natural and the multicolor orderings of the rows.\n\n";
+
+/*
+  Relaxes A x = 0 for the 5-point Laplacian on a -m x -m grid from a random x with -sweeps symmetric SOR sweeps, and
+  reports the reduction of the residual per sweep with the natural ordering and with -pc_sor_multicolor. With -report
+  the time per sweep is also printed.
+
+  Usage: OMP_NUM_THREADS=8 ./ex10 -m 2000 -sweeps 10 -report
+*/
+#include <petscksp.h>
+#include <petsctime.h>
+
+int main(int argc,char **args)
+{
+  Mat            A;
+  Vec            x,x0,b,r;
+  KSP            ksp;
+  PC             pc;
+  PetscInt       m = 64,sweeps = 4,Istart,Iend,row,i,j,o;
+  PetscReal      norm0,norm,omega = 1.0;
+  PetscBool      report = PETSC_FALSE;
+  PetscLogDouble t0,t1;
+  const char     *orderings[] = {"natural","multicolor"};
+  PetscErrorCode ierr;
+
+  ierr = PetscInitialize(&argc,&args,(char*)0,help);if (ierr) return ierr;
+  ierr = PetscOptionsGetInt(NULL,NULL,"-m",&m,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,NULL,"-sweeps",&sweeps,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetReal(NULL,NULL,"-omega",&omega,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetBool(NULL,NULL,"-report",&report,NULL);CHKERRQ(ierr);
+
+  ierr = MatCreateAIJ(PETSC_COMM_WORLD,PETSC_DECIDE,PETSC_DECIDE,m*m,m*m,5,NULL,2,NULL,&A);CHKERRQ(ierr);
+  ierr = MatGetOwnershipRange(A,&Istart,&Iend);CHKERRQ(ierr);
+  for (row=Istart; row<Iend; row++) {
+    i = row/m; j = row - i*m;
+    if (i > 0)   {ierr = MatSetValue(A,row,row-m,-1.0,INSERT_VALUES);CHKERRQ(ierr);}
+    if (j > 0)   {ierr = MatSetValue(A,row,row-1,-1.0,INSERT_VALUES);CHKERRQ(ierr);}
+    ierr = MatSetValue(A,row,row,4.0,INSERT_VALUES);CHKERRQ(ierr);
+    if (j < m-1) {ierr = MatSetValue(A,row,row+1,-1.0,INSERT_VALUES);CHKERRQ(ierr);}
+    if (i < m-1) {ierr = MatSetValue(A,row,row+m,-1.0,INSERT_VALUES);CHKERRQ(ierr);}
+  }
+  ierr = MatAssemblyBegin(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatCreateVecs(A,&x,&b);CHKERRQ(ierr);
+  ierr = VecDuplicate(x,&x0);CHKERRQ(ierr);
+  ierr = VecDuplicate(x,&r);CHKERRQ(ierr);
+  ierr = VecSetRandom(x0,NULL);CHKERRQ(ierr);
+  ierr = VecSet(b,0.0);CHKERRQ(ierr);
+  ierr = MatMult(A,x0,r);CHKERRQ(ierr);
+  ierr = VecNorm(r,NORM_2,&norm0);CHKERRQ(ierr);
+
+  for (o=0; o<2; o++) {
+    ierr = KSPCreate(PETSC_COMM_WORLD,&ksp);CHKERRQ(ierr);
+    ierr = KSPSetOperators(ksp,A,A);CHKERRQ(ierr);
+    ierr = KSPSetType(ksp,KSPRICHARDSON);CHKERRQ(ierr);
+    ierr = KSPSetInitialGuessNonzero(ksp,PETSC_TRUE);CHKERRQ(ierr);
+    ierr = KSPSetNormType(ksp,KSP_NORM_NONE);CHKERRQ(ierr);
+    ierr = KSPSetTolerances(ksp,0.0,0.0,PETSC_DEFAULT,sweeps);CHKERRQ(ierr);
+    ierr = KSPGetPC(ksp,&pc);CHKERRQ(ierr);
+    ierr = PCSetType(pc,PCSOR);CHKERRQ(ierr);
+    ierr = PCSORSetOmega(pc,omega);CHKERRQ(ierr);
+    ierr = PCSORSetMulticolor(pc,o ? PETSC_TRUE : PETSC_FALSE);CHKERRQ(ierr);
+    ierr = KSPSetFromOptions(ksp);CHKERRQ(ierr);
+    ierr = KSPSetUp(ksp);CHKERRQ(ierr);
+    /* The first sweep colors the rows */
+    ierr = VecCopy(x0,x);CHKERRQ(ierr);
+    ierr = PCApply(pc,b,x);CHKERRQ(ierr);
+
+    ierr = VecCopy(x0,x);CHKERRQ(ierr);
+    ierr = PetscTime(&t0);CHKERRQ(ierr);
+    ierr = KSPSolve(ksp,b,x);CHKERRQ(ierr);
+    ierr = PetscTime(&t1);CHKERRQ(ierr);
+    ierr = MatMult(A,x,r);CHKERRQ(ierr);
+    ierr = VecNorm(r,NORM_2,&norm);CHKERRQ(ierr);
+    ierr = PetscPrintf(PETSC_COMM_WORLD,"%-10s ordering: residual reduction per sweep %.2f\n",orderings[o],(double)PetscPowReal(norm/norm0,1.0/sweeps));CHKERRQ(ierr);
+    if (report) {ierr = PetscPrintf(PETSC_COMM_WORLD,"%-10s ordering: %g s per sweep\n",orderings[o],(t1-t0)/sweeps);CHKERRQ(ierr);}
+    ierr = KSPDestroy(&ksp);CHKERRQ(ierr);
+  }
+
+  ierr = VecDestroy(&x);CHKERRQ(ierr);
+  ierr = VecDestroy(&x0);CHKERRQ(ierr);
+  ierr = VecDestroy(&b);CHKERRQ(ierr);
+  ierr = VecDestroy(&r);CHKERRQ(ierr);
+  ierr = MatDestroy(&A);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+   test:
+      suffix: 1
+
+   test:
+      suffix: 2
+      nsize: 2
+      args: -pc_sor_local_forward -omega 1.2
+
+   test:
+      suffix: jp
+      args: -mat_coloring_type jp -ksp_view
+      filter: grep -e ordering -e multicolor
+
+TEST*/
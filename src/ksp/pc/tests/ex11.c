@@ -0,0 +1,168 @@
+
+static char help[] = "Measures the point-block Jacobi preconditioners with and without the batched inversion of the blocks.\n\n";
+
+/*
+  For the block sizes -bs_min to -bs_max, sets up PCPBJACOBI on a block tridiagonal matrix with -n random blocks per
+  process and applies it -its times, with and without -pc_pbjacobi_batched, and checks that both give the same result
+  and the same transpose. The diagonal of the first block is zero, its inverse needs pivoting. With -vpb the same is
+  done with PCVPBJACOBI and runs of blocks of sizes 1 to -bs_max. With -report the blocks set up and applied per second
+  are also printed.
+
+  Usage: ./ex11 -n 200000 -bs_min 2 -bs_max 16 -its 20 -report
+*/
+#include <petscpc.h>
+#include <petsctime.h>
+
+/* Fills the diagonal blocks of the sizes bsizes[] with random entries, diagonally dominant except for the first block */
+static PetscErrorCode FillMatrix(Mat A,PetscInt nblocks,const PetscInt *bsizes,PetscRandom rand)
+{
+  PetscErrorCode ierr;
+  PetscInt       b,i,j,bs,rstart,ncnt,N;
+  PetscScalar    v;
+
+  PetscFunctionBegin;
+  ierr = MatGetOwnershipRange(A,&rstart,NULL);CHKERRQ(ierr);
+  ierr = MatGetSize(A,&N,NULL);CHKERRQ(ierr);
+  ncnt = rstart;
+  for (b=0; b<nblocks; b++) {
+    bs = bsizes[b];
+    for (i=0; i<bs; i++) {
+      for (j=0; j<bs; j++) {
+        ierr = PetscRandomGetValue(rand,&v);CHKERRQ(ierr);
+        if (i == j) v = (b || i) ? v + bs : 0.0;
+        ierr = MatSetValue(A,ncnt+i,ncnt+j,v,INSERT_VALUES);CHKERRQ(ierr);
+      }
+      if (ncnt+i >= bs)  {ierr = MatSetValue(A,ncnt+i,ncnt+i-bs,-0.5,INSERT_VALUES);CHKERRQ(ierr);}
+      if (ncnt+i+bs < N) {ierr = MatSetValue(A,ncnt+i,ncnt+i+bs,-0.5,INSERT_VALUES);CHKERRQ(ierr);}
+    }
+    ncnt += bs;
+  }
+  ierr = MatAssemblyBegin(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* Applies the preconditioner of type, with and without batching, and prints how far apart the results are */
+static PetscErrorCode TestPC(Mat A,PCType type,const char *label,PetscInt nblocks,PetscInt its,PetscBool report)
+{
+  PetscErrorCode ierr;
+  PC             pc;
+  Vec            x,y[2],yt[2];
+  PetscInt       o,k;
+  PetscReal      norm,diff,normt,difft = 0.0;
+  PetscLogDouble t0,t1,t2;
+  PetscBool      pb;
+  const char     *option;
+
+  PetscFunctionBegin;
+  ierr   = PetscStrcmp(type,PCPBJACOBI,&pb);CHKERRQ(ierr);
+  option = pb ? "-pc_pbjacobi_batched" : "-pc_vpbjacobi_batched";
+  ierr = MatCreateVecs(A,&x,&y[0]);CHKERRQ(ierr);
+  ierr = VecDuplicate(y[0],&y[1]);CHKERRQ(ierr);
+  ierr = VecDuplicate(y[0],&yt[0]);CHKERRQ(ierr);
+  ierr = VecDuplicate(y[0],&yt[1]);CHKERRQ(ierr);
+  ierr = VecSetRandom(x,NULL);CHKERRQ(ierr);
+  for (o=0; o<2; o++) {
+    ierr = PetscOptionsSetValue(NULL,option,o ? "true" : "false");CHKERRQ(ierr);
+    ierr = PCCreate(PetscObjectComm((PetscObject)A),&pc);CHKERRQ(ierr);
+    ierr = PCSetType(pc,type);CHKERRQ(ierr);
+    ierr = PCSetOperators(pc,A,A);CHKERRQ(ierr);
+    ierr = PCSetFromOptions(pc);CHKERRQ(ierr);
+    ierr = PetscTime(&t0);CHKERRQ(ierr);
+    ierr = PCSetUp(pc);CHKERRQ(ierr);
+    ierr = PetscTime(&t1);CHKERRQ(ierr);
+    for (k=0; k<its; k++) {ierr = PCApply(pc,x,y[o]);CHKERRQ(ierr);}
+    ierr = PetscTime(&t2);CHKERRQ(ierr);
+    if (pb) {ierr = PCApplyTranspose(pc,x,yt[o]);CHKERRQ(ierr);}
+    if (report) {
+      ierr = PetscPrintf(PETSC_COMM_WORLD,"%s %-9s: %g blocks/s set up, %g blocks/s applied\n",label,o ? "batched" : "unbatched",nblocks/(t1-t0),its*nblocks/(t2-t1));CHKERRQ(ierr);
+    }
+    ierr = PCDestroy(&pc);CHKERRQ(ierr);
+  }
+  ierr = PetscOptionsClearValue(NULL,option);CHKERRQ(ierr);
+  ierr = VecNorm(y[0],NORM_2,&norm);CHKERRQ(ierr);
+  ierr = VecAXPY(y[1],-1.0,y[0]);CHKERRQ(ierr);
+  ierr = VecNorm(y[1],NORM_2,&diff);CHKERRQ(ierr);
+  diff /= norm;
+  if (pb) {
+    ierr  = VecNorm(yt[0],NORM_2,&normt);CHKERRQ(ierr);
+    ierr  = VecAXPY(yt[1],-1.0,yt[0]);CHKERRQ(ierr);
+    ierr  = VecNorm(yt[1],NORM_2,&difft);CHKERRQ(ierr);
+    difft /= normt;
+  }
+  diff = PetscMax(diff,difft);
+  if (diff <= 1.e3*PETSC_MACHINE_EPSILON) {
+    ierr = PetscPrintf(PETSC_COMM_WORLD,"%s: batched and unbatched %s agree\n",label,type);CHKERRQ(ierr);
+  } else {
+    ierr = PetscPrintf(PETSC_COMM_WORLD,"%s: batched and unbatched %s differ by %g\n",label,type,(double)diff);CHKERRQ(ierr);
+  }
+  ierr = VecDestroy(&x);CHKERRQ(ierr);
+  ierr = VecDestroy(&y[0]);CHKERRQ(ierr);
+  ierr = VecDestroy(&y[1]);CHKERRQ(ierr);
+  ierr = VecDestroy(&yt[0]);CHKERRQ(ierr);
+  ierr = VecDestroy(&yt[1]);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+int main(int argc,char **args)
+{
+  Mat            A;
+  PetscRandom    rand;
+  PetscInt       n = 100,bs,bsmin = 2,bsmax = 16,its = 4,b,nlocal,*bsizes;
+  PetscBool      vpb = PETSC_FALSE,report = PETSC_FALSE;
+  char           label[32];
+  PetscErrorCode ierr;
+
+  ierr = PetscInitialize(&argc,&args,(char*)0,help);if (ierr) return ierr;
+  ierr = PetscOptionsGetInt(NULL,NULL,"-n",&n,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,NULL,"-bs_min",&bsmin,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,NULL,"-bs_max",&bsmax,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,NULL,"-its",&its,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetBool(NULL,NULL,"-vpb",&vpb,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetBool(NULL,NULL,"-report",&report,NULL);CHKERRQ(ierr);
+  ierr = PetscRandomCreate(PETSC_COMM_WORLD,&rand);CHKERRQ(ierr);
+  ierr = PetscRandomSetInterval(rand,-1.0,1.0);CHKERRQ(ierr);
+  ierr = PetscRandomSetFromOptions(rand);CHKERRQ(ierr);
+  ierr = PetscMalloc1(n,&bsizes);CHKERRQ(ierr);
+
+  for (bs=bsmin; bs<=bsmax; bs++) {
+    for (b=0; b<n; b++) bsizes[b] = bs;
+    ierr = MatCreateAIJ(PETSC_COMM_WORLD,n*bs,n*bs,PETSC_DETERMINE,PETSC_DETERMINE,bs+2,NULL,2,NULL,&A);CHKERRQ(ierr);
+    ierr = MatSetBlockSize(A,bs);CHKERRQ(ierr);
+    ierr = FillMatrix(A,n,bsizes,rand);CHKERRQ(ierr);
+    ierr = PetscSNPrintf(label,sizeof(label),"bs %2D",bs);CHKERRQ(ierr);
+    ierr = TestPC(A,PCPBJACOBI,label,n,its,report);CHKERRQ(ierr);
+    ierr = MatDestroy(&A);CHKERRQ(ierr);
+  }
+
+  if (vpb) {
+    /* runs of 10 blocks of the same size, every third run of size 1 */
+    for (b=0,nlocal=0; b<n; b++) {
+      bsizes[b] = (b/10) % 3 == 2 ? 1 : 2 + (b/10) % (bsmax-1);
+      nlocal   += bsizes[b];
+    }
+    ierr = MatCreateAIJ(PETSC_COMM_WORLD,nlocal,nlocal,PETSC_DETERMINE,PETSC_DETERMINE,bsmax+2,NULL,2,NULL,&A);CHKERRQ(ierr);
+    ierr = MatSetVariableBlockSizes(A,n,bsizes);CHKERRQ(ierr);
+    ierr = FillMatrix(A,n,bsizes,rand);CHKERRQ(ierr);
+    ierr = TestPC(A,PCVPBJACOBI,"variable",n,its,report);CHKERRQ(ierr);
+    ierr = MatDestroy(&A);CHKERRQ(ierr);
+  }
+
+  ierr = PetscFree(bsizes);CHKERRQ(ierr);
+  ierr = PetscRandomDestroy(&rand);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+   test:
+      suffix: 1
+      args: -vpb
+
+   test:
+      suffix: 2
+      nsize: 2
+      args: -n 37 -bs_max 9 -vpb
+
+TEST*/
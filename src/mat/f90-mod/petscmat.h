@@ -67,7 +67,9 @@
       PetscEnum, parameter :: MAT_STRUCTURE_ONLY = 22
       PetscEnum, parameter :: MAT_SORTED_FULL = 23
       PetscEnum, parameter :: MAT_FORM_EXPLICIT_TRANSPOSE = 24
-      PetscEnum, parameter :: MAT_OPTION_MAX = 25
+      PetscEnum, parameter :: MAT_AUTOTUNE_MULT = 25
+      PetscEnum, parameter :: MAT_SOR_MULTICOLOR = 26
+      PetscEnum, parameter :: MAT_OPTION_MAX = 27
 !
 !  MatFactorShiftType
 !
@@ -1313,6 +1313,11 @@ PetscErrorCode MatView_MPIAIJ_ASCIIorDraworSocket(Mat mat,PetscViewer viewer)
       } else {
         ierr = PetscViewerASCIIPrintf(viewer,"not using I-node (on process 0) routines\n");CHKERRQ(ierr);
       }
+      if (((Mat_SeqAIJ*)aij->A->data)->autotune.use) {
+        Mat_SeqAIJ *ad = (Mat_SeqAIJ*)aij->A->data,*bd = (Mat_SeqAIJ*)aij->B->data;
+
+        ierr = PetscViewerASCIIPrintf(viewer,"MatMult kernel autotuning (on process 0): diagonal block %s, off-diagonal block %s\n",ad->autotune.tuned ? MatSeqAIJMultKernels[ad->autotune.kernel] : "not yet tuned",bd->autotune.tuned ? MatSeqAIJMultKernels[bd->autotune.kernel] : "not yet tuned");CHKERRQ(ierr);
+      }
       PetscFunctionReturn(0);
     } else if (format == PETSC_VIEWER_ASCII_FACTOR_INFO) {
       PetscFunctionReturn(0);
@@ -1676,6 +1681,8 @@ PetscErrorCode MatSetOption_MPIAIJ(Mat A,MatOption op,PetscBool flg)
   case MAT_USE_INODES:
   case MAT_IGNORE_ZERO_ENTRIES:
   case MAT_FORM_EXPLICIT_TRANSPOSE:
+  case MAT_AUTOTUNE_MULT:
+  case MAT_SOR_MULTICOLOR:
     MatCheckPreallocated(A,1);
     ierr = MatSetOption(a->A,op,flg);CHKERRQ(ierr);
     ierr = MatSetOption(a->B,op,flg);CHKERRQ(ierr);
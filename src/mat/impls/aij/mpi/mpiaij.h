@@ -27,6 +27,8 @@ typedef struct { /* used by MatPtAPXXX_MPIAIJ_MPIAIJ() and MatMatMultXXX_MPIAIJ_
   PetscInt                algType;                 /* implementation algorithm */
   PetscSF                 sf;                      /* use it to communicate remote part of C */
   PetscInt                *c_othi,*c_rmti;
+  PetscInt                cbs;                     /* block size of C when allatonce stores it as MATMPIBAIJ, 1 otherwise */
+  PetscLogDouble          mem_symbolic,mem_numeric; /* PetscMalloc() high water of the allatonce symbolic and numeric phases */
 
   Mat_Merge_SeqsToMPI *merge;
 } Mat_APMPI;
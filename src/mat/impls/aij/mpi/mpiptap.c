@@ -7,6 +7,7 @@
 #include <../src/mat/impls/aij/seq/aij.h>   /*I "petscmat.h" I*/
 #include <../src/mat/utils/freespace.h>
 #include <../src/mat/impls/aij/mpi/mpiaij.h>
+#include <../src/mat/impls/baij/mpi/mpibaij.h>
 #include <petscbt.h>
 #include <petsctime.h>
 #include <petsc/private/hashmapiv.h>
@@ -36,6 +37,12 @@ PetscErrorCode MatView_MPIAIJ_PtAP(Mat A,PetscViewer viewer)
       } else if (ptap->algType == 3) {
         ierr = PetscViewerASCIIPrintf(viewer,"using merged allatonce MatPtAP() implementation\n");CHKERRQ(ierr);
       }
+      if (ptap->cbs > 1) {
+        ierr = PetscViewerASCIIPrintf(viewer,"storing the product as MATMPIBAIJ with block size %D\n",ptap->cbs);CHKERRQ(ierr);
+      }
+      if (format == PETSC_VIEWER_ASCII_INFO_DETAIL && (ptap->mem_symbolic > 0 || ptap->mem_numeric > 0)) {
+        ierr = PetscViewerASCIIPrintf(viewer,"memory high water on this process: symbolic %g MB, numeric %g MB\n",ptap->mem_symbolic/1048576.0,ptap->mem_numeric/1048576.0);CHKERRQ(ierr);
+      }
     }
   }
   PetscFunctionReturn(0);
@@ -719,11 +726,49 @@ PETSC_STATIC_INLINE PetscErrorCode MatPtAPNumericComputeOneRowOfAP_private(Mat A
 
 PetscErrorCode MatGetBrowsOfAcols_MPIXAIJ(Mat,Mat,PetscInt dof,MatReuse,Mat*);
 
+/* Adds the block columns of the columns in ht to bht */
+static PetscErrorCode MatPtAPAddBlockColumns_private(PetscHSetI ht,PetscInt bs,PetscHSetI bht)
+{
+  PetscHashIter  iter;
+  PetscInt       col;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscHashIterBegin(ht,iter);
+  while (!PetscHashIterAtEnd(ht,iter)) {
+    PetscHashIterGetKey(ht,iter,col);
+    ierr = PetscHSetIAdd(bht,col/bs);CHKERRQ(ierr);
+    PetscHashIterNext(ht,iter);
+  }
+  PetscFunctionReturn(0);
+}
+
+/* Upper bound of the number of nonzeros of the local rows of C, stored as MATMPIAIJ, or MATMPIBAIJ when cbs > 1 */
+static PetscErrorCode MatPtAPGetMaxRowLength_allatonce(Mat C,PetscInt cbs,PetscInt *cmaxr)
+{
+  PetscInt i;
+
+  PetscFunctionBegin;
+  *cmaxr = 0;
+  if (cbs > 1) {
+    Mat_MPIBAIJ *c  = (Mat_MPIBAIJ*)C->data;
+    Mat_SeqBAIJ *cd = (Mat_SeqBAIJ*)(c->A)->data,*co = (Mat_SeqBAIJ*)(c->B)->data;
+
+    for (i=0; i<c->mbs; i++) *cmaxr = PetscMax(*cmaxr,cbs*((cd->i[i+1]-cd->i[i])+(co->i[i+1]-co->i[i])));
+  } else {
+    Mat_MPIAIJ *c  = (Mat_MPIAIJ*)C->data;
+    Mat_SeqAIJ *cd = (Mat_SeqAIJ*)(c->A)->data,*co = (Mat_SeqAIJ*)(c->B)->data;
+
+    for (i=0; i<C->rmap->n; i++) *cmaxr = PetscMax(*cmaxr,(cd->i[i+1]-cd->i[i])+(co->i[i+1]-co->i[i]));
+  }
+  PetscFunctionReturn(0);
+}
+
 PetscErrorCode MatPtAPNumeric_MPIAIJ_MPIXAIJ_allatonce(Mat A,Mat P,PetscInt dof,Mat C)
 {
   PetscErrorCode    ierr;
-  Mat_MPIAIJ        *p=(Mat_MPIAIJ*)P->data,*c=(Mat_MPIAIJ*)C->data;
-  Mat_SeqAIJ        *cd,*co,*po=(Mat_SeqAIJ*)p->B->data,*pd=(Mat_SeqAIJ*)p->A->data;
+  Mat_MPIAIJ        *p=(Mat_MPIAIJ*)P->data;
+  Mat_SeqAIJ        *po=(Mat_SeqAIJ*)p->B->data,*pd=(Mat_SeqAIJ*)p->A->data;
   Mat_APMPI         *ptap;
   PetscHMapIV       hmap;
   PetscInt          i,j,jj,kk,nzi,*c_rmtj,voff,*c_othj,pn,pon,pcstart,pcend,ccstart,ccend,row,am,*poj,*pdj,*apindices,cmaxr,*c_rmtc,*c_rmtjj,*dcc,*occ,loc;
@@ -731,12 +776,15 @@ PetscErrorCode MatPtAPNumeric_MPIAIJ_MPIXAIJ_allatonce(Mat A,Mat P,PetscInt dof,
   PetscInt          offset,ii,pocol;
   const PetscInt    *mappingindices;
   IS                map;
+  PetscLogDouble    mem,memmax;
 
   PetscFunctionBegin;
   MatCheckProduct(C,4);
   ptap = (Mat_APMPI*)C->product->data;
   if (!ptap) SETERRQ(PetscObjectComm((PetscObject)C),PETSC_ERR_ARG_WRONGSTATE,"PtAP cannot be computed. Missing data");
   if (!ptap->P_oth) SETERRQ(PetscObjectComm((PetscObject)C),PETSC_ERR_ARG_WRONGSTATE,"PtAP cannot be reused. Do not call MatProductClear()");
+  ierr = PetscMallocGetCurrentUsage(&mem);CHKERRQ(ierr);
+  ierr = PetscMallocPushMaximumUsage(MAT_PtAPNumeric);CHKERRQ(ierr);
 
   ierr = MatZeroEntries(C);CHKERRQ(ierr);
 
@@ -819,13 +867,7 @@ PetscErrorCode MatPtAPNumeric_MPIAIJ_MPIXAIJ_allatonce(Mat A,Mat P,PetscInt dof,
   ierr = MatGetOwnershipRangeColumn(P,&pcstart,&pcend);CHKERRQ(ierr);
   pcstart = pcstart*dof;
   pcend   = pcend*dof;
-  cd = (Mat_SeqAIJ*)(c->A)->data;
-  co = (Mat_SeqAIJ*)(c->B)->data;
-
-  cmaxr = 0;
-  for (i=0; i<pn; i++) {
-    cmaxr = PetscMax(cmaxr,(cd->i[i+1]-cd->i[i])+(co->i[i+1]-co->i[i]));
-  }
+  ierr = MatPtAPGetMaxRowLength_allatonce(C,ptap->cbs,&cmaxr);CHKERRQ(ierr);
   ierr = PetscCalloc5(cmaxr,&apindices,cmaxr,&apvalues,cmaxr,&apvaluestmp,pn,&dcc,pn,&occ);CHKERRQ(ierr);
   ierr = PetscHMapIVCreate(&hmap);CHKERRQ(ierr);
   ierr = PetscHMapIVResize(hmap,cmaxr);CHKERRQ(ierr);
@@ -870,6 +912,8 @@ PetscErrorCode MatPtAPNumeric_MPIAIJ_MPIXAIJ_allatonce(Mat A,Mat P,PetscInt dof,
   ierr = MatAssemblyEnd(C,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
 
   ptap->reuse = MAT_REUSE_MATRIX;
+  ierr = PetscMallocPopMaximumUsage(MAT_PtAPNumeric,&memmax);CHKERRQ(ierr);
+  ptap->mem_numeric = PetscMax(ptap->mem_numeric,memmax-mem);
   PetscFunctionReturn(0);
 }
 
@@ -886,21 +930,24 @@ PetscErrorCode MatPtAPNumeric_MPIAIJ_MPIAIJ_allatonce(Mat A,Mat P,Mat C)
 PetscErrorCode MatPtAPNumeric_MPIAIJ_MPIXAIJ_allatonce_merged(Mat A,Mat P,PetscInt dof,Mat C)
 {
   PetscErrorCode    ierr;
-  Mat_MPIAIJ        *p=(Mat_MPIAIJ*)P->data,*c=(Mat_MPIAIJ*)C->data;
-  Mat_SeqAIJ        *cd,*co,*po=(Mat_SeqAIJ*)p->B->data,*pd=(Mat_SeqAIJ*)p->A->data;
+  Mat_MPIAIJ        *p=(Mat_MPIAIJ*)P->data;
+  Mat_SeqAIJ        *po=(Mat_SeqAIJ*)p->B->data,*pd=(Mat_SeqAIJ*)p->A->data;
   Mat_APMPI         *ptap;
   PetscHMapIV       hmap;
-  PetscInt          i,j,jj,kk,nzi,dnzi,*c_rmtj,voff,*c_othj,pn,pon,pcstart,pcend,row,am,*poj,*pdj,*apindices,cmaxr,*c_rmtc,*c_rmtjj,loc;
+  PetscInt          i,j,jj,kk,nzi,dnzi,*c_rmtj,voff,*c_othj,pn,pon,pcstart,pcend,row,am,*poj,*pdj,*apindices,cmaxr,cmaxc,*c_rmtc,*c_rmtjj,loc;
   PetscScalar       *c_rmta,*c_otha,*poa,*pda,*apvalues,*apvaluestmp,*c_rmtaa;
   PetscInt          offset,ii,pocol;
   const PetscInt    *mappingindices;
   IS                map;
+  PetscLogDouble    mem,memmax;
 
   PetscFunctionBegin;
   MatCheckProduct(C,4);
   ptap = (Mat_APMPI*)C->product->data;
   if (!ptap) SETERRQ(PetscObjectComm((PetscObject)C),PETSC_ERR_ARG_WRONGSTATE,"PtAP cannot be computed. Missing data");
   if (!ptap->P_oth) SETERRQ(PetscObjectComm((PetscObject)C),PETSC_ERR_ARG_WRONGSTATE,"PtAP cannot be reused. Do not call MatProductClear()");
+  ierr = PetscMallocGetCurrentUsage(&mem);CHKERRQ(ierr);
+  ierr = PetscMallocPushMaximumUsage(MAT_PtAPNumeric);CHKERRQ(ierr);
 
   ierr = MatZeroEntries(C);CHKERRQ(ierr);
 
@@ -925,11 +972,8 @@ PetscErrorCode MatPtAPNumeric_MPIAIJ_MPIXAIJ_allatonce_merged(Mat A,Mat P,PetscI
   for (i=0; i<pon; i++) {
     cmaxr = PetscMax(cmaxr,ptap->c_rmti[i+1]-ptap->c_rmti[i]);
   }
-  cd = (Mat_SeqAIJ*)(c->A)->data;
-  co = (Mat_SeqAIJ*)(c->B)->data;
-  for (i=0; i<pn; i++) {
-    cmaxr = PetscMax(cmaxr,(cd->i[i+1]-cd->i[i])+(co->i[i+1]-co->i[i]));
-  }
+  ierr  = MatPtAPGetMaxRowLength_allatonce(C,ptap->cbs,&cmaxc);CHKERRQ(ierr);
+  cmaxr = PetscMax(cmaxr,cmaxc);
   ierr = PetscCalloc4(cmaxr,&apindices,cmaxr,&apvalues,cmaxr,&apvaluestmp,pon,&c_rmtc);CHKERRQ(ierr);
   ierr = PetscHMapIVCreate(&hmap);CHKERRQ(ierr);
   ierr = PetscHMapIVResize(hmap,cmaxr);CHKERRQ(ierr);
@@ -1016,6 +1060,8 @@ PetscErrorCode MatPtAPNumeric_MPIAIJ_MPIXAIJ_allatonce_merged(Mat A,Mat P,PetscI
   ierr = MatAssemblyEnd(C,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
 
   ptap->reuse = MAT_REUSE_MATRIX;
+  ierr = PetscMallocPopMaximumUsage(MAT_PtAPNumeric,&memmax);CHKERRQ(ierr);
+  ptap->mem_numeric = PetscMax(ptap->mem_numeric,memmax-mem);
   PetscFunctionReturn(0);
 }
 
@@ -1041,13 +1087,14 @@ PetscErrorCode MatPtAPSymbolic_MPIAIJ_MPIXAIJ_allatonce(Mat A,Mat P,PetscInt dof
   PetscSFNode         *iremote;
   PetscInt            rootspacesize,*rootspace,*rootspaceoffsets,nleaves;
   const PetscInt      *rootdegrees;
-  PetscHSetI          ht,oht,*hta,*hto;
+  PetscHSetI          ht,oht,bht = NULL,boht = NULL,*hta,*hto;
   PetscInt            pn,pon,*c_rmtc,i,j,nzi,htsize,htosize,*c_rmtj,off,*c_othj,rcvncols,sendncols,*c_rmtoffsets;
   PetscInt            lidx,*rdj,col,pcstart,pcend,*dnz,*onz,am,arstart,arend,*poj,*pdj;
-  PetscInt            nalg=2,alg=0,offset,ii;
+  PetscInt            nalg=2,alg=0,offset,ii,cbs;
   PetscMPIInt         owner;
   const PetscInt      *mappingindices;
-  PetscBool           flg;
+  PetscBool           flg,baij = PETSC_FALSE;
+  PetscLogDouble      mem,memmax;
   const char          *algTypes[2] = {"overlapping","merged"};
   IS                  map;
   PetscErrorCode      ierr;
@@ -1056,17 +1103,30 @@ PetscErrorCode MatPtAPSymbolic_MPIAIJ_MPIXAIJ_allatonce(Mat A,Mat P,PetscInt dof
   MatCheckProduct(Cmpi,5);
   if (Cmpi->product->data) SETERRQ(PetscObjectComm((PetscObject)Cmpi),PETSC_ERR_PLIB,"Product data not empty");
   ierr = PetscObjectGetComm((PetscObject)A,&comm);CHKERRQ(ierr);
+  ierr = PetscMallocGetCurrentUsage(&mem);CHKERRQ(ierr);
+  ierr = PetscMallocPushMaximumUsage(MAT_PtAPSymbolic);CHKERRQ(ierr);
+
+  /* pick an algorithm */
+  ierr = PetscOptionsBegin(PetscObjectComm((PetscObject)A),((PetscObject)A)->prefix,"MatPtAP","Mat");CHKERRQ(ierr);
+  alg = 0;
+  ierr = PetscOptionsEList("-matptap_allatonce_via","PtAP allatonce numeric approach","MatPtAP",algTypes,nalg,algTypes[alg],&alg,&flg);CHKERRQ(ierr);
+  ierr = PetscOptionsBool("-matptap_allatonce_baij","Store the product as MATMPIBAIJ when P has a block structure","MatPtAP",baij,&baij,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsEnd();CHKERRQ(ierr);
+  /* C inherits the blocks of the columns of P, the rows and columns of C are then hashed by blocks */
+  cbs = dof > 1 ? dof : P->cmap->bs;
+  if (!baij) cbs = 1;
 
   /* Create symbolic parallel matrix Cmpi */
   ierr = MatGetLocalSize(P,NULL,&pn);CHKERRQ(ierr);
   pn *= dof;
   ierr = MatGetType(A,&mtype);CHKERRQ(ierr);
-  ierr = MatSetType(Cmpi,mtype);CHKERRQ(ierr);
+  ierr = MatSetType(Cmpi,cbs > 1 ? MATMPIBAIJ : mtype);CHKERRQ(ierr);
   ierr = MatSetSizes(Cmpi,pn,pn,PETSC_DETERMINE,PETSC_DETERMINE);CHKERRQ(ierr);
 
   ierr = PetscNew(&ptap);CHKERRQ(ierr);
   ptap->reuse = MAT_INITIAL_MATRIX;
   ptap->algType = 2;
+  ptap->cbs = cbs;
 
   /* Get P_oth by taking rows of P (= non-zero cols of local A) from other processors */
   ierr = MatGetBrowsOfAcols_MPIXAIJ(A,P,dof,MAT_INITIAL_MATRIX,&ptap->P_oth);CHKERRQ(ierr);
@@ -1199,16 +1259,20 @@ PetscErrorCode MatPtAPSymbolic_MPIAIJ_MPIXAIJ_allatonce(Mat A,Mat P,PetscInt dof
   /* One to one map */
   ierr = PetscSFReduceBegin(ptap->sf,MPIU_INT,c_rmtj,c_othj,MPI_REPLACE);CHKERRQ(ierr);
 
-  ierr = PetscMalloc2(pn,&dnz,pn,&onz);CHKERRQ(ierr);
+  ierr = PetscMalloc2(pn/cbs,&dnz,pn/cbs,&onz);CHKERRQ(ierr);
   ierr = PetscHSetICreate(&oht);CHKERRQ(ierr);
   ierr = MatGetOwnershipRangeColumn(P,&pcstart,&pcend);CHKERRQ(ierr);
   pcstart *= dof;
   pcend   *= dof;
-  ierr = PetscMalloc2(pn,&hta,pn,&hto);CHKERRQ(ierr);
-  for (i=0; i<pn; i++) {
+  ierr = PetscMalloc2(pn/cbs,&hta,pn/cbs,&hto);CHKERRQ(ierr);
+  for (i=0; i<pn/cbs; i++) {
     ierr = PetscHSetICreate(&hta[i]);CHKERRQ(ierr);
     ierr = PetscHSetICreate(&hto[i]);CHKERRQ(ierr);
   }
+  if (cbs > 1) {
+    ierr = PetscHSetICreate(&bht);CHKERRQ(ierr);
+    ierr = PetscHSetICreate(&boht);CHKERRQ(ierr);
+  }
   /* Work on local part */
   /* 4) Pass 1: Estimate memory for C_loc */
   for (i=0; i<am && pn; i++) {
@@ -1225,9 +1289,20 @@ PetscErrorCode MatPtAPSymbolic_MPIAIJ_MPIXAIJ_allatonce(Mat A,Mat P,PetscInt dof
     if (!(htsize+htosize)) continue;
     /* Form C(ii, :) */
     pdj = pd->j + pd->i[ii];
-    for (j=0; j<nzi; j++) {
-      ierr = PetscHSetIUpdate(hta[pdj[j]*dof+offset],ht);CHKERRQ(ierr);
-      ierr = PetscHSetIUpdate(hto[pdj[j]*dof+offset],oht);CHKERRQ(ierr);
+    if (cbs > 1) {
+      ierr = PetscHSetIClear(bht);CHKERRQ(ierr);
+      ierr = PetscHSetIClear(boht);CHKERRQ(ierr);
+      ierr = MatPtAPAddBlockColumns_private(ht,cbs,bht);CHKERRQ(ierr);
+      ierr = MatPtAPAddBlockColumns_private(oht,cbs,boht);CHKERRQ(ierr);
+      for (j=0; j<nzi; j++) {
+        ierr = PetscHSetIUpdate(hta[(pdj[j]*dof+offset)/cbs],bht);CHKERRQ(ierr);
+        ierr = PetscHSetIUpdate(hto[(pdj[j]*dof+offset)/cbs],boht);CHKERRQ(ierr);
+      }
+    } else {
+      for (j=0; j<nzi; j++) {
+        ierr = PetscHSetIUpdate(hta[pdj[j]*dof+offset],ht);CHKERRQ(ierr);
+        ierr = PetscHSetIUpdate(hto[pdj[j]*dof+offset],oht);CHKERRQ(ierr);
+      }
     }
   }
 
@@ -1235,6 +1310,10 @@ PetscErrorCode MatPtAPSymbolic_MPIAIJ_MPIXAIJ_allatonce(Mat A,Mat P,PetscInt dof
 
   ierr = PetscHSetIDestroy(&ht);CHKERRQ(ierr);
   ierr = PetscHSetIDestroy(&oht);CHKERRQ(ierr);
+  if (cbs > 1) {
+    ierr = PetscHSetIDestroy(&bht);CHKERRQ(ierr);
+    ierr = PetscHSetIDestroy(&boht);CHKERRQ(ierr);
+  }
 
   /* Get remote data */
   ierr = PetscSFReduceEnd(ptap->sf,MPIU_INT,c_rmtj,c_othj,MPI_REPLACE);CHKERRQ(ierr);
@@ -1247,11 +1326,13 @@ PetscErrorCode MatPtAPSymbolic_MPIAIJ_MPIXAIJ_allatonce(Mat A,Mat P,PetscInt dof
       col = rdj[j];
       /* diag part */
       if (col>=pcstart && col<pcend) {
-        ierr = PetscHSetIAdd(hta[i],col);CHKERRQ(ierr);
+        ierr = PetscHSetIAdd(hta[i/cbs],col/cbs);CHKERRQ(ierr);
       } else { /* off diag */
-        ierr = PetscHSetIAdd(hto[i],col);CHKERRQ(ierr);
+        ierr = PetscHSetIAdd(hto[i/cbs],col/cbs);CHKERRQ(ierr);
       }
     }
+  }
+  for (i = 0; i < pn/cbs; i++) {
     ierr = PetscHSetIGetSize(hta[i],&htsize);CHKERRQ(ierr);
     dnz[i] = htsize;
     ierr = PetscHSetIDestroy(&hta[i]);CHKERRQ(ierr);
@@ -1266,7 +1347,11 @@ PetscErrorCode MatPtAPSymbolic_MPIAIJ_MPIXAIJ_allatonce(Mat A,Mat P,PetscInt dof
   /* local sizes and preallocation */
   ierr = MatSetSizes(Cmpi,pn,pn,PETSC_DETERMINE,PETSC_DETERMINE);CHKERRQ(ierr);
   ierr = MatSetBlockSizes(Cmpi,dof>1? dof: P->cmap->bs,dof>1? dof: P->cmap->bs);CHKERRQ(ierr);
-  ierr = MatMPIAIJSetPreallocation(Cmpi,0,dnz,0,onz);CHKERRQ(ierr);
+  if (cbs > 1) {
+    ierr = MatMPIBAIJSetPreallocation(Cmpi,cbs,0,dnz,0,onz);CHKERRQ(ierr);
+  } else {
+    ierr = MatMPIAIJSetPreallocation(Cmpi,0,dnz,0,onz);CHKERRQ(ierr);
+  }
   ierr = MatSetUp(Cmpi);CHKERRQ(ierr);
   ierr = PetscFree2(dnz,onz);CHKERRQ(ierr);
 
@@ -1277,11 +1362,8 @@ PetscErrorCode MatPtAPSymbolic_MPIAIJ_MPIXAIJ_allatonce(Mat A,Mat P,PetscInt dof
 
   /* Cmpi is not ready for use - assembly will be done by MatPtAPNumeric() */
   Cmpi->assembled = PETSC_FALSE;
-  /* pick an algorithm */
-  ierr = PetscOptionsBegin(PetscObjectComm((PetscObject)A),((PetscObject)A)->prefix,"MatPtAP","Mat");CHKERRQ(ierr);
-  alg = 0;
-  ierr = PetscOptionsEList("-matptap_allatonce_via","PtAP allatonce numeric approach","MatPtAP",algTypes,nalg,algTypes[alg],&alg,&flg);CHKERRQ(ierr);
-  ierr = PetscOptionsEnd();CHKERRQ(ierr);
+  ierr = PetscMallocPopMaximumUsage(MAT_PtAPSymbolic,&memmax);CHKERRQ(ierr);
+  ptap->mem_symbolic = memmax-mem;
   switch (alg) {
     case 0:
       Cmpi->ops->ptapnumeric = MatPtAPNumeric_MPIAIJ_MPIAIJ_allatonce;
@@ -1315,12 +1397,13 @@ PetscErrorCode MatPtAPSymbolic_MPIAIJ_MPIXAIJ_allatonce_merged(Mat A,Mat P,Petsc
   PetscSFNode         *iremote;
   PetscInt            rootspacesize,*rootspace,*rootspaceoffsets,nleaves;
   const PetscInt      *rootdegrees;
-  PetscHSetI          ht,oht,*hta,*hto,*htd;
+  PetscHSetI          ht,oht,bht = NULL,boht = NULL,*hta,*hto,*htd;
   PetscInt            pn,pon,*c_rmtc,i,j,nzi,dnzi,htsize,htosize,*c_rmtj,off,*c_othj,rcvncols,sendncols,*c_rmtoffsets;
   PetscInt            lidx,*rdj,col,pcstart,pcend,*dnz,*onz,am,arstart,arend,*poj,*pdj;
-  PetscInt            nalg=2,alg=0,offset,ii;
+  PetscInt            nalg=2,alg=0,offset,ii,cbs;
   PetscMPIInt         owner;
-  PetscBool           flg;
+  PetscBool           flg,baij = PETSC_FALSE;
+  PetscLogDouble      mem,memmax;
   const char          *algTypes[2] = {"merged","overlapping"};
   const PetscInt      *mappingindices;
   IS                  map;
@@ -1330,17 +1413,30 @@ PetscErrorCode MatPtAPSymbolic_MPIAIJ_MPIXAIJ_allatonce_merged(Mat A,Mat P,Petsc
   MatCheckProduct(Cmpi,5);
   if (Cmpi->product->data) SETERRQ(PetscObjectComm((PetscObject)Cmpi),PETSC_ERR_PLIB,"Product data not empty");
   ierr = PetscObjectGetComm((PetscObject)A,&comm);CHKERRQ(ierr);
+  ierr = PetscMallocGetCurrentUsage(&mem);CHKERRQ(ierr);
+  ierr = PetscMallocPushMaximumUsage(MAT_PtAPSymbolic);CHKERRQ(ierr);
+
+  /* pick an algorithm */
+  ierr = PetscOptionsBegin(PetscObjectComm((PetscObject)A),((PetscObject)A)->prefix,"MatPtAP","Mat");CHKERRQ(ierr);
+  alg = 0;
+  ierr = PetscOptionsEList("-matptap_allatonce_via","PtAP allatonce numeric approach","MatPtAP",algTypes,nalg,algTypes[alg],&alg,&flg);CHKERRQ(ierr);
+  ierr = PetscOptionsBool("-matptap_allatonce_baij","Store the product as MATMPIBAIJ when P has a block structure","MatPtAP",baij,&baij,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsEnd();CHKERRQ(ierr);
+  /* C inherits the blocks of the columns of P, the local rows and columns of C are then hashed by blocks */
+  cbs = dof > 1 ? dof : P->cmap->bs;
+  if (!baij) cbs = 1;
 
   /* Create symbolic parallel matrix Cmpi */
   ierr = MatGetLocalSize(P,NULL,&pn);CHKERRQ(ierr);
   pn *= dof;
   ierr = MatGetType(A,&mtype);CHKERRQ(ierr);
-  ierr = MatSetType(Cmpi,mtype);CHKERRQ(ierr);
+  ierr = MatSetType(Cmpi,cbs > 1 ? MATMPIBAIJ : mtype);CHKERRQ(ierr);
   ierr = MatSetSizes(Cmpi,pn,pn,PETSC_DETERMINE,PETSC_DETERMINE);CHKERRQ(ierr);
 
   ierr        = PetscNew(&ptap);CHKERRQ(ierr);
   ptap->reuse = MAT_INITIAL_MATRIX;
   ptap->algType = 3;
+  ptap->cbs     = cbs;
 
   /* 0) Get P_oth by taking rows of P (= non-zero cols of local A) from other processors */
   ierr = MatGetBrowsOfAcols_MPIXAIJ(A,P,dof,MAT_INITIAL_MATRIX,&ptap->P_oth);CHKERRQ(ierr);
@@ -1362,11 +1458,15 @@ PetscErrorCode MatPtAPSymbolic_MPIAIJ_MPIXAIJ_allatonce_merged(Mat A,Mat P,Petsc
   /* Create hash table to merge all columns for C(i, :) */
   ierr = PetscHSetICreate(&ht);CHKERRQ(ierr);
   ierr = PetscHSetICreate(&oht);CHKERRQ(ierr);
-  ierr = PetscMalloc2(pn,&htd,pn,&hto);CHKERRQ(ierr);
-  for (i=0; i<pn; i++) {
+  ierr = PetscMalloc2(pn/cbs,&htd,pn/cbs,&hto);CHKERRQ(ierr);
+  for (i=0; i<pn/cbs; i++) {
     ierr = PetscHSetICreate(&htd[i]);CHKERRQ(ierr);
     ierr = PetscHSetICreate(&hto[i]);CHKERRQ(ierr);
   }
+  if (cbs > 1) {
+    ierr = PetscHSetICreate(&bht);CHKERRQ(ierr);
+    ierr = PetscHSetICreate(&boht);CHKERRQ(ierr);
+  }
 
   ierr = ISGetIndices(map,&mappingindices);CHKERRQ(ierr);
   ptap->c_rmti[0] = 0;
@@ -1397,9 +1497,20 @@ PetscErrorCode MatPtAPSymbolic_MPIAIJ_MPIXAIJ_allatonce_merged(Mat A,Mat P,Petsc
 
     /* Form local C(ii, :) */
     pdj = pd->j + pd->i[ii];
-    for (j=0; j<dnzi; j++) {
-      ierr = PetscHSetIUpdate(htd[pdj[j]*dof+offset],ht);CHKERRQ(ierr);
-      ierr = PetscHSetIUpdate(hto[pdj[j]*dof+offset],oht);CHKERRQ(ierr);
+    if (cbs > 1) {
+      ierr = PetscHSetIClear(bht);CHKERRQ(ierr);
+      ierr = PetscHSetIClear(boht);CHKERRQ(ierr);
+      ierr = MatPtAPAddBlockColumns_private(ht,cbs,bht);CHKERRQ(ierr);
+      ierr = MatPtAPAddBlockColumns_private(oht,cbs,boht);CHKERRQ(ierr);
+      for (j=0; j<dnzi; j++) {
+        ierr = PetscHSetIUpdate(htd[(pdj[j]*dof+offset)/cbs],bht);CHKERRQ(ierr);
+        ierr = PetscHSetIUpdate(hto[(pdj[j]*dof+offset)/cbs],boht);CHKERRQ(ierr);
+      }
+    } else {
+      for (j=0; j<dnzi; j++) {
+        ierr = PetscHSetIUpdate(htd[pdj[j]*dof+offset],ht);CHKERRQ(ierr);
+        ierr = PetscHSetIUpdate(hto[pdj[j]*dof+offset],oht);CHKERRQ(ierr);
+      }
     }
   }
 
@@ -1407,6 +1518,10 @@ PetscErrorCode MatPtAPSymbolic_MPIAIJ_MPIXAIJ_allatonce_merged(Mat A,Mat P,Petsc
 
   ierr = PetscHSetIDestroy(&ht);CHKERRQ(ierr);
   ierr = PetscHSetIDestroy(&oht);CHKERRQ(ierr);
+  if (cbs > 1) {
+    ierr = PetscHSetIDestroy(&bht);CHKERRQ(ierr);
+    ierr = PetscHSetIDestroy(&boht);CHKERRQ(ierr);
+  }
 
   for (i=0; i<pon; i++) {
     ierr = PetscHSetIGetSize(hta[i],&htsize);CHKERRQ(ierr);
@@ -1499,7 +1614,7 @@ PetscErrorCode MatPtAPSymbolic_MPIAIJ_MPIXAIJ_allatonce_merged(Mat A,Mat P,Petsc
   /* Get remote data */
   ierr = PetscSFReduceEnd(ptap->sf,MPIU_INT,c_rmtj,c_othj,MPI_REPLACE);CHKERRQ(ierr);
   ierr = PetscFree(c_rmtj);CHKERRQ(ierr);
-  ierr = PetscMalloc2(pn,&dnz,pn,&onz);CHKERRQ(ierr);
+  ierr = PetscMalloc2(pn/cbs,&dnz,pn/cbs,&onz);CHKERRQ(ierr);
   ierr = MatGetOwnershipRangeColumn(P,&pcstart,&pcend);CHKERRQ(ierr);
   pcstart *= dof;
   pcend   *= dof;
@@ -1510,11 +1625,13 @@ PetscErrorCode MatPtAPSymbolic_MPIAIJ_MPIXAIJ_allatonce_merged(Mat A,Mat P,Petsc
       col =  rdj[j];
       /* diag part */
       if (col>=pcstart && col<pcend) {
-        ierr = PetscHSetIAdd(htd[i],col);CHKERRQ(ierr);
+        ierr = PetscHSetIAdd(htd[i/cbs],col/cbs);CHKERRQ(ierr);
       } else { /* off diag */
-        ierr = PetscHSetIAdd(hto[i],col);CHKERRQ(ierr);
+        ierr = PetscHSetIAdd(hto[i/cbs],col/cbs);CHKERRQ(ierr);
       }
     }
+  }
+  for (i = 0; i < pn/cbs; i++) {
     ierr = PetscHSetIGetSize(htd[i],&htsize);CHKERRQ(ierr);
     dnz[i] = htsize;
     ierr = PetscHSetIDestroy(&htd[i]);CHKERRQ(ierr);
@@ -1529,7 +1646,11 @@ PetscErrorCode MatPtAPSymbolic_MPIAIJ_MPIXAIJ_allatonce_merged(Mat A,Mat P,Petsc
   /* local sizes and preallocation */
   ierr = MatSetSizes(Cmpi,pn,pn,PETSC_DETERMINE,PETSC_DETERMINE);CHKERRQ(ierr);
   ierr = MatSetBlockSizes(Cmpi, dof>1? dof: P->cmap->bs,dof>1? dof: P->cmap->bs);CHKERRQ(ierr);
-  ierr = MatMPIAIJSetPreallocation(Cmpi,0,dnz,0,onz);CHKERRQ(ierr);
+  if (cbs > 1) {
+    ierr = MatMPIBAIJSetPreallocation(Cmpi,cbs,0,dnz,0,onz);CHKERRQ(ierr);
+  } else {
+    ierr = MatMPIAIJSetPreallocation(Cmpi,0,dnz,0,onz);CHKERRQ(ierr);
+  }
   ierr = PetscFree2(dnz,onz);CHKERRQ(ierr);
 
   /* attach the supporting struct to Cmpi for reuse */
@@ -1539,11 +1660,8 @@ PetscErrorCode MatPtAPSymbolic_MPIAIJ_MPIXAIJ_allatonce_merged(Mat A,Mat P,Petsc
 
   /* Cmpi is not ready for use - assembly will be done by MatPtAPNumeric() */
   Cmpi->assembled = PETSC_FALSE;
-  /* pick an algorithm */
-  ierr = PetscOptionsBegin(PetscObjectComm((PetscObject)A),((PetscObject)A)->prefix,"MatPtAP","Mat");CHKERRQ(ierr);
-  alg = 0;
-  ierr = PetscOptionsEList("-matptap_allatonce_via","PtAP allatonce numeric approach","MatPtAP",algTypes,nalg,algTypes[alg],&alg,&flg);CHKERRQ(ierr);
-  ierr = PetscOptionsEnd();CHKERRQ(ierr);
+  ierr = PetscMallocPopMaximumUsage(MAT_PtAPSymbolic,&memmax);CHKERRQ(ierr);
+  ptap->mem_symbolic = memmax-mem;
   switch (alg) {
     case 0:
       Cmpi->ops->ptapnumeric = MatPtAPNumeric_MPIAIJ_MPIAIJ_allatonce_merged;
@@ -399,8 +399,8 @@ PetscErrorCode MatConvertToTriples_seqsell_seqaij(Mat A,PetscInt shift,MatReuse
     nz   = a->sliidx[a->totalslices];
     ierr = PetscMalloc2(nz,&row,nz,&col);CHKERRQ(ierr);
     for (i=k=0; i<a->totalslices; i++) {
-      for (j=a->sliidx[i],r=0; j<a->sliidx[i+1]; j++,r=((r+1)&0x07)) {
-        ierr = PetscMUMPSIntCast(8*i+r+shift,&row[k++]);CHKERRQ(ierr);
+      for (j=a->sliidx[i],r=0; j<a->sliidx[i+1]; j++,r=((r+1)%a->sliceheight)) {
+        ierr = PetscMUMPSIntCast(MatSeqSELLRowOfPosition(a,a->sliceheight*i+r)+shift,&row[k++]);CHKERRQ(ierr);
       }
     }
     for (i=0;i<nz;i++) {ierr = PetscMUMPSIntCast(a->colidx[i]+shift,&col[i]);CHKERRQ(ierr);}
@@ -1148,6 +1148,9 @@ PetscErrorCode MatView_SeqAIJ(Mat A,PetscViewer viewer)
     ierr = MatView_SeqAIJ_Draw(A,viewer);CHKERRQ(ierr);
   }
   ierr = MatView_SeqAIJ_Inode(A,viewer);CHKERRQ(ierr);
+  ierr = MatView_SeqAIJ_Autotune(A,viewer);CHKERRQ(ierr);
+  ierr = MatView_SeqAIJ_SolveLevels(A,viewer);CHKERRQ(ierr);
+  ierr = MatView_SeqAIJ_SORMulticolor(A,viewer);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
@@ -1166,6 +1169,7 @@ PetscErrorCode MatAssemblyEnd_SeqAIJ(Mat A,MatAssemblyType mode)
   if (A->was_assembled && A->ass_nonzerostate == A->nonzerostate) {
     /* we need to respect users asking to use or not the inodes routine in between matrix assemblies */
     ierr = MatAssemblyEnd_SeqAIJ_Inode(A,mode);CHKERRQ(ierr);
+    ierr = MatSeqAIJAutotuneMult(A);CHKERRQ(ierr);
     PetscFunctionReturn(0);
   }
 
@@ -1218,6 +1222,7 @@ PetscErrorCode MatAssemblyEnd_SeqAIJ(Mat A,MatAssemblyType mode)
     ierr = MatCheckCompressedRow(A,a->nonzerorowcnt,&a->compressedrow,a->i,m,ratio);CHKERRQ(ierr);
   }
   ierr = MatAssemblyEnd_SeqAIJ_Inode(A,mode);CHKERRQ(ierr);
+  ierr = MatSeqAIJAutotuneMult(A);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
@@ -1295,6 +1300,9 @@ PetscErrorCode MatDestroy_SeqAIJ(Mat A)
   ierr = PetscFree2(a->compressedrow.i,a->compressedrow.rindex);CHKERRQ(ierr);
 
   ierr = MatDestroy_SeqAIJ_Inode(A);CHKERRQ(ierr);
+  ierr = MatDestroy_SeqAIJ_Autotune(A);CHKERRQ(ierr);
+  ierr = MatDestroy_SeqAIJ_SolveLevels(A);CHKERRQ(ierr);
+  ierr = MatDestroy_SeqAIJ_SORMulticolor(A);CHKERRQ(ierr);
   ierr = PetscFree(A->data);CHKERRQ(ierr);
 
   /* MatMatMultNumeric_SeqAIJ_SeqAIJ_Sorted may allocate this.
@@ -1398,6 +1406,12 @@ PetscErrorCode MatSetOption_SeqAIJ(Mat A,MatOption op,PetscBool flg)
   case MAT_FORM_EXPLICIT_TRANSPOSE:
     A->form_explicit_transpose = flg;
     break;
+  case MAT_AUTOTUNE_MULT:
+    ierr = MatSetOption_SeqAIJ_Autotune(A,flg);CHKERRQ(ierr);
+    break;
+  case MAT_SOR_MULTICOLOR:
+    a->sormulticolor.use = flg;
+    break;
   default:
     SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_SUP,"unknown option %d",op);
   }
@@ -1520,7 +1534,7 @@ PetscErrorCode MatMult_SeqAIJ(Mat A,Vec xx,Vec yy)
 #endif
 
   PetscFunctionBegin;
-  if (a->inode.use && a->inode.checked) {
+  if (a->inode.use && a->inode.checked && !(a->autotune.use && a->autotune.kernel == MAT_SEQAIJ_MULT_CSR)) {
     ierr = MatMult_SeqAIJ_Inode(A,xx,yy);CHKERRQ(ierr);
     PetscFunctionReturn(0);
   }
@@ -1676,7 +1690,7 @@ PetscErrorCode MatMultAdd_SeqAIJ(Mat A,Vec xx,Vec yy,Vec zz)
   PetscBool         usecprow=a->compressedrow.use;
 
   PetscFunctionBegin;
-  if (a->inode.use && a->inode.checked) {
+  if (a->inode.use && a->inode.checked && !(a->autotune.use && a->autotune.kernel == MAT_SEQAIJ_MULT_CSR)) {
     ierr = MatMultAdd_SeqAIJ_Inode(A,xx,yy,zz);CHKERRQ(ierr);
     PetscFunctionReturn(0);
   }
@@ -1983,6 +1997,10 @@ PetscErrorCode MatSOR_SeqAIJ(Mat A,Vec bb,PetscReal omega,MatSORType flag,PetscR
   const PetscInt    *idx,*diag;
 
   PetscFunctionBegin;
+  if (a->sormulticolor.use && !(flag & SOR_EISENSTAT) && flag != SOR_APPLY_UPPER && flag != SOR_APPLY_LOWER) {
+    ierr = MatSOR_SeqAIJ_Multicolor(A,bb,omega,flag,fshift,its,lits,xx);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
   if (a->inode.use && a->inode.checked && omega == 1.0 && fshift == 0.0) {
     ierr = MatSOR_SeqAIJ_Inode(A,bb,omega,flag,fshift,its,lits,xx);CHKERRQ(ierr);
     PetscFunctionReturn(0);
@@ -3090,6 +3108,7 @@ PetscErrorCode MatCopy_SeqAIJ(Mat A,Mat B,MatStructure str)
     ierr = MatSeqAIJGetArrayRead(A,&aa);CHKERRQ(ierr);
     if (a->i[A->rmap->n] != b->i[B->rmap->n]) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_ARG_INCOMP,"Number of nonzeros in two matrices are different %D != %D",a->i[A->rmap->n],b->i[B->rmap->n]);
     ierr = PetscArraycpy(b->a,aa,a->i[A->rmap->n]);CHKERRQ(ierr);
+    ierr = MatSeqAIJInvalidateDiagonal(B);CHKERRQ(ierr);
     ierr = PetscObjectStateIncrease((PetscObject)B);CHKERRQ(ierr);
     ierr = MatSeqAIJRestoreArrayRead(A,&aa);CHKERRQ(ierr);
   } else {
@@ -3490,7 +3509,7 @@ PetscErrorCode MatInvertBlockDiagonal_SeqAIJ(Mat A,const PetscScalar **values)
     break;
   case 7:
     for (i=0; i<mbs; i++) {
-      ij[0] = 7*i; ij[1] = 7*i + 1; ij[2] = 7*i + 2; ij[3] = 7*i + 3; ij[4] = 7*i + 4; ij[5] = 7*i + 5; ij[5] = 7*i + 6;
+      ij[0] = 7*i; ij[1] = 7*i + 1; ij[2] = 7*i + 2; ij[3] = 7*i + 3; ij[4] = 7*i + 4; ij[5] = 7*i + 5; ij[6] = 7*i + 6;
       ierr  = MatGetValues(A,7,ij,7,ij,diag);CHKERRQ(ierr);
       ierr  = PetscKernel_A_gets_inverse_A_7(diag,shift,allowzeropivot,&zeropivotdetected);CHKERRQ(ierr);
       if (zeropivotdetected) A->factorerrortype = MAT_FACTOR_NUMERIC_ZEROPIVOT;
@@ -4646,6 +4665,7 @@ PETSC_EXTERN PetscErrorCode MatCreate_SeqAIJ(Mat B)
   ierr = PetscObjectComposeFunction((PetscObject)B,"MatConvert_seqaij_seqaijkokkos_C",MatConvert_SeqAIJ_SeqAIJKokkos);CHKERRQ(ierr);
 #endif
   ierr = PetscObjectComposeFunction((PetscObject)B,"MatConvert_seqaij_seqaijcrl_C",MatConvert_SeqAIJ_SeqAIJCRL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)B,"MatConvert_seqaij_seqaijsingle_C",MatConvert_SeqAIJ_SeqAIJSingle);CHKERRQ(ierr);
 #if defined(PETSC_HAVE_ELEMENTAL)
   ierr = PetscObjectComposeFunction((PetscObject)B,"MatConvert_seqaij_elemental_C",MatConvert_SeqAIJ_Elemental);CHKERRQ(ierr);
 #endif
@@ -4763,6 +4783,7 @@ PetscErrorCode MatDuplicateNoCreate_SeqAIJ(Mat C,Mat A,MatDuplicateOption cpvalu
   C->nonzerostate  = A->nonzerostate;
 
   ierr = MatDuplicate_SeqAIJ_Inode(A,cpvalues,&C);CHKERRQ(ierr);
+  ierr = MatDuplicate_SeqAIJ_Autotune(A,C);CHKERRQ(ierr);
   ierr = PetscFunctionListDuplicate(((PetscObject)A)->qlist,&((PetscObject)C)->qlist);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
@@ -5264,6 +5285,7 @@ PetscErrorCode  MatSeqAIJRegisterAll(void)
   ierr = MatSeqAIJRegister(MATSEQAIJCRL,      MatConvert_SeqAIJ_SeqAIJCRL);CHKERRQ(ierr);
   ierr = MatSeqAIJRegister(MATSEQAIJPERM,     MatConvert_SeqAIJ_SeqAIJPERM);CHKERRQ(ierr);
   ierr = MatSeqAIJRegister(MATSEQAIJSELL,     MatConvert_SeqAIJ_SeqAIJSELL);CHKERRQ(ierr);
+  ierr = MatSeqAIJRegister(MATSEQAIJSINGLE,   MatConvert_SeqAIJ_SeqAIJSingle);CHKERRQ(ierr);
 #if defined(PETSC_HAVE_MKL_SPARSE)
   ierr = MatSeqAIJRegister(MATSEQAIJMKL,      MatConvert_SeqAIJ_SeqAIJMKL);CHKERRQ(ierr);
 #endif
@@ -99,6 +99,63 @@ typedef struct {
   PetscObjectState mat_nonzerostate;               /* non-zero state when inodes were checked for */
 } Mat_SeqAIJ_Inode;
 
+/* Candidate MatMult() kernels for MAT_AUTOTUNE_MULT; MAT_SEQAIJ_MULT_INODE is also the default dispatch of MatMult_SeqAIJ() */
+typedef enum {MAT_SEQAIJ_MULT_CSR,MAT_SEQAIJ_MULT_INODE,MAT_SEQAIJ_MULT_SELL,MAT_SEQAIJ_MULT_PERM,MAT_SEQAIJ_MULT_NKERNELS} MatSeqAIJMultKernel;
+PETSC_INTERN const char *const MatSeqAIJMultKernels[];
+
+/* Info about the autotuned MatMult() kernel helper class for SeqAIJ */
+typedef struct {
+  PetscBool           use;                              /* time the candidate kernels at assembly and install the fastest */
+  PetscBool           tuned;                            /* kernel and time[] hold the result for the pattern mat_nonzerostate */
+  PetscObjectState    mat_nonzerostate;                 /* non-zero state when the kernels were timed */
+  MatSeqAIJMultKernel kernel;                           /* kernel installed in A->ops->mult and A->ops->multadd */
+  PetscLogDouble      time[MAT_SEQAIJ_MULT_NKERNELS];   /* best time of each kernel, negative if it was not a candidate */
+  Mat                 S;                                /* "shadow" matrix used by the SELL and PERM kernels */
+  PetscObjectState    state;                            /* state of the matrix when the shadow was last updated */
+} Mat_SeqAIJ_Autotune;
+
+PETSC_INTERN PetscErrorCode MatSeqAIJAutotuneMult(Mat);
+PETSC_INTERN PetscErrorCode MatSetOption_SeqAIJ_Autotune(Mat,PetscBool);
+PETSC_INTERN PetscErrorCode MatView_SeqAIJ_Autotune(Mat,PetscViewer);
+PETSC_INTERN PetscErrorCode MatDuplicate_SeqAIJ_Autotune(Mat,Mat);
+PETSC_INTERN PetscErrorCode MatDestroy_SeqAIJ_Autotune(Mat);
+
+/* Rows of a triangular factor sorted by level, for the level-scheduled MatSolve() of LU factors */
+typedef struct {
+  PetscInt  nlevels;                                    /* number of levels */
+  PetscInt  ngroups;                                    /* number of groups of rows, separated by barriers */
+  PetscInt  *groups;                                    /* rows[groups[g]:groups[g+1]] are the rows of group g */
+  PetscBool *parallel;                                  /* a parallel group is one level solved by all threads, the others are solved by one thread */
+  PetscInt  *rows;                                      /* rows sorted by level */
+} Mat_SeqAIJ_TriLevels;
+
+/* Info about the level scheduling of the triangular solves helper class for SeqAIJ factors */
+typedef struct {
+  PetscBool            use;                             /* MatSolve_SeqAIJ_Levels() is installed */
+  PetscBool            identity;                        /* the row and column permutations are the identity */
+  PetscInt             minwidth;                        /* levels with fewer rows are merged */
+  Mat_SeqAIJ_TriLevels lower,upper;
+} Mat_SeqAIJ_SolveLevels;
+
+PETSC_INTERN PetscErrorCode MatSeqAIJSolveLevelsSetUp(Mat);
+PETSC_INTERN PetscErrorCode MatSolve_SeqAIJ_Levels(Mat,Vec,Vec);
+PETSC_INTERN PetscErrorCode MatView_SeqAIJ_SolveLevels(Mat,PetscViewer);
+PETSC_INTERN PetscErrorCode MatDestroy_SeqAIJ_SolveLevels(Mat);
+
+/* Info about the multicolor SOR helper class for SeqAIJ, set with MAT_SOR_MULTICOLOR */
+typedef struct {
+  PetscBool        use;                                 /* MatSOR() sweeps the rows color by color */
+  PetscInt         ncolors;                             /* number of colors, 0 if the rows are not yet colored */
+  PetscInt         *colors;                             /* rows[colors[c]:colors[c+1]] are the rows of color c */
+  PetscInt         *rows;                               /* rows sorted by color */
+  PetscObjectState mat_nonzerostate;                    /* non-zero state when the rows were colored */
+} Mat_SeqAIJ_SORMulticolor;
+
+PETSC_INTERN PetscErrorCode MatSOR_SeqAIJ_Multicolor(Mat,Vec,PetscReal,MatSORType,PetscReal,PetscInt,PetscInt,Vec);
+PETSC_INTERN PetscErrorCode MatView_SeqAIJ_SORMulticolor(Mat,PetscViewer);
+PETSC_INTERN PetscErrorCode MatDestroy_SeqAIJ_SORMulticolor(Mat);
+PETSC_INTERN PetscErrorCode MatInvertDiagonal_SeqAIJ(Mat,PetscScalar,PetscScalar);
+
 PETSC_INTERN PetscErrorCode MatView_SeqAIJ_Inode(Mat,PetscViewer);
 PETSC_INTERN PetscErrorCode MatAssemblyEnd_SeqAIJ_Inode(Mat,MatAssemblyType);
 PETSC_INTERN PetscErrorCode MatDestroy_SeqAIJ_Inode(Mat);
@@ -114,6 +171,9 @@ PETSC_INTERN PetscErrorCode MatSeqAIJRestoreArray_SeqAIJ(Mat,PetscScalar**);
 typedef struct {
   SEQAIJHEADER(MatScalar);
   Mat_SeqAIJ_Inode inode;
+  Mat_SeqAIJ_Autotune autotune;
+  Mat_SeqAIJ_SolveLevels solvelevels;
+  Mat_SeqAIJ_SORMulticolor sormulticolor;
   MatScalar        *saved_values;             /* location for stashing nonzero values of matrix */
 
   PetscScalar *idiag,*mdiag,*ssor_work;       /* inverse of diagonal entries, diagonal values and workspace for Eisenstat trick */
@@ -290,12 +350,14 @@ PETSC_INTERN PetscErrorCode MatMatMultSymbolic_SeqAIJ_SeqAIJ_Heap(Mat,Mat,PetscR
 PETSC_INTERN PetscErrorCode MatMatMultSymbolic_SeqAIJ_SeqAIJ_BTHeap(Mat,Mat,PetscReal,Mat);
 PETSC_INTERN PetscErrorCode MatMatMultSymbolic_SeqAIJ_SeqAIJ_RowMerge(Mat,Mat,PetscReal,Mat);
 PETSC_INTERN PetscErrorCode MatMatMultSymbolic_SeqAIJ_SeqAIJ_LLCondensed(Mat,Mat,PetscReal,Mat);
+PETSC_INTERN PetscErrorCode MatMatMultSymbolic_SeqAIJ_SeqAIJ_HashOMP(Mat,Mat,PetscReal,Mat);
 #if defined(PETSC_HAVE_HYPRE)
 PETSC_INTERN PetscErrorCode MatMatMultSymbolic_AIJ_AIJ_wHYPRE(Mat,Mat,PetscReal,Mat);
 #endif
 
 PETSC_INTERN PetscErrorCode MatMatMultNumeric_SeqAIJ_SeqAIJ(Mat,Mat,Mat);
 PETSC_INTERN PetscErrorCode MatMatMultNumeric_SeqAIJ_SeqAIJ_Sorted(Mat,Mat,Mat);
+PETSC_INTERN PetscErrorCode MatMatMultNumeric_SeqAIJ_SeqAIJ_HashOMP(Mat,Mat,Mat);
 
 PETSC_INTERN PetscErrorCode MatMatMultNumeric_SeqDense_SeqAIJ(Mat,Mat,Mat);
 PETSC_INTERN PetscErrorCode MatMatMultNumeric_SeqAIJ_SeqAIJ_Scalable(Mat,Mat,Mat);
@@ -357,6 +419,8 @@ PETSC_INTERN PetscErrorCode MatConvert_SeqAIJ_SeqSBAIJ(Mat,MatType,MatReuse,Mat*
 PETSC_INTERN PetscErrorCode MatConvert_SeqAIJ_SeqBAIJ(Mat,MatType,MatReuse,Mat*);
 PETSC_INTERN PetscErrorCode MatConvert_SeqAIJ_SeqDense(Mat,MatType,MatReuse,Mat*);
 PETSC_INTERN PetscErrorCode MatConvert_SeqAIJ_SeqAIJCRL(Mat,MatType,MatReuse,Mat*);
+PETSC_INTERN PetscErrorCode MatConvert_SeqAIJ_SeqAIJSingle(Mat,MatType,MatReuse,Mat*);
+PETSC_INTERN PetscErrorCode MatGetFactor_seqaij_petsc(Mat,MatFactorType,Mat*);
 PETSC_INTERN PetscErrorCode MatConvert_SeqAIJ_Elemental(Mat,MatType,MatReuse,Mat*);
 #if defined(PETSC_HAVE_SCALAPACK)
 PETSC_INTERN PetscErrorCode MatConvert_AIJ_ScaLAPACK(Mat,MatType,MatReuse,Mat*);
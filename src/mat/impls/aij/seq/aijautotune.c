@@ -0,0 +1,267 @@
+/*
+  Selects, by timing on the actual nonzero pattern, the fastest of several MatMult() kernels for a MATSEQAIJ matrix.
+
+  The candidates are the plain CSR kernel, the I-node kernel (when I-nodes were found), and the kernels of the
+  MATSEQSELL and MATSEQAIJPERM formats. The latter two run on a "shadow" matrix: a MATSEQSELL copy of the matrix
+  (refreshed when the matrix changes, as done by MATSEQAIJSELL), or a MATSEQAIJPERM matrix that shares the i, j, and a
+  arrays of the matrix and only adds the row grouping permutation.
+*/
+#include <../src/mat/impls/aij/seq/aij.h>
+#include <../src/mat/impls/sell/seq/sell.h>
+#include <petsctime.h>
+
+const char *const MatSeqAIJMultKernels[] = {"csr","inode","sell","perm","MatSeqAIJMultKernel","MAT_SEQAIJ_MULT_",NULL};
+
+/* Creates a MATSEQAIJ matrix that shares the arrays of A; A does not need to be flagged as assembled */
+static PetscErrorCode MatSeqAIJAutotuneCreateAlias_Private(Mat A,Mat *B)
+{
+  Mat_SeqAIJ     *a = (Mat_SeqAIJ*)A->data;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MatCreateSeqAIJWithArrays(PETSC_COMM_SELF,A->rmap->n,A->cmap->n,a->i,a->j,a->a,B);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatSeqAIJAutotuneCreateShadow_Private(Mat A,MatSeqAIJMultKernel kernel,Mat *S)
+{
+  PetscErrorCode ierr;
+  Mat            B;
+
+  PetscFunctionBegin;
+  *S   = NULL;
+  /* the shadow is an implementation detail, it should not respond to -mat_view */
+  ierr = PetscOptionsPushGetViewerOff(PETSC_TRUE);CHKERRQ(ierr);
+  ierr = MatSeqAIJAutotuneCreateAlias_Private(A,&B);CHKERRQ(ierr);
+  if (kernel == MAT_SEQAIJ_MULT_SELL) {
+    ierr = MatConvert_SeqAIJ_SeqSELL(B,MATSEQSELL,MAT_INITIAL_MATRIX,S);CHKERRQ(ierr);
+    ierr = MatDestroy(&B);CHKERRQ(ierr);
+  } else if (kernel == MAT_SEQAIJ_MULT_PERM) {
+    ierr = MatConvert(B,MATSEQAIJPERM,MAT_INPLACE_MATRIX,&B);CHKERRQ(ierr);
+    *S   = B;
+  } else SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_PLIB,"Kernel %s does not use a shadow matrix",MatSeqAIJMultKernels[kernel]);
+  ierr = PetscOptionsPopGetViewerOff();CHKERRQ(ierr);
+  ierr = PetscObjectStateGet((PetscObject)A,&((Mat_SeqAIJ*)A->data)->autotune.state);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* The PERM shadow shares the values of the matrix, the SELL shadow must be updated when the matrix has changed */
+static PetscErrorCode MatSeqAIJAutotuneUpdateShadow_Private(Mat A)
+{
+  Mat_SeqAIJ       *a = (Mat_SeqAIJ*)A->data;
+  PetscErrorCode   ierr;
+  PetscObjectState state;
+
+  PetscFunctionBegin;
+  if (a->autotune.kernel != MAT_SEQAIJ_MULT_SELL) PetscFunctionReturn(0);
+  ierr = PetscObjectStateGet((PetscObject)A,&state);CHKERRQ(ierr);
+  if (a->autotune.state == state) PetscFunctionReturn(0);
+  ierr = PetscLogEventBegin(MAT_Convert,A,0,0,0);CHKERRQ(ierr);
+  ierr = PetscOptionsPushGetViewerOff(PETSC_TRUE);CHKERRQ(ierr);
+  ierr = MatConvert_SeqAIJ_SeqSELL(A,MATSEQSELL,MAT_REUSE_MATRIX,&a->autotune.S);CHKERRQ(ierr);
+  ierr = PetscOptionsPopGetViewerOff();CHKERRQ(ierr);
+  ierr = PetscLogEventEnd(MAT_Convert,A,0,0,0);CHKERRQ(ierr);
+  a->autotune.state = state;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatMult_SeqAIJ_Autotune(Mat A,Vec xx,Vec yy)
+{
+  Mat_SeqAIJ     *a = (Mat_SeqAIJ*)A->data;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MatSeqAIJAutotuneUpdateShadow_Private(A);CHKERRQ(ierr);
+  ierr = (*a->autotune.S->ops->mult)(a->autotune.S,xx,yy);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatMultAdd_SeqAIJ_Autotune(Mat A,Vec xx,Vec yy,Vec zz)
+{
+  Mat_SeqAIJ     *a = (Mat_SeqAIJ*)A->data;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MatSeqAIJAutotuneUpdateShadow_Private(A);CHKERRQ(ierr);
+  ierr = (*a->autotune.S->ops->multadd)(a->autotune.S,xx,yy,zz);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* Installs the kernel; S is the shadow matrix needed by the SELL and PERM kernels, ownership is taken */
+static PetscErrorCode MatSeqAIJAutotuneSetKernel_Private(Mat A,MatSeqAIJMultKernel kernel,Mat S)
+{
+  Mat_SeqAIJ     *a = (Mat_SeqAIJ*)A->data;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (S != a->autotune.S) {ierr = MatDestroy(&a->autotune.S);CHKERRQ(ierr);}
+  a->autotune.S      = S;
+  a->autotune.kernel = kernel;
+  if (kernel == MAT_SEQAIJ_MULT_SELL || kernel == MAT_SEQAIJ_MULT_PERM) {
+    if (!S) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_PLIB,"Kernel %s requires a shadow matrix",MatSeqAIJMultKernels[kernel]);
+    A->ops->mult    = MatMult_SeqAIJ_Autotune;
+    A->ops->multadd = MatMultAdd_SeqAIJ_Autotune;
+  } else {
+    /* MatMult_SeqAIJ() dispatches to the I-node kernel unless a->autotune.kernel is MAT_SEQAIJ_MULT_CSR */
+    A->ops->mult    = MatMult_SeqAIJ;
+    A->ops->multadd = MatMultAdd_SeqAIJ;
+  }
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatSeqAIJAutotuneTime_Private(Mat A,Vec xx,Vec yy,PetscInt its,PetscLogDouble *time)
+{
+  PetscErrorCode ierr;
+  PetscInt       k;
+  PetscLogDouble t0,t1;
+
+  PetscFunctionBegin;
+  /* one untimed product to bring the matrix and the vectors into cache */
+  ierr  = (*A->ops->mult)(A,xx,yy);CHKERRQ(ierr);
+  *time = PETSC_MAX_REAL;
+  for (k=0; k<its; k++) {
+    ierr  = PetscTime(&t0);CHKERRQ(ierr);
+    ierr  = (*A->ops->mult)(A,xx,yy);CHKERRQ(ierr);
+    ierr  = PetscTime(&t1);CHKERRQ(ierr);
+    *time = PetscMin(*time,t1-t0);
+  }
+  PetscFunctionReturn(0);
+}
+
+/*
+   MatSeqAIJAutotuneMult - Times the candidate MatMult() kernels on the current nonzero pattern and installs the fastest one
+   in A->ops->mult and A->ops->multadd. Called at the end of MatAssemblyEnd_SeqAIJ(); the decision is cached for the
+   nonzero state so later assemblies with the same pattern do not retune.
+*/
+PetscErrorCode MatSeqAIJAutotuneMult(Mat A)
+{
+  Mat_SeqAIJ          *a = (Mat_SeqAIJ*)A->data;
+  PetscErrorCode      ierr;
+  PetscBool           isseqaij;
+  PetscInt            its = 10;
+  Vec                 xx,yy;
+  Mat                 S[MAT_SEQAIJ_MULT_NKERNELS] = {NULL};
+  PetscInt            k;
+  MatSeqAIJMultKernel best = MAT_SEQAIJ_MULT_CSR;
+
+  PetscFunctionBegin;
+  if (!a->autotune.use) PetscFunctionReturn(0);
+  if (a->autotune.tuned && a->autotune.mat_nonzerostate == A->nonzerostate) PetscFunctionReturn(0);
+  /* subtypes of MATSEQAIJ such as MATSEQAIJSELL or MATSEQAIJCUSPARSE install their own kernels */
+  ierr = PetscObjectTypeCompare((PetscObject)A,MATSEQAIJ,&isseqaij);CHKERRQ(ierr);
+  if (!isseqaij || A->factortype || A->structure_only) PetscFunctionReturn(0);
+
+  ierr = MatSeqAIJAutotuneSetKernel_Private(A,MAT_SEQAIJ_MULT_INODE,NULL);CHKERRQ(ierr);
+  a->autotune.tuned = PETSC_FALSE;
+  if (!A->rmap->n || !a->nz) PetscFunctionReturn(0);
+
+  ierr = PetscOptionsGetInt(((PetscObject)A)->options,((PetscObject)A)->prefix,"-mat_autotune_mult_its",&its,NULL);CHKERRQ(ierr);
+  its  = PetscMax(its,1);
+  ierr = MatCreateVecs(A,&xx,&yy);CHKERRQ(ierr);
+  ierr = VecSet(xx,1.0);CHKERRQ(ierr);
+  for (k=0; k<MAT_SEQAIJ_MULT_NKERNELS; k++) {
+    a->autotune.time[k] = -1.0;
+    if (k == MAT_SEQAIJ_MULT_INODE && !(a->inode.use && a->inode.checked && a->inode.size)) continue;
+    if (k == MAT_SEQAIJ_MULT_SELL || k == MAT_SEQAIJ_MULT_PERM) {
+      ierr = MatSeqAIJAutotuneCreateShadow_Private(A,(MatSeqAIJMultKernel)k,&S[k]);CHKERRQ(ierr);
+      ierr = MatSeqAIJAutotuneTime_Private(S[k],xx,yy,its,&a->autotune.time[k]);CHKERRQ(ierr);
+    } else {
+      a->autotune.kernel = (MatSeqAIJMultKernel)k;
+      ierr = MatSeqAIJAutotuneTime_Private(A,xx,yy,its,&a->autotune.time[k]);CHKERRQ(ierr);
+    }
+    if (a->autotune.time[k] < a->autotune.time[best]) best = (MatSeqAIJMultKernel)k;
+  }
+  ierr = VecDestroy(&xx);CHKERRQ(ierr);
+  ierr = VecDestroy(&yy);CHKERRQ(ierr);
+  for (k=0; k<MAT_SEQAIJ_MULT_NKERNELS; k++) {
+    if (k != best) {ierr = MatDestroy(&S[k]);CHKERRQ(ierr);}
+  }
+  ierr = MatSeqAIJAutotuneSetKernel_Private(A,best,S[best]);CHKERRQ(ierr);
+  ierr = PetscInfo6(A,"MatMult() kernel times (sec): csr %g inode %g sell %g perm %g; using %s kernel for %D nonzeros\n",(double)a->autotune.time[MAT_SEQAIJ_MULT_CSR],(double)a->autotune.time[MAT_SEQAIJ_MULT_INODE],(double)a->autotune.time[MAT_SEQAIJ_MULT_SELL],(double)a->autotune.time[MAT_SEQAIJ_MULT_PERM],MatSeqAIJMultKernels[best],a->nz);CHKERRQ(ierr);
+  a->autotune.tuned            = PETSC_TRUE;
+  a->autotune.mat_nonzerostate = A->nonzerostate;
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode MatSetOption_SeqAIJ_Autotune(Mat A,PetscBool flg)
+{
+  Mat_SeqAIJ     *a = (Mat_SeqAIJ*)A->data;
+  PetscErrorCode ierr;
+  PetscBool      isseqaij;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectTypeCompare((PetscObject)A,MATSEQAIJ,&isseqaij);CHKERRQ(ierr);
+  if (!isseqaij) {
+    ierr = PetscInfo1(A,"Option %s ignored for subtypes of MATSEQAIJ\n",MatOptions[MAT_AUTOTUNE_MULT]);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  if (flg == a->autotune.use) PetscFunctionReturn(0);
+  a->autotune.use   = flg;
+  a->autotune.tuned = PETSC_FALSE;
+  ierr = MatSeqAIJAutotuneSetKernel_Private(A,MAT_SEQAIJ_MULT_INODE,NULL);CHKERRQ(ierr);
+  if (flg && A->assembled) {ierr = MatSeqAIJAutotuneMult(A);CHKERRQ(ierr);}
+  PetscFunctionReturn(0);
+}
+
+/* C has the same nonzero pattern as A so the kernel selected for A is also used for C */
+PetscErrorCode MatDuplicate_SeqAIJ_Autotune(Mat A,Mat C)
+{
+  Mat_SeqAIJ     *a = (Mat_SeqAIJ*)A->data,*c = (Mat_SeqAIJ*)C->data;
+  PetscErrorCode ierr;
+  Mat            S = NULL;
+
+  PetscFunctionBegin;
+  c->autotune.use    = a->autotune.use;
+  c->autotune.tuned  = PETSC_FALSE;
+  c->autotune.kernel = MAT_SEQAIJ_MULT_INODE;
+  c->autotune.S      = NULL;
+  if (!a->autotune.use || !a->autotune.tuned || a->autotune.mat_nonzerostate != A->nonzerostate || C->factortype) PetscFunctionReturn(0);
+  if (a->autotune.kernel == MAT_SEQAIJ_MULT_SELL || a->autotune.kernel == MAT_SEQAIJ_MULT_PERM) {
+    ierr = MatSeqAIJAutotuneCreateShadow_Private(C,a->autotune.kernel,&S);CHKERRQ(ierr);
+  }
+  ierr = MatSeqAIJAutotuneSetKernel_Private(C,a->autotune.kernel,S);CHKERRQ(ierr);
+  ierr = PetscArraycpy(c->autotune.time,a->autotune.time,MAT_SEQAIJ_MULT_NKERNELS);CHKERRQ(ierr);
+  c->autotune.tuned            = PETSC_TRUE;
+  c->autotune.mat_nonzerostate = C->nonzerostate;
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode MatView_SeqAIJ_Autotune(Mat A,PetscViewer viewer)
+{
+  Mat_SeqAIJ          *a = (Mat_SeqAIJ*)A->data;
+  PetscErrorCode      ierr;
+  PetscBool           iascii;
+  PetscViewerFormat   format;
+  PetscInt            k;
+
+  PetscFunctionBegin;
+  if (!a->autotune.use) PetscFunctionReturn(0);
+  ierr = PetscObjectTypeCompare((PetscObject)viewer,PETSCVIEWERASCII,&iascii);CHKERRQ(ierr);
+  if (!iascii) PetscFunctionReturn(0);
+  ierr = PetscViewerGetFormat(viewer,&format);CHKERRQ(ierr);
+  if (format != PETSC_VIEWER_ASCII_INFO_DETAIL && format != PETSC_VIEWER_ASCII_INFO) PetscFunctionReturn(0);
+  if (!a->autotune.tuned) {
+    ierr = PetscViewerASCIIPrintf(viewer,"MatMult kernel autotuning: not yet tuned\n");CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  ierr = PetscViewerASCIIPrintf(viewer,"MatMult kernel autotuning: using %s kernel\n",MatSeqAIJMultKernels[a->autotune.kernel]);CHKERRQ(ierr);
+  if (format == PETSC_VIEWER_ASCII_INFO_DETAIL) {
+    ierr = PetscViewerASCIIPushTab(viewer);CHKERRQ(ierr);
+    for (k=0; k<MAT_SEQAIJ_MULT_NKERNELS; k++) {
+      if (a->autotune.time[k] < 0.0) continue;
+      ierr = PetscViewerASCIIPrintf(viewer,"%s kernel time %g sec\n",MatSeqAIJMultKernels[k],(double)a->autotune.time[k]);CHKERRQ(ierr);
+    }
+    ierr = PetscViewerASCIIPopTab(viewer);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode MatDestroy_SeqAIJ_Autotune(Mat A)
+{
+  Mat_SeqAIJ     *a = (Mat_SeqAIJ*)A->data;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MatDestroy(&a->autotune.S);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
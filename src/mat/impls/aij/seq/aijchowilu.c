@@ -0,0 +1,404 @@
+/*
+  Fine-grained parallel ILU of Chow and Patel for MATSEQAIJ, with OpenMP threads.
+
+  The factors have the nonzero pattern S computed by MatILUFactorSymbolic_SeqAIJ(). Their entries are the fixed point of
+      l_ij = (a_ij - sum_{k<j} l_ik u_kj) / u_jj    for (i,j) in S, i > j
+      u_ij =  a_ij - sum_{k<i} l_ik u_kj            for (i,j) in S, i <= j
+  computed by sweeps over the nonzeros that are all independent, starting from the scaled entries of A. Within a sweep
+  the threads use the most recent values (the asynchronous iteration); with one thread the first sweep visits the
+  nonzeros in the order of the standard ILU and gives the exact factors. The triangular solves are replaced by a few
+  Jacobi iterations, that are also parallel over the rows.
+*/
+#include <../src/mat/impls/aij/seq/aij.h>
+#if defined(PETSC_HAVE_OPENMP)
+#include <omp.h>
+#define MatChowILUPragmaOMP(x) _Pragma(PetscStringize(omp x))
+#else
+#define MatChowILUPragmaOMP(x)
+#endif
+
+typedef struct {
+  PetscInt    sweeps;   /* number of sweeps over the nonzeros in the numeric factorization */
+  PetscInt    its;      /* number of Jacobi iterations in the triangular solves, 0 for the exact solves */
+  PetscInt    *ui;      /* U by columns, including the diagonal as the last entry of each column */
+  PetscInt    *uj;      /* rows of the entries of U by columns */
+  PetscInt    *upos;    /* position in the factor of the entries of U by columns */
+  PetscInt    *ucsc;    /* position in U by columns of the entries of U in the factor */
+  MatScalar   *ua;      /* values of U by columns */
+  MatScalar   *aa;      /* values of A(r,c) at the nonzeros of the factor */
+  PetscScalar *work;    /* work vectors of the Jacobi iterations */
+} Mat_SeqAIJ_ChowILU;
+
+static PetscErrorCode MatFactorGetSolverType_seqaij_chowilu(Mat A,MatSolverType *type)
+{
+  PetscFunctionBegin;
+  *type = MATSOLVERCHOWILU;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatDestroy_SeqAIJ_ChowILU(Mat A)
+{
+  Mat_SeqAIJ_ChowILU *chow = (Mat_SeqAIJ_ChowILU*)A->spptr;
+  PetscErrorCode     ierr;
+
+  PetscFunctionBegin;
+  if (chow) {
+    ierr = PetscFree4(chow->ui,chow->uj,chow->upos,chow->ucsc);CHKERRQ(ierr);
+    ierr = PetscFree3(chow->ua,chow->aa,chow->work);CHKERRQ(ierr);
+  }
+  ierr = PetscFree(A->spptr);CHKERRQ(ierr);
+  ierr = MatDestroy_SeqAIJ(A);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatView_SeqAIJ_ChowILU(Mat A,PetscViewer viewer)
+{
+  Mat_SeqAIJ_ChowILU *chow = (Mat_SeqAIJ_ChowILU*)A->spptr;
+  PetscErrorCode     ierr;
+  PetscBool          iascii;
+  PetscViewerFormat  format;
+
+  PetscFunctionBegin;
+  ierr = MatView_SeqAIJ(A,viewer);CHKERRQ(ierr);
+  ierr = PetscObjectTypeCompare((PetscObject)viewer,PETSCVIEWERASCII,&iascii);CHKERRQ(ierr);
+  if (!iascii || !chow) PetscFunctionReturn(0);
+  ierr = PetscViewerGetFormat(viewer,&format);CHKERRQ(ierr);
+  if (format != PETSC_VIEWER_ASCII_INFO_DETAIL && format != PETSC_VIEWER_ASCII_INFO) PetscFunctionReturn(0);
+  ierr = PetscViewerASCIIPrintf(viewer,"Chow-Patel ILU: %D sweeps, ",chow->sweeps);CHKERRQ(ierr);
+  ierr = PetscViewerASCIIUseTabs(viewer,PETSC_FALSE);CHKERRQ(ierr);
+  if (chow->its) {ierr = PetscViewerASCIIPrintf(viewer,"%D Jacobi iterations in the triangular solves\n",chow->its);CHKERRQ(ierr);}
+  else {ierr = PetscViewerASCIIPrintf(viewer,"exact triangular solves\n");CHKERRQ(ierr);}
+  ierr = PetscViewerASCIIUseTabs(viewer,PETSC_TRUE);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* The triangular solves with -mat_factor_chowilu_jacobi_its Jacobi iterations each, starting from the diagonal solves */
+static PetscErrorCode MatSolve_SeqAIJ_ChowILU(Mat A,Vec bb,Vec xx)
+{
+  Mat_SeqAIJ         *a    = (Mat_SeqAIJ*)A->data;
+  Mat_SeqAIJ_ChowILU *chow = (Mat_SeqAIJ_ChowILU*)A->spptr;
+  const PetscInt     n     = A->rmap->n,*ai = a->i,*aj = a->j,*adiag = a->diag,*r,*c;
+  const MatScalar    *aa   = a->a;
+  PetscScalar        *x,*y,*z,*w,*t;
+  const PetscScalar  *b;
+  PetscInt           i,k,its;
+  PetscErrorCode     ierr;
+
+  PetscFunctionBegin;
+  if (!n) PetscFunctionReturn(0);
+  if (!chow || !chow->its) {
+    ierr = MatSolve_SeqAIJ(A,bb,xx);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  its  = chow->its;
+  y    = chow->work;
+  z    = chow->work+n;
+  w    = chow->work+2*n;
+  ierr = VecGetArrayRead(bb,&b);CHKERRQ(ierr);
+  ierr = VecGetArrayWrite(xx,&x);CHKERRQ(ierr);
+  ierr = ISGetIndices(a->row,&r);CHKERRQ(ierr);
+  ierr = ISGetIndices(a->col,&c);CHKERRQ(ierr);
+
+  /* L y = b(r) with the unit diagonal */
+  for (i=0; i<n; i++) y[i] = b[r[i]];
+  for (k=0; k<its; k++) {
+    MatChowILUPragmaOMP(parallel for schedule(static))
+    for (i=0; i<n; i++) {
+      const PetscInt  *vi = aj+ai[i];
+      const MatScalar *v  = aa+ai[i];
+      PetscScalar     sum = b[r[i]];
+
+      PetscSparseDenseMinusDot(sum,y,v,vi,ai[i+1]-ai[i]);
+      z[i] = sum;
+    }
+    t = y; y = z; z = t;
+  }
+
+  /* U w = y, the inverse of the diagonal of row i is aa[adiag[i]] */
+  for (i=0; i<n; i++) w[i] = y[i]*aa[adiag[i]];
+  for (k=0; k<its; k++) {
+    MatChowILUPragmaOMP(parallel for schedule(static))
+    for (i=0; i<n; i++) {
+      const PetscInt  *vi = aj+adiag[i+1]+1;
+      const MatScalar *v  = aa+adiag[i+1]+1;
+      PetscScalar     sum = y[i];
+
+      PetscSparseDenseMinusDot(sum,w,v,vi,adiag[i]-adiag[i+1]-1);
+      z[i] = sum*aa[adiag[i]];
+    }
+    t = w; w = z; z = t;
+  }
+  for (i=0; i<n; i++) x[c[i]] = w[i];
+
+  ierr = ISRestoreIndices(a->row,&r);CHKERRQ(ierr);
+  ierr = ISRestoreIndices(a->col,&c);CHKERRQ(ierr);
+  ierr = VecRestoreArrayRead(bb,&b);CHKERRQ(ierr);
+  ierr = VecRestoreArrayWrite(xx,&x);CHKERRQ(ierr);
+  ierr = PetscLogFlops(its*(2.0*a->nz - A->cmap->n) + A->cmap->n);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+  The transposed solves with the same number of Jacobi iterations, which give the transpose of the operator of
+  MatSolve_SeqAIJ_ChowILU(). The rows of U^T are the columns of U kept for the sweeps, while L^T is applied by rows of L.
+*/
+static PetscErrorCode MatSolveTranspose_SeqAIJ_ChowILU(Mat A,Vec bb,Vec xx)
+{
+  Mat_SeqAIJ         *a    = (Mat_SeqAIJ*)A->data;
+  Mat_SeqAIJ_ChowILU *chow = (Mat_SeqAIJ_ChowILU*)A->spptr;
+  const PetscInt     n     = A->rmap->n,*ai = a->i,*aj = a->j,*adiag = a->diag,*ui,*uj,*r,*c;
+  const MatScalar    *aa   = a->a,*ua;
+  PetscScalar        *x,*y,*z,*w,*t;
+  const PetscScalar  *b;
+  PetscInt           i,k,p,its;
+  PetscErrorCode     ierr;
+
+  PetscFunctionBegin;
+  if (!n) PetscFunctionReturn(0);
+  if (!chow || !chow->its) {
+    ierr = MatSolveTranspose_SeqAIJ(A,bb,xx);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  its  = chow->its;
+  ui   = chow->ui;
+  uj   = chow->uj;
+  ua   = chow->ua;
+  y    = chow->work;
+  z    = chow->work+n;
+  w    = chow->work+2*n;
+  ierr = VecGetArrayRead(bb,&b);CHKERRQ(ierr);
+  ierr = VecGetArrayWrite(xx,&x);CHKERRQ(ierr);
+  ierr = ISGetIndices(a->row,&r);CHKERRQ(ierr);
+  ierr = ISGetIndices(a->col,&c);CHKERRQ(ierr);
+
+  /* U^T w = b(c), the diagonal is the last entry of each column of U */
+  for (i=0; i<n; i++) w[i] = b[c[i]]*aa[adiag[i]];
+  for (k=0; k<its; k++) {
+    MatChowILUPragmaOMP(parallel for schedule(static))
+    for (i=0; i<n; i++) {
+      const PetscInt  *vi = uj+ui[i];
+      const MatScalar *v  = ua+ui[i];
+      PetscScalar     sum = b[c[i]];
+
+      PetscSparseDenseMinusDot(sum,w,v,vi,ui[i+1]-ui[i]-1);
+      z[i] = sum*aa[adiag[i]];
+    }
+    t = w; w = z; z = t;
+  }
+
+  /* L^T y = w with the unit diagonal */
+  for (i=0; i<n; i++) y[i] = w[i];
+  for (k=0; k<its; k++) {
+    for (i=0; i<n; i++) z[i] = w[i];
+    for (i=0; i<n; i++) {
+      for (p=ai[i]; p<ai[i+1]; p++) z[aj[p]] -= aa[p]*y[i];
+    }
+    t = y; y = z; z = t;
+  }
+  for (i=0; i<n; i++) x[r[i]] = y[i];
+
+  ierr = ISRestoreIndices(a->row,&r);CHKERRQ(ierr);
+  ierr = ISRestoreIndices(a->col,&c);CHKERRQ(ierr);
+  ierr = VecRestoreArrayRead(bb,&b);CHKERRQ(ierr);
+  ierr = VecRestoreArrayWrite(xx,&x);CHKERRQ(ierr);
+  ierr = PetscLogFlops(its*(2.0*a->nz - A->cmap->n) + A->cmap->n);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* Sparse dot product of the row i of L and the column j of U, with the entries in the columns and rows k < kend */
+PETSC_STATIC_INLINE PetscScalar MatChowILUDot_Private(const PetscInt *lj,const MatScalar *la,PetscInt nl,const PetscInt *uj,const MatScalar *ua,PetscInt nu,PetscInt kend)
+{
+  PetscScalar sum = 0.0;
+  PetscInt    p = 0,q = 0;
+
+  while (p < nl && q < nu && lj[p] < kend && uj[q] < kend) {
+    if (lj[p] < uj[q]) p++;
+    else if (lj[p] > uj[q]) q++;
+    else sum += la[p++]*ua[q++];
+  }
+  return sum;
+}
+
+static PetscErrorCode MatLUFactorNumeric_SeqAIJ_ChowILU(Mat B,Mat A,const MatFactorInfo *info)
+{
+  Mat_SeqAIJ         *a    = (Mat_SeqAIJ*)A->data,*b = (Mat_SeqAIJ*)B->data;
+  Mat_SeqAIJ_ChowILU *chow = (Mat_SeqAIJ_ChowILU*)B->spptr;
+  const PetscInt     n     = A->rmap->n,*ai = a->i,*aj = a->j,*bi = b->i,*bj = b->j,*bdiag = b->diag;
+  const PetscInt     *ui   = chow->ui,*uj = chow->uj,*upos = chow->upos,*ucsc = chow->ucsc,*r,*ic;
+  MatScalar          *ba   = b->a,*ua = chow->ua,*caa = chow->aa;
+  PetscInt           i,j,p,s,*colpos;
+  FactorShiftCtx     sctx;
+  PetscErrorCode     ierr;
+
+  PetscFunctionBegin;
+  ierr = ISGetIndices(b->row,&r);CHKERRQ(ierr);
+  ierr = ISGetIndices(b->icol,&ic);CHKERRQ(ierr);
+  /* Values of A(r,c) at the nonzeros of the factor, zero at the fill-in */
+  ierr = PetscMalloc1(n,&colpos);CHKERRQ(ierr);
+  for (i=0; i<n; i++) colpos[i] = -1;
+  for (i=0; i<n; i++) {
+    for (p=bi[i]; p<bi[i+1]; p++) colpos[bj[p]] = p;
+    for (p=bdiag[i+1]+1; p<=bdiag[i]; p++) colpos[bj[p]] = p;
+    for (p=bi[i]; p<bi[i+1]; p++) caa[p] = 0.0;
+    for (p=bdiag[i+1]+1; p<=bdiag[i]; p++) caa[p] = 0.0;
+    for (p=ai[r[i]]; p<ai[r[i]+1]; p++) {
+      j = ic[aj[p]];
+      if (colpos[j] >= 0) caa[colpos[j]] = a->a[p];
+    }
+    for (p=bi[i]; p<bi[i+1]; p++) colpos[bj[p]] = -1;
+    for (p=bdiag[i+1]+1; p<=bdiag[i]; p++) colpos[bj[p]] = -1;
+  }
+  ierr = PetscFree(colpos);CHKERRQ(ierr);
+  ierr = ISRestoreIndices(b->row,&r);CHKERRQ(ierr);
+  ierr = ISRestoreIndices(b->icol,&ic);CHKERRQ(ierr);
+
+  /* Initial guess L = tril(A) D^{-1} and U = triu(A) */
+  B->factorerrortype = MAT_FACTOR_NOERROR;
+  ierr = PetscMemzero(&sctx,sizeof(sctx));CHKERRQ(ierr);
+  for (i=0; i<n; i++) {
+    sctx.pv = caa[bdiag[i]];
+    ierr    = MatPivotCheck_none(B,A,info,&sctx,i);CHKERRQ(ierr);
+    if (B->factorerrortype) PetscFunctionReturn(0);
+  }
+  for (i=0; i<n; i++) {
+    for (p=bi[i]; p<bi[i+1]; p++) ba[p] = caa[p]/caa[bdiag[bj[p]]];
+  }
+  for (s=0; s<ui[n]; s++) ua[s] = caa[upos[s]];
+
+  for (s=0; s<chow->sweeps; s++) {
+    MatChowILUPragmaOMP(parallel for schedule(static) private(p,j))
+    for (i=0; i<n; i++) {
+      const PetscInt  *lj = bj+bi[i];
+      const MatScalar *la = ba+bi[i];
+      PetscInt        nl  = bi[i+1]-bi[i];
+
+      for (p=bi[i]; p<bi[i+1]; p++) {
+        j     = bj[p];
+        ba[p] = (caa[p] - MatChowILUDot_Private(lj,la,nl,uj+ui[j],ua+ui[j],ui[j+1]-ui[j],j))/ua[ui[j+1]-1];
+      }
+      for (p=bdiag[i+1]+1; p<=bdiag[i]; p++) {
+        j           = bj[p];
+        ua[ucsc[p]] = caa[p] - MatChowILUDot_Private(lj,la,nl,uj+ui[j],ua+ui[j],ui[j+1]-ui[j],i);
+      }
+    }
+  }
+
+  /* Store U in the factor, with the inverse of the diagonal */
+  for (i=0; i<n; i++) {
+    for (p=bdiag[i+1]+1; p<bdiag[i]; p++) ba[p] = ua[ucsc[p]];
+    sctx.pv = ua[ucsc[bdiag[i]]];
+    ierr    = MatPivotCheck_none(B,A,info,&sctx,i);CHKERRQ(ierr);
+    if (B->factorerrortype) PetscFunctionReturn(0);
+    ba[bdiag[i]] = 1.0/sctx.pv;
+  }
+
+  /* The other solves use these two, so that they apply the same operator */
+  B->ops->solve             = MatSolve_SeqAIJ_ChowILU;
+  B->ops->solvetranspose    = MatSolveTranspose_SeqAIJ_ChowILU;
+  B->ops->solveadd          = NULL;
+  B->ops->solvetransposeadd = NULL;
+  B->ops->matsolve          = NULL;
+  B->ops->matsolvetranspose = NULL;
+  B->assembled              = PETSC_TRUE;
+  B->preallocated           = PETSC_TRUE;
+  ierr = PetscLogFlops(chow->sweeps*2.0*b->nz);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* The pattern of the factor is the one of the standard ILU(k), the structure of U by columns is added for the sweeps */
+static PetscErrorCode MatILUFactorSymbolic_SeqAIJ_ChowILU(Mat B,Mat A,IS isrow,IS iscol,const MatFactorInfo *info)
+{
+  Mat_SeqAIJ         *b;
+  Mat_SeqAIJ_ChowILU *chow = (Mat_SeqAIJ_ChowILU*)B->spptr;
+  PetscInt           n = A->rmap->n,i,p,nu,*count;
+  PetscErrorCode     ierr;
+
+  PetscFunctionBegin;
+  ierr = MatILUFactorSymbolic_SeqAIJ(B,A,isrow,iscol,info);CHKERRQ(ierr);
+  b    = (Mat_SeqAIJ*)B->data;
+  ierr = PetscFree4(chow->ui,chow->uj,chow->upos,chow->ucsc);CHKERRQ(ierr);
+  ierr = PetscFree3(chow->ua,chow->aa,chow->work);CHKERRQ(ierr);
+
+  nu   = b->diag[0]-b->diag[n];
+  ierr = PetscMalloc4(n+1,&chow->ui,nu,&chow->uj,nu,&chow->upos,b->diag[0]+1,&chow->ucsc);CHKERRQ(ierr);
+  ierr = PetscMalloc3(nu,&chow->ua,b->diag[0]+1,&chow->aa,3*n,&chow->work);CHKERRQ(ierr);
+  ierr = PetscLogObjectMemory((PetscObject)B,(n+1+2*nu+b->diag[0]+1)*sizeof(PetscInt)+(nu+b->diag[0]+1+3*n)*sizeof(PetscScalar));CHKERRQ(ierr);
+  ierr = PetscCalloc1(n+1,&count);CHKERRQ(ierr);
+  for (i=0; i<n; i++) {
+    for (p=b->diag[i+1]+1; p<=b->diag[i]; p++) count[b->j[p]+1]++;
+  }
+  for (i=0; i<n; i++) count[i+1] += count[i];
+  ierr = PetscArraycpy(chow->ui,count,n+1);CHKERRQ(ierr);
+  /* Visiting the rows in increasing order sorts the columns by rows, with the diagonal last */
+  for (i=0; i<n; i++) {
+    for (p=b->diag[i+1]+1; p<=b->diag[i]; p++) {
+      PetscInt q = count[b->j[p]]++;
+
+      chow->uj[q]   = i;
+      chow->upos[q] = p;
+      chow->ucsc[p] = q;
+    }
+  }
+  ierr = PetscFree(count);CHKERRQ(ierr);
+
+  B->ops->lufactornumeric = MatLUFactorNumeric_SeqAIJ_ChowILU;
+  PetscFunctionReturn(0);
+}
+
+/*MC
+  MATSOLVERCHOWILU - "chowilu" - The fine-grained parallel ILU(k) of Chow and Patel for MATSEQAIJ matrices, with
+  OpenMP threads
+
+  The factors have the same nonzero pattern as the ILU(k) of MATSOLVERPETSC and are computed by sweeps of fixed-point
+  iterations over their nonzeros, that are all updated in parallel. The triangular solves are replaced by Jacobi
+  iterations. Without OpenMP, one sweep computes the same factors as MATSOLVERPETSC. The transposed solves use the same
+  number of Jacobi iterations and apply the transpose of the operator of MatSolve(), as needed by KSPBICG.
+
+  Options Database Keys:
++ -mat_factor_chowilu_sweeps <3> - number of sweeps over the nonzeros of the factors
+- -mat_factor_chowilu_jacobi_its <3> - number of Jacobi iterations of each triangular solve, 0 for the exact solves
+
+  Notes:
+    Use -pc_type ilu -pc_factor_mat_solver_type chowilu. The shifts of the diagonal of MatFactorInfo are not
+    supported.
+
+  Level: intermediate
+
+  References:
+.   1. - E. Chow and A. Patel, Fine-grained parallel incomplete LU factorization, SIAM J. Sci. Comput., 37 (2015).
+
+.seealso: PCFactorSetMatSolverType(), MatSolverType, PCILU, MATSOLVERPETSC
+M*/
+
+PETSC_INTERN PetscErrorCode MatGetFactor_seqaij_chowilu(Mat A,MatFactorType ftype,Mat *B)
+{
+  Mat_SeqAIJ_ChowILU *chow;
+  PetscInt           n = A->rmap->n;
+  PetscErrorCode     ierr;
+
+  PetscFunctionBegin;
+  if (ftype != MAT_FACTOR_ILU) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_SUP,"Factor type not supported");
+  ierr = MatCreate(PetscObjectComm((PetscObject)A),B);CHKERRQ(ierr);
+  ierr = MatSetSizes(*B,n,n,n,n);CHKERRQ(ierr);
+  ierr = MatSetType(*B,MATSEQAIJ);CHKERRQ(ierr);
+  ierr = MatSetBlockSizesFromMats(*B,A,A);CHKERRQ(ierr);
+  ierr = PetscNewLog(*B,&chow);CHKERRQ(ierr);
+  (*B)->spptr = (void*)chow;
+  chow->sweeps = 3;
+  chow->its    = 3;
+  ierr = PetscOptionsBegin(PetscObjectComm((PetscObject)A),((PetscObject)A)->prefix,"Chow-Patel ILU options","Mat");CHKERRQ(ierr);
+  ierr = PetscOptionsInt("-mat_factor_chowilu_sweeps","Number of sweeps over the nonzeros of the factors","None",chow->sweeps,&chow->sweeps,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsInt("-mat_factor_chowilu_jacobi_its","Number of Jacobi iterations of each triangular solve, 0 for the exact solves","None",chow->its,&chow->its,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsEnd();CHKERRQ(ierr);
+
+  (*B)->ops->ilufactorsymbolic = MatILUFactorSymbolic_SeqAIJ_ChowILU;
+  (*B)->ops->destroy           = MatDestroy_SeqAIJ_ChowILU;
+  (*B)->ops->view              = MatView_SeqAIJ_ChowILU;
+  (*B)->factortype             = ftype;
+  (*B)->canuseordering         = PETSC_TRUE;
+  ierr = PetscStrallocpy(MATORDERINGNATURAL,(char**)&(*B)->preferredordering[MAT_FACTOR_ILU]);CHKERRQ(ierr);
+  ierr = PetscFree((*B)->solvertype);CHKERRQ(ierr);
+  ierr = PetscStrallocpy(MATSOLVERCHOWILU,&(*B)->solvertype);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)*B,"MatFactorGetSolverType_C",MatFactorGetSolverType_seqaij_chowilu);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
@@ -431,6 +431,7 @@ PetscErrorCode MatLUFactorSymbolic_SeqAIJ(Mat B,Mat A,IS isrow,IS iscol,const Ma
     ierr = PetscInfo(A,"Empty matrix\n");CHKERRQ(ierr);
   }
 #endif
+  ierr = MatDestroy_SeqAIJ_SolveLevels(B);CHKERRQ(ierr);
   B->ops->lufactornumeric = MatLUFactorNumeric_SeqAIJ;
   if (a->inode.size) {
     B->ops->lufactornumeric = MatLUFactorNumeric_SeqAIJ_Inode;
@@ -614,6 +615,7 @@ PetscErrorCode MatLUFactorNumeric_SeqAIJ(Mat B,Mat A,const MatFactorInfo *info)
   C->ops->matsolve          = MatMatSolve_SeqAIJ;
   C->assembled              = PETSC_TRUE;
   C->preallocated           = PETSC_TRUE;
+  ierr = MatSeqAIJSolveLevelsSetUp(C);CHKERRQ(ierr);
 
   ierr = PetscLogFlops(C->cmap->n);CHKERRQ(ierr);
 
@@ -1663,6 +1665,7 @@ PetscErrorCode MatILUFactorSymbolic_SeqAIJ_ilu0(Mat fact,Mat A,IS isrow,IS iscol
   fact->info.fill_ratio_given  = info->fill;
   fact->info.fill_ratio_needed = 1.0;
   fact->ops->lufactornumeric   = MatLUFactorNumeric_SeqAIJ;
+  ierr = MatDestroy_SeqAIJ_SolveLevels(fact);CHKERRQ(ierr);
   ierr = MatSeqAIJCheckInode_FactorLU(fact);CHKERRQ(ierr);
 
   b       = (Mat_SeqAIJ*)(fact)->data;
@@ -1847,6 +1850,7 @@ PetscErrorCode MatILUFactorSymbolic_SeqAIJ(Mat fact,Mat A,IS isrow,IS iscol,cons
   if (a->inode.size) {
     (fact)->ops->lufactornumeric = MatLUFactorNumeric_SeqAIJ_Inode;
   }
+  ierr = MatDestroy_SeqAIJ_SolveLevels(fact);CHKERRQ(ierr);
   ierr = MatSeqAIJCheckInode_FactorLU(fact);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
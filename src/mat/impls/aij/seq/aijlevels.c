@@ -0,0 +1,249 @@
+/*
+  Level scheduling of the triangular solves of a MATSEQAIJ LU or ILU factor, for threaded MatSolve() with OpenMP.
+
+  The rows of L (and of U) are sorted by level: a row only depends on rows of lower levels, so the rows of one level are
+  solved concurrently, with a barrier between levels. Consecutive levels with fewer than min_width rows do not have
+  enough work for the threads, they are merged into one group solved in order by a single thread, with one barrier.
+  The analysis only depends on the nonzero pattern, so it is computed at the first numeric factorization and kept
+  until the next symbolic factorization.
+*/
+#include <../src/mat/impls/aij/seq/aij.h>
+#if defined(PETSC_HAVE_OPENMP)
+#include <omp.h>
+#define MatSolveLevelsPragmaOMP(x) _Pragma(PetscStringize(omp x))
+#else
+#define MatSolveLevelsPragmaOMP(x)
+#endif
+
+static PetscErrorCode MatSeqAIJSolveLevelsReset_Private(Mat_SeqAIJ_TriLevels *tri)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscFree3(tri->groups,tri->parallel,tri->rows);CHKERRQ(ierr);
+  tri->nlevels = 0;
+  tri->ngroups = 0;
+  PetscFunctionReturn(0);
+}
+
+/* Frees the levels, called when the factor is destroyed or its nonzero pattern recomputed by a symbolic factorization */
+PetscErrorCode MatDestroy_SeqAIJ_SolveLevels(Mat A)
+{
+  Mat_SeqAIJ     *a = (Mat_SeqAIJ*)A->data;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MatSeqAIJSolveLevelsReset_Private(&a->solvelevels.lower);CHKERRQ(ierr);
+  ierr = MatSeqAIJSolveLevelsReset_Private(&a->solvelevels.upper);CHKERRQ(ierr);
+  a->solvelevels.use = PETSC_FALSE;
+  PetscFunctionReturn(0);
+}
+
+/*
+  Sorts the n rows by the levels in level[] and merges the consecutive levels with fewer than minwidth rows.
+  Returns the number of rows in parallel groups.
+*/
+static PetscErrorCode MatSeqAIJSolveLevelsGroup_Private(PetscInt n,const PetscInt level[],PetscInt nlevels,PetscInt minwidth,Mat_SeqAIJ_TriLevels *tri,PetscInt *nparallel)
+{
+  PetscInt       *count,i,l,g;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscCalloc1(nlevels+1,&count);CHKERRQ(ierr);
+  ierr = PetscMalloc3(nlevels+1,&tri->groups,nlevels,&tri->parallel,n,&tri->rows);CHKERRQ(ierr);
+  /* Counting sort of the rows by level, in increasing order of rows in each level */
+  for (i=0; i<n; i++) count[level[i]+1]++;
+  for (l=0; l<nlevels; l++) count[l+1] += count[l];
+  for (i=0; i<n; i++) tri->rows[count[level[i]]++] = i;
+  /* Now count[l] is the end of level l */
+  tri->nlevels   = nlevels;
+  tri->ngroups   = 0;
+  tri->groups[0] = 0;
+  *nparallel     = 0;
+  for (l=0; l<nlevels; l++) {
+    PetscInt start = l ? count[l-1] : 0,width = count[l]-start;
+
+    if (width >= minwidth) {
+      g                = tri->ngroups++;
+      tri->parallel[g] = PETSC_TRUE;
+      *nparallel      += width;
+    } else if (!tri->ngroups || tri->parallel[tri->ngroups-1]) {
+      g                = tri->ngroups++;
+      tri->parallel[g] = PETSC_FALSE;
+    } else g = tri->ngroups-1;
+    tri->groups[g+1] = count[l];
+  }
+  ierr = PetscFree(count);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+  MatSeqAIJSolveLevelsSetUp - Called at the end of the numeric LU factorization, installs MatSolve_SeqAIJ_Levels()
+  with -mat_factor_solve_levels if enough rows are in levels of at least -mat_factor_solve_levels_min_width rows.
+*/
+PetscErrorCode MatSeqAIJSolveLevelsSetUp(Mat fact)
+{
+  Mat_SeqAIJ             *b  = (Mat_SeqAIJ*)fact->data;
+  Mat_SeqAIJ_SolveLevels *lv = &b->solvelevels;
+  const PetscInt         *bi = b->i,*bj = b->j,*bdiag = b->diag;
+  PetscInt               n   = fact->rmap->n,i,k,*level,nlevels,nparallelL,nparallelU;
+  PetscBool              use = PETSC_FALSE,row_identity,col_identity;
+  PetscErrorCode         ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscOptionsGetBool(((PetscObject)fact)->options,((PetscObject)fact)->prefix,"-mat_factor_solve_levels",&use,NULL);CHKERRQ(ierr);
+  if (!use || !n) PetscFunctionReturn(0);
+  if (!lv->lower.ngroups) {
+    lv->minwidth = 32;
+    ierr = PetscOptionsGetInt(((PetscObject)fact)->options,((PetscObject)fact)->prefix,"-mat_factor_solve_levels_min_width",&lv->minwidth,NULL);CHKERRQ(ierr);
+    ierr = PetscMalloc1(n,&level);CHKERRQ(ierr);
+    /* Levels of L, whose row i is in bj[bi[i]:bi[i+1]] without the unit diagonal */
+    nlevels = 0;
+    for (i=0; i<n; i++) {
+      level[i] = 0;
+      for (k=bi[i]; k<bi[i+1]; k++) level[i] = PetscMax(level[i],level[bj[k]]+1);
+      nlevels = PetscMax(nlevels,level[i]+1);
+    }
+    ierr = MatSeqAIJSolveLevelsGroup_Private(n,level,nlevels,lv->minwidth,&lv->lower,&nparallelL);CHKERRQ(ierr);
+    /* Levels of U, whose row i is in bj[bdiag[i+1]+1:bdiag[i]] without the diagonal, stored from the last row */
+    nlevels = 0;
+    for (i=n-1; i>=0; i--) {
+      level[i] = 0;
+      for (k=bdiag[i+1]+1; k<bdiag[i]; k++) level[i] = PetscMax(level[i],level[bj[k]]+1);
+      nlevels = PetscMax(nlevels,level[i]+1);
+    }
+    ierr = MatSeqAIJSolveLevelsGroup_Private(n,level,nlevels,lv->minwidth,&lv->upper,&nparallelU);CHKERRQ(ierr);
+    ierr = PetscFree(level);CHKERRQ(ierr);
+    ierr = PetscLogObjectMemory((PetscObject)fact,2*(2*n+lv->lower.nlevels+lv->upper.nlevels)*sizeof(PetscInt));CHKERRQ(ierr);
+
+    ierr = ISIdentity(b->row,&row_identity);CHKERRQ(ierr);
+    ierr = ISIdentity(b->col,&col_identity);CHKERRQ(ierr);
+    lv->identity = (PetscBool)(row_identity && col_identity);
+    /* With less than half of the rows in levels solved concurrently, the barriers cost more than the threads gain */
+    lv->use = (PetscBool)(nparallelL+nparallelU >= n);
+    ierr = PetscInfo6(fact,"Levels of L %D with %D groups, of U %D with %D groups, %g%% of the rows in levels of at least %D rows\n",lv->lower.nlevels,lv->lower.ngroups,lv->upper.nlevels,lv->upper.ngroups,(double)(50.0*(nparallelL+nparallelU)/n),lv->minwidth);CHKERRQ(ierr);
+    if (!lv->use) {ierr = PetscInfo(fact,"Not enough rows in wide levels, using the sequential triangular solves\n");CHKERRQ(ierr);}
+  }
+  if (lv->use) fact->ops->solve = MatSolve_SeqAIJ_Levels;
+  PetscFunctionReturn(0);
+}
+
+/* Same arithmetic as MatSolve_SeqAIJ() and MatSolve_SeqAIJ_NaturalOrdering(), with the rows visited level by level */
+PetscErrorCode MatSolve_SeqAIJ_Levels(Mat A,Vec bb,Vec xx)
+{
+  Mat_SeqAIJ                 *a  = (Mat_SeqAIJ*)A->data;
+  const Mat_SeqAIJ_TriLevels *L  = &a->solvelevels.lower,*U = &a->solvelevels.upper;
+  const PetscInt             *ai = a->i,*aj = a->j,*adiag = a->diag,*r = NULL,*c = NULL;
+  const MatScalar            *aa = a->a;
+  PetscScalar                *x,*tmp;
+  const PetscScalar          *b;
+  PetscInt                   g;
+  PetscErrorCode             ierr;
+
+  PetscFunctionBegin;
+  if (!A->rmap->n) PetscFunctionReturn(0);
+  if (!L->ngroups) { /* The levels are not set up, e.g. for a duplicate of the factor */
+    ierr = MatSolve_SeqAIJ(A,bb,xx);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  ierr = VecGetArrayRead(bb,&b);CHKERRQ(ierr);
+  ierr = VecGetArrayWrite(xx,&x);CHKERRQ(ierr);
+  if (a->solvelevels.identity) tmp = x;
+  else {
+    tmp  = a->solve_work;
+    ierr = ISGetIndices(a->row,&r);CHKERRQ(ierr);
+    ierr = ISGetIndices(a->col,&c);CHKERRQ(ierr);
+  }
+
+  MatSolveLevelsPragmaOMP(parallel private(g))
+  {
+    /* forward solve the lower triangular */
+    for (g=0; g<L->ngroups; g++) {
+      PetscInt k;
+
+      if (L->parallel[g]) {
+        MatSolveLevelsPragmaOMP(for schedule(static))
+        for (k=L->groups[g]; k<L->groups[g+1]; k++) {
+          PetscInt        i = L->rows[k],nz = ai[i+1]-ai[i];
+          const PetscInt  *vi = aj+ai[i];
+          const MatScalar *v  = aa+ai[i];
+          PetscScalar     sum = r ? b[r[i]] : b[i];
+
+          PetscSparseDenseMinusDot(sum,tmp,v,vi,nz);
+          tmp[i] = sum;
+        }
+      } else {
+        MatSolveLevelsPragmaOMP(single)
+        for (k=L->groups[g]; k<L->groups[g+1]; k++) {
+          PetscInt        i = L->rows[k],nz = ai[i+1]-ai[i];
+          const PetscInt  *vi = aj+ai[i];
+          const MatScalar *v  = aa+ai[i];
+          PetscScalar     sum = r ? b[r[i]] : b[i];
+
+          PetscSparseDenseMinusDot(sum,tmp,v,vi,nz);
+          tmp[i] = sum;
+        }
+      }
+    }
+
+    /* backward solve the upper triangular */
+    for (g=0; g<U->ngroups; g++) {
+      PetscInt k;
+
+      if (U->parallel[g]) {
+        MatSolveLevelsPragmaOMP(for schedule(static))
+        for (k=U->groups[g]; k<U->groups[g+1]; k++) {
+          PetscInt        i = U->rows[k],nz = adiag[i]-adiag[i+1]-1;
+          const PetscInt  *vi = aj+adiag[i+1]+1;
+          const MatScalar *v  = aa+adiag[i+1]+1;
+          PetscScalar     sum = tmp[i];
+
+          PetscSparseDenseMinusDot(sum,tmp,v,vi,nz);
+          tmp[i] = sum*v[nz]; /* v[nz] = aa[adiag[i]] */
+          if (c) x[c[i]] = tmp[i];
+        }
+      } else {
+        MatSolveLevelsPragmaOMP(single)
+        for (k=U->groups[g]; k<U->groups[g+1]; k++) {
+          PetscInt        i = U->rows[k],nz = adiag[i]-adiag[i+1]-1;
+          const PetscInt  *vi = aj+adiag[i+1]+1;
+          const MatScalar *v  = aa+adiag[i+1]+1;
+          PetscScalar     sum = tmp[i];
+
+          PetscSparseDenseMinusDot(sum,tmp,v,vi,nz);
+          tmp[i] = sum*v[nz];
+          if (c) x[c[i]] = tmp[i];
+        }
+      }
+    }
+  }
+
+  if (!a->solvelevels.identity) {
+    ierr = ISRestoreIndices(a->row,&r);CHKERRQ(ierr);
+    ierr = ISRestoreIndices(a->col,&c);CHKERRQ(ierr);
+  }
+  ierr = VecRestoreArrayRead(bb,&b);CHKERRQ(ierr);
+  ierr = VecRestoreArrayWrite(xx,&x);CHKERRQ(ierr);
+  ierr = PetscLogFlops(2.0*a->nz - A->cmap->n);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode MatView_SeqAIJ_SolveLevels(Mat A,PetscViewer viewer)
+{
+  Mat_SeqAIJ        *a = (Mat_SeqAIJ*)A->data;
+  PetscErrorCode    ierr;
+  PetscBool         iascii;
+  PetscViewerFormat format;
+
+  PetscFunctionBegin;
+  if (!a->solvelevels.lower.ngroups) PetscFunctionReturn(0);
+  ierr = PetscObjectTypeCompare((PetscObject)viewer,PETSCVIEWERASCII,&iascii);CHKERRQ(ierr);
+  if (!iascii) PetscFunctionReturn(0);
+  ierr = PetscViewerGetFormat(viewer,&format);CHKERRQ(ierr);
+  if (format != PETSC_VIEWER_ASCII_INFO_DETAIL && format != PETSC_VIEWER_ASCII_INFO) PetscFunctionReturn(0);
+  ierr = PetscViewerASCIIPrintf(viewer,"Level-scheduled triangular solves: %s\n",a->solvelevels.use ? "used" : "not used, too few rows in wide levels");CHKERRQ(ierr);
+  ierr = PetscViewerASCIIPushTab(viewer);CHKERRQ(ierr);
+  ierr = PetscViewerASCIIPrintf(viewer,"L: %D levels merged in %D groups, U: %D levels merged in %D groups, minimum width %D\n",a->solvelevels.lower.nlevels,a->solvelevels.lower.ngroups,a->solvelevels.upper.nlevels,a->solvelevels.upper.ngroups,a->solvelevels.minwidth);CHKERRQ(ierr);
+  ierr = PetscViewerASCIIPopTab(viewer);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
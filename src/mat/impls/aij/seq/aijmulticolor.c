@@ -0,0 +1,166 @@
+/*
+  Multicolor SOR for MATSEQAIJ, set with MAT_SOR_MULTICOLOR.
+
+  The rows are colored with MatColoring on the symmetrized nonzero pattern, so the rows of one color are not coupled
+  and are relaxed in parallel by OpenMP threads. A forward sweep relaxes the colors in increasing order, a backward
+  sweep in decreasing order. The coloring only depends on the nonzero pattern, it is computed at the first MatSOR()
+  and kept until the nonzero pattern changes.
+*/
+#include <../src/mat/impls/aij/seq/aij.h>
+#if defined(PETSC_HAVE_OPENMP)
+#include <omp.h>
+#define MatSORMulticolorPragmaOMP(x) _Pragma(PetscStringize(omp x))
+#else
+#define MatSORMulticolorPragmaOMP(x)
+#endif
+
+PetscErrorCode MatDestroy_SeqAIJ_SORMulticolor(Mat A)
+{
+  Mat_SeqAIJ     *a = (Mat_SeqAIJ*)A->data;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscFree2(a->sormulticolor.colors,a->sormulticolor.rows);CHKERRQ(ierr);
+  a->sormulticolor.ncolors = 0;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatSeqAIJSORMulticolorSetUp_Private(Mat A)
+{
+  Mat_SeqAIJ               *a  = (Mat_SeqAIJ*)A->data;
+  Mat_SeqAIJ_SORMulticolor *mc = &a->sormulticolor;
+  Mat                      S   = A;
+  MatColoring              coloring;
+  ISColoring               iscoloring;
+  IS                       *iss;
+  const PetscInt           *idx;
+  PetscInt                 c,ncolors,n;
+  PetscErrorCode           ierr;
+
+  PetscFunctionBegin;
+  if (mc->ncolors && mc->mat_nonzerostate == A->nonzerostate) PetscFunctionReturn(0);
+  ierr = MatDestroy_SeqAIJ_SORMulticolor(A);CHKERRQ(ierr);
+  /* The rows of one color must not be coupled in either direction */
+  if (!A->structurally_symmetric) {
+    ierr = MatTranspose(A,MAT_INITIAL_MATRIX,&S);CHKERRQ(ierr);
+    ierr = MatAXPY(S,1.0,A,DIFFERENT_NONZERO_PATTERN);CHKERRQ(ierr);
+  }
+  ierr = MatColoringCreate(S,&coloring);CHKERRQ(ierr);
+  ierr = PetscObjectSetOptionsPrefix((PetscObject)coloring,((PetscObject)A)->prefix);CHKERRQ(ierr);
+  ierr = MatColoringSetType(coloring,MATCOLORINGGREEDY);CHKERRQ(ierr);
+  ierr = MatColoringSetDistance(coloring,1);CHKERRQ(ierr);
+  ierr = MatColoringSetFromOptions(coloring);CHKERRQ(ierr);
+  ierr = MatColoringApply(coloring,&iscoloring);CHKERRQ(ierr);
+  ierr = MatColoringDestroy(&coloring);CHKERRQ(ierr);
+  if (S != A) {ierr = MatDestroy(&S);CHKERRQ(ierr);}
+
+  ierr = ISColoringGetIS(iscoloring,PETSC_USE_POINTER,&ncolors,&iss);CHKERRQ(ierr);
+  ierr = PetscMalloc2(ncolors+1,&mc->colors,A->rmap->n,&mc->rows);CHKERRQ(ierr);
+  ierr = PetscLogObjectMemory((PetscObject)A,(ncolors+1+A->rmap->n)*sizeof(PetscInt));CHKERRQ(ierr);
+  mc->colors[0] = 0;
+  for (c=0; c<ncolors; c++) {
+    ierr = ISGetLocalSize(iss[c],&n);CHKERRQ(ierr);
+    ierr = ISGetIndices(iss[c],&idx);CHKERRQ(ierr);
+    ierr = PetscArraycpy(mc->rows+mc->colors[c],idx,n);CHKERRQ(ierr);
+    ierr = ISRestoreIndices(iss[c],&idx);CHKERRQ(ierr);
+    mc->colors[c+1] = mc->colors[c]+n;
+  }
+  ierr = ISColoringRestoreIS(iscoloring,PETSC_USE_POINTER,&iss);CHKERRQ(ierr);
+  ierr = ISColoringDestroy(&iscoloring);CHKERRQ(ierr);
+  if (mc->colors[ncolors] != A->rmap->n) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_PLIB,"Colored %D rows out of %D",mc->colors[ncolors],A->rmap->n);
+  mc->ncolors          = ncolors;
+  mc->mat_nonzerostate = A->nonzerostate;
+  ierr = PetscInfo2(A,"Colored the %D rows with %D colors for the multicolor SOR\n",A->rmap->n,ncolors);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* Relaxes the rows of the colors first, first+step, ..., last */
+PETSC_STATIC_INLINE void MatSORMulticolorSweep_Private(const Mat_SeqAIJ *a,const MatScalar *aa,const PetscScalar *b,PetscScalar *x,PetscReal omega,PetscInt first,PetscInt last,PetscInt step)
+{
+  const Mat_SeqAIJ_SORMulticolor *mc = &a->sormulticolor;
+  const PetscScalar              *idiag = a->idiag,*mdiag = a->mdiag;
+  PetscInt                       c,k;
+
+  MatSORMulticolorPragmaOMP(parallel private(c))
+  for (c=first; c!=last+step; c+=step) {
+    MatSORMulticolorPragmaOMP(for schedule(static))
+    for (k=mc->colors[c]; k<mc->colors[c+1]; k++) {
+      PetscInt        i   = mc->rows[k],n = a->i[i+1]-a->i[i];
+      const PetscInt  *vi = a->j+a->i[i];
+      const MatScalar *v  = aa+a->i[i];
+      PetscScalar     sum = b[i];
+
+      PetscSparseDenseMinusDot(sum,x,v,vi,n);
+      x[i] = (1.-omega)*x[i] + (sum + mdiag[i]*x[i])*idiag[i]; /* omega in idiag */
+    }
+  }
+}
+
+/* Same relaxation as MatSOR_SeqAIJ(), with the rows ordered by color instead of by index */
+PetscErrorCode MatSOR_SeqAIJ_Multicolor(Mat A,Vec bb,PetscReal omega,MatSORType flag,PetscReal fshift,PetscInt its,PetscInt lits,Vec xx)
+{
+  Mat_SeqAIJ        *a = (Mat_SeqAIJ*)A->data;
+  PetscInt          ncolors;
+  PetscScalar       *x;
+  const PetscScalar *b;
+  const MatScalar   *aa;
+  PetscErrorCode    ierr;
+
+  PetscFunctionBegin;
+  ierr = MatSeqAIJSORMulticolorSetUp_Private(A);CHKERRQ(ierr);
+  ncolors = a->sormulticolor.ncolors;
+  its     = its*lits;
+
+  if (fshift != a->fshift || omega != a->omega) a->idiagvalid = PETSC_FALSE; /* must recompute idiag[] */
+  if (!a->idiagvalid) {ierr = MatInvertDiagonal_SeqAIJ(A,omega,fshift);CHKERRQ(ierr);}
+  a->fshift = fshift;
+  a->omega  = omega;
+
+  ierr = MatSeqAIJGetArrayRead(A,&aa);CHKERRQ(ierr);
+  ierr = VecGetArrayRead(bb,&b);CHKERRQ(ierr);
+  if (flag & SOR_ZERO_INITIAL_GUESS) {
+    ierr = VecGetArrayWrite(xx,&x);CHKERRQ(ierr);
+    ierr = PetscArrayzero(x,A->rmap->n);CHKERRQ(ierr);
+  } else {
+    ierr = VecGetArray(xx,&x);CHKERRQ(ierr);
+  }
+  while (its--) {
+    if (flag & SOR_FORWARD_SWEEP || flag & SOR_LOCAL_FORWARD_SWEEP) {
+      MatSORMulticolorSweep_Private(a,aa,b,x,omega,0,ncolors-1,1);
+      ierr = PetscLogFlops(2.0*a->nz);CHKERRQ(ierr);
+    }
+    if (flag & SOR_BACKWARD_SWEEP || flag & SOR_LOCAL_BACKWARD_SWEEP) {
+      MatSORMulticolorSweep_Private(a,aa,b,x,omega,ncolors-1,0,-1);
+      ierr = PetscLogFlops(2.0*a->nz);CHKERRQ(ierr);
+    }
+  }
+  if (flag & SOR_ZERO_INITIAL_GUESS) {
+    ierr = VecRestoreArrayWrite(xx,&x);CHKERRQ(ierr);
+  } else {
+    ierr = VecRestoreArray(xx,&x);CHKERRQ(ierr);
+  }
+  ierr = VecRestoreArrayRead(bb,&b);CHKERRQ(ierr);
+  ierr = MatSeqAIJRestoreArrayRead(A,&aa);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode MatView_SeqAIJ_SORMulticolor(Mat A,PetscViewer viewer)
+{
+  Mat_SeqAIJ        *a = (Mat_SeqAIJ*)A->data;
+  PetscErrorCode    ierr;
+  PetscBool         iascii;
+  PetscViewerFormat format;
+
+  PetscFunctionBegin;
+  if (!a->sormulticolor.use) PetscFunctionReturn(0);
+  ierr = PetscObjectTypeCompare((PetscObject)viewer,PETSCVIEWERASCII,&iascii);CHKERRQ(ierr);
+  if (!iascii) PetscFunctionReturn(0);
+  ierr = PetscViewerGetFormat(viewer,&format);CHKERRQ(ierr);
+  if (format != PETSC_VIEWER_ASCII_INFO_DETAIL && format != PETSC_VIEWER_ASCII_INFO) PetscFunctionReturn(0);
+  if (a->sormulticolor.ncolors) {
+    ierr = PetscViewerASCIIPrintf(viewer,"Multicolor SOR with %D colors\n",a->sormulticolor.ncolors);CHKERRQ(ierr);
+  } else {
+    ierr = PetscViewerASCIIPrintf(viewer,"Multicolor SOR, rows not yet colored\n");CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
@@ -0,0 +1,517 @@
+/*
+  Defines the MATSEQAIJSINGLE matrix class, derived from MATSEQAIJ. It keeps the values of the matrix in
+  PetscScalar, for every operation inherited from MATSEQAIJ, and a copy of them in single precision that
+  MatMult(), MatMultAdd(), MatSOR() and the triangular solves of its LU and ILU factors read instead, with the
+  arithmetic done in PetscScalar. These kernels are limited by the memory bandwidth, reading 4 instead of 8
+  bytes per value makes them faster when the matrix only defines a preconditioner.
+
+  The copy is made again the first time one of these kernels is called after the object state of the matrix
+  changed, for example after MatAssemblyEnd() or a new numerical factorization.
+*/
+#include <../src/mat/impls/aij/seq/aij.h>
+
+#if defined(PETSC_USE_REAL_DOUBLE) && !defined(PETSC_USE_COMPLEX)
+typedef float MatScalarSingle;
+#else
+typedef MatScalar MatScalarSingle; /* no lower precision for this scalar type, the copy only duplicates the values */
+#endif
+
+typedef struct {
+  MatScalarSingle  *a;        /* single precision copy of the values, same layout as Mat_SeqAIJ->a */
+  PetscInt         maxnz;     /* length of a[] */
+  PetscObjectState state;     /* object state of the matrix when a[] was copied */
+  PetscErrorCode   (*lufactornumeric)(Mat,Mat,const MatFactorInfo*); /* numeric factorization chosen by the symbolic one */
+} Mat_SeqAIJSingle;
+
+#define MatSeqAIJSingleSparseDensePlusDot(sum,r,xv,xi,nnz) do { \
+    PetscInt __k; \
+    for (__k=0; __k<(nnz); __k++) (sum) += (PetscScalar)(xv)[__k]*(r)[(xi)[__k]]; \
+  } while (0)
+
+#define MatSeqAIJSingleSparseDenseMinusDot(sum,r,xv,xi,nnz) do { \
+    PetscInt __k; \
+    for (__k=0; __k<(nnz); __k++) (sum) -= (PetscScalar)(xv)[__k]*(r)[(xi)[__k]]; \
+  } while (0)
+
+/* Copies the values to single precision if the matrix changed since the last copy */
+static PetscErrorCode MatSeqAIJSingleGetArray_Private(Mat A,const MatScalarSingle **sa)
+{
+  PetscErrorCode   ierr;
+  Mat_SeqAIJ       *a = (Mat_SeqAIJ*)A->data;
+  Mat_SeqAIJSingle *s = (Mat_SeqAIJSingle*)A->spptr;
+  PetscObjectState state;
+  PetscInt         i,nz = 0;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectStateGet((PetscObject)A,&state);CHKERRQ(ierr);
+  if (state != s->state) {
+    /* the factors store U after L with the diagonal of row 0 last, see MatLUFactorSymbolic_SeqAIJ() */
+    if (A->rmap->n) nz = A->factortype ? a->diag[0]+1 : a->i[A->rmap->n];
+    if (nz > s->maxnz) {
+      ierr = PetscFree(s->a);CHKERRQ(ierr);
+      ierr = PetscMalloc1(nz,&s->a);CHKERRQ(ierr);
+      ierr = PetscLogObjectMemory((PetscObject)A,(nz-s->maxnz)*sizeof(MatScalarSingle));CHKERRQ(ierr);
+      s->maxnz = nz;
+    }
+    for (i=0; i<nz; i++) s->a[i] = (MatScalarSingle)a->a[i];
+    s->state = state;
+  }
+  *sa = s->a;
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode MatDestroy_SeqAIJSingle(Mat A)
+{
+  PetscErrorCode   ierr;
+  Mat_SeqAIJSingle *s = (Mat_SeqAIJSingle*)A->spptr;
+
+  PetscFunctionBegin;
+  if (s) {
+    ierr = PetscFree(s->a);CHKERRQ(ierr);
+  }
+  ierr = PetscFree(A->spptr);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)A,"MatConvert_seqaijsingle_seqaij_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectChangeTypeName((PetscObject)A,MATSEQAIJ);CHKERRQ(ierr);
+  ierr = MatDestroy_SeqAIJ(A);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode MatMult_SeqAIJSingle(Mat A,Vec xx,Vec yy)
+{
+  Mat_SeqAIJ            *a = (Mat_SeqAIJ*)A->data;
+  PetscScalar           *y,sum;
+  const PetscScalar     *x;
+  const MatScalarSingle *aa,*v;
+  PetscErrorCode        ierr;
+  const PetscInt        *ii = a->i,*aj;
+  PetscInt              m = A->rmap->n,n,i;
+
+  PetscFunctionBegin;
+  ierr = MatSeqAIJSingleGetArray_Private(A,&aa);CHKERRQ(ierr);
+  ierr = VecGetArrayRead(xx,&x);CHKERRQ(ierr);
+  ierr = VecGetArrayWrite(yy,&y);CHKERRQ(ierr);
+  for (i=0; i<m; i++) {
+    n   = ii[i+1] - ii[i];
+    aj  = a->j + ii[i];
+    v   = aa + ii[i];
+    sum = 0.0;
+    MatSeqAIJSingleSparseDensePlusDot(sum,x,v,aj,n);
+    y[i] = sum;
+  }
+  ierr = PetscLogFlops(2.0*a->nz - a->nonzerorowcnt);CHKERRQ(ierr);
+  ierr = VecRestoreArrayRead(xx,&x);CHKERRQ(ierr);
+  ierr = VecRestoreArrayWrite(yy,&y);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode MatMultAdd_SeqAIJSingle(Mat A,Vec xx,Vec yy,Vec zz)
+{
+  Mat_SeqAIJ            *a = (Mat_SeqAIJ*)A->data;
+  PetscScalar           *y,*z,sum;
+  const PetscScalar     *x;
+  const MatScalarSingle *aa,*v;
+  PetscErrorCode        ierr;
+  const PetscInt        *ii = a->i,*aj;
+  PetscInt              m = A->rmap->n,n,i;
+
+  PetscFunctionBegin;
+  ierr = MatSeqAIJSingleGetArray_Private(A,&aa);CHKERRQ(ierr);
+  ierr = VecGetArrayRead(xx,&x);CHKERRQ(ierr);
+  ierr = VecGetArrayPair(yy,zz,&y,&z);CHKERRQ(ierr);
+  for (i=0; i<m; i++) {
+    n   = ii[i+1] - ii[i];
+    aj  = a->j + ii[i];
+    v   = aa + ii[i];
+    sum = y[i];
+    MatSeqAIJSingleSparseDensePlusDot(sum,x,v,aj,n);
+    z[i] = sum;
+  }
+  ierr = PetscLogFlops(2.0*a->nz);CHKERRQ(ierr);
+  ierr = VecRestoreArrayRead(xx,&x);CHKERRQ(ierr);
+  ierr = VecRestoreArrayPair(yy,zz,&y,&z);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+   The forward, backward and symmetric sweeps of MatSOR_SeqAIJ() with the single precision values, the inverse
+   of the diagonal is still computed in PetscScalar by MatInvertDiagonal_SeqAIJ(). Eisenstat's trick, the
+   applications of the triangular parts and the multicolor sweeps are left to MatSOR_SeqAIJ().
+*/
+PetscErrorCode MatSOR_SeqAIJSingle(Mat A,Vec bb,PetscReal omega,MatSORType flag,PetscReal fshift,PetscInt its,PetscInt lits,Vec xx)
+{
+  Mat_SeqAIJ            *a = (Mat_SeqAIJ*)A->data;
+  PetscScalar           *x,sum,*t;
+  const MatScalarSingle *v,*aa;
+  const PetscScalar     *b,*xb,*idiag;
+  PetscErrorCode        ierr;
+  PetscInt              n,m = A->rmap->n,i;
+  const PetscInt        *idx,*diag,*ai = a->i;
+
+  PetscFunctionBegin;
+  if (a->sormulticolor.use || (flag & SOR_EISENSTAT) || flag == SOR_APPLY_UPPER || flag == SOR_APPLY_LOWER) {
+    ierr = MatSOR_SeqAIJ(A,bb,omega,flag,fshift,its,lits,xx);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  its = its*lits;
+
+  if (fshift != a->fshift || omega != a->omega) a->idiagvalid = PETSC_FALSE; /* must recompute idiag[] */
+  if (!a->idiagvalid) {ierr = MatInvertDiagonal_SeqAIJ(A,omega,fshift);CHKERRQ(ierr);}
+  a->fshift = fshift;
+  a->omega  = omega;
+
+  diag  = a->diag;
+  t     = a->ssor_work;
+  idiag = a->idiag;
+
+  ierr = MatSeqAIJSingleGetArray_Private(A,&aa);CHKERRQ(ierr);
+  ierr = VecGetArray(xx,&x);CHKERRQ(ierr);
+  ierr = VecGetArrayRead(bb,&b);CHKERRQ(ierr);
+  if (flag & SOR_ZERO_INITIAL_GUESS) {
+    if (flag & SOR_FORWARD_SWEEP || flag & SOR_LOCAL_FORWARD_SWEEP) {
+      for (i=0; i<m; i++) {
+        n   = diag[i] - ai[i];
+        idx = a->j + ai[i];
+        v   = aa + ai[i];
+        sum = b[i];
+        MatSeqAIJSingleSparseDenseMinusDot(sum,x,v,idx,n);
+        t[i] = sum;
+        x[i] = sum*idiag[i];
+      }
+      xb   = t;
+      ierr = PetscLogFlops(a->nz);CHKERRQ(ierr);
+    } else xb = b;
+    if (flag & SOR_BACKWARD_SWEEP || flag & SOR_LOCAL_BACKWARD_SWEEP) {
+      for (i=m-1; i>=0; i--) {
+        n   = ai[i+1] - diag[i] - 1;
+        idx = a->j + diag[i] + 1;
+        v   = aa + diag[i] + 1;
+        sum = xb[i];
+        MatSeqAIJSingleSparseDenseMinusDot(sum,x,v,idx,n);
+        if (xb == b) {
+          x[i] = sum*idiag[i];
+        } else {
+          x[i] = (1-omega)*x[i] + sum*idiag[i];  /* omega in idiag */
+        }
+      }
+      ierr = PetscLogFlops(a->nz);CHKERRQ(ierr); /* assumes 1/2 in upper */
+    }
+    its--;
+  }
+  while (its--) {
+    if (flag & SOR_FORWARD_SWEEP || flag & SOR_LOCAL_FORWARD_SWEEP) {
+      for (i=0; i<m; i++) {
+        /* lower */
+        n   = diag[i] - ai[i];
+        idx = a->j + ai[i];
+        v   = aa + ai[i];
+        sum = b[i];
+        MatSeqAIJSingleSparseDenseMinusDot(sum,x,v,idx,n);
+        t[i] = sum;             /* save application of the lower-triangular part */
+        /* upper */
+        n   = ai[i+1] - diag[i] - 1;
+        idx = a->j + diag[i] + 1;
+        v   = aa + diag[i] + 1;
+        MatSeqAIJSingleSparseDenseMinusDot(sum,x,v,idx,n);
+        x[i] = (1. - omega)*x[i] + sum*idiag[i]; /* omega in idiag */
+      }
+      xb   = t;
+      ierr = PetscLogFlops(2.0*a->nz);CHKERRQ(ierr);
+    } else xb = b;
+    if (flag & SOR_BACKWARD_SWEEP || flag & SOR_LOCAL_BACKWARD_SWEEP) {
+      for (i=m-1; i>=0; i--) {
+        sum = xb[i];
+        if (xb == b) {
+          /* whole matrix without the diagonal (no checkpointing available) */
+          n   = diag[i] - ai[i];
+          idx = a->j + ai[i];
+          v   = aa + ai[i];
+          MatSeqAIJSingleSparseDenseMinusDot(sum,x,v,idx,n);
+          n   = ai[i+1] - diag[i] - 1;
+          idx = a->j + diag[i] + 1;
+          v   = aa + diag[i] + 1;
+          MatSeqAIJSingleSparseDenseMinusDot(sum,x,v,idx,n);
+          x[i] = (1. - omega)*x[i] + sum*idiag[i];
+        } else { /* lower-triangular part has been saved, so only apply upper-triangular */
+          n   = ai[i+1] - diag[i] - 1;
+          idx = a->j + diag[i] + 1;
+          v   = aa + diag[i] + 1;
+          MatSeqAIJSingleSparseDenseMinusDot(sum,x,v,idx,n);
+          x[i] = (1. - omega)*x[i] + sum*idiag[i];  /* omega in idiag */
+        }
+      }
+      if (xb == b) {
+        ierr = PetscLogFlops(2.0*a->nz);CHKERRQ(ierr);
+      } else {
+        ierr = PetscLogFlops(a->nz);CHKERRQ(ierr); /* assumes 1/2 in upper */
+      }
+    }
+  }
+  ierr = VecRestoreArray(xx,&x);CHKERRQ(ierr);
+  ierr = VecRestoreArrayRead(bb,&b);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* MatSolve_SeqAIJ_NaturalOrdering() with the single precision values of the factor */
+static PetscErrorCode MatSolve_SeqAIJSingle_NaturalOrdering(Mat A,Vec bb,Vec xx)
+{
+  Mat_SeqAIJ            *a = (Mat_SeqAIJ*)A->data;
+  PetscErrorCode        ierr;
+  PetscInt              n   = A->rmap->n;
+  const PetscInt        *ai = a->i,*aj = a->j,*adiag = a->diag,*vi;
+  PetscScalar           *x,sum;
+  const PetscScalar     *b;
+  const MatScalarSingle *aa,*v;
+  PetscInt              i,nz;
+
+  PetscFunctionBegin;
+  if (!n) PetscFunctionReturn(0);
+
+  ierr = MatSeqAIJSingleGetArray_Private(A,&aa);CHKERRQ(ierr);
+  ierr = VecGetArrayRead(bb,&b);CHKERRQ(ierr);
+  ierr = VecGetArrayWrite(xx,&x);CHKERRQ(ierr);
+
+  /* forward solve the lower triangular */
+  x[0] = b[0];
+  v    = aa;
+  vi   = aj;
+  for (i=1; i<n; i++) {
+    nz  = ai[i+1] - ai[i];
+    sum = b[i];
+    MatSeqAIJSingleSparseDenseMinusDot(sum,x,v,vi,nz);
+    v   += nz;
+    vi  += nz;
+    x[i] = sum;
+  }
+
+  /* backward solve the upper triangular */
+  for (i=n-1; i>=0; i--) {
+    v   = aa + adiag[i+1] + 1;
+    vi  = aj + adiag[i+1] + 1;
+    nz  = adiag[i] - adiag[i+1]-1;
+    sum = x[i];
+    MatSeqAIJSingleSparseDenseMinusDot(sum,x,v,vi,nz);
+    x[i] = sum*v[nz]; /* v[nz] = aa[adiag[i]] */
+  }
+
+  ierr = PetscLogFlops(2.0*a->nz - A->cmap->n);CHKERRQ(ierr);
+  ierr = VecRestoreArrayRead(bb,&b);CHKERRQ(ierr);
+  ierr = VecRestoreArrayWrite(xx,&x);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* MatSolve_SeqAIJ() with the single precision values of the factor */
+static PetscErrorCode MatSolve_SeqAIJSingle(Mat A,Vec bb,Vec xx)
+{
+  Mat_SeqAIJ            *a    = (Mat_SeqAIJ*)A->data;
+  IS                    iscol = a->col,isrow = a->row;
+  PetscErrorCode        ierr;
+  PetscInt              i,n = A->rmap->n,nz;
+  const PetscInt        *ai = a->i,*aj = a->j,*adiag = a->diag,*vi;
+  const PetscInt        *rout,*cout,*r,*c;
+  PetscScalar           *x,*tmp,sum;
+  const PetscScalar     *b;
+  const MatScalarSingle *aa,*v;
+
+  PetscFunctionBegin;
+  if (!n) PetscFunctionReturn(0);
+
+  ierr = MatSeqAIJSingleGetArray_Private(A,&aa);CHKERRQ(ierr);
+  ierr = VecGetArrayRead(bb,&b);CHKERRQ(ierr);
+  ierr = VecGetArrayWrite(xx,&x);CHKERRQ(ierr);
+  tmp  = a->solve_work;
+
+  ierr = ISGetIndices(isrow,&rout);CHKERRQ(ierr); r = rout;
+  ierr = ISGetIndices(iscol,&cout);CHKERRQ(ierr); c = cout;
+
+  /* forward solve the lower triangular */
+  tmp[0] = b[r[0]];
+  v      = aa;
+  vi     = aj;
+  for (i=1; i<n; i++) {
+    nz  = ai[i+1] - ai[i];
+    sum = b[r[i]];
+    MatSeqAIJSingleSparseDenseMinusDot(sum,tmp,v,vi,nz);
+    tmp[i] = sum;
+    v     += nz; vi += nz;
+  }
+
+  /* backward solve the upper triangular */
+  for (i=n-1; i>=0; i--) {
+    v   = aa + adiag[i+1]+1;
+    vi  = aj + adiag[i+1]+1;
+    nz  = adiag[i]-adiag[i+1]-1;
+    sum = tmp[i];
+    MatSeqAIJSingleSparseDenseMinusDot(sum,tmp,v,vi,nz);
+    x[c[i]] = tmp[i] = sum*v[nz]; /* v[nz] = aa[adiag[i]] */
+  }
+
+  ierr = ISRestoreIndices(isrow,&rout);CHKERRQ(ierr);
+  ierr = ISRestoreIndices(iscol,&cout);CHKERRQ(ierr);
+  ierr = VecRestoreArrayRead(bb,&b);CHKERRQ(ierr);
+  ierr = VecRestoreArrayWrite(xx,&x);CHKERRQ(ierr);
+  ierr = PetscLogFlops(2.0*a->nz - A->cmap->n);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+   The factorizations are those of MATSEQAIJ, the factor only swaps the triangular solves for the ones above when
+   the numeric factorization picked the solves of the standard (not in-place) storage of the factor
+*/
+static PetscErrorCode MatLUFactorNumeric_SeqAIJSingle(Mat B,Mat A,const MatFactorInfo *info)
+{
+  PetscErrorCode   ierr;
+  Mat_SeqAIJSingle *s = (Mat_SeqAIJSingle*)B->spptr;
+
+  PetscFunctionBegin;
+  ierr = (*s->lufactornumeric)(B,A,info);CHKERRQ(ierr);
+  if (B->ops->solve == MatSolve_SeqAIJ_NaturalOrdering) B->ops->solve = MatSolve_SeqAIJSingle_NaturalOrdering;
+  else if (B->ops->solve == MatSolve_SeqAIJ || B->ops->solve == MatSolve_SeqAIJ_Inode) B->ops->solve = MatSolve_SeqAIJSingle;
+  if (B->ops->lufactornumeric != MatLUFactorNumeric_SeqAIJSingle) {
+    s->lufactornumeric      = B->ops->lufactornumeric;
+    B->ops->lufactornumeric = MatLUFactorNumeric_SeqAIJSingle;
+  }
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatLUFactorSymbolic_SeqAIJSingle(Mat B,Mat A,IS isrow,IS iscol,const MatFactorInfo *info)
+{
+  PetscErrorCode   ierr;
+  Mat_SeqAIJSingle *s = (Mat_SeqAIJSingle*)B->spptr;
+
+  PetscFunctionBegin;
+  ierr = MatLUFactorSymbolic_SeqAIJ(B,A,isrow,iscol,info);CHKERRQ(ierr);
+  s->lufactornumeric      = B->ops->lufactornumeric;
+  B->ops->lufactornumeric = MatLUFactorNumeric_SeqAIJSingle;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatILUFactorSymbolic_SeqAIJSingle(Mat B,Mat A,IS isrow,IS iscol,const MatFactorInfo *info)
+{
+  PetscErrorCode   ierr;
+  Mat_SeqAIJSingle *s = (Mat_SeqAIJSingle*)B->spptr;
+
+  PetscFunctionBegin;
+  ierr = MatILUFactorSymbolic_SeqAIJ(B,A,isrow,iscol,info);CHKERRQ(ierr);
+  s->lufactornumeric      = B->ops->lufactornumeric;
+  B->ops->lufactornumeric = MatLUFactorNumeric_SeqAIJSingle;
+  PetscFunctionReturn(0);
+}
+
+/* The LU and ILU factors are MATSEQAIJSINGLE too, the Cholesky and ICC factors are those of MATSEQAIJ */
+PETSC_INTERN PetscErrorCode MatGetFactor_seqaijsingle_petsc(Mat A,MatFactorType ftype,Mat *B)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MatGetFactor_seqaij_petsc(A,ftype,B);CHKERRQ(ierr);
+  if (ftype == MAT_FACTOR_LU || ftype == MAT_FACTOR_ILU) {
+    ierr = MatConvert_SeqAIJ_SeqAIJSingle(*B,MATSEQAIJSINGLE,MAT_INPLACE_MATRIX,B);CHKERRQ(ierr);
+    (*B)->ops->lufactorsymbolic  = MatLUFactorSymbolic_SeqAIJSingle;
+    (*B)->ops->ilufactorsymbolic = MatILUFactorSymbolic_SeqAIJSingle;
+  }
+  PetscFunctionReturn(0);
+}
+
+PETSC_INTERN PetscErrorCode MatConvert_SeqAIJSingle_SeqAIJ(Mat A,MatType type,MatReuse reuse,Mat *newmat)
+{
+  PetscErrorCode   ierr;
+  Mat              B = *newmat;
+  Mat_SeqAIJSingle *s;
+
+  PetscFunctionBegin;
+  if (reuse == MAT_REUSE_MATRIX) {
+    ierr = MatCopy(A,B,SAME_NONZERO_PATTERN);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  if (reuse == MAT_INITIAL_MATRIX) {
+    ierr = MatDuplicate(A,MAT_COPY_VALUES,&B);CHKERRQ(ierr);
+  }
+  s = (Mat_SeqAIJSingle*)B->spptr;
+
+  /* Reset the original function pointers. */
+  B->ops->destroy = MatDestroy_SeqAIJ;
+  B->ops->mult    = MatMult_SeqAIJ;
+  B->ops->multadd = MatMultAdd_SeqAIJ;
+  B->ops->sor     = MatSOR_SeqAIJ;
+
+  ierr = PetscObjectComposeFunction((PetscObject)B,"MatConvert_seqaijsingle_seqaij_C",NULL);CHKERRQ(ierr);
+  ierr = PetscFree(s->a);CHKERRQ(ierr);
+  ierr = PetscFree(B->spptr);CHKERRQ(ierr);
+  ierr = PetscObjectChangeTypeName((PetscObject)B,MATSEQAIJ);CHKERRQ(ierr);
+  *newmat = B;
+  PetscFunctionReturn(0);
+}
+
+/* MatConvert_SeqAIJ_SeqAIJSingle converts a SeqAIJ matrix into a
+ * SeqAIJSingle matrix.  This routine is called by the MatCreate_SeqAIJSingle()
+ * routine, but can also be used to convert an assembled SeqAIJ matrix
+ * into a SeqAIJSingle one. */
+PETSC_INTERN PetscErrorCode MatConvert_SeqAIJ_SeqAIJSingle(Mat A,MatType type,MatReuse reuse,Mat *newmat)
+{
+  PetscErrorCode   ierr;
+  Mat              B = *newmat;
+  Mat_SeqAIJSingle *s;
+  PetscBool        sametype;
+
+  PetscFunctionBegin;
+  if (reuse == MAT_REUSE_MATRIX) {
+    ierr = MatCopy(A,B,SAME_NONZERO_PATTERN);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  if (reuse == MAT_INITIAL_MATRIX) {
+    ierr = MatDuplicate(A,MAT_COPY_VALUES,&B);CHKERRQ(ierr);
+  }
+  ierr = PetscObjectTypeCompare((PetscObject)A,type,&sametype);CHKERRQ(ierr);
+  if (sametype) {*newmat = B; PetscFunctionReturn(0);}
+
+  ierr     = PetscNewLog(B,&s);CHKERRQ(ierr);
+  s->state = -1;
+  B->spptr = (void*)s;
+
+  /* the inode kernels would bypass the single precision values */
+  ((Mat_SeqAIJ*)B->data)->inode.use = PETSC_FALSE;
+
+  /* Set function pointers for methods that we inherit from AIJ but override. */
+  B->ops->destroy = MatDestroy_SeqAIJSingle;
+  B->ops->mult    = MatMult_SeqAIJSingle;
+  B->ops->multadd = MatMultAdd_SeqAIJSingle;
+  B->ops->sor     = MatSOR_SeqAIJSingle;
+
+  ierr    = PetscObjectComposeFunction((PetscObject)B,"MatConvert_seqaijsingle_seqaij_C",MatConvert_SeqAIJSingle_SeqAIJ);CHKERRQ(ierr);
+  ierr    = PetscObjectChangeTypeName((PetscObject)B,MATSEQAIJSINGLE);CHKERRQ(ierr);
+  *newmat = B;
+  PetscFunctionReturn(0);
+}
+
+/*MC
+   MATSEQAIJSINGLE - MATSEQAIJSINGLE = "seqaijsingle" - A matrix type to be used for sequential sparse matrices that
+   only define a preconditioner. It is the MATSEQAIJ format with an additional copy of the values in single precision
+   that MatMult(), MatMultAdd(), MatSOR() and MatSolve() with its LU and ILU factors read, the computations are done
+   in the precision of PetscScalar. All the other operations use the values in PetscScalar.
+
+   Options Database Keys:
++  -mat_type seqaijsingle - sets the matrix type to "seqaijsingle" during a call to MatSetFromOptions()
+-  -pc_mat_precision single - converts a MATSEQAIJ Pmat of the PC to this type in PCSetUp()
+
+   Notes:
+   The single precision copy adds half the memory of the values and is made again the first time one of these
+   operations is called after the matrix changed. The preconditioner is then that of the matrix rounded to single
+   precision, which is fine inside a Krylov method that applies the operator in full precision, but a stationary
+   method such as PCSOR with KSPRICHARDSON alone cannot converge beyond the single precision accuracy.
+
+   In complex or single precision builds the copy has the precision of PetscScalar.
+
+   Level: intermediate
+
+.seealso: MatCreateSeqAIJ(), MATSEQAIJ, PCSetMatPrecision()
+M*/
+
+PETSC_EXTERN PetscErrorCode MatCreate_SeqAIJSingle(Mat A)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MatSetType(A,MATSEQAIJ);CHKERRQ(ierr);
+  ierr = MatConvert_SeqAIJ_SeqAIJSingle(A,MATSEQAIJSINGLE,MAT_INPLACE_MATRIX,&A);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
@@ -124,6 +124,13 @@ PetscErrorCode MatMatMultSymbolic_SeqAIJ_SeqAIJ(Mat A,Mat B,PetscReal fill,Mat C
     PetscFunctionReturn(0);
   }
 
+  /* hash_omp */
+  ierr = PetscStrcmp(alg,"hash_omp",&flg);CHKERRQ(ierr);
+  if (flg) {
+    ierr = MatMatMultSymbolic_SeqAIJ_SeqAIJ_HashOMP(A,B,fill,C);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+
 #if defined(PETSC_HAVE_HYPRE)
   ierr = PetscStrcmp(alg,"hypre",&flg);CHKERRQ(ierr);
   if (flg) {
@@ -1501,18 +1508,51 @@ PetscErrorCode MatMatMultSymbolic_SeqAIJ_SeqDense(Mat A,Mat B,PetscReal fill,Mat
   PetscFunctionReturn(0);
 }
 
+/* Maximum number of columns of B (and C) processed in one pass over the CSR matrix */
+#define MAT_AIJ_DENSE_MAX_FUSED 16
+
+/*
+   Computes k columns of C = A*B (or C += A*B) with a single pass over A. The k columns of B are given row-major in bt,
+   so the k values needed by each nonzero of A are contiguous and the loops over k vectorize. Called with a literal k
+   so the compiler can specialize the inner loops.
+*/
+PETSC_STATIC_INLINE void MatMatMultFused_SeqAIJ_SeqDense_Private(const PetscInt k,PetscInt am,const PetscInt *ai,const PetscInt *aj,const PetscScalar *av,const PetscScalar *bt,PetscScalar *c,PetscInt clda,PetscBool add)
+{
+  PetscScalar       r[MAT_AIJ_DENSE_MAX_FUSED];
+  const PetscScalar *aa,*btj;
+  const PetscInt    *ajj;
+  PetscInt          i,j,l,n;
+
+  for (i=0; i<am; i++) {
+    n   = ai[i+1] - ai[i];
+    ajj = aj + ai[i];
+    aa  = av + ai[i];
+    PetscPragmaSIMD
+    for (l=0; l<k; l++) r[l] = 0.0;
+    for (j=0; j<n; j++) {
+      const PetscScalar aatmp = aa[j];
+
+      btj = bt + ajj[j]*k;
+      PetscPragmaSIMD
+      for (l=0; l<k; l++) r[l] += aatmp*btj[l];
+    }
+    if (add) for (l=0; l<k; l++) c[l*clda+i] += r[l];
+    else     for (l=0; l<k; l++) c[l*clda+i]  = r[l];
+  }
+}
+
 PETSC_INTERN PetscErrorCode MatMatMultNumericAdd_SeqAIJ_SeqDense(Mat A,Mat B,Mat C,const PetscBool add)
 {
   Mat_SeqAIJ        *a=(Mat_SeqAIJ*)A->data;
   Mat_SeqDense      *bd=(Mat_SeqDense*)B->data;
   Mat_SeqDense      *cd=(Mat_SeqDense*)C->data;
   PetscErrorCode    ierr;
-  PetscScalar       *c,r1,r2,r3,r4,*c1,*c2,*c3,*c4;
-  const PetscScalar *aa,*b,*b1,*b2,*b3,*b4,*av;
+  PetscScalar       *c,*bt = NULL,r1;
+  const PetscScalar *aa,*b,*b1,*av;
   const PetscInt    *aj;
-  PetscInt          cm=C->rmap->n,cn=B->cmap->n,bm=bd->lda,am=A->rmap->n;
+  PetscInt          cm=C->rmap->n,cn=B->cmap->n,bm=bd->lda,bn=B->rmap->n,am=A->rmap->n;
   PetscInt          clda=cd->lda;
-  PetscInt          am4=4*clda,bm4=4*bm,col,i,j,n;
+  PetscInt          col,i,j,k,l,n;
 
   PetscFunctionBegin;
   if (!cm || !cn) PetscFunctionReturn(0);
@@ -1523,96 +1563,46 @@ PETSC_INTERN PetscErrorCode MatMatMultNumericAdd_SeqAIJ_SeqDense(Mat A,Mat B,Mat
     ierr = MatDenseGetArrayWrite(C,&c);CHKERRQ(ierr);
   }
   ierr = MatDenseGetArrayRead(B,&b);CHKERRQ(ierr);
-  b1 = b; b2 = b1 + bm; b3 = b2 + bm; b4 = b3 + bm;
-  c1 = c; c2 = c1 + clda; c3 = c2 + clda; c4 = c3 + clda;
-  for (col=0; col<(cn/4)*4; col += 4) {  /* over columns of C */
-    for (i=0; i<am; i++) {        /* over rows of A in those columns */
-      r1 = r2 = r3 = r4 = 0.0;
-      n  = a->i[i+1] - a->i[i];
-      aj = a->j + a->i[i];
-      aa = av + a->i[i];
-      for (j=0; j<n; j++) {
-        const PetscScalar aatmp = aa[j];
-        const PetscInt    ajtmp = aj[j];
-        r1 += aatmp*b1[ajtmp];
-        r2 += aatmp*b2[ajtmp];
-        r3 += aatmp*b3[ajtmp];
-        r4 += aatmp*b4[ajtmp];
-      }
-      if (add) {
-        c1[i] += r1;
-        c2[i] += r2;
-        c3[i] += r3;
-        c4[i] += r4;
-      } else {
-        c1[i] = r1;
-        c2[i] = r2;
-        c3[i] = r3;
-        c4[i] = r4;
-      }
-    }
-    b1 += bm4; b2 += bm4; b3 += bm4; b4 += bm4;
-    c1 += am4; c2 += am4; c3 += am4; c4 += am4;
-  }
-  /* process remaining columns */
-  if (col != cn) {
-    PetscInt rc = cn-col;
-
-    if (rc == 1) {
+  if (cn > 1) {ierr = PetscMalloc1(bn*PetscMin(cn,MAT_AIJ_DENSE_MAX_FUSED),&bt);CHKERRQ(ierr);}
+  /* process the columns of C in blocks of at most MAT_AIJ_DENSE_MAX_FUSED, each with a single pass over A */
+  for (col=0; col<cn; col += k) {
+    k = PetscMin(cn-col,MAT_AIJ_DENSE_MAX_FUSED);
+    if (k == 1) {
+      b1 = b + col*bm;
       for (i=0; i<am; i++) {
         r1 = 0.0;
         n  = a->i[i+1] - a->i[i];
         aj = a->j + a->i[i];
         aa = av + a->i[i];
         for (j=0; j<n; j++) r1 += aa[j]*b1[aj[j]];
-        if (add) c1[i] += r1;
-        else c1[i] = r1;
-      }
-    } else if (rc == 2) {
-      for (i=0; i<am; i++) {
-        r1 = r2 = 0.0;
-        n  = a->i[i+1] - a->i[i];
-        aj = a->j + a->i[i];
-        aa = av + a->i[i];
-        for (j=0; j<n; j++) {
-          const PetscScalar aatmp = aa[j];
-          const PetscInt    ajtmp = aj[j];
-          r1 += aatmp*b1[ajtmp];
-          r2 += aatmp*b2[ajtmp];
-        }
-        if (add) {
-          c1[i] += r1;
-          c2[i] += r2;
-        } else {
-          c1[i] = r1;
-          c2[i] = r2;
-        }
-      }
-    } else {
-      for (i=0; i<am; i++) {
-        r1 = r2 = r3 = 0.0;
-        n  = a->i[i+1] - a->i[i];
-        aj = a->j + a->i[i];
-        aa = av + a->i[i];
-        for (j=0; j<n; j++) {
-          const PetscScalar aatmp = aa[j];
-          const PetscInt    ajtmp = aj[j];
-          r1 += aatmp*b1[ajtmp];
-          r2 += aatmp*b2[ajtmp];
-          r3 += aatmp*b3[ajtmp];
-        }
-        if (add) {
-          c1[i] += r1;
-          c2[i] += r2;
-          c3[i] += r3;
-        } else {
-          c1[i] = r1;
-          c2[i] = r2;
-          c3[i] = r3;
-        }
+        if (add) c[col*clda+i] += r1;
+        else c[col*clda+i] = r1;
       }
+      continue;
+    }
+    /* interlace the k columns of B so that each row of B is contiguous */
+    for (l=0; l<k; l++) {
+      b1 = b + (col+l)*bm;
+      for (i=0; i<bn; i++) bt[i*k+l] = b1[i];
+    }
+    switch (k) {
+    case 2:
+      MatMatMultFused_SeqAIJ_SeqDense_Private(2,am,a->i,a->j,av,bt,c+col*clda,clda,add);
+      break;
+    case 4:
+      MatMatMultFused_SeqAIJ_SeqDense_Private(4,am,a->i,a->j,av,bt,c+col*clda,clda,add);
+      break;
+    case 8:
+      MatMatMultFused_SeqAIJ_SeqDense_Private(8,am,a->i,a->j,av,bt,c+col*clda,clda,add);
+      break;
+    case 16:
+      MatMatMultFused_SeqAIJ_SeqDense_Private(16,am,a->i,a->j,av,bt,c+col*clda,clda,add);
+      break;
+    default:
+      MatMatMultFused_SeqAIJ_SeqDense_Private(k,am,a->i,a->j,av,bt,c+col*clda,clda,add);
     }
   }
+  ierr = PetscFree(bt);CHKERRQ(ierr);
   ierr = PetscLogFlops(cn*(2.0*a->nz));CHKERRQ(ierr);
   if (add) {
     ierr = MatDenseRestoreArray(C,&c);CHKERRQ(ierr);
@@ -1998,11 +1988,11 @@ static PetscErrorCode MatProductSetFromOptions_SeqAIJ_AB(Mat C)
   PetscInt       alg = 0; /* default algorithm */
   PetscBool      flg = PETSC_FALSE;
 #if !defined(PETSC_HAVE_HYPRE)
-  const char     *algTypes[7] = {"sorted","scalable","scalable_fast","heap","btheap","llcondensed","rowmerge"};
-  PetscInt       nalg = 7;
-#else
-  const char     *algTypes[8] = {"sorted","scalable","scalable_fast","heap","btheap","llcondensed","rowmerge","hypre"};
+  const char     *algTypes[8] = {"sorted","scalable","scalable_fast","heap","btheap","llcondensed","rowmerge","hash_omp"};
   PetscInt       nalg = 8;
+#else
+  const char     *algTypes[9] = {"sorted","scalable","scalable_fast","heap","btheap","llcondensed","rowmerge","hash_omp","hypre"};
+  PetscInt       nalg = 9;
 #endif
 
   PetscFunctionBegin;
@@ -2102,11 +2092,11 @@ static PetscErrorCode MatProductSetFromOptions_SeqAIJ_PtAP(Mat C)
   PetscBool      flg = PETSC_FALSE;
   PetscInt       alg = 0; /* default algorithm -- alg=1 should be default!!! */
 #if !defined(PETSC_HAVE_HYPRE)
-  const char      *algTypes[2] = {"scalable","rap"};
-  PetscInt        nalg = 2;
-#else
-  const char      *algTypes[3] = {"scalable","rap","hypre"};
+  const char      *algTypes[3] = {"scalable","rap","hash_omp"};
   PetscInt        nalg = 3;
+#else
+  const char      *algTypes[4] = {"scalable","rap","hash_omp","hypre"};
+  PetscInt        nalg = 4;
 #endif
 
   PetscFunctionBegin;
@@ -2175,8 +2165,8 @@ static PetscErrorCode MatProductSetFromOptions_SeqAIJ_ABC(Mat C)
   Mat_Product    *product = C->product;
   PetscInt       alg = 0; /* default algorithm */
   PetscBool      flg = PETSC_FALSE;
-  const char     *algTypes[7] = {"sorted","scalable","scalable_fast","heap","btheap","llcondensed","rowmerge"};
-  PetscInt       nalg = 7;
+  const char     *algTypes[8] = {"sorted","scalable","scalable_fast","heap","btheap","llcondensed","rowmerge","hash_omp"};
+  PetscInt       nalg = 8;
 
   PetscFunctionBegin;
   /* Set default algorithm */
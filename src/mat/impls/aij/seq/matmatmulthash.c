@@ -0,0 +1,201 @@
+/*
+  Row-parallel matrix-matrix product C = A * B for pairs of SeqAIJ matrices, algorithm "hash_omp".
+
+  The symbolic product makes two passes over the rows of C, distributed over the OpenMP threads. The first pass counts
+  the nonzeros of each row with a hash set private to the thread, the second inserts the columns of each row again and
+  copies them, sorted, into the preallocated CSR structure. The numeric product computes each row in a dense
+  accumulator private to the thread. No PETSc routine is called inside the parallel regions, the threads only use the
+  khash kernels, which allocate with the C library. Without OpenMP the same passes run on one thread.
+*/
+#include <../src/mat/impls/aij/seq/aij.h>
+#include <petsc/private/hashseti.h>
+#if defined(PETSC_HAVE_OPENMP)
+#include <omp.h>
+#define MatMatMultHashPragmaOMP(x) _Pragma(PetscStringize(omp x))
+#else
+#define MatMatMultHashPragmaOMP(x)
+#endif
+
+PETSC_STATIC_INLINE PetscInt MatMatMultHashThreads_Private(void)
+{
+#if defined(PETSC_HAVE_OPENMP)
+  return (PetscInt)omp_get_max_threads();
+#else
+  return 1;
+#endif
+}
+
+PETSC_STATIC_INLINE PetscInt MatMatMultHashThreadId_Private(void)
+{
+#if defined(PETSC_HAVE_OPENMP)
+  return (PetscInt)omp_get_thread_num();
+#else
+  return 0;
+#endif
+}
+
+/* Inserts the columns of row i of A*B in ht, returns nonzero if khash failed to allocate */
+PETSC_STATIC_INLINE int MatMatMultHashRow_Private(PetscHSetI ht,PetscInt i,const PetscInt *ai,const PetscInt *aj,const PetscInt *bi,const PetscInt *bj,PetscBool diag)
+{
+  PetscInt k,l;
+  int      ret;
+
+  kh_clear(HSetI,ht);
+  for (k=ai[i]; k<ai[i+1]; k++) {
+    for (l=bi[aj[k]]; l<bi[aj[k]+1]; l++) {
+      kh_put(HSetI,ht,bj[l],&ret);
+      if (ret < 0) return 1;
+    }
+  }
+  if (diag) {
+    kh_put(HSetI,ht,i,&ret);
+    if (ret < 0) return 1;
+  }
+  return 0;
+}
+
+PETSC_STATIC_INLINE void MatMatMultHashSiftDown_Private(PetscInt *v,PetscInt root,PetscInt n)
+{
+  PetscInt child,swap;
+
+  while ((child = 2*root+1) < n) {
+    if (child+1 < n && v[child] < v[child+1]) child++;
+    if (v[root] >= v[child]) return;
+    swap = v[root]; v[root] = v[child]; v[child] = swap;
+    root = child;
+  }
+}
+
+/* Heapsort, PetscSortInt() is not called from the threads since it pushes on the PETSc stack */
+PETSC_STATIC_INLINE void MatMatMultHashSortInt_Private(PetscInt n,PetscInt *v)
+{
+  PetscInt k,swap;
+
+  for (k=n/2-1; k>=0; k--) MatMatMultHashSiftDown_Private(v,k,n);
+  for (k=n-1; k>0; k--) {
+    swap = v[0]; v[0] = v[k]; v[k] = swap;
+    MatMatMultHashSiftDown_Private(v,0,k);
+  }
+}
+
+PetscErrorCode MatMatMultSymbolic_SeqAIJ_SeqAIJ_HashOMP(Mat A,Mat B,PetscReal fill,Mat C)
+{
+  PetscErrorCode ierr;
+  Mat_SeqAIJ     *a  = (Mat_SeqAIJ*)A->data,*b=(Mat_SeqAIJ*)B->data,*c;
+  const PetscInt *ai = a->i,*bi=b->i,*aj=a->j,*bj=b->j;
+  PetscInt       *ci,*cj;
+  PetscInt       am=A->rmap->N,bn=B->cmap->N,bm=B->rmap->N;
+  PetscInt       i,t,nthreads = MatMatMultHashThreads_Private();
+  PetscReal      afill;
+  PetscHSetI     *ht;
+  PetscBool      diag = C->force_diagonals;
+  int            fail = 0;
+
+  PetscFunctionBegin;
+  ierr = PetscMalloc1(nthreads,&ht);CHKERRQ(ierr);
+  for (t=0; t<nthreads; t++) {ierr = PetscHSetICreate(&ht[t]);CHKERRQ(ierr);}
+  ierr  = PetscMalloc1(am+1,&ci);CHKERRQ(ierr);
+  ci[0] = 0;
+
+  /* First pass: count the nonzeros of the rows of C */
+  MatMatMultHashPragmaOMP(parallel for schedule(dynamic,64) reduction(|:fail))
+  for (i=0; i<am; i++) {
+    PetscHSetI hti = ht[MatMatMultHashThreadId_Private()];
+
+    fail   |= MatMatMultHashRow_Private(hti,i,ai,aj,bi,bj,(PetscBool)(diag && i < bn));
+    ci[i+1] = (PetscInt)kh_size(hti);
+  }
+  if (fail) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_MEM,"Hash set allocation failed");
+  for (i=0; i<am; i++) ci[i+1] += ci[i];
+  ierr = PetscMalloc1(ci[am]+1,&cj);CHKERRQ(ierr);
+
+  /* Second pass: fill the sorted columns of the rows of C */
+  MatMatMultHashPragmaOMP(parallel for schedule(dynamic,64) reduction(|:fail))
+  for (i=0; i<am; i++) {
+    PetscHSetI hti = ht[MatMatMultHashThreadId_Private()];
+    PetscInt   *cjj = cj+ci[i],n = 0;
+    khiter_t   iter;
+
+    fail |= MatMatMultHashRow_Private(hti,i,ai,aj,bi,bj,(PetscBool)(diag && i < bn));
+    for (iter=kh_begin(hti); iter!=kh_end(hti); iter++) {
+      if (kh_exist(hti,iter)) cjj[n++] = kh_key(hti,iter);
+    }
+    MatMatMultHashSortInt_Private(n,cjj);
+  }
+  if (fail) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_MEM,"Hash set allocation failed");
+  for (t=0; t<nthreads; t++) {ierr = PetscHSetIDestroy(&ht[t]);CHKERRQ(ierr);}
+  ierr = PetscFree(ht);CHKERRQ(ierr);
+
+  /* put together the new symbolic matrix */
+  ierr = MatSetSeqAIJWithArrays_private(PetscObjectComm((PetscObject)A),am,bn,ci,cj,NULL,((PetscObject)A)->type_name,C);CHKERRQ(ierr);
+  ierr = MatSetBlockSizesFromMats(C,A,B);CHKERRQ(ierr);
+
+  /* These are PETSc arrays, so change flags so arrays can be deleted by PETSc */
+  c          = (Mat_SeqAIJ*)(C->data);
+  c->free_a  = PETSC_TRUE;
+  c->free_ij = PETSC_TRUE;
+  c->nonew   = 0;
+
+  C->ops->matmultnumeric = MatMatMultNumeric_SeqAIJ_SeqAIJ_HashOMP;
+
+  /* set MatInfo */
+  afill = (PetscReal)ci[am]/PetscMax(ai[am]+bi[bm],1) + 1.e-5;
+  if (afill < 1.0) afill = 1.0;
+  c->maxnz                  = ci[am];
+  c->nz                     = ci[am];
+  C->info.mallocs           = 0;
+  C->info.fill_ratio_given  = fill;
+  C->info.fill_ratio_needed = afill;
+  ierr = PetscInfo3(C,"Symbolic product with %D nonzeros on %D threads, fill ratio needed %g\n",ci[am],nthreads,(double)afill);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode MatMatMultNumeric_SeqAIJ_SeqAIJ_HashOMP(Mat A,Mat B,Mat C)
+{
+  PetscErrorCode    ierr;
+  PetscLogDouble    flops = 0.0;
+  Mat_SeqAIJ        *a = (Mat_SeqAIJ*)A->data,*b = (Mat_SeqAIJ*)B->data,*c = (Mat_SeqAIJ*)C->data;
+  const PetscInt    *ai = a->i,*aj = a->j,*bi = b->i,*bj = b->j,*ci = c->i,*cj = c->j;
+  PetscInt          am = A->rmap->n,bn = B->cmap->N,i,nthreads = MatMatMultHashThreads_Private();
+  PetscScalar       *ca,*work;
+  const PetscScalar *aa,*ba;
+
+  PetscFunctionBegin;
+  ierr = MatSeqAIJGetArrayRead(A,&aa);CHKERRQ(ierr);
+  ierr = MatSeqAIJGetArrayRead(B,&ba);CHKERRQ(ierr);
+  if (!c->a) { /* first numeric product */
+    ierr      = PetscMalloc1(ci[am]+1,&c->a);CHKERRQ(ierr);
+    c->free_a = PETSC_TRUE;
+  }
+  ca   = c->a;
+  /* the accumulators are zeroed again by the rows that use them */
+  ierr = PetscCalloc1(nthreads*bn,&work);CHKERRQ(ierr);
+
+  MatMatMultHashPragmaOMP(parallel for schedule(dynamic,64) reduction(+:flops))
+  for (i=0; i<am; i++) {
+    PetscScalar *acc = work+MatMatMultHashThreadId_Private()*bn;
+    PetscInt    k,l;
+
+    for (k=ai[i]; k<ai[i+1]; k++) {
+      const PetscInt    brow = aj[k];
+      const PetscScalar v    = aa[k];
+
+      for (l=bi[brow]; l<bi[brow+1]; l++) acc[bj[l]] += v*ba[l];
+      flops += 2*(bi[brow+1]-bi[brow]);
+    }
+    for (k=ci[i]; k<ci[i+1]; k++) {
+      ca[k]      = acc[cj[k]];
+      acc[cj[k]] = 0.0;
+    }
+  }
+  ierr = PetscFree(work);CHKERRQ(ierr);
+#if defined(PETSC_HAVE_DEVICE)
+  if (C->offloadmask != PETSC_OFFLOAD_UNALLOCATED) C->offloadmask = PETSC_OFFLOAD_CPU;
+#endif
+  ierr = MatAssemblyBegin(C,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(C,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = PetscLogFlops(flops);CHKERRQ(ierr);
+  ierr = MatSeqAIJRestoreArrayRead(A,&aa);CHKERRQ(ierr);
+  ierr = MatSeqAIJRestoreArrayRead(B,&ba);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
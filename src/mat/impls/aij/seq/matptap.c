@@ -32,8 +32,9 @@ PetscErrorCode MatProductSymbolic_PtAP_SeqAIJ_SeqAIJ(Mat C)
     PetscFunctionReturn(0);
   }
 
-  /* "rap" */
+  /* "rap" and "hash_omp", the latter computes both products of Pt*(A*P) with the row-parallel algorithm */
   ierr = PetscStrcmp(alg,"rap",&flg);CHKERRQ(ierr);
+  if (!flg) {ierr = PetscStrcmp(alg,"hash_omp",&flg);CHKERRQ(ierr);}
   if (flg) {
     Mat_MatTransMatMult *atb;
 
@@ -0,0 +1,69 @@
+/*
+      Inverts PETSC_KERNEL_BATCH_SIZE bs by bs matrices at once with Gauss-Jordan elimination.
+
+    The matrices are interleaved, so the innermost loops run over the matrices of the batch and
+    are vectorized. The elimination does not pivot, a matrix with a pivot small relative to its
+    largest entry is inverted again from a copy with the LINPACK routines dgefa() and dgedi().
+
+       Used by PCPBJACOBI and PCVPBJACOBI
+*/
+#include <petscsys.h>
+#include <petsc/private/kernels/blockinvert.h>
+
+PETSC_EXTERN PetscErrorCode PetscKernel_A_gets_inverse_A_Batch(PetscInt bs,MatScalar *a,PetscInt *pivots,MatScalar *work,PetscBool allowzeropivot,PetscBool *zeropivotdetected)
+{
+  const PetscInt nb = PETSC_KERNEL_BATCH_SIZE;
+  PetscInt       bs2 = bs*bs,i,j,k,l;
+  MatScalar      p[PETSC_KERNEL_BATCH_SIZE],*aik,*akj,*aij,*blk = work+nb*bs2;
+  MatReal        amax[PETSC_KERNEL_BATCH_SIZE];
+  PetscBool      repivot[PETSC_KERNEL_BATCH_SIZE],zp;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (zeropivotdetected) *zeropivotdetected = PETSC_FALSE;
+  ierr = PetscArraycpy(work,a,nb*bs2);CHKERRQ(ierr);
+  for (l=0; l<nb; l++) {amax[l] = 0.0; repivot[l] = PETSC_FALSE;}
+  for (i=0; i<bs2; i++) {
+    for (l=0; l<nb; l++) amax[l] = PetscMax(amax[l],PetscAbsScalar(a[i*nb+l]));
+  }
+
+  for (k=0; k<bs; k++) {
+    aik = a + (k+k*bs)*nb;
+    for (l=0; l<nb; l++) {
+      if (PetscAbsScalar(aik[l]) <= PETSC_SQRT_MACHINE_EPSILON*amax[l]) repivot[l] = PETSC_TRUE;
+      p[l]   = repivot[l] ? 1.0 : 1.0/aik[l];
+      aik[l] = p[l];
+    }
+    /* scale row k */
+    for (j=0; j<bs; j++) {
+      if (j == k) continue;
+      akj = a + (k+j*bs)*nb;
+      PetscPragmaSIMD
+      for (l=0; l<nb; l++) akj[l] *= p[l];
+    }
+    /* eliminate column k from the other rows */
+    for (i=0; i<bs; i++) {
+      if (i == k) continue;
+      aik = a + (i+k*bs)*nb;
+      for (j=0; j<bs; j++) {
+        if (j == k) continue;
+        aij = a + (i+j*bs)*nb;
+        akj = a + (k+j*bs)*nb;
+        PetscPragmaSIMD
+        for (l=0; l<nb; l++) aij[l] -= aik[l]*akj[l];
+      }
+      PetscPragmaSIMD
+      for (l=0; l<nb; l++) aik[l] = -aik[l]*p[l];
+    }
+  }
+
+  /* invert the matrices with small pivots again with partial pivoting */
+  for (l=0; l<nb; l++) {
+    if (!repivot[l]) continue;
+    for (i=0; i<bs2; i++) blk[i] = work[i*nb+l];
+    ierr = PetscKernel_A_gets_inverse_A(bs,blk,pivots,blk+bs2,allowzeropivot,&zp);CHKERRQ(ierr);
+    if (zp && zeropivotdetected) *zeropivotdetected = PETSC_TRUE;
+    for (i=0; i<bs2; i++) a[i*nb+l] = blk[i];
+  }
+  PetscFunctionReturn(0);
+}
@@ -18,7 +18,7 @@ PetscErrorCode MatDisAssemble_MPISELL(Mat A)
   Mat_MPISELL    *sell=(Mat_MPISELL*)A->data;
   Mat            B=sell->B,Bnew;
   Mat_SeqSELL    *Bsell=(Mat_SeqSELL*)B->data;
-  PetscInt       i,j,totalslices,N=A->cmap->N,ec,row;
+  PetscInt       i,j,totalslices,N=A->cmap->N,ec,row,sh=Bsell->sliceheight;
   PetscBool      isnonzero;
   PetscErrorCode ierr;
 
@@ -45,6 +45,8 @@ PetscErrorCode MatDisAssemble_MPISELL(Mat A)
   ierr = MatSetSizes(Bnew,B->rmap->n,N,B->rmap->n,N);CHKERRQ(ierr);
   ierr = MatSetBlockSizesFromMats(Bnew,A,A);CHKERRQ(ierr);
   ierr = MatSetType(Bnew,((PetscObject)B)->type_name);CHKERRQ(ierr);
+  ierr = MatSELLSetSliceHeight(Bnew,sh);CHKERRQ(ierr);
+  ierr = MatSELLSetSigma(Bnew,Bsell->sigma);CHKERRQ(ierr);
   ierr = MatSeqSELLSetPreallocation(Bnew,0,Bsell->rlen);CHKERRQ(ierr);
   if (Bsell->nonew >= 0) { /* Inherit insertion error options (if positive). */
     ((Mat_SeqSELL*)Bnew->data)->nonew = Bsell->nonew;
@@ -56,12 +58,12 @@ PetscErrorCode MatDisAssemble_MPISELL(Mat A)
    */
   Bnew->nonzerostate = B->nonzerostate;
 
-  totalslices = B->rmap->n/8+((B->rmap->n & 0x07)?1:0); /* floor(n/8) */
+  totalslices = Bsell->totalslices;
   for (i=0; i<totalslices; i++) { /* loop over slices */
-    for (j=Bsell->sliidx[i],row=0; j<Bsell->sliidx[i+1]; j++,row=((row+1)&0x07)) {
-      isnonzero = (PetscBool)((j-Bsell->sliidx[i])/8 < Bsell->rlen[8*i+row]);
+    for (j=Bsell->sliidx[i],row=0; j<Bsell->sliidx[i+1]; j++,row=((row+1)%sh)) {
+      isnonzero = (PetscBool)((j-Bsell->sliidx[i])/sh < Bsell->rlen[MatSeqSELLRowOfPosition(Bsell,sh*i+row)]);
       if (isnonzero) {
-        ierr = MatSetValue(Bnew,8*i+row,sell->garray[Bsell->colidx[j]],Bsell->val[j],B->insertmode);CHKERRQ(ierr);
+        ierr = MatSetValue(Bnew,MatSeqSELLRowOfPosition(Bsell,sh*i+row),sell->garray[Bsell->colidx[j]],Bsell->val[j],B->insertmode);CHKERRQ(ierr);
       }
     }
   }
@@ -82,7 +84,7 @@ PetscErrorCode MatSetUpMultiply_MPISELL(Mat mat)
   Mat_MPISELL    *sell=(Mat_MPISELL*)mat->data;
   Mat_SeqSELL    *B=(Mat_SeqSELL*)(sell->B->data);
   PetscErrorCode ierr;
-  PetscInt       i,j,*bcolidx=B->colidx,ec=0,*garray,totalslices;
+  PetscInt       i,j,*bcolidx=B->colidx,ec=0,*garray,totalslices,sh=B->sliceheight;
   IS             from,to;
   Vec            gvec;
   PetscBool      isnonzero;
@@ -95,7 +97,7 @@ PetscErrorCode MatSetUpMultiply_MPISELL(Mat mat)
 #endif
 
   PetscFunctionBegin;
-  totalslices = sell->B->rmap->n/8+((sell->B->rmap->n & 0x07)?1:0); /* floor(n/8) */
+  totalslices = B->totalslices;
 
   /* ec counts the number of columns that contain nonzeros */
 #if defined(PETSC_USE_CTABLE)
@@ -103,7 +105,7 @@ PetscErrorCode MatSetUpMultiply_MPISELL(Mat mat)
   ierr = PetscTableCreate(sell->B->rmap->n,mat->cmap->N+1,&gid1_lid1);CHKERRQ(ierr);
   for (i=0; i<totalslices; i++) { /* loop over slices */
     for (j=B->sliidx[i]; j<B->sliidx[i+1]; j++) {
-      isnonzero = (PetscBool)((j-B->sliidx[i])/8 < B->rlen[(i<<3)+(j&0x07)]);
+      isnonzero = (PetscBool)((j-B->sliidx[i])/sh < B->rlen[MatSeqSELLRowOfPosition(B,sh*i+(j-B->sliidx[i])%sh)]);
       if (isnonzero) { /* check the mask bit */
         PetscInt data,gid1 = bcolidx[j] + 1;
         ierr = PetscTableFind(gid1_lid1,gid1,&data);CHKERRQ(ierr);
@@ -133,7 +135,7 @@ PetscErrorCode MatSetUpMultiply_MPISELL(Mat mat)
   /* compact out the extra columns in B */
   for (i=0; i<totalslices; i++) { /* loop over slices */
     for (j=B->sliidx[i]; j<B->sliidx[i+1]; j++) {
-      isnonzero = (PetscBool)((j-B->sliidx[i])/8 < B->rlen[(i<<3)+(j&0x07)]);
+      isnonzero = (PetscBool)((j-B->sliidx[i])/sh < B->rlen[MatSeqSELLRowOfPosition(B,sh*i+(j-B->sliidx[i])%sh)]);
       if (isnonzero) {
         PetscInt gid1 = bcolidx[j] + 1;
         ierr = PetscTableFind(gid1_lid1,gid1,&lid);CHKERRQ(ierr);
@@ -151,7 +153,7 @@ PetscErrorCode MatSetUpMultiply_MPISELL(Mat mat)
   /* mark those columns that are in sell->B */
   for (i=0; i<totalslices; i++) { /* loop over slices */
     for (j=B->sliidx[i]; j<B->sliidx[i+1]; j++) {
-      isnonzero = (PetscBool)((j-B->sliidx[i])/8 < B->rlen[(i<<3)+(j&0x07)]);
+      isnonzero = (PetscBool)((j-B->sliidx[i])/sh < B->rlen[MatSeqSELLRowOfPosition(B,sh*i+(j-B->sliidx[i])%sh)]);
       if (isnonzero) {
         if (!indices[bcolidx[j]]) ec++;
         indices[bcolidx[j]] = 1;
@@ -174,7 +176,7 @@ PetscErrorCode MatSetUpMultiply_MPISELL(Mat mat)
   /* compact out the extra columns in B */
   for (i=0; i<totalslices; i++) { /* loop over slices */
     for (j=B->sliidx[i]; j<B->sliidx[i+1]; j++) {
-      isnonzero = (PetscBool)((j-B->sliidx[i])/8 < B->rlen[(i<<3)+(j&0x07)]);
+      isnonzero = (PetscBool)((j-B->sliidx[i])/sh < B->rlen[MatSeqSELLRowOfPosition(B,sh*i+(j-B->sliidx[i])%sh)]);
       if (isnonzero) bcolidx[j] = indices[bcolidx[j]];
     }
   }
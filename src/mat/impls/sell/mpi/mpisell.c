@@ -71,28 +71,28 @@ PetscErrorCode MatCreateColmap_MPISELL_Private(Mat mat)
     lastcol1 = col; \
     while (high1-low1 > 5) { \
       t = (low1+high1)/2; \
-      if (*(cp1+8*t) > col) high1 = t; \
+      if (*(cp1+a->sliceheight*t) > col) high1 = t; \
       else                   low1 = t; \
     } \
     for (_i=low1; _i<high1; _i++) { \
-      if (*(cp1+8*_i) > col) break; \
-      if (*(cp1+8*_i) == col) { \
-        if (addv == ADD_VALUES) *(vp1+8*_i) += value;   \
-        else                     *(vp1+8*_i) = value; \
+      if (*(cp1+a->sliceheight*_i) > col) break; \
+      if (*(cp1+a->sliceheight*_i) == col) { \
+        if (addv == ADD_VALUES) *(vp1+a->sliceheight*_i) += value;   \
+        else                     *(vp1+a->sliceheight*_i) = value; \
         goto a_noinsert; \
       } \
     }  \
     if (value == 0.0 && ignorezeroentries) {low1 = 0; high1 = nrow1;goto a_noinsert;} \
     if (nonew == 1) {low1 = 0; high1 = nrow1; goto a_noinsert;} \
     if (nonew == -1) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"Inserting a new nonzero at global row/column (%D, %D) into matrix", orow, ocol); \
-    MatSeqXSELLReallocateSELL(A,am,1,nrow1,a->sliidx,row/8,row,col,a->colidx,a->val,cp1,vp1,nonew,MatScalar); \
+    MatSeqXSELLReallocateSELL(A,am,1,nrow1,a->sliidx,MatSeqSELLPositionOfRow(a,row)/a->sliceheight,row,col,a->colidx,a->val,cp1,vp1,nonew,MatScalar); \
     /* shift up all the later entries in this row */ \
     for (ii=nrow1-1; ii>=_i; ii--) { \
-      *(cp1+8*(ii+1)) = *(cp1+8*ii); \
-      *(vp1+8*(ii+1)) = *(vp1+8*ii); \
+      *(cp1+a->sliceheight*(ii+1)) = *(cp1+a->sliceheight*ii); \
+      *(vp1+a->sliceheight*(ii+1)) = *(vp1+a->sliceheight*ii); \
     } \
-    *(cp1+8*_i) = col; \
-    *(vp1+8*_i) = value; \
+    *(cp1+a->sliceheight*_i) = col; \
+    *(vp1+a->sliceheight*_i) = value; \
     a->nz++; nrow1++; A->nonzerostate++; \
     a_noinsert: ; \
     a->rlen[row] = nrow1; \
@@ -105,28 +105,28 @@ PetscErrorCode MatCreateColmap_MPISELL_Private(Mat mat)
     lastcol2 = col; \
     while (high2-low2 > 5) { \
       t = (low2+high2)/2; \
-      if (*(cp2+8*t) > col) high2 = t; \
+      if (*(cp2+b->sliceheight*t) > col) high2 = t; \
       else low2  = t; \
     } \
     for (_i=low2; _i<high2; _i++) { \
-      if (*(cp2+8*_i) > col) break; \
-      if (*(cp2+8*_i) == col) { \
-        if (addv == ADD_VALUES) *(vp2+8*_i) += value; \
-        else                     *(vp2+8*_i) = value; \
+      if (*(cp2+b->sliceheight*_i) > col) break; \
+      if (*(cp2+b->sliceheight*_i) == col) { \
+        if (addv == ADD_VALUES) *(vp2+b->sliceheight*_i) += value; \
+        else                     *(vp2+b->sliceheight*_i) = value; \
         goto b_noinsert; \
       } \
     } \
     if (value == 0.0 && ignorezeroentries) {low2 = 0; high2 = nrow2; goto b_noinsert;} \
     if (nonew == 1) {low2 = 0; high2 = nrow2; goto b_noinsert;} \
     if (nonew == -1) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"Inserting a new nonzero at global row/column (%D, %D) into matrix", orow, ocol); \
-    MatSeqXSELLReallocateSELL(B,bm,1,nrow2,b->sliidx,row/8,row,col,b->colidx,b->val,cp2,vp2,nonew,MatScalar); \
+    MatSeqXSELLReallocateSELL(B,bm,1,nrow2,b->sliidx,MatSeqSELLPositionOfRow(b,row)/b->sliceheight,row,col,b->colidx,b->val,cp2,vp2,nonew,MatScalar); \
     /* shift up all the later entries in this row */ \
     for (ii=nrow2-1; ii>=_i; ii--) { \
-      *(cp2+8*(ii+1)) = *(cp2+8*ii); \
-      *(vp2+8*(ii+1)) = *(vp2+8*ii); \
+      *(cp2+b->sliceheight*(ii+1)) = *(cp2+b->sliceheight*ii); \
+      *(vp2+b->sliceheight*(ii+1)) = *(vp2+b->sliceheight*ii); \
     } \
-    *(cp2+8*_i) = col; \
-    *(vp2+8*_i) = value; \
+    *(cp2+b->sliceheight*_i) = col; \
+    *(vp2+b->sliceheight*_i) = value; \
     b->nz++; nrow2++; B->nonzerostate++; \
     b_noinsert: ; \
     b->rlen[row] = nrow2; \
@@ -157,14 +157,14 @@ PetscErrorCode MatSetValues_MPISELL(Mat mat,PetscInt m,const PetscInt im[],Petsc
     if (im[i] >= rstart && im[i] < rend) {
       row      = im[i] - rstart;
       lastcol1 = -1;
-      shift1   = a->sliidx[row>>3]+(row&0x07); /* starting index of the row */
+      shift1   = MatSeqSELLRowShift(a,row); /* starting index of the row */
       cp1      = a->colidx+shift1;
       vp1      = a->val+shift1;
       nrow1    = a->rlen[row];
       low1     = 0;
       high1    = nrow1;
       lastcol2 = -1;
-      shift2   = b->sliidx[row>>3]+(row&0x07); /* starting index of the row */
+      shift2   = MatSeqSELLRowShift(b,row); /* starting index of the row */
       cp2      = b->colidx+shift2;
       vp2      = b->val+shift2;
       nrow2    = b->rlen[row];
@@ -197,7 +197,7 @@ PetscErrorCode MatSetValues_MPISELL(Mat mat,PetscInt m,const PetscInt im[],Petsc
               /* Reinitialize the variables required by MatSetValues_SeqSELL_B_Private() */
               B      = sell->B;
               b      = (Mat_SeqSELL*)B->data;
-              shift2 = b->sliidx[row>>3]+(row&0x07); /* starting index of the row */
+              shift2 = MatSeqSELLRowShift(b,row); /* starting index of the row */
               cp2    = b->colidx+shift2;
               vp2    = b->val+shift2;
               nrow2  = b->rlen[row];
@@ -518,6 +518,8 @@ PetscErrorCode MatDestroy_MPISELL(Mat mat)
   ierr = PetscObjectComposeFunction((PetscObject)mat,"MatMPISELLSetPreallocation_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)mat,"MatConvert_mpisell_mpiaij_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)mat,"MatDiagonalScaleLocal_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)mat,"MatSELLSetSliceHeight_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)mat,"MatSELLSetSigma_C",NULL);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
@@ -614,9 +616,9 @@ PetscErrorCode MatView_MPISELL_ASCIIorDraworSocket(Mat mat,PetscViewer viewer)
     acolidx = Aloc->colidx; aval = Aloc->val;
     for (i=0; i<Aloc->totalslices; i++) { /* loop over slices */
       for (j=Aloc->sliidx[i]; j<Aloc->sliidx[i+1]; j++) {
-        isnonzero = (PetscBool)((j-Aloc->sliidx[i])/8 < Aloc->rlen[(i<<3)+(j&0x07)]);
+        isnonzero = (PetscBool)((j-Aloc->sliidx[i])/Aloc->sliceheight < Aloc->rlen[MatSeqSELLRowOfPosition(Aloc,Aloc->sliceheight*i+(j-Aloc->sliidx[i])%Aloc->sliceheight)]);
         if (isnonzero) { /* check the mask bit */
-          row  = (i<<3)+(j&0x07) + mat->rmap->rstart; /* i<<3 is the starting row of this slice */
+          row  = MatSeqSELLRowOfPosition(Aloc,Aloc->sliceheight*i+(j-Aloc->sliidx[i])%Aloc->sliceheight) + mat->rmap->rstart;
           col  = *acolidx + mat->rmap->rstart;
           ierr = MatSetValues(A,1,&row,1,&col,aval,INSERT_VALUES);CHKERRQ(ierr);
         }
@@ -629,9 +631,9 @@ PetscErrorCode MatView_MPISELL_ASCIIorDraworSocket(Mat mat,PetscViewer viewer)
     acolidx = Aloc->colidx; aval = Aloc->val;
     for (i=0; i<Aloc->totalslices; i++) {
       for (j=Aloc->sliidx[i]; j<Aloc->sliidx[i+1]; j++) {
-        isnonzero = (PetscBool)((j-Aloc->sliidx[i])/8 < Aloc->rlen[(i<<3)+(j&0x07)]);
+        isnonzero = (PetscBool)((j-Aloc->sliidx[i])/Aloc->sliceheight < Aloc->rlen[MatSeqSELLRowOfPosition(Aloc,Aloc->sliceheight*i+(j-Aloc->sliidx[i])%Aloc->sliceheight)]);
         if (isnonzero) {
-          row  = (i<<3)+(j&0x07) + mat->rmap->rstart;
+          row  = MatSeqSELLRowOfPosition(Aloc,Aloc->sliceheight*i+(j-Aloc->sliidx[i])%Aloc->sliceheight) + mat->rmap->rstart;
           col  = sell->garray[*acolidx];
           ierr = MatSetValues(A,1,&row,1,&col,aval,INSERT_VALUES);CHKERRQ(ierr);
         }
@@ -953,10 +955,17 @@ static PetscErrorCode MatSetRandom_MPISELL(Mat x,PetscRandom rctx)
 
 PetscErrorCode MatSetFromOptions_MPISELL(PetscOptionItems *PetscOptionsObject,Mat A)
 {
+  Mat_MPISELL    *sell=(Mat_MPISELL*)A->data;
+  PetscInt       sliceheight=sell->sliceheight,sigma=sell->sigma;
+  PetscBool      flg;
   PetscErrorCode ierr;
 
   PetscFunctionBegin;
   ierr = PetscOptionsHead(PetscOptionsObject,"MPISELL options");CHKERRQ(ierr);
+  ierr = PetscOptionsInt("-mat_sell_slice_height","Number of rows in a slice","MatSELLSetSliceHeight",sliceheight,&sliceheight,&flg);CHKERRQ(ierr);
+  if (flg) {ierr = MatSELLSetSliceHeight(A,sliceheight);CHKERRQ(ierr);}
+  ierr = PetscOptionsInt("-mat_sell_sigma","Size of the windows of rows sorted by length, 1 means no sorting","MatSELLSetSigma",sigma,&sigma,&flg);CHKERRQ(ierr);
+  if (flg) {ierr = MatSELLSetSigma(A,sigma);CHKERRQ(ierr);}
   ierr = PetscOptionsTail();CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
@@ -1191,11 +1200,15 @@ PetscErrorCode MatMPISELLSetPreallocation_MPISELL(Mat B,PetscInt d_rlenmax,const
     ierr = MatSetSizes(b->A,B->rmap->n,B->cmap->n,B->rmap->n,B->cmap->n);CHKERRQ(ierr);
     ierr = MatSetBlockSizesFromMats(b->A,B,B);CHKERRQ(ierr);
     ierr = MatSetType(b->A,MATSEQSELL);CHKERRQ(ierr);
+    ierr = MatSELLSetSliceHeight(b->A,b->sliceheight);CHKERRQ(ierr);
+    ierr = MatSELLSetSigma(b->A,b->sigma);CHKERRQ(ierr);
     ierr = PetscLogObjectParent((PetscObject)B,(PetscObject)b->A);CHKERRQ(ierr);
     ierr = MatCreate(PETSC_COMM_SELF,&b->B);CHKERRQ(ierr);
     ierr = MatSetSizes(b->B,B->rmap->n,B->cmap->N,B->rmap->n,B->cmap->N);CHKERRQ(ierr);
     ierr = MatSetBlockSizesFromMats(b->B,B,B);CHKERRQ(ierr);
     ierr = MatSetType(b->B,MATSEQSELL);CHKERRQ(ierr);
+    ierr = MatSELLSetSliceHeight(b->B,b->sliceheight);CHKERRQ(ierr);
+    ierr = MatSELLSetSigma(b->B,b->sigma);CHKERRQ(ierr);
     ierr = PetscLogObjectParent((PetscObject)B,(PetscObject)b->B);CHKERRQ(ierr);
   }
 
@@ -1212,6 +1225,30 @@ PetscErrorCode MatMPISELLSetPreallocation_MPISELL(Mat B,PetscInt d_rlenmax,const
   PetscFunctionReturn(0);
 }
 
+PetscErrorCode MatSELLSetSliceHeight_MPISELL(Mat B,PetscInt sliceheight)
+{
+  Mat_MPISELL *b=(Mat_MPISELL*)B->data;
+
+  PetscFunctionBegin;
+  if (sliceheight == b->sliceheight) PetscFunctionReturn(0);
+  if (B->preallocated) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ORDER,"The slice height must be set before the matrix is preallocated");
+  if (sliceheight != 4 && sliceheight != 8 && sliceheight != 16 && sliceheight != 32) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"Slice height %D is not supported, use 4, 8, 16 or 32",sliceheight);
+  b->sliceheight = sliceheight;
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode MatSELLSetSigma_MPISELL(Mat B,PetscInt sigma)
+{
+  Mat_MPISELL *b=(Mat_MPISELL*)B->data;
+
+  PetscFunctionBegin;
+  if (sigma == b->sigma) PetscFunctionReturn(0);
+  if (B->preallocated) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ORDER,"The sorting window must be set before the matrix is preallocated");
+  if (sigma < 1) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"Sorting window %D must be positive",sigma);
+  b->sigma = sigma;
+  PetscFunctionReturn(0);
+}
+
 PetscErrorCode MatDuplicate_MPISELL(Mat matin,MatDuplicateOption cpvalues,Mat *newmat)
 {
   Mat            mat;
@@ -1238,6 +1275,8 @@ PetscErrorCode MatDuplicate_MPISELL(Mat matin,MatDuplicateOption cpvalues,Mat *n
   a->rowindices   = NULL;
   a->rowvalues    = NULL;
   a->getrowactive = PETSC_FALSE;
+  a->sliceheight  = oldmat->sliceheight;
+  a->sigma        = oldmat->sigma;
 
   ierr = PetscLayoutReference(matin->rmap,&mat->rmap);CHKERRQ(ierr);
   ierr = PetscLayoutReference(matin->cmap,&mat->cmap);CHKERRQ(ierr);
@@ -1880,12 +1919,17 @@ PETSC_EXTERN PetscErrorCode MatCreate_MPISELL(Mat B)
   b->rowvalues    = NULL;
   b->getrowactive = PETSC_FALSE;
 
+  b->sliceheight = 8;
+  b->sigma       = 1;
+
   ierr = PetscObjectComposeFunction((PetscObject)B,"MatStoreValues_C",MatStoreValues_MPISELL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)B,"MatRetrieveValues_C",MatRetrieveValues_MPISELL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)B,"MatIsTranspose_C",MatIsTranspose_MPISELL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)B,"MatMPISELLSetPreallocation_C",MatMPISELLSetPreallocation_MPISELL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)B,"MatConvert_mpisell_mpiaij_C",MatConvert_MPISELL_MPIAIJ);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)B,"MatDiagonalScaleLocal_C",MatDiagonalScaleLocal_MPISELL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)B,"MatSELLSetSliceHeight_C",MatSELLSetSliceHeight_MPISELL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)B,"MatSELLSetSigma_C",MatSELLSetSigma_MPISELL);CHKERRQ(ierr);
   ierr = PetscObjectChangeTypeName((PetscObject)B,MATMPISELL);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
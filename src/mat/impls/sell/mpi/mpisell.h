@@ -36,6 +36,9 @@ typedef struct {
   PetscBool   getrowactive;        /* indicates MatGetRow(), not restored */
 
   PetscInt *ld;                    /* number of entries per row left of diagona block */
+
+  PetscInt sliceheight;            /* slice height and sorting window of A and B, applied when they are created */
+  PetscInt sigma;
 } Mat_MPISELL;
 
 PETSC_EXTERN PetscErrorCode MatCreate_MPISELL(Mat);
@@ -53,6 +56,8 @@ PETSC_INTERN PetscErrorCode MatGetSeqNonzeroStructure_MPISELL(Mat,Mat*);
 
 PETSC_INTERN PetscErrorCode MatSetFromOptions_MPISELL(PetscOptionItems*,Mat);
 PETSC_INTERN PetscErrorCode MatMPISELLSetPreallocation_MPISELL(Mat,PetscInt,const PetscInt[],PetscInt,const PetscInt[]);
+PETSC_INTERN PetscErrorCode MatSELLSetSliceHeight_MPISELL(Mat,PetscInt);
+PETSC_INTERN PetscErrorCode MatSELLSetSigma_MPISELL(Mat,PetscInt);
 
 PETSC_INTERN PetscErrorCode MatConvert_MPISELL_MPIAIJ(Mat,MatType,MatReuse,Mat*);
 PETSC_INTERN PetscErrorCode MatConvert_MPIAIJ_MPISELL(Mat,MatType,MatReuse,Mat*);
@@ -11,7 +11,7 @@ PetscErrorCode MatGetColumnIJ_SeqSELL_Color(Mat A,PetscInt oshift,PetscBool symm
 {
   Mat_SeqSELL    *a = (Mat_SeqSELL*)A->data;
   PetscInt       i,j,*collengths,*cia,*cja,n = A->cmap->n,totalslices;
-  PetscInt       row,col;
+  PetscInt       row,col,sh = a->sliceheight;
   PetscInt       *cspidx;
   PetscBool      isnonzero;
   PetscErrorCode ierr;
@@ -25,10 +25,10 @@ PetscErrorCode MatGetColumnIJ_SeqSELL_Color(Mat A,PetscInt oshift,PetscBool symm
   ierr = PetscMalloc1(a->nz+1,&cja);CHKERRQ(ierr);
   ierr = PetscMalloc1(a->nz+1,&cspidx);CHKERRQ(ierr);
 
-  totalslices = A->rmap->n/8+((A->rmap->n & 0x07)?1:0); /* floor(n/8) */
+  totalslices = a->totalslices;
   for (i=0; i<totalslices; i++) { /* loop over slices */
-    for (j=a->sliidx[i],row=0; j<a->sliidx[i+1]; j++,row=((row+1)&0x07)) {
-      isnonzero = (PetscBool)((j-a->sliidx[i])/8 < a->rlen[8*i+row]);
+    for (j=a->sliidx[i],row=0; j<a->sliidx[i+1]; j++,row=((row+1)%sh)) {
+      isnonzero = (PetscBool)((j-a->sliidx[i])/sh < a->rlen[MatSeqSELLRowOfPosition(a,sh*i+row)]);
       if (isnonzero) collengths[a->colidx[j]]++;
     }
   }
@@ -40,12 +40,12 @@ PetscErrorCode MatGetColumnIJ_SeqSELL_Color(Mat A,PetscInt oshift,PetscBool symm
   ierr = PetscArrayzero(collengths,n);CHKERRQ(ierr);
 
   for (i=0; i<totalslices; i++) { /* loop over slices */
-    for (j=a->sliidx[i],row=0; j<a->sliidx[i+1]; j++,row=((row+1)&0x07)) {
-      isnonzero = (PetscBool)((j-a->sliidx[i])/8 < a->rlen[8*i+row]);
+    for (j=a->sliidx[i],row=0; j<a->sliidx[i+1]; j++,row=((row+1)%sh)) {
+      isnonzero = (PetscBool)((j-a->sliidx[i])/sh < a->rlen[MatSeqSELLRowOfPosition(a,sh*i+row)]);
       if (isnonzero) {
         col = a->colidx[j];
         cspidx[cia[col]+collengths[col]-oshift] = j; /* index of a->colidx */
-        cja[cia[col]+collengths[col]-oshift] = 8*i+row +oshift; /* row index */
+        cja[cia[col]+collengths[col]-oshift] = MatSeqSELLRowOfPosition(a,sh*i+row) +oshift; /* row index */
         collengths[col]++;
       }
     }
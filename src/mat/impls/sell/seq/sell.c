@@ -13,23 +13,14 @@
   #define _MM_SCALE_8    8
   #endif
 
+  /* vec_y += A(:,j) x for the 8 (AVX-512) or 4 (AVX2) rows starting at aval/acolidx of a slice column */
   #if defined(__AVX512F__)
-  /* these do not work
-   vec_idx  = _mm512_loadunpackhi_epi32(vec_idx,acolidx);
-   vec_vals = _mm512_loadunpackhi_pd(vec_vals,aval);
-  */
-    #define AVX512_Mult_Private(vec_idx,vec_x,vec_vals,vec_y) \
-    /* if the mask bit is set, copy from acolidx, otherwise from vec_idx */ \
-    vec_idx  = _mm256_loadu_si256((__m256i const*)acolidx); \
-    vec_vals = _mm512_loadu_pd(aval); \
-    vec_x    = _mm512_i32gather_pd(vec_idx,x,_MM_SCALE_8); \
-    vec_y    = _mm512_fmadd_pd(vec_x,vec_vals,vec_y)
-  #elif defined(__AVX2__) && defined(__FMA__)
-    #define AVX2_Mult_Private(vec_idx,vec_x,vec_vals,vec_y) \
-    vec_vals = _mm256_loadu_pd(aval); \
-    vec_idx  = _mm_loadu_si128((__m128i const*)acolidx); /* SSE2 */ \
-    vec_x    = _mm256_i32gather_pd(x,vec_idx,_MM_SCALE_8); \
-    vec_y    = _mm256_fmadd_pd(vec_x,vec_vals,vec_y)
+    #define AVX512_Mult_Private(aval,acolidx,vec_y) \
+    vec_y = _mm512_fmadd_pd(_mm512_i32gather_pd(_mm256_loadu_si256((__m256i const*)(acolidx)),x,_MM_SCALE_8),_mm512_loadu_pd(aval),vec_y)
+  #endif
+  #if defined(__AVX2__) && defined(__FMA__)
+    #define AVX2_Mult_Private(aval,acolidx,vec_y) \
+    vec_y = _mm256_fmadd_pd(_mm256_i32gather_pd(x,_mm_loadu_si128((__m128i const*)(acolidx)),_MM_SCALE_8),_mm256_loadu_pd(aval),vec_y)
   #endif
 #endif  /* PETSC_HAVE_IMMINTRIN_H */
 
@@ -83,10 +74,150 @@ PetscErrorCode MatSeqSELLSetPreallocation(Mat B,PetscInt rlenmax,const PetscInt
   PetscFunctionReturn(0);
 }
 
+/*@
+ MatSELLSetSliceHeight - Sets the number of rows in each slice of a SELL matrix
+
+ Logically Collective on Mat
+
+ Input Parameters:
+ +  A - the MATSEQSELL or MATMPISELL matrix
+ -  sliceheight - the slice height, one of 4, 8 (the default), 16 or 32
+
+ Options Database Key:
+ .  -mat_sell_slice_height <sliceheight> - set the slice height
+
+ Notes:
+ This must be called before the matrix is preallocated.
+
+ A slice height that is a multiple of the SIMD width is required by the vectorized kernels of MatMult(), 8 doubles
+ for AVX-512 and 4 for AVX2. Taller slices expose more parallelism but need more padding when the row lengths vary,
+ see MatSELLSetSigma().
+
+ Level: advanced
+
+ .seealso: MatSELLSetSigma(), MatSeqSELLSetPreallocation(), MatMPISELLSetPreallocation(), MATSELL
+ @*/
+PetscErrorCode MatSELLSetSliceHeight(Mat A,PetscInt sliceheight)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(A,MAT_CLASSID,1);
+  PetscValidLogicalCollectiveInt(A,sliceheight,2);
+  ierr = PetscTryMethod(A,"MatSELLSetSliceHeight_C",(Mat,PetscInt),(A,sliceheight));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*@
+ MatSELLSetSigma - Sets the size of the windows of rows in which a SELL matrix sorts its rows by decreasing length
+
+ Logically Collective on Mat
+
+ Input Parameters:
+ +  A - the MATSEQSELL or MATMPISELL matrix
+ -  sigma - the number of rows of a sorting window, 1 (the default) means the rows are not sorted
+
+ Options Database Key:
+ .  -mat_sell_sigma <sigma> - set the window size
+
+ Notes:
+ This must be called before the matrix is preallocated. The rows are sorted when the preallocation is given with the
+ number of nonzeros of each row, so that rows of similar lengths share a slice and less padding is stored and multiplied.
+ The permutation is internal to the storage, the numbering of the rows of the matrix does not change. A sigma that is a
+ multiple of the slice height keeps the reordering local, a larger one removes more padding.
+
+ Level: advanced
+
+ .seealso: MatSELLSetSliceHeight(), MatSeqSELLSetPreallocation(), MatMPISELLSetPreallocation(), MATSELL
+ @*/
+PetscErrorCode MatSELLSetSigma(Mat A,PetscInt sigma)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(A,MAT_CLASSID,1);
+  PetscValidLogicalCollectiveInt(A,sigma,2);
+  ierr = PetscTryMethod(A,"MatSELLSetSigma_C",(Mat,PetscInt),(A,sigma));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode MatSELLSetSliceHeight_SeqSELL(Mat A,PetscInt sliceheight)
+{
+  Mat_SeqSELL *a=(Mat_SeqSELL*)A->data;
+
+  PetscFunctionBegin;
+  if (sliceheight == a->sliceheight) PetscFunctionReturn(0);
+  if (A->preallocated) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ORDER,"The slice height must be set before the matrix is preallocated");
+  if (sliceheight != 4 && sliceheight != 8 && sliceheight != 16 && sliceheight != 32) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"Slice height %D is not supported, use 4, 8, 16 or 32",sliceheight);
+  a->sliceheight = sliceheight;
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode MatSELLSetSigma_SeqSELL(Mat A,PetscInt sigma)
+{
+  Mat_SeqSELL *a=(Mat_SeqSELL*)A->data;
+
+  PetscFunctionBegin;
+  if (sigma == a->sigma) PetscFunctionReturn(0);
+  if (A->preallocated) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ORDER,"The sorting window must be set before the matrix is preallocated");
+  if (sigma < 1) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"Sorting window %D must be positive",sigma);
+  a->sigma = sigma;
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode MatSetFromOptions_SeqSELL(PetscOptionItems *PetscOptionsObject,Mat A)
+{
+  Mat_SeqSELL    *a=(Mat_SeqSELL*)A->data;
+  PetscInt       sliceheight=a->sliceheight,sigma=a->sigma;
+  PetscBool      flg;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscOptionsHead(PetscOptionsObject,"SeqSELL options");CHKERRQ(ierr);
+  ierr = PetscOptionsInt("-mat_sell_slice_height","Number of rows in a slice","MatSELLSetSliceHeight",sliceheight,&sliceheight,&flg);CHKERRQ(ierr);
+  if (flg) {ierr = MatSELLSetSliceHeight(A,sliceheight);CHKERRQ(ierr);}
+  ierr = PetscOptionsInt("-mat_sell_sigma","Size of the windows of rows sorted by length, 1 means no sorting","MatSELLSetSigma",sigma,&sigma,&flg);CHKERRQ(ierr);
+  if (flg) {ierr = MatSELLSetSigma(A,sigma);CHKERRQ(ierr);}
+  ierr = PetscOptionsTail();CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+   Sorts the rows by decreasing length within consecutive windows of sigma rows, so rows of similar length share a slice
+   and less padding is needed. Sets b->rowperm and b->irowperm; the positions past the last row map to themselves.
+*/
+static PetscErrorCode MatSeqSELLSetRowPermutation_Private(Mat B,const PetscInt rlen[])
+{
+  Mat_SeqSELL    *b=(Mat_SeqSELL*)B->data;
+  PetscInt       m=B->rmap->n,npos=b->sliceheight*b->totalslices,i,j,k,w,*key;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscFree2(b->rowperm,b->irowperm);CHKERRQ(ierr);
+  if (!rlen || b->sigma <= 1 || m <= 1) PetscFunctionReturn(0);
+  ierr = PetscMalloc2(npos,&b->rowperm,npos,&b->irowperm);CHKERRQ(ierr);
+  ierr = PetscLogObjectMemory((PetscObject)B,2*npos*sizeof(PetscInt));CHKERRQ(ierr);
+  ierr = PetscMalloc1(PetscMin(b->sigma,m),&key);CHKERRQ(ierr);
+  for (i=0; i<npos; i++) b->rowperm[i] = i;
+  for (i=0; i<m; i+=b->sigma) {
+    w = PetscMin(b->sigma,m-i);
+    for (j=0; j<w; j++) key[j] = -rlen[i+j];
+    ierr = PetscSortIntWithArray(w,key,b->rowperm+i);CHKERRQ(ierr);
+    /* keep rows of equal length in their original order for the locality of the accesses to x */
+    for (j=0; j<w; j=k) {
+      for (k=j+1; k<w && key[k] == key[j]; k++) ;
+      ierr = PetscSortInt(k-j,b->rowperm+i+j);CHKERRQ(ierr);
+    }
+  }
+  ierr = PetscFree(key);CHKERRQ(ierr);
+  for (i=0; i<npos; i++) b->irowperm[b->rowperm[i]] = i;
+  PetscFunctionReturn(0);
+}
+
 PetscErrorCode MatSeqSELLSetPreallocation_SeqSELL(Mat B,PetscInt maxallocrow,const PetscInt rlen[])
 {
   Mat_SeqSELL    *b;
-  PetscInt       i,j,totalslices;
+  PetscInt       i,j,totalslices,sh,width;
   PetscBool      skipallocation=PETSC_FALSE,realalloc=PETSC_FALSE;
   PetscErrorCode ierr;
 
@@ -112,37 +243,33 @@ PetscErrorCode MatSeqSELLSetPreallocation_SeqSELL(Mat B,PetscInt maxallocrow,con
 
   B->preallocated = PETSC_TRUE;
 
-  b = (Mat_SeqSELL*)B->data;
+  b  = (Mat_SeqSELL*)B->data;
+  sh = b->sliceheight;
 
-  totalslices = B->rmap->n/8+((B->rmap->n & 0x07)?1:0); /* ceil(n/8) */
+  totalslices = B->rmap->n/sh+((B->rmap->n % sh)?1:0); /* ceil(n/sh) */
+  if (b->sliidx && totalslices != b->totalslices) {ierr = PetscFree(b->sliidx);CHKERRQ(ierr);}
   b->totalslices = totalslices;
   if (!skipallocation) {
-    if (B->rmap->n & 0x07) {ierr = PetscInfo1(B,"Padding rows to the SEQSELL matrix because the number of rows is not the multiple of 8 (value %D)\n",B->rmap->n);CHKERRQ(ierr);}
+    if (B->rmap->n % sh) {ierr = PetscInfo2(B,"Padding rows to the SEQSELL matrix because the number of rows is not the multiple of the slice height %D (value %D)\n",sh,B->rmap->n);CHKERRQ(ierr);}
 
     if (!b->sliidx) { /* sliidx gives the starting index of each slice, the last element is the total space allocated */
       ierr = PetscMalloc1(totalslices+1,&b->sliidx);CHKERRQ(ierr);
       ierr = PetscLogObjectMemory((PetscObject)B,(totalslices+1)*sizeof(PetscInt));CHKERRQ(ierr);
     }
+    ierr = MatSeqSELLSetRowPermutation_Private(B,rlen);CHKERRQ(ierr);
     if (!rlen) { /* if rlen is not provided, allocate same space for all the slices */
       if (maxallocrow == PETSC_DEFAULT || maxallocrow == PETSC_DECIDE) maxallocrow = 10;
       else if (maxallocrow < 0) maxallocrow = 1;
-      for (i=0; i<=totalslices; i++) b->sliidx[i] = i*8*maxallocrow;
+      for (i=0; i<=totalslices; i++) b->sliidx[i] = i*sh*maxallocrow;
     } else {
-      maxallocrow = 0;
+      maxallocrow  = 0;
       b->sliidx[0] = 0;
-      for (i=1; i<totalslices; i++) {
-        b->sliidx[i] = 0;
-        for (j=0;j<8;j++) {
-          b->sliidx[i] = PetscMax(b->sliidx[i],rlen[8*(i-1)+j]);
-        }
-        maxallocrow = PetscMax(b->sliidx[i],maxallocrow);
-        ierr = PetscIntSumError(b->sliidx[i-1],8*b->sliidx[i],&b->sliidx[i]);CHKERRQ(ierr);
+      for (i=0; i<totalslices; i++) {
+        width = 0;
+        for (j=i*sh; j<PetscMin((i+1)*sh,B->rmap->n); j++) width = PetscMax(width,rlen[MatSeqSELLRowOfPosition(b,j)]);
+        maxallocrow = PetscMax(width,maxallocrow);
+        ierr = PetscIntSumError(b->sliidx[i],sh*width,&b->sliidx[i+1]);CHKERRQ(ierr);
       }
-      /* last slice */
-      b->sliidx[totalslices] = 0;
-      for (j=(totalslices-1)*8;j<B->rmap->n;j++) b->sliidx[totalslices] = PetscMax(b->sliidx[totalslices],rlen[j]);
-      maxallocrow = PetscMax(b->sliidx[totalslices],maxallocrow);
-      b->sliidx[totalslices] = b->sliidx[totalslices-1] + 8*b->sliidx[totalslices];
     }
 
     /* allocate space for val, colidx, rlen */
@@ -152,8 +279,9 @@ PetscErrorCode MatSeqSELLSetPreallocation_SeqSELL(Mat B,PetscInt maxallocrow,con
     ierr = PetscMalloc2(b->sliidx[totalslices],&b->val,b->sliidx[totalslices],&b->colidx);CHKERRQ(ierr);
     ierr = PetscLogObjectMemory((PetscObject)B,b->sliidx[totalslices]*(sizeof(PetscScalar)+sizeof(PetscInt)));CHKERRQ(ierr);
     /* b->rlen will count nonzeros in each row so far. We dont copy rlen to b->rlen because the matrix has not been set. */
-    ierr = PetscCalloc1(8*totalslices,&b->rlen);CHKERRQ(ierr);
-    ierr = PetscLogObjectMemory((PetscObject)B,8*totalslices*sizeof(PetscInt));CHKERRQ(ierr);
+    ierr = PetscFree(b->rlen);CHKERRQ(ierr);
+    ierr = PetscCalloc1(sh*totalslices,&b->rlen);CHKERRQ(ierr);
+    ierr = PetscLogObjectMemory((PetscObject)B,sh*totalslices*sizeof(PetscInt));CHKERRQ(ierr);
 
     b->singlemalloc = PETSC_TRUE;
     b->free_val     = PETSC_TRUE;
@@ -177,12 +305,12 @@ PetscErrorCode MatSeqSELLSetPreallocation_SeqSELL(Mat B,PetscInt maxallocrow,con
 PetscErrorCode MatGetRow_SeqSELL(Mat A,PetscInt row,PetscInt *nz,PetscInt **idx,PetscScalar **v)
 {
   Mat_SeqSELL *a = (Mat_SeqSELL*)A->data;
-  PetscInt    shift;
+  PetscInt    shift,sh=a->sliceheight;
 
   PetscFunctionBegin;
   if (row < 0 || row >= A->rmap->n) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"Row %D out of range",row);
   if (nz) *nz = a->rlen[row];
-  shift = a->sliidx[row>>3]+(row&0x07);
+  shift = MatSeqSELLRowShift(a,row);
   if (!a->getrowcols) {
     PetscErrorCode ierr;
 
@@ -190,12 +318,12 @@ PetscErrorCode MatGetRow_SeqSELL(Mat A,PetscInt row,PetscInt *nz,PetscInt **idx,
   }
   if (idx) {
     PetscInt j;
-    for (j=0; j<a->rlen[row]; j++) a->getrowcols[j] = a->colidx[shift+8*j];
+    for (j=0; j<a->rlen[row]; j++) a->getrowcols[j] = a->colidx[shift+sh*j];
     *idx = a->getrowcols;
   }
   if (v) {
     PetscInt j;
-    for (j=0; j<a->rlen[row]; j++) a->getrowvals[j] = a->val[shift+8*j];
+    for (j=0; j<a->rlen[row]; j++) a->getrowvals[j] = a->val[shift+sh*j];
     *v = a->getrowvals;
   }
   PetscFunctionReturn(0);
@@ -292,369 +420,218 @@ PetscErrorCode MatConvert_SeqAIJ_SeqSELL(Mat A,MatType newtype,MatReuse reuse,Ma
   PetscFunctionReturn(0);
 }
 
-PetscErrorCode MatMult_SeqSELL(Mat A,Vec xx,Vec yy)
+/*
+   Computes ys[r] = yadd[r] + sum_j aval[sh*j+r]*x[acolidx[sh*j+r]] for the sh rows of a slice of width columns; yadd may be NULL.
+   The callers pass a constant sh so that the loops over the rows of the slice are unrolled and the unused branches vanish.
+   The padding entries hold a zero value and a valid column index, so they are processed like the nonzeros.
+*/
+PETSC_STATIC_INLINE void MatMultSlice_SeqSELL_Private(PetscInt sh,PetscInt width,const MatScalar *aval,const PetscInt *acolidx,const PetscScalar *x,const PetscScalar *yadd,PetscScalar *ys)
 {
-  Mat_SeqSELL       *a=(Mat_SeqSELL*)A->data;
-  PetscScalar       *y;
-  const PetscScalar *x;
-  const MatScalar   *aval=a->val;
-  PetscInt          totalslices=a->totalslices;
-  const PetscInt    *acolidx=a->colidx;
-  PetscInt          i,j;
-  PetscErrorCode    ierr;
+  PetscInt    j,k;
+  PetscScalar sum[MAT_SELL_MAX_SLICE_HEIGHT];
 #if defined(PETSC_HAVE_IMMINTRIN_H) && defined(__AVX512F__) && defined(PETSC_USE_REAL_DOUBLE) && !defined(PETSC_USE_COMPLEX) && !defined(PETSC_USE_64BIT_INDICES)
-  __m512d           vec_x,vec_y,vec_vals;
-  __m256i           vec_idx;
-  __mmask8          mask;
-  __m512d           vec_x2,vec_y2,vec_vals2,vec_x3,vec_y3,vec_vals3,vec_x4,vec_y4,vec_vals4;
-  __m256i           vec_idx2,vec_idx3,vec_idx4;
-#elif defined(PETSC_HAVE_IMMINTRIN_H) && defined(__AVX2__) && defined(__FMA__) && defined(PETSC_USE_REAL_DOUBLE) && !defined(PETSC_USE_COMPLEX) && !defined(PETSC_USE_64BIT_INDICES)
-  __m128i           vec_idx;
-  __m256d           vec_x,vec_y,vec_y2,vec_vals;
-  MatScalar         yval;
-  PetscInt          r,rows_left,row,nnz_in_row;
-#elif defined(PETSC_HAVE_IMMINTRIN_H) && defined(__AVX__) && defined(PETSC_USE_REAL_DOUBLE) && !defined(PETSC_USE_COMPLEX) && !defined(PETSC_USE_64BIT_INDICES)
-  __m128d           vec_x_tmp;
-  __m256d           vec_x,vec_y,vec_y2,vec_vals;
-  MatScalar         yval;
-  PetscInt          r,rows_left,row,nnz_in_row;
-#else
-  PetscScalar       sum[8];
-#endif
+  __m512d     vec_y[MAT_SELL_MAX_SLICE_HEIGHT/8],vec_y2[MAT_SELL_MAX_SLICE_HEIGHT/8];
 
-#if defined(PETSC_HAVE_PRAGMA_DISJOINT)
-#pragma disjoint(*x,*y,*aval)
-#endif
-
-  PetscFunctionBegin;
-  ierr = VecGetArrayRead(xx,&x);CHKERRQ(ierr);
-  ierr = VecGetArray(yy,&y);CHKERRQ(ierr);
-#if defined(PETSC_HAVE_IMMINTRIN_H) && defined(__AVX512F__) && defined(PETSC_USE_REAL_DOUBLE) && !defined(PETSC_USE_COMPLEX) && !defined(PETSC_USE_64BIT_INDICES)
-  for (i=0; i<totalslices; i++) { /* loop over slices */
-    PetscPrefetchBlock(acolidx,a->sliidx[i+1]-a->sliidx[i],0,PETSC_PREFETCH_HINT_T0);
-    PetscPrefetchBlock(aval,a->sliidx[i+1]-a->sliidx[i],0,PETSC_PREFETCH_HINT_T0);
-
-    vec_y  = _mm512_setzero_pd();
-    vec_y2 = _mm512_setzero_pd();
-    vec_y3 = _mm512_setzero_pd();
-    vec_y4 = _mm512_setzero_pd();
-
-    j = a->sliidx[i]>>3; /* 8 bytes are read at each time, corresponding to a slice columnn */
-    switch ((a->sliidx[i+1]-a->sliidx[i])/8 & 3) {
-    case 3:
-      AVX512_Mult_Private(vec_idx,vec_x,vec_vals,vec_y);
-      acolidx += 8; aval += 8;
-      AVX512_Mult_Private(vec_idx2,vec_x2,vec_vals2,vec_y2);
-      acolidx += 8; aval += 8;
-      AVX512_Mult_Private(vec_idx3,vec_x3,vec_vals3,vec_y3);
-      acolidx += 8; aval += 8;
-      j += 3;
-      break;
-    case 2:
-      AVX512_Mult_Private(vec_idx,vec_x,vec_vals,vec_y);
-      acolidx += 8; aval += 8;
-      AVX512_Mult_Private(vec_idx2,vec_x2,vec_vals2,vec_y2);
-      acolidx += 8; aval += 8;
-      j += 2;
-      break;
-    case 1:
-      AVX512_Mult_Private(vec_idx,vec_x,vec_vals,vec_y);
-      acolidx += 8; aval += 8;
-      j += 1;
-      break;
+  if (!(sh%8)) {
+    for (k=0; k<sh/8; k++) {
+      vec_y[k]  = _mm512_setzero_pd();
+      vec_y2[k] = _mm512_setzero_pd();
     }
-    #pragma novector
-    for (; j<(a->sliidx[i+1]>>3); j+=4) {
-      AVX512_Mult_Private(vec_idx,vec_x,vec_vals,vec_y);
-      acolidx += 8; aval += 8;
-      AVX512_Mult_Private(vec_idx2,vec_x2,vec_vals2,vec_y2);
-      acolidx += 8; aval += 8;
-      AVX512_Mult_Private(vec_idx3,vec_x3,vec_vals3,vec_y3);
-      acolidx += 8; aval += 8;
-      AVX512_Mult_Private(vec_idx4,vec_x4,vec_vals4,vec_y4);
-      acolidx += 8; aval += 8;
+    /* two slice columns at a time give independent chains of FMAs */
+    for (j=0; j<width-1; j+=2,aval+=2*sh,acolidx+=2*sh) {
+      for (k=0; k<sh/8; k++) {
+        AVX512_Mult_Private(aval+8*k,acolidx+8*k,vec_y[k]);
+        AVX512_Mult_Private(aval+sh+8*k,acolidx+sh+8*k,vec_y2[k]);
+      }
     }
-
-    vec_y = _mm512_add_pd(vec_y,vec_y2);
-    vec_y = _mm512_add_pd(vec_y,vec_y3);
-    vec_y = _mm512_add_pd(vec_y,vec_y4);
-    if (i == totalslices-1 && A->rmap->n & 0x07) { /* if last slice has padding rows */
-      mask = (__mmask8)(0xff >> (8-(A->rmap->n & 0x07)));
-      _mm512_mask_storeu_pd(&y[8*i],mask,vec_y);
-    } else {
-      _mm512_storeu_pd(&y[8*i],vec_y);
+    if (j < width) {
+      for (k=0; k<sh/8; k++) AVX512_Mult_Private(aval+8*k,acolidx+8*k,vec_y[k]);
+    }
+    for (k=0; k<sh/8; k++) {
+      vec_y[k] = _mm512_add_pd(vec_y[k],vec_y2[k]);
+      if (yadd) vec_y[k] = _mm512_add_pd(vec_y[k],_mm512_loadu_pd(yadd+8*k));
+      _mm512_storeu_pd(ys+8*k,vec_y[k]);
     }
+    return;
   }
-#elif defined(PETSC_HAVE_IMMINTRIN_H) && defined(__AVX2__) && defined(__FMA__) && defined(PETSC_USE_REAL_DOUBLE) && !defined(PETSC_USE_COMPLEX) && !defined(PETSC_USE_64BIT_INDICES)
-  for (i=0; i<totalslices; i++) { /* loop over full slices */
-    PetscPrefetchBlock(acolidx,a->sliidx[i+1]-a->sliidx[i],0,PETSC_PREFETCH_HINT_T0);
-    PetscPrefetchBlock(aval,a->sliidx[i+1]-a->sliidx[i],0,PETSC_PREFETCH_HINT_T0);
-
-    /* last slice may have padding rows. Don't use vectorization. */
-    if (i == totalslices-1 && (A->rmap->n & 0x07)) {
-      rows_left = A->rmap->n - 8*i;
-      for (r=0; r<rows_left; ++r) {
-        yval = (MatScalar)0;
-        row = 8*i + r;
-        nnz_in_row = a->rlen[row];
-        for (j=0; j<nnz_in_row; ++j) yval += aval[8*j+r] * x[acolidx[8*j+r]];
-        y[row] = yval;
+#endif
+#if defined(PETSC_HAVE_IMMINTRIN_H) && defined(__AVX2__) && defined(__FMA__) && defined(PETSC_USE_REAL_DOUBLE) && !defined(PETSC_USE_COMPLEX) && !defined(PETSC_USE_64BIT_INDICES)
+  __m256d     vec_z[MAT_SELL_MAX_SLICE_HEIGHT/4],vec_z2[MAT_SELL_MAX_SLICE_HEIGHT/4];
+
+  if (!(sh%4)) {
+    for (k=0; k<sh/4; k++) {
+      vec_z[k]  = _mm256_setzero_pd();
+      vec_z2[k] = _mm256_setzero_pd();
+    }
+    for (j=0; j<width-1; j+=2,aval+=2*sh,acolidx+=2*sh) {
+      for (k=0; k<sh/4; k++) {
+        AVX2_Mult_Private(aval+4*k,acolidx+4*k,vec_z[k]);
+        AVX2_Mult_Private(aval+sh+4*k,acolidx+sh+4*k,vec_z2[k]);
       }
-      break;
     }
-
-    vec_y  = _mm256_setzero_pd();
-    vec_y2 = _mm256_setzero_pd();
-
-    /* Process slice of height 8 (512 bits) via two subslices of height 4 (256 bits) via AVX */
-    #pragma novector
-    #pragma unroll(2)
-    for (j=a->sliidx[i]; j<a->sliidx[i+1]; j+=8) {
-      AVX2_Mult_Private(vec_idx,vec_x,vec_vals,vec_y);
-      aval += 4; acolidx += 4;
-      AVX2_Mult_Private(vec_idx,vec_x,vec_vals,vec_y2);
-      aval += 4; acolidx += 4;
+    if (j < width) {
+      for (k=0; k<sh/4; k++) AVX2_Mult_Private(aval+4*k,acolidx+4*k,vec_z[k]);
     }
-
-    _mm256_storeu_pd(y+i*8,vec_y);
-    _mm256_storeu_pd(y+i*8+4,vec_y2);
+    for (k=0; k<sh/4; k++) {
+      vec_z[k] = _mm256_add_pd(vec_z[k],vec_z2[k]);
+      if (yadd) vec_z[k] = _mm256_add_pd(vec_z[k],_mm256_loadu_pd(yadd+4*k));
+      _mm256_storeu_pd(ys+4*k,vec_z[k]);
+    }
+    return;
   }
 #elif defined(PETSC_HAVE_IMMINTRIN_H) && defined(__AVX__) && defined(PETSC_USE_REAL_DOUBLE) && !defined(PETSC_USE_COMPLEX) && !defined(PETSC_USE_64BIT_INDICES)
-  for (i=0; i<totalslices; i++) { /* loop over full slices */
-    PetscPrefetchBlock(acolidx,a->sliidx[i+1]-a->sliidx[i],0,PETSC_PREFETCH_HINT_T0);
-    PetscPrefetchBlock(aval,a->sliidx[i+1]-a->sliidx[i],0,PETSC_PREFETCH_HINT_T0);
-
-    vec_y  = _mm256_setzero_pd();
-    vec_y2 = _mm256_setzero_pd();
-
-    /* last slice may have padding rows. Don't use vectorization. */
-    if (i == totalslices-1 && (A->rmap->n & 0x07)) {
-      rows_left = A->rmap->n - 8*i;
-      for (r=0; r<rows_left; ++r) {
-        yval = (MatScalar)0;
-        row = 8*i + r;
-        nnz_in_row = a->rlen[row];
-        for (j=0; j<nnz_in_row; ++j) yval += aval[8*j + r] * x[acolidx[8*j + r]];
-        y[row] = yval;
+  __m128d     vec_x_tmp;
+  __m256d     vec_x,vec_z[MAT_SELL_MAX_SLICE_HEIGHT/4];
+
+  if (!(sh%4)) {
+    vec_x_tmp = _mm_setzero_pd();
+    vec_x     = _mm256_setzero_pd();
+    for (k=0; k<sh/4; k++) vec_z[k] = _mm256_setzero_pd();
+    /* there is no gather in AVX, load the entries of x one at a time */
+    for (j=0; j<width; j++,aval+=sh,acolidx+=sh) {
+      for (k=0; k<sh/4; k++) {
+        vec_x_tmp = _mm_loadl_pd(vec_x_tmp,x+acolidx[4*k]);
+        vec_x_tmp = _mm_loadh_pd(vec_x_tmp,x+acolidx[4*k+1]);
+        vec_x     = _mm256_insertf128_pd(vec_x,vec_x_tmp,0);
+        vec_x_tmp = _mm_loadl_pd(vec_x_tmp,x+acolidx[4*k+2]);
+        vec_x_tmp = _mm_loadh_pd(vec_x_tmp,x+acolidx[4*k+3]);
+        vec_x     = _mm256_insertf128_pd(vec_x,vec_x_tmp,1);
+        vec_z[k]  = _mm256_add_pd(_mm256_mul_pd(vec_x,_mm256_loadu_pd(aval+4*k)),vec_z[k]);
       }
-      break;
     }
-
-    /* Process slice of height 8 (512 bits) via two subslices of height 4 (256 bits) via AVX */
-    #pragma novector
-    #pragma unroll(2)
-    for (j=a->sliidx[i]; j<a->sliidx[i+1]; j+=8) {
-      vec_vals  = _mm256_loadu_pd(aval);
-      vec_x_tmp = _mm_loadl_pd(vec_x_tmp, x + *acolidx++);
-      vec_x_tmp = _mm_loadh_pd(vec_x_tmp, x + *acolidx++);
-      vec_x     = _mm256_insertf128_pd(vec_x,vec_x_tmp,0);
-      vec_x_tmp = _mm_loadl_pd(vec_x_tmp, x + *acolidx++);
-      vec_x_tmp = _mm_loadh_pd(vec_x_tmp, x + *acolidx++);
-      vec_x     = _mm256_insertf128_pd(vec_x,vec_x_tmp,1);
-      vec_y     = _mm256_add_pd(_mm256_mul_pd(vec_x,vec_vals),vec_y);
-      aval     += 4;
-
-      vec_vals  = _mm256_loadu_pd(aval);
-      vec_x_tmp = _mm_loadl_pd(vec_x_tmp, x + *acolidx++);
-      vec_x_tmp = _mm_loadh_pd(vec_x_tmp, x + *acolidx++);
-      vec_x     = _mm256_insertf128_pd(vec_x,vec_x_tmp,0);
-      vec_x_tmp = _mm_loadl_pd(vec_x_tmp, x + *acolidx++);
-      vec_x_tmp = _mm_loadh_pd(vec_x_tmp, x + *acolidx++);
-      vec_x     = _mm256_insertf128_pd(vec_x,vec_x_tmp,1);
-      vec_y2    = _mm256_add_pd(_mm256_mul_pd(vec_x,vec_vals),vec_y2);
-      aval     += 4;
+    for (k=0; k<sh/4; k++) {
+      if (yadd) vec_z[k] = _mm256_add_pd(vec_z[k],_mm256_loadu_pd(yadd+4*k));
+      _mm256_storeu_pd(ys+4*k,vec_z[k]);
     }
-
-    _mm256_storeu_pd(y + i*8,     vec_y);
-    _mm256_storeu_pd(y + i*8 + 4, vec_y2);
+    return;
   }
-#else
-  for (i=0; i<totalslices; i++) { /* loop over slices */
-    for (j=0; j<8; j++) sum[j] = 0.0;
-    for (j=a->sliidx[i]; j<a->sliidx[i+1]; j+=8) {
-      sum[0] += aval[j] * x[acolidx[j]];
-      sum[1] += aval[j+1] * x[acolidx[j+1]];
-      sum[2] += aval[j+2] * x[acolidx[j+2]];
-      sum[3] += aval[j+3] * x[acolidx[j+3]];
-      sum[4] += aval[j+4] * x[acolidx[j+4]];
-      sum[5] += aval[j+5] * x[acolidx[j+5]];
-      sum[6] += aval[j+6] * x[acolidx[j+6]];
-      sum[7] += aval[j+7] * x[acolidx[j+7]];
-    }
-    if (i == totalslices-1 && (A->rmap->n & 0x07)) { /* if last slice has padding rows */
-      for (j=0; j<(A->rmap->n & 0x07); j++) y[8*i+j] = sum[j];
-    } else {
-      for (j=0; j<8; j++) y[8*i+j] = sum[j];
+#endif
+  for (k=0; k<sh; k++) sum[k] = 0.0;
+  for (j=0; j<width; j++,aval+=sh,acolidx+=sh) {
+    for (k=0; k<sh; k++) sum[k] += aval[k]*x[acolidx[k]];
+  }
+  if (yadd) {
+    for (k=0; k<sh; k++) ys[k] = yadd[k]+sum[k];
+  } else {
+    for (k=0; k<sh; k++) ys[k] = sum[k];
+  }
+}
+
+/*
+   Computes y[acolidx[sh*j+r]] += aval[sh*j+r]*xs[r] for the sh rows of a slice of width columns.
+   Different rows of a slice column may share a column index, with AVX512CD such conflicts are detected so that the
+   updates of y can be gathered and scattered as a vector when there is none.
+*/
+PETSC_STATIC_INLINE void MatMultTransposeSlice_SeqSELL_Private(PetscInt sh,PetscInt width,const MatScalar *aval,const PetscInt *acolidx,const PetscScalar *xs,PetscScalar *y)
+{
+  PetscInt    j,k;
+#if defined(PETSC_HAVE_IMMINTRIN_H) && defined(__AVX512F__) && defined(__AVX512CD__) && defined(PETSC_USE_REAL_DOUBLE) && !defined(PETSC_USE_COMPLEX) && !defined(PETSC_USE_64BIT_INDICES)
+  __m256i     vec_idx;
+  __m512d     vec_p;
+  __m512i     vec_conflict;
+  PetscScalar prod[8];
+  PetscInt    r;
+
+  if (!(sh%8)) {
+    for (j=0; j<width; j++,aval+=sh,acolidx+=sh) {
+      for (k=0; k<sh/8; k++) {
+        vec_idx      = _mm256_loadu_si256((__m256i const*)(acolidx+8*k));
+        vec_p        = _mm512_mul_pd(_mm512_loadu_pd(aval+8*k),_mm512_loadu_pd(xs+8*k));
+        /* the conflicts of the lower 8 lanes only involve the lower 8 lanes */
+        vec_conflict = _mm512_conflict_epi32(_mm512_castsi256_si512(vec_idx));
+        if (!_mm512_mask_test_epi32_mask(0xff,vec_conflict,vec_conflict)) {
+          vec_p = _mm512_add_pd(vec_p,_mm512_i32gather_pd(vec_idx,y,_MM_SCALE_8));
+          _mm512_i32scatter_pd(y,vec_idx,vec_p,_MM_SCALE_8);
+        } else {
+          _mm512_storeu_pd(prod,vec_p);
+          for (r=0; r<8; r++) y[acolidx[8*k+r]] += prod[r];
+        }
+      }
     }
+    return;
   }
 #endif
-
-  ierr = PetscLogFlops(2.0*a->nz-a->nonzerorowcnt);CHKERRQ(ierr); /* theoretical minimal FLOPs */
-  ierr = VecRestoreArrayRead(xx,&x);CHKERRQ(ierr);
-  ierr = VecRestoreArray(yy,&y);CHKERRQ(ierr);
-  PetscFunctionReturn(0);
+  for (j=0; j<width; j++,aval+=sh,acolidx+=sh) {
+    for (k=0; k<sh; k++) y[acolidx[k]] += aval[k]*xs[k];
+  }
 }
 
-#include <../src/mat/impls/aij/seq/ftn-kernels/fmultadd.h>
-PetscErrorCode MatMultAdd_SeqSELL(Mat A,Vec xx,Vec yy,Vec zz)
+/* z = A x + y, or z = A x when y is NULL; y and z may be the same array */
+static PetscErrorCode MatMultAdd_SeqSELL_Private(Mat A,const PetscScalar *x,const PetscScalar *y,PetscScalar *z)
 {
-  Mat_SeqSELL       *a=(Mat_SeqSELL*)A->data;
-  PetscScalar       *y,*z;
-  const PetscScalar *x;
-  const MatScalar   *aval=a->val;
-  PetscInt          totalslices=a->totalslices;
-  const PetscInt    *acolidx=a->colidx;
-  PetscInt          i,j;
-  PetscErrorCode    ierr;
-#if defined(PETSC_HAVE_IMMINTRIN_H) && defined(__AVX512F__) && defined(PETSC_USE_REAL_DOUBLE) && !defined(PETSC_USE_COMPLEX) && !defined(PETSC_USE_64BIT_INDICES)
-  __m512d           vec_x,vec_y,vec_vals;
-  __m256i           vec_idx;
-  __mmask8          mask;
-  __m512d           vec_x2,vec_y2,vec_vals2,vec_x3,vec_y3,vec_vals3,vec_x4,vec_y4,vec_vals4;
-  __m256i           vec_idx2,vec_idx3,vec_idx4;
-#elif defined(PETSC_HAVE_IMMINTRIN_H) && defined(__AVX__) && defined(PETSC_USE_REAL_DOUBLE) && !defined(PETSC_USE_COMPLEX) && !defined(PETSC_USE_64BIT_INDICES)
-  __m128d           vec_x_tmp;
-  __m256d           vec_x,vec_y,vec_y2,vec_vals;
-  MatScalar         yval;
-  PetscInt          r,row,nnz_in_row;
-#else
-  PetscScalar       sum[8];
-#endif
+  Mat_SeqSELL     *a=(Mat_SeqSELL*)A->data;
+  const MatScalar *aval=a->val;
+  const PetscInt  *acolidx=a->colidx;
+  PetscInt        i,r,row,m=A->rmap->n,sh=a->sliceheight,width;
+  PetscScalar     buf[MAT_SELL_MAX_SLICE_HEIGHT],*ys;
+  const PetscScalar *yadd;
+  PetscBool       direct;
 
 #if defined(PETSC_HAVE_PRAGMA_DISJOINT)
 #pragma disjoint(*x,*y,*aval)
 #endif
 
   PetscFunctionBegin;
-  ierr = VecGetArrayRead(xx,&x);CHKERRQ(ierr);
-  ierr = VecGetArrayPair(yy,zz,&y,&z);CHKERRQ(ierr);
-#if defined(PETSC_HAVE_IMMINTRIN_H) && defined(__AVX512F__) && defined(PETSC_USE_REAL_DOUBLE) && !defined(PETSC_USE_COMPLEX) && !defined(PETSC_USE_64BIT_INDICES)
-  for (i=0; i<totalslices; i++) { /* loop over slices */
-    PetscPrefetchBlock(acolidx,a->sliidx[i+1]-a->sliidx[i],0,PETSC_PREFETCH_HINT_T0);
-    PetscPrefetchBlock(aval,a->sliidx[i+1]-a->sliidx[i],0,PETSC_PREFETCH_HINT_T0);
-
-    if (i == totalslices-1 && A->rmap->n & 0x07) { /* if last slice has padding rows */
-      mask   = (__mmask8)(0xff >> (8-(A->rmap->n & 0x07)));
-      vec_y  = _mm512_mask_loadu_pd(vec_y,mask,&y[8*i]);
-    } else {
-      vec_y  = _mm512_loadu_pd(&y[8*i]);
-    }
-    vec_y2 = _mm512_setzero_pd();
-    vec_y3 = _mm512_setzero_pd();
-    vec_y4 = _mm512_setzero_pd();
-
-    j = a->sliidx[i]>>3; /* 8 bytes are read at each time, corresponding to a slice columnn */
-    switch ((a->sliidx[i+1]-a->sliidx[i])/8 & 3) {
-    case 3:
-      AVX512_Mult_Private(vec_idx,vec_x,vec_vals,vec_y);
-      acolidx += 8; aval += 8;
-      AVX512_Mult_Private(vec_idx2,vec_x2,vec_vals2,vec_y2);
-      acolidx += 8; aval += 8;
-      AVX512_Mult_Private(vec_idx3,vec_x3,vec_vals3,vec_y3);
-      acolidx += 8; aval += 8;
-      j += 3;
+  for (i=0; i<a->totalslices; i++) { /* loop over slices */
+    PetscPrefetchBlock(acolidx+a->sliidx[i],a->sliidx[i+1]-a->sliidx[i],0,PETSC_PREFETCH_HINT_T0);
+    PetscPrefetchBlock(aval+a->sliidx[i],a->sliidx[i+1]-a->sliidx[i],0,PETSC_PREFETCH_HINT_T0);
+    width = (a->sliidx[i+1]-a->sliidx[i])/sh;
+    /* the results of a full slice of unpermuted rows go straight into z */
+    direct = (PetscBool)(!a->rowperm && (i+1)*sh <= m);
+    ys     = direct ? z+i*sh : buf;
+    yadd   = direct && y ? y+i*sh : NULL;
+    switch (sh) {
+    case 4:
+      MatMultSlice_SeqSELL_Private(4,width,aval+a->sliidx[i],acolidx+a->sliidx[i],x,yadd,ys);
       break;
-    case 2:
-      AVX512_Mult_Private(vec_idx,vec_x,vec_vals,vec_y);
-      acolidx += 8; aval += 8;
-      AVX512_Mult_Private(vec_idx2,vec_x2,vec_vals2,vec_y2);
-      acolidx += 8; aval += 8;
-      j += 2;
+    case 8:
+      MatMultSlice_SeqSELL_Private(8,width,aval+a->sliidx[i],acolidx+a->sliidx[i],x,yadd,ys);
       break;
-    case 1:
-      AVX512_Mult_Private(vec_idx,vec_x,vec_vals,vec_y);
-      acolidx += 8; aval += 8;
-      j += 1;
+    case 16:
+      MatMultSlice_SeqSELL_Private(16,width,aval+a->sliidx[i],acolidx+a->sliidx[i],x,yadd,ys);
+      break;
+    default:
+      MatMultSlice_SeqSELL_Private(32,width,aval+a->sliidx[i],acolidx+a->sliidx[i],x,yadd,ys);
       break;
     }
-    #pragma novector
-    for (; j<(a->sliidx[i+1]>>3); j+=4) {
-      AVX512_Mult_Private(vec_idx,vec_x,vec_vals,vec_y);
-      acolidx += 8; aval += 8;
-      AVX512_Mult_Private(vec_idx2,vec_x2,vec_vals2,vec_y2);
-      acolidx += 8; aval += 8;
-      AVX512_Mult_Private(vec_idx3,vec_x3,vec_vals3,vec_y3);
-      acolidx += 8; aval += 8;
-      AVX512_Mult_Private(vec_idx4,vec_x4,vec_vals4,vec_y4);
-      acolidx += 8; aval += 8;
-    }
-
-    vec_y = _mm512_add_pd(vec_y,vec_y2);
-    vec_y = _mm512_add_pd(vec_y,vec_y3);
-    vec_y = _mm512_add_pd(vec_y,vec_y4);
-    if (i == totalslices-1 && A->rmap->n & 0x07) { /* if last slice has padding rows */
-      _mm512_mask_storeu_pd(&z[8*i],mask,vec_y);
-    } else {
-      _mm512_storeu_pd(&z[8*i],vec_y);
-    }
-  }
-#elif defined(PETSC_HAVE_IMMINTRIN_H) && defined(__AVX__) && defined(PETSC_USE_REAL_DOUBLE) && !defined(PETSC_USE_COMPLEX) && !defined(PETSC_USE_64BIT_INDICES)
-  for (i=0; i<totalslices; i++) { /* loop over full slices */
-    PetscPrefetchBlock(acolidx,a->sliidx[i+1]-a->sliidx[i],0,PETSC_PREFETCH_HINT_T0);
-    PetscPrefetchBlock(aval,a->sliidx[i+1]-a->sliidx[i],0,PETSC_PREFETCH_HINT_T0);
-
-    /* last slice may have padding rows. Don't use vectorization. */
-    if (i == totalslices-1 && (A->rmap->n & 0x07)) {
-      for (r=0; r<(A->rmap->n & 0x07); ++r) {
-        row        = 8*i + r;
-        yval       = (MatScalar)0.0;
-        nnz_in_row = a->rlen[row];
-        for (j=0; j<nnz_in_row; ++j) yval += aval[8*j+r] * x[acolidx[8*j+r]];
-        z[row] = y[row] + yval;
+    if (!direct) {
+      for (r=0; r<sh && i*sh+r<m; r++) { /* skip the padding rows */
+        row    = MatSeqSELLRowOfPosition(a,i*sh+r);
+        z[row] = y ? y[row]+buf[r] : buf[r];
       }
-      break;
     }
+  }
+  PetscFunctionReturn(0);
+}
 
-    vec_y  = _mm256_loadu_pd(y+8*i);
-    vec_y2 = _mm256_loadu_pd(y+8*i+4);
-
-    /* Process slice of height 8 (512 bits) via two subslices of height 4 (256 bits) via AVX */
-    for (j=a->sliidx[i]; j<a->sliidx[i+1]; j+=8) {
-      vec_vals  = _mm256_loadu_pd(aval);
-      vec_x_tmp = _mm_loadl_pd(vec_x_tmp, x + *acolidx++);
-      vec_x_tmp = _mm_loadh_pd(vec_x_tmp, x + *acolidx++);
-      vec_x     = _mm256_insertf128_pd(vec_x,vec_x_tmp,0);
-      vec_x_tmp = _mm_loadl_pd(vec_x_tmp, x + *acolidx++);
-      vec_x_tmp = _mm_loadh_pd(vec_x_tmp, x + *acolidx++);
-      vec_x     = _mm256_insertf128_pd(vec_x,vec_x_tmp,1);
-      vec_y     = _mm256_add_pd(_mm256_mul_pd(vec_x,vec_vals),vec_y);
-      aval     += 4;
-
-      vec_vals  = _mm256_loadu_pd(aval);
-      vec_x_tmp = _mm_loadl_pd(vec_x_tmp, x + *acolidx++);
-      vec_x_tmp = _mm_loadh_pd(vec_x_tmp, x + *acolidx++);
-      vec_x     = _mm256_insertf128_pd(vec_x,vec_x_tmp,0);
-      vec_x_tmp = _mm_loadl_pd(vec_x_tmp, x + *acolidx++);
-      vec_x_tmp = _mm_loadh_pd(vec_x_tmp, x + *acolidx++);
-      vec_x     = _mm256_insertf128_pd(vec_x,vec_x_tmp,1);
-      vec_y2    = _mm256_add_pd(_mm256_mul_pd(vec_x,vec_vals),vec_y2);
-      aval     += 4;
-    }
+PetscErrorCode MatMult_SeqSELL(Mat A,Vec xx,Vec yy)
+{
+  Mat_SeqSELL       *a=(Mat_SeqSELL*)A->data;
+  PetscScalar       *y;
+  const PetscScalar *x;
+  PetscErrorCode    ierr;
 
-    _mm256_storeu_pd(z+i*8,vec_y);
-    _mm256_storeu_pd(z+i*8+4,vec_y2);
-  }
-#else
-  for (i=0; i<totalslices; i++) { /* loop over slices */
-    for (j=0; j<8; j++) sum[j] = 0.0;
-    for (j=a->sliidx[i]; j<a->sliidx[i+1]; j+=8) {
-      sum[0] += aval[j] * x[acolidx[j]];
-      sum[1] += aval[j+1] * x[acolidx[j+1]];
-      sum[2] += aval[j+2] * x[acolidx[j+2]];
-      sum[3] += aval[j+3] * x[acolidx[j+3]];
-      sum[4] += aval[j+4] * x[acolidx[j+4]];
-      sum[5] += aval[j+5] * x[acolidx[j+5]];
-      sum[6] += aval[j+6] * x[acolidx[j+6]];
-      sum[7] += aval[j+7] * x[acolidx[j+7]];
-    }
-    if (i == totalslices-1 && (A->rmap->n & 0x07)) {
-      for (j=0; j<(A->rmap->n & 0x07); j++) z[8*i+j] = y[8*i+j] + sum[j];
-    } else {
-      for (j=0; j<8; j++) z[8*i+j] = y[8*i+j] + sum[j];
-    }
-  }
-#endif
+  PetscFunctionBegin;
+  ierr = VecGetArrayRead(xx,&x);CHKERRQ(ierr);
+  ierr = VecGetArray(yy,&y);CHKERRQ(ierr);
+  ierr = MatMultAdd_SeqSELL_Private(A,x,NULL,y);CHKERRQ(ierr);
+  ierr = PetscLogFlops(2.0*a->nz-a->nonzerorowcnt);CHKERRQ(ierr); /* theoretical minimal FLOPs */
+  ierr = VecRestoreArrayRead(xx,&x);CHKERRQ(ierr);
+  ierr = VecRestoreArray(yy,&y);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
 
+PetscErrorCode MatMultAdd_SeqSELL(Mat A,Vec xx,Vec yy,Vec zz)
+{
+  Mat_SeqSELL       *a=(Mat_SeqSELL*)A->data;
+  PetscScalar       *y,*z;
+  const PetscScalar *x;
+  PetscErrorCode    ierr;
+
+  PetscFunctionBegin;
+  ierr = VecGetArrayRead(xx,&x);CHKERRQ(ierr);
+  ierr = VecGetArrayPair(yy,zz,&y,&z);CHKERRQ(ierr);
+  ierr = MatMultAdd_SeqSELL_Private(A,x,y,z);CHKERRQ(ierr);
   ierr = PetscLogFlops(2.0*a->nz);CHKERRQ(ierr);
   ierr = VecRestoreArrayRead(xx,&x);CHKERRQ(ierr);
   ierr = VecRestoreArrayPair(yy,zz,&y,&z);CHKERRQ(ierr);
@@ -664,11 +641,11 @@ PetscErrorCode MatMultAdd_SeqSELL(Mat A,Vec xx,Vec yy,Vec zz)
 PetscErrorCode MatMultTransposeAdd_SeqSELL(Mat A,Vec xx,Vec zz,Vec yy)
 {
   Mat_SeqSELL       *a=(Mat_SeqSELL*)A->data;
-  PetscScalar       *y;
+  PetscScalar       *y,xs[MAT_SELL_MAX_SLICE_HEIGHT];
   const PetscScalar *x;
   const MatScalar   *aval=a->val;
   const PetscInt    *acolidx=a->colidx;
-  PetscInt          i,j,r,row,nnz_in_row,totalslices=a->totalslices;
+  PetscInt          i,r,m=A->rmap->n,sh=a->sliceheight,width;
   PetscErrorCode    ierr;
 
 #if defined(PETSC_HAVE_PRAGMA_DISJOINT)
@@ -684,23 +661,21 @@ PetscErrorCode MatMultTransposeAdd_SeqSELL(Mat A,Vec xx,Vec zz,Vec yy)
   ierr = VecGetArrayRead(xx,&x);CHKERRQ(ierr);
   ierr = VecGetArray(yy,&y);CHKERRQ(ierr);
   for (i=0; i<a->totalslices; i++) { /* loop over slices */
-    if (i == totalslices-1 && (A->rmap->n & 0x07)) {
-      for (r=0; r<(A->rmap->n & 0x07); ++r) {
-        row        = 8*i + r;
-        nnz_in_row = a->rlen[row];
-        for (j=0; j<nnz_in_row; ++j) y[acolidx[8*j+r]] += aval[8*j+r] * x[row];
-      }
+    for (r=0; r<sh; r++) xs[r] = i*sh+r < m ? x[MatSeqSELLRowOfPosition(a,i*sh+r)] : 0.0; /* the padding rows contribute nothing */
+    width = (a->sliidx[i+1]-a->sliidx[i])/sh;
+    switch (sh) {
+    case 4:
+      MatMultTransposeSlice_SeqSELL_Private(4,width,aval+a->sliidx[i],acolidx+a->sliidx[i],xs,y);
+      break;
+    case 8:
+      MatMultTransposeSlice_SeqSELL_Private(8,width,aval+a->sliidx[i],acolidx+a->sliidx[i],xs,y);
+      break;
+    case 16:
+      MatMultTransposeSlice_SeqSELL_Private(16,width,aval+a->sliidx[i],acolidx+a->sliidx[i],xs,y);
+      break;
+    default:
+      MatMultTransposeSlice_SeqSELL_Private(32,width,aval+a->sliidx[i],acolidx+a->sliidx[i],xs,y);
       break;
-    }
-    for (j=a->sliidx[i]; j<a->sliidx[i+1]; j+=8) {
-      y[acolidx[j]]   += aval[j] * x[8*i];
-      y[acolidx[j+1]] += aval[j+1] * x[8*i+1];
-      y[acolidx[j+2]] += aval[j+2] * x[8*i+2];
-      y[acolidx[j+3]] += aval[j+3] * x[8*i+3];
-      y[acolidx[j+4]] += aval[j+4] * x[8*i+4];
-      y[acolidx[j+5]] += aval[j+5] * x[8*i+5];
-      y[acolidx[j+6]] += aval[j+6] * x[8*i+6];
-      y[acolidx[j+7]] += aval[j+7] * x[8*i+7];
     }
   }
   ierr = PetscLogFlops(2.0*a->sliidx[a->totalslices]);CHKERRQ(ierr);
@@ -755,7 +730,7 @@ PetscErrorCode MatMissingDiagonal_SeqSELL(Mat A,PetscBool  *missing,PetscInt *d)
 PetscErrorCode MatMarkDiagonal_SeqSELL(Mat A)
 {
   Mat_SeqSELL    *a=(Mat_SeqSELL*)A->data;
-  PetscInt       i,j,m=A->rmap->n,shift;
+  PetscInt       i,j,m=A->rmap->n,shift,sh=a->sliceheight;
   PetscErrorCode ierr;
 
   PetscFunctionBegin;
@@ -765,11 +740,11 @@ PetscErrorCode MatMarkDiagonal_SeqSELL(Mat A)
     a->free_diag = PETSC_TRUE;
   }
   for (i=0; i<m; i++) { /* loop over rows */
-    shift = a->sliidx[i>>3]+(i&0x07); /* starting index of the row i */
+    shift = MatSeqSELLRowShift(a,i); /* starting index of the row i */
     a->diag[i] = -1;
     for (j=0; j<a->rlen[i]; j++) {
-      if (a->colidx[shift+j*8] == i) {
-        a->diag[i] = shift+j*8;
+      if (a->colidx[shift+j*sh] == i) {
+        a->diag[i] = shift+j*sh;
         break;
       }
     }
@@ -851,6 +826,7 @@ PetscErrorCode MatDestroy_SeqSELL(Mat A)
   ierr = PetscFree(a->diag);CHKERRQ(ierr);
   ierr = PetscFree(a->rlen);CHKERRQ(ierr);
   ierr = PetscFree(a->sliidx);CHKERRQ(ierr);
+  ierr = PetscFree2(a->rowperm,a->irowperm);CHKERRQ(ierr);
   ierr = PetscFree3(a->idiag,a->mdiag,a->ssor_work);CHKERRQ(ierr);
   ierr = PetscFree(a->solve_work);CHKERRQ(ierr);
   ierr = ISDestroy(&a->icol);CHKERRQ(ierr);
@@ -863,6 +839,8 @@ PetscErrorCode MatDestroy_SeqSELL(Mat A)
   ierr = PetscObjectComposeFunction((PetscObject)A,"MatStoreValues_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)A,"MatRetrieveValues_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)A,"MatSeqSELLSetPreallocation_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)A,"MatSELLSetSliceHeight_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)A,"MatSELLSetSigma_C",NULL);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
@@ -913,7 +891,7 @@ PetscErrorCode MatSetOption_SeqSELL(Mat A,MatOption op,PetscBool flg)
 PetscErrorCode MatGetDiagonal_SeqSELL(Mat A,Vec v)
 {
   Mat_SeqSELL    *a=(Mat_SeqSELL*)A->data;
-  PetscInt       i,j,n,shift;
+  PetscInt       i,j,n,shift,sh=a->sliceheight;
   PetscScalar    *x,zero=0.0;
   PetscErrorCode ierr;
 
@@ -932,11 +910,11 @@ PetscErrorCode MatGetDiagonal_SeqSELL(Mat A,Vec v)
   ierr = VecSet(v,zero);CHKERRQ(ierr);
   ierr = VecGetArray(v,&x);CHKERRQ(ierr);
   for (i=0; i<n; i++) { /* loop over rows */
-    shift = a->sliidx[i>>3]+(i&0x07); /* starting index of the row i */
+    shift = MatSeqSELLRowShift(a,i); /* starting index of the row i */
     x[i] = 0;
     for (j=0; j<a->rlen[i]; j++) {
-      if (a->colidx[shift+j*8] == i) {
-        x[i] = a->val[shift+j*8];
+      if (a->colidx[shift+j*sh] == i) {
+        x[i] = a->val[shift+j*sh];
         break;
       }
     }
@@ -949,7 +927,7 @@ PetscErrorCode MatDiagonalScale_SeqSELL(Mat A,Vec ll,Vec rr)
 {
   Mat_SeqSELL       *a=(Mat_SeqSELL*)A->data;
   const PetscScalar *l,*r;
-  PetscInt          i,j,m,n,row;
+  PetscInt          i,j,m,n,row,sh=a->sliceheight;
   PetscErrorCode    ierr;
 
   PetscFunctionBegin;
@@ -960,14 +938,8 @@ PetscErrorCode MatDiagonalScale_SeqSELL(Mat A,Vec ll,Vec rr)
     if (m != A->rmap->n) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ARG_SIZ,"Left scaling vector wrong length");
     ierr = VecGetArrayRead(ll,&l);CHKERRQ(ierr);
     for (i=0; i<a->totalslices; i++) { /* loop over slices */
-      if (i == a->totalslices-1 && (A->rmap->n & 0x07)) { /* if last slice has padding rows */
-        for (j=a->sliidx[i],row=0; j<a->sliidx[i+1]; j++,row=((row+1)&0x07)) {
-          if (row < (A->rmap->n & 0x07)) a->val[j] *= l[8*i+row];
-        }
-      } else {
-        for (j=a->sliidx[i],row=0; j<a->sliidx[i+1]; j++,row=((row+1)&0x07)) {
-          a->val[j] *= l[8*i+row];
-        }
+      for (j=a->sliidx[i],row=0; j<a->sliidx[i+1]; j++,row=((row+1)%sh)) {
+        if (sh*i+row < A->rmap->n) a->val[j] *= l[MatSeqSELLRowOfPosition(a,sh*i+row)]; /* skip the padding rows */
       }
     }
     ierr = VecRestoreArrayRead(ll,&l);CHKERRQ(ierr);
@@ -978,9 +950,9 @@ PetscErrorCode MatDiagonalScale_SeqSELL(Mat A,Vec ll,Vec rr)
     if (n != A->cmap->n) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ARG_SIZ,"Right scaling vector wrong length");
     ierr = VecGetArrayRead(rr,&r);CHKERRQ(ierr);
     for (i=0; i<a->totalslices; i++) { /* loop over slices */
-      if (i == a->totalslices-1 && (A->rmap->n & 0x07)) { /* if last slice has padding rows */
-        for (j=a->sliidx[i],row=0; j<a->sliidx[i+1]; j++,row=((row+1)&0x07)) {
-          if (row < (A->rmap->n & 0x07)) a->val[j] *= r[a->colidx[j]];
+      if (i == a->totalslices-1 && (A->rmap->n % sh)) { /* if last slice has padding rows */
+        for (j=a->sliidx[i],row=0; j<a->sliidx[i+1]; j++,row=((row+1)%sh)) {
+          if (row < (A->rmap->n % sh)) a->val[j] *= r[a->colidx[j]];
         }
       } else {
         for (j=a->sliidx[i]; j<a->sliidx[i+1]; j++) {
@@ -1000,7 +972,7 @@ extern PetscErrorCode MatSetValues_SeqSELL(Mat,PetscInt,const PetscInt[],PetscIn
 PetscErrorCode MatGetValues_SeqSELL(Mat A,PetscInt m,const PetscInt im[],PetscInt n,const PetscInt in[],PetscScalar v[])
 {
   Mat_SeqSELL *a=(Mat_SeqSELL*)A->data;
-  PetscInt    *cp,i,k,low,high,t,row,col,l;
+  PetscInt    *cp,i,k,low,high,t,row,col,l,sh=a->sliceheight;
   PetscInt    shift;
   MatScalar   *vp;
 
@@ -1009,7 +981,7 @@ PetscErrorCode MatGetValues_SeqSELL(Mat A,PetscInt m,const PetscInt im[],PetscIn
     row = im[k];
     if (row<0) continue;
     if (PetscUnlikelyDebug(row >= A->rmap->n)) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"Row too large: row %D max %D",row,A->rmap->n-1);
-    shift = a->sliidx[row>>3]+(row&0x07); /* starting index of the row */
+    shift = MatSeqSELLRowShift(a,row); /* starting index of the row */
     cp = a->colidx+shift; /* pointer to the row */
     vp = a->val+shift; /* pointer to the row */
     for (l=0; l<n; l++) { /* loop over requested columns */
@@ -1019,13 +991,13 @@ PetscErrorCode MatGetValues_SeqSELL(Mat A,PetscInt m,const PetscInt im[],PetscIn
       high = a->rlen[row]; low = 0; /* assume unsorted */
       while (high-low > 5) {
         t = (low+high)/2;
-        if (*(cp+t*8) > col) high = t;
+        if (*(cp+t*sh) > col) high = t;
         else low = t;
       }
       for (i=low; i<high; i++) {
-        if (*(cp+8*i) > col) break;
-        if (*(cp+8*i) == col) {
-          *v++ = *(vp+8*i);
+        if (*(cp+sh*i) > col) break;
+        if (*(cp+sh*i) == col) {
+          *v++ = *(vp+sh*i);
           goto finished;
         }
       }
@@ -1039,7 +1011,7 @@ PetscErrorCode MatGetValues_SeqSELL(Mat A,PetscInt m,const PetscInt im[],PetscIn
 PetscErrorCode MatView_SeqSELL_ASCII(Mat A,PetscViewer viewer)
 {
   Mat_SeqSELL       *a=(Mat_SeqSELL*)A->data;
-  PetscInt          i,j,m=A->rmap->n,shift;
+  PetscInt          i,j,m=A->rmap->n,shift,sh=a->sliceheight;
   const char        *name;
   PetscViewerFormat format;
   PetscErrorCode    ierr;
@@ -1064,12 +1036,12 @@ PetscErrorCode MatView_SeqSELL_ASCII(Mat A,PetscViewer viewer)
     ierr = PetscViewerASCIIPrintf(viewer,"zzz = [\n");CHKERRQ(ierr);
 
     for (i=0; i<m; i++) {
-      shift = a->sliidx[i>>3]+(i&0x07);
+      shift = MatSeqSELLRowShift(a,i);
       for (j=0; j<a->rlen[i]; j++) {
 #if defined(PETSC_USE_COMPLEX)
-        ierr = PetscViewerASCIIPrintf(viewer,"%D %D  %18.16e %18.16e\n",i+1,a->colidx[shift+8*j]+1,(double)PetscRealPart(a->val[shift+8*j]),(double)PetscImaginaryPart(a->val[shift+8*j]));CHKERRQ(ierr);
+        ierr = PetscViewerASCIIPrintf(viewer,"%D %D  %18.16e %18.16e\n",i+1,a->colidx[shift+sh*j]+1,(double)PetscRealPart(a->val[shift+sh*j]),(double)PetscImaginaryPart(a->val[shift+sh*j]));CHKERRQ(ierr);
 #else
-        ierr = PetscViewerASCIIPrintf(viewer,"%D %D  %18.16e\n",i+1,a->colidx[shift+8*j]+1,(double)a->val[shift+8*j]);CHKERRQ(ierr);
+        ierr = PetscViewerASCIIPrintf(viewer,"%D %D  %18.16e\n",i+1,a->colidx[shift+sh*j]+1,(double)a->val[shift+sh*j]);CHKERRQ(ierr);
 #endif
       }
     }
@@ -1091,18 +1063,18 @@ PetscErrorCode MatView_SeqSELL_ASCII(Mat A,PetscViewer viewer)
     ierr = PetscViewerASCIIUseTabs(viewer,PETSC_FALSE);CHKERRQ(ierr);
     for (i=0; i<m; i++) {
       ierr = PetscViewerASCIIPrintf(viewer,"row %D:",i);CHKERRQ(ierr);
-      shift = a->sliidx[i>>3]+(i&0x07);
+      shift = MatSeqSELLRowShift(a,i);
       for (j=0; j<a->rlen[i]; j++) {
 #if defined(PETSC_USE_COMPLEX)
-        if (PetscImaginaryPart(a->val[shift+8*j]) > 0.0 && PetscRealPart(a->val[shift+8*j]) != 0.0) {
-          ierr = PetscViewerASCIIPrintf(viewer," (%D, %g + %g i)",a->colidx[shift+8*j],(double)PetscRealPart(a->val[shift+8*j]),(double)PetscImaginaryPart(a->val[shift+8*j]));CHKERRQ(ierr);
-        } else if (PetscImaginaryPart(a->val[shift+8*j]) < 0.0 && PetscRealPart(a->val[shift+8*j]) != 0.0) {
-          ierr = PetscViewerASCIIPrintf(viewer," (%D, %g - %g i)",a->colidx[shift+8*j],(double)PetscRealPart(a->val[shift+8*j]),(double)-PetscImaginaryPart(a->val[shift+8*j]));CHKERRQ(ierr);
-        } else if (PetscRealPart(a->val[shift+8*j]) != 0.0) {
-          ierr = PetscViewerASCIIPrintf(viewer," (%D, %g) ",a->colidx[shift+8*j],(double)PetscRealPart(a->val[shift+8*j]));CHKERRQ(ierr);
+        if (PetscImaginaryPart(a->val[shift+sh*j]) > 0.0 && PetscRealPart(a->val[shift+sh*j]) != 0.0) {
+          ierr = PetscViewerASCIIPrintf(viewer," (%D, %g + %g i)",a->colidx[shift+sh*j],(double)PetscRealPart(a->val[shift+sh*j]),(double)PetscImaginaryPart(a->val[shift+sh*j]));CHKERRQ(ierr);
+        } else if (PetscImaginaryPart(a->val[shift+sh*j]) < 0.0 && PetscRealPart(a->val[shift+sh*j]) != 0.0) {
+          ierr = PetscViewerASCIIPrintf(viewer," (%D, %g - %g i)",a->colidx[shift+sh*j],(double)PetscRealPart(a->val[shift+sh*j]),(double)-PetscImaginaryPart(a->val[shift+sh*j]));CHKERRQ(ierr);
+        } else if (PetscRealPart(a->val[shift+sh*j]) != 0.0) {
+          ierr = PetscViewerASCIIPrintf(viewer," (%D, %g) ",a->colidx[shift+sh*j],(double)PetscRealPart(a->val[shift+sh*j]));CHKERRQ(ierr);
         }
 #else
-        if (a->val[shift+8*j] != 0.0) {ierr = PetscViewerASCIIPrintf(viewer," (%D, %g) ",a->colidx[shift+8*j],(double)a->val[shift+8*j]);CHKERRQ(ierr);}
+        if (a->val[shift+sh*j] != 0.0) {ierr = PetscViewerASCIIPrintf(viewer," (%D, %g) ",a->colidx[shift+sh*j],(double)a->val[shift+sh*j]);CHKERRQ(ierr);}
 #endif
       }
       ierr = PetscViewerASCIIPrintf(viewer,"\n");CHKERRQ(ierr);
@@ -1124,9 +1096,9 @@ PetscErrorCode MatView_SeqSELL_ASCII(Mat A,PetscViewer viewer)
     ierr = PetscViewerASCIIUseTabs(viewer,PETSC_FALSE);CHKERRQ(ierr);
     for (i=0; i<m; i++) {
       jcnt = 0;
-      shift = a->sliidx[i>>3]+(i&0x07);
+      shift = MatSeqSELLRowShift(a,i);
       for (j=0; j<A->cmap->n; j++) {
-        if (jcnt < a->rlen[i] && j == a->colidx[shift+8*j]) {
+        if (jcnt < a->rlen[i] && j == a->colidx[shift+sh*j]) {
           value = a->val[cnt++];
           jcnt++;
         } else {
@@ -1155,12 +1127,12 @@ PetscErrorCode MatView_SeqSELL_ASCII(Mat A,PetscViewer viewer)
 #endif
     ierr = PetscViewerASCIIPrintf(viewer,"%D %D %D\n", m, A->cmap->n, a->nz);CHKERRQ(ierr);
     for (i=0; i<m; i++) {
-      shift = a->sliidx[i>>3]+(i&0x07);
+      shift = MatSeqSELLRowShift(a,i);
       for (j=0; j<a->rlen[i]; j++) {
 #if defined(PETSC_USE_COMPLEX)
-        ierr = PetscViewerASCIIPrintf(viewer,"%D %D %g %g\n",i+fshift,a->colidx[shift+8*j]+fshift,(double)PetscRealPart(a->val[shift+8*j]),(double)PetscImaginaryPart(a->val[shift+8*j]));CHKERRQ(ierr);
+        ierr = PetscViewerASCIIPrintf(viewer,"%D %D %g %g\n",i+fshift,a->colidx[shift+sh*j]+fshift,(double)PetscRealPart(a->val[shift+sh*j]),(double)PetscImaginaryPart(a->val[shift+sh*j]));CHKERRQ(ierr);
 #else
-        ierr = PetscViewerASCIIPrintf(viewer,"%D %D %g\n",i+fshift,a->colidx[shift+8*j]+fshift,(double)a->val[shift+8*j]);CHKERRQ(ierr);
+        ierr = PetscViewerASCIIPrintf(viewer,"%D %D %g\n",i+fshift,a->colidx[shift+sh*j]+fshift,(double)a->val[shift+sh*j]);CHKERRQ(ierr);
 #endif
       }
     }
@@ -1169,17 +1141,17 @@ PetscErrorCode MatView_SeqSELL_ASCII(Mat A,PetscViewer viewer)
     for (i=0; i<a->totalslices; i++) { /* loop over slices */
       PetscInt row;
       ierr = PetscViewerASCIIPrintf(viewer,"slice %D: %D %D\n",i,a->sliidx[i],a->sliidx[i+1]);CHKERRQ(ierr);
-      for (j=a->sliidx[i],row=0; j<a->sliidx[i+1]; j++,row=((row+1)&0x07)) {
+      for (j=a->sliidx[i],row=0; j<a->sliidx[i+1]; j++,row=((row+1)%sh)) {
 #if defined(PETSC_USE_COMPLEX)
         if (PetscImaginaryPart(a->val[j]) > 0.0) {
-          ierr = PetscViewerASCIIPrintf(viewer,"  %D %D %g + %g i\n",8*i+row,a->colidx[j],(double)PetscRealPart(a->val[j]),(double)PetscImaginaryPart(a->val[j]));CHKERRQ(ierr);
+          ierr = PetscViewerASCIIPrintf(viewer,"  %D %D %g + %g i\n",MatSeqSELLRowOfPosition(a,sh*i+row),a->colidx[j],(double)PetscRealPart(a->val[j]),(double)PetscImaginaryPart(a->val[j]));CHKERRQ(ierr);
         } else if (PetscImaginaryPart(a->val[j]) < 0.0) {
-          ierr = PetscViewerASCIIPrintf(viewer,"  %D %D %g - %g i\n",8*i+row,a->colidx[j],(double)PetscRealPart(a->val[j]),-(double)PetscImaginaryPart(a->val[j]));CHKERRQ(ierr);
+          ierr = PetscViewerASCIIPrintf(viewer,"  %D %D %g - %g i\n",MatSeqSELLRowOfPosition(a,sh*i+row),a->colidx[j],(double)PetscRealPart(a->val[j]),-(double)PetscImaginaryPart(a->val[j]));CHKERRQ(ierr);
         } else {
-          ierr = PetscViewerASCIIPrintf(viewer,"  %D %D %g\n",8*i+row,a->colidx[j],(double)PetscRealPart(a->val[j]));CHKERRQ(ierr);
+          ierr = PetscViewerASCIIPrintf(viewer,"  %D %D %g\n",MatSeqSELLRowOfPosition(a,sh*i+row),a->colidx[j],(double)PetscRealPart(a->val[j]));CHKERRQ(ierr);
         }
 #else
-        ierr = PetscViewerASCIIPrintf(viewer,"  %D %D %g\n",8*i+row,a->colidx[j],(double)a->val[j]);CHKERRQ(ierr);
+        ierr = PetscViewerASCIIPrintf(viewer,"  %D %D %g\n",MatSeqSELLRowOfPosition(a,sh*i+row),a->colidx[j],(double)a->val[j]);CHKERRQ(ierr);
 #endif
       }
     }
@@ -1187,14 +1159,14 @@ PetscErrorCode MatView_SeqSELL_ASCII(Mat A,PetscViewer viewer)
     ierr = PetscViewerASCIIUseTabs(viewer,PETSC_FALSE);CHKERRQ(ierr);
     if (A->factortype) {
       for (i=0; i<m; i++) {
-        shift = a->sliidx[i>>3]+(i&0x07);
+        shift = MatSeqSELLRowShift(a,i);
         ierr = PetscViewerASCIIPrintf(viewer,"row %D:",i);CHKERRQ(ierr);
         /* L part */
-        for (j=shift; j<a->diag[i]; j+=8) {
+        for (j=shift; j<a->diag[i]; j+=sh) {
 #if defined(PETSC_USE_COMPLEX)
-          if (PetscImaginaryPart(a->val[shift+8*j]) > 0.0) {
+          if (PetscImaginaryPart(a->val[shift+sh*j]) > 0.0) {
             ierr = PetscViewerASCIIPrintf(viewer," (%D, %g + %g i)",a->colidx[j],(double)PetscRealPart(a->val[j]),(double)PetscImaginaryPart(a->val[j]));CHKERRQ(ierr);
-          } else if (PetscImaginaryPart(a->val[shift+8*j]) < 0.0) {
+          } else if (PetscImaginaryPart(a->val[shift+sh*j]) < 0.0) {
             ierr = PetscViewerASCIIPrintf(viewer," (%D, %g - %g i)",a->colidx[j],(double)PetscRealPart(a->val[j]),(double)(-PetscImaginaryPart(a->val[j])));CHKERRQ(ierr);
           } else {
             ierr = PetscViewerASCIIPrintf(viewer," (%D, %g) ",a->colidx[j],(double)PetscRealPart(a->val[j]));CHKERRQ(ierr);
@@ -1218,7 +1190,7 @@ PetscErrorCode MatView_SeqSELL_ASCII(Mat A,PetscViewer viewer)
 #endif
 
         /* U part */
-        for (j=a->diag[i]+1; j<shift+8*a->rlen[i]; j+=8) {
+        for (j=a->diag[i]+1; j<shift+sh*a->rlen[i]; j+=sh) {
 #if defined(PETSC_USE_COMPLEX)
           if (PetscImaginaryPart(a->val[j]) > 0.0) {
             ierr = PetscViewerASCIIPrintf(viewer," (%D, %g + %g i)",a->colidx[j],(double)PetscRealPart(a->val[j]),(double)PetscImaginaryPart(a->val[j]));CHKERRQ(ierr);
@@ -1235,19 +1207,19 @@ PetscErrorCode MatView_SeqSELL_ASCII(Mat A,PetscViewer viewer)
       }
     } else {
       for (i=0; i<m; i++) {
-        shift = a->sliidx[i>>3]+(i&0x07);
+        shift = MatSeqSELLRowShift(a,i);
         ierr = PetscViewerASCIIPrintf(viewer,"row %D:",i);CHKERRQ(ierr);
         for (j=0; j<a->rlen[i]; j++) {
 #if defined(PETSC_USE_COMPLEX)
           if (PetscImaginaryPart(a->val[j]) > 0.0) {
-            ierr = PetscViewerASCIIPrintf(viewer," (%D, %g + %g i)",a->colidx[shift+8*j],(double)PetscRealPart(a->val[shift+8*j]),(double)PetscImaginaryPart(a->val[shift+8*j]));CHKERRQ(ierr);
+            ierr = PetscViewerASCIIPrintf(viewer," (%D, %g + %g i)",a->colidx[shift+sh*j],(double)PetscRealPart(a->val[shift+sh*j]),(double)PetscImaginaryPart(a->val[shift+sh*j]));CHKERRQ(ierr);
           } else if (PetscImaginaryPart(a->val[j]) < 0.0) {
-            ierr = PetscViewerASCIIPrintf(viewer," (%D, %g - %g i)",a->colidx[shift+8*j],(double)PetscRealPart(a->val[shift+8*j]),(double)-PetscImaginaryPart(a->val[shift+8*j]));CHKERRQ(ierr);
+            ierr = PetscViewerASCIIPrintf(viewer," (%D, %g - %g i)",a->colidx[shift+sh*j],(double)PetscRealPart(a->val[shift+sh*j]),(double)-PetscImaginaryPart(a->val[shift+sh*j]));CHKERRQ(ierr);
           } else {
-            ierr = PetscViewerASCIIPrintf(viewer," (%D, %g) ",a->colidx[shift+8*j],(double)PetscRealPart(a->val[shift+8*j]));CHKERRQ(ierr);
+            ierr = PetscViewerASCIIPrintf(viewer," (%D, %g) ",a->colidx[shift+sh*j],(double)PetscRealPart(a->val[shift+sh*j]));CHKERRQ(ierr);
           }
 #else
-          ierr = PetscViewerASCIIPrintf(viewer," (%D, %g) ",a->colidx[shift+8*j],(double)a->val[shift+8*j]);CHKERRQ(ierr);
+          ierr = PetscViewerASCIIPrintf(viewer," (%D, %g) ",a->colidx[shift+sh*j],(double)a->val[shift+sh*j]);CHKERRQ(ierr);
 #endif
         }
         ierr = PetscViewerASCIIPrintf(viewer,"\n");CHKERRQ(ierr);
@@ -1264,7 +1236,7 @@ PetscErrorCode MatView_SeqSELL_Draw_Zoom(PetscDraw draw,void *Aa)
 {
   Mat               A=(Mat)Aa;
   Mat_SeqSELL       *a=(Mat_SeqSELL*)A->data;
-  PetscInt          i,j,m=A->rmap->n,shift;
+  PetscInt          i,j,m=A->rmap->n,shift,sh=a->sliceheight;
   int               color;
   PetscReal         xl,yl,xr,yr,x_l,x_r,y_l,y_r;
   PetscViewer       viewer;
@@ -1283,31 +1255,31 @@ PetscErrorCode MatView_SeqSELL_Draw_Zoom(PetscDraw draw,void *Aa)
     /* Blue for negative, Cyan for zero and  Red for positive */
     color = PETSC_DRAW_BLUE;
     for (i=0; i<m; i++) {
-      shift = a->sliidx[i>>3]+(i&0x07); /* starting index of the row i */
+      shift = MatSeqSELLRowShift(a,i); /* starting index of the row i */
       y_l = m - i - 1.0; y_r = y_l + 1.0;
       for (j=0; j<a->rlen[i]; j++) {
-        x_l = a->colidx[shift+j*8]; x_r = x_l + 1.0;
-        if (PetscRealPart(a->val[shift+8*j]) >=  0.) continue;
+        x_l = a->colidx[shift+j*sh]; x_r = x_l + 1.0;
+        if (PetscRealPart(a->val[shift+sh*j]) >=  0.) continue;
         ierr = PetscDrawRectangle(draw,x_l,y_l,x_r,y_r,color,color,color,color);CHKERRQ(ierr);
       }
     }
     color = PETSC_DRAW_CYAN;
     for (i=0; i<m; i++) {
-      shift = a->sliidx[i>>3]+(i&0x07);
+      shift = MatSeqSELLRowShift(a,i);
       y_l = m - i - 1.0; y_r = y_l + 1.0;
       for (j=0; j<a->rlen[i]; j++) {
-        x_l = a->colidx[shift+j*8]; x_r = x_l + 1.0;
-        if (a->val[shift+8*j] !=  0.) continue;
+        x_l = a->colidx[shift+j*sh]; x_r = x_l + 1.0;
+        if (a->val[shift+sh*j] !=  0.) continue;
         ierr = PetscDrawRectangle(draw,x_l,y_l,x_r,y_r,color,color,color,color);CHKERRQ(ierr);
       }
     }
     color = PETSC_DRAW_RED;
     for (i=0; i<m; i++) {
-      shift = a->sliidx[i>>3]+(i&0x07);
+      shift = MatSeqSELLRowShift(a,i);
       y_l = m - i - 1.0; y_r = y_l + 1.0;
       for (j=0; j<a->rlen[i]; j++) {
-        x_l = a->colidx[shift+j*8]; x_r = x_l + 1.0;
-        if (PetscRealPart(a->val[shift+8*j]) <=  0.) continue;
+        x_l = a->colidx[shift+j*sh]; x_r = x_l + 1.0;
+        if (PetscRealPart(a->val[shift+sh*j]) <=  0.) continue;
         ierr = PetscDrawRectangle(draw,x_l,y_l,x_r,y_r,color,color,color,color);CHKERRQ(ierr);
       }
     }
@@ -1327,11 +1299,11 @@ PetscErrorCode MatView_SeqSELL_Draw_Zoom(PetscDraw draw,void *Aa)
 
     ierr = PetscDrawCollectiveBegin(draw);CHKERRQ(ierr);
     for (i=0; i<m; i++) {
-      shift = a->sliidx[i>>3]+(i&0x07);
+      shift = MatSeqSELLRowShift(a,i);
       y_l = m - i - 1.0;
       y_r = y_l + 1.0;
       for (j=0; j<a->rlen[i]; j++) {
-        x_l = a->colidx[shift+j*8];
+        x_l = a->colidx[shift+j*sh];
         x_r = x_l + 1.0;
         color = PetscDrawRealToColor(PetscAbsScalar(a->val[count]),minv,maxv);
         ierr = PetscDrawRectangle(draw,x_l,y_l,x_r,y_r,color,color,color,color);CHKERRQ(ierr);
@@ -1388,7 +1360,7 @@ PetscErrorCode MatView_SeqSELL(Mat A,PetscViewer viewer)
 PetscErrorCode MatAssemblyEnd_SeqSELL(Mat A,MatAssemblyType mode)
 {
   Mat_SeqSELL    *a=(Mat_SeqSELL*)A->data;
-  PetscInt       i,shift,row_in_slice,row,nrow,*cp,lastcol,j,k;
+  PetscInt       i,shift,row_in_slice,row,nrow,*cp,lastcol,j,k,sh=a->sliceheight;
   MatScalar      *vp;
   PetscErrorCode ierr;
 
@@ -1404,8 +1376,8 @@ PetscErrorCode MatAssemblyEnd_SeqSELL(Mat A,MatAssemblyType mode)
     shift = a->sliidx[i];    /* starting index of the slice */
     cp    = a->colidx+shift; /* pointer to the column indices of the slice */
     vp    = a->val+shift;    /* pointer to the nonzero values of the slice */
-    for (row_in_slice=0; row_in_slice<8; ++row_in_slice) { /* loop over rows in the slice */
-      row  = 8*i + row_in_slice;
+    for (row_in_slice=0; row_in_slice<sh; ++row_in_slice) { /* loop over rows in the slice */
+      row  = MatSeqSELLRowOfPosition(a,sh*i+row_in_slice);
       nrow = a->rlen[row]; /* number of nonzeros in row */
       /*
         Search for the nearest nonzero. Normally setting the index to zero may cause extra communication.
@@ -1413,10 +1385,10 @@ PetscErrorCode MatAssemblyEnd_SeqSELL(Mat A,MatAssemblyType mode)
       */
       lastcol = 0;
       if (nrow>0) { /* nonempty row */
-        lastcol = cp[8*(nrow-1)+row_in_slice]; /* use the index from the last nonzero at current row */
+        lastcol = cp[sh*(nrow-1)+row_in_slice]; /* use the index from the last nonzero at current row */
       } else if (!row_in_slice) { /* first row of the currect slice is empty */
-        for (j=1;j<8;j++) {
-          if (a->rlen[8*i+j]) {
+        for (j=1;j<sh;j++) {
+          if (a->rlen[MatSeqSELLRowOfPosition(a,sh*i+j)]) {
             lastcol = cp[j];
             break;
           }
@@ -1425,9 +1397,9 @@ PetscErrorCode MatAssemblyEnd_SeqSELL(Mat A,MatAssemblyType mode)
         if (a->sliidx[i+1] != shift) lastcol = cp[row_in_slice-1]; /* use the index from the previous row */
       }
 
-      for (k=nrow; k<(a->sliidx[i+1]-shift)/8; ++k) {
-        cp[8*k+row_in_slice] = lastcol;
-        vp[8*k+row_in_slice] = (MatScalar)0;
+      for (k=nrow; k<(a->sliidx[i+1]-shift)/sh; ++k) {
+        cp[sh*k+row_in_slice] = lastcol;
+        vp[sh*k+row_in_slice] = (MatScalar)0;
       }
     }
   }
@@ -1466,7 +1438,7 @@ PetscErrorCode MatGetInfo_SeqSELL(Mat A,MatInfoType flag,MatInfo *info)
 PetscErrorCode MatSetValues_SeqSELL(Mat A,PetscInt m,const PetscInt im[],PetscInt n,const PetscInt in[],const PetscScalar v[],InsertMode is)
 {
   Mat_SeqSELL    *a=(Mat_SeqSELL*)A->data;
-  PetscInt       shift,i,k,l,low,high,t,ii,row,col,nrow;
+  PetscInt       shift,i,k,l,low,high,t,ii,row,col,nrow,sh=a->sliceheight;
   PetscInt       *cp,nonew=a->nonew,lastcol=-1;
   MatScalar      *vp,value;
   PetscErrorCode ierr;
@@ -1476,7 +1448,7 @@ PetscErrorCode MatSetValues_SeqSELL(Mat A,PetscInt m,const PetscInt im[],PetscIn
     row = im[k];
     if (row < 0) continue;
     if (PetscUnlikelyDebug(row >= A->rmap->n)) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"Row too large: row %D max %D",row,A->rmap->n-1);
-    shift = a->sliidx[row>>3]+(row&0x07); /* starting index of the row */
+    shift = MatSeqSELLRowShift(a,row); /* starting index of the row */
     cp    = a->colidx+shift; /* pointer to the row */
     vp    = a->val+shift; /* pointer to the row */
     nrow  = a->rlen[row];
@@ -1500,14 +1472,14 @@ PetscErrorCode MatSetValues_SeqSELL(Mat A,PetscInt m,const PetscInt im[],PetscIn
       lastcol = col;
       while (high-low > 5) {
         t = (low+high)/2;
-        if (*(cp+t*8) > col) high = t;
+        if (*(cp+t*sh) > col) high = t;
         else low = t;
       }
       for (i=low; i<high; i++) {
-        if (*(cp+i*8) > col) break;
-        if (*(cp+i*8) == col) {
-          if (is == ADD_VALUES) *(vp+i*8) += value;
-          else *(vp+i*8) = value;
+        if (*(cp+i*sh) > col) break;
+        if (*(cp+i*sh) == col) {
+          if (is == ADD_VALUES) *(vp+i*sh) += value;
+          else *(vp+i*sh) = value;
           low = i + 1;
           goto noinsert;
         }
@@ -1516,15 +1488,15 @@ PetscErrorCode MatSetValues_SeqSELL(Mat A,PetscInt m,const PetscInt im[],PetscIn
       if (nonew == 1) goto noinsert;
       if (nonew == -1) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"Inserting a new nonzero (%D, %D) in the matrix", row, col);
       /* If the current row length exceeds the slice width (e.g. nrow==slice_width), allocate a new space, otherwise do nothing */
-      MatSeqXSELLReallocateSELL(A,A->rmap->n,1,nrow,a->sliidx,row/8,row,col,a->colidx,a->val,cp,vp,nonew,MatScalar);
+      MatSeqXSELLReallocateSELL(A,A->rmap->n,1,nrow,a->sliidx,MatSeqSELLPositionOfRow(a,row)/sh,row,col,a->colidx,a->val,cp,vp,nonew,MatScalar);
       /* add the new nonzero to the high position, shift the remaining elements in current row to the right by one slot */
       for (ii=nrow-1; ii>=i; ii--) {
-        *(cp+(ii+1)*8) = *(cp+ii*8);
-        *(vp+(ii+1)*8) = *(vp+ii*8);
+        *(cp+(ii+1)*sh) = *(cp+ii*sh);
+        *(vp+(ii+1)*sh) = *(vp+ii*sh);
       }
       a->rlen[row]++;
-      *(cp+i*8) = col;
-      *(vp+i*8) = value;
+      *(cp+i*sh) = col;
+      *(vp+i*sh) = value;
       a->nz++;
       A->nonzerostate++;
       low = i+1; high++; nrow++;
@@ -1535,13 +1507,17 @@ noinsert:;
   PetscFunctionReturn(0);
 }
 
+static PetscErrorCode MatSeqSELLSameStorage_Private(Mat,Mat,PetscBool*);
+
 PetscErrorCode MatCopy_SeqSELL(Mat A,Mat B,MatStructure str)
 {
+  PetscBool      same=PETSC_FALSE;
   PetscErrorCode ierr;
 
   PetscFunctionBegin;
-  /* If the two matrices have the same copy implementation, use fast copy. */
-  if (str == SAME_NONZERO_PATTERN && (A->ops->copy == B->ops->copy)) {
+  /* If the two matrices have the same copy implementation and storage layout, use fast copy. */
+  if (str == SAME_NONZERO_PATTERN && (A->ops->copy == B->ops->copy)) {ierr = MatSeqSELLSameStorage_Private(A,B,&same);CHKERRQ(ierr);}
+  if (same) {
     Mat_SeqSELL *a=(Mat_SeqSELL*)A->data;
     Mat_SeqSELL *b=(Mat_SeqSELL*)B->data;
 
@@ -1636,7 +1612,7 @@ PetscErrorCode MatSOR_SeqSELL(Mat A,Vec bb,PetscReal omega,MatSORType flag,Petsc
   PetscScalar       *x,sum,*t;
   const MatScalar   *idiag=NULL,*mdiag;
   const PetscScalar *b,*xb;
-  PetscInt          n,m=A->rmap->n,i,j,shift;
+  PetscInt          n,m=A->rmap->n,i,j,shift,sh=a->sliceheight;
   const PetscInt    *diag;
   PetscErrorCode    ierr;
 
@@ -1663,10 +1639,10 @@ PetscErrorCode MatSOR_SeqSELL(Mat A,Vec bb,PetscReal omega,MatSORType flag,Petsc
   if (flag & SOR_ZERO_INITIAL_GUESS) {
     if ((flag & SOR_FORWARD_SWEEP) || (flag & SOR_LOCAL_FORWARD_SWEEP)) {
       for (i=0; i<m; i++) {
-        shift = a->sliidx[i>>3]+(i&0x07); /* starting index of the row i */
+        shift = MatSeqSELLRowShift(a,i); /* starting index of the row i */
         sum   = b[i];
-        n     = (diag[i]-shift)/8;
-        for (j=0; j<n; j++) sum -= a->val[shift+j*8]*x[a->colidx[shift+j*8]];
+        n     = (diag[i]-shift)/sh;
+        for (j=0; j<n; j++) sum -= a->val[shift+j*sh]*x[a->colidx[shift+j*sh]];
         t[i]  = sum;
         x[i]  = sum*idiag[i];
       }
@@ -1675,10 +1651,10 @@ PetscErrorCode MatSOR_SeqSELL(Mat A,Vec bb,PetscReal omega,MatSORType flag,Petsc
     } else xb = b;
     if ((flag & SOR_BACKWARD_SWEEP) || (flag & SOR_LOCAL_BACKWARD_SWEEP)) {
       for (i=m-1; i>=0; i--) {
-        shift = a->sliidx[i>>3]+(i&0x07); /* starting index of the row i */
+        shift = MatSeqSELLRowShift(a,i); /* starting index of the row i */
         sum   = xb[i];
-        n     = a->rlen[i]-(diag[i]-shift)/8-1;
-        for (j=1; j<=n; j++) sum -= a->val[diag[i]+j*8]*x[a->colidx[diag[i]+j*8]];
+        n     = a->rlen[i]-(diag[i]-shift)/sh-1;
+        for (j=1; j<=n; j++) sum -= a->val[diag[i]+j*sh]*x[a->colidx[diag[i]+j*sh]];
         if (xb == b) {
           x[i] = sum*idiag[i];
         } else {
@@ -1693,14 +1669,14 @@ PetscErrorCode MatSOR_SeqSELL(Mat A,Vec bb,PetscReal omega,MatSORType flag,Petsc
     if ((flag & SOR_FORWARD_SWEEP) || (flag & SOR_LOCAL_FORWARD_SWEEP)) {
       for (i=0; i<m; i++) {
         /* lower */
-        shift = a->sliidx[i>>3]+(i&0x07); /* starting index of the row i */
+        shift = MatSeqSELLRowShift(a,i); /* starting index of the row i */
         sum   = b[i];
-        n     = (diag[i]-shift)/8;
-        for (j=0; j<n; j++) sum -= a->val[shift+j*8]*x[a->colidx[shift+j*8]];
+        n     = (diag[i]-shift)/sh;
+        for (j=0; j<n; j++) sum -= a->val[shift+j*sh]*x[a->colidx[shift+j*sh]];
         t[i]  = sum;             /* save application of the lower-triangular part */
         /* upper */
-        n     = a->rlen[i]-(diag[i]-shift)/8-1;
-        for (j=1; j<=n; j++) sum -= a->val[diag[i]+j*8]*x[a->colidx[diag[i]+j*8]];
+        n     = a->rlen[i]-(diag[i]-shift)/sh-1;
+        for (j=1; j<=n; j++) sum -= a->val[diag[i]+j*sh]*x[a->colidx[diag[i]+j*sh]];
         x[i]  = (1.-omega)*x[i]+sum*idiag[i];  /* omega in idiag */
       }
       xb   = t;
@@ -1708,16 +1684,16 @@ PetscErrorCode MatSOR_SeqSELL(Mat A,Vec bb,PetscReal omega,MatSORType flag,Petsc
     } else xb = b;
     if ((flag & SOR_BACKWARD_SWEEP) || (flag & SOR_LOCAL_BACKWARD_SWEEP)) {
       for (i=m-1; i>=0; i--) {
-        shift = a->sliidx[i>>3]+(i&0x07); /* starting index of the row i */
+        shift = MatSeqSELLRowShift(a,i); /* starting index of the row i */
         sum = xb[i];
         if (xb == b) {
           /* whole matrix (no checkpointing available) */
           n     = a->rlen[i];
-          for (j=0; j<n; j++) sum -= a->val[shift+j*8]*x[a->colidx[shift+j*8]];
+          for (j=0; j<n; j++) sum -= a->val[shift+j*sh]*x[a->colidx[shift+j*sh]];
           x[i] = (1.-omega)*x[i]+(sum+mdiag[i]*x[i])*idiag[i];
         } else { /* lower-triangular part has been saved, so only apply upper-triangular */
-          n     = a->rlen[i]-(diag[i]-shift)/8-1;
-          for (j=1; j<=n; j++) sum -= a->val[diag[i]+j*8]*x[a->colidx[diag[i]+j*8]];
+          n     = a->rlen[i]-(diag[i]-shift)/sh-1;
+          for (j=1; j<=n; j++) sum -= a->val[diag[i]+j*sh]*x[a->colidx[diag[i]+j*sh]];
           x[i]  = (1.-omega)*x[i]+sum*idiag[i];  /* omega in idiag */
         }
       }
@@ -1810,7 +1786,7 @@ static struct _MatOps MatOps_Values = {MatSetValues_SeqSELL,
                                        NULL,
                                /* 74*/ NULL,
                                        MatFDColoringApply_AIJ, /* reuse the FDColoring function for AIJ */
-                                       NULL,
+                                       MatSetFromOptions_SeqSELL,
                                        NULL,
                                        NULL,
                                /* 79*/ NULL,
@@ -1968,6 +1944,10 @@ PETSC_EXTERN PetscErrorCode MatCreate_SeqSELL(Mat B)
   b->fshift             = 0.0;
   b->idiagvalid         = PETSC_FALSE;
   b->keepnonzeropattern = PETSC_FALSE;
+  b->sliceheight        = 8;
+  b->sigma              = 1;
+  b->rowperm            = NULL;
+  b->irowperm           = NULL;
 
   ierr = PetscObjectChangeTypeName((PetscObject)B,MATSEQSELL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)B,"MatSeqSELLGetArray_C",MatSeqSELLGetArray_SeqSELL);CHKERRQ(ierr);
@@ -1976,6 +1956,8 @@ PETSC_EXTERN PetscErrorCode MatCreate_SeqSELL(Mat B)
   ierr = PetscObjectComposeFunction((PetscObject)B,"MatRetrieveValues_C",MatRetrieveValues_SeqSELL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)B,"MatSeqSELLSetPreallocation_C",MatSeqSELLSetPreallocation_SeqSELL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)B,"MatConvert_seqsell_seqaij_C",MatConvert_SeqSELL_SeqAIJ);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)B,"MatSELLSetSliceHeight_C",MatSELLSetSliceHeight_SeqSELL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)B,"MatSELLSetSigma_C",MatSELLSetSigma_SeqSELL);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
@@ -1986,7 +1968,7 @@ PetscErrorCode MatDuplicateNoCreate_SeqSELL(Mat C,Mat A,MatDuplicateOption cpval
 {
   Mat_SeqSELL    *c,*a=(Mat_SeqSELL*)A->data;
   PetscInt       i,m=A->rmap->n;
-  PetscInt       totalslices=a->totalslices;
+  PetscInt       totalslices=a->totalslices,npos=a->sliceheight*totalslices;
   PetscErrorCode ierr;
 
   PetscFunctionBegin;
@@ -2003,13 +1985,22 @@ PetscErrorCode MatDuplicateNoCreate_SeqSELL(Mat C,Mat A,MatDuplicateOption cpval
   ierr = PetscLayoutReference(A->rmap,&C->rmap);CHKERRQ(ierr);
   ierr = PetscLayoutReference(A->cmap,&C->cmap);CHKERRQ(ierr);
 
-  ierr = PetscMalloc1(8*totalslices,&c->rlen);CHKERRQ(ierr);
-  ierr = PetscLogObjectMemory((PetscObject)C,m*sizeof(PetscInt));CHKERRQ(ierr);
+  c->sliceheight = a->sliceheight;
+  c->sigma       = a->sigma;
+  c->totalslices = totalslices;
+  ierr = PetscMalloc1(npos,&c->rlen);CHKERRQ(ierr);
+  ierr = PetscLogObjectMemory((PetscObject)C,npos*sizeof(PetscInt));CHKERRQ(ierr);
   ierr = PetscMalloc1(totalslices+1,&c->sliidx);CHKERRQ(ierr);
   ierr = PetscLogObjectMemory((PetscObject)C, (totalslices+1)*sizeof(PetscInt));CHKERRQ(ierr);
 
-  for (i=0; i<m; i++) c->rlen[i] = a->rlen[i];
+  ierr = PetscArraycpy(c->rlen,a->rlen,npos);CHKERRQ(ierr);
   for (i=0; i<totalslices+1; i++) c->sliidx[i] = a->sliidx[i];
+  if (a->rowperm) {
+    ierr = PetscMalloc2(npos,&c->rowperm,npos,&c->irowperm);CHKERRQ(ierr);
+    ierr = PetscLogObjectMemory((PetscObject)C,2*npos*sizeof(PetscInt));CHKERRQ(ierr);
+    ierr = PetscArraycpy(c->rowperm,a->rowperm,npos);CHKERRQ(ierr);
+    ierr = PetscArraycpy(c->irowperm,a->irowperm,npos);CHKERRQ(ierr);
+  }
 
   /* allocate the matrix space */
   if (mallocmatspace) {
@@ -2120,10 +2111,24 @@ PetscErrorCode MatCreateSeqSELL(MPI_Comm comm,PetscInt m,PetscInt n,PetscInt max
   PetscFunctionReturn(0);
 }
 
+/* Checks if the entries of the two matrices are stored at the same places */
+static PetscErrorCode MatSeqSELLSameStorage_Private(Mat A,Mat B,PetscBool *flg)
+{
+  Mat_SeqSELL    *a=(Mat_SeqSELL*)A->data,*b=(Mat_SeqSELL*)B->data;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  *flg = (PetscBool)(A->rmap->n == B->rmap->n && a->sliceheight == b->sliceheight && a->totalslices == b->totalslices && !a->rowperm == !b->rowperm);
+  if (!*flg) PetscFunctionReturn(0);
+  ierr = PetscArraycmp(a->sliidx,b->sliidx,a->totalslices+1,flg);CHKERRQ(ierr);
+  if (*flg && a->rowperm) {ierr = PetscArraycmp(a->rowperm,b->rowperm,a->sliceheight*a->totalslices,flg);CHKERRQ(ierr);}
+  PetscFunctionReturn(0);
+}
+
 PetscErrorCode MatEqual_SeqSELL(Mat A,Mat B,PetscBool * flg)
 {
   Mat_SeqSELL     *a=(Mat_SeqSELL*)A->data,*b=(Mat_SeqSELL*)B->data;
-  PetscInt       totalslices=a->totalslices;
+  PetscInt       totalslices=a->totalslices,i,j,sa,sb;
   PetscErrorCode ierr;
 
   PetscFunctionBegin;
@@ -2132,6 +2137,19 @@ PetscErrorCode MatEqual_SeqSELL(Mat A,Mat B,PetscBool * flg)
     *flg = PETSC_FALSE;
     PetscFunctionReturn(0);
   }
+  ierr = MatSeqSELLSameStorage_Private(A,B,flg);CHKERRQ(ierr);
+  if (!*flg) { /* different slice heights or row orders, compare row by row */
+    for (i=0; i<A->rmap->n; i++) {
+      if (a->rlen[i] != b->rlen[i]) PetscFunctionReturn(0);
+      sa = MatSeqSELLRowShift(a,i);
+      sb = MatSeqSELLRowShift(b,i);
+      for (j=0; j<a->rlen[i]; j++,sa+=a->sliceheight,sb+=b->sliceheight) {
+        if (a->colidx[sa] != b->colidx[sb] || a->val[sa] != b->val[sb]) PetscFunctionReturn(0);
+      }
+    }
+    *flg = PETSC_TRUE;
+    PetscFunctionReturn(0);
+  }
   /* if the a->colidx are the same */
   ierr = PetscArraycmp(a->colidx,b->colidx,a->sliidx[totalslices],flg);CHKERRQ(ierr);
   if (!*flg) PetscFunctionReturn(0);
@@ -37,6 +37,10 @@ Mat         parent;            /* set if this matrix was formed with MatDuplicat
 means that this shares some data structures with the parent including diag, ilen, imax, i, j */ \
 PetscInt    *sliidx;           /* slice index */ \
 PetscInt    totalslices;       /* total number of slices */ \
+PetscInt    sliceheight;       /* number of rows in a slice */ \
+PetscInt    sigma;             /* rows are sorted by length within windows of sigma rows, 1 means no sorting */ \
+PetscInt    *rowperm;          /* local row stored at each position of the slices, NULL if the rows are not sorted */ \
+PetscInt    *irowperm;         /* position in the slices of each local row, NULL if the rows are not sorted */ \
 PetscInt    *getrowcols;       /* workarray for MatGetRow_SeqSELL */ \
 PetscScalar *getrowvals        /* workarray for MatGetRow_SeqSELL */ \
 
@@ -65,11 +69,22 @@ PETSC_STATIC_INLINE PetscErrorCode MatSeqXSELLFreeSELL(Mat AA,MatScalar **val,Pe
   return 0;
 }
 
+#define MAT_SELL_MAX_SLICE_HEIGHT 32
+
+/*
+ Positions in the slices: the row stored at position pos is in slice pos/sliceheight, the entries of the row start at
+ MatSeqSELLShift(a,pos) in val and colidx and are sliceheight apart. Positions past the last row are padding.
+ */
+#define MatSeqSELLRowOfPosition(a,pos) ((a)->rowperm ? (a)->rowperm[pos] : (pos))
+#define MatSeqSELLPositionOfRow(a,row) ((a)->irowperm ? (a)->irowperm[row] : (row))
+#define MatSeqSELLShift(a,pos) ((a)->sliidx[(pos)/(a)->sliceheight]+(pos)%(a)->sliceheight)
+#define MatSeqSELLRowShift(a,row) MatSeqSELLShift(a,MatSeqSELLPositionOfRow(a,row))
+
 #define MatSeqXSELLReallocateSELL(Amat,AM,BS2,WIDTH,SIDX,SID,ROW,COL,COLIDX,VAL,CP,VP,NONEW,datatype) \
-if (WIDTH >= (SIDX[SID+1]-SIDX[SID])/8) { \
+if (WIDTH >= (SIDX[SID+1]-SIDX[SID])/((Mat_SeqSELL*)Amat->data)->sliceheight) { \
 Mat_SeqSELL *Ain = (Mat_SeqSELL*)Amat->data; \
-/* there is no extra room in row, therefore enlarge 8 elements (1 slice column) */ \
-PetscInt new_size=Ain->maxallocmat+8,*new_colidx; \
+/* there is no extra room in row, therefore enlarge sliceheight elements (1 slice column) */ \
+PetscInt new_size=Ain->maxallocmat+Ain->sliceheight,*new_colidx; \
 datatype *new_val; \
 \
 if (NONEW == -2) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"New nonzero at (%D,%D) caused a malloc\nUse MatSetOption(A, MAT_NEW_NONZERO_ALLOCATION_ERR, PETSC_FALSE) to turn off this check",ROW,COL); \
@@ -79,13 +94,13 @@ ierr = PetscMalloc2(BS2*new_size,&new_val,BS2*new_size,&new_colidx);CHKERRQ(ierr
 /* copy over old data into new slots by two steps: one step for data before the current slice and the other for the rest */ \
 ierr = PetscArraycpy(new_val,VAL,SIDX[SID+1]);CHKERRQ(ierr); \
 ierr = PetscArraycpy(new_colidx,COLIDX,SIDX[SID+1]);CHKERRQ(ierr); \
-ierr = PetscArraycpy(new_val+SIDX[SID+1]+8,VAL+SIDX[SID+1],SIDX[AM>>3]-SIDX[SID+1]);CHKERRQ(ierr); \
-ierr = PetscArraycpy(new_colidx+SIDX[SID+1]+8,COLIDX+SIDX[SID+1],SIDX[AM>>3]-SIDX[SID+1]);CHKERRQ(ierr); \
+ierr = PetscArraycpy(new_val+SIDX[SID+1]+Ain->sliceheight,VAL+SIDX[SID+1],SIDX[Ain->totalslices]-SIDX[SID+1]);CHKERRQ(ierr); \
+ierr = PetscArraycpy(new_colidx+SIDX[SID+1]+Ain->sliceheight,COLIDX+SIDX[SID+1],SIDX[Ain->totalslices]-SIDX[SID+1]);CHKERRQ(ierr); \
 /* update slice_idx */ \
-for (ii=SID+1;ii<=AM>>3;ii++) { SIDX[ii] += 8; } \
+for (ii=SID+1;ii<=Ain->totalslices;ii++) { SIDX[ii] += Ain->sliceheight; } \
 /* update pointers. Notice that they point to the FIRST postion of the row */ \
-CP = new_colidx+SIDX[SID]+(ROW & 0x07); \
-VP = new_val+SIDX[SID]+(ROW & 0x07); \
+CP = new_colidx+(CP-COLIDX); \
+VP = new_val+(VP-VAL); \
 /* free up old matrix storage */ \
 ierr              = MatSeqXSELLFreeSELL(A,&Ain->val,&Ain->colidx);CHKERRQ(ierr); \
 Ain->val          = (MatScalar*) new_val; \
@@ -100,43 +115,44 @@ if (WIDTH>=Ain->rlenmax) Ain->rlenmax++; \
 #define MatSetValue_SeqSELL_Private(A,row,col,value,addv,orow,ocol,cp,vp,lastcol,low,high) \
 { \
   Mat_SeqSELL  *a=(Mat_SeqSELL*)A->data; \
+  PetscInt     sh=a->sliceheight,sid=MatSeqSELLPositionOfRow(a,row)/sh; \
   found=PETSC_FALSE; \
   if (col <= lastcol) low = 0; \
   else high = a->rlen[row]; \
   lastcol = col; \
   while (high-low > 5) { \
     t = (low+high)/2; \
-    if (*(cp+8*t) > col) high = t; \
+    if (*(cp+sh*t) > col) high = t; \
     else low = t; \
   } \
   for (_i=low; _i<high; _i++) { \
-    if (*(cp+8*_i) > col) break; \
-    if (*(cp+8*_i) == col) { \
-      if (addv == ADD_VALUES)*(vp+8*_i) += value; \
-      else *(vp+8*_i) = value; \
+    if (*(cp+sh*_i) > col) break; \
+    if (*(cp+sh*_i) == col) { \
+      if (addv == ADD_VALUES)*(vp+sh*_i) += value; \
+      else *(vp+sh*_i) = value; \
       found = PETSC_TRUE; \
       break; \
     } \
   } \
   if (!found) { \
     if (a->nonew == -1) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"Inserting a new nonzero at global row/column (%D, %D) into matrix", orow, ocol); \
-    if (a->nonew != 1 && !(value == 0.0 && a->ignorezeroentries) && a->rlen[row] >= (a->sliidx[row/8+1]-a->sliidx[row/8])/8) { \
-      /* there is no extra room in row, therefore enlarge 8 elements (1 slice column) */ \
-      if (a->maxallocmat < a->sliidx[a->totalslices]+8) { \
+    if (a->nonew != 1 && !(value == 0.0 && a->ignorezeroentries) && a->rlen[row] >= (a->sliidx[sid+1]-a->sliidx[sid])/sh) { \
+      /* there is no extra room in row, therefore enlarge sliceheight elements (1 slice column) */ \
+      if (a->maxallocmat < a->sliidx[a->totalslices]+sh) { \
         /* allocates a larger array for the XSELL matrix types; only extend the current slice by one more column. */ \
-        PetscInt  new_size=a->maxallocmat+8,*new_colidx; \
+        PetscInt  new_size=a->maxallocmat+sh,*new_colidx; \
         MatScalar *new_val; \
         if (a->nonew == -2) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"New nonzero at (%D,%D) caused a malloc\nUse MatSetOption(A, MAT_NEW_NONZERO_ALLOCATION_ERR, PETSC_FALSE) to turn off this check",orow,ocol); \
         /* malloc new storage space */ \
         ierr = PetscMalloc2(new_size,&new_val,new_size,&new_colidx);CHKERRQ(ierr); \
         /* copy over old data into new slots by two steps: one step for data before the current slice and the other for the rest */ \
-        ierr = PetscArraycpy(new_val,a->val,a->sliidx[row/8+1]);CHKERRQ(ierr); \
-        ierr = PetscArraycpy(new_colidx,a->colidx,a->sliidx[row/8+1]);CHKERRQ(ierr); \
-        ierr = PetscArraycpy(new_val+a->sliidx[row/8+1]+8,a->val+a->sliidx[row/8+1],a->sliidx[a->totalslices]-a->sliidx[row/8+1]);CHKERRQ(ierr);  \
-        ierr = PetscArraycpy(new_colidx+a->sliidx[row/8+1]+8,a->colidx+a->sliidx[row/8+1],a->sliidx[a->totalslices]-a->sliidx[row/8+1]);CHKERRQ(ierr); \
+        ierr = PetscArraycpy(new_val,a->val,a->sliidx[sid+1]);CHKERRQ(ierr); \
+        ierr = PetscArraycpy(new_colidx,a->colidx,a->sliidx[sid+1]);CHKERRQ(ierr); \
+        ierr = PetscArraycpy(new_val+a->sliidx[sid+1]+sh,a->val+a->sliidx[sid+1],a->sliidx[a->totalslices]-a->sliidx[sid+1]);CHKERRQ(ierr);  \
+        ierr = PetscArraycpy(new_colidx+a->sliidx[sid+1]+sh,a->colidx+a->sliidx[sid+1],a->sliidx[a->totalslices]-a->sliidx[sid+1]);CHKERRQ(ierr); \
         /* update pointers. Notice that they point to the FIRST postion of the row */ \
-        cp = new_colidx+a->sliidx[row/8]+(row & 0x07); \
-        vp = new_val+a->sliidx[row/8]+(row & 0x07); \
+        cp = new_colidx+(cp-a->colidx); \
+        vp = new_val+(vp-a->val); \
         /* free up old matrix storage */ \
         ierr            = MatSeqXSELLFreeSELL(A,&a->val,&a->colidx);CHKERRQ(ierr); \
         a->val          = (MatScalar*)new_val; \
@@ -146,21 +162,21 @@ if (WIDTH>=Ain->rlenmax) Ain->rlenmax++; \
         a->reallocs++; \
       } else { \
         /* no need to reallocate, just shift the following slices to create space for the added slice column */ \
-        ierr = PetscArraymove(a->val+a->sliidx[row/8+1]+8,a->val+a->sliidx[row/8+1],a->sliidx[a->totalslices]-a->sliidx[row/8+1]);CHKERRQ(ierr);  \
-        ierr = PetscArraymove(a->colidx+a->sliidx[row/8+1]+8,a->colidx+a->sliidx[row/8+1],a->sliidx[a->totalslices]-a->sliidx[row/8+1]);CHKERRQ(ierr); \
+        ierr = PetscArraymove(a->val+a->sliidx[sid+1]+sh,a->val+a->sliidx[sid+1],a->sliidx[a->totalslices]-a->sliidx[sid+1]);CHKERRQ(ierr);  \
+        ierr = PetscArraymove(a->colidx+a->sliidx[sid+1]+sh,a->colidx+a->sliidx[sid+1],a->sliidx[a->totalslices]-a->sliidx[sid+1]);CHKERRQ(ierr); \
       } \
       /* update slice_idx */ \
-      for (ii=row/8+1;ii<=a->totalslices;ii++) a->sliidx[ii] += 8; \
+      for (ii=sid+1;ii<=a->totalslices;ii++) a->sliidx[ii] += sh; \
       if (a->rlen[row]>=a->maxallocrow) a->maxallocrow++; \
       if (a->rlen[row]>=a->rlenmax) a->rlenmax++; \
     } \
     /* shift up all the later entries in this row */ \
     for (ii=a->rlen[row]-1; ii>=_i; ii--) { \
-      *(cp+8*(ii+1)) = *(cp+8*ii); \
-      *(vp+8*(ii+1)) = *(vp+8*ii); \
+      *(cp+sh*(ii+1)) = *(cp+sh*ii); \
+      *(vp+sh*(ii+1)) = *(vp+sh*ii); \
     } \
-    *(cp+8*_i) = col; \
-    *(vp+8*_i) = value; \
+    *(cp+sh*_i) = col; \
+    *(vp+sh*_i) = value; \
     a->nz++; a->rlen[row]++; A->nonzerostate++; \
     low = _i+1; high++; \
   } \
@@ -202,4 +218,7 @@ PETSC_INTERN PetscErrorCode MatRestoreColumnIJ_SeqSELL_Color(Mat,PetscInt,PetscB
 PETSC_INTERN PetscErrorCode MatConjugate_SeqSELL(Mat A);
 PETSC_INTERN PetscErrorCode MatScale_SeqSELL(Mat,PetscScalar);
 PETSC_INTERN PetscErrorCode MatDiagonalScale_SeqSELL(Mat,Vec,Vec);
+PETSC_INTERN PetscErrorCode MatSetFromOptions_SeqSELL(PetscOptionItems*,Mat);
+PETSC_INTERN PetscErrorCode MatSELLSetSliceHeight_SeqSELL(Mat,PetscInt);
+PETSC_INTERN PetscErrorCode MatSELLSetSigma_SeqSELL(Mat,PetscInt);
 #endif
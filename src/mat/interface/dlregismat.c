@@ -28,6 +28,8 @@ const char       *MatOptions_Shifted[] = {"UNUSED_NONZERO_LOCATION_ERR",
                                   "STRUCTURE_ONLY",
                                   "SORTED_FULL",
                                   "FORM_EXPLICIT_TRANSPOSE",
+                                  "AUTOTUNE_MULT",
+                                  "SOR_MULTICOLOR",
                                   "MatOption","MAT_",NULL};
 const char *const* MatOptions = MatOptions_Shifted+2;
 const char *const MatFactorShiftTypes[] = {"NONE","NONZERO","POSITIVE_DEFINITE","INBLOCKS","MatFactorShiftType","PC_FACTOR_",NULL};
@@ -135,6 +137,7 @@ PETSC_EXTERN PetscErrorCode MatSolverTypeRegister_Lusol(void);
 #endif
 
 PETSC_INTERN PetscErrorCode MatGetFactor_seqaij_petsc(Mat,MatFactorType,Mat*);
+PETSC_INTERN PetscErrorCode MatGetFactor_seqaijsingle_petsc(Mat,MatFactorType,Mat*);
 PETSC_INTERN PetscErrorCode MatGetFactor_seqbaij_petsc(Mat,MatFactorType,Mat*);
 PETSC_INTERN PetscErrorCode MatGetFactor_seqsbaij_petsc(Mat,MatFactorType,Mat*);
 PETSC_INTERN PetscErrorCode MatGetFactor_seqdense_petsc(Mat,MatFactorType,Mat*);
@@ -143,6 +146,7 @@ PETSC_INTERN PetscErrorCode MatGetFactor_seqdense_cuda(Mat,MatFactorType,Mat*);
 #endif
 PETSC_INTERN PetscErrorCode MatGetFactor_constantdiagonal_petsc(Mat,MatFactorType,Mat*);
 PETSC_INTERN PetscErrorCode MatGetFactor_seqaij_bas(Mat,MatFactorType,Mat*);
+PETSC_INTERN PetscErrorCode MatGetFactor_seqaij_chowilu(Mat,MatFactorType,Mat*);
 
 /*@C
   MatInitializePackage - This function initializes everything in the Mat package. It is called
@@ -323,7 +327,12 @@ PetscErrorCode  MatInitializePackage(void)
     if (pkg) {ierr = PetscLogEventExcludeClass(MAT_NULLSPACE_CLASSID);CHKERRQ(ierr);}
   }
 
-  /* Register the PETSc built in factorization based solvers */
+  /* Register the PETSc built in factorization based solvers, MATSEQAIJSINGLE first since the matrix types are matched by prefix */
+  ierr = MatSolverTypeRegister(MATSOLVERPETSC, MATSEQAIJSINGLE,  MAT_FACTOR_LU,MatGetFactor_seqaijsingle_petsc);CHKERRQ(ierr);
+  ierr = MatSolverTypeRegister(MATSOLVERPETSC, MATSEQAIJSINGLE,  MAT_FACTOR_CHOLESKY,MatGetFactor_seqaij_petsc);CHKERRQ(ierr);
+  ierr = MatSolverTypeRegister(MATSOLVERPETSC, MATSEQAIJSINGLE,  MAT_FACTOR_ILU,MatGetFactor_seqaijsingle_petsc);CHKERRQ(ierr);
+  ierr = MatSolverTypeRegister(MATSOLVERPETSC, MATSEQAIJSINGLE,  MAT_FACTOR_ICC,MatGetFactor_seqaij_petsc);CHKERRQ(ierr);
+
   ierr = MatSolverTypeRegister(MATSOLVERPETSC, MATSEQAIJ,        MAT_FACTOR_LU,MatGetFactor_seqaij_petsc);CHKERRQ(ierr);
   ierr = MatSolverTypeRegister(MATSOLVERPETSC, MATSEQAIJ,        MAT_FACTOR_CHOLESKY,MatGetFactor_seqaij_petsc);CHKERRQ(ierr);
   ierr = MatSolverTypeRegister(MATSOLVERPETSC, MATSEQAIJ,        MAT_FACTOR_ILU,MatGetFactor_seqaij_petsc);CHKERRQ(ierr);
@@ -378,6 +387,7 @@ PetscErrorCode  MatInitializePackage(void)
 #endif
 
   ierr = MatSolverTypeRegister(MATSOLVERBAS,   MATSEQAIJ,        MAT_FACTOR_ICC,MatGetFactor_seqaij_bas);CHKERRQ(ierr);
+  ierr = MatSolverTypeRegister(MATSOLVERCHOWILU,MATSEQAIJ,       MAT_FACTOR_ILU,MatGetFactor_seqaij_chowilu);CHKERRQ(ierr);
 
   /*
      Register the external package factorization based solvers
@@ -43,6 +43,7 @@ PETSC_EXTERN PetscErrorCode MatCreate_MPIBAIJMKL(Mat);
 #endif
 
 PETSC_EXTERN PetscErrorCode MatCreate_SeqAIJCRL(Mat);
+PETSC_EXTERN PetscErrorCode MatCreate_SeqAIJSingle(Mat);
 PETSC_EXTERN PetscErrorCode MatCreate_MPIAIJCRL(Mat);
 
 PETSC_EXTERN PetscErrorCode MatCreate_Scatter(Mat);
@@ -152,6 +153,7 @@ PetscErrorCode  MatRegisterAll(void)
   ierr = MatRegisterRootName(MATAIJCRL,MATSEQAIJCRL,MATMPIAIJCRL);CHKERRQ(ierr);
   ierr = MatRegister(MATSEQAIJCRL,      MatCreate_SeqAIJCRL);CHKERRQ(ierr);
   ierr = MatRegister(MATMPIAIJCRL,      MatCreate_MPIAIJCRL);CHKERRQ(ierr);
+  ierr = MatRegister(MATSEQAIJSINGLE,   MatCreate_SeqAIJSingle);CHKERRQ(ierr);
 
   ierr = MatRegisterRootName(MATBAIJ,MATSEQBAIJ,MATMPIBAIJ);CHKERRQ(ierr);
   ierr = MatRegister(MATMPIBAIJ,        MatCreate_MPIBAIJ);CHKERRQ(ierr);
@@ -1348,6 +1348,10 @@ PetscErrorCode MatDestroy(Mat *A)
    with homogeneous Dirchlet boundary conditions that you don't want represented
    in the matrix.
 
+   With PETSc configured --with-openmp --with-threadsafety, threads of an OpenMP parallel region may
+   concurrently set values in rows owned by other processes of MATMPIAIJ matrices: each thread stashes
+   them in its own buffers, which are merged and sorted with threads in MatAssemblyBegin().
+
    Efficiency Alert:
    The routine MatSetValuesBlocked() may offer much better efficiency
    for users of block sparse formats (MATSEQBAIJ and MATMPIBAIJ).
@@ -5827,6 +5831,16 @@ PetscErrorCode MatAssemblyEnd(Mat mat,MatAssemblyType type)
                      single call to MatSetValues(), preallocation is perfect, row oriented, INSERT_VALUES is used. Common
                      with finite difference schemes with non-periodic boundary conditions.
 
+   MAT_AUTOTUNE_MULT - for AIJ matrices, time the available MatMult() kernels (CSR, I-node, SELL, and permuted) on the nonzero
+                     pattern at the end of MatAssemblyEnd() and use the fastest for MatMult() and MatMultAdd(). The choice is
+                     kept until the nonzero pattern changes and is reported by MatView() with PETSC_VIEWER_ASCII_INFO. The number of
+                     timed products per kernel can be set with -mat_autotune_mult_its <10>
+
+   MAT_SOR_MULTICOLOR - for AIJ matrices, MatSOR() colors the rows (of the diagonal block) with MatColoring so that the
+                     rows of one color do not depend on each other, and sweeps the colors one after the other with the rows
+                     of each color relaxed in parallel by OpenMP threads. The coloring is kept until the nonzero pattern
+                     changes, its type can be set with -mat_coloring_type <greedy>
+
    Level: intermediate
 
 .seealso:  MatOption, Mat
@@ -286,6 +286,18 @@ int main(int argc,char **argv)
       nsize: 4
       args: -m 6 -n 6 -stencil 2d5point -matmatmult_via seqmpi
 
+ test:
+      suffix: hash_omp
+      nsize: 1
+      args: -m 8 -n 8 -stencil 2d5point -matmatmult_via hash_omp -matptap_via hash_omp
+      output_file: output/ex226_1.out
+
+ test:
+      suffix: hash_omp_3d
+      nsize: 1
+      args: -m 5 -n 5 -o 5 -stencil 3d27point -matmatmult_via hash_omp -matptap_via hash_omp
+      output_file: output/ex226_2.out
+
 
 
 TEST*/
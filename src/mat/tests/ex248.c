@@ -0,0 +1,134 @@
+static char help[] = "Tests MatMult() kernel autotuning with MAT_AUTOTUNE_MULT for AIJ matrices.\n\n";
+
+#include <petscmat.h>
+
+/* Assembles the 2d 5-point Laplacian with dof fully coupled unknowns per grid point (so I-nodes are found), scaled by s */
+static PetscErrorCode AssembleLaplacian(Mat A,PetscInt n,PetscInt dof,PetscScalar s)
+{
+  PetscErrorCode ierr;
+  PetscInt       Istart,Iend,II,i,j,c,d,k,node,col[5];
+  PetscScalar    v[5];
+
+  PetscFunctionBeginUser;
+  ierr = MatGetOwnershipRange(A,&Istart,&Iend);CHKERRQ(ierr);
+  for (II=Istart; II<Iend; II++) {
+    node = II/dof; i = node/n; j = node%n; c = II%dof; k = 0;
+    if (i>0)   {col[k] = node-n; v[k++] = -s;}
+    if (j>0)   {col[k] = node-1; v[k++] = -s;}
+    col[k] = node; v[k++] = 4.0*s;
+    if (j<n-1) {col[k] = node+1; v[k++] = -s;}
+    if (i<n-1) {col[k] = node+n; v[k++] = -s;}
+    for (; k>0; k--) {
+      for (d=0; d<dof; d++) {
+        ierr = MatSetValue(A,II,col[k-1]*dof+d,d == c ? v[k-1] : 0.1*v[k-1],INSERT_VALUES);CHKERRQ(ierr);
+      }
+    }
+  }
+  ierr = MatAssemblyBegin(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode CheckMult(Mat A,Mat B,Vec x,const char *stage)
+{
+  PetscErrorCode ierr;
+  Vec            y,z;
+  PetscReal      norm;
+
+  PetscFunctionBeginUser;
+  ierr = MatCreateVecs(A,NULL,&y);CHKERRQ(ierr);
+  ierr = VecDuplicate(y,&z);CHKERRQ(ierr);
+  ierr = MatMult(A,x,y);CHKERRQ(ierr);
+  ierr = MatMult(B,x,z);CHKERRQ(ierr);
+  ierr = VecAXPY(z,-1.0,y);CHKERRQ(ierr);
+  ierr = VecNorm(z,NORM_2,&norm);CHKERRQ(ierr);
+  if (norm > PETSC_SMALL) {ierr = PetscPrintf(PETSC_COMM_WORLD,"%s: MatMult() error %g\n",stage,(double)norm);CHKERRQ(ierr);}
+  ierr = VecSet(z,1.0);CHKERRQ(ierr);
+  ierr = VecCopy(z,y);CHKERRQ(ierr);
+  ierr = MatMultAdd(A,x,y,y);CHKERRQ(ierr);
+  ierr = MatMultAdd(B,x,z,z);CHKERRQ(ierr);
+  ierr = VecAXPY(z,-1.0,y);CHKERRQ(ierr);
+  ierr = VecNorm(z,NORM_2,&norm);CHKERRQ(ierr);
+  if (norm > PETSC_SMALL) {ierr = PetscPrintf(PETSC_COMM_WORLD,"%s: MatMultAdd() error %g\n",stage,(double)norm);CHKERRQ(ierr);}
+  ierr = VecDestroy(&y);CHKERRQ(ierr);
+  ierr = VecDestroy(&z);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+int main(int argc,char **args)
+{
+  Mat            A,B,C;
+  Vec            x;
+  PetscInt       n = 20,dof = 3,N;
+  PetscRandom    rand;
+  PetscErrorCode ierr;
+
+  ierr = PetscInitialize(&argc,&args,(char*)0,help);if (ierr) return ierr;
+  ierr = PetscOptionsGetInt(NULL,NULL,"-n",&n,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,NULL,"-dof",&dof,NULL);CHKERRQ(ierr);
+  N    = n*n*dof;
+
+  /* A uses the autotuned kernels, B is the reference */
+  ierr = MatCreate(PETSC_COMM_WORLD,&A);CHKERRQ(ierr);
+  ierr = MatSetSizes(A,PETSC_DECIDE,PETSC_DECIDE,N,N);CHKERRQ(ierr);
+  ierr = MatSetType(A,MATAIJ);CHKERRQ(ierr);
+  ierr = MatSetFromOptions(A);CHKERRQ(ierr);
+  ierr = MatSeqAIJSetPreallocation(A,5*dof,NULL);CHKERRQ(ierr);
+  ierr = MatMPIAIJSetPreallocation(A,5*dof,NULL,dof,NULL);CHKERRQ(ierr);
+  ierr = MatSetOption(A,MAT_AUTOTUNE_MULT,PETSC_TRUE);CHKERRQ(ierr);
+  ierr = MatCreate(PETSC_COMM_WORLD,&B);CHKERRQ(ierr);
+  ierr = MatSetSizes(B,PETSC_DECIDE,PETSC_DECIDE,N,N);CHKERRQ(ierr);
+  ierr = MatSetType(B,MATAIJ);CHKERRQ(ierr);
+  ierr = MatSeqAIJSetPreallocation(B,5*dof,NULL);CHKERRQ(ierr);
+  ierr = MatMPIAIJSetPreallocation(B,5*dof,NULL,dof,NULL);CHKERRQ(ierr);
+
+  ierr = PetscRandomCreate(PETSC_COMM_WORLD,&rand);CHKERRQ(ierr);
+  ierr = PetscRandomSetFromOptions(rand);CHKERRQ(ierr);
+  ierr = MatCreateVecs(A,&x,NULL);CHKERRQ(ierr);
+  ierr = VecSetRandom(x,rand);CHKERRQ(ierr);
+
+  ierr = AssembleLaplacian(A,n,dof,1.0);CHKERRQ(ierr);
+  ierr = AssembleLaplacian(B,n,dof,1.0);CHKERRQ(ierr);
+  ierr = CheckMult(A,B,x,"First assembly");CHKERRQ(ierr);
+  ierr = PetscViewerPushFormat(PETSC_VIEWER_STDOUT_WORLD,PETSC_VIEWER_ASCII_INFO);CHKERRQ(ierr);
+  ierr = MatView(A,PETSC_VIEWER_STDOUT_WORLD);CHKERRQ(ierr);
+  ierr = PetscViewerPopFormat(PETSC_VIEWER_STDOUT_WORLD);CHKERRQ(ierr);
+
+  /* same nonzero pattern, new values: the kernel selected above is reused */
+  ierr = AssembleLaplacian(A,n,dof,2.0);CHKERRQ(ierr);
+  ierr = AssembleLaplacian(B,n,dof,2.0);CHKERRQ(ierr);
+  ierr = CheckMult(A,B,x,"Second assembly");CHKERRQ(ierr);
+
+  ierr = MatDuplicate(A,MAT_COPY_VALUES,&C);CHKERRQ(ierr);
+  ierr = CheckMult(C,B,x,"Duplicate");CHKERRQ(ierr);
+  ierr = MatScale(C,0.5);CHKERRQ(ierr);
+  ierr = MatScale(B,0.5);CHKERRQ(ierr);
+  ierr = CheckMult(C,B,x,"Scaled duplicate");CHKERRQ(ierr);
+
+  ierr = MatSetOption(A,MAT_AUTOTUNE_MULT,PETSC_FALSE);CHKERRQ(ierr);
+  ierr = MatScale(A,0.5);CHKERRQ(ierr);
+  ierr = CheckMult(A,B,x,"Autotuning turned off");CHKERRQ(ierr);
+
+  ierr = PetscRandomDestroy(&rand);CHKERRQ(ierr);
+  ierr = VecDestroy(&x);CHKERRQ(ierr);
+  ierr = MatDestroy(&A);CHKERRQ(ierr);
+  ierr = MatDestroy(&B);CHKERRQ(ierr);
+  ierr = MatDestroy(&C);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+   test:
+      suffix: 1
+      args: -dof {{1 3}separate output}
+      filter: sed -e "s/using [a-z]* kernel/using KERNEL kernel/g"
+
+   test:
+      suffix: 2
+      nsize: 2
+      args: -dof 3
+      filter: sed -e "s/ block [a-z]\{1,\}/ block KERNEL/g"
+
+TEST*/
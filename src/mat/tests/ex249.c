@@ -0,0 +1,105 @@
+static char help[] = "Tests the products of SELL matrices with different slice heights and row sorting windows.\n\n";
+
+#include <petscmat.h>
+
+/* Row i has a varying number of entries so that sorting the rows by length removes padding */
+static PetscInt RowLength(PetscInt i,PetscInt N)
+{
+  return PetscMin(1+(i*7)%11,N);
+}
+
+static PetscInt ColumnOfEntry(PetscInt i,PetscInt k,PetscInt N)
+{
+  return (i+k*13)%N;
+}
+
+int main(int argc,char **args)
+{
+  Mat            A,B,C;
+  PetscInt       N = 101,i,k,rstart,rend,cstart,cend,col,*d_nnz,*o_nnz;
+  PetscScalar    v;
+  PetscBool      flg;
+  PetscErrorCode ierr;
+
+  ierr = PetscInitialize(&argc,&args,(char*)0,help);if (ierr) return ierr;
+  ierr = PetscOptionsGetInt(NULL,NULL,"-N",&N,NULL);CHKERRQ(ierr);
+
+  /* A is the AIJ reference, B has the same entries in SELL format */
+  ierr = MatCreate(PETSC_COMM_WORLD,&A);CHKERRQ(ierr);
+  ierr = MatSetSizes(A,PETSC_DECIDE,PETSC_DECIDE,N,N);CHKERRQ(ierr);
+  ierr = MatSetType(A,MATAIJ);CHKERRQ(ierr);
+  ierr = MatSetUp(A);CHKERRQ(ierr);
+  ierr = MatGetOwnershipRange(A,&rstart,&rend);CHKERRQ(ierr);
+  ierr = MatGetOwnershipRangeColumn(A,&cstart,&cend);CHKERRQ(ierr);
+
+  ierr = MatCreate(PETSC_COMM_WORLD,&B);CHKERRQ(ierr);
+  ierr = MatSetSizes(B,rend-rstart,cend-cstart,N,N);CHKERRQ(ierr);
+  ierr = MatSetType(B,MATSELL);CHKERRQ(ierr);
+  ierr = MatSetFromOptions(B);CHKERRQ(ierr);
+  ierr = PetscCalloc2(rend-rstart,&d_nnz,rend-rstart,&o_nnz);CHKERRQ(ierr);
+  for (i=rstart; i<rend; i++) {
+    for (k=0; k<RowLength(i,N); k++) {
+      col = ColumnOfEntry(i,k,N);
+      if (col >= cstart && col < cend) d_nnz[i-rstart]++;
+      else o_nnz[i-rstart]++;
+    }
+  }
+  ierr = MatSeqSELLSetPreallocation(B,0,d_nnz);CHKERRQ(ierr);
+  ierr = MatMPISELLSetPreallocation(B,0,d_nnz,0,o_nnz);CHKERRQ(ierr);
+  ierr = PetscFree2(d_nnz,o_nnz);CHKERRQ(ierr);
+
+  for (i=rstart; i<rend; i++) {
+    for (k=0; k<RowLength(i,N); k++) {
+      col  = ColumnOfEntry(i,k,N);
+      v    = 1.0+i+0.5*col;
+      ierr = MatSetValues(A,1,&i,1,&col,&v,INSERT_VALUES);CHKERRQ(ierr);
+      ierr = MatSetValues(B,1,&i,1,&col,&v,INSERT_VALUES);CHKERRQ(ierr);
+    }
+  }
+  ierr = MatAssemblyBegin(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyBegin(B,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(B,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+
+  ierr = MatMultEqual(A,B,3,&flg);CHKERRQ(ierr);
+  if (!flg) {ierr = PetscPrintf(PETSC_COMM_WORLD,"MatMult() differs\n");CHKERRQ(ierr);}
+  ierr = MatMultAddEqual(A,B,3,&flg);CHKERRQ(ierr);
+  if (!flg) {ierr = PetscPrintf(PETSC_COMM_WORLD,"MatMultAdd() differs\n");CHKERRQ(ierr);}
+  ierr = MatMultTransposeEqual(A,B,3,&flg);CHKERRQ(ierr);
+  if (!flg) {ierr = PetscPrintf(PETSC_COMM_WORLD,"MatMultTranspose() differs\n");CHKERRQ(ierr);}
+  ierr = MatMultTransposeAddEqual(A,B,3,&flg);CHKERRQ(ierr);
+  if (!flg) {ierr = PetscPrintf(PETSC_COMM_WORLD,"MatMultTransposeAdd() differs\n");CHKERRQ(ierr);}
+
+  /* the duplicate keeps the slice height and the row order */
+  ierr = MatDuplicate(B,MAT_COPY_VALUES,&C);CHKERRQ(ierr);
+  ierr = MatMultEqual(A,C,3,&flg);CHKERRQ(ierr);
+  if (!flg) {ierr = PetscPrintf(PETSC_COMM_WORLD,"MatMult() of the duplicate differs\n");CHKERRQ(ierr);}
+  ierr = MatEqual(B,C,&flg);CHKERRQ(ierr);
+  if (!flg) {ierr = PetscPrintf(PETSC_COMM_WORLD,"The duplicate differs\n");CHKERRQ(ierr);}
+
+  /* the rows are reached through the permutation */
+  ierr = MatConvert(B,MATAIJ,MAT_INPLACE_MATRIX,&B);CHKERRQ(ierr);
+  ierr = MatEqual(A,B,&flg);CHKERRQ(ierr);
+  if (!flg) {ierr = PetscPrintf(PETSC_COMM_WORLD,"MatConvert() differs\n");CHKERRQ(ierr);}
+
+  ierr = MatDestroy(&A);CHKERRQ(ierr);
+  ierr = MatDestroy(&B);CHKERRQ(ierr);
+  ierr = MatDestroy(&C);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+   test:
+      suffix: 1
+      args: -mat_sell_slice_height {{4 8 16 32}} -mat_sell_sigma {{1 16 128}}
+      output_file: output/ex249_1.out
+
+   test:
+      suffix: 2
+      nsize: 2
+      args: -mat_sell_slice_height {{4 16}} -mat_sell_sigma {{1 32}}
+      output_file: output/ex249_1.out
+
+TEST*/
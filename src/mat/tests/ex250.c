@@ -0,0 +1,78 @@
+static char help[] = "Tests MatMatMult() of AIJ and dense matrices with many columns.\n\n";
+
+#include <petscmat.h>
+
+int main(int argc,char **args)
+{
+  Mat            A,B,C;
+  PetscInt       m = 53,n = 37,k = 4,lda = 0,i,j,rstart,rend,cstart,cend,col;
+  PetscScalar    v;
+  PetscRandom    rand;
+  PetscBool      flg;
+  PetscErrorCode ierr;
+
+  ierr = PetscInitialize(&argc,&args,(char*)0,help);if (ierr) return ierr;
+  ierr = PetscOptionsGetInt(NULL,NULL,"-m",&m,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,NULL,"-n",&n,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,NULL,"-k",&k,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,NULL,"-lda",&lda,NULL);CHKERRQ(ierr);
+
+  /* rectangular A with rows of different lengths */
+  ierr = MatCreate(PETSC_COMM_WORLD,&A);CHKERRQ(ierr);
+  ierr = MatSetSizes(A,PETSC_DECIDE,PETSC_DECIDE,m,n);CHKERRQ(ierr);
+  ierr = MatSetType(A,MATAIJ);CHKERRQ(ierr);
+  ierr = MatSetFromOptions(A);CHKERRQ(ierr);
+  ierr = MatSetUp(A);CHKERRQ(ierr);
+  ierr = MatGetOwnershipRange(A,&rstart,&rend);CHKERRQ(ierr);
+  ierr = MatGetOwnershipRangeColumn(A,&cstart,&cend);CHKERRQ(ierr);
+  for (i=rstart; i<rend; i++) {
+    for (j=0; j<1+(i*5)%9; j++) {
+      col  = (i+j*11)%n;
+      v    = 1.0+0.1*i-0.3*col;
+      ierr = MatSetValues(A,1,&i,1,&col,&v,INSERT_VALUES);CHKERRQ(ierr);
+    }
+  }
+  ierr = MatAssemblyBegin(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+
+  ierr = MatCreate(PETSC_COMM_WORLD,&B);CHKERRQ(ierr);
+  ierr = MatSetSizes(B,cend-cstart,PETSC_DECIDE,n,k);CHKERRQ(ierr);
+  ierr = MatSetType(B,MATDENSE);CHKERRQ(ierr);
+  if (lda) {ierr = MatDenseSetLDA(B,cend-cstart+lda);CHKERRQ(ierr);}
+  ierr = MatSetUp(B);CHKERRQ(ierr);
+  ierr = PetscRandomCreate(PETSC_COMM_WORLD,&rand);CHKERRQ(ierr);
+  ierr = PetscRandomSetFromOptions(rand);CHKERRQ(ierr);
+  ierr = MatSetRandom(B,rand);CHKERRQ(ierr);
+
+  ierr = MatMatMult(A,B,MAT_INITIAL_MATRIX,PETSC_DEFAULT,&C);CHKERRQ(ierr);
+  ierr = MatMatMultEqual(A,B,C,5,&flg);CHKERRQ(ierr);
+  if (!flg) {ierr = PetscPrintf(PETSC_COMM_WORLD,"MatMatMult() with MAT_INITIAL_MATRIX differs\n");CHKERRQ(ierr);}
+
+  /* new values in B, same C */
+  ierr = MatSetRandom(B,rand);CHKERRQ(ierr);
+  ierr = MatMatMult(A,B,MAT_REUSE_MATRIX,PETSC_DEFAULT,&C);CHKERRQ(ierr);
+  ierr = MatMatMultEqual(A,B,C,5,&flg);CHKERRQ(ierr);
+  if (!flg) {ierr = PetscPrintf(PETSC_COMM_WORLD,"MatMatMult() with MAT_REUSE_MATRIX differs\n");CHKERRQ(ierr);}
+
+  ierr = PetscRandomDestroy(&rand);CHKERRQ(ierr);
+  ierr = MatDestroy(&A);CHKERRQ(ierr);
+  ierr = MatDestroy(&B);CHKERRQ(ierr);
+  ierr = MatDestroy(&C);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+   test:
+      suffix: 1
+      args: -k {{1 2 3 4 5 8 13 16 17 35}} -lda {{0 3}}
+      output_file: output/ex250_1.out
+
+   test:
+      suffix: 2
+      nsize: 2
+      args: -k {{2 16 35}}
+      output_file: output/ex250_1.out
+
+TEST*/
@@ -0,0 +1,108 @@
+static char help[] = "Benchmarks assembly of off-process matrix entries stashed by several OpenMP threads.\n\n";
+
+/*
+  Each process adds -nel element matrices of size k x k of ones to rows owned by the next process, so that all values
+  go through the stash. With OpenMP and thread safety, the elements are added in a parallel loop by 1,2,4,... up to
+  -max_threads threads, each thread stashing in its own buffers, and -report prints the assembly throughput.
+
+  Usage: mpiexec -n 2 ./ex251 -nel 1000000 -max_threads 64 -report
+*/
+#include <petscmat.h>
+#include <petsctime.h>
+#if defined(PETSC_HAVE_OPENMP) && defined(PETSC_HAVE_THREADSAFETY)
+#include <omp.h>
+#endif
+
+int main(int argc,char **args)
+{
+  Mat            A;
+  Vec            x,y;
+  PetscInt       n = 1000,k = 4,nel = 10000,maxthreads = 1,nthreads,e,rstart,nwrong = 0;
+  PetscMPIInt    rank,size;
+  PetscScalar    sum;
+  PetscBool      report = PETSC_FALSE;
+  PetscLogDouble tinsert,tassembly;
+  PetscErrorCode ierr;
+
+  ierr = PetscInitialize(&argc,&args,(char*)0,help);if (ierr) return ierr;
+  ierr = MPI_Comm_rank(PETSC_COMM_WORLD,&rank);CHKERRMPI(ierr);
+  ierr = MPI_Comm_size(PETSC_COMM_WORLD,&size);CHKERRMPI(ierr);
+#if defined(PETSC_HAVE_OPENMP) && defined(PETSC_HAVE_THREADSAFETY)
+  maxthreads = omp_get_max_threads();
+#endif
+  ierr = PetscOptionsGetInt(NULL,NULL,"-n",&n,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,NULL,"-k",&k,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,NULL,"-nel",&nel,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,NULL,"-max_threads",&maxthreads,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetBool(NULL,NULL,"-report",&report,NULL);CHKERRQ(ierr);
+  if (k > PetscMin(n,64)) SETERRQ2(PETSC_COMM_WORLD,PETSC_ERR_ARG_OUTOFRANGE,"Element size %D must not exceed local size %D nor 64",k,n);
+  if (size == 1) maxthreads = 1; /* Values would not be stashed, but inserted by threads concurrently in the local matrix */
+
+  ierr = MatCreateAIJ(PETSC_COMM_WORLD,n,n,PETSC_DETERMINE,PETSC_DETERMINE,2*k-1,NULL,0,NULL,&A);CHKERRQ(ierr);
+  ierr = MatSetOption(A,MAT_NEW_NONZERO_ALLOCATION_ERR,PETSC_TRUE);CHKERRQ(ierr);
+  ierr = MatCreateVecs(A,&x,&y);CHKERRQ(ierr);
+  ierr = VecSet(x,1.0);CHKERRQ(ierr);
+  rstart = ((rank+1)%size)*n; /* Elements are in the rows of the next process */
+
+  for (nthreads=1; nthreads<=maxthreads; nthreads*=2) {
+    PetscErrorCode ierrs = 0;
+
+    ierr = MatZeroEntries(A);CHKERRQ(ierr);
+    ierr = MPI_Barrier(PETSC_COMM_WORLD);CHKERRMPI(ierr);
+    ierr = PetscTime(&tinsert);CHKERRQ(ierr);
+#if defined(PETSC_HAVE_OPENMP) && defined(PETSC_HAVE_THREADSAFETY)
+    #pragma omp parallel for num_threads(nthreads) reduction(max:ierrs)
+#endif
+    for (e=0; e<nel; e++) {
+      PetscInt       j,idx[64];
+      PetscScalar    v[64*64];
+      PetscErrorCode ierrl;
+      for (j=0; j<k; j++) idx[j] = rstart + (e*7)%(n-k+1) + j;
+      for (j=0; j<k*k; j++) v[j] = 1.0;
+      ierrl = MatSetValues(A,k,idx,k,idx,v,ADD_VALUES);
+      ierrs = PetscMax(ierrs,ierrl); /* The private copies of ierrs start from INT_MIN, so PetscMax() must not call MatSetValues() */
+    }
+    ierr = ierrs;CHKERRQ(ierr);
+    ierr = PetscTimeSubtract(&tinsert);CHKERRQ(ierr);
+    ierr = PetscTime(&tassembly);CHKERRQ(ierr);
+    ierr = MatAssemblyBegin(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+    ierr = MatAssemblyEnd(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+    ierr = PetscTimeSubtract(&tassembly);CHKERRQ(ierr);
+
+    /* The sum of all entries is the number of element entries */
+    ierr = MatMult(A,x,y);CHKERRQ(ierr);
+    ierr = VecSum(y,&sum);CHKERRQ(ierr);
+    if (PetscAbsScalar(sum - (PetscReal)(size*nel*k*k)) > 0.5) {
+      ierr = PetscPrintf(PETSC_COMM_WORLD,"Wrong sum of entries %g with %D threads\n",(double)PetscRealPart(sum),nthreads);CHKERRQ(ierr);
+      nwrong++;
+    }
+    if (report) {
+      PetscLogDouble t = -tinsert-tassembly;
+      ierr = MPI_Allreduce(MPI_IN_PLACE,&t,1,MPI_DOUBLE,MPI_MAX,PETSC_COMM_WORLD);CHKERRMPI(ierr);
+      ierr = PetscPrintf(PETSC_COMM_WORLD,"%3D threads: insertion %8.4f s, assembly %8.4f s, %g Mentries/s per process\n",nthreads,-tinsert,-tassembly,1e-6*nel*k*k/t);CHKERRQ(ierr);
+    }
+  }
+  if (!nwrong) {ierr = PetscPrintf(PETSC_COMM_WORLD,"Stashed entries assembled correctly\n");CHKERRQ(ierr);}
+
+  ierr = VecDestroy(&x);CHKERRQ(ierr);
+  ierr = VecDestroy(&y);CHKERRQ(ierr);
+  ierr = MatDestroy(&A);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+   test:
+      suffix: 1
+      nsize: {{1 3}}
+      args: -k {{1 4}}
+      output_file: output/ex251_1.out
+
+   test:
+      suffix: 2
+      nsize: 2
+      args: -nel 20000 -k 3 -matstash_legacy {{0 1}}
+      output_file: output/ex251_1.out
+
+TEST*/
@@ -0,0 +1,108 @@
+static char help[] = "Tests the level-scheduled triangular solves of SeqAIJ LU and ILU factors.\n\n";
+
+/*
+  The 5-point Laplacian on a -m x -m grid is factored twice with the same ordering and factor type, the second factor
+  with the options prefix lv_. Both solves must agree, run with -lv_mat_factor_solve_levels to use the levels in the
+  second factor.
+
+  Usage: ./ex252 -m 1000 -lv_mat_factor_solve_levels -lv_mat_factor_solve_levels_min_width 64 -log_view
+*/
+#include <petscmat.h>
+
+int main(int argc,char **args)
+{
+  Mat            A,F,Flv;
+  Vec            b,x,xlv;
+  IS             isrow,iscol;
+  MatFactorInfo  info;
+  MatFactorType  ftype = MAT_FACTOR_ILU;
+  PetscInt       m = 20,i,j,row,nsolves = 2,s;
+  PetscReal      norm;
+  PetscBool      lu = PETSC_FALSE;
+  char           ordering[256] = MATORDERINGNATURAL;
+  PetscViewer    viewer;
+  PetscErrorCode ierr;
+
+  ierr = PetscInitialize(&argc,&args,(char*)0,help);if (ierr) return ierr;
+  ierr = PetscOptionsGetInt(NULL,NULL,"-m",&m,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetBool(NULL,NULL,"-lu",&lu,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetString(NULL,NULL,"-ordering",ordering,sizeof(ordering),NULL);CHKERRQ(ierr);
+  if (lu) ftype = MAT_FACTOR_LU;
+
+  ierr = MatCreateSeqAIJ(PETSC_COMM_SELF,m*m,m*m,5,NULL,&A);CHKERRQ(ierr);
+  for (i=0; i<m; i++) {
+    for (j=0; j<m; j++) {
+      row  = i*m+j;
+      if (i > 0)   {ierr = MatSetValue(A,row,row-m,-1.0,INSERT_VALUES);CHKERRQ(ierr);}
+      if (j > 0)   {ierr = MatSetValue(A,row,row-1,-1.0,INSERT_VALUES);CHKERRQ(ierr);}
+      ierr = MatSetValue(A,row,row,4.0,INSERT_VALUES);CHKERRQ(ierr);
+      if (j < m-1) {ierr = MatSetValue(A,row,row+1,-1.0,INSERT_VALUES);CHKERRQ(ierr);}
+      if (i < m-1) {ierr = MatSetValue(A,row,row+m,-1.0,INSERT_VALUES);CHKERRQ(ierr);}
+    }
+  }
+  ierr = MatAssemblyBegin(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatCreateVecs(A,&x,&b);CHKERRQ(ierr);
+  ierr = VecDuplicate(x,&xlv);CHKERRQ(ierr);
+  ierr = VecSetRandom(b,NULL);CHKERRQ(ierr);
+
+  ierr = MatGetOrdering(A,ordering,&isrow,&iscol);CHKERRQ(ierr);
+  ierr = MatFactorInfoInitialize(&info);CHKERRQ(ierr);
+  info.fill = lu ? 5.0 : 1.0;
+  ierr = MatGetFactor(A,MATSOLVERPETSC,ftype,&F);CHKERRQ(ierr);
+  ierr = MatGetFactor(A,MATSOLVERPETSC,ftype,&Flv);CHKERRQ(ierr);
+  ierr = MatSetOptionsPrefix(Flv,"lv_");CHKERRQ(ierr);
+  if (lu) {
+    ierr = MatLUFactorSymbolic(F,A,isrow,iscol,&info);CHKERRQ(ierr);
+    ierr = MatLUFactorSymbolic(Flv,A,isrow,iscol,&info);CHKERRQ(ierr);
+  } else {
+    ierr = MatILUFactorSymbolic(F,A,isrow,iscol,&info);CHKERRQ(ierr);
+    ierr = MatILUFactorSymbolic(Flv,A,isrow,iscol,&info);CHKERRQ(ierr);
+  }
+  /* The second numeric factorization reuses the levels computed by the first one */
+  for (s=0; s<nsolves; s++) {
+    ierr = MatLUFactorNumeric(F,A,&info);CHKERRQ(ierr);
+    ierr = MatLUFactorNumeric(Flv,A,&info);CHKERRQ(ierr);
+    ierr = MatSolve(F,b,x);CHKERRQ(ierr);
+    ierr = MatSolve(Flv,b,xlv);CHKERRQ(ierr);
+    ierr = VecAXPY(xlv,-1.0,x);CHKERRQ(ierr);
+    ierr = VecNorm(xlv,NORM_INFINITY,&norm);CHKERRQ(ierr);
+    if (norm > 100*PETSC_MACHINE_EPSILON) {ierr = PetscPrintf(PETSC_COMM_SELF,"Solves differ by %g\n",(double)norm);CHKERRQ(ierr);}
+  }
+
+  ierr = PetscViewerASCIIGetStdout(PETSC_COMM_SELF,&viewer);CHKERRQ(ierr);
+  ierr = PetscViewerPushFormat(viewer,PETSC_VIEWER_ASCII_INFO);CHKERRQ(ierr);
+  ierr = MatView(Flv,viewer);CHKERRQ(ierr);
+  ierr = PetscViewerPopFormat(viewer);CHKERRQ(ierr);
+
+  ierr = ISDestroy(&isrow);CHKERRQ(ierr);
+  ierr = ISDestroy(&iscol);CHKERRQ(ierr);
+  ierr = VecDestroy(&b);CHKERRQ(ierr);
+  ierr = VecDestroy(&x);CHKERRQ(ierr);
+  ierr = VecDestroy(&xlv);CHKERRQ(ierr);
+  ierr = MatDestroy(&F);CHKERRQ(ierr);
+  ierr = MatDestroy(&Flv);CHKERRQ(ierr);
+  ierr = MatDestroy(&A);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+   test:
+      suffix: ilu
+      args: -lv_mat_factor_solve_levels -lv_mat_factor_solve_levels_min_width 1
+
+   test:
+      suffix: ilu_rcm
+      args: -lv_mat_factor_solve_levels -lv_mat_factor_solve_levels_min_width 1 -ordering rcm
+
+   test:
+      suffix: lu_nd
+      args: -lv_mat_factor_solve_levels -lv_mat_factor_solve_levels_min_width 4 -ordering nd -lu
+
+   test:
+      suffix: narrow
+      args: -lv_mat_factor_solve_levels -lu
+
+TEST*/
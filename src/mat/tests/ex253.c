@@ -0,0 +1,166 @@
+static char help[] = "Tests the Chow-Patel ILU factorization of MATSOLVERCHOWILU against the one of MATSOLVERPETSC.\n\n";
+
+/*
+  The 5-point Laplacian on a -m x -m grid is factored with ILU(-levels) by both solver types. The solves and transposed
+  solves of MATSOLVERCHOWILU must agree with the ones of MATSOLVERPETSC up to -tol, relative to the solution, which is the
+  error of the fixed-point sweeps and of the Jacobi iterations. After as many sweeps as the depth of the dependencies
+  between the nonzeros and with the exact triangular solves, they agree up to rounding. The transposed solves must apply
+  the transpose of the operator of the solves, and MatMatSolve() and MatMatSolveTranspose() the same operators as MatSolve()
+  and MatSolveTranspose(), up to rounding.
+
+  Usage: OMP_NUM_THREADS=4 ./ex253 -m 8 -mat_factor_chowilu_sweeps 3 -mat_factor_chowilu_jacobi_its 8 -tol 0.05
+*/
+#include <petscmat.h>
+
+static PetscErrorCode CheckSolves(Mat F,Mat Fchow,Vec b,PetscBool transpose,PetscReal tol)
+{
+  Vec            x,xchow;
+  MatSolverType  type;
+  PetscReal      norm,normx;
+  PetscErrorCode ierr;
+
+  PetscFunctionBeginUser;
+  ierr = MatFactorGetSolverType(Fchow,&type);CHKERRQ(ierr);
+  ierr = VecDuplicate(b,&x);CHKERRQ(ierr);
+  ierr = VecDuplicate(b,&xchow);CHKERRQ(ierr);
+  if (transpose) {
+    ierr = MatSolveTranspose(F,b,x);CHKERRQ(ierr);
+    ierr = MatSolveTranspose(Fchow,b,xchow);CHKERRQ(ierr);
+  } else {
+    ierr = MatSolve(F,b,x);CHKERRQ(ierr);
+    ierr = MatSolve(Fchow,b,xchow);CHKERRQ(ierr);
+  }
+  ierr = VecNorm(x,NORM_2,&normx);CHKERRQ(ierr);
+  ierr = VecAXPY(xchow,-1.0,x);CHKERRQ(ierr);
+  ierr = VecNorm(xchow,NORM_2,&norm);CHKERRQ(ierr);
+  if (norm > tol*normx) {ierr = PetscPrintf(PETSC_COMM_SELF,"Error: %s of %s differs from the ILU one by %g relative to the solution\n",transpose ? "MatSolveTranspose()" : "MatSolve()",type,(double)(norm/normx));CHKERRQ(ierr);}
+  ierr = VecDestroy(&x);CHKERRQ(ierr);
+  ierr = VecDestroy(&xchow);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* Checks (M^{-T} v, u) = (v, M^{-1} u), and that MatMatSolve() and MatMatSolveTranspose() solve each column in the same way */
+static PetscErrorCode CheckTranspose(Mat Fchow,Vec u,Vec v)
+{
+  Mat            B,X;
+  Vec            x,xt,col;
+  PetscScalar    dot,dott;
+  PetscReal      norm,normx,tol = 100*PETSC_MACHINE_EPSILON;
+  PetscInt       n,k;
+  PetscErrorCode ierr;
+
+  PetscFunctionBeginUser;
+  ierr = VecDuplicate(u,&x);CHKERRQ(ierr);
+  ierr = VecDuplicate(u,&xt);CHKERRQ(ierr);
+  ierr = MatSolve(Fchow,u,x);CHKERRQ(ierr);
+  ierr = MatSolveTranspose(Fchow,v,xt);CHKERRQ(ierr);
+  ierr = VecDot(x,v,&dot);CHKERRQ(ierr);
+  ierr = VecDot(u,xt,&dott);CHKERRQ(ierr);
+  ierr = VecNorm(x,NORM_2,&normx);CHKERRQ(ierr);
+  ierr = VecNorm(v,NORM_2,&norm);CHKERRQ(ierr);
+  if (PetscAbsScalar(dot-dott) > tol*normx*norm) {ierr = PetscPrintf(PETSC_COMM_SELF,"Error: MatSolveTranspose() is not the transpose of MatSolve(), the products differ by %g\n",(double)PetscAbsScalar(dot-dott));CHKERRQ(ierr);}
+
+  ierr = VecGetLocalSize(u,&n);CHKERRQ(ierr);
+  ierr = MatCreateSeqDense(PETSC_COMM_SELF,n,2,NULL,&B);CHKERRQ(ierr);
+  ierr = MatCreateSeqDense(PETSC_COMM_SELF,n,2,NULL,&X);CHKERRQ(ierr);
+  for (k=0; k<2; k++) {
+    ierr = MatDenseGetColumnVecWrite(B,k,&col);CHKERRQ(ierr);
+    ierr = VecCopy(k ? v : u,col);CHKERRQ(ierr);
+    ierr = MatDenseRestoreColumnVecWrite(B,k,&col);CHKERRQ(ierr);
+  }
+  for (k=0; k<2; k++) {
+    if (k) {
+      ierr = MatMatSolveTranspose(Fchow,B,X);CHKERRQ(ierr);
+      ierr = MatSolveTranspose(Fchow,v,xt);CHKERRQ(ierr);
+    } else {
+      ierr = MatMatSolve(Fchow,B,X);CHKERRQ(ierr);
+      ierr = MatSolve(Fchow,v,xt);CHKERRQ(ierr);
+    }
+    ierr = MatDenseGetColumnVecRead(X,1,&col);CHKERRQ(ierr);
+    ierr = VecCopy(col,x);CHKERRQ(ierr);
+    ierr = MatDenseRestoreColumnVecRead(X,1,&col);CHKERRQ(ierr);
+    ierr = VecNorm(xt,NORM_2,&normx);CHKERRQ(ierr);
+    ierr = VecAXPY(x,-1.0,xt);CHKERRQ(ierr);
+    ierr = VecNorm(x,NORM_2,&norm);CHKERRQ(ierr);
+    if (norm > tol*normx) {ierr = PetscPrintf(PETSC_COMM_SELF,"Error: %s differs from the solves of the columns by %g\n",k ? "MatMatSolveTranspose()" : "MatMatSolve()",(double)norm);CHKERRQ(ierr);}
+  }
+  ierr = MatDestroy(&B);CHKERRQ(ierr);
+  ierr = MatDestroy(&X);CHKERRQ(ierr);
+  ierr = VecDestroy(&x);CHKERRQ(ierr);
+  ierr = VecDestroy(&xt);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+int main(int argc,char **args)
+{
+  Mat            A,F,Fchow;
+  Vec            b,v;
+  IS             isrow,iscol;
+  MatFactorInfo  info;
+  PetscInt       m = 8,levels = 0,i,j,row;
+  PetscReal      tol = 100*PETSC_MACHINE_EPSILON;
+  char           ordering[256] = MATORDERINGNATURAL;
+  PetscErrorCode ierr;
+
+  ierr = PetscInitialize(&argc,&args,(char*)0,help);if (ierr) return ierr;
+  ierr = PetscOptionsGetInt(NULL,NULL,"-m",&m,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,NULL,"-levels",&levels,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetReal(NULL,NULL,"-tol",&tol,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetString(NULL,NULL,"-ordering",ordering,sizeof(ordering),NULL);CHKERRQ(ierr);
+
+  ierr = MatCreateSeqAIJ(PETSC_COMM_SELF,m*m,m*m,5,NULL,&A);CHKERRQ(ierr);
+  for (i=0; i<m; i++) {
+    for (j=0; j<m; j++) {
+      row = i*m+j;
+      if (i > 0)   {ierr = MatSetValue(A,row,row-m,-1.0,INSERT_VALUES);CHKERRQ(ierr);}
+      if (j > 0)   {ierr = MatSetValue(A,row,row-1,-1.0,INSERT_VALUES);CHKERRQ(ierr);}
+      ierr = MatSetValue(A,row,row,4.0,INSERT_VALUES);CHKERRQ(ierr);
+      if (j < m-1) {ierr = MatSetValue(A,row,row+1,-1.0,INSERT_VALUES);CHKERRQ(ierr);}
+      if (i < m-1) {ierr = MatSetValue(A,row,row+m,-1.0,INSERT_VALUES);CHKERRQ(ierr);}
+    }
+  }
+  ierr = MatAssemblyBegin(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatCreateVecs(A,&v,&b);CHKERRQ(ierr);
+  ierr = VecSetRandom(b,NULL);CHKERRQ(ierr);
+  ierr = VecSetRandom(v,NULL);CHKERRQ(ierr);
+
+  ierr = MatGetOrdering(A,ordering,&isrow,&iscol);CHKERRQ(ierr);
+  ierr = MatFactorInfoInitialize(&info);CHKERRQ(ierr);
+  info.fill   = 1.0;
+  info.levels = levels;
+  ierr = MatGetFactor(A,MATSOLVERPETSC,MAT_FACTOR_ILU,&F);CHKERRQ(ierr);
+  ierr = MatGetFactor(A,MATSOLVERCHOWILU,MAT_FACTOR_ILU,&Fchow);CHKERRQ(ierr);
+  ierr = MatILUFactorSymbolic(F,A,isrow,iscol,&info);CHKERRQ(ierr);
+  ierr = MatILUFactorSymbolic(Fchow,A,isrow,iscol,&info);CHKERRQ(ierr);
+  ierr = MatLUFactorNumeric(F,A,&info);CHKERRQ(ierr);
+  ierr = MatLUFactorNumeric(Fchow,A,&info);CHKERRQ(ierr);
+  ierr = CheckSolves(F,Fchow,b,PETSC_FALSE,tol);CHKERRQ(ierr);
+  ierr = CheckSolves(F,Fchow,b,PETSC_TRUE,tol);CHKERRQ(ierr);
+  ierr = CheckTranspose(Fchow,b,v);CHKERRQ(ierr);
+  ierr = PetscViewerPushFormat(PETSC_VIEWER_STDOUT_SELF,PETSC_VIEWER_ASCII_INFO);CHKERRQ(ierr);
+  ierr = MatView(Fchow,PETSC_VIEWER_STDOUT_SELF);CHKERRQ(ierr);
+  ierr = PetscViewerPopFormat(PETSC_VIEWER_STDOUT_SELF);CHKERRQ(ierr);
+
+  ierr = ISDestroy(&isrow);CHKERRQ(ierr);
+  ierr = ISDestroy(&iscol);CHKERRQ(ierr);
+  ierr = VecDestroy(&b);CHKERRQ(ierr);
+  ierr = VecDestroy(&v);CHKERRQ(ierr);
+  ierr = MatDestroy(&F);CHKERRQ(ierr);
+  ierr = MatDestroy(&Fchow);CHKERRQ(ierr);
+  ierr = MatDestroy(&A);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+   test:
+      suffix: exact
+      args: -mat_factor_chowilu_sweeps 64 -mat_factor_chowilu_jacobi_its 0
+
+   test:
+      suffix: jacobi
+      args: -mat_factor_chowilu_sweeps 3 -mat_factor_chowilu_jacobi_its 8 -levels 1 -ordering rcm -tol 0.05
+
+TEST*/
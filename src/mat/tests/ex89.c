@@ -160,4 +160,16 @@ int main(int argc,char **argv)
       args: -M 10 -N 10 -Z 10 -matproduct_ptap_via nonscalable
       output_file: output/ex89_5.out
 
+   test:
+      suffix: allatonce_baij
+      nsize: 4
+      args: -M 10 -N 10 -Z 10 -matptap_allatonce_baij
+      output_file: output/ex89_6.out
+
+   test:
+      suffix: allatonce_merged_baij_3D
+      nsize: 4
+      args: -M 10 -M 5 -M 10 -test_3D 1 -matproduct_ptap_via allatonce_merged -matptap_allatonce_baij
+      output_file: output/ex89_7.out
+
 TEST*/
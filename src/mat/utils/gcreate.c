@@ -248,6 +248,14 @@ PetscErrorCode  MatSetFromOptions(Mat B)
   ierr = PetscOptionsBool("-mat_form_explicit_transpose","Hint to form an explicit transpose for operations like MatMultTranspose","MatSetOption",flg,&flg,&set);CHKERRQ(ierr);
   if (set) {ierr = MatSetOption(B,MAT_FORM_EXPLICIT_TRANSPOSE,flg);CHKERRQ(ierr);}
 
+  flg  = PETSC_FALSE;
+  ierr = PetscOptionsBool("-mat_autotune_mult","Time the available MatMult() kernels at assembly and use the fastest one","MatSetOption",flg,&flg,&set);CHKERRQ(ierr);
+  if (set) {ierr = MatSetOption(B,MAT_AUTOTUNE_MULT,flg);CHKERRQ(ierr);}
+
+  flg  = PETSC_FALSE;
+  ierr = PetscOptionsBool("-mat_sor_multicolor","Sweep the rows color by color in parallel in MatSOR()","MatSetOption",flg,&flg,&set);CHKERRQ(ierr);
+  if (set) {ierr = MatSetOption(B,MAT_SOR_MULTICOLOR,flg);CHKERRQ(ierr);}
+
   /* process any options handlers added with PetscObjectAddOptionsHandler() */
   ierr = PetscObjectProcessOptionsHandlers(PetscOptionsObject,(PetscObject)B);CHKERRQ(ierr);
   ierr = PetscOptionsEnd();CHKERRQ(ierr);
@@ -3,6 +3,13 @@
 
 #define DEFAULT_STASH_SIZE   10000
 
+/* Threads may stash values concurrently only if the rest of PETSc (malloc, error handling) is thread-safe */
+#if defined(PETSC_HAVE_OPENMP) && defined(PETSC_HAVE_THREADSAFETY)
+#include <omp.h>
+#define MATSTASH_USE_THREADS
+#define MATSTASH_THREADS_MIN_SORT 16384 /* Sort and compress stashes at least this long with threads */
+#endif
+
 static PetscErrorCode MatStashScatterBegin_Ref(Mat,MatStash*,PetscInt*);
 PETSC_INTERN PetscErrorCode MatStashScatterGetMesg_Ref(MatStash*,PetscMPIInt*,PetscInt**,PetscInt**,PetscScalar**,PetscInt*);
 PETSC_INTERN PetscErrorCode MatStashScatterEnd_Ref(MatStash*);
@@ -66,6 +73,12 @@ PetscErrorCode MatStashCreate_Private(MPI_Comm comm,PetscInt bs,MatStash *stash)
   stash->reallocs   = -1;
   stash->space_head = NULL;
   stash->space      = NULL;
+  stash->nthreads   = 1;
+  stash->threads    = NULL;
+#if defined(MATSTASH_USE_THREADS)
+  stash->nthreads   = omp_get_max_threads();
+  if (stash->nthreads > 1) {ierr = PetscCalloc1(stash->nthreads,&stash->threads);CHKERRQ(ierr);}
+#endif
 
   stash->send_waits  = NULL;
   stash->recv_waits  = NULL;
@@ -106,9 +119,16 @@ PetscErrorCode MatStashCreate_Private(MPI_Comm comm,PetscInt bs,MatStash *stash)
 PetscErrorCode MatStashDestroy_Private(MatStash *stash)
 {
   PetscErrorCode ierr;
+  PetscInt       t;
 
   PetscFunctionBegin;
   ierr = PetscMatStashSpaceDestroy(&stash->space_head);CHKERRQ(ierr);
+  for (t=0; stash->threads && t<stash->nthreads; t++) {
+    ierr = PetscSegBufferDestroy(&stash->threads[t].row);CHKERRQ(ierr);
+    ierr = PetscSegBufferDestroy(&stash->threads[t].col);CHKERRQ(ierr);
+    ierr = PetscSegBufferDestroy(&stash->threads[t].val);CHKERRQ(ierr);
+  }
+  ierr = PetscFree(stash->threads);CHKERRQ(ierr);
   if (stash->ScatterDestroy) {ierr = (*stash->ScatterDestroy)(stash);CHKERRQ(ierr);}
 
   stash->space = NULL;
@@ -251,6 +271,105 @@ static PetscErrorCode MatStashExpand_Private(MatStash *stash,PetscInt incr)
   stash->nmax = newnmax;
   PetscFunctionReturn(0);
 }
+#if defined(MATSTASH_USE_THREADS)
+/*
+  MatStashGetThread_Private - gets the stash of the calling thread if it is in an active OpenMP
+  parallel region, otherwise NULL, in which case values go to the shared stash.
+*/
+static PetscErrorCode MatStashGetThread_Private(MatStash *stash,MatStashThread **thread)
+{
+  PetscErrorCode ierr;
+  MatStashThread *t;
+  int            tid;
+
+  PetscFunctionBegin;
+  *thread = NULL;
+  if (!stash->threads || !omp_in_parallel()) PetscFunctionReturn(0);
+  if (omp_get_active_level() > 1) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_SUP,"Cannot stash matrix values from nested OpenMP parallel regions");
+  tid = omp_get_thread_num();
+  if (tid >= stash->nthreads) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_SUP,"Thread %d is beyond the %D threads the stash was created for",tid,stash->nthreads);
+  t = &stash->threads[tid];
+  if (!t->val) { /* Each thread creates its own buffers */
+    PetscInt expected = PetscMax(stash->umax,DEFAULT_STASH_SIZE)/stash->nthreads;
+    ierr = PetscSegBufferCreate(sizeof(PetscInt),expected,&t->row);CHKERRQ(ierr);
+    ierr = PetscSegBufferCreate(sizeof(PetscInt),expected,&t->col);CHKERRQ(ierr);
+    ierr = PetscSegBufferCreate(sizeof(PetscScalar),expected,&t->val);CHKERRQ(ierr);
+  }
+  *thread = t;
+  PetscFunctionReturn(0);
+}
+
+/* Stash values of one row in the stash of a thread, values[] being separated by stepval */
+static PetscErrorCode MatStashValuesThread_Private(MatStashThread *t,PetscInt row,PetscInt n,const PetscInt idxn[],const PetscScalar values[],PetscInt stepval,PetscBool ignorezeroentries)
+{
+  PetscErrorCode ierr;
+  PetscInt       i,cnt = 0,*rows,*cols;
+  PetscScalar    *vals;
+
+  PetscFunctionBegin;
+  ierr = PetscSegBufferGet(t->row,n,&rows);CHKERRQ(ierr);
+  ierr = PetscSegBufferGet(t->col,n,&cols);CHKERRQ(ierr);
+  ierr = PetscSegBufferGet(t->val,n,&vals);CHKERRQ(ierr);
+  for (i=0; i<n; i++) {
+    if (ignorezeroentries && values && values[i*stepval] == 0.0) continue;
+    rows[cnt] = row;
+    cols[cnt] = idxn[i];
+    vals[cnt] = values ? values[i*stepval] : 0.0;
+    cnt++;
+  }
+  if (cnt < n) {
+    ierr = PetscSegBufferUnuse(t->row,n-cnt);CHKERRQ(ierr);
+    ierr = PetscSegBufferUnuse(t->col,n-cnt);CHKERRQ(ierr);
+    ierr = PetscSegBufferUnuse(t->val,n-cnt);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+/*
+  MatStashMergeThreads_Private - appends the values stashed by threads to the shared stash.
+  Each thread copies its own segments to a contiguous range of a single stash space.
+*/
+static PetscErrorCode MatStashMergeThreads_Private(MatStash *stash)
+{
+  PetscErrorCode     ierr;
+  PetscInt           t,nthreads = stash->nthreads,*offset,ntotal;
+  size_t             nt;
+  PetscMatStashSpace space;
+  PetscErrorCode     *ierrs;
+
+  PetscFunctionBegin;
+  if (!stash->threads) PetscFunctionReturn(0);
+  ierr = PetscMalloc2(nthreads+1,&offset,nthreads,&ierrs);CHKERRQ(ierr);
+  for (t=0,offset[0]=0; t<nthreads; t++) {
+    nt = 0;
+    if (stash->threads[t].val) {ierr = PetscSegBufferGetSize(stash->threads[t].val,&nt);CHKERRQ(ierr);}
+    offset[t+1] = offset[t] + (PetscInt)nt;
+    ierrs[t]    = 0;
+  }
+  ntotal = offset[nthreads];
+  if (ntotal) {
+    if (!stash->space || stash->space->local_remaining < ntotal) {
+      ierr = MatStashExpand_Private(stash,ntotal);CHKERRQ(ierr);
+    }
+    space = stash->space;
+    #pragma omp parallel for num_threads(nthreads) schedule(static,1)
+    for (t=0; t<nthreads; t++) {
+      const PetscInt k = space->local_used + offset[t];
+      if (offset[t+1] == offset[t]) continue;
+      ierrs[t] = PetscSegBufferExtractTo(stash->threads[t].row,space->idx+k);
+      if (!ierrs[t]) ierrs[t] = PetscSegBufferExtractTo(stash->threads[t].col,space->idy+k);
+      if (!ierrs[t]) ierrs[t] = PetscSegBufferExtractTo(stash->threads[t].val,space->val+k);
+    }
+    for (t=0; t<nthreads; t++) {ierr = ierrs[t];CHKERRQ(ierr);}
+    stash->n               += ntotal;
+    space->local_used      += ntotal;
+    space->local_remaining -= ntotal;
+  }
+  ierr = PetscFree2(offset,ierrs);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+#endif
+
 /*
   MatStashValuesRow_Private - inserts values into the stash. This function
   expects the values to be roworiented. Multiple columns belong to the same row
@@ -262,6 +381,10 @@ static PetscErrorCode MatStashExpand_Private(MatStash *stash,PetscInt incr)
   n      - the number of elements inserted. All elements belong to the above row.
   idxn   - the global column indices corresponding to each of the values.
   values - the values inserted
+
+  Notes:
+  With OpenMP and thread safety, threads in a parallel region stash values in their own
+  buffers, which are merged when the stash is scattered.
 */
 PetscErrorCode MatStashValuesRow_Private(MatStash *stash,PetscInt row,PetscInt n,const PetscInt idxn[],const PetscScalar values[],PetscBool ignorezeroentries)
 {
@@ -270,6 +393,16 @@ PetscErrorCode MatStashValuesRow_Private(MatStash *stash,PetscInt row,PetscInt n
   PetscMatStashSpace space=stash->space;
 
   PetscFunctionBegin;
+#if defined(MATSTASH_USE_THREADS)
+  {
+    MatStashThread *thread;
+    ierr = MatStashGetThread_Private(stash,&thread);CHKERRQ(ierr);
+    if (thread) {
+      ierr = MatStashValuesThread_Private(thread,row,n,idxn,values,1,ignorezeroentries);CHKERRQ(ierr);
+      PetscFunctionReturn(0);
+    }
+  }
+#endif
   /* Check and see if we have sufficient memory */
   if (!space || space->local_remaining < n) {
     ierr = MatStashExpand_Private(stash,n);CHKERRQ(ierr);
@@ -311,6 +444,16 @@ PetscErrorCode MatStashValuesCol_Private(MatStash *stash,PetscInt row,PetscInt n
   PetscMatStashSpace space=stash->space;
 
   PetscFunctionBegin;
+#if defined(MATSTASH_USE_THREADS)
+  {
+    MatStashThread *thread;
+    ierr = MatStashGetThread_Private(stash,&thread);CHKERRQ(ierr);
+    if (thread) {
+      ierr = MatStashValuesThread_Private(thread,row,n,idxn,values,stepval,ignorezeroentries);CHKERRQ(ierr);
+      PetscFunctionReturn(0);
+    }
+  }
+#endif
   /* Check and see if we have sufficient memory */
   if (!space || space->local_remaining < n) {
     ierr = MatStashExpand_Private(stash,n);CHKERRQ(ierr);
@@ -459,6 +602,9 @@ PetscErrorCode MatStashScatterBegin_Private(Mat mat,MatStash *stash,PetscInt *ow
   PetscErrorCode ierr;
 
   PetscFunctionBegin;
+#if defined(MATSTASH_USE_THREADS)
+  ierr = MatStashMergeThreads_Private(stash);CHKERRQ(ierr);
+#endif
   ierr = (*stash->ScatterBegin)(mat,stash,owners);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
@@ -706,6 +852,108 @@ typedef struct {
   PetscScalar vals[1];          /* Actually an array of length bs2 */
 } MatStashBlock;
 
+#if defined(MATSTASH_USE_THREADS)
+/*
+  MatStashRadixSort_Private - stable LSD radix sort of (row,col) pairs with 8-bit digits, sorting by col then by row.
+  Each of the nchunks chunks of the input is processed by one thread: threads count digits in their chunk, then scatter
+  their chunk after a prefix sum over (digit,chunk). Only digits needed for the ranges of row[] and col[] are sorted.
+*/
+static PetscErrorCode MatStashRadixSort_Private(PetscInt n,PetscInt nchunks,PetscInt *row,PetscInt *col,PetscInt *perm)
+{
+  PetscErrorCode ierr;
+  PetscInt       *src[3],*dst[3],*tmp[3],(*count)[256],rmin = PETSC_MAX_INT,rmax = PETSC_MIN_INT,cmin = PETSC_MAX_INT,cmax = PETSC_MIN_INT;
+  PetscInt       i,c,d,k,shift,sum;
+
+  PetscFunctionBegin;
+  ierr = PetscMalloc4(n,&dst[0],n,&dst[1],n,&dst[2],nchunks,&count);CHKERRQ(ierr);
+  tmp[0] = dst[0]; tmp[1] = dst[1]; tmp[2] = dst[2];
+  src[0] = row;    src[1] = col;    src[2] = perm;
+  #pragma omp parallel for reduction(min:rmin,cmin) reduction(max:rmax,cmax)
+  for (i=0; i<n; i++) {
+    rmin = PetscMin(rmin,row[i]); rmax = PetscMax(rmax,row[i]);
+    cmin = PetscMin(cmin,col[i]); cmax = PetscMax(cmax,col[i]);
+  }
+  for (k=1; k>=0; k--) { /* Sort by col (k=1), then by row (k=0) */
+    const PetscInt base = k ? cmin : rmin,range = k ? cmax-cmin : rmax-rmin;
+    for (shift=0; shift<(PetscInt)(8*sizeof(PetscInt)) && (range >> shift); shift+=8) {
+      #pragma omp parallel for schedule(static,1)
+      for (c=0; c<nchunks; c++) {
+        const PetscInt lo = n*c/nchunks,hi = n*(c+1)/nchunks,*key = src[k];
+        PetscInt       j;
+        for (j=0; j<256; j++) count[c][j] = 0;
+        for (j=lo; j<hi; j++) count[c][((key[j]-base) >> shift) & 255]++;
+      }
+      for (d=0,sum=0; d<256; d++) {
+        for (c=0; c<nchunks; c++) {PetscInt cnt = count[c][d]; count[c][d] = sum; sum += cnt;}
+      }
+      #pragma omp parallel for schedule(static,1)
+      for (c=0; c<nchunks; c++) {
+        const PetscInt lo = n*c/nchunks,hi = n*(c+1)/nchunks,*key = src[k];
+        PetscInt       j,l;
+        for (j=lo; j<hi; j++) {
+          l         = count[c][((key[j]-base) >> shift) & 255]++;
+          dst[0][l] = src[0][j];
+          dst[1][l] = src[1][j];
+          dst[2][l] = src[2][j];
+        }
+      }
+      for (i=0; i<3; i++) {PetscInt *t = src[i]; src[i] = dst[i]; dst[i] = t;}
+    }
+  }
+  if (src[0] != row) {
+    #pragma omp parallel for
+    for (i=0; i<n; i++) {row[i] = src[0][i]; col[i] = src[1][i]; perm[i] = src[2][i];}
+  }
+  ierr = PetscFree4(tmp[0],tmp[1],tmp[2],count);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+  MatStashSortCompress_Threads_Private - threaded version of MatStashSortCompress_Private(). After a radix sort, each
+  thread combines the duplicates of the (row,col) runs starting in its chunk of the sorted entries. A first pass counts
+  the runs of each chunk to find where its compressed blocks go in the send buffer.
+*/
+static PetscErrorCode MatStashSortCompress_Threads_Private(MatStash *stash,InsertMode insertmode,PetscInt *row,PetscInt *col,PetscInt *perm,PetscScalar **valptr)
+{
+  PetscErrorCode ierr;
+  PetscInt       n = stash->n,bs2 = stash->bs*stash->bs,nchunks = stash->nthreads,*start,c;
+  size_t         blocksize = stash->blocktype_size;
+  char           *blocks;
+
+  PetscFunctionBegin;
+  ierr = MatStashRadixSort_Private(n,nchunks,row,col,perm);CHKERRQ(ierr);
+  ierr = PetscMalloc1(nchunks+1,&start);CHKERRQ(ierr);
+  #pragma omp parallel for schedule(static,1)
+  for (c=0; c<nchunks; c++) {
+    const PetscInt lo = n*c/nchunks,hi = n*(c+1)/nchunks;
+    PetscInt       j,cnt = 0;
+    for (j=lo; j<hi; j++) if (!j || row[j] != row[j-1] || col[j] != col[j-1]) cnt++;
+    start[c+1] = cnt;
+  }
+  for (c=0,start[0]=0; c<nchunks; c++) start[c+1] += start[c];
+  ierr = PetscSegBufferGet(stash->segsendblocks,start[nchunks],&blocks);CHKERRQ(ierr);
+  #pragma omp parallel for schedule(static,1)
+  for (c=0; c<nchunks; c++) {
+    const PetscInt lo = n*c/nchunks,hi = n*(c+1)/nchunks;
+    PetscInt       j,l,m,b = start[c];
+    for (j=lo; j<hi; j++) {
+      MatStashBlock *block;
+      if (j && row[j] == row[j-1] && col[j] == col[j-1]) continue; /* Not the start of a run */
+      block      = (MatStashBlock*)(blocks + (b++)*blocksize);
+      block->row = row[j];
+      block->col = col[j];
+      for (l=0; l<bs2; l++) block->vals[l] = valptr[perm[j]][l];
+      for (m=j+1; m<n && row[m] == row[j] && col[m] == col[j]; m++) { /* The run may extend to the next chunks */
+        if (insertmode == ADD_VALUES) for (l=0; l<bs2; l++) block->vals[l] += valptr[perm[m]][l];
+        else                          for (l=0; l<bs2; l++) block->vals[l]  = valptr[perm[m]][l];
+      }
+    }
+  }
+  ierr = PetscFree(start);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+#endif
+
 static PetscErrorCode MatStashSortCompress_Private(MatStash *stash,InsertMode insertmode)
 {
   PetscErrorCode ierr;
@@ -725,6 +973,13 @@ static PetscErrorCode MatStashSortCompress_Private(MatStash *stash,InsertMode in
     }
   }
   if (cnt != n) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_PLIB,"MatStash n %D, but counted %D entries",n,cnt);
+#if defined(MATSTASH_USE_THREADS)
+  if (stash->nthreads > 1 && n >= MATSTASH_THREADS_MIN_SORT) {
+    ierr = MatStashSortCompress_Threads_Private(stash,insertmode,row,col,perm,valptr);CHKERRQ(ierr);
+    ierr = PetscFree4(row,col,valptr,perm);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+#endif
   ierr = PetscSortIntWithArrayPair(n,row,col,perm);CHKERRQ(ierr);
   /* Scan through the rows, sorting each one, combining duplicates, and packing send buffers */
   for (rowstart=0,cnt=0,i=1; i<=n; i++) {
@@ -0,0 +1,302 @@
+static const char help[] = "Measures the FEM residual evaluation on a mesh before and after reordering it for locality.\n\n";
+
+/*
+  Creates a box mesh, or with -sphere a quadrilateral mesh of the unit sphere embedded in 3D, with -tree_cell refines
+  one cell non-conformingly, with -shuffle randomly permutes the points in each stratum as a mesh generator with a poor
+  ordering might, and calls DMSetFromOptions(), which distributes and reorders the mesh with -dm_distribute and
+  -dm_plex_reorder_locality. With -order_type the mesh is then also reordered by DMPlexGetLocalityOrdering(). For both
+  meshes the residual of a nonlinear Poisson problem is evaluated -its times, and the bandwidth of the Jacobian, the mean
+  spread of the dof offsets of the points of each depth in a cell closure, the residual norm and with -report the time
+  per evaluation are printed.
+
+  Usage: ./ex70 -dm_plex_box_dim 3 -dm_plex_box_faces 32,32,32 -petscspace_degree 2 -shuffle -order_type hilbert -its 10 -report
+*/
+#include <petscdmplex.h>
+#include <petscds.h>
+#include <petscsnes.h>
+#include <petsctime.h>
+
+static void f0_u(PetscInt dim, PetscInt Nf, PetscInt NfAux,
+                 const PetscInt uOff[], const PetscInt uOff_x[], const PetscScalar u[], const PetscScalar u_t[], const PetscScalar u_x[],
+                 const PetscInt aOff[], const PetscInt aOff_x[], const PetscScalar a[], const PetscScalar a_t[], const PetscScalar a_x[],
+                 PetscReal t, const PetscReal x[], PetscInt numConstants, const PetscScalar constants[], PetscScalar f0[])
+{
+  f0[0] = u[0]*u[0]*u[0] - 1.0;
+}
+
+static void f1_u(PetscInt dim, PetscInt Nf, PetscInt NfAux,
+                 const PetscInt uOff[], const PetscInt uOff_x[], const PetscScalar u[], const PetscScalar u_t[], const PetscScalar u_x[],
+                 const PetscInt aOff[], const PetscInt aOff_x[], const PetscScalar a[], const PetscScalar a_t[], const PetscScalar a_x[],
+                 PetscReal t, const PetscReal x[], PetscInt numConstants, const PetscScalar constants[], PetscScalar f1[])
+{
+  PetscInt d;
+  for (d = 0; d < dim; ++d) f1[d] = u_x[d];
+}
+
+static PetscErrorCode quadratic(PetscInt dim, PetscReal time, const PetscReal x[], PetscInt Nc, PetscScalar *u, void *ctx)
+{
+  PetscInt d;
+
+  u[0] = 0.0;
+  for (d = 0; d < dim; ++d) u[0] += (d+1)*x[d]*x[d];
+  return 0;
+}
+
+/* Randomly permutes the points within each depth stratum */
+static PetscErrorCode ShuffleMesh(DM *dm)
+{
+  DM             pdm;
+  IS             perm;
+  PetscRandom    rand;
+  PetscInt      *pperm, depth, d, pStart, pEnd, p, q, tmp;
+  PetscReal      r;
+  PetscErrorCode ierr;
+
+  PetscFunctionBeginUser;
+  ierr = PetscRandomCreate(PETSC_COMM_SELF, &rand);CHKERRQ(ierr);
+  ierr = DMPlexGetChart(*dm, &pStart, &pEnd);CHKERRQ(ierr);
+  ierr = PetscMalloc1(pEnd-pStart, &pperm);CHKERRQ(ierr);
+  for (p = pStart; p < pEnd; ++p) pperm[p] = p;
+  ierr = DMPlexGetDepth(*dm, &depth);CHKERRQ(ierr);
+  for (d = 0; d <= depth; ++d) {
+    ierr = DMPlexGetDepthStratum(*dm, d, &pStart, &pEnd);CHKERRQ(ierr);
+    for (p = pEnd-1; p > pStart; --p) {
+      ierr = PetscRandomGetValueReal(rand, &r);CHKERRQ(ierr);
+      q        = pStart + PetscMin((PetscInt) (r*(p-pStart+1)), p-pStart);
+      tmp      = pperm[p];
+      pperm[p] = pperm[q];
+      pperm[q] = tmp;
+    }
+  }
+  ierr = PetscRandomDestroy(&rand);CHKERRQ(ierr);
+  ierr = DMPlexGetChart(*dm, &pStart, &pEnd);CHKERRQ(ierr);
+  ierr = ISCreateGeneral(PetscObjectComm((PetscObject) *dm), pEnd-pStart, pperm, PETSC_OWN_POINTER, &perm);CHKERRQ(ierr);
+  ierr = DMPlexPermute(*dm, perm, &pdm);CHKERRQ(ierr);
+  ierr = ISDestroy(&perm);CHKERRQ(ierr);
+  ierr = DMDestroy(dm);CHKERRQ(ierr);
+  *dm  = pdm;
+  PetscFunctionReturn(0);
+}
+
+/* The largest distance of two global dof indices in a cell closure, which is the bandwidth of the Jacobian, and the mean
+   over the cells of the largest distance of the offsets of two closure points of the same depth. Plex numbers the points
+   by stratum, so only the latter measures the locality within the strata. */
+static PetscErrorCode ComputeBandwidth(DM dm, PetscInt *bw, PetscReal *span)
+{
+  PetscSection   section, gsection;
+  PetscInt       cStart, cEnd, c, bwLocal = 0;
+  PetscReal      sum[2] = {0.0, 0.0}, gsum[2];
+  PetscErrorCode ierr;
+
+  PetscFunctionBeginUser;
+  ierr = DMGetLocalSection(dm, &section);CHKERRQ(ierr);
+  ierr = DMGetGlobalSection(dm, &gsection);CHKERRQ(ierr);
+  ierr = DMPlexGetHeightStratum(dm, 0, &cStart, &cEnd);CHKERRQ(ierr);
+  for (c = cStart; c < cEnd; ++c) {
+    PetscInt *idx = NULL, *closure = NULL, n, i, min = PETSC_MAX_INT, max = 0, smin[4], smax[4], cspan = 0, d;
+
+    ierr = DMPlexGetClosureIndices(dm, section, gsection, c, PETSC_TRUE, &n, &idx, NULL, NULL);CHKERRQ(ierr);
+    for (i = 0; i < n; ++i) {
+      const PetscInt gidx = idx[i] < 0 ? -(idx[i]+1) : idx[i];
+
+      min = PetscMin(min, gidx);
+      max = PetscMax(max, gidx);
+    }
+    if (n) bwLocal = PetscMax(bwLocal, max - min);
+    ierr = DMPlexRestoreClosureIndices(dm, section, gsection, c, PETSC_TRUE, &n, &idx, NULL, NULL);CHKERRQ(ierr);
+    for (d = 0; d < 4; ++d) {smin[d] = PETSC_MAX_INT; smax[d] = -1;}
+    ierr = DMPlexGetTransitiveClosure(dm, c, PETSC_TRUE, &n, &closure);CHKERRQ(ierr);
+    for (i = 0; i < n; ++i) {
+      PetscInt p = closure[2*i], dof, off;
+
+      ierr = PetscSectionGetDof(gsection, p, &dof);CHKERRQ(ierr);
+      if (!dof) continue;
+      ierr = PetscSectionGetOffset(gsection, p, &off);CHKERRQ(ierr);
+      ierr = DMPlexGetPointDepth(dm, p, &d);CHKERRQ(ierr);
+      off     = off < 0 ? -(off+1) : off;
+      smin[d] = PetscMin(smin[d], off);
+      smax[d] = PetscMax(smax[d], off);
+    }
+    ierr = DMPlexRestoreTransitiveClosure(dm, c, PETSC_TRUE, &n, &closure);CHKERRQ(ierr);
+    for (d = 0; d < 4; ++d) if (smax[d] >= 0) cspan = PetscMax(cspan, smax[d] - smin[d]);
+    sum[0] += cspan;
+    sum[1] += 1.0;
+  }
+  ierr = MPIU_Allreduce(&bwLocal, bw, 1, MPIU_INT, MPI_MAX, PetscObjectComm((PetscObject) dm));CHKERRQ(ierr);
+  ierr = MPIU_Allreduce(sum, gsum, 2, MPIU_REAL, MPIU_SUM, PetscObjectComm((PetscObject) dm));CHKERRQ(ierr);
+  *span = gsum[1] > 0.0 ? gsum[0]/gsum[1] : 0.0;
+  PetscFunctionReturn(0);
+}
+
+/* Discretizes the problem on dm, evaluates the residual its times and prints its norm and the bandwidth */
+static PetscErrorCode EvaluateResidual(DM dm, const char label[], PetscInt its, PetscBool report, PetscReal *norm)
+{
+  PetscFE         fe;
+  PetscDS         ds;
+  Vec             u, locU, locF, F;
+  PetscErrorCode (*funcs[1])(PetscInt, PetscReal, const PetscReal[], PetscInt, PetscScalar *, void *) = {quadratic};
+  DMPolytopeType  ct;
+  PetscInt        dim, cStart, cEnd, numCells, bw, k;
+  PetscReal       span;
+  PetscBool       simplex;
+  PetscLogDouble  t0, t1;
+  PetscErrorCode  ierr;
+
+  PetscFunctionBeginUser;
+  ierr = DMGetDimension(dm, &dim);CHKERRQ(ierr);
+  ierr = DMPlexGetHeightStratum(dm, 0, &cStart, &cEnd);CHKERRQ(ierr);
+  ierr = DMPlexGetCellType(dm, cStart, &ct);CHKERRQ(ierr);
+  simplex = DMPolytopeTypeGetNumVertices(ct) == DMPolytopeTypeGetDim(ct)+1 ? PETSC_TRUE : PETSC_FALSE;
+  ierr = PetscFECreateDefault(PetscObjectComm((PetscObject) dm), dim, 1, simplex, NULL, PETSC_DETERMINE, &fe);CHKERRQ(ierr);
+  ierr = DMSetField(dm, 0, NULL, (PetscObject) fe);CHKERRQ(ierr);
+  ierr = PetscFEDestroy(&fe);CHKERRQ(ierr);
+  ierr = DMCreateDS(dm);CHKERRQ(ierr);
+  ierr = DMGetDS(dm, &ds);CHKERRQ(ierr);
+  ierr = PetscDSSetResidual(ds, 0, f0_u, f1_u);CHKERRQ(ierr);
+  ierr = DMCreateGlobalVector(dm, &u);CHKERRQ(ierr);
+  ierr = DMCreateGlobalVector(dm, &F);CHKERRQ(ierr);
+  ierr = DMCreateLocalVector(dm, &locU);CHKERRQ(ierr);
+  ierr = DMCreateLocalVector(dm, &locF);CHKERRQ(ierr);
+  ierr = DMProjectFunction(dm, 0.0, funcs, NULL, INSERT_ALL_VALUES, u);CHKERRQ(ierr);
+  ierr = DMGlobalToLocalBegin(dm, u, INSERT_VALUES, locU);CHKERRQ(ierr);
+  ierr = DMGlobalToLocalEnd(dm, u, INSERT_VALUES, locU);CHKERRQ(ierr);
+  /* The first evaluation sets up the geometry and tabulation caches */
+  ierr = VecZeroEntries(locF);CHKERRQ(ierr);
+  ierr = DMPlexSNESComputeResidualFEM(dm, locU, locF, NULL);CHKERRQ(ierr);
+  ierr = MPI_Barrier(PetscObjectComm((PetscObject) dm));CHKERRMPI(ierr);
+  ierr = PetscTime(&t0);CHKERRQ(ierr);
+  for (k = 0; k < its; ++k) {
+    ierr = VecZeroEntries(locF);CHKERRQ(ierr);
+    ierr = DMPlexSNESComputeResidualFEM(dm, locU, locF, NULL);CHKERRQ(ierr);
+  }
+  ierr = MPI_Barrier(PetscObjectComm((PetscObject) dm));CHKERRMPI(ierr);
+  ierr = PetscTime(&t1);CHKERRQ(ierr);
+  ierr = VecZeroEntries(F);CHKERRQ(ierr);
+  ierr = DMLocalToGlobalBegin(dm, locF, ADD_VALUES, F);CHKERRQ(ierr);
+  ierr = DMLocalToGlobalEnd(dm, locF, ADD_VALUES, F);CHKERRQ(ierr);
+  ierr = VecNorm(F, NORM_2, norm);CHKERRQ(ierr);
+  ierr = ComputeBandwidth(dm, &bw, &span);CHKERRQ(ierr);
+  ierr = PetscPrintf(PetscObjectComm((PetscObject) dm), "%s: bandwidth %D, mean stratum span %.1f, residual norm %.6g\n", label, bw, (double) span, (double) *norm);CHKERRQ(ierr);
+  if (report) {
+    numCells = cEnd - cStart;
+    ierr = PetscPrintf(PetscObjectComm((PetscObject) dm), "%s: %g s per residual evaluation, %g cells/s on rank 0\n", label, its ? (t1-t0)/its : 0.0, t1 > t0 ? its*numCells/(t1-t0) : 0.0);CHKERRQ(ierr);
+  }
+  ierr = VecDestroy(&u);CHKERRQ(ierr);
+  ierr = VecDestroy(&F);CHKERRQ(ierr);
+  ierr = VecDestroy(&locU);CHKERRQ(ierr);
+  ierr = VecDestroy(&locF);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+int main(int argc, char **argv)
+{
+  DM                        dm, rdm;
+  IS                        perm;
+  DMPlexReorderLocalityType otype = DMPLEX_REORDER_LOCALITY_NONE;
+  PetscSection              parentSection, rparentSection;
+  PetscInt                  its = 1, treeCell = -1, cdim, rcdim;
+  PetscReal                 norm, rnorm;
+  PetscBool                 shuffle = PETSC_FALSE, report = PETSC_FALSE, reorder = PETSC_FALSE, sphere = PETSC_FALSE;
+  PetscErrorCode            ierr;
+
+  ierr = PetscInitialize(&argc, &argv, NULL, help);if (ierr) return ierr;
+  ierr = PetscOptionsBegin(PETSC_COMM_WORLD, "", "Locality Reordering Options", "DMPLEX");CHKERRQ(ierr);
+  ierr = PetscOptionsBool("-sphere", "Mesh the unit sphere embedded in 3D instead of a box", "ex70.c", sphere, &sphere, NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsInt("-tree_cell", "Refine this cell non-conformingly", "ex70.c", treeCell, &treeCell, NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsBool("-shuffle", "Randomly permute the points of the mesh", "ex70.c", shuffle, &shuffle, NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsEnum("-order_type", "Also reorder the mesh with this ordering", "DMPlexGetLocalityOrdering", DMPlexReorderLocalityTypes, (PetscEnum) otype, (PetscEnum *) &otype, &reorder);CHKERRQ(ierr);
+  ierr = PetscOptionsInt("-its", "The number of residual evaluations", "ex70.c", its, &its, NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsBool("-report", "Print the time per residual evaluation", "ex70.c", report, &report, NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsEnd();CHKERRQ(ierr);
+  if (sphere) {ierr = DMPlexCreateSphereMesh(PETSC_COMM_WORLD, 2, PETSC_FALSE, 1.0, &dm);CHKERRQ(ierr);}
+  else        {ierr = DMPlexCreateBoxMesh(PETSC_COMM_WORLD, 2, PETSC_FALSE, NULL, NULL, NULL, NULL, PETSC_TRUE, &dm);CHKERRQ(ierr);}
+  if (treeCell >= 0) {
+    DM refTree, ncdm = NULL;
+
+    ierr = DMPlexCreateDefaultReferenceTree(PETSC_COMM_WORLD, 2, PETSC_FALSE, &refTree);CHKERRQ(ierr);
+    ierr = DMPlexSetReferenceTree(dm, refTree);CHKERRQ(ierr);
+    ierr = DMDestroy(&refTree);CHKERRQ(ierr);
+    ierr = DMPlexTreeRefineCell(dm, treeCell, &ncdm);CHKERRQ(ierr);
+    if (ncdm) {
+      ierr = DMDestroy(&dm);CHKERRQ(ierr);
+      dm   = ncdm;
+    }
+  }
+  if (shuffle) {ierr = ShuffleMesh(&dm);CHKERRQ(ierr);}
+  ierr = DMSetFromOptions(dm);CHKERRQ(ierr);
+  ierr = DMViewFromOptions(dm, NULL, "-dm_view");CHKERRQ(ierr);
+  if (reorder) {
+    ierr = DMPlexGetLocalityOrdering(dm, otype, &perm);CHKERRQ(ierr);
+    ierr = DMPlexPermute(dm, perm, &rdm);CHKERRQ(ierr);
+    ierr = ISDestroy(&perm);CHKERRQ(ierr);
+    ierr = DMPlexCheckSymmetry(rdm);CHKERRQ(ierr);
+    ierr = DMPlexCheckSkeleton(rdm, 0);CHKERRQ(ierr);
+    ierr = DMPlexCheckFaces(rdm, 0);CHKERRQ(ierr);
+    ierr = DMPlexCheckPointSF(rdm);CHKERRQ(ierr);
+    ierr = DMGetCoordinateDim(dm, &cdim);CHKERRQ(ierr);
+    ierr = DMGetCoordinateDim(rdm, &rcdim);CHKERRQ(ierr);
+    if (rcdim != cdim) SETERRQ2(PETSC_COMM_WORLD, PETSC_ERR_PLIB, "Reordered mesh has coordinate dimension %D instead of %D", rcdim, cdim);
+    ierr = DMPlexGetTree(dm, &parentSection, NULL, NULL, NULL, NULL);CHKERRQ(ierr);
+    ierr = DMPlexGetTree(rdm, &rparentSection, NULL, NULL, NULL, NULL);CHKERRQ(ierr);
+    if (!parentSection != !rparentSection) SETERRQ(PETSC_COMM_WORLD, PETSC_ERR_PLIB, "Reordering did not keep the tree of the mesh");
+  }
+  ierr = EvaluateResidual(dm, "Original ", its, report, &norm);CHKERRQ(ierr);
+  if (reorder) {
+    ierr = EvaluateResidual(rdm, "Reordered", its, report, &rnorm);CHKERRQ(ierr);
+    ierr = PetscPrintf(PETSC_COMM_WORLD, "Residual norms %s\n", PetscAbsReal(rnorm - norm) <= 1.e-10*norm ? "agree" : "differ");CHKERRQ(ierr);
+    ierr = DMDestroy(&rdm);CHKERRQ(ierr);
+  }
+  ierr = DMDestroy(&dm);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+  test:
+    suffix: hilbert_2d
+    args: -dm_plex_box_faces 8,8 -petscspace_degree 2 -shuffle -order_type hilbert
+
+  test:
+    suffix: morton_3d
+    args: -dm_plex_box_dim 3 -dm_plex_box_faces 4,4,4 -petscspace_degree 2 -shuffle -order_type morton
+
+  test:
+    suffix: rcm_3d
+    args: -dm_plex_box_dim 3 -dm_plex_box_faces 4,4,4 -petscspace_degree 1 -shuffle -order_type rcm
+
+  test:
+    suffix: periodic
+    args: -dm_plex_box_faces 6,6 -dm_plex_box_bd periodic,none -petscspace_degree 2 -shuffle -order_type hilbert
+
+  test:
+    suffix: simplex
+    args: -dm_plex_box_faces 4,4 -dm_plex_cell_refiner tosimplex -dm_refine 1 -petscspace_degree 2 -shuffle -order_type hilbert
+
+  # The residual norm is the same as with the unordered mesh
+  testset:
+    nsize: 2
+    args: -dm_plex_box_faces 8,8 -petscspace_degree 2 -shuffle -dm_distribute -petscpartitioner_type simple
+    test:
+      suffix: dist_none
+    test:
+      suffix: dist_hilbert
+      args: -dm_plex_reorder_locality hilbert -order_type none
+    test:
+      suffix: dist_overlap
+      args: -dm_distribute_overlap 1 -dm_plex_reorder_locality rcm
+
+  # Embedded and non-conforming meshes keep their coordinate dimension and tree
+  test:
+    suffix: sphere
+    args: -sphere -dm_refine 2 -petscspace_degree 1 -shuffle -order_type hilbert -dm_plex_reorder_locality rcm
+
+  test:
+    suffix: tree
+    args: -dm_plex_box_faces 4,4 -tree_cell 5 -petscspace_degree 2 -shuffle -order_type rcm
+
+  test:
+    suffix: serial_morton
+    args: -dm_plex_box_faces 8,8 -petscspace_degree 2 -shuffle -dm_plex_reorder_locality morton
+
+TEST*/
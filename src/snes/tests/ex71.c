@@ -0,0 +1,194 @@
+static const char help[] = "Compares the FEM residual evaluated with and without batching the cells.\n\n";
+
+/*
+  Evaluates the residual of a nonlinear Poisson problem, with -vector coupled to a vector Laplacian and with -aux with a
+  variable coefficient in an auxiliary field, first cell by cell and then with PetscFESetBatched(), and checks that the
+  residuals agree. The batch size is the number of cells in a batch from PetscFEGetTileSizes(), which grows with
+  -petscfe_num_blocks. With -check the norms of the residual and of the difference are printed.
+*/
+#include <petscdmplex.h>
+#include <petscds.h>
+#include <petscsnes.h>
+
+static void f0_u(PetscInt dim, PetscInt Nf, PetscInt NfAux,
+                 const PetscInt uOff[], const PetscInt uOff_x[], const PetscScalar u[], const PetscScalar u_t[], const PetscScalar u_x[],
+                 const PetscInt aOff[], const PetscInt aOff_x[], const PetscScalar a[], const PetscScalar a_t[], const PetscScalar a_x[],
+                 PetscReal t, const PetscReal x[], PetscInt numConstants, const PetscScalar constants[], PetscScalar f0[])
+{
+  PetscInt d;
+
+  f0[0] = u[0]*u[0]*u[0] - x[0];
+  if (Nf > 1) for (d = 0; d < dim; ++d) f0[0] += u[uOff[1]+d]*u_x[d];
+}
+
+static void f1_u(PetscInt dim, PetscInt Nf, PetscInt NfAux,
+                 const PetscInt uOff[], const PetscInt uOff_x[], const PetscScalar u[], const PetscScalar u_t[], const PetscScalar u_x[],
+                 const PetscInt aOff[], const PetscInt aOff_x[], const PetscScalar a[], const PetscScalar a_t[], const PetscScalar a_x[],
+                 PetscReal t, const PetscReal x[], PetscInt numConstants, const PetscScalar constants[], PetscScalar f1[])
+{
+  PetscInt d;
+
+  for (d = 0; d < dim; ++d) f1[d] = (NfAux ? a[0] : 1.0)*u_x[d] + (NfAux ? a_x[d] : 0.0);
+}
+
+static void f0_v(PetscInt dim, PetscInt Nf, PetscInt NfAux,
+                 const PetscInt uOff[], const PetscInt uOff_x[], const PetscScalar u[], const PetscScalar u_t[], const PetscScalar u_x[],
+                 const PetscInt aOff[], const PetscInt aOff_x[], const PetscScalar a[], const PetscScalar a_t[], const PetscScalar a_x[],
+                 PetscReal t, const PetscReal x[], PetscInt numConstants, const PetscScalar constants[], PetscScalar f0[])
+{
+  PetscInt c;
+
+  for (c = 0; c < dim; ++c) f0[c] = u[0]*x[c];
+}
+
+static void f1_v(PetscInt dim, PetscInt Nf, PetscInt NfAux,
+                 const PetscInt uOff[], const PetscInt uOff_x[], const PetscScalar u[], const PetscScalar u_t[], const PetscScalar u_x[],
+                 const PetscInt aOff[], const PetscInt aOff_x[], const PetscScalar a[], const PetscScalar a_t[], const PetscScalar a_x[],
+                 PetscReal t, const PetscReal x[], PetscInt numConstants, const PetscScalar constants[], PetscScalar f1[])
+{
+  PetscInt c, d;
+
+  for (c = 0; c < dim; ++c) for (d = 0; d < dim; ++d) f1[c*dim+d] = u_x[uOff_x[1]+c*dim+d] + u_x[uOff_x[1]+d*dim+c];
+}
+
+static PetscErrorCode trig(PetscInt dim, PetscReal time, const PetscReal x[], PetscInt Nc, PetscScalar *u, void *ctx)
+{
+  PetscInt c, d;
+
+  for (c = 0; c < Nc; ++c) {
+    u[c] = c;
+    for (d = 0; d < dim; ++d) u[c] += PetscSinReal((c+d+1)*x[d]);
+  }
+  return 0;
+}
+
+static PetscErrorCode coefficient(PetscInt dim, PetscReal time, const PetscReal x[], PetscInt Nc, PetscScalar *u, void *ctx)
+{
+  PetscInt d;
+
+  u[0] = 1.0;
+  for (d = 0; d < dim; ++d) u[0] += x[d]*x[d];
+  return 0;
+}
+
+/* Evaluates the residual and returns it in F */
+static PetscErrorCode EvaluateResidual(DM dm, Vec locU, Vec F)
+{
+  Vec            locF;
+  PetscErrorCode ierr;
+
+  PetscFunctionBeginUser;
+  ierr = DMGetLocalVector(dm, &locF);CHKERRQ(ierr);
+  ierr = VecZeroEntries(locF);CHKERRQ(ierr);
+  ierr = DMPlexSNESComputeResidualFEM(dm, locU, locF, NULL);CHKERRQ(ierr);
+  ierr = VecZeroEntries(F);CHKERRQ(ierr);
+  ierr = DMLocalToGlobalBegin(dm, locF, ADD_VALUES, F);CHKERRQ(ierr);
+  ierr = DMLocalToGlobalEnd(dm, locF, ADD_VALUES, F);CHKERRQ(ierr);
+  ierr = DMRestoreLocalVector(dm, &locF);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+int main(int argc, char **argv)
+{
+  DM              dm, dmAux;
+  PetscFE         fe, feAux;
+  PetscDS         ds;
+  Vec             u, locU, nu, F[2];
+  PetscErrorCode (*funcs[2])(PetscInt, PetscReal, const PetscReal[], PetscInt, PetscScalar *, void *) = {trig, trig};
+  PetscErrorCode (*auxFuncs[1])(PetscInt, PetscReal, const PetscReal[], PetscInt, PetscScalar *, void *) = {coefficient};
+  DMPolytopeType  ct;
+  PetscInt        dim, cStart, cEnd, Nf, f, i;
+  PetscReal       norm, diff;
+  PetscBool       simplex, vector = PETSC_FALSE, aux = PETSC_FALSE, check = PETSC_FALSE;
+  PetscErrorCode  ierr;
+
+  ierr = PetscInitialize(&argc, &argv, NULL, help);if (ierr) return ierr;
+  ierr = PetscOptionsBegin(PETSC_COMM_WORLD, "", "Batched Residual Options", "PetscFE");CHKERRQ(ierr);
+  ierr = PetscOptionsBool("-vector", "Add a vector field", "ex71.c", vector, &vector, NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsBool("-aux", "Add an auxiliary coefficient field", "ex71.c", aux, &aux, NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsBool("-check", "Print the norms of the residual and of the difference", "ex71.c", check, &check, NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsEnd();CHKERRQ(ierr);
+  ierr = DMPlexCreateBoxMesh(PETSC_COMM_WORLD, 2, PETSC_FALSE, NULL, NULL, NULL, NULL, PETSC_TRUE, &dm);CHKERRQ(ierr);
+  ierr = DMSetFromOptions(dm);CHKERRQ(ierr);
+  ierr = DMViewFromOptions(dm, NULL, "-dm_view");CHKERRQ(ierr);
+  ierr = DMGetDimension(dm, &dim);CHKERRQ(ierr);
+  ierr = DMPlexGetHeightStratum(dm, 0, &cStart, &cEnd);CHKERRQ(ierr);
+  ierr = DMPlexGetCellType(dm, cStart, &ct);CHKERRQ(ierr);
+  simplex = DMPolytopeTypeGetNumVertices(ct) == DMPolytopeTypeGetDim(ct)+1 ? PETSC_TRUE : PETSC_FALSE;
+
+  ierr = PetscFECreateDefault(PETSC_COMM_WORLD, dim, 1, simplex, NULL, PETSC_DETERMINE, &fe);CHKERRQ(ierr);
+  ierr = DMSetField(dm, 0, NULL, (PetscObject) fe);CHKERRQ(ierr);
+  if (vector) {
+    PetscFE fev;
+
+    ierr = PetscFECreateDefault(PETSC_COMM_WORLD, dim, dim, simplex, "vel_", PETSC_DETERMINE, &fev);CHKERRQ(ierr);
+    ierr = PetscFECopyQuadrature(fe, fev);CHKERRQ(ierr);
+    ierr = DMSetField(dm, 1, NULL, (PetscObject) fev);CHKERRQ(ierr);
+    ierr = PetscFEDestroy(&fev);CHKERRQ(ierr);
+  }
+  ierr = DMCreateDS(dm);CHKERRQ(ierr);
+  ierr = DMGetDS(dm, &ds);CHKERRQ(ierr);
+  ierr = PetscDSSetResidual(ds, 0, f0_u, f1_u);CHKERRQ(ierr);
+  if (vector) {ierr = PetscDSSetResidual(ds, 1, f0_v, f1_v);CHKERRQ(ierr);}
+  if (aux) {
+    ierr = PetscFECreateDefault(PETSC_COMM_WORLD, dim, 1, simplex, "aux_", PETSC_DETERMINE, &feAux);CHKERRQ(ierr);
+    ierr = PetscFECopyQuadrature(fe, feAux);CHKERRQ(ierr);
+    ierr = DMClone(dm, &dmAux);CHKERRQ(ierr);
+    ierr = DMSetField(dmAux, 0, NULL, (PetscObject) feAux);CHKERRQ(ierr);
+    ierr = DMCreateDS(dmAux);CHKERRQ(ierr);
+    ierr = DMCreateLocalVector(dmAux, &nu);CHKERRQ(ierr);
+    ierr = DMProjectFunctionLocal(dmAux, 0.0, auxFuncs, NULL, INSERT_ALL_VALUES, nu);CHKERRQ(ierr);
+    ierr = DMSetAuxiliaryVec(dm, NULL, 0, nu);CHKERRQ(ierr);
+    ierr = VecDestroy(&nu);CHKERRQ(ierr);
+    ierr = DMDestroy(&dmAux);CHKERRQ(ierr);
+    ierr = PetscFEDestroy(&feAux);CHKERRQ(ierr);
+  }
+  ierr = PetscFEDestroy(&fe);CHKERRQ(ierr);
+
+  ierr = DMCreateGlobalVector(dm, &u);CHKERRQ(ierr);
+  ierr = DMCreateLocalVector(dm, &locU);CHKERRQ(ierr);
+  ierr = DMProjectFunction(dm, 0.0, funcs, NULL, INSERT_ALL_VALUES, u);CHKERRQ(ierr);
+  ierr = DMGlobalToLocalBegin(dm, u, INSERT_VALUES, locU);CHKERRQ(ierr);
+  ierr = DMGlobalToLocalEnd(dm, u, INSERT_VALUES, locU);CHKERRQ(ierr);
+  ierr = PetscDSGetNumFields(ds, &Nf);CHKERRQ(ierr);
+  for (i = 0; i < 2; ++i) {
+    for (f = 0; f < Nf; ++f) {
+      ierr = PetscDSGetDiscretization(ds, f, (PetscObject *) &fe);CHKERRQ(ierr);
+      ierr = PetscFESetBatched(fe, i ? PETSC_TRUE : PETSC_FALSE);CHKERRQ(ierr);
+    }
+    ierr = VecDuplicate(u, &F[i]);CHKERRQ(ierr);
+    ierr = EvaluateResidual(dm, locU, F[i]);CHKERRQ(ierr);
+  }
+  ierr = VecNorm(F[0], NORM_2, &norm);CHKERRQ(ierr);
+  ierr = VecAXPY(F[1], -1.0, F[0]);CHKERRQ(ierr);
+  ierr = VecNorm(F[1], NORM_2, &diff);CHKERRQ(ierr);
+  if (check) {ierr = PetscPrintf(PETSC_COMM_WORLD, "Residual norm %g, difference of the batched residual %g\n", (double) norm, (double) diff);CHKERRQ(ierr);}
+  if (diff > 1.e-12*norm) {ierr = PetscPrintf(PETSC_COMM_WORLD, "Error: batched and unbatched residuals differ by %g\n", (double) diff);CHKERRQ(ierr);}
+  for (i = 0; i < 2; ++i) {ierr = VecDestroy(&F[i]);CHKERRQ(ierr);}
+  ierr = VecDestroy(&u);CHKERRQ(ierr);
+  ierr = VecDestroy(&locU);CHKERRQ(ierr);
+  ierr = DMDestroy(&dm);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+  test:
+    suffix: q2
+    args: -check -dm_plex_box_faces 5,5 -petscspace_degree 2
+
+  test:
+    suffix: p2_vector_aux
+    args: -check -dm_plex_box_faces 3,3 -dm_plex_cell_refiner tosimplex -dm_refine 1 -petscspace_degree 2 -vel_petscspace_degree 2 -vector -aux -aux_petscspace_degree 1
+
+  test:
+    suffix: q1_3d
+    args: -check -dm_plex_box_dim 3 -dm_plex_box_faces 3,3,3 -petscspace_degree 1 -vector -vel_petscspace_degree 1 -petscfe_num_blocks 3
+
+  test:
+    suffix: p1_3d_aux
+    nsize: 2
+    args: -check -dm_plex_box_dim 3 -dm_plex_box_faces 2,2,2 -dm_plex_cell_refiner tosimplex -dm_refine 1 -dm_distribute -petscpartitioner_type simple -petscspace_degree 1 -aux -aux_petscspace_degree 2
+
+TEST*/
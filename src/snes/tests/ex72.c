@@ -0,0 +1,332 @@
+static const char help[] = "Compares the matrix-free sum factorized FEM Jacobian with the assembled Jacobian.\n\n";
+
+/*
+  Forms the Jacobian of a nonlinear Poisson problem, with -vector coupled to a vector Laplacian and with -aux with a
+  variable coefficient in an auxiliary field, once assembled and once with DMPlexCreateMatrixFree(), and checks that
+  their action and diagonal agree. With -check the norms of the assembled action and diagonal and of their differences
+  are printed. With -solve the problem is solved with the matrix-free Jacobian on every level.
+
+  Usage: ./ex72 -dm_plex_box_dim 3 -dm_refine_hierarchy 2 -petscspace_degree 2 -solve -ksp_type gmres -pc_type mg
+           -mg_levels_ksp_type chebyshev -mg_levels_pc_type jacobi -mg_coarse_ksp_type gmres -mg_coarse_pc_type jacobi
+*/
+#include <petscdmplex.h>
+#include <petscds.h>
+#include <petscsnes.h>
+
+static void f0_u(PetscInt dim, PetscInt Nf, PetscInt NfAux,
+                 const PetscInt uOff[], const PetscInt uOff_x[], const PetscScalar u[], const PetscScalar u_t[], const PetscScalar u_x[],
+                 const PetscInt aOff[], const PetscInt aOff_x[], const PetscScalar a[], const PetscScalar a_t[], const PetscScalar a_x[],
+                 PetscReal t, const PetscReal x[], PetscInt numConstants, const PetscScalar constants[], PetscScalar f0[])
+{
+  PetscInt d;
+
+  f0[0] = u[0]*u[0]*u[0] - 1.0;
+  if (Nf > 1) for (d = 0; d < dim; ++d) f0[0] += u[uOff[1]+d]*u_x[d];
+}
+
+static void f1_u(PetscInt dim, PetscInt Nf, PetscInt NfAux,
+                 const PetscInt uOff[], const PetscInt uOff_x[], const PetscScalar u[], const PetscScalar u_t[], const PetscScalar u_x[],
+                 const PetscInt aOff[], const PetscInt aOff_x[], const PetscScalar a[], const PetscScalar a_t[], const PetscScalar a_x[],
+                 PetscReal t, const PetscReal x[], PetscInt numConstants, const PetscScalar constants[], PetscScalar f1[])
+{
+  PetscInt d;
+
+  for (d = 0; d < dim; ++d) f1[d] = (NfAux ? a[0] : 1.0)*(1.0 + u[0]*u[0])*u_x[d];
+}
+
+static void g0_uu(PetscInt dim, PetscInt Nf, PetscInt NfAux,
+                  const PetscInt uOff[], const PetscInt uOff_x[], const PetscScalar u[], const PetscScalar u_t[], const PetscScalar u_x[],
+                  const PetscInt aOff[], const PetscInt aOff_x[], const PetscScalar a[], const PetscScalar a_t[], const PetscScalar a_x[],
+                  PetscReal t, PetscReal u_tShift, const PetscReal x[], PetscInt numConstants, const PetscScalar constants[], PetscScalar g0[])
+{
+  g0[0] = 3.0*u[0]*u[0];
+}
+
+static void g1_uu(PetscInt dim, PetscInt Nf, PetscInt NfAux,
+                  const PetscInt uOff[], const PetscInt uOff_x[], const PetscScalar u[], const PetscScalar u_t[], const PetscScalar u_x[],
+                  const PetscInt aOff[], const PetscInt aOff_x[], const PetscScalar a[], const PetscScalar a_t[], const PetscScalar a_x[],
+                  PetscReal t, PetscReal u_tShift, const PetscReal x[], PetscInt numConstants, const PetscScalar constants[], PetscScalar g1[])
+{
+  PetscInt d;
+
+  for (d = 0; d < dim; ++d) g1[d] = u[uOff[1]+d];
+}
+
+static void g2_uu(PetscInt dim, PetscInt Nf, PetscInt NfAux,
+                  const PetscInt uOff[], const PetscInt uOff_x[], const PetscScalar u[], const PetscScalar u_t[], const PetscScalar u_x[],
+                  const PetscInt aOff[], const PetscInt aOff_x[], const PetscScalar a[], const PetscScalar a_t[], const PetscScalar a_x[],
+                  PetscReal t, PetscReal u_tShift, const PetscReal x[], PetscInt numConstants, const PetscScalar constants[], PetscScalar g2[])
+{
+  PetscInt d;
+
+  for (d = 0; d < dim; ++d) g2[d] = (NfAux ? a[0] : 1.0)*2.0*u[0]*u_x[d];
+}
+
+static void g3_uu(PetscInt dim, PetscInt Nf, PetscInt NfAux,
+                  const PetscInt uOff[], const PetscInt uOff_x[], const PetscScalar u[], const PetscScalar u_t[], const PetscScalar u_x[],
+                  const PetscInt aOff[], const PetscInt aOff_x[], const PetscScalar a[], const PetscScalar a_t[], const PetscScalar a_x[],
+                  PetscReal t, PetscReal u_tShift, const PetscReal x[], PetscInt numConstants, const PetscScalar constants[], PetscScalar g3[])
+{
+  PetscInt d;
+
+  for (d = 0; d < dim; ++d) g3[d*dim+d] = (NfAux ? a[0] : 1.0)*(1.0 + u[0]*u[0]);
+}
+
+static void g0_uv(PetscInt dim, PetscInt Nf, PetscInt NfAux,
+                  const PetscInt uOff[], const PetscInt uOff_x[], const PetscScalar u[], const PetscScalar u_t[], const PetscScalar u_x[],
+                  const PetscInt aOff[], const PetscInt aOff_x[], const PetscScalar a[], const PetscScalar a_t[], const PetscScalar a_x[],
+                  PetscReal t, PetscReal u_tShift, const PetscReal x[], PetscInt numConstants, const PetscScalar constants[], PetscScalar g0[])
+{
+  PetscInt d;
+
+  for (d = 0; d < dim; ++d) g0[d] = u_x[d];
+}
+
+static void f0_v(PetscInt dim, PetscInt Nf, PetscInt NfAux,
+                 const PetscInt uOff[], const PetscInt uOff_x[], const PetscScalar u[], const PetscScalar u_t[], const PetscScalar u_x[],
+                 const PetscInt aOff[], const PetscInt aOff_x[], const PetscScalar a[], const PetscScalar a_t[], const PetscScalar a_x[],
+                 PetscReal t, const PetscReal x[], PetscInt numConstants, const PetscScalar constants[], PetscScalar f0[])
+{
+  PetscInt c;
+
+  for (c = 0; c < dim; ++c) f0[c] = u[0]*x[c];
+}
+
+static void f1_v(PetscInt dim, PetscInt Nf, PetscInt NfAux,
+                 const PetscInt uOff[], const PetscInt uOff_x[], const PetscScalar u[], const PetscScalar u_t[], const PetscScalar u_x[],
+                 const PetscInt aOff[], const PetscInt aOff_x[], const PetscScalar a[], const PetscScalar a_t[], const PetscScalar a_x[],
+                 PetscReal t, const PetscReal x[], PetscInt numConstants, const PetscScalar constants[], PetscScalar f1[])
+{
+  PetscInt c, d;
+
+  for (c = 0; c < dim; ++c) for (d = 0; d < dim; ++d) f1[c*dim+d] = u_x[uOff_x[1]+c*dim+d] + u_x[uOff_x[1]+d*dim+c];
+}
+
+static void g0_vu(PetscInt dim, PetscInt Nf, PetscInt NfAux,
+                  const PetscInt uOff[], const PetscInt uOff_x[], const PetscScalar u[], const PetscScalar u_t[], const PetscScalar u_x[],
+                  const PetscInt aOff[], const PetscInt aOff_x[], const PetscScalar a[], const PetscScalar a_t[], const PetscScalar a_x[],
+                  PetscReal t, PetscReal u_tShift, const PetscReal x[], PetscInt numConstants, const PetscScalar constants[], PetscScalar g0[])
+{
+  PetscInt c;
+
+  for (c = 0; c < dim; ++c) g0[c] = x[c];
+}
+
+static void g3_vv(PetscInt dim, PetscInt Nf, PetscInt NfAux,
+                  const PetscInt uOff[], const PetscInt uOff_x[], const PetscScalar u[], const PetscScalar u_t[], const PetscScalar u_x[],
+                  const PetscInt aOff[], const PetscInt aOff_x[], const PetscScalar a[], const PetscScalar a_t[], const PetscScalar a_x[],
+                  PetscReal t, PetscReal u_tShift, const PetscReal x[], PetscInt numConstants, const PetscScalar constants[], PetscScalar g3[])
+{
+  PetscInt c, d;
+
+  for (c = 0; c < dim; ++c) {
+    for (d = 0; d < dim; ++d) {
+      g3[((c*dim+c)*dim+d)*dim+d] += 1.0;
+      g3[((c*dim+d)*dim+d)*dim+c] += 1.0;
+    }
+  }
+}
+
+static PetscErrorCode trig(PetscInt dim, PetscReal time, const PetscReal x[], PetscInt Nc, PetscScalar *u, void *ctx)
+{
+  PetscInt c, d;
+
+  for (c = 0; c < Nc; ++c) {
+    u[c] = c;
+    for (d = 0; d < dim; ++d) u[c] += PetscSinReal((c+d+1)*x[d]);
+  }
+  return 0;
+}
+
+static PetscErrorCode zero(PetscInt dim, PetscReal time, const PetscReal x[], PetscInt Nc, PetscScalar *u, void *ctx)
+{
+  PetscInt c;
+
+  for (c = 0; c < Nc; ++c) u[c] = 0.0;
+  return 0;
+}
+
+static PetscErrorCode coefficient(PetscInt dim, PetscReal time, const PetscReal x[], PetscInt Nc, PetscScalar *u, void *ctx)
+{
+  PetscInt d;
+
+  u[0] = 1.0;
+  for (d = 0; d < dim; ++d) u[0] += x[d]*x[d];
+  return 0;
+}
+
+static PetscErrorCode SetupDiscretization(DM dm, PetscBool vector, PetscBool aux)
+{
+  DM             cdm = dm;
+  PetscFE        fe, fev = NULL;
+  PetscDS        ds;
+  DMLabel        label;
+  DMPolytopeType ct;
+  PetscInt       dim, cStart, id = 1;
+  PetscBool      simplex;
+  PetscErrorCode ierr;
+
+  PetscFunctionBeginUser;
+  ierr = DMGetDimension(dm, &dim);CHKERRQ(ierr);
+  ierr = DMPlexGetHeightStratum(dm, 0, &cStart, NULL);CHKERRQ(ierr);
+  ierr = DMPlexGetCellType(dm, cStart, &ct);CHKERRQ(ierr);
+  simplex = DMPolytopeTypeGetNumVertices(ct) == DMPolytopeTypeGetDim(ct)+1 ? PETSC_TRUE : PETSC_FALSE;
+  ierr = PetscFECreateDefault(PETSC_COMM_WORLD, dim, 1, simplex, NULL, PETSC_DETERMINE, &fe);CHKERRQ(ierr);
+  ierr = DMSetField(dm, 0, NULL, (PetscObject) fe);CHKERRQ(ierr);
+  if (vector) {
+    ierr = PetscFECreateDefault(PETSC_COMM_WORLD, dim, dim, simplex, "vel_", PETSC_DETERMINE, &fev);CHKERRQ(ierr);
+    ierr = PetscFECopyQuadrature(fe, fev);CHKERRQ(ierr);
+    ierr = DMSetField(dm, 1, NULL, (PetscObject) fev);CHKERRQ(ierr);
+  }
+  ierr = DMCreateDS(dm);CHKERRQ(ierr);
+  ierr = DMGetDS(dm, &ds);CHKERRQ(ierr);
+  ierr = PetscDSSetResidual(ds, 0, f0_u, f1_u);CHKERRQ(ierr);
+  ierr = PetscDSSetJacobian(ds, 0, 0, g0_uu, vector ? g1_uu : NULL, g2_uu, g3_uu);CHKERRQ(ierr);
+  if (vector) {
+    ierr = PetscDSSetResidual(ds, 1, f0_v, f1_v);CHKERRQ(ierr);
+    ierr = PetscDSSetJacobian(ds, 0, 1, g0_uv, NULL, NULL, NULL);CHKERRQ(ierr);
+    ierr = PetscDSSetJacobian(ds, 1, 0, g0_vu, NULL, NULL, NULL);CHKERRQ(ierr);
+    ierr = PetscDSSetJacobian(ds, 1, 1, NULL, NULL, NULL, g3_vv);CHKERRQ(ierr);
+  }
+  ierr = DMGetLabel(dm, "marker", &label);CHKERRQ(ierr);
+  ierr = DMAddBoundary(dm, DM_BC_ESSENTIAL, "wall", label, 1, &id, 0, 0, NULL, (void (*)(void)) zero, NULL, NULL, NULL);CHKERRQ(ierr);
+  if (vector) {ierr = DMAddBoundary(dm, DM_BC_ESSENTIAL, "wall_vel", label, 1, &id, 1, 0, NULL, (void (*)(void)) zero, NULL, NULL, NULL);CHKERRQ(ierr);}
+  while (cdm) {
+    ierr = DMCopyDisc(dm, cdm);CHKERRQ(ierr);
+    if (aux) {
+      PetscErrorCode (*auxFuncs[1])(PetscInt, PetscReal, const PetscReal[], PetscInt, PetscScalar *, void *) = {coefficient};
+      DM               dmAux;
+      PetscFE          feAux;
+      Vec              nu;
+
+      ierr = PetscFECreateDefault(PETSC_COMM_WORLD, dim, 1, simplex, "aux_", PETSC_DETERMINE, &feAux);CHKERRQ(ierr);
+      ierr = PetscFECopyQuadrature(fe, feAux);CHKERRQ(ierr);
+      ierr = DMClone(cdm, &dmAux);CHKERRQ(ierr);
+      ierr = DMSetField(dmAux, 0, NULL, (PetscObject) feAux);CHKERRQ(ierr);
+      ierr = DMCreateDS(dmAux);CHKERRQ(ierr);
+      ierr = DMCreateLocalVector(dmAux, &nu);CHKERRQ(ierr);
+      ierr = DMProjectFunctionLocal(dmAux, 0.0, auxFuncs, NULL, INSERT_ALL_VALUES, nu);CHKERRQ(ierr);
+      ierr = DMSetAuxiliaryVec(cdm, NULL, 0, nu);CHKERRQ(ierr);
+      ierr = VecDestroy(&nu);CHKERRQ(ierr);
+      ierr = DMDestroy(&dmAux);CHKERRQ(ierr);
+      ierr = PetscFEDestroy(&feAux);CHKERRQ(ierr);
+    }
+    ierr = DMGetCoarseDM(cdm, &cdm);CHKERRQ(ierr);
+  }
+  ierr = PetscFEDestroy(&fe);CHKERRQ(ierr);
+  ierr = PetscFEDestroy(&fev);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+int main(int argc, char **argv)
+{
+  DM              dm;
+  SNES            snes;
+  Mat             J, Jmf;
+  Vec             u, locU, x, y[2], d[2];
+  PetscErrorCode (*funcs[2])(PetscInt, PetscReal, const PetscReal[], PetscInt, PetscScalar *, void *) = {trig, trig};
+  PetscRandom     rand;
+  PetscInt        i;
+  PetscReal       norm, diff, dnorm, ddiff;
+  PetscBool       vector = PETSC_FALSE, aux = PETSC_FALSE, solve = PETSC_FALSE, check = PETSC_FALSE;
+  PetscErrorCode  ierr;
+
+  ierr = PetscInitialize(&argc, &argv, NULL, help);if (ierr) return ierr;
+  ierr = PetscOptionsBegin(PETSC_COMM_WORLD, "", "Matrix-free Jacobian Options", "DMPLEX");CHKERRQ(ierr);
+  ierr = PetscOptionsBool("-vector", "Add a vector field", "ex72.c", vector, &vector, NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsBool("-aux", "Add an auxiliary coefficient field", "ex72.c", aux, &aux, NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsBool("-solve", "Solve the problem with the matrix-free Jacobian", "ex72.c", solve, &solve, NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsBool("-check", "Print the norms of the assembled action and diagonal and of the differences", "ex72.c", check, &check, NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsEnd();CHKERRQ(ierr);
+  ierr = DMPlexCreateBoxMesh(PETSC_COMM_WORLD, 2, PETSC_FALSE, NULL, NULL, NULL, NULL, PETSC_TRUE, &dm);CHKERRQ(ierr);
+  ierr = DMSetFromOptions(dm);CHKERRQ(ierr);
+  ierr = DMViewFromOptions(dm, NULL, "-dm_view");CHKERRQ(ierr);
+  ierr = SetupDiscretization(dm, vector, aux);CHKERRQ(ierr);
+
+  ierr = DMCreateGlobalVector(dm, &u);CHKERRQ(ierr);
+  ierr = DMCreateLocalVector(dm, &locU);CHKERRQ(ierr);
+  ierr = DMProjectFunction(dm, 0.0, funcs, NULL, INSERT_ALL_VALUES, u);CHKERRQ(ierr);
+  ierr = DMPlexInsertBoundaryValues(dm, PETSC_TRUE, locU, 0.0, NULL, NULL, NULL);CHKERRQ(ierr);
+  ierr = DMGlobalToLocalBegin(dm, u, INSERT_VALUES, locU);CHKERRQ(ierr);
+  ierr = DMGlobalToLocalEnd(dm, u, INSERT_VALUES, locU);CHKERRQ(ierr);
+  /* The assembled Jacobian */
+  ierr = DMSetMatType(dm, MATAIJ);CHKERRQ(ierr);
+  ierr = DMCreateMatrix(dm, &J);CHKERRQ(ierr);
+  ierr = DMPlexSNESComputeJacobianFEM(dm, locU, J, J, NULL);CHKERRQ(ierr);
+  /* The matrix-free Jacobian */
+  ierr = DMPlexCreateMatrixFree(dm, &Jmf);CHKERRQ(ierr);
+  ierr = DMPlexSNESComputeJacobianFEM(dm, locU, Jmf, Jmf, NULL);CHKERRQ(ierr);
+
+  ierr = VecDuplicate(u, &x);CHKERRQ(ierr);
+  ierr = PetscRandomCreate(PETSC_COMM_WORLD, &rand);CHKERRQ(ierr);
+  ierr = VecSetRandom(x, rand);CHKERRQ(ierr);
+  ierr = PetscRandomDestroy(&rand);CHKERRQ(ierr);
+  for (i = 0; i < 2; ++i) {
+    ierr = VecDuplicate(u, &y[i]);CHKERRQ(ierr);
+    ierr = VecDuplicate(u, &d[i]);CHKERRQ(ierr);
+    ierr = MatMult(i ? Jmf : J, x, y[i]);CHKERRQ(ierr);
+    ierr = MatGetDiagonal(i ? Jmf : J, d[i]);CHKERRQ(ierr);
+  }
+  ierr = VecNorm(y[0], NORM_2, &norm);CHKERRQ(ierr);
+  ierr = VecAXPY(y[1], -1.0, y[0]);CHKERRQ(ierr);
+  ierr = VecNorm(y[1], NORM_2, &diff);CHKERRQ(ierr);
+  ierr = VecNorm(d[0], NORM_2, &dnorm);CHKERRQ(ierr);
+  ierr = VecAXPY(d[1], -1.0, d[0]);CHKERRQ(ierr);
+  ierr = VecNorm(d[1], NORM_2, &ddiff);CHKERRQ(ierr);
+  if (check) {
+    ierr = PetscPrintf(PETSC_COMM_WORLD, "Assembled action norm %g, difference of the matrix-free action %g\n", (double) norm, (double) diff);CHKERRQ(ierr);
+    ierr = PetscPrintf(PETSC_COMM_WORLD, "Assembled diagonal norm %g, difference of the matrix-free diagonal %g\n", (double) dnorm, (double) ddiff);CHKERRQ(ierr);
+  }
+  if (diff > 1.e-10*norm)   {ierr = PetscPrintf(PETSC_COMM_WORLD, "Error: matrix-free and assembled actions differ by %g\n", (double) diff);CHKERRQ(ierr);}
+  if (ddiff > 1.e-10*dnorm) {ierr = PetscPrintf(PETSC_COMM_WORLD, "Error: matrix-free and assembled diagonals differ by %g\n", (double) ddiff);CHKERRQ(ierr);}
+  for (i = 0; i < 2; ++i) {
+    ierr = VecDestroy(&y[i]);CHKERRQ(ierr);
+    ierr = VecDestroy(&d[i]);CHKERRQ(ierr);
+  }
+  ierr = VecDestroy(&x);CHKERRQ(ierr);
+  ierr = MatDestroy(&J);CHKERRQ(ierr);
+  ierr = MatDestroy(&Jmf);CHKERRQ(ierr);
+
+  if (solve) {
+    DM cdm = dm;
+
+    /* Every level gets the matrix-free Jacobian from DMCreateMatrix() */
+    while (cdm) {
+      ierr = DMSetMatType(cdm, MATSHELL);CHKERRQ(ierr);
+      ierr = DMGetCoarseDM(cdm, &cdm);CHKERRQ(ierr);
+    }
+    ierr = SNESCreate(PETSC_COMM_WORLD, &snes);CHKERRQ(ierr);
+    ierr = SNESSetDM(snes, dm);CHKERRQ(ierr);
+    ierr = DMPlexSetSNESLocalFEM(dm, NULL, NULL, NULL);CHKERRQ(ierr);
+    ierr = SNESSetFromOptions(snes);CHKERRQ(ierr);
+    ierr = VecSet(u, 0.0);CHKERRQ(ierr);
+    ierr = SNESSolve(snes, NULL, u);CHKERRQ(ierr);
+    ierr = SNESDestroy(&snes);CHKERRQ(ierr);
+  }
+  ierr = VecDestroy(&u);CHKERRQ(ierr);
+  ierr = VecDestroy(&locU);CHKERRQ(ierr);
+  ierr = DMDestroy(&dm);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+  test:
+    suffix: q2
+    args: -check -dm_plex_box_faces 3,3 -petscspace_degree 2
+
+  test:
+    suffix: q3_vector_aux
+    args: -check -dm_plex_box_faces 2,3 -petscspace_degree 3 -vel_petscspace_degree 3 -vector -aux -aux_petscspace_degree 1
+
+  test:
+    suffix: q2_3d
+    nsize: 2
+    args: -check -dm_plex_box_dim 3 -dm_plex_box_faces 2,2,3 -dm_distribute -petscpartitioner_type simple -petscspace_degree 2 -vector -vel_petscspace_degree 2
+
+  test:
+    suffix: q2_mg
+    args: -check -dm_plex_box_faces 2,2 -dm_refine_hierarchy 2 -petscspace_degree 2 -aux -aux_petscspace_degree 2 -solve -snes_converged_reason -snes_rtol 1.e-8 -ksp_type gmres -ksp_rtol 1.e-10 -pc_type mg -pc_mg_levels 3 -mg_levels_ksp_type chebyshev -mg_levels_pc_type jacobi -mg_coarse_ksp_type gmres -mg_coarse_ksp_rtol 1.e-12 -mg_coarse_pc_type jacobi
+
+TEST*/
@@ -1528,9 +1528,12 @@ PetscErrorCode DMPlexComputeJacobianAction(DM dm, IS cellIS, PetscReal t, PetscR
   We form the residual one batch of elements at a time. This allows us to offload work onto an accelerator,
   like a GPU, or vectorize on a multicore machine.
 
+  If Jac is the matrix-free operator from DMPlexCreateMatrixFree(), only its pointwise data is computed, and JacP is
+  assembled if it is a different matrix.
+
   Level: developer
 
-.seealso: FormFunctionLocal()
+.seealso: FormFunctionLocal(), DMPlexCreateMatrixFree()
 @*/
 PetscErrorCode DMPlexSNESComputeJacobianFEM(DM dm, Vec X, Mat Jac, Mat JacP,void *user)
 {
@@ -1538,10 +1541,18 @@ PetscErrorCode DMPlexSNESComputeJacobianFEM(DM dm, Vec X, Mat Jac, Mat JacP,void
   IS             allcellIS;
   PetscBool      hasJac, hasPrec;
   PetscInt       Nds, s;
+  PetscErrorCode (*matfree)(DM, PetscReal, Vec, Mat);
   PetscErrorCode ierr;
 
   PetscFunctionBegin;
   ierr = DMSNESConvertPlex(dm, &plex, PETSC_TRUE);CHKERRQ(ierr);
+  ierr = PetscObjectQueryFunction((PetscObject) Jac, "DMPlexComputeJacobianMatrixFree_C", &matfree);CHKERRQ(ierr);
+  if (matfree) {
+    /* Only the pointwise data is computed for the operator, and the preconditioner is assembled if it is separate */
+    ierr = DMPlexComputeJacobianMatrixFree(plex, 0.0, X, Jac);CHKERRQ(ierr);
+    if (JacP == Jac) {ierr = DMDestroy(&plex);CHKERRQ(ierr); PetscFunctionReturn(0);}
+    Jac  = JacP;
+  }
   ierr = DMPlexGetAllCells_Internal(plex, &allcellIS);CHKERRQ(ierr);
   ierr = DMGetNumDS(dm, &Nds);CHKERRQ(ierr);
   for (s = 0; s < Nds; ++s) {
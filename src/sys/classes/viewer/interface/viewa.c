@@ -38,6 +38,7 @@ const char *const PetscViewerFormats[] = {
   "HDF5_VIZ",
   "HDF5_XDMF",
   "HDF5_MAT",
+  "ASCII_CHROME_TRACE",
   "NOFORMAT",
   "LOAD_BALANCE",
   "FAILED",
@@ -135,7 +136,8 @@ PetscErrorCode  PetscViewerSetFormat(PetscViewer viewer,PetscViewerFormat format
 .    PETSC_VIEWER_DRAW_BASIC - views the vector with a simple 1d plot
 .    PETSC_VIEWER_DRAW_LG - views the vector with a line graph
 .    PETSC_VIEWER_DRAW_CONTOUR - views the vector with a contour plot
--    PETSC_VIEWER_ASCII_XML - saves the data in XML format, needed for PetscLogView() when viewing with PetscLogNestedBegin()
+.    PETSC_VIEWER_ASCII_XML - saves the data in XML format, needed for PetscLogView() when viewing with PetscLogNestedBegin()
+-    PETSC_VIEWER_ASCII_CHROME_TRACE - saves a timeline in the Trace Event Format, needed for PetscLogView() when viewing with PetscLogChromeTraceBegin()
 
    These formats are most often used for viewing matrices and vectors.
    Currently, the object name is used only in the MATLAB format.
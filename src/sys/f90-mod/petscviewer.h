@@ -60,24 +60,26 @@
       PetscEnum, parameter :: PETSC_VIEWER_ASCII_FACTOR_INFO = 16
       PetscEnum, parameter :: PETSC_VIEWER_ASCII_LATEX = 17
       PetscEnum, parameter :: PETSC_VIEWER_ASCII_XML = 18
-      PetscEnum, parameter :: PETSC_VIEWER_ASCII_GLVIS = 19
-      PetscEnum, parameter :: PETSC_VIEWER_ASCII_CSV = 20
-      PetscEnum, parameter :: PETSC_VIEWER_DRAW_BASIC = 21
-      PetscEnum, parameter :: PETSC_VIEWER_DRAW_LG = 22
-      PetscEnum, parameter :: PETSC_VIEWER_DRAW_LG_XRANGE = 23
-      PetscEnum, parameter :: PETSC_VIEWER_DRAW_CONTOUR = 24
-      PetscEnum, parameter :: PETSC_VIEWER_DRAW_PORTS = 25
-      PetscEnum, parameter :: PETSC_VIEWER_VTK_VTS = 26
-      PetscEnum, parameter :: PETSC_VIEWER_VTK_VTR = 27
-      PetscEnum, parameter :: PETSC_VIEWER_VTK_VTU = 28
-      PetscEnum, parameter :: PETSC_VIEWER_BINARY_MATLAB = 29
-      PetscEnum, parameter :: PETSC_VIEWER_NATIVE = 30
-      PetscEnum, parameter :: PETSC_VIEWER_HDF5_PETSC = 31
-      PetscEnum, parameter :: PETSC_VIEWER_HDF5_VIZ = 32
-      PetscEnum, parameter :: PETSC_VIEWER_HDF5_XDMF = 33
-      PetscEnum, parameter :: PETSC_VIEWER_HDF5_MAT = 34
-      PetscEnum, parameter :: PETSC_VIEWER_NOFORMAT = 35
-      PetscEnum, parameter :: PETSC_VIEWER_LOAD_BALANCE = 36
+      PetscEnum, parameter :: PETSC_VIEWER_ASCII_FLAMEGRAPH = 19
+      PetscEnum, parameter :: PETSC_VIEWER_ASCII_GLVIS = 20
+      PetscEnum, parameter :: PETSC_VIEWER_ASCII_CSV = 21
+      PetscEnum, parameter :: PETSC_VIEWER_DRAW_BASIC = 22
+      PetscEnum, parameter :: PETSC_VIEWER_DRAW_LG = 23
+      PetscEnum, parameter :: PETSC_VIEWER_DRAW_LG_XRANGE = 24
+      PetscEnum, parameter :: PETSC_VIEWER_DRAW_CONTOUR = 25
+      PetscEnum, parameter :: PETSC_VIEWER_DRAW_PORTS = 26
+      PetscEnum, parameter :: PETSC_VIEWER_VTK_VTS = 27
+      PetscEnum, parameter :: PETSC_VIEWER_VTK_VTR = 28
+      PetscEnum, parameter :: PETSC_VIEWER_VTK_VTU = 29
+      PetscEnum, parameter :: PETSC_VIEWER_BINARY_MATLAB = 30
+      PetscEnum, parameter :: PETSC_VIEWER_NATIVE = 31
+      PetscEnum, parameter :: PETSC_VIEWER_HDF5_PETSC = 32
+      PetscEnum, parameter :: PETSC_VIEWER_HDF5_VIZ = 33
+      PetscEnum, parameter :: PETSC_VIEWER_HDF5_XDMF = 34
+      PetscEnum, parameter :: PETSC_VIEWER_HDF5_MAT = 35
+      PetscEnum, parameter :: PETSC_VIEWER_ASCII_CHROME_TRACE = 36
+      PetscEnum, parameter :: PETSC_VIEWER_NOFORMAT = 37
+      PetscEnum, parameter :: PETSC_VIEWER_LOAD_BALANCE = 38
 
 #if defined(_WIN32) && defined(PETSC_USE_SHARED_LIBRARIES)
 !DEC$ ATTRIBUTES DLLEXPORT::PETSC_NULL_VIEWER
@@ -117,6 +119,7 @@
 !DEC$ ATTRIBUTES DLLEXPORT::PETSC_VIEWER_ASCII_FACTOR_INFO
 !DEC$ ATTRIBUTES DLLEXPORT::PETSC_VIEWER_ASCII_LATEX
 !DEC$ ATTRIBUTES DLLEXPORT::PETSC_VIEWER_ASCII_XML
+!DEC$ ATTRIBUTES DLLEXPORT::PETSC_VIEWER_ASCII_FLAMEGRAPH
 !DEC$ ATTRIBUTES DLLEXPORT::PETSC_VIEWER_ASCII_GLVIS
 !DEC$ ATTRIBUTES DLLEXPORT::PETSC_VIEWER_DRAW_BASIC
 !DEC$ ATTRIBUTES DLLEXPORT::PETSC_VIEWER_DRAW_LG
@@ -128,5 +131,6 @@
 !DEC$ ATTRIBUTES DLLEXPORT::PETSC_VIEWER_BINARY_MATLAB
 !DEC$ ATTRIBUTES DLLEXPORT::PETSC_VIEWER_NATIVE
 !DEC$ ATTRIBUTES DLLEXPORT::PETSC_VIEWER_HDF5_VIZ
+!DEC$ ATTRIBUTES DLLEXPORT::PETSC_VIEWER_ASCII_CHROME_TRACE
 !DEC$ ATTRIBUTES DLLEXPORT::PETSC_VIEWER_NOFORMAT
 #endif
@@ -0,0 +1,277 @@
+/*
+     Timeline of the events and stages of each process, written in the Trace Event Format of Chrome and Perfetto.
+*/
+#include <petsc/private/logimpl.h>  /*I "petscsys.h" I*/
+#include <petsctime.h>
+#include <petscviewer.h>
+#if defined(PETSC_HAVE_OPENMP)
+#include <omp.h>
+#endif
+
+#if defined(PETSC_USE_LOG)
+
+/*
+  A record is a completed event or stage (event = -1-stage), with its begin time and duration in seconds. The records
+  are kept in a ring buffer of fixed size, so that only the most recent ones are written when it overflows.
+*/
+typedef struct {
+  int            event;
+  int            stage;
+  PetscLogDouble begin,duration;
+} PetscChromeTraceRecord;
+
+static PetscChromeTraceRecord *traceRecords    = NULL;
+static PetscInt               traceSize        = 0;
+static PetscInt64             traceCount       = 0;     /* The number of records since the beginning, including overwritten ones */
+static PetscLogDouble         *traceEventBegin = NULL;  /* The begin time of each event */
+static int                    *traceEventDepth = NULL;  /* The nesting depth of each event */
+static int                    traceMaxEvents   = 0;
+static PetscLogDouble         *traceStageBegin = NULL;  /* The begin time of each stage on the stack */
+static int                    *traceStageId    = NULL;  /* The stages on the stack */
+static int                    traceStageDepth  = 0;
+static int                    traceMaxStages   = 0;
+
+PETSC_STATIC_INLINE void PetscLogChromeTraceRecord_Private(int event,int stage,PetscLogDouble begin,PetscLogDouble end)
+{
+  PetscChromeTraceRecord *record = &traceRecords[traceCount%traceSize];
+
+  record->event    = event;
+  record->stage    = stage;
+  record->begin    = begin;
+  record->duration = end-begin;
+  traceCount++;
+}
+
+static PetscErrorCode PetscLogChromeTraceEnsureEvents_Private(int numEvents)
+{
+  PetscLogDouble *begin;
+  int            *depth;
+  int            maxEvents = PetscMax(traceMaxEvents,128);
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (numEvents <= traceMaxEvents) PetscFunctionReturn(0);
+  while (maxEvents < numEvents) maxEvents *= 2;
+  ierr = PetscCalloc2(maxEvents,&begin,maxEvents,&depth);CHKERRQ(ierr);
+  ierr = PetscArraycpy(begin,traceEventBegin,traceMaxEvents);CHKERRQ(ierr);
+  ierr = PetscArraycpy(depth,traceEventDepth,traceMaxEvents);CHKERRQ(ierr);
+  ierr = PetscFree2(traceEventBegin,traceEventDepth);CHKERRQ(ierr);
+  traceEventBegin = begin;
+  traceEventDepth = depth;
+  traceMaxEvents  = maxEvents;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode PetscLogEventBeginChromeTrace(PetscLogEvent event,int t,PetscObject o1,PetscObject o2,PetscObject o3,PetscObject o4)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscLogEventBeginDefault(event,t,o1,o2,o3,o4);CHKERRQ(ierr);
+#if defined(PETSC_HAVE_OPENMP)
+  if (omp_in_parallel()) PetscFunctionReturn(0);
+#endif
+  ierr = PetscLogChromeTraceEnsureEvents_Private(event+1);CHKERRQ(ierr);
+  if (traceEventDepth[event]++) PetscFunctionReturn(0);
+  PetscTime(&traceEventBegin[event]);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode PetscLogEventEndChromeTrace(PetscLogEvent event,int t,PetscObject o1,PetscObject o2,PetscObject o3,PetscObject o4)
+{
+  PetscLogDouble end;
+  int            stage;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+#if defined(PETSC_HAVE_OPENMP)
+  if (omp_in_parallel()) {
+    ierr = PetscLogEventEndDefault(event,t,o1,o2,o3,o4);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+#endif
+  PetscTime(&end);
+  if (event < traceMaxEvents && traceEventDepth[event] > 0 && !--traceEventDepth[event]) {
+    ierr = PetscStageLogGetCurrent(petsc_stageLog,&stage);CHKERRQ(ierr);
+    PetscLogChromeTraceRecord_Private(event,stage,traceEventBegin[event],end);
+  }
+  ierr = PetscLogEventEndDefault(event,t,o1,o2,o3,o4);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* Called by PetscLogStagePush() and PetscLogStagePop() */
+PetscErrorCode PetscLogChromeTraceStage_Private(PetscLogStage stage,PetscBool push)
+{
+  PetscLogDouble time;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (!traceRecords) PetscFunctionReturn(0);
+  PetscTime(&time);
+  if (push) {
+    if (traceStageDepth == traceMaxStages) {
+      PetscLogDouble *begin;
+      int            *id;
+
+      traceMaxStages = PetscMax(2*traceMaxStages,16);
+      ierr = PetscMalloc2(traceMaxStages,&begin,traceMaxStages,&id);CHKERRQ(ierr);
+      ierr = PetscArraycpy(begin,traceStageBegin,traceStageDepth);CHKERRQ(ierr);
+      ierr = PetscArraycpy(id,traceStageId,traceStageDepth);CHKERRQ(ierr);
+      ierr = PetscFree2(traceStageBegin,traceStageId);CHKERRQ(ierr);
+      traceStageBegin = begin;
+      traceStageId    = id;
+    }
+    traceStageBegin[traceStageDepth] = time;
+    traceStageId[traceStageDepth++]  = stage;
+  } else if (traceStageDepth > 0) {
+    traceStageDepth--;
+    PetscLogChromeTraceRecord_Private(-1-stage,stage,traceStageBegin[traceStageDepth],time);
+  }
+  PetscFunctionReturn(0);
+}
+
+/*@C
+  PetscLogChromeTraceBegin - Turns on logging of events and stages in a timeline, in addition to the default logging of
+  PetscLogDefaultBegin(). The timeline of each process is written by PetscLogView() with the format PETSC_VIEWER_ASCII_CHROME_TRACE
+  in the Trace Event Format, which can be opened with chrome://tracing or https://ui.perfetto.dev
+
+  Logically Collective over PETSC_COMM_WORLD
+
+  Options Database Keys:
++ -log_view :filename.json:ascii_chrome_trace - Records the timeline and writes it to the file in PetscFinalize()
+- -log_chrome_trace_buffer_size <n> - The maximum number of events and stages kept by each process (default 65536)
+
+  Notes:
+  Each event or stage completed on a process takes one entry of its buffer, which is a ring buffer: when it is full, the
+  oldest entries are overwritten, so that memory use is bounded and the end of the run is kept.
+
+  Only the outermost call of an event nested in itself is recorded. Events called by OpenMP threads inside parallel regions
+  are not recorded.
+
+  The timestamps are the times since PetscInitialize() on each process, in microseconds.
+
+  Level: advanced
+
+.seealso: PetscLogView(), PetscLogDefaultBegin(), PetscLogNestedBegin(), PetscLogTraceBegin()
+@*/
+PetscErrorCode PetscLogChromeTraceBegin(void)
+{
+  PetscStageLog  stageLog;
+  PetscInt       size = 65536;
+  int            depth;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (traceRecords) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ORDER,"The timeline is already being recorded");
+  ierr = PetscOptionsGetInt(NULL,NULL,"-log_chrome_trace_buffer_size",&size,NULL);CHKERRQ(ierr);
+  if (size < 1) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"Buffer size %D must be positive",size);
+  ierr       = PetscMalloc1(size,&traceRecords);CHKERRQ(ierr);
+  traceSize  = size;
+  traceCount = 0;
+  /* The stages already on the stack begin now, the main stage is pushed later when called from PetscInitialize() */
+  if (petsc_stageLog) {
+    ierr = PetscLogGetStageLog(&stageLog);CHKERRQ(ierr);
+    for (depth = 0; depth <= stageLog->stack->top; depth++) {
+      ierr = PetscLogChromeTraceStage_Private(stageLog->stack->stack[depth],PETSC_TRUE);CHKERRQ(ierr);
+    }
+  }
+  ierr = PetscLogSet(PetscLogEventBeginChromeTrace,PetscLogEventEndChromeTrace);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* Delete the data structures of the timeline */
+PetscErrorCode PetscLogChromeTraceEnd(void)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscFree(traceRecords);CHKERRQ(ierr);
+  ierr = PetscFree2(traceEventBegin,traceEventDepth);CHKERRQ(ierr);
+  ierr = PetscFree2(traceStageBegin,traceStageId);CHKERRQ(ierr);
+  traceSize       = 0;
+  traceCount      = 0;
+  traceMaxEvents  = 0;
+  traceStageDepth = 0;
+  traceMaxStages  = 0;
+  PetscFunctionReturn(0);
+}
+
+/* Copies a name into a JSON string, escaping the quotes, the backslashes and the control characters */
+static PetscErrorCode PetscLogChromeTraceEscape_Private(const char name[],char escaped[],size_t len)
+{
+  size_t         n = 0;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  for (; *name && n+7 < len; name++) {
+    unsigned char c = (unsigned char)*name;
+
+    if (c == '"' || c == '\\') {escaped[n++] = '\\'; escaped[n++] = (char)c;}
+    else if (c < 0x20) {ierr = PetscSNPrintf(escaped+n,len-n,"\\u%04x",(unsigned int)c);CHKERRQ(ierr); n += 6;}
+    else escaped[n++] = (char)c;
+  }
+  escaped[n] = 0;
+  PetscFunctionReturn(0);
+}
+
+/*
+  Writes the records of all processes in a single JSON object, each process being a "pid" of the Trace Event Format, so
+  that the timelines of the processes are shown one below the other. Events are complete events ("ph":"X") in the
+  category "event", with the stage in their arguments, and stages are complete events in the category "stage".
+*/
+PetscErrorCode PetscLogView_ChromeTrace(PetscViewer viewer)
+{
+  PetscStageLog          stageLog;
+  PetscChromeTraceRecord *record;
+  PetscInt64             i,start,dropped,totalDropped;
+  PetscLogDouble         now;
+  PetscMPIInt            rank;
+  int                    d;
+  const char             *name,*stageName;
+  char                   ename[PETSC_MAX_PATH_LEN],sname[PETSC_MAX_PATH_LEN];
+  MPI_Comm               comm;
+  PetscErrorCode         ierr;
+
+  PetscFunctionBegin;
+  if (!traceRecords) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ORDER,"Must use -log_view :filename:ascii_chrome_trace or PetscLogChromeTraceBegin() to record the timeline");
+  ierr = PetscObjectGetComm((PetscObject)viewer,&comm);CHKERRQ(ierr);
+  ierr = MPI_Comm_rank(comm,&rank);CHKERRMPI(ierr);
+  ierr = PetscLogGetStageLog(&stageLog);CHKERRQ(ierr);
+  dropped = traceCount > traceSize ? traceCount-traceSize : 0;
+  start   = dropped;
+  ierr    = MPIU_Allreduce(&dropped,&totalDropped,1,MPIU_INT64,MPI_SUM,comm);CHKERRMPI(ierr);
+
+  ierr = PetscViewerASCIIPrintf(viewer,"{\"traceEvents\":[\n");CHKERRQ(ierr);
+  ierr = PetscViewerASCIIPushSynchronized(viewer);CHKERRQ(ierr);
+  ierr = PetscViewerASCIISynchronizedPrintf(viewer,"%s{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":%d,\"tid\":0,\"args\":{\"name\":\"Rank %d\"}},\n",rank ? "," : "",rank,rank);CHKERRQ(ierr);
+  ierr = PetscViewerASCIISynchronizedPrintf(viewer,"{\"name\":\"process_sort_index\",\"ph\":\"M\",\"pid\":%d,\"tid\":0,\"args\":{\"sort_index\":%d}}",rank,rank);CHKERRQ(ierr);
+  for (i=start; i<traceCount; i++) {
+    record    = &traceRecords[i%traceSize];
+    stageName = record->stage >= 0 && record->stage < stageLog->numStages ? stageLog->stageInfo[record->stage].name : "";
+    if (record->event >= 0) {
+      name = record->event < stageLog->eventLog->numEvents ? stageLog->eventLog->eventInfo[record->event].name : "";
+      ierr = PetscLogChromeTraceEscape_Private(name,ename,sizeof(ename));CHKERRQ(ierr);
+      ierr = PetscLogChromeTraceEscape_Private(stageName,sname,sizeof(sname));CHKERRQ(ierr);
+      ierr = PetscViewerASCIISynchronizedPrintf(viewer,",\n{\"name\":\"%s\",\"cat\":\"event\",\"ph\":\"X\",\"pid\":%d,\"tid\":0,\"ts\":%.3f,\"dur\":%.3f,\"args\":{\"stage\":\"%s\"}}",
+                                                ename,rank,1e6*(record->begin-petsc_BaseTime),1e6*record->duration,sname);CHKERRQ(ierr);
+    } else {
+      ierr = PetscLogChromeTraceEscape_Private(stageName,sname,sizeof(sname));CHKERRQ(ierr);
+      ierr = PetscViewerASCIISynchronizedPrintf(viewer,",\n{\"name\":\"%s\",\"cat\":\"stage\",\"ph\":\"X\",\"pid\":%d,\"tid\":0,\"ts\":%.3f,\"dur\":%.3f}",
+                                                sname,rank,1e6*(record->begin-petsc_BaseTime),1e6*record->duration);CHKERRQ(ierr);
+    }
+  }
+  /* The stages still on the stack, such as the main stage, end now */
+  PetscTime(&now);
+  for (d=0; d<traceStageDepth; d++) {
+    ierr = PetscLogChromeTraceEscape_Private(stageLog->stageInfo[traceStageId[d]].name,sname,sizeof(sname));CHKERRQ(ierr);
+    ierr = PetscViewerASCIISynchronizedPrintf(viewer,",\n{\"name\":\"%s\",\"cat\":\"stage\",\"ph\":\"X\",\"pid\":%d,\"tid\":0,\"ts\":%.3f,\"dur\":%.3f}",
+                                              sname,rank,1e6*(traceStageBegin[d]-petsc_BaseTime),1e6*(now-traceStageBegin[d]));CHKERRQ(ierr);
+  }
+  ierr = PetscViewerASCIISynchronizedPrintf(viewer,"\n");CHKERRQ(ierr);
+  ierr = PetscViewerFlush(viewer);CHKERRQ(ierr);
+  ierr = PetscViewerASCIIPopSynchronized(viewer);CHKERRQ(ierr);
+  ierr = PetscViewerASCIIPrintf(viewer,"],\n\"displayTimeUnit\":\"ms\",\n\"otherData\":{\"droppedRecords\":%" PetscInt64_FMT "}}\n",totalDropped);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+#endif
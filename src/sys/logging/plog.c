@@ -11,6 +11,9 @@
 #include <petsc/private/logimpl.h>        /*I    "petscsys.h"   I*/
 #include <petsctime.h>
 #include <petscviewer.h>
+#if defined(PETSC_HAVE_OPENMP)
+#include <omp.h>
+#endif
 
 PetscErrorCode PetscLogObjectParent(PetscObject p,PetscObject c)
 {
@@ -65,6 +68,10 @@ int       petsc_numObjectsDestroyed = 0;
 PetscLogDouble petsc_BaseTime        = 0.0;
 PetscLogDouble petsc_TotalFlops      = 0.0;  /* The number of flops */
 PetscLogDouble petsc_tmp_flops       = 0.0;  /* The incremental number of flops */
+#if defined(PETSC_HAVE_OPENMP)
+int            petsc_numThreadFlops  = 0;     /* The number of OpenMP threads with their own flop counters */
+PetscLogDouble *petsc_threadFlops    = NULL;  /* The flops of each thread in the current parallel region */
+#endif
 PetscLogDouble petsc_send_ct         = 0.0;  /* The number of sends */
 PetscLogDouble petsc_recv_ct         = 0.0;  /* The number of receives */
 PetscLogDouble petsc_send_len        = 0.0;  /* The total length of all sent messages */
@@ -126,6 +133,10 @@ PETSC_INTERN PetscErrorCode PetscLogInitialize(void)
   if (petsc_logObjects) {
     ierr = PetscMalloc1(petsc_maxObjects, &petsc_objects);CHKERRQ(ierr);
   }
+#if defined(PETSC_HAVE_OPENMP)
+  petsc_numThreadFlops = omp_get_max_threads();
+  ierr = PetscCalloc1(petsc_numThreadFlops*PETSC_LOG_THREAD_FLOPS_STRIDE, &petsc_threadFlops);CHKERRQ(ierr);
+#endif
   PetscLogPHC = PetscLogObjCreateDefault;
   PetscLogPHD = PetscLogObjDestroyDefault;
   /* Setup default logging structures */
@@ -147,7 +158,13 @@ PETSC_INTERN PetscErrorCode PetscLogFinalize(void)
   PetscFunctionBegin;
   ierr = PetscFree(petsc_actions);CHKERRQ(ierr);
   ierr = PetscFree(petsc_objects);CHKERRQ(ierr);
+#if defined(PETSC_HAVE_OPENMP)
+  ierr = PetscFree(petsc_threadFlops);CHKERRQ(ierr);
+  petsc_numThreadFlops = 0;
+#endif
   ierr = PetscLogNestedEnd();CHKERRQ(ierr);
+  ierr = PetscLogChromeTraceEnd();CHKERRQ(ierr);
+  ierr = PetscLogPerfCountersEnd();CHKERRQ(ierr);
   ierr = PetscLogSet(NULL, NULL);CHKERRQ(ierr);
 
   /* Resetting phase */
@@ -457,6 +474,7 @@ PetscErrorCode  PetscLogStagePush(PetscLogStage stage)
   PetscFunctionBegin;
   ierr = PetscLogGetStageLog(&stageLog);CHKERRQ(ierr);
   ierr = PetscStageLogPush(stageLog, stage);CHKERRQ(ierr);
+  ierr = PetscLogChromeTraceStage_Private(stage, PETSC_TRUE);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
@@ -494,6 +512,7 @@ PetscErrorCode  PetscLogStagePop(void)
 
   PetscFunctionBegin;
   ierr = PetscLogGetStageLog(&stageLog);CHKERRQ(ierr);
+  ierr = PetscLogChromeTraceStage_Private(stageLog->curStage, PETSC_FALSE);CHKERRQ(ierr);
   ierr = PetscStageLogPop(stageLog);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
@@ -1448,6 +1467,75 @@ static PetscErrorCode PetscLogViewWarnNoGpuAwareMpi(MPI_Comm comm,FILE *fd)
 extern PetscInt PetscNumOMPThreads;
 #endif
 
+/* Prints the count and time of the events called by each OpenMP thread inside parallel regions, if any */
+static PetscErrorCode PetscLogViewThreads_Default(MPI_Comm comm,FILE *fd,PetscStageLog stageLog,int numStages,const PetscBool *stageVisible)
+{
+  PetscEventPerfLog eventLog = NULL;
+  PetscLogDouble    *times,*maxTimes;
+  PetscMPIInt       *counts,*maxCounts;
+  PetscMPIInt       localThreadCount = 0,threadCount;
+  int               localNumThreads = 0,numThreads,localNumEvents,numEvents;
+  int               stage,t;
+  PetscLogEvent     event;
+  PetscBool         header = PETSC_FALSE;
+  const char        *name;
+  PetscErrorCode    ierr;
+
+  PetscFunctionBegin;
+  for (stage = 0; stage < stageLog->numStages; stage++) {
+    eventLog        = stageLog->stageInfo[stage].eventLog;
+    localNumThreads = PetscMax(localNumThreads,eventLog->numThreads);
+    for (t = 0; t < eventLog->numThreads*eventLog->maxEvents; t++) localThreadCount += eventLog->threadInfo[t].count;
+  }
+  ierr = MPI_Allreduce(&localThreadCount,&threadCount,1,MPI_INT,MPI_MAX,comm);CHKERRMPI(ierr);
+  if (!threadCount) PetscFunctionReturn(0);
+  ierr = MPI_Allreduce(&localNumThreads,&numThreads,1,MPI_INT,MPI_MAX,comm);CHKERRMPI(ierr);
+  ierr = PetscMalloc4(numThreads,&counts,numThreads,&maxCounts,numThreads,&times,numThreads,&maxTimes);CHKERRQ(ierr);
+
+  ierr = PetscFPrintf(comm, fd, "------------------------------------------------------------------------------------------------------------------------\n");CHKERRQ(ierr);
+  ierr = PetscFPrintf(comm, fd, "Events called by OpenMP threads inside parallel regions (included in the table above):\n");CHKERRQ(ierr);
+  ierr = PetscFPrintf(comm, fd, "   Count: Maximum number of times the thread called the event over all processors\n");CHKERRQ(ierr);
+  ierr = PetscFPrintf(comm, fd, "   Time: Maximum time the thread spent in the event over all processors\n");CHKERRQ(ierr);
+  ierr = PetscFPrintf(comm, fd, "\nEvent                 Thread   Count      Time (sec)\n");CHKERRQ(ierr);
+  for (stage = 0; stage < numStages; stage++) {
+    if (!stageVisible[stage]) continue;
+    if (stage < stageLog->numStages) {
+      eventLog       = stageLog->stageInfo[stage].eventLog;
+      localNumEvents = eventLog->numEvents;
+    } else localNumEvents = 0;
+    ierr = MPI_Allreduce(&localNumEvents,&numEvents,1,MPI_INT,MPI_MAX,comm);CHKERRMPI(ierr);
+    header = PETSC_FALSE;
+    for (event = 0; event < numEvents; event++) {
+      for (t = 0; t < numThreads; t++) {
+        if (event < localNumEvents && t < eventLog->numThreads) {
+          counts[t] = eventLog->threadInfo[t*eventLog->maxEvents+event].count;
+          times[t]  = eventLog->threadInfo[t*eventLog->maxEvents+event].time;
+        } else {
+          counts[t] = 0;
+          times[t]  = 0.0;
+        }
+      }
+      ierr = MPI_Allreduce(counts,maxCounts,numThreads,MPI_INT,MPI_MAX,comm);CHKERRMPI(ierr);
+      ierr = MPI_Allreduce(times,maxTimes,numThreads,MPIU_PETSCLOGDOUBLE,MPI_MAX,comm);CHKERRMPI(ierr);
+      for (t = 0, threadCount = 0; t < numThreads; t++) threadCount += maxCounts[t];
+      if (!threadCount) continue;
+      if (!header) {
+        ierr   = PetscFPrintf(comm, fd, "\n--- Event Stage %d: %s\n\n", stage, stage < stageLog->numStages ? stageLog->stageInfo[stage].name : "Unknown");CHKERRQ(ierr);
+        header = PETSC_TRUE;
+      }
+      name = event < stageLog->eventLog->numEvents ? stageLog->eventLog->eventInfo[event].name : "";
+      for (t = 0; t < numThreads; t++) {
+        if (!maxCounts[t]) continue;
+        ierr = PetscFPrintf(comm, fd, "%-20s %7d %7d  %5.4e\n", name, t, maxCounts[t], maxTimes[t]);CHKERRQ(ierr);
+        name = "";
+      }
+    }
+  }
+  ierr = PetscFPrintf(comm, fd, "\n");CHKERRQ(ierr);
+  ierr = PetscFree4(counts,maxCounts,times,maxTimes);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 PetscErrorCode  PetscLogView_Default(PetscViewer viewer)
 {
   FILE               *fd;
@@ -1465,6 +1553,7 @@ PetscErrorCode  PetscLogView_Default(PetscViewer viewer)
   PetscLogDouble     fracStageTime, fracStageFlops, fracStageMess, fracStageMessLen, fracStageRed;
   PetscLogDouble     min, max, tot, ratio, avg, x, y;
   PetscLogDouble     minf, maxf, totf, ratf, mint, maxt, tott, ratt, ratC, totm, totml, totr, mal, malmax, emalmax;
+  PetscLogDouble     totpc[PETSC_LOG_NUM_PERF_COUNTERS];
   #if defined(PETSC_HAVE_DEVICE)
   PetscLogDouble     cct, gct, csz, gsz, gmaxt, gflops, gflopr, fracgflops;
   #endif
@@ -1670,6 +1759,21 @@ PetscErrorCode  PetscLogView_Default(PetscViewer viewer)
     ierr = PetscFPrintf(comm, fd, "   MMalloc Mbytes: Increase in high water mark of allocated memory (sum over all calls to event)\n");CHKERRQ(ierr);
     ierr = PetscFPrintf(comm, fd, "   RMI Mbytes: Increase in resident memory (sum over all calls to event)\n");CHKERRQ(ierr);
   }
+  if (PetscLogPerfCounters) {
+    PetscBool   available[PETSC_LOG_NUM_PERF_COUNTERS];
+    PetscMPIInt localAvailable, allAvailable;
+    int         c;
+
+    ierr = PetscFPrintf(comm, fd, "   IPC: instructions per cycle, (sum of instructions over all processors)/(sum of cycles over all processors)\n");CHKERRQ(ierr);
+    ierr = PetscFPrintf(comm, fd, "   LLC Miss: number of last level cache misses (sum over all processors)\n");CHKERRQ(ierr);
+    ierr = PetscFPrintf(comm, fd, "   Mbyte/s: 10e-6 * (sum of LLC misses times %d bytes over all processors)/(max time over all processors), estimates the memory bandwidth\n",PETSC_LEVEL1_DCACHE_LINESIZE);CHKERRQ(ierr);
+    ierr = PetscLogPerfCountersGetAvailable(available);CHKERRQ(ierr);
+    for (c = 0; c < PETSC_LOG_NUM_PERF_COUNTERS; c++) {
+      localAvailable = (PetscMPIInt)available[c];
+      ierr = MPI_Allreduce(&localAvailable, &allAvailable, 1, MPI_INT, MPI_MIN, comm);CHKERRMPI(ierr);
+      if (!allAvailable) {ierr = PetscFPrintf(comm, fd, "   Warning: the hardware counter of %s is not available on all processors, it is counted as zero\n", PetscLogPerfCounterNames[c]);CHKERRQ(ierr);}
+    }
+  }
   #if defined(PETSC_HAVE_DEVICE)
   ierr = PetscFPrintf(comm, fd, "   GPU Mflop/s: 10e-6 * (sum of flop on GPU over all processors)/(max GPU time over all processors)\n");CHKERRQ(ierr);
   ierr = PetscFPrintf(comm, fd, "   CpuToGpu Count: total number of CPU to GPU copies per processor\n");CHKERRQ(ierr);
@@ -1687,6 +1791,9 @@ PetscErrorCode  PetscLogView_Default(PetscViewer viewer)
   if (PetscLogMemory) {
     ierr = PetscFPrintf(comm, fd,"  Malloc EMalloc MMalloc RMI");CHKERRQ(ierr);
   }
+  if (PetscLogPerfCounters) {
+    ierr = PetscFPrintf(comm, fd,"  ---- HW Counters -----");CHKERRQ(ierr);
+  }
   #if defined(PETSC_HAVE_DEVICE)
   ierr = PetscFPrintf(comm, fd,"   GPU    - CpuToGpu -   - GpuToCpu - GPU");CHKERRQ(ierr);
   #endif
@@ -1695,6 +1802,9 @@ PetscErrorCode  PetscLogView_Default(PetscViewer viewer)
   if (PetscLogMemory) {
     ierr = PetscFPrintf(comm, fd," Mbytes Mbytes Mbytes Mbytes");CHKERRQ(ierr);
   }
+  if (PetscLogPerfCounters) {
+    ierr = PetscFPrintf(comm, fd,"   IPC LLC Miss  Mbyte/s");CHKERRQ(ierr);
+  }
   #if defined(PETSC_HAVE_DEVICE)
   ierr = PetscFPrintf(comm, fd," Mflop/s Count   Size   Count   Size  %%F");CHKERRQ(ierr);
   #endif
@@ -1703,6 +1813,9 @@ PetscErrorCode  PetscLogView_Default(PetscViewer viewer)
   if (PetscLogMemory) {
     ierr = PetscFPrintf(comm, fd,"-----------------------------");CHKERRQ(ierr);
   }
+  if (PetscLogPerfCounters) {
+    ierr = PetscFPrintf(comm, fd,"------------------------");CHKERRQ(ierr);
+  }
   #if defined(PETSC_HAVE_DEVICE)
   ierr = PetscFPrintf(comm, fd,"---------------------------------------");CHKERRQ(ierr);
   #endif
@@ -1763,6 +1876,9 @@ PetscErrorCode  PetscLogView_Default(PetscViewer viewer)
           ierr  = MPI_Allreduce(&eventInfo[event].mallocIncrease, &malmax,1, MPIU_PETSCLOGDOUBLE, MPI_SUM, comm);CHKERRMPI(ierr);
           ierr  = MPI_Allreduce(&eventInfo[event].mallocIncreaseEvent, &emalmax,1, MPIU_PETSCLOGDOUBLE, MPI_SUM, comm);CHKERRMPI(ierr);
         }
+        if (PetscLogPerfCounters) {
+          ierr  = MPI_Allreduce(eventInfo[event].perfCounters, totpc, PETSC_LOG_NUM_PERF_COUNTERS, MPIU_PETSCLOGDOUBLE, MPI_SUM, comm);CHKERRMPI(ierr);
+        }
         #if defined(PETSC_HAVE_DEVICE)
         ierr  = MPI_Allreduce(&eventInfo[event].CpuToGpuCount,    &cct,   1, MPIU_PETSCLOGDOUBLE, MPI_SUM, comm);CHKERRMPI(ierr);
         ierr  = MPI_Allreduce(&eventInfo[event].GpuToCpuCount,    &gct,   1, MPIU_PETSCLOGDOUBLE, MPI_SUM, comm);CHKERRMPI(ierr);
@@ -1791,6 +1907,10 @@ PetscErrorCode  PetscLogView_Default(PetscViewer viewer)
           ierr  = MPI_Allreduce(&zero,                        &malmax, 1, MPIU_PETSCLOGDOUBLE, MPI_SUM, comm);CHKERRMPI(ierr);
           ierr  = MPI_Allreduce(&zero,                        &emalmax,1, MPIU_PETSCLOGDOUBLE, MPI_SUM, comm);CHKERRMPI(ierr);
         }
+        if (PetscLogPerfCounters) {
+          PetscLogDouble zeros[PETSC_LOG_NUM_PERF_COUNTERS] = {0.0, 0.0, 0.0};
+          ierr  = MPI_Allreduce(zeros,                        totpc,   PETSC_LOG_NUM_PERF_COUNTERS, MPIU_PETSCLOGDOUBLE, MPI_SUM, comm);CHKERRMPI(ierr);
+        }
         #if defined(PETSC_HAVE_DEVICE)
         ierr  = MPI_Allreduce(&zero,                          &cct,    1, MPIU_PETSCLOGDOUBLE, MPI_SUM, comm);CHKERRMPI(ierr);
         ierr  = MPI_Allreduce(&zero,                          &gct,    1, MPIU_PETSCLOGDOUBLE, MPI_SUM, comm);CHKERRMPI(ierr);
@@ -1834,6 +1954,11 @@ PetscErrorCode  PetscLogView_Default(PetscViewer viewer)
         if (PetscLogMemory) {
           ierr = PetscFPrintf(comm, fd," %5.0f   %5.0f   %5.0f   %5.0f",mal/1.0e6,emalmax/1.0e6,malmax/1.0e6,mem/1.0e6);CHKERRQ(ierr);
         }
+        if (PetscLogPerfCounters) {
+          PetscLogDouble ipc = totpc[0] != 0.0 ? totpc[1]/totpc[0] : 0.0;
+          PetscLogDouble bw  = maxt != 0.0 ? totpc[2]*PETSC_LEVEL1_DCACHE_LINESIZE/maxt : 0.0;
+          ierr = PetscFPrintf(comm, fd," %5.2f %3.2e %8.0f",ipc,totpc[2],bw/1.0e6);CHKERRQ(ierr);
+        }
         #if defined(PETSC_HAVE_DEVICE)
         if (totf  != 0.0) fracgflops = gflops/totf;  else fracgflops = 0.0;
         if (gmaxt != 0.0) gflopr     = gflops/gmaxt; else gflopr     = 0.0;
@@ -1844,11 +1969,16 @@ PetscErrorCode  PetscLogView_Default(PetscViewer viewer)
     }
   }
 
+  ierr = PetscLogViewThreads_Default(comm, fd, stageLog, numStages, stageVisible);CHKERRQ(ierr);
+
   /* Memory usage and object creation */
   ierr = PetscFPrintf(comm, fd, "------------------------------------------------------------------------------------------------------------------------");CHKERRQ(ierr);
   if (PetscLogMemory) {
     ierr = PetscFPrintf(comm, fd, "-----------------------------");CHKERRQ(ierr);
   }
+  if (PetscLogPerfCounters) {
+    ierr = PetscFPrintf(comm, fd, "------------------------");CHKERRQ(ierr);
+  }
   #if defined(PETSC_HAVE_DEVICE)
   ierr = PetscFPrintf(comm, fd, "---------------------------------------");CHKERRQ(ierr);
   #endif
@@ -1973,6 +2103,9 @@ PetscErrorCode  PetscLogView_Default(PetscViewer viewer)
 .  -log_view :filename.py:ascii_info_detail - Saves logging information from each process as a Python file
 .  -log_view :filename.xml:ascii_xml - Saves a summary of the logging information in a nested format (see below for how to view it)
 .  -log_view :filename.txt:ascii_flamegraph - Saves logging information in a format suitable for visualising as a Flame Graph (see below for how to view it)
+.  -log_view :filename.json:ascii_chrome_trace - Saves a timeline of the events and stages of each process in the Trace Event Format (see below for how to view it)
+.  -log_view_memory - Also displays the memory allocated in each event
+.  -log_view_perf_counters - Also displays the cycles, instructions and last level cache misses counted by the hardware in each event
 .  -log_all - Saves a file Log.rank for each MPI process with details of each step of the computation
 -  -log_trace [filename] - Displays a trace of what each process is doing
 
@@ -1996,13 +2129,26 @@ $    Safari - see https://ccm.net/faq/36342-safari-how-to-enable-local-file-acce
 
   The nested XML format was kindly donated by Koos Huijssen and Christiaan M. Klaij  MARITIME  RESEARCH  INSTITUTE  NETHERLANDS
 
+  Events called by OpenMP threads inside parallel regions are logged by each thread in its own table, without synchronization.
+  Their counts and the largest time over the threads are added to the totals of the events, and the default and XML formats
+  also list the count and time of these events for each thread. The flops of the threads are counted per thread and added to
+  the total flops, and to the events, outside of parallel regions. Messages and memory are not logged by threads.
+
   The Flame Graph output can be visualised using either the original Flame Graph script (https://github.com/brendangregg/FlameGraph)
   or using speedscope (https://www.speedscope.app).
   Old XML profiles may be converted into this format using the script ${PETSC_DIR}/lib/petsc/bin/xml2flamegraph.py.
 
+  With -log_view_perf_counters, the hardware counters of each process are read with perf_event_open() of Linux at the
+  beginning and end of events. The default format then gives the instructions per cycle, the cache misses and the memory
+  bandwidth they imply. Only the thread calling PetscInitialize() is counted, and the counters not supported by the machine,
+  for instance in virtual machines, or forbidden by /proc/sys/kernel/perf_event_paranoid are counted as zero.
+
+  The timeline can be visualised by loading the JSON file in chrome://tracing or https://ui.perfetto.dev, where each
+  process is shown as a separate row. See PetscLogChromeTraceBegin() for how to bound the memory it uses.
+
   Level: beginner
 
-.seealso: PetscLogDefaultBegin(), PetscLogDump()
+.seealso: PetscLogDefaultBegin(), PetscLogNestedBegin(), PetscLogChromeTraceBegin(), PetscLogDump()
 @*/
 PetscErrorCode  PetscLogView(PetscViewer viewer)
 {
@@ -2023,6 +2169,11 @@ PetscErrorCode  PetscLogView(PetscViewer viewer)
     ierr      = PetscStageLogPop(stageLog);CHKERRQ(ierr);
     ierr      = PetscStageLogGetCurrent(stageLog, &stage);CHKERRQ(ierr);
   }
+  /* Add the flops and events logged by OpenMP threads to the totals */
+  ierr = PetscLogMergeThreadFlops();CHKERRQ(ierr);
+  for (stage = 0; stage < stageLog->numStages; stage++) {
+    ierr = PetscEventPerfLogMergeThreads(stageLog->stageInfo[stage].eventLog);CHKERRQ(ierr);
+  }
   ierr = PetscObjectTypeCompare((PetscObject)viewer,PETSCVIEWERASCII,&isascii);CHKERRQ(ierr);
   if (!isascii) SETERRQ(PetscObjectComm((PetscObject)viewer),PETSC_ERR_SUP,"Currently can only view logging to ASCII");
   ierr = PetscViewerGetFormat(viewer,&format);CHKERRQ(ierr);
@@ -2036,6 +2187,8 @@ PetscErrorCode  PetscLogView(PetscViewer viewer)
     ierr = PetscLogView_Nested(viewer);CHKERRQ(ierr);
   } else if (format == PETSC_VIEWER_ASCII_FLAMEGRAPH) {
     ierr = PetscLogView_Flamegraph(viewer);CHKERRQ(ierr);
+  } else if (format == PETSC_VIEWER_ASCII_CHROME_TRACE) {
+    ierr = PetscLogView_ChromeTrace(viewer);CHKERRQ(ierr);
   }
   ierr = PetscStageLogPush(stageLog, lastStage);CHKERRQ(ierr);
   PetscFunctionReturn(0);
@@ -2092,11 +2245,39 @@ PetscErrorCode PetscLogViewFromOptions(void)
 @*/
 PetscErrorCode  PetscGetFlops(PetscLogDouble *flops)
 {
+  PetscErrorCode ierr;
+
   PetscFunctionBegin;
+  ierr   = PetscLogMergeThreadFlops();CHKERRQ(ierr);
   *flops = petsc_TotalFlops;
   PetscFunctionReturn(0);
 }
 
+/*
+  PetscLogMergeThreadFlops - Adds the flops counted by OpenMP threads in parallel regions to petsc_TotalFlops (and petsc_gflops),
+  and clears the counters of the threads. Inside a parallel region this does nothing, since the threads may still be counting.
+*/
+PetscErrorCode PetscLogMergeThreadFlops(void)
+{
+#if defined(PETSC_HAVE_OPENMP)
+  int t;
+#endif
+
+  PetscFunctionBegin;
+#if defined(PETSC_HAVE_OPENMP)
+  if (omp_in_parallel()) PetscFunctionReturn(0);
+  for (t = 0; t < petsc_numThreadFlops; t++) {
+    petsc_TotalFlops += petsc_threadFlops[t*PETSC_LOG_THREAD_FLOPS_STRIDE];
+#if defined(PETSC_HAVE_DEVICE)
+    petsc_gflops     += petsc_threadFlops[t*PETSC_LOG_THREAD_FLOPS_STRIDE+1];
+#endif
+    petsc_threadFlops[t*PETSC_LOG_THREAD_FLOPS_STRIDE]   = 0.0;
+    petsc_threadFlops[t*PETSC_LOG_THREAD_FLOPS_STRIDE+1] = 0.0;
+  }
+#endif
+  PetscFunctionReturn(0);
+}
+
 PetscErrorCode  PetscLogObjectState(PetscObject obj, const char format[], ...)
 {
   PetscErrorCode ierr;
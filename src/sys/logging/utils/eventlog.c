@@ -6,6 +6,9 @@
 
 */
 #include <petsc/private/logimpl.h>  /*I    "petscsys.h"   I*/
+#if defined(PETSC_HAVE_OPENMP)
+#include <omp.h>
+#endif
 
 PetscBool PetscLogSyncOn = PETSC_FALSE;
 PetscBool PetscLogMemory = PETSC_FALSE;
@@ -90,6 +93,10 @@ PetscErrorCode PetscEventPerfLogCreate(PetscEventPerfLog *eventLog)
   l->numEvents = 0;
   l->maxEvents = 100;
   ierr         = PetscCalloc1(l->maxEvents,&l->eventInfo);CHKERRQ(ierr);
+#if defined(PETSC_HAVE_OPENMP)
+  l->numThreads = omp_get_max_threads();
+#endif
+  ierr         = PetscCalloc1(l->numThreads*l->maxEvents,&l->threadInfo);CHKERRQ(ierr);
   *eventLog    = l;
   PetscFunctionReturn(0);
 }
@@ -112,6 +119,7 @@ PetscErrorCode PetscEventPerfLogDestroy(PetscEventPerfLog eventLog)
 
   PetscFunctionBegin;
   ierr = PetscFree(eventLog->eventInfo);CHKERRQ(ierr);
+  ierr = PetscFree(eventLog->threadInfo);CHKERRQ(ierr);
   ierr = PetscFree(eventLog);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
@@ -131,6 +139,8 @@ PetscErrorCode PetscEventPerfLogDestroy(PetscEventPerfLog eventLog)
 @*/
 PetscErrorCode PetscEventPerfInfoClear(PetscEventPerfInfo *eventInfo)
 {
+  int c;
+
   PetscFunctionBegin;
   eventInfo->id            = -1;
   eventInfo->active        = PETSC_TRUE;
@@ -163,6 +173,7 @@ PetscErrorCode PetscEventPerfInfoClear(PetscEventPerfInfo *eventInfo)
   eventInfo->numMessages   = 0.0;
   eventInfo->messageLength = 0.0;
   eventInfo->numReductions = 0.0;
+  for (c = 0; c < PETSC_LOG_NUM_PERF_COUNTERS; c++) eventInfo->perfCounters[c] = 0.0;
   #if defined(PETSC_HAVE_DEVICE)
   eventInfo->CpuToGpuCount = 0.0;
   eventInfo->GpuToCpuCount = 0.0;
@@ -213,8 +224,10 @@ PetscErrorCode PetscEventPerfInfoCopy(PetscEventPerfInfo *eventInfo,PetscEventPe
 @*/
 PetscErrorCode PetscEventPerfLogEnsureSize(PetscEventPerfLog eventLog,int size)
 {
-  PetscEventPerfInfo *eventInfo;
-  PetscErrorCode     ierr;
+  PetscEventPerfInfo   *eventInfo;
+  PetscEventThreadInfo *threadInfo;
+  int                  t;
+  PetscErrorCode       ierr;
 
   PetscFunctionBegin;
   while (size > eventLog->maxEvents) {
@@ -222,6 +235,12 @@ PetscErrorCode PetscEventPerfLogEnsureSize(PetscEventPerfLog eventLog,int size)
     ierr = PetscArraycpy(eventInfo,eventLog->eventInfo,eventLog->maxEvents);CHKERRQ(ierr);
     ierr = PetscFree(eventLog->eventInfo);CHKERRQ(ierr);
     eventLog->eventInfo  = eventInfo;
+    ierr = PetscCalloc1(eventLog->numThreads*eventLog->maxEvents*2,&threadInfo);CHKERRQ(ierr);
+    for (t=0; t<eventLog->numThreads; t++) {
+      ierr = PetscArraycpy(threadInfo+t*eventLog->maxEvents*2,eventLog->threadInfo+t*eventLog->maxEvents,eventLog->maxEvents);CHKERRQ(ierr);
+    }
+    ierr = PetscFree(eventLog->threadInfo);CHKERRQ(ierr);
+    eventLog->threadInfo = threadInfo;
     eventLog->maxEvents *= 2;
   }
   while (eventLog->numEvents < size) {
@@ -230,6 +249,52 @@ PetscErrorCode PetscEventPerfLogEnsureSize(PetscEventPerfLog eventLog,int size)
   PetscFunctionReturn(0);
 }
 
+/*@C
+  PetscEventPerfLogMergeThreads - This adds the statistics of events called by OpenMP threads inside parallel regions, since
+  the last merge, to the PetscEventPerfInfo of the events.
+
+  Not collective
+
+  Input Parameter:
+. eventLog - The PetscEventPerfLog
+
+  Notes:
+  The counts of all threads are added, but only the largest time over the threads is added to the time of the event, since
+  the threads run concurrently. The flops of all threads are added. Messages and memory are not logged per thread.
+
+  This must be called outside of parallel regions.
+
+  Level: developer
+
+.seealso: PetscEventPerfLogEnsureSize(), PetscLogView()
+@*/
+PetscErrorCode PetscEventPerfLogMergeThreads(PetscEventPerfLog eventLog)
+{
+  PetscEventThreadInfo *threadInfo;
+  PetscLogDouble       time;
+  int                  event,t;
+
+  PetscFunctionBegin;
+#if defined(PETSC_HAVE_OPENMP)
+  if (omp_in_parallel()) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ARG_WRONGSTATE,"Cannot merge the event logs of threads inside a parallel region");
+#endif
+  for (event=0; event<eventLog->numEvents; event++) {
+    time = 0.0;
+    for (t=0; t<eventLog->numThreads; t++) {
+      threadInfo = &eventLog->threadInfo[t*eventLog->maxEvents+event];
+      eventLog->eventInfo[event].count += threadInfo->count - threadInfo->countMerged;
+      eventLog->eventInfo[event].flops += threadInfo->flops - threadInfo->flopsMerged;
+      time                              = PetscMax(time,threadInfo->time - threadInfo->timeMerged);
+      threadInfo->countMerged           = threadInfo->count;
+      threadInfo->flopsMerged           = threadInfo->flops;
+      threadInfo->timeMerged            = threadInfo->time;
+    }
+    eventLog->eventInfo[event].time  += time;
+    eventLog->eventInfo[event].time2 += time*time;
+  }
+  PetscFunctionReturn(0);
+}
+
 #if defined(PETSC_HAVE_MPE)
 #include <mpe.h>
 PETSC_INTERN PetscErrorCode PetscLogMPEGetRGBColor(const char*[]);
@@ -617,6 +682,9 @@ PetscErrorCode PetscEventPerfLogGetVisible(PetscEventPerfLog eventLog,PetscLogEv
   Output Parameters:
 . info - This structure is filled with the performance information
 
+  Notes:
+  This must be called outside of OpenMP parallel regions. It first adds the events called by threads inside parallel regions to the totals.
+
   Level: Intermediate
 
 .seealso: PetscLogEventGetFlops()
@@ -633,6 +701,7 @@ PetscErrorCode PetscLogEventGetPerfInfo(int stage,PetscLogEvent event,PetscEvent
   ierr = PetscLogGetStageLog(&stageLog);CHKERRQ(ierr);
   if (stage < 0) {ierr = PetscStageLogGetCurrent(stageLog,&stage);CHKERRQ(ierr);}
   ierr = PetscStageLogGetEventPerfLog(stageLog,stage,&eventLog);CHKERRQ(ierr);
+  ierr = PetscEventPerfLogMergeThreads(eventLog);CHKERRQ(ierr);
   *info = eventLog->eventInfo[event];
   PetscFunctionReturn(0);
 }
@@ -707,6 +776,25 @@ PetscErrorCode PetscLogEventBeginDefault(PetscLogEvent event,int t,PetscObject o
   ierr = PetscLogGetStageLog(&stageLog);CHKERRQ(ierr);
   ierr = PetscStageLogGetCurrent(stageLog,&stage);CHKERRQ(ierr);
   ierr = PetscStageLogGetEventPerfLog(stageLog,stage,&eventLog);CHKERRQ(ierr);
+#if defined(PETSC_HAVE_OPENMP)
+  /* Threads in a parallel region only log the count, time and flops, in their own copy of the event information */
+  if (omp_in_parallel()) {
+    int tid = omp_get_thread_num();
+
+    if (tid < eventLog->numThreads) {
+      PetscEventThreadInfo *threadInfo = &eventLog->threadInfo[tid*eventLog->maxEvents+event];
+
+      threadInfo->depth++;
+      if (threadInfo->depth > 1) PetscFunctionReturn(0);
+      threadInfo->count++;
+      threadInfo->timeTmp  = 0.0;
+      threadInfo->flopsTmp = tid < petsc_numThreadFlops ? -petsc_threadFlops[tid*PETSC_LOG_THREAD_FLOPS_STRIDE] : 0.0;
+      PetscTimeSubtract(&threadInfo->timeTmp);
+    }
+    PetscFunctionReturn(0);
+  }
+#endif
+  ierr = PetscLogMergeThreadFlops();CHKERRQ(ierr);
   /* Synchronization */
   ierr = PetscLogEventSynchronize(event,PetscObjectComm(o1));CHKERRQ(ierr);
   /* Check for double counting */
@@ -730,6 +818,12 @@ PetscErrorCode PetscLogEventBeginDefault(PetscLogEvent event,int t,PetscObject o
     eventLog->eventInfo[event].mallocIncrease -= usage;
     ierr = PetscMallocPushMaximumUsage((int)event);CHKERRQ(ierr);
   }
+  if (PetscLogPerfCounters) {
+    PetscLogDouble counters[PETSC_LOG_NUM_PERF_COUNTERS];
+    int            c;
+    ierr = PetscLogPerfCountersRead(counters);CHKERRQ(ierr);
+    for (c = 0; c < PETSC_LOG_NUM_PERF_COUNTERS; c++) eventLog->eventInfo[event].perfCounters[c] -= counters[c];
+  }
   #if defined(PETSC_HAVE_DEVICE)
   eventLog->eventInfo[event].CpuToGpuCount -= petsc_ctog_ct;
   eventLog->eventInfo[event].GpuToCpuCount -= petsc_gtoc_ct;
@@ -752,12 +846,36 @@ PetscErrorCode PetscLogEventEndDefault(PetscLogEvent event,int t,PetscObject o1,
   ierr = PetscLogGetStageLog(&stageLog);CHKERRQ(ierr);
   ierr = PetscStageLogGetCurrent(stageLog,&stage);CHKERRQ(ierr);
   ierr = PetscStageLogGetEventPerfLog(stageLog,stage,&eventLog);CHKERRQ(ierr);
+#if defined(PETSC_HAVE_OPENMP)
+  if (omp_in_parallel()) {
+    int tid = omp_get_thread_num();
+
+    if (tid < eventLog->numThreads) {
+      PetscEventThreadInfo *threadInfo = &eventLog->threadInfo[tid*eventLog->maxEvents+event];
+
+      threadInfo->depth--;
+      if (threadInfo->depth > 0) PetscFunctionReturn(0);
+      else if (threadInfo->depth < 0) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ARG_WRONGSTATE,"Logging event had unbalanced begin/end pairs");
+      PetscTimeAdd(&threadInfo->timeTmp);
+      threadInfo->time += threadInfo->timeTmp;
+      if (tid < petsc_numThreadFlops) threadInfo->flops += threadInfo->flopsTmp + petsc_threadFlops[tid*PETSC_LOG_THREAD_FLOPS_STRIDE];
+    }
+    PetscFunctionReturn(0);
+  }
+#endif
+  ierr = PetscLogMergeThreadFlops();CHKERRQ(ierr);
   /* Check for double counting */
   eventLog->eventInfo[event].depth--;
   if (eventLog->eventInfo[event].depth > 0) PetscFunctionReturn(0);
   else if (eventLog->eventInfo[event].depth < 0) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ARG_WRONGSTATE,"Logging event had unbalanced begin/end pairs");
   /* Log performance info */
   PetscTimeAdd(&eventLog->eventInfo[event].timeTmp);
+  if (PetscLogPerfCounters) {
+    PetscLogDouble counters[PETSC_LOG_NUM_PERF_COUNTERS];
+    int            c;
+    ierr = PetscLogPerfCountersRead(counters);CHKERRQ(ierr);
+    for (c = 0; c < PETSC_LOG_NUM_PERF_COUNTERS; c++) eventLog->eventInfo[event].perfCounters[c] += counters[c];
+  }
   eventLog->eventInfo[event].time          += eventLog->eventInfo[event].timeTmp;
   eventLog->eventInfo[event].time2         += eventLog->eventInfo[event].timeTmp*eventLog->eventInfo[event].timeTmp;
   eventLog->eventInfo[event].flopsTmp      += petsc_TotalFlops;
@@ -813,6 +931,7 @@ PetscErrorCode PetscLogEventBeginComplete(PetscLogEvent event,int t,PetscObject
     petsc_BaseTime += (end - start);
   }
   /* Record the event */
+  ierr = PetscLogMergeThreadFlops();CHKERRQ(ierr);
   ierr = PetscLogGetStageLog(&stageLog);CHKERRQ(ierr);
   ierr = PetscStageLogGetCurrent(stageLog,&stage);CHKERRQ(ierr);
   ierr = PetscStageLogGetEventRegLog(stageLog,&eventRegLog);CHKERRQ(ierr);
@@ -873,6 +992,7 @@ PetscErrorCode PetscLogEventEndComplete(PetscLogEvent event,int t,PetscObject o1
     petsc_BaseTime += (end - start);
   }
   /* Record the event */
+  ierr = PetscLogMergeThreadFlops();CHKERRQ(ierr);
   ierr = PetscLogGetStageLog(&stageLog);CHKERRQ(ierr);
   ierr = PetscStageLogGetCurrent(stageLog,&stage);CHKERRQ(ierr);
   ierr = PetscStageLogGetEventRegLog(stageLog,&eventRegLog);CHKERRQ(ierr);
@@ -0,0 +1,126 @@
+/*
+     Hardware performance counters of the process, read at the beginning and end of events with -log_view_perf_counters.
+   They are opened with the perf_event_open() system call of Linux, on other systems no counter is available.
+*/
+#include <petsc/private/logimpl.h>  /*I    "petscsys.h"   I*/
+#if defined(PETSC_HAVE_LINUX_PERF_EVENT_H)
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+PetscBool PetscLogPerfCounters = PETSC_FALSE;
+
+const char *const PetscLogPerfCounterNames[PETSC_LOG_NUM_PERF_COUNTERS] = {"cycles","instructions","last level cache misses"};
+
+#if defined(PETSC_HAVE_LINUX_PERF_EVENT_H)
+static const __u64 PetscLogPerfCounterConfigs[PETSC_LOG_NUM_PERF_COUNTERS] = {PERF_COUNT_HW_CPU_CYCLES,PERF_COUNT_HW_INSTRUCTIONS,PERF_COUNT_HW_CACHE_MISSES};
+static int         PetscLogPerfCounterFds[PETSC_LOG_NUM_PERF_COUNTERS]     = {-1,-1,-1};
+#endif
+
+/*
+  PetscLogPerfCountersBegin - Opens the hardware counters of the calling thread and turns on their logging in events.
+  The counters that cannot be opened, e.g. in virtual machines or when /proc/sys/kernel/perf_event_paranoid forbids
+  it, are reported by -info and read as zero.
+*/
+PetscErrorCode PetscLogPerfCountersBegin(void)
+{
+#if defined(PETSC_HAVE_LINUX_PERF_EVENT_H)
+  struct perf_event_attr attr;
+  int                    c;
+#endif
+  PetscErrorCode         ierr;
+
+  PetscFunctionBegin;
+  if (PetscLogPerfCounters) PetscFunctionReturn(0);
+#if defined(PETSC_HAVE_LINUX_PERF_EVENT_H)
+  for (c=0; c<PETSC_LOG_NUM_PERF_COUNTERS; c++) {
+    ierr = PetscMemzero(&attr,sizeof(attr));CHKERRQ(ierr);
+    attr.size           = sizeof(attr);
+    attr.type           = PERF_TYPE_HARDWARE;
+    attr.config         = PetscLogPerfCounterConfigs[c];
+    attr.exclude_kernel = 1;
+    attr.exclude_hv     = 1;
+    /* The counters may be multiplexed if the hardware has fewer registers, their values are then scaled */
+    attr.read_format    = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    PetscLogPerfCounterFds[c] = (int)syscall(SYS_perf_event_open,&attr,0,-1,-1,0);
+    if (PetscLogPerfCounterFds[c] < 0) {
+      ierr = PetscInfo1(NULL,"Hardware counter of %s is not available\n",PetscLogPerfCounterNames[c]);CHKERRQ(ierr);
+    }
+  }
+#else
+  ierr = PetscInfo(NULL,"Hardware counters require perf_event_open() of Linux\n");CHKERRQ(ierr);
+#endif
+  PetscLogPerfCounters = PETSC_TRUE;
+  PetscFunctionReturn(0);
+}
+
+/* Closes the hardware counters */
+PetscErrorCode PetscLogPerfCountersEnd(void)
+{
+#if defined(PETSC_HAVE_LINUX_PERF_EVENT_H)
+  int c;
+#endif
+
+  PetscFunctionBegin;
+#if defined(PETSC_HAVE_LINUX_PERF_EVENT_H)
+  for (c=0; c<PETSC_LOG_NUM_PERF_COUNTERS; c++) {
+    if (PetscLogPerfCounterFds[c] >= 0) close(PetscLogPerfCounterFds[c]);
+    PetscLogPerfCounterFds[c] = -1;
+  }
+#endif
+  PetscLogPerfCounters = PETSC_FALSE;
+  PetscFunctionReturn(0);
+}
+
+/*@C
+  PetscLogPerfCountersGetAvailable - Tells which hardware counters could be opened by -log_view_perf_counters
+
+  Not Collective
+
+  Output Parameter:
+. available - array of length PETSC_LOG_NUM_PERF_COUNTERS, PETSC_TRUE for each counter (cycles, instructions and
+              last level cache misses) that is read in the events
+
+  Notes:
+  The counters are opened with perf_event_open() of Linux, on other systems none is available. The counters that are not
+  available read as zero, and PetscLogView() warns about those not available on all processes.
+
+  Level: developer
+
+.seealso: PetscLogView(), PetscLogEventGetPerfInfo(), PetscEventPerfInfo
+@*/
+PetscErrorCode PetscLogPerfCountersGetAvailable(PetscBool available[])
+{
+  int c;
+
+  PetscFunctionBegin;
+  for (c=0; c<PETSC_LOG_NUM_PERF_COUNTERS; c++) {
+#if defined(PETSC_HAVE_LINUX_PERF_EVENT_H)
+    available[c] = PetscLogPerfCounterFds[c] >= 0 ? PETSC_TRUE : PETSC_FALSE;
+#else
+    available[c] = PETSC_FALSE;
+#endif
+  }
+  PetscFunctionReturn(0);
+}
+
+/* Reads the current values of the hardware counters, zero for those not available */
+PetscErrorCode PetscLogPerfCountersRead(PetscLogDouble counters[])
+{
+  int c;
+
+  PetscFunctionBegin;
+  for (c=0; c<PETSC_LOG_NUM_PERF_COUNTERS; c++) {
+    counters[c] = 0.0;
+#if defined(PETSC_HAVE_LINUX_PERF_EVENT_H)
+    if (PetscLogPerfCounterFds[c] >= 0) {
+      __u64 values[3]; /* The value, the time enabled and the time running */
+
+      if (read(PetscLogPerfCounterFds[c],values,sizeof(values)) != (ssize_t)sizeof(values)) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_SYS,"Unable to read the hardware counter of %s",PetscLogPerfCounterNames[c]);
+      if (values[2]) counters[c] = (PetscLogDouble)values[0]*((PetscLogDouble)values[1]/(PetscLogDouble)values[2]);
+    }
+#endif
+  }
+  PetscFunctionReturn(0);
+}
@@ -253,6 +253,7 @@ PetscErrorCode  PetscStageLogPush(PetscStageLog stageLog, int stage)
   if ((stage < 0) || (stage >= stageLog->numStages)) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE, "Invalid stage %d should be in [0,%d)", stage, stageLog->numStages);
 
   /* Record flops/time of previous stage */
+  ierr = PetscLogMergeThreadFlops();CHKERRQ(ierr);
   ierr = PetscIntStackEmpty(stageLog->stack, &empty);CHKERRQ(ierr);
   if (!empty) {
     ierr = PetscIntStackTop(stageLog->stack, &curStage);CHKERRQ(ierr);
@@ -319,6 +320,7 @@ PetscErrorCode  PetscStageLogPop(PetscStageLog stageLog)
 
   PetscFunctionBegin;
   /* Record flops/time of current stage */
+  ierr = PetscLogMergeThreadFlops();CHKERRQ(ierr);
   ierr = PetscIntStackPop(stageLog->stack, &curStage);CHKERRQ(ierr);
   if (stageLog->stageInfo[curStage].perfInfo.active) {
     PetscTimeAdd(&stageLog->stageInfo[curStage].perfInfo.time);
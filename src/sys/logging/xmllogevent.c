@@ -10,6 +10,9 @@
 #include <petsctime.h>
 #include <petscviewer.h>
 #include "../src/sys/logging/xmlviewer.h"
+#if defined(PETSC_HAVE_OPENMP)
+#include <omp.h>
+#endif
 
 #if defined(PETSC_USE_LOG)
 
@@ -281,6 +284,13 @@ static PetscErrorCode PetscLogEventBeginNested(NestedEventId nstEvent, int t, Pe
   PetscLogEvent   dftEvent;
 
   PetscFunctionBegin;
+#if defined(PETSC_HAVE_OPENMP)
+  /* The nested timers are shared by all threads, so threads in a parallel region only log the event in their own table */
+  if (omp_in_parallel()) {
+    ierr = PetscLogEventBeginDefault(nstEvent,t,o1,o2,o3,o4);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+#endif
   ierr = PetscLogEventFindNestedTimer(nstEvent, &entry);CHKERRQ(ierr);
   if (entry>=nNestedEvents || nestedEvents[entry].nstEvent != nstEvent) {
     /* Nested event doesn't exist yet: create it */
@@ -388,6 +398,12 @@ static PetscErrorCode PetscLogEventEndNested(NestedEventId nstEvent, int t, Pets
   PetscLogEvent  *dftEventsSorted;
 
   PetscFunctionBegin;
+#if defined(PETSC_HAVE_OPENMP)
+  if (omp_in_parallel()) {
+    ierr = PetscLogEventEndDefault(nstEvent,t,o1,o2,o3,o4);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+#endif
   /* Find the nested event */
   ierr = PetscLogEventFindNestedTimer(nstEvent, &entry);CHKERRQ(ierr);
   if (entry>=nNestedEvents) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_ARG_WRONGSTATE, "Logging event %d larger than number of events %d",entry,nNestedEvents);
@@ -1360,6 +1376,63 @@ static PetscErrorCode PetscPrintSelfTime(PetscViewer viewer, const PetscSelfTime
   PetscFunctionReturn(0);
 }
 
+/*
+ * Print the count and time of the events called by each OpenMP thread inside parallel regions, summed over the stages
+ * and maximized over the processes
+ */
+static PetscErrorCode PetscPrintThreadTimes(PetscViewer viewer)
+{
+  PetscErrorCode    ierr;
+  PetscStageLog     stageLog;
+  PetscEventPerfLog eventLog;
+  PetscLogDouble    *times, *maxTimes;
+  PetscMPIInt       *counts, *maxCounts;
+  int               localSizes[2], sizes[2], stage, t, n, nEvents, nThreads;
+  PetscLogEvent     event;
+  MPI_Comm          comm;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectGetComm((PetscObject)viewer,&comm);CHKERRQ(ierr);
+  ierr = PetscLogGetStageLog(&stageLog);CHKERRQ(ierr);
+  localSizes[0] = stageLog->eventLog->numEvents;
+  localSizes[1] = 0;
+  for (stage=0; stage<stageLog->numStages; stage++) localSizes[1] = PetscMax(localSizes[1],stageLog->stageInfo[stage].eventLog->numThreads);
+  ierr = MPIU_Allreduce(localSizes, sizes, 2, MPI_INT, MPI_MAX, comm);CHKERRMPI(ierr);
+  nEvents = sizes[0]; nThreads = sizes[1];
+  if (!nThreads) PetscFunctionReturn(0);
+
+  ierr = PetscCalloc4(nEvents*nThreads,&counts,nEvents*nThreads,&maxCounts,nEvents*nThreads,&times,nEvents*nThreads,&maxTimes);CHKERRQ(ierr);
+  for (stage=0; stage<stageLog->numStages; stage++) {
+    eventLog = stageLog->stageInfo[stage].eventLog;
+    for (t=0; t<eventLog->numThreads; t++) {
+      for (event=0; event<eventLog->numEvents; event++) {
+        counts[event*nThreads+t] += eventLog->threadInfo[t*eventLog->maxEvents+event].count;
+        times[event*nThreads+t]  += eventLog->threadInfo[t*eventLog->maxEvents+event].time;
+      }
+    }
+  }
+  ierr = MPIU_Allreduce(counts, maxCounts, nEvents*nThreads, MPI_INT, MPI_MAX, comm);CHKERRMPI(ierr);
+  ierr = MPIU_Allreduce(times, maxTimes, nEvents*nThreads, MPIU_PETSCLOGDOUBLE, MPI_MAX, comm);CHKERRMPI(ierr);
+  for (n=0; n<nEvents*nThreads; n++) if (maxCounts[n]) break;
+  if (n < nEvents*nThreads) {
+    ierr = PetscViewerXMLStartSection(viewer, "threadtimertable", "Events of OpenMP threads in parallel regions (max over processes)");CHKERRQ(ierr);
+    for (event=0; event<nEvents; event++) {
+      for (t=0; t<nThreads; t++) {
+        if (!maxCounts[event*nThreads+t]) continue;
+        ierr = PetscViewerXMLStartSection(viewer, "threadevent", NULL);CHKERRQ(ierr);
+        ierr = PetscViewerXMLPutString(viewer, "name", NULL, event < stageLog->eventLog->numEvents ? stageLog->eventLog->eventInfo[event].name : "");CHKERRQ(ierr);
+        ierr = PetscViewerXMLPutInt(viewer, "thread", NULL, t);CHKERRQ(ierr);
+        ierr = PetscViewerXMLPutInt(viewer, "count", NULL, maxCounts[event*nThreads+t]);CHKERRQ(ierr);
+        ierr = PetscViewerXMLPutDouble(viewer, "time", NULL, maxTimes[event*nThreads+t], "%g");CHKERRQ(ierr);
+        ierr = PetscViewerXMLEndSection(viewer, "threadevent");CHKERRQ(ierr);
+      }
+    }
+    ierr = PetscViewerXMLEndSection(viewer, "threadtimertable");CHKERRQ(ierr);
+  }
+  ierr = PetscFree4(counts,maxCounts,times,maxTimes);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 PetscErrorCode PetscLogView_Nested(PetscViewer viewer)
 {
   PetscErrorCode       ierr;
@@ -1392,6 +1465,9 @@ PetscErrorCode PetscLogView_Nested(PetscViewer viewer)
   ierr = PetscPrintSelfTime(viewer, selftimers, nstMax, globTotalTime);CHKERRQ(ierr);
   ierr = PetscFree(selftimers);CHKERRQ(ierr);
 
+  /* Print the events of OpenMP threads, if any */
+  ierr = PetscPrintThreadTimes(viewer);CHKERRQ(ierr);
+
   ierr = PetscViewerXMLEndSection(viewer, "petscroot");CHKERRQ(ierr);
   ierr = PetscViewerFinalASCII_XML(viewer);CHKERRQ(ierr);
   PetscFunctionReturn(0);
@@ -12,6 +12,7 @@
 #include <petscviewer.h>
 #if defined(PETSC_USE_LOG)
 PETSC_INTERN PetscErrorCode PetscLogInitialize(void);
+PETSC_INTERN PetscErrorCode PetscLogPerfCountersBegin(void);
 #endif
 
 #if defined(PETSC_HAVE_SYS_SYSINFO_H)
@@ -659,6 +660,8 @@ PETSC_INTERN PetscErrorCode  PetscOptionsCheckInitial_Private(const char help[])
   if (flg4) {
     if (format == PETSC_VIEWER_ASCII_XML || format == PETSC_VIEWER_ASCII_FLAMEGRAPH) {
       ierr = PetscLogNestedBegin();CHKERRQ(ierr);
+    } else if (format == PETSC_VIEWER_ASCII_CHROME_TRACE) {
+      ierr = PetscLogChromeTraceBegin();CHKERRQ(ierr);
     } else {
       ierr = PetscLogDefaultBegin();CHKERRQ(ierr);
     }
@@ -668,6 +671,9 @@ PETSC_INTERN PetscErrorCode  PetscOptionsCheckInitial_Private(const char help[])
     ierr = PetscOptionsGetReal(NULL,NULL,"-log_threshold",&threshold,&flg1);CHKERRQ(ierr);
     if (flg1) {ierr = PetscLogSetThreshold((PetscLogDouble)threshold,NULL);CHKERRQ(ierr);}
   }
+  flg1 = PETSC_FALSE;
+  ierr = PetscOptionsGetBool(NULL,NULL,"-log_view_perf_counters",&flg1,NULL);CHKERRQ(ierr);
+  if (flg1) {ierr = PetscLogPerfCountersBegin();CHKERRQ(ierr);}
 #endif
 
   ierr = PetscOptionsGetBool(NULL,NULL,"-saws_options",&PetscOptionsPublish,NULL);CHKERRQ(ierr);
@@ -735,6 +735,7 @@ PetscInt PetscNumOMPThreads;
         hangs without running in the debugger).  See PetscLogTraceBegin().
 .  -log_view [:filename:format] - Prints summary of flop and timing information to screen or file, see PetscLogView().
 .  -log_view_memory - Includes in the summary from -log_view the memory used in each method, see PetscLogView().
+.  -log_view_perf_counters - Includes in the summary from -log_view the hardware counters of each method, see PetscLogView().
 .  -log_summary [filename] - (Deprecated, use -log_view) Prints summary of flop and timing information to screen. If the filename is specified the
         summary is written to the file.  See PetscLogView().
 .  -log_exclude: <vec,mat,pc,ksp,snes> - excludes subset of object classes from logging
@@ -1319,8 +1320,9 @@ PetscErrorCode  PetscFinalize(void)
   flg1 = PETSC_FALSE;
   ierr = PetscOptionsGetBool(NULL,NULL,"-get_total_flops",&flg1,NULL);CHKERRQ(ierr);
   if (flg1) {
-    PetscLogDouble flops = 0;
-    ierr = MPI_Reduce(&petsc_TotalFlops,&flops,1,MPI_DOUBLE,MPI_SUM,0,PETSC_COMM_WORLD);CHKERRMPI(ierr);
+    PetscLogDouble flops = 0,localFlops;
+    ierr = PetscGetFlops(&localFlops);CHKERRQ(ierr);
+    ierr = MPI_Reduce(&localFlops,&flops,1,MPI_DOUBLE,MPI_SUM,0,PETSC_COMM_WORLD);CHKERRMPI(ierr);
     ierr = PetscPrintf(PETSC_COMM_WORLD,"Total flops over all processors %g\n",flops);CHKERRQ(ierr);
   }
 #endif
@@ -0,0 +1,91 @@
+static char help[] = "Tests logging of events called by OpenMP threads in parallel regions.\n\n";
+
+/*
+  With OpenMP and thread safety, the events are called in a parallel loop and each thread logs them in its own table.
+  The counts are merged by PetscLogEventGetPerfInfo() and PetscLogView(), which also lists the events of each thread.
+  The flops logged by the threads are added to the total and to the events.
+
+  Usage: OMP_NUM_THREADS=4 ./ex57 -n 100000 -log_view
+*/
+#include <petscsys.h>
+
+int main(int argc,char **argv)
+{
+  PetscLogEvent      outer,inner;
+  PetscEventPerfInfo info;
+  PetscLogDouble     flops0,flops;
+  PetscInt           i,n = 1000;
+  PetscBool          check = PETSC_TRUE;
+  PetscErrorCode     ierr,ierrs = 0;
+
+  ierr = PetscInitialize(&argc,&argv,NULL,help);if (ierr) return ierr;
+  ierr = PetscOptionsGetInt(NULL,NULL,"-n",&n,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetBool(NULL,NULL,"-check",&check,NULL);CHKERRQ(ierr);
+  if (!PetscLogPLB) SETERRQ(PETSC_COMM_WORLD,PETSC_ERR_USER,"Must run with -log_view");
+  ierr = PetscLogEventRegister("ThreadOuter",0,&outer);CHKERRQ(ierr);
+  ierr = PetscLogEventRegister("ThreadInner",0,&inner);CHKERRQ(ierr);
+
+  /* Outside of parallel regions */
+  ierr = PetscGetFlops(&flops0);CHKERRQ(ierr);
+  ierr = PetscLogEventBegin(outer,0,0,0,0);CHKERRQ(ierr);
+  ierr = PetscLogEventBegin(inner,0,0,0,0);CHKERRQ(ierr);
+  ierr = PetscLogFlops(2.0);CHKERRQ(ierr);
+  ierr = PetscLogEventEnd(inner,0,0,0,0);CHKERRQ(ierr);
+  ierr = PetscLogFlops(1.0);CHKERRQ(ierr);
+  ierr = PetscLogEventEnd(outer,0,0,0,0);CHKERRQ(ierr);
+
+  /* The inner event is called twice per iteration, the second time nested in itself; each iteration logs 3 flops */
+#if defined(PETSC_HAVE_OPENMP) && defined(PETSC_HAVE_THREADSAFETY)
+  #pragma omp parallel for reduction(max:ierrs)
+#endif
+  for (i=0; i<n; i++) {
+    PetscErrorCode ierrl;
+
+    ierrl = PetscLogEventBegin(outer,0,0,0,0);
+    if (!ierrl) ierrl = PetscLogEventBegin(inner,0,0,0,0);
+    if (!ierrl) ierrl = PetscLogFlops(2.0);
+    if (!ierrl) ierrl = PetscLogEventEnd(inner,0,0,0,0);
+    if (!ierrl) ierrl = PetscLogFlops(1.0);
+    if (!ierrl) ierrl = PetscLogEventBegin(inner,0,0,0,0);
+    if (!ierrl) ierrl = PetscLogEventBegin(inner,0,0,0,0);
+    if (!ierrl) ierrl = PetscLogEventEnd(inner,0,0,0,0);
+    if (!ierrl) ierrl = PetscLogEventEnd(inner,0,0,0,0);
+    if (!ierrl) ierrl = PetscLogEventEnd(outer,0,0,0,0);
+    ierrs = PetscMax(ierrs,ierrl);
+  }
+  ierr = ierrs;CHKERRQ(ierr);
+
+  if (check) {
+    ierr = PetscLogEventGetPerfInfo(PETSC_DETERMINE,outer,&info);CHKERRQ(ierr);
+    if (info.count != n+1) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_PLIB,"Outer event logged %d times instead of %D",info.count,n+1);
+    if (info.flops != PETSC_FLOPS_PER_OP*3*(n+1)) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_PLIB,"Outer event logged %g flops instead of %g",info.flops,PETSC_FLOPS_PER_OP*3*(n+1));
+    ierr = PetscLogEventGetPerfInfo(PETSC_DETERMINE,inner,&info);CHKERRQ(ierr);
+    if (info.count != 2*n+1) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_PLIB,"Inner event logged %d times instead of %D",info.count,2*n+1);
+    if (info.flops != PETSC_FLOPS_PER_OP*2*(n+1)) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_PLIB,"Inner event logged %g flops instead of %g",info.flops,PETSC_FLOPS_PER_OP*2*(n+1));
+    ierr = PetscGetFlops(&flops);CHKERRQ(ierr);
+    if (flops-flops0 != PETSC_FLOPS_PER_OP*3*(n+1)) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_PLIB,"Logged %g flops instead of %g",flops-flops0,PETSC_FLOPS_PER_OP*3*(n+1));
+    /* Merging again must not count the events twice */
+    ierr = PetscLogEventGetPerfInfo(PETSC_DETERMINE,inner,&info);CHKERRQ(ierr);
+    if (info.count != 2*n+1) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_PLIB,"Inner event logged %d times instead of %D after merging twice",info.count,2*n+1);
+  }
+  ierr = PetscPrintf(PETSC_COMM_WORLD,"Events logged correctly\n");CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+   build:
+      requires: define(PETSC_USE_LOG)
+
+   test:
+      nsize: {{1 2}}
+      args: -log_view :/dev/null
+
+   test:
+      suffix: xml
+      nsize: 2
+      args: -log_view :/dev/null:ascii_xml -check 0
+      output_file: output/ex57_1.out
+
+TEST*/
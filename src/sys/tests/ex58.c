@@ -0,0 +1,86 @@
+static char help[] = "Tests the timeline of events and stages written in the Trace Event Format.\n\n";
+
+/*
+  Each process calls an event -n times in a stage, then the timeline is written to ex58.json and process 0 counts the
+  entries of the event and of the processes. A second event has a quote and a backslash in its name, which must be
+  escaped in the JSON. With -log_chrome_trace_buffer_size smaller than -n, only the most recent
+  entries are kept.
+
+  Usage: mpiexec -n 2 ./ex58 -log_view :trace.json:ascii_chrome_trace and load trace.json in https://ui.perfetto.dev
+*/
+#include <petscsys.h>
+#include <petscviewer.h>
+
+int main(int argc,char **argv)
+{
+  PetscLogEvent  event,quoted;
+  PetscLogStage  stage;
+  PetscViewer    viewer;
+  PetscInt       i,n = 10,nevents = 0,nquoted = 0,nprocs = 0,nstages = 0;
+  PetscMPIInt    rank;
+  PetscBool      dropped = PETSC_FALSE;
+  PetscErrorCode ierr;
+
+  ierr = PetscInitialize(&argc,&argv,NULL,help);if (ierr) return ierr;
+  ierr = MPI_Comm_rank(PETSC_COMM_WORLD,&rank);CHKERRMPI(ierr);
+  ierr = PetscOptionsGetInt(NULL,NULL,"-n",&n,NULL);CHKERRQ(ierr);
+  ierr = PetscLogStageRegister("TraceStage",&stage);CHKERRQ(ierr);
+  ierr = PetscLogEventRegister("TraceEvent",0,&event);CHKERRQ(ierr);
+  ierr = PetscLogEventRegister("Trace\"Quoted\\Event",0,&quoted);CHKERRQ(ierr);
+
+  ierr = PetscLogStagePush(stage);CHKERRQ(ierr);
+  for (i=0; i<n; i++) {
+    ierr = PetscLogEventBegin(event,0,0,0,0);CHKERRQ(ierr);
+    /* Nested calls of the event in itself are not recorded */
+    ierr = PetscLogEventBegin(event,0,0,0,0);CHKERRQ(ierr);
+    ierr = PetscLogEventEnd(event,0,0,0,0);CHKERRQ(ierr);
+    ierr = PetscLogEventEnd(event,0,0,0,0);CHKERRQ(ierr);
+  }
+  ierr = PetscLogEventBegin(quoted,0,0,0,0);CHKERRQ(ierr);
+  ierr = PetscLogEventEnd(quoted,0,0,0,0);CHKERRQ(ierr);
+  ierr = PetscLogStagePop();CHKERRQ(ierr);
+
+  ierr = PetscViewerASCIIOpen(PETSC_COMM_WORLD,"ex58.json",&viewer);CHKERRQ(ierr);
+  ierr = PetscViewerPushFormat(viewer,PETSC_VIEWER_ASCII_CHROME_TRACE);CHKERRQ(ierr);
+  ierr = PetscLogView(viewer);CHKERRQ(ierr);
+  ierr = PetscViewerPopFormat(viewer);CHKERRQ(ierr);
+  ierr = PetscViewerDestroy(&viewer);CHKERRQ(ierr);
+
+  if (!rank) {
+    FILE *fd;
+    char line[PETSC_MAX_PATH_LEN];
+
+    ierr = PetscFOpen(PETSC_COMM_SELF,"ex58.json","r",&fd);CHKERRQ(ierr);
+    while (fgets(line,sizeof(line),fd)) {
+      if (strstr(line,"\"name\":\"TraceEvent\""))   nevents++;
+      if (strstr(line,"\"name\":\"Trace\\\"Quoted\\\\Event\"")) nquoted++;
+      if (strstr(line,"\"name\":\"TraceStage\""))   nstages++;
+      if (strstr(line,"\"name\":\"process_name\"")) nprocs++;
+      if (strstr(line,"\"droppedRecords\"") && !strstr(line,"\"droppedRecords\":0}")) dropped = PETSC_TRUE;
+    }
+    ierr = PetscFClose(PETSC_COMM_SELF,fd);CHKERRQ(ierr);
+  }
+  ierr = PetscPrintf(PETSC_COMM_WORLD,"Processes %D, stages %D, events %D, escaped events %D, dropped records %s\n",nprocs,nstages,nevents,nquoted,PetscBools[dropped]);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+   build:
+      requires: define(PETSC_USE_LOG)
+
+   test:
+      suffix: 1
+      args: -log_view :/dev/null:ascii_chrome_trace
+
+   test:
+      suffix: 2
+      nsize: 2
+      args: -log_view :/dev/null:ascii_chrome_trace
+
+   test:
+      suffix: small
+      args: -log_view :/dev/null:ascii_chrome_trace -log_chrome_trace_buffer_size 4
+
+TEST*/
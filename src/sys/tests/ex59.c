@@ -0,0 +1,59 @@
+static char help[] = "Tests the hardware counters logged in events with -log_view_perf_counters.\n\n";
+
+/*
+  An event sums an array of -n entries -nrep times. The counters available on the machine must have counted some cycles
+  and instructions, while the counters not available must be zero.
+
+  Usage: ./ex59 -n 100000000 -log_view -log_view_perf_counters
+*/
+#include <petscsys.h>
+#include <petsc/private/logimpl.h>
+
+int main(int argc,char **argv)
+{
+  PetscLogEvent      event;
+  PetscEventPerfInfo info;
+  PetscBool          available[PETSC_LOG_NUM_PERF_COUNTERS];
+  PetscInt           i,r,n = 100000,nrep = 10;
+  PetscScalar        *x,sum = 0.0;
+  int                c;
+  PetscErrorCode     ierr;
+
+  ierr = PetscInitialize(&argc,&argv,NULL,help);if (ierr) return ierr;
+  ierr = PetscOptionsGetInt(NULL,NULL,"-n",&n,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,NULL,"-nrep",&nrep,NULL);CHKERRQ(ierr);
+  if (!PetscLogPerfCounters) SETERRQ(PETSC_COMM_WORLD,PETSC_ERR_USER,"Must run with -log_view_perf_counters");
+  ierr = PetscLogEventRegister("SumArray",0,&event);CHKERRQ(ierr);
+  ierr = PetscMalloc1(n,&x);CHKERRQ(ierr);
+  for (i=0; i<n; i++) x[i] = 1.0;
+
+  ierr = PetscLogEventBegin(event,0,0,0,0);CHKERRQ(ierr);
+  for (r=0; r<nrep; r++) for (i=0; i<n; i++) sum += x[i];
+  ierr = PetscLogFlops(nrep*n);CHKERRQ(ierr);
+  ierr = PetscLogEventEnd(event,0,0,0,0);CHKERRQ(ierr);
+  if (PetscRealPart(sum) != (PetscReal)(nrep*n)) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_PLIB,"Wrong sum");
+
+  ierr = PetscLogEventGetPerfInfo(PETSC_DETERMINE,event,&info);CHKERRQ(ierr);
+  ierr = PetscLogPerfCountersGetAvailable(available);CHKERRQ(ierr);
+  for (c=0; c<PETSC_LOG_NUM_PERF_COUNTERS; c++) {
+    /* Cycles and instructions are always counted, there may be no cache misses for a small array */
+    if (available[c] && c < 2 && info.perfCounters[c] <= 0.0) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_PLIB,"Counted %g %s",info.perfCounters[c],PetscLogPerfCounterNames[c]);
+    if (!available[c] && info.perfCounters[c] != 0.0) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_PLIB,"Counted %g %s with a counter not available",info.perfCounters[c],PetscLogPerfCounterNames[c]);
+    if (info.perfCounters[c] < 0.0) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_PLIB,"Counted %g %s",info.perfCounters[c],PetscLogPerfCounterNames[c]);
+  }
+  ierr = PetscPrintf(PETSC_COMM_WORLD,"Hardware counters logged correctly\n");CHKERRQ(ierr);
+  ierr = PetscFree(x);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+   build:
+      requires: define(PETSC_USE_LOG)
+
+   test:
+      nsize: {{1 2}}
+      args: -log_view :/dev/null -log_view_perf_counters
+
+TEST*/
@@ -65,6 +65,11 @@ PetscErrorCode PetscSectionCreate(MPI_Comm comm, PetscSection *s)
   (*s)->clHash              = NULL;
   (*s)->clSection           = NULL;
   (*s)->clPoints            = NULL;
+  (*s)->clDofObj            = NULL;
+  (*s)->clDofSection        = NULL;
+  (*s)->clDofs              = NULL;
+  (*s)->clIdxSection        = NULL;
+  (*s)->clIdxDofs           = NULL;
   PetscFunctionReturn(0);
 }
 
@@ -2170,6 +2175,19 @@ static PetscErrorCode PetscSectionResetClosurePermutation(PetscSection section)
   PetscFunctionReturn(0);
 }
 
+static PetscErrorCode PetscSectionResetClosureDofIndex(PetscSection section)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscSectionDestroy(&section->clDofSection);CHKERRQ(ierr);
+  ierr = PetscFree(section->clDofs);CHKERRQ(ierr);
+  ierr = PetscSectionDestroy(&section->clIdxSection);CHKERRQ(ierr);
+  ierr = PetscFree(section->clIdxDofs);CHKERRQ(ierr);
+  section->clDofObj = NULL;
+  PetscFunctionReturn(0);
+}
+
 /*@
   PetscSectionReset - Frees all section data.
 
@@ -2208,6 +2226,7 @@ PetscErrorCode PetscSectionReset(PetscSection s)
   ierr = ISDestroy(&s->clPoints);CHKERRQ(ierr);
   ierr = ISDestroy(&s->perm);CHKERRQ(ierr);
   ierr = PetscSectionResetClosurePermutation(s);CHKERRQ(ierr);
+  ierr = PetscSectionResetClosureDofIndex(s);CHKERRQ(ierr);
   ierr = PetscSectionSymDestroy(&s->sym);CHKERRQ(ierr);
   ierr = PetscSectionDestroy(&s->clSection);CHKERRQ(ierr);
   ierr = ISDestroy(&s->clPoints);CHKERRQ(ierr);
@@ -2632,6 +2651,65 @@ PetscErrorCode PetscSectionGetClosureIndex(PetscSection section, PetscObject obj
   PetscFunctionReturn(0);
 }
 
+/*
+  PetscSectionSetClosureDofIndex_Internal - Set a cache of the dof offsets in the closure of each indexed point, with
+  the closure permutation and the point symmetries applied
+
+  Input Parameters:
++ section      - The (local) PetscSection
+. obj          - A PetscObject which serves as the key for this index
+. idxSection   - The section whose offsets are cached, section itself or usually the global section
+. clDofSection - Section giving the number of dofs in the closure of each indexed point
+- clDofs       - The offsets, the section takes ownership
+
+  Note: The offsets of idxSection can only be set once those of section are set with the same clDofSection. Setting
+  those of section drops any other ones.
+*/
+PetscErrorCode PetscSectionSetClosureDofIndex_Internal(PetscSection section, PetscObject obj, PetscSection idxSection, PetscSection clDofSection, PetscInt *clDofs)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(section,PETSC_SECTION_CLASSID,1);
+  PetscValidHeaderSpecific(idxSection,PETSC_SECTION_CLASSID,3);
+  PetscValidHeaderSpecific(clDofSection,PETSC_SECTION_CLASSID,4);
+  if (idxSection == section) {
+    ierr = PetscObjectReference((PetscObject)clDofSection);CHKERRQ(ierr);
+    ierr = PetscSectionResetClosureDofIndex(section);CHKERRQ(ierr);
+    section->clDofObj     = obj;
+    section->clDofSection = clDofSection;
+    section->clDofs       = clDofs;
+  } else {
+    if (section->clDofObj != obj || section->clDofSection != clDofSection) SETERRQ(PetscObjectComm((PetscObject)section),PETSC_ERR_ARG_WRONGSTATE,"The local closure dof index must be set first");
+    ierr = PetscObjectReference((PetscObject)idxSection);CHKERRQ(ierr);
+    ierr = PetscSectionDestroy(&section->clIdxSection);CHKERRQ(ierr);
+    ierr = PetscFree(section->clIdxDofs);CHKERRQ(ierr);
+    section->clIdxSection = idxSection;
+    section->clIdxDofs    = clDofs;
+  }
+  PetscFunctionReturn(0);
+}
+
+/*
+  PetscSectionGetClosureDofIndex_Internal - Get the cache of the dof offsets of idxSection in the closure of each
+  indexed point, or NULL if they are not cached for this key
+*/
+PetscErrorCode PetscSectionGetClosureDofIndex_Internal(PetscSection section, PetscObject obj, PetscSection idxSection, PetscSection *clDofSection, const PetscInt *clDofs[])
+{
+  PetscFunctionBegin;
+  *clDofSection = NULL;
+  *clDofs       = NULL;
+  if (section->clDofObj != obj) PetscFunctionReturn(0);
+  if (idxSection == section) {
+    *clDofSection = section->clDofSection;
+    *clDofs       = section->clDofs;
+  } else if (idxSection == section->clIdxSection) {
+    *clDofSection = section->clDofSection;
+    *clDofs       = section->clIdxDofs;
+  }
+  PetscFunctionReturn(0);
+}
+
 PetscErrorCode PetscSectionSetClosurePermutation_Internal(PetscSection section, PetscObject obj, PetscInt depth, PetscInt clSize, PetscCopyMode mode, PetscInt *clPerm)
 {
   PetscInt       i;
@@ -2647,6 +2725,7 @@ PetscErrorCode PetscSectionSetClosurePermutation_Internal(PetscSection section,
     ierr = ISDestroy(&section->clPoints);CHKERRQ(ierr);
   }
   section->clObj = obj;
+  ierr = PetscSectionResetClosureDofIndex(section);CHKERRQ(ierr);
   if (!section->clHash) {ierr = PetscClPermCreate(&section->clHash);CHKERRQ(ierr);}
   iter = kh_put(ClPerm, section->clHash, key, &new_entry);
   val = &kh_val(section->clHash, iter);
@@ -3025,6 +3104,7 @@ PetscErrorCode PetscSectionSetSym(PetscSection section, PetscSectionSym sym)
 
   PetscFunctionBegin;
   PetscValidHeaderSpecific(section,PETSC_SECTION_CLASSID,1);
+  ierr = PetscSectionResetClosureDofIndex(section);CHKERRQ(ierr);
   ierr = PetscSectionSymDestroy(&(section->sym));CHKERRQ(ierr);
   if (sym) {
     PetscValidHeaderSpecific(sym,PETSC_SECTION_SYM_CLASSID,2);
@@ -3079,6 +3159,7 @@ PetscErrorCode PetscSectionSetFieldSym(PetscSection section, PetscInt field, Pet
   PetscFunctionBegin;
   PetscValidHeaderSpecific(section,PETSC_SECTION_CLASSID,1);
   if (field < 0 || field >= section->numFields) SETERRQ2(PetscObjectComm((PetscObject)section),PETSC_ERR_ARG_OUTOFRANGE,"Invalid field number %D (not in [0,%D)", field, section->numFields);
+  ierr = PetscSectionResetClosureDofIndex(section);CHKERRQ(ierr);
   ierr = PetscSectionSetSym(section->field[field],sym);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
@@ -3,12 +3,18 @@
 
 #if defined(PETSC_HAVE_MPI_NEIGHBORHOOD_COLLECTIVES)
 
+#if defined(PETSC_HAVE_MPIX_NEIGHBOR_ALLTOALLV_INIT)
+#include <mpi-ext.h>
+#define MPI_Neighbor_alltoallv_init MPIX_Neighbor_alltoallv_init
+#endif
+
 typedef struct {
   SFBASICHEADER;
   MPI_Comm      comms[2];       /* Communicators with distributed topology in both directions */
   PetscBool     initialized[2]; /* Are the two communicators initialized? */
   PetscMPIInt   *rootdispls,*rootcounts,*leafdispls,*leafcounts; /* displs/counts for non-distinguished ranks */
   PetscInt      rootdegree,leafdegree;
+  PetscBool     persistent;     /* Use persistent neighborhood collectives, which are init'ed once per link */
 } PetscSF_Neighbor;
 
 /*===================================================================================*/
@@ -44,6 +50,46 @@ static PetscErrorCode PetscSFGetDistComm_Neighbor(PetscSF sf,PetscSFDirection di
   PetscFunctionReturn(0);
 }
 
+/* Start the neighborhood alltoallv from sendbuf to recvbuf in the given direction, whose request is req in the link.
+
+   With persistent requests, the request is init'ed on first use of the link and then restarted. Since init is collective,
+   we can not re-init it on processes where root/leafdata changed, so MPI only sees link-owned buffers (see mpiownbuf).
+ */
+static PetscErrorCode PetscSFStartNeighborCommunication_Private(PetscSF sf,PetscSFLink link,PetscSFDirection direction,void *sendbuf,void *recvbuf,MPI_Request *req)
+{
+  PetscErrorCode    ierr;
+  PetscSF_Neighbor  *dat = (PetscSF_Neighbor*)sf->data;
+  MPI_Comm          distcomm = MPI_COMM_NULL;
+  MPI_Datatype      unit = link->unit;
+  PetscInt          outdegree,indegree;
+  const PetscMPIInt *sendcounts,*senddispls,*recvcounts,*recvdispls;
+
+  PetscFunctionBegin;
+  ierr = PetscSFGetDistComm_Neighbor(sf,direction,&distcomm);CHKERRQ(ierr);
+  if (direction == PETSCSF_ROOT2LEAF) {
+    outdegree = dat->rootdegree; sendcounts = dat->rootcounts; senddispls = dat->rootdispls;
+    indegree  = dat->leafdegree; recvcounts = dat->leafcounts; recvdispls = dat->leafdispls;
+  } else {
+    outdegree = dat->leafdegree; sendcounts = dat->leafcounts; senddispls = dat->leafdispls;
+    indegree  = dat->rootdegree; recvcounts = dat->rootcounts; recvdispls = dat->rootdispls;
+  }
+#if defined(PETSC_HAVE_MPI_PERSISTENT_NEIGHBORHOOD_COLLECTIVES)
+  if (dat->persistent) {
+    PetscBool *inited = &link->rootreqsinited[direction][link->rootmtype_mpi][link->rootdirect_mpi];
+
+    if (!outdegree && !indegree) PetscFunctionReturn(0);
+    if (!*inited) {
+      ierr    = MPI_Neighbor_alltoallv_init(sendbuf,sendcounts,senddispls,unit,recvbuf,recvcounts,recvdispls,unit,distcomm,MPI_INFO_NULL,req);CHKERRMPI(ierr);
+      *inited = PETSC_TRUE;
+    }
+    ierr = MPI_Start_persistent_neighbor_alltoallv(outdegree,indegree,sendcounts,unit,recvcounts,unit,req);CHKERRMPI(ierr);
+    PetscFunctionReturn(0);
+  }
+#endif
+  ierr = MPI_Start_ineighbor_alltoallv(outdegree,indegree,sendbuf,sendcounts,senddispls,unit,recvbuf,recvcounts,recvdispls,unit,distcomm,req);CHKERRMPI(ierr);
+  PetscFunctionReturn(0);
+}
+
 /*===================================================================================*/
 /*              Implementations of SF public APIs                                    */
 /*===================================================================================*/
@@ -114,8 +160,6 @@ static PetscErrorCode PetscSFBcastBegin_Neighbor(PetscSF sf,MPI_Datatype unit,Pe
 {
   PetscErrorCode       ierr;
   PetscSFLink          link;
-  PetscSF_Neighbor     *dat = (PetscSF_Neighbor*)sf->data;
-  MPI_Comm             distcomm = MPI_COMM_NULL;
   void                 *rootbuf = NULL,*leafbuf = NULL;
   MPI_Request          *req;
 
@@ -124,10 +168,9 @@ static PetscErrorCode PetscSFBcastBegin_Neighbor(PetscSF sf,MPI_Datatype unit,Pe
   ierr = PetscSFLinkPackRootData(sf,link,PETSCSF_REMOTE,rootdata);CHKERRQ(ierr);
   /* Do neighborhood alltoallv for remote ranks */
   ierr = PetscSFLinkCopyRootBufferInCaseNotUseGpuAwareMPI(sf,link,PETSC_TRUE/* device2host before sending */);CHKERRQ(ierr);
-  ierr = PetscSFGetDistComm_Neighbor(sf,PETSCSF_ROOT2LEAF,&distcomm);CHKERRQ(ierr);
   ierr = PetscSFLinkGetMPIBuffersAndRequests(sf,link,PETSCSF_ROOT2LEAF,&rootbuf,&leafbuf,&req,NULL);CHKERRQ(ierr);
   ierr = PetscSFLinkSyncStreamBeforeCallMPI(sf,link,PETSCSF_ROOT2LEAF);CHKERRQ(ierr);
-  ierr = MPI_Start_ineighbor_alltoallv(dat->rootdegree,dat->leafdegree,rootbuf,dat->rootcounts,dat->rootdispls,unit,leafbuf,dat->leafcounts,dat->leafdispls,unit,distcomm,req);CHKERRMPI(ierr);
+  ierr = PetscSFStartNeighborCommunication_Private(sf,link,PETSCSF_ROOT2LEAF,rootbuf,leafbuf,req);CHKERRQ(ierr);
   ierr = PetscSFLinkScatterLocal(sf,link,PETSCSF_ROOT2LEAF,(void*)rootdata,leafdata,op);
   PetscFunctionReturn(0);
 }
@@ -136,8 +179,6 @@ PETSC_STATIC_INLINE PetscErrorCode PetscSFLeafToRootBegin_Neighbor(PetscSF sf,MP
 {
   PetscErrorCode       ierr;
   PetscSFLink          link;
-  PetscSF_Neighbor     *dat = (PetscSF_Neighbor*)sf->data;
-  MPI_Comm             distcomm = MPI_COMM_NULL;
   void                 *rootbuf = NULL,*leafbuf = NULL;
   MPI_Request          *req = NULL;
 
@@ -146,10 +187,9 @@ PETSC_STATIC_INLINE PetscErrorCode PetscSFLeafToRootBegin_Neighbor(PetscSF sf,MP
   ierr = PetscSFLinkPackLeafData(sf,link,PETSCSF_REMOTE,leafdata);CHKERRQ(ierr);
   /* Do neighborhood alltoallv for remote ranks */
   ierr = PetscSFLinkCopyLeafBufferInCaseNotUseGpuAwareMPI(sf,link,PETSC_TRUE/* device2host before sending */);CHKERRQ(ierr);
-  ierr = PetscSFGetDistComm_Neighbor(sf,PETSCSF_LEAF2ROOT,&distcomm);CHKERRQ(ierr);
   ierr = PetscSFLinkGetMPIBuffersAndRequests(sf,link,PETSCSF_LEAF2ROOT,&rootbuf,&leafbuf,&req,NULL);CHKERRQ(ierr);
   ierr = PetscSFLinkSyncStreamBeforeCallMPI(sf,link,PETSCSF_LEAF2ROOT);CHKERRQ(ierr);
-  ierr = MPI_Start_ineighbor_alltoallv(dat->leafdegree,dat->rootdegree,leafbuf,dat->leafcounts,dat->leafdispls,unit,rootbuf,dat->rootcounts,dat->rootdispls,unit,distcomm,req);CHKERRMPI(ierr);
+  ierr = PetscSFStartNeighborCommunication_Private(sf,link,PETSCSF_LEAF2ROOT,leafbuf,rootbuf,req);CHKERRQ(ierr);
   *out = link;
   PetscFunctionReturn(0);
 }
@@ -201,6 +241,36 @@ static PetscErrorCode PetscSFFetchAndOpEnd_Neighbor(PetscSF sf,MPI_Datatype unit
   PetscFunctionReturn(0);
 }
 
+static PetscErrorCode PetscSFSetFromOptions_Neighbor(PetscOptionItems *PetscOptionsObject,PetscSF sf)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscOptionsHead(PetscOptionsObject,"PetscSF Neighbor options");CHKERRQ(ierr);
+#if defined(PETSC_HAVE_MPI_PERSISTENT_NEIGHBORHOOD_COLLECTIVES)
+  {
+    PetscSF_Neighbor *dat = (PetscSF_Neighbor*)sf->data;
+    ierr = PetscOptionsBool("-sf_neighbor_persistent","Use persistent MPI neighborhood collectives","PetscSFSetFromOptions",dat->persistent,&dat->persistent,NULL);CHKERRQ(ierr);
+    dat->mpiownbuf = dat->persistent;
+  }
+#endif
+  ierr = PetscOptionsTail();CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode PetscSFView_Neighbor(PetscSF sf,PetscViewer viewer)
+{
+  PetscSF_Neighbor *dat = (PetscSF_Neighbor*)sf->data;
+  PetscErrorCode   ierr;
+  PetscBool        iascii;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectTypeCompare((PetscObject)viewer,PETSCVIEWERASCII,&iascii);CHKERRQ(ierr);
+  if (iascii && dat->persistent) {ierr = PetscViewerASCIIPrintf(viewer,"  using persistent neighborhood collectives\n");CHKERRQ(ierr);}
+  ierr = PetscSFView_Basic(sf,viewer);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 PETSC_INTERN PetscErrorCode PetscSFCreate_Neighbor(PetscSF sf)
 {
   PetscErrorCode   ierr;
@@ -211,9 +281,10 @@ PETSC_INTERN PetscErrorCode PetscSFCreate_Neighbor(PetscSF sf)
   sf->ops->BcastEnd             = PetscSFBcastEnd_Basic;
   sf->ops->ReduceEnd            = PetscSFReduceEnd_Basic;
   sf->ops->GetLeafRanks         = PetscSFGetLeafRanks_Basic;
-  sf->ops->View                 = PetscSFView_Basic;
 
   sf->ops->SetUp                = PetscSFSetUp_Neighbor;
+  sf->ops->SetFromOptions       = PetscSFSetFromOptions_Neighbor;
+  sf->ops->View                 = PetscSFView_Neighbor;
   sf->ops->Reset                = PetscSFReset_Neighbor;
   sf->ops->Destroy              = PetscSFDestroy_Neighbor;
   sf->ops->BcastBegin           = PetscSFBcastBegin_Neighbor;
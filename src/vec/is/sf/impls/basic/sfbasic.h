@@ -20,6 +20,7 @@ typedef struct _n_PetscSFLink* PetscSFLink;
   PetscSFPackOpt   rootpackopt_d[2];/* Copy of rootpackopt[] on device if needed */                                                \
   PetscBool        rootdups[2];     /* Indices of roots in irootloc[local/remote] have dups. Used for data-race test */            \
   PetscInt         nrootreqs;       /* Number of MPI reqests */                                                                    \
+  PetscBool        mpiownbuf;       /* Always pass link-owned buffers to MPI instead of root/leafdata, e.g., for persistent collectives */ \
   PetscSFLink      avail;           /* One or more entries per MPI Datatype, lazily constructed */                                 \
   PetscSFLink      inuse            /* Buffers being used for transactions that have not yet completed */
 
@@ -106,6 +106,7 @@ PetscErrorCode PetscSFLinkCreate_MPI(PetscSF sf,MPI_Datatype unit,PetscMemType x
       leafdirect[i] = PETSC_FALSE; /* We also force allocating a separate leafbuf so that leafdata and leafupdate can share mpi requests */
     }
   }
+  if (bas->mpiownbuf) rootdirect[PETSCSF_REMOTE] = leafdirect[PETSCSF_REMOTE] = PETSC_FALSE;
 
   if (sf->use_gpu_aware_mpi) {
     rootmtype_mpi = rootmtype;
@@ -70,7 +70,7 @@ PETSC_STATIC_INLINE PetscErrorCode PetscGetMemType(const void *data,PetscMemType
    Options Database Keys:
 +  -sf_type basic     -Use MPI persistent Isend/Irecv for communication (Default)
 .  -sf_type window    -Use MPI-3 one-sided window for communication
--  -sf_type neighbor  -Use MPI-3 neighborhood collectives for communication
+-  -sf_type neighbor  -Use MPI-3 neighborhood collectives for communication, see also -sf_neighbor_persistent in PetscSFSetFromOptions()
 
    Level: intermediate
 
@@ -357,6 +357,8 @@ PetscErrorCode PetscSFSetUp(PetscSF sf)
                             If true, this option only works with -use_gpu_aware_mpi 1.
 .  -sf_use_stream_aware_mpi  - Assume the underlying MPI is cuda-stream aware and SF won't sync streams for send/recv buffers passed to MPI (default: false).
                                If true, this option only works with -use_gpu_aware_mpi 1.
+.  -sf_neighbor_persistent - With -sf_type neighbor, use persistent neighborhood collectives (MPI-4 or OpenMPI's MPIX extension) that are
+                             initialized once and then restarted at each communication (default: false)
 
 -  -sf_backend cuda | hip | kokkos -Select the device backend SF uses. Currently SF has these backends: cuda, hip and Kokkos.
                               On CUDA (HIP) devices, one can choose cuda (hip) or kokkos with the default being kokkos. On other devices,
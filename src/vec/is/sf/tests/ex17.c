@@ -0,0 +1,133 @@
+static char help[]= "Benchmark latency of PetscSF halo exchanges, e.g., to compare SF types and persistent neighborhood collectives\n\n";
+
+#include <petscsf.h>
+#include <petsctime.h>
+
+/* Processes are arranged in a periodic 1D ring. Each process owns n roots and has 2*w leaves, which are ghosts of the
+   w last roots of its left neighbor and the w first roots of its right neighbor, like a halo exchange in a stencil code.
+
+   We time -niter PetscSFBcast (ghost update) and PetscSFReduce (ghost accumulation) and check the results. With -alternate,
+   we switch between two leafdata arrays at each iteration, so that SF implementations caching requests on buffers
+   have to rebuild them.
+
+   Usage: mpiexec -n 4 ./ex17 -n 64 -w 2 -niter 10000 -report -sf_type neighbor -sf_neighbor_persistent
+ */
+int main(int argc,char **argv)
+{
+  PetscErrorCode ierr;
+  PetscSF        sf;
+  PetscSFNode    *iremote;
+  PetscMPIInt    size,rank,left,right;
+  PetscInt       i,j,k,n = 16,w = 2,nleaves,niter = 100,nwarmup = 10,nerr = 0;
+  PetscScalar    *rootdata,*leafdata[2],*expected;
+  PetscBool      alternate = PETSC_FALSE,report = PETSC_FALSE;
+  PetscLogDouble t0,tbcast,treduce;
+
+  ierr = PetscInitialize(&argc,&argv,NULL,help);if (ierr) return ierr;
+  ierr = MPI_Comm_size(PETSC_COMM_WORLD,&size);CHKERRMPI(ierr);
+  ierr = MPI_Comm_rank(PETSC_COMM_WORLD,&rank);CHKERRMPI(ierr);
+  ierr = PetscOptionsGetInt(NULL,NULL,"-n",&n,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,NULL,"-w",&w,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,NULL,"-niter",&niter,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,NULL,"-nwarmup",&nwarmup,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetBool(NULL,NULL,"-alternate",&alternate,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetBool(NULL,NULL,"-report",&report,NULL);CHKERRQ(ierr);
+  if (w > n) SETERRQ2(PETSC_COMM_WORLD,PETSC_ERR_ARG_OUTOFRANGE,"Halo width %D must not exceed local size %D",w,n);
+
+  left    = (rank+size-1)%size;
+  right   = (rank+1)%size;
+  nleaves = 2*w;
+  ierr    = PetscMalloc1(nleaves,&iremote);CHKERRQ(ierr);
+  for (i=0; i<w; i++) {
+    iremote[i].rank    = left;  iremote[i].index   = n-w+i;
+    iremote[w+i].rank  = right; iremote[w+i].index = i;
+  }
+
+  ierr = PetscSFCreate(PETSC_COMM_WORLD,&sf);CHKERRQ(ierr);
+  ierr = PetscSFSetFromOptions(sf);CHKERRQ(ierr);
+  ierr = PetscSFSetGraph(sf,n,nleaves,NULL,PETSC_OWN_POINTER,iremote,PETSC_OWN_POINTER);CHKERRQ(ierr);
+  ierr = PetscSFSetUp(sf);CHKERRQ(ierr);
+
+  ierr = PetscMalloc4(n,&rootdata,nleaves,&leafdata[0],nleaves,&leafdata[1],n,&expected);CHKERRQ(ierr);
+  for (i=0; i<n; i++) rootdata[i] = rank*n+i;
+
+  /* Ghost update */
+  for (k=0; k<nwarmup; k++) {
+    ierr = PetscSFBcastBegin(sf,MPIU_SCALAR,rootdata,leafdata[0],MPI_REPLACE);CHKERRQ(ierr);
+    ierr = PetscSFBcastEnd(sf,MPIU_SCALAR,rootdata,leafdata[0],MPI_REPLACE);CHKERRQ(ierr);
+  }
+  ierr = MPI_Barrier(PETSC_COMM_WORLD);CHKERRMPI(ierr);
+  ierr = PetscTime(&t0);CHKERRQ(ierr);
+  for (k=0; k<niter; k++) {
+    PetscScalar *leaf = leafdata[alternate ? k%2 : 0];
+    ierr = PetscSFBcastBegin(sf,MPIU_SCALAR,rootdata,leaf,MPI_REPLACE);CHKERRQ(ierr);
+    ierr = PetscSFBcastEnd(sf,MPIU_SCALAR,rootdata,leaf,MPI_REPLACE);CHKERRQ(ierr);
+  }
+  ierr   = PetscTimeSubtract(&t0);CHKERRQ(ierr);
+  tbcast = -t0;
+  for (j=0; j<(alternate && niter > 1 ? 2 : 1); j++) {
+    for (i=0; i<w; i++) {
+      if (leafdata[j][i]   != (PetscScalar)(left*n+n-w+i)) nerr++;
+      if (leafdata[j][w+i] != (PetscScalar)(right*n+i))    nerr++;
+    }
+  }
+
+  /* Ghost accumulation: every root gets contributions from the ghosts referring to it */
+  for (i=0; i<nleaves; i++) leafdata[0][i] = leafdata[1][i] = 1.0;
+  for (i=0; i<n; i++) rootdata[i] = 0.0;
+  for (k=0; k<nwarmup; k++) {
+    ierr = PetscSFReduceBegin(sf,MPIU_SCALAR,leafdata[0],rootdata,MPIU_SUM);CHKERRQ(ierr);
+    ierr = PetscSFReduceEnd(sf,MPIU_SCALAR,leafdata[0],rootdata,MPIU_SUM);CHKERRQ(ierr);
+  }
+  ierr = MPI_Barrier(PETSC_COMM_WORLD);CHKERRMPI(ierr);
+  ierr = PetscTime(&t0);CHKERRQ(ierr);
+  for (k=0; k<niter; k++) {
+    PetscScalar *leaf = leafdata[alternate ? k%2 : 0];
+    ierr = PetscSFReduceBegin(sf,MPIU_SCALAR,leaf,rootdata,MPIU_SUM);CHKERRQ(ierr);
+    ierr = PetscSFReduceEnd(sf,MPIU_SCALAR,leaf,rootdata,MPIU_SUM);CHKERRQ(ierr);
+  }
+  ierr    = PetscTimeSubtract(&t0);CHKERRQ(ierr);
+  treduce = -t0;
+  for (i=0; i<n; i++) expected[i] = 0.0;
+  for (i=0; i<w; i++) {expected[n-w+i] += 1.0; expected[i] += 1.0;} /* From the right and the left neighbors respectively */
+  for (i=0; i<n; i++) if (rootdata[i] != (PetscScalar)(nwarmup+niter)*expected[i]) nerr++;
+
+  ierr = MPI_Allreduce(MPI_IN_PLACE,&nerr,1,MPIU_INT,MPI_SUM,PETSC_COMM_WORLD);CHKERRMPI(ierr);
+  if (nerr) {ierr = PetscPrintf(PETSC_COMM_WORLD,"Found %D wrong entries in halo exchanges\n",nerr);CHKERRQ(ierr);}
+  else      {ierr = PetscPrintf(PETSC_COMM_WORLD,"Halo exchanges are correct\n");CHKERRQ(ierr);}
+  if (report) {
+    ierr = MPI_Allreduce(MPI_IN_PLACE,&tbcast,1,MPI_DOUBLE,MPI_MAX,PETSC_COMM_WORLD);CHKERRMPI(ierr);
+    ierr = MPI_Allreduce(MPI_IN_PLACE,&treduce,1,MPI_DOUBLE,MPI_MAX,PETSC_COMM_WORLD);CHKERRMPI(ierr);
+    ierr = PetscPrintf(PETSC_COMM_WORLD,"Average latency over %D iterations: bcast %g us, reduce %g us\n",niter,1e6*tbcast/PetscMax(niter,1),1e6*treduce/PetscMax(niter,1));CHKERRQ(ierr);
+  }
+
+  ierr = PetscFree4(rootdata,leafdata[0],leafdata[1],expected);CHKERRQ(ierr);
+  ierr = PetscSFDestroy(&sf);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+   build:
+     requires: !define(PETSC_HAVE_MPIUNI)
+
+   testset:
+     nsize: {{1 3}}
+     output_file: output/ex17_1.out
+
+     test:
+       suffix: basic
+       args: -sf_type basic -alternate {{0 1}}
+
+     test:
+       suffix: neighbor
+       args: -sf_type neighbor -alternate {{0 1}}
+       requires: define(PETSC_HAVE_MPI_NEIGHBORHOOD_COLLECTIVES)
+
+     test:
+       suffix: neighbor_persistent
+       args: -sf_type neighbor -sf_neighbor_persistent -alternate {{0 1}}
+       requires: define(PETSC_HAVE_MPI_PERSISTENT_NEIGHBORHOOD_COLLECTIVES)
+
+TEST*/